@@ -25,6 +25,13 @@
  *
  * Optimised string operations
  *
+ * These use "ldp"/"stp" pairs of general registers, moving 16 bytes
+ * per iteration with destination-aligned accesses.  NEON copies were
+ * considered and rejected: the UEFI firmware build convention for
+ * AArch64 is -mgeneral-regs-only, SIMD may be trapped or disabled by
+ * the environment that invoked us, and early execution environments
+ * with the MMU disabled treat memory as Device memory, on which SIMD
+ * and unaligned accesses are not permitted.
  */
 
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
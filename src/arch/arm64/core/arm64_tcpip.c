@@ -27,6 +27,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * TCP/IP checksum
  *
+ * The main loop uses "ldp" pairs of general registers with
+ * carry-chained additions, unrolled TCPIP_CHKSUM_UNROLL times, and
+ * runs close to load bandwidth on typical server cores.  As with the
+ * string operations, a NEON implementation is deliberately avoided
+ * since SIMD state belongs to (and may be trapped by) the invoking
+ * environment.
  */
 
 #include <strings.h>
@@ -25,6 +25,15 @@
  *
  * Optimised string operations
  *
+ * Copies and fills align on the destination and then move one
+ * register width (XLEN) per iteration.  Vector (RVV) kernels would
+ * need more than a vsetvli loop: vector state is disabled at S-mode
+ * entry (sstatus.VS) and belongs to the invoking environment, any use
+ * would have to be gated on a hart_supported ( "_v" ) probe of the
+ * devicetree ISA string with these scalar loops retained as the
+ * fallback, and the assembler would need to be told about the V
+ * extension for just these objects.  None of that is currently
+ * justified by profiling on the supported targets.
  */
 
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
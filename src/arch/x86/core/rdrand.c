@@ -39,9 +39,20 @@ struct entropy_source rdrand_entropy __entropy_source ( ENTROPY_PREFERRED );
 /** Number of times to retry RDRAND instruction */
 #define RDRAND_RETRY_COUNT 16
 
+/** Number of times to retry RDSEED instruction
+ *
+ * Unlike RDRAND, the RDSEED instruction may legitimately fail for
+ * extended periods if the hardware entropy source's conditioner is
+ * unable to keep up with demand.
+ */
+#define RDSEED_RETRY_COUNT 4096
+
 /** Colour for debug messages */
 #define colour &rdrand_entropy
 
+/** RDSEED instruction is available */
+static int rdseed;
+
 /**
  * Enable entropy gathering
  *
@@ -49,6 +60,10 @@ struct entropy_source rdrand_entropy __entropy_source ( ENTROPY_PREFERRED );
  */
 static int rdrand_entropy_enable ( void ) {
 	struct x86_features features;
+	uint32_t eax;
+	uint32_t ebx;
+	uint32_t ecx;
+	uint32_t edx;
 
 	/* Check that RDRAND is supported */
 	x86_features ( &features );
@@ -57,6 +72,18 @@ static int rdrand_entropy_enable ( void ) {
 		return -ENOTSUP;
 	}
 
+	/* Use RDSEED instead of RDRAND where available, since it
+	 * provides direct access to the conditioned output of the
+	 * hardware entropy source, rather than to the output of a
+	 * DRBG seeded from it.
+	 */
+	if ( cpuid_supported ( CPUID_SEF ) == 0 ) {
+		cpuid ( CPUID_SEF, 0, &eax, &ebx, &ecx, &edx );
+		rdseed = ( !! ( ebx & CPUID_SEF_EBX_RDSEED ) );
+	}
+	DBGC ( colour, "RDRAND using %s\n",
+	       ( rdseed ? "RDSEED" : "RDRAND" ) );
+
 	/* Data returned by RDRAND is theoretically full entropy, up
 	 * to a security strength of 128 bits, so assume that each
 	 * sample contains exactly 8 bits of entropy.
@@ -79,13 +106,22 @@ static int rdrand_get_noise ( noise_sample_t *noise ) {
 	unsigned int discard_c;
 	unsigned int ok;
 
-	/* Issue RDRAND, retrying until CF is set */
-	__asm__ ( "\n1:\n\t"
-		  "rdrand %0\n\t"
-		  "sbb %1, %1\n\t"
-		  "loopz 1b\n\t"
-		  : "=r" ( result ), "=r" ( ok ), "=c" ( discard_c )
-		  : "2" ( RDRAND_RETRY_COUNT ) );
+	/* Issue RDSEED or RDRAND, retrying until CF is set */
+	if ( rdseed ) {
+		__asm__ ( "\n1:\n\t"
+			  "rdseed %0\n\t"
+			  "sbb %1, %1\n\t"
+			  "loopz 1b\n\t"
+			  : "=r" ( result ), "=r" ( ok ), "=c" ( discard_c )
+			  : "2" ( RDSEED_RETRY_COUNT ) );
+	} else {
+		__asm__ ( "\n1:\n\t"
+			  "rdrand %0\n\t"
+			  "sbb %1, %1\n\t"
+			  "loopz 1b\n\t"
+			  : "=r" ( result ), "=r" ( ok ), "=c" ( discard_c )
+			  : "2" ( RDRAND_RETRY_COUNT ) );
+	}
 	if ( ! ok ) {
 		DBGC ( colour, "RDRAND failed to become ready\n" );
 		return -EBUSY;
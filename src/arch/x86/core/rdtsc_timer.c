@@ -111,6 +111,66 @@ static void rdtsc_udelay ( unsigned long usecs ) {
 	} while ( elapsed < threshold );
 }
 
+/**
+ * Determine TSC frequency via CPUID
+ *
+ * @ret tsc_per_us	TSC increments per microsecond, or zero if unknown
+ */
+static unsigned long rdtsc_frequency ( void ) {
+	struct x86_features features;
+	uint32_t denominator;
+	uint32_t numerator;
+	uint32_t crystal;
+	uint32_t khz;
+	uint32_t mhz;
+	uint32_t discard_b;
+	uint32_t discard_c;
+	uint32_t discard_d;
+
+	/* Try the hypervisor timing leaf first: under virtualisation
+	 * the crystal clock leaves are often absent and the PIT may
+	 * be emulated (slowly), while the hypervisor reports the
+	 * guest TSC rate directly.
+	 */
+	x86_features ( &features );
+	if ( ( features.intel.ecx & CPUID_FEATURES_INTEL_ECX_HYPERVISOR ) &&
+	     ( cpuid_supported ( CPUID_HYPERVISOR_TIMING ) == 0 ) ) {
+		cpuid ( CPUID_HYPERVISOR_TIMING, 0, &khz, &discard_b,
+			&discard_c, &discard_d );
+		if ( khz ) {
+			DBGC ( colour, "RDTSC hypervisor reports %d kHz\n",
+			       khz );
+			return ( khz / 1000 );
+		}
+	}
+
+	/* Try the TSC and core crystal clock leaf */
+	if ( cpuid_supported ( CPUID_TSC_CRYSTAL ) == 0 ) {
+		cpuid ( CPUID_TSC_CRYSTAL, 0, &denominator, &numerator,
+			&crystal, &discard_d );
+		if ( denominator && numerator && crystal ) {
+			DBGC ( colour, "RDTSC crystal %d Hz * %d / %d\n",
+			       crystal, numerator, denominator );
+			return ( ( ( ( uint64_t ) crystal ) * numerator ) /
+				 ( ( ( uint64_t ) denominator ) * 1000000 ) );
+		}
+	}
+
+	/* Try the processor frequency leaf.  The TSC on invariant-TSC
+	 * CPUs increments at the base frequency.
+	 */
+	if ( cpuid_supported ( CPUID_FREQUENCY ) == 0 ) {
+		cpuid ( CPUID_FREQUENCY, 0, &mhz, &discard_b, &discard_c,
+			&discard_d );
+		if ( mhz ) {
+			DBGC ( colour, "RDTSC base frequency %d MHz\n", mhz );
+			return mhz;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Probe RDTSC timer
  *
@@ -139,12 +199,18 @@ static int rdtsc_probe ( void ) {
 		return -ENOTTY;
 	}
 
-	/* Calibrate udelay() timer via 8254 PIT */
-	before = rdtsc_raw();
-	pit8254_udelay ( TSC_CALIBRATE_US );
-	after = rdtsc_raw();
-	elapsed = ( after - before );
-	tsc_per_us = ( elapsed / TSC_CALIBRATE_US );
+	/* Determine TSC frequency via CPUID if possible, falling back
+	 * to calibration against the 8254 PIT (which costs a fixed
+	 * amount of wall time at startup).
+	 */
+	tsc_per_us = rdtsc_frequency();
+	if ( ! tsc_per_us ) {
+		before = rdtsc_raw();
+		pit8254_udelay ( TSC_CALIBRATE_US );
+		after = rdtsc_raw();
+		elapsed = ( after - before );
+		tsc_per_us = ( elapsed / TSC_CALIBRATE_US );
+	}
 	if ( ! tsc_per_us ) {
 		DBGC ( colour, "RDTSC has zero TSC per microsecond\n" );
 		return -EIO;
@@ -31,6 +31,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <string.h>
 #include <config/defaults.h>
+#include <ipxe/cpuid.h>
 
 /* Use generic_memcpy_reverse() if we cannot safely set the direction flag */
 #ifdef UNSAFE_STD
@@ -39,6 +40,39 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define USE_GENERIC_MEMCPY_REVERSE 0
 #endif
 
+/** Minimum length for which to use "rep movsb" on ERMS-capable CPUs
+ *
+ * Below this length the dword-based copy is at least as fast, and
+ * avoids any reliance on the (cached) CPUID feature probe.
+ */
+#define ERMS_THRESHOLD 64
+
+/**
+ * Check for Enhanced REP MOVSB/STOSB support
+ *
+ * @ret erms		ERMS is supported
+ */
+static int have_erms ( void ) {
+	static int erms = -1;
+	uint32_t discard_a;
+	uint32_t ebx;
+	uint32_t discard_c;
+	uint32_t discard_d;
+
+	/* Probe via CPUID on first use */
+	if ( erms < 0 ) {
+		if ( cpuid_supported ( CPUID_SEF ) == 0 ) {
+			cpuid ( CPUID_SEF, 0, &discard_a, &ebx, &discard_c,
+				&discard_d );
+			erms = ( !! ( ebx & CPUID_SEF_EBX_ERMS ) );
+		} else {
+			erms = 0;
+		}
+	}
+
+	return erms;
+}
+
 /**
  * Copy memory area
  *
@@ -53,6 +87,21 @@ void * __attribute__ (( noinline )) __memcpy ( void *dest, const void *src,
 	const void *esi = src;
 	int discard_ecx;
 
+	/* On CPUs with Enhanced REP MOVSB, a single byte-granular
+	 * "rep movsb" is the fastest available bulk copy regardless
+	 * of alignment, and (unlike a vector copy loop) requires no
+	 * FPU or SSE state, which we must leave untouched since the
+	 * firmware or a chainloaded NBP may be using it.
+	 */
+	if ( ( len >= ERMS_THRESHOLD ) && have_erms() ) {
+		__asm__ __volatile__ ( "rep movsb"
+				       : "=&D" ( edi ), "=&S" ( esi ),
+					 "=&c" ( discard_ecx )
+				       : "0" ( edi ), "1" ( esi ), "2" ( len )
+				       : "memory" );
+		return dest;
+	}
+
 	/* We often do large dword-aligned and dword-length block
 	 * moves.  Using movsl rather than movsb speeds these up by
 	 * around 32%.
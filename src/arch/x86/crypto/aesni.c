@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * AES algorithm using AES-NI instructions
+ *
+ * The software key expansion in aes.c already constructs both key
+ * schedules in exactly the form required by the AES-NI instructions:
+ * the encryption schedule is the standard expanded key, and the
+ * decryption schedule is the Equivalent Inverse Cipher schedule
+ * (i.e. the inner round keys transformed via InvMixColumns, as
+ * performed by the AESIMC instruction).  We can therefore reuse the
+ * software-expanded keys directly.
+ */
+
+#include <ipxe/aes.h>
+#include <ipxe/cpuid.h>
+
+/** CR4: operating system FXSAVE/FXRSTOR support */
+#define CR4_OSFXSR ( 1 << 9 )
+
+/**
+ * Check for AES-NI support
+ *
+ * @ret supported	AES-NI is supported
+ */
+static int aesni_supported ( void ) {
+	struct x86_features features;
+#ifndef PLATFORM_linux
+	unsigned long cr4;
+#endif
+
+	/* Check for AES instruction support */
+	x86_features ( &features );
+	if ( ! ( features.intel.ecx & CPUID_FEATURES_INTEL_ECX_AES ) )
+		return 0;
+
+#ifndef PLATFORM_linux
+	/* SSE instructions (including the AES instructions) will
+	 * raise an undefined opcode exception unless CR4.OSFXSR is
+	 * enabled.  We run at ring 0 and own the CPU state, so enable
+	 * it ourselves if the firmware has not already done so.
+	 */
+	if ( ! ( features.intel.edx & CPUID_FEATURES_INTEL_EDX_FXSR ) )
+		return 0;
+	__asm__ __volatile__ ( "mov %%cr4, %0" : "=r" ( cr4 ) );
+	if ( ! ( cr4 & CR4_OSFXSR ) ) {
+		cr4 |= CR4_OSFXSR;
+		__asm__ __volatile__ ( "mov %0, %%cr4" : : "r" ( cr4 ) );
+	}
+#endif
+
+	DBGC ( &features, "AESNI using accelerated AES\n" );
+	return 1;
+}
+
+/**
+ * Check for hardware-accelerated AES support
+ *
+ * @ret supported	Hardware-accelerated AES is supported
+ */
+int aes_accel_supported ( void ) {
+	static int supported = -1;
+
+	/* Check for support, if not already done */
+	if ( supported < 0 )
+		supported = aesni_supported();
+
+	return supported;
+}
+
+/**
+ * Encrypt data using hardware acceleration
+ *
+ * @v aes		AES context
+ * @v src		Data to encrypt
+ * @v dst		Buffer for encrypted data
+ */
+void aes_accel_encrypt ( struct aes_context *aes, const void *src,
+			 void *dst ) {
+	const union aes_matrix *key = aes->encrypt.key;
+	unsigned int rounds = ( aes->rounds - 2 );
+
+	/* Perform initial round (AddRoundKey), intermediate rounds
+	 * (AESENC), and final round (AESENCLAST).
+	 */
+	__asm__ __volatile__ ( "movups ( %2 ), %%xmm0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "pxor %%xmm1, %%xmm0\n\t"
+			       "\n1:\n\t"
+			       "add %4, %0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "aesenc %%xmm1, %%xmm0\n\t"
+			       "dec %1\n\t"
+			       "jnz 1b\n\t"
+			       "add %4, %0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "aesenclast %%xmm1, %%xmm0\n\t"
+			       "movups %%xmm0, ( %3 )\n\t"
+			       : "+r" ( key ), "+r" ( rounds )
+			       : "r" ( src ), "r" ( dst ),
+				 "i" ( sizeof ( *key ) )
+			       : "xmm0", "xmm1", "cc", "memory" );
+}
+
+/**
+ * Decrypt data using hardware acceleration
+ *
+ * @v aes		AES context
+ * @v src		Data to decrypt
+ * @v dst		Buffer for decrypted data
+ */
+void aes_accel_decrypt ( struct aes_context *aes, const void *src,
+			 void *dst ) {
+	const union aes_matrix *key = aes->decrypt.key;
+	unsigned int rounds = ( aes->rounds - 2 );
+
+	/* Perform initial round (AddRoundKey), intermediate rounds
+	 * (AESDEC), and final round (AESDECLAST).
+	 */
+	__asm__ __volatile__ ( "movups ( %2 ), %%xmm0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "pxor %%xmm1, %%xmm0\n\t"
+			       "\n1:\n\t"
+			       "add %4, %0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "aesdec %%xmm1, %%xmm0\n\t"
+			       "dec %1\n\t"
+			       "jnz 1b\n\t"
+			       "add %4, %0\n\t"
+			       "movups ( %0 ), %%xmm1\n\t"
+			       "aesdeclast %%xmm1, %%xmm0\n\t"
+			       "movups %%xmm0, ( %3 )\n\t"
+			       : "+r" ( key ), "+r" ( rounds )
+			       : "r" ( src ), "r" ( dst ),
+				 "i" ( sizeof ( *key ) )
+			       : "xmm0", "xmm1", "cc", "memory" );
+}
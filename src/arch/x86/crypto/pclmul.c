@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * GCM GHASH multiplication using the PCLMULQDQ instruction
+ *
+ * GCM treats its 128-bit blocks as polynomials over GF(2) with the
+ * constant term held in the most significant bit of the first byte.
+ * Byte-swapping a block therefore yields the bit-reflection of the
+ * polynomial viewed as a 128-bit integer, and all arithmetic can be
+ * carried out in this reflected domain: a carry-less product of two
+ * reflected operands is the (256-bit) reflection of the polynomial
+ * product shifted right by one bit, and multiplication of a
+ * reflected value by x^n is a right shift by n bits.
+ */
+
+#include <stdint.h>
+#include <byteswap.h>
+#include <ipxe/gcm.h>
+#include <ipxe/cpuid.h>
+
+/** CR4: operating system FXSAVE/FXRSTOR support */
+#define CR4_OSFXSR ( 1 << 9 )
+
+/**
+ * Check for PCLMULQDQ support
+ *
+ * @ret supported	PCLMULQDQ is supported
+ */
+static int pclmul_supported ( void ) {
+	struct x86_features features;
+#ifndef PLATFORM_linux
+	unsigned long cr4;
+#endif
+
+	/* Check for carry-less multiplication instruction support */
+	x86_features ( &features );
+	if ( ! ( features.intel.ecx & CPUID_FEATURES_INTEL_ECX_PCLMULQDQ ) )
+		return 0;
+
+#ifndef PLATFORM_linux
+	/* Ensure that CR4.OSFXSR is enabled, since the SSE registers
+	 * used by PCLMULQDQ are otherwise inaccessible.
+	 */
+	if ( ! ( features.intel.edx & CPUID_FEATURES_INTEL_EDX_FXSR ) )
+		return 0;
+	__asm__ __volatile__ ( "mov %%cr4, %0" : "=r" ( cr4 ) );
+	if ( ! ( cr4 & CR4_OSFXSR ) ) {
+		cr4 |= CR4_OSFXSR;
+		__asm__ __volatile__ ( "mov %0, %%cr4" : : "r" ( cr4 ) );
+	}
+#endif
+
+	DBGC ( &features, "PCLMUL using accelerated GHASH\n" );
+	return 1;
+}
+
+/**
+ * Check for hardware-accelerated GCM support
+ *
+ * @ret supported	Hardware-accelerated GCM is supported
+ */
+int gcm_accel_supported ( void ) {
+	static int supported = -1;
+
+	/* Check for support, if not already done */
+	if ( supported < 0 )
+		supported = pclmul_supported();
+
+	return supported;
+}
+
+/**
+ * Perform 64-bit carry-less multiplication
+ *
+ * @v multiplicand	Multiplicand
+ * @v multiplier	Multiplier
+ * @v hi		Most significant 64 bits of product to fill in
+ * @v lo		Least significant 64 bits of product to fill in
+ */
+static inline void pclmul ( uint64_t multiplicand, uint64_t multiplier,
+			    uint64_t *hi, uint64_t *lo ) {
+	uint64_t product[2];
+
+	/* Use a memory operand for the 64-bit values, since these
+	 * cannot be moved directly to an SSE register in a way that
+	 * works for both i386 and x86_64.
+	 */
+	product[0] = multiplicand;
+	product[1] = multiplier;
+	__asm__ ( "movq 0( %1 ), %%xmm0\n\t"
+		  "movq 8( %1 ), %%xmm1\n\t"
+		  "pclmulqdq $0, %%xmm1, %%xmm0\n\t"
+		  "movups %%xmm0, 0( %1 )\n\t"
+		  : "+m" ( product )
+		  : "r" ( product )
+		  : "xmm0", "xmm1" );
+	*lo = product[0];
+	*hi = product[1];
+}
+
+/**
+ * Multiply polynomial by hash key in situ using hardware acceleration
+ *
+ * @v key		Hash key
+ * @v poly		Multiplicand and result
+ */
+void gcm_accel_multiply ( const union gcm_block *key,
+			  union gcm_block *poly ) {
+	uint64_t ah = be64_to_cpu ( poly->qword[0] );
+	uint64_t al = be64_to_cpu ( poly->qword[1] );
+	uint64_t bh = be64_to_cpu ( key->qword[0] );
+	uint64_t bl = be64_to_cpu ( key->qword[1] );
+	uint64_t t3h;
+	uint64_t t3l;
+	uint64_t t2h;
+	uint64_t t2l;
+	uint64_t t1h;
+	uint64_t t1l;
+	uint64_t t0h;
+	uint64_t t0l;
+	uint64_t s3;
+	uint64_t s2;
+	uint64_t s1;
+	uint64_t s0;
+	uint64_t u;
+
+	/* Calculate 256-bit carry-less product via four 64-bit
+	 * carry-less multiplications.
+	 */
+	pclmul ( al, bl, &t0h, &t0l );
+	pclmul ( al, bh, &t1h, &t1l );
+	pclmul ( ah, bl, &t2h, &t2l );
+	t1h ^= t2h;
+	t1l ^= t2l;
+	pclmul ( ah, bh, &t3h, &t3l );
+	t3l ^= t1h;
+	t0h ^= t1l;
+
+	/* Shift left by one bit to obtain the reflection of the
+	 * 255-bit polynomial product [s3:s2:s1:s0], of which [s3:s2]
+	 * reflects the coefficients of x^0..x^127 and [s1:s0]
+	 * reflects the coefficients of x^128..x^254.
+	 */
+	s3 = ( ( t3h << 1 ) | ( t3l >> 63 ) );
+	s2 = ( ( t3l << 1 ) | ( t0h >> 63 ) );
+	s1 = ( ( t0h << 1 ) | ( t0l >> 63 ) );
+	s0 = ( t0l << 1 );
+
+	/* Reduce modulo the field polynomial (x^128 + x^7 + x^2 + x
+	 * + 1).  The high coefficients are multiplied by (x^7 + x^2
+	 * + x + 1) via right shifts in the reflected domain; the
+	 * handful of coefficients thereby pushed beyond x^127 (which
+	 * can arise only from the x^7 and x^2 terms) are folded in
+	 * via a second reduction of [u:0].
+	 */
+	u = ( ( s0 << 57 ) ^ ( s0 << 62 ) );
+	s3 ^= ( s1 ^ ( s1 >> 1 ) ^ ( s1 >> 2 ) ^ ( s1 >> 7 ) ^
+		u ^ ( u >> 1 ) ^ ( u >> 2 ) ^ ( u >> 7 ) );
+	s2 ^= ( s0 ^ ( s0 >> 1 ) ^ ( s0 >> 2 ) ^ ( s0 >> 7 ) ^
+		( s1 << 63 ) ^ ( s1 << 62 ) ^ ( s1 << 57 ) );
+
+	/* Overwrite result */
+	poly->qword[0] = cpu_to_be64 ( s3 );
+	poly->qword[1] = cpu_to_be64 ( s2 );
+}
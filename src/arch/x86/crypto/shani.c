@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * SHA-256 algorithm using the SHA extensions
+ *
+ * The SHA256RNDS2 instruction performs two rounds of the compression
+ * function, holding half of the working state { a, b, e, f } in one
+ * register and the other half { c, d, g, h } in a second register,
+ * with the round constant already added to the message schedule in
+ * XMM0.  After two rounds the new { c, d, g, h } is simply the old
+ * { a, b, e, f }, so the two state registers alternate roles between
+ * successive instructions.  The message schedule itself is computed
+ * sixteen dwords at a time using SHA256MSG1 and SHA256MSG2.
+ *
+ * Endianness conversion and state register lane ordering are handled
+ * in C, so that the assembly consists purely of the round and message
+ * schedule instructions.
+ */
+
+#include <byteswap.h>
+#include <ipxe/sha256.h>
+#include <ipxe/cpuid.h>
+
+/** CR4: operating system FXSAVE/FXRSTOR support */
+#define CR4_OSFXSR ( 1 << 9 )
+
+/**
+ * Check for SHA extensions support
+ *
+ * @ret supported	SHA extensions are supported
+ */
+static int shani_supported ( void ) {
+	struct x86_features features;
+	uint32_t eax;
+	uint32_t ebx;
+	uint32_t ecx;
+	uint32_t edx;
+#ifndef PLATFORM_linux
+	unsigned long cr4;
+#endif
+
+	/* Check for SHA extensions support */
+	x86_features ( &features );
+	if ( cpuid_supported ( CPUID_SEF ) != 0 )
+		return 0;
+	cpuid ( CPUID_SEF, 0, &eax, &ebx, &ecx, &edx );
+	if ( ! ( ebx & CPUID_SEF_EBX_SHA ) )
+		return 0;
+
+#ifndef PLATFORM_linux
+	/* The SHA instructions operate on XMM registers and so will
+	 * raise an undefined opcode exception unless CR4.OSFXSR is
+	 * enabled.  We run at ring 0 and own the CPU state, so enable
+	 * it ourselves if the firmware has not already done so.
+	 */
+	if ( ! ( features.intel.edx & CPUID_FEATURES_INTEL_EDX_FXSR ) )
+		return 0;
+	__asm__ __volatile__ ( "mov %%cr4, %0" : "=r" ( cr4 ) );
+	if ( ! ( cr4 & CR4_OSFXSR ) ) {
+		cr4 |= CR4_OSFXSR;
+		__asm__ __volatile__ ( "mov %0, %%cr4" : : "r" ( cr4 ) );
+	}
+#endif
+
+	DBGC ( &features, "SHANI using accelerated SHA-256\n" );
+	return 1;
+}
+
+/**
+ * Check for hardware-accelerated SHA-256 support
+ *
+ * @ret supported	Hardware-accelerated SHA-256 is supported
+ */
+int sha256_accel_supported ( void ) {
+	static int supported = -1;
+
+	/* Check for support, if not already done */
+	if ( supported < 0 )
+		supported = shani_supported();
+
+	return supported;
+}
+
+/**
+ * Digest one data block using hardware acceleration
+ *
+ * @v digest		Digest to update
+ * @v data		Data block
+ */
+void sha256_accel_digest ( struct sha256_digest *digest,
+			   const union sha256_block *data ) {
+	uint32_t h[8];
+	uint32_t abef[4];
+	uint32_t cdgh[4];
+	uint32_t w[16];
+	unsigned int i;
+
+	/* Convert digest and data block to host endianness, and
+	 * arrange the working state in the lane order expected by
+	 * SHA256RNDS2 (most significant lane first).
+	 */
+	for ( i = 0 ; i < 8 ; i++ )
+		h[i] = be32_to_cpu ( digest->h[i] );
+	abef[3] = h[0];
+	abef[2] = h[1];
+	abef[1] = h[4];
+	abef[0] = h[5];
+	cdgh[3] = h[2];
+	cdgh[2] = h[3];
+	cdgh[1] = h[6];
+	cdgh[0] = h[7];
+	for ( i = 0 ; i < 16 ; i++ )
+		w[i] = be32_to_cpu ( data->dword[i] );
+
+	/* Perform all 64 rounds.  The "r4" macro performs four rounds,
+	 * using \cur as the current sixteen-round message schedule
+	 * chunk, updating \prev via SHA256MSG1 and \next via
+	 * SHA256MSG2 so that the schedule stays four rounds ahead.
+	 * The trailing invocations compute schedule dwords beyond
+	 * w[63]; these values are never used and the work is cheaper
+	 * than special-casing the final rounds.
+	 */
+	__asm__ ( ".macro r4 koff, next, prev, cur\n\t"
+		  "movdqa \\cur, %%xmm0\n\t"
+		  "paddd \\koff(%[k]), %%xmm0\n\t"
+		  "sha256rnds2 %%xmm1, %%xmm2\n\t"
+		  "movdqa \\cur, %%xmm7\n\t"
+		  "palignr $4, \\prev, %%xmm7\n\t"
+		  "paddd %%xmm7, \\next\n\t"
+		  "sha256msg2 \\cur, \\next\n\t"
+		  "pshufd $0x0e, %%xmm0, %%xmm0\n\t"
+		  "sha256rnds2 %%xmm2, %%xmm1\n\t"
+		  "sha256msg1 \\cur, \\prev\n\t"
+		  ".endm\n\t"
+		  /* Load working state */
+		  "movdqu ( %[abef] ), %%xmm1\n\t"
+		  "movdqu ( %[cdgh] ), %%xmm2\n\t"
+		  /* Rounds 0-11, loading the message block */
+		  "movdqu 0( %[w] ), %%xmm3\n\t"
+		  "movdqa %%xmm3, %%xmm0\n\t"
+		  "paddd 0( %[k] ), %%xmm0\n\t"
+		  "sha256rnds2 %%xmm1, %%xmm2\n\t"
+		  "pshufd $0x0e, %%xmm0, %%xmm0\n\t"
+		  "sha256rnds2 %%xmm2, %%xmm1\n\t"
+		  "movdqu 16( %[w] ), %%xmm4\n\t"
+		  "movdqa %%xmm4, %%xmm0\n\t"
+		  "paddd 16( %[k] ), %%xmm0\n\t"
+		  "sha256rnds2 %%xmm1, %%xmm2\n\t"
+		  "pshufd $0x0e, %%xmm0, %%xmm0\n\t"
+		  "sha256rnds2 %%xmm2, %%xmm1\n\t"
+		  "sha256msg1 %%xmm4, %%xmm3\n\t"
+		  "movdqu 32( %[w] ), %%xmm5\n\t"
+		  "movdqa %%xmm5, %%xmm0\n\t"
+		  "paddd 32( %[k] ), %%xmm0\n\t"
+		  "sha256rnds2 %%xmm1, %%xmm2\n\t"
+		  "pshufd $0x0e, %%xmm0, %%xmm0\n\t"
+		  "sha256rnds2 %%xmm2, %%xmm1\n\t"
+		  "sha256msg1 %%xmm5, %%xmm4\n\t"
+		  /* Rounds 12-63 */
+		  "movdqu 48( %[w] ), %%xmm6\n\t"
+		  "r4 48, %%xmm3, %%xmm5, %%xmm6\n\t"
+		  "r4 64, %%xmm4, %%xmm6, %%xmm3\n\t"
+		  "r4 80, %%xmm5, %%xmm3, %%xmm4\n\t"
+		  "r4 96, %%xmm6, %%xmm4, %%xmm5\n\t"
+		  "r4 112, %%xmm3, %%xmm5, %%xmm6\n\t"
+		  "r4 128, %%xmm4, %%xmm6, %%xmm3\n\t"
+		  "r4 144, %%xmm5, %%xmm3, %%xmm4\n\t"
+		  "r4 160, %%xmm6, %%xmm4, %%xmm5\n\t"
+		  "r4 176, %%xmm3, %%xmm5, %%xmm6\n\t"
+		  "r4 192, %%xmm4, %%xmm6, %%xmm3\n\t"
+		  "r4 208, %%xmm5, %%xmm3, %%xmm4\n\t"
+		  "r4 224, %%xmm6, %%xmm4, %%xmm5\n\t"
+		  "r4 240, %%xmm3, %%xmm5, %%xmm6\n\t"
+		  ".purgem r4\n\t"
+		  /* Store working state */
+		  "movdqu %%xmm1, ( %[abef] )\n\t"
+		  "movdqu %%xmm2, ( %[cdgh] )\n\t"
+		  : : [abef] "r" ( abef ), [cdgh] "r" ( cdgh ),
+		      [w] "r" ( w ), [k] "r" ( sha256_k )
+		  : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+		    "xmm7", "memory" );
+
+	/* Add this block's state to the digest, converting back to
+	 * big endian.
+	 */
+	digest->h[0] = cpu_to_be32 ( h[0] + abef[3] );
+	digest->h[1] = cpu_to_be32 ( h[1] + abef[2] );
+	digest->h[2] = cpu_to_be32 ( h[2] + cdgh[3] );
+	digest->h[3] = cpu_to_be32 ( h[3] + cdgh[2] );
+	digest->h[4] = cpu_to_be32 ( h[4] + abef[1] );
+	digest->h[5] = cpu_to_be32 ( h[5] + abef[0] );
+	digest->h[6] = cpu_to_be32 ( h[6] + cdgh[1] );
+	digest->h[7] = cpu_to_be32 ( h[7] + cdgh[0] );
+}
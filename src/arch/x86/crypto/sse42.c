@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * CRC32C calculation using the SSE4.2 crc32 instruction
+ *
+ * The crc32 instruction operates on general-purpose registers and so
+ * requires no FPU or SSE register state to be set up, unlike the
+ * other accelerated crypto primitives.
+ */
+
+#include <stdint.h>
+#include <ipxe/crc32.h>
+#include <ipxe/cpuid.h>
+
+/**
+ * Check for SSE4.2 support
+ *
+ * @ret supported	SSE4.2 is supported
+ */
+static int sse42_supported ( void ) {
+	struct x86_features features;
+
+	/* Check for crc32 instruction support */
+	x86_features ( &features );
+	if ( ! ( features.intel.ecx & CPUID_FEATURES_INTEL_ECX_SSE42 ) )
+		return 0;
+
+	DBGC ( &features, "SSE42 using accelerated CRC32C\n" );
+	return 1;
+}
+
+/**
+ * Check for hardware-accelerated CRC32C support
+ *
+ * @ret supported	Hardware-accelerated CRC32C is supported
+ */
+int crc32c_accel_supported ( void ) {
+	static int supported = -1;
+
+	/* Check for support, if not already done */
+	if ( supported < 0 )
+		supported = sse42_supported();
+
+	return supported;
+}
+
+/**
+ * Calculate CRC32C checksum using hardware acceleration
+ *
+ * @v seed	Initial value
+ * @v data	Data to checksum
+ * @v len	Length of data
+ * @ret crc	Updated CRC value
+ */
+u32 crc32c_accel ( u32 seed, const void *data, size_t len ) {
+	const unsigned long __attribute__ (( may_alias )) *word;
+	const uint8_t *src = data;
+	unsigned long crc = seed;
+
+	/* Process bytes up to the first word boundary */
+	while ( len && ( ( ( intptr_t ) src ) & ( sizeof ( *word ) - 1 ) ) ) {
+		__asm__ ( "crc32b %1, %k0" : "+r" ( crc ) : "m" ( *src ) );
+		src++;
+		len--;
+	}
+
+	/* Process whole words */
+	while ( len >= sizeof ( *word ) ) {
+		word = ( ( const void * ) src );
+#ifdef __x86_64__
+		__asm__ ( "crc32q %1, %0" : "+r" ( crc ) : "m" ( *word ) );
+#else
+		__asm__ ( "crc32l %1, %0" : "+r" ( crc ) : "m" ( *word ) );
+#endif
+		src += sizeof ( *word );
+		len -= sizeof ( *word );
+	}
+
+	/* Process remaining bytes */
+	while ( len-- ) {
+		__asm__ ( "crc32b %1, %k0" : "+r" ( crc ) : "m" ( *src ) );
+		src++;
+	}
+
+	return crc;
+}
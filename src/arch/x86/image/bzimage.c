@@ -40,6 +40,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <bzimage.h>
 #include <initrd.h>
 #include <ipxe/uaccess.h>
+#include <ipxe/io.h>
 #include <ipxe/image.h>
 #include <ipxe/segment.h>
 #include <ipxe/init.h>
@@ -351,13 +352,19 @@ static size_t bzimage_load_initrd ( struct image *image,
 		return 0;
 
 	/* Determine length of cpio headers for non-prebuilt images */
-	len = 0;
-	for ( i = 0 ; ( cpio_len = cpio_header ( initrd, i, &cpio ) ) ; i++ )
-		len += ( cpio_len + cpio_pad_len ( cpio_len ) );
-
-	/* Copy in initrd image body and construct any cpio headers */
+	len = cpio_headers_len ( initrd );
+
+	/* Copy in initrd image body and construct any cpio headers.
+	 * The body is moved only if it is not already at its final
+	 * address: reshuffling leaves each image with headroom for
+	 * its cpio headers, so in the common case the headers are
+	 * constructed in situ and the (potentially very large) body
+	 * copy is skipped entirely.
+	 */
 	if ( address ) {
-		memmove ( ( address + len ), initrd->data, initrd->len );
+		if ( ( address + len ) != initrd->data )
+			memmove ( ( address + len ), initrd->data,
+				  initrd->len );
 		memset ( address, 0, len );
 		offset = 0;
 		for ( i = 0 ; ( cpio_len = cpio_header ( initrd, i, &cpio ) ) ;
@@ -458,18 +465,9 @@ static void bzimage_load_initrds ( struct image *image,
 	size_t offset;
 	size_t len;
 
-	/* Reshuffle initrds into desired order */
+	/* Reshuffle initrds into desired order at top of memory */
 	bottom = virt_to_phys ( bzimg->pm_kernel + bzimg->pm_sz );
-	initrd_reshuffle ( bottom );
-
-	/* Find highest usable address */
-	top = 0;
-	for_each_image ( initrd ) {
-		if ( virt_to_phys ( initrd->data ) >= top ) {
-			top = ( virt_to_phys ( initrd->data ) +
-				bzimage_align ( initrd->len ) );
-		}
-	}
+	top = initrd_reshuffle ( bottom );
 
 	/* Do nothing if there are no initrds */
 	if ( ! top )
@@ -517,21 +515,23 @@ static void bzimage_load_initrds ( struct image *image,
  */
 static int bzimage_exec ( struct image *image ) {
 	struct bzimage_context bzimg;
+	struct memory_map memmap;
 	int rc;
 
 	/* Read and parse header from image */
 	if ( ( rc = bzimage_parse_header ( image, &bzimg ) ) != 0 )
 		return rc;
 
-	/* Prepare segments */
+	/* Prepare segments, fetching the memory map once for both */
+	get_memmap ( &memmap );
 	if ( ( rc = prep_segment ( bzimg.rm_kernel, bzimg.rm_filesz,
-				   bzimg.rm_memsz ) ) != 0 ) {
+				   bzimg.rm_memsz, &memmap ) ) != 0 ) {
 		DBGC ( image, "bzImage %s could not prepare RM segment: %s\n",
 		       image->name, strerror ( rc ) );
 		return rc;
 	}
 	if ( ( rc = prep_segment ( bzimg.pm_kernel, bzimg.pm_sz,
-				   bzimg.pm_sz ) ) != 0 ) {
+				   bzimg.pm_sz, &memmap ) ) != 0 ) {
 		DBGC ( image, "bzImage %s could not prepare PM segment: %s\n",
 		       image->name, strerror ( rc ) );
 		return rc;
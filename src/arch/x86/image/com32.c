@@ -210,7 +210,7 @@ static int com32_load_image ( struct image *image ) {
 	filesz = image->len;
 	memsz = filesz;
 	buffer = phys_to_virt ( COM32_START_PHYS );
-	if ( ( rc = prep_segment ( buffer, filesz, memsz ) ) != 0 ) {
+	if ( ( rc = prep_segment ( buffer, filesz, memsz, NULL ) ) != 0 ) {
 		DBGC ( image, "COM32 %p: could not prepare segment: %s\n",
 		       image, strerror ( rc ) );
 		return rc;
@@ -239,7 +239,7 @@ static int com32_prepare_bounce_buffer ( struct image * image ) {
 	filesz = 0;
 
 	/* Prepare, verify, and load the real-mode segment */
-	if ( ( rc = prep_segment ( seg, filesz, memsz ) ) != 0 ) {
+	if ( ( rc = prep_segment ( seg, filesz, memsz, NULL ) ) != 0 ) {
 		DBGC ( image, "COM32 %p: could not prepare bounce buffer segment: %s\n",
 		       image, strerror ( rc ) );
 		return rc;
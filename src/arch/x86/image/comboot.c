@@ -250,7 +250,7 @@ static int comboot_prepare_segment ( struct image *image )
 	memsz = 0xFFFF;
 
 	/* Prepare, verify, and load the real-mode segment */
-	if ( ( rc = prep_segment ( seg, filesz, memsz ) ) != 0 ) {
+	if ( ( rc = prep_segment ( seg, filesz, memsz, NULL ) ) != 0 ) {
 		DBGC ( image, "COMBOOT %p: could not prepare segment: %s\n",
 		       image, strerror ( rc ) );
 		return rc;
@@ -90,7 +90,8 @@ static int elfboot_exec ( struct image *image ) {
  * @ret rc		Return status code
  */
 static int elfboot_check_segment ( struct image *image, const Elf_Phdr *phdr,
-				   physaddr_t dest ) {
+				   physaddr_t dest,
+				   struct memory_map *memmap __unused ) {
 
 	/* Check that ELF segment uses flat physical addressing */
 	if ( phdr->p_vaddr != dest ) {
@@ -137,7 +138,7 @@ static int elfboot_probe ( struct image *image ) {
 
 	/* Check that this image uses flat physical addressing */
 	if ( ( rc = elf_segments ( image, ehdr, elfboot_check_segment,
-				   &entry, &max ) ) != 0 ) {
+				   NULL, &entry, &max ) ) != 0 ) {
 		DBGC ( image, "ELF %s is not loadable: %s\n",
 		       image->name, strerror ( rc ) );
 		return rc;
@@ -55,6 +55,7 @@ static physaddr_t initrd_squash_high ( physaddr_t top ) {
 	struct image *initrd;
 	struct image *highest;
 	void *data;
+	size_t hlen;
 	size_t len;
 
 	/* Squash up any initrds already within or below the region */
@@ -73,32 +74,49 @@ static physaddr_t initrd_squash_high ( physaddr_t top ) {
 		if ( ! highest )
 			break;
 
-		/* Move this image to its final position */
-		len = ( ( highest->len + INITRD_ALIGN - 1 ) &
+		/* Move this image to its final position (unless it is
+		 * already in place, in which case no data needs to
+		 * move: downloaded images are typically allocated
+		 * downwards from the top of memory in registration
+		 * order, and so tend to be in their final squashed
+		 * positions already).
+		 *
+		 * Each image's slot includes headroom below the image
+		 * body for any CPIO headers to be constructed later,
+		 * so that constructing the headers in situ does not
+		 * require moving the image body.
+		 */
+		hlen = cpio_headers_len ( highest );
+		len = ( ( hlen + highest->len + INITRD_ALIGN - 1 ) &
 			~( INITRD_ALIGN - 1 ) );
 		current -= len;
-		DBGC ( &images, "INITRD squashing %s [%#08lx,%#08lx)->"
-		       "[%#08lx,%#08lx)\n", highest->name,
-		       virt_to_phys ( highest->data ),
-		       ( virt_to_phys ( highest->data ) + highest->len ),
-		       current, ( current + highest->len ) );
-		data = phys_to_virt ( current );
-		memmove ( data, highest->data, highest->len );
-		highest->data = data;
+		data = ( phys_to_virt ( current ) + hlen );
+		if ( data != highest->data ) {
+			DBGC ( &images, "INITRD squashing %s [%#08lx,%#08lx)->"
+			       "[%#08lx,%#08lx)\n", highest->name,
+			       virt_to_phys ( highest->data ),
+			       ( virt_to_phys ( highest->data ) + highest->len ),
+			       virt_to_phys ( data ),
+			       ( virt_to_phys ( data ) + highest->len ) );
+			memmove ( data, highest->data, highest->len );
+			highest->data = data;
+		}
 	}
 
 	/* Copy any remaining initrds (e.g. embedded images) to the region */
 	for_each_image ( initrd ) {
 		if ( virt_to_phys ( initrd->data ) >= top ) {
-			len = ( ( initrd->len + INITRD_ALIGN - 1 ) &
+			hlen = cpio_headers_len ( initrd );
+			len = ( ( hlen + initrd->len + INITRD_ALIGN - 1 ) &
 				~( INITRD_ALIGN - 1 ) );
 			current -= len;
+			data = ( phys_to_virt ( current ) + hlen );
 			DBGC ( &images, "INITRD copying %s [%#08lx,%#08lx)->"
 			       "[%#08lx,%#08lx)\n", initrd->name,
 			       virt_to_phys ( initrd->data ),
 			       ( virt_to_phys ( initrd->data ) + initrd->len ),
-			       current, ( current + initrd->len ) );
-			data = phys_to_virt ( current );
+			       virt_to_phys ( data ),
+			       ( virt_to_phys ( data ) + initrd->len ) );
 			memcpy ( data, initrd->data, initrd->len );
 			initrd->data = data;
 		}
@@ -117,9 +135,15 @@ static physaddr_t initrd_squash_high ( physaddr_t top ) {
  */
 static void initrd_swap ( struct image *low, struct image *high,
 			  void *free, size_t free_len ) {
-	size_t len = 0;
+	size_t low_hlen = cpio_headers_len ( low );
+	size_t high_hlen = cpio_headers_len ( high );
+	size_t high_slot = ( ( high_hlen + high->len + INITRD_ALIGN - 1 ) &
+			     ~( INITRD_ALIGN - 1 ) );
+	void *base = ( low->rwdata - low_hlen );
+	size_t done = 0;
+	size_t shifted = 0;
 	size_t frag_len;
-	size_t new_len;
+	ssize_t shift;
 
 	DBGC ( &images, "INITRD swapping %s [%#08lx,%#08lx)<->[%#08lx,%#08lx) "
 	       "%s\n", low->name, virt_to_phys ( low->data ),
@@ -132,26 +156,39 @@ static void initrd_swap ( struct image *low, struct image *high,
 	assert ( free_len > 0 );
 
 	/* Swap image data */
-	while ( len < high->len ) {
+	while ( done < high->len ) {
 
 		/* Calculate maximum fragment length */
-		frag_len = ( high->len - len );
+		frag_len = ( high->len - done );
 		if ( frag_len > free_len )
 			frag_len = free_len;
-		new_len = ( ( len + frag_len + INITRD_ALIGN - 1 ) &
-			    ~( INITRD_ALIGN - 1 ) );
-
-		/* Swap fragments */
-		memcpy ( free, ( high->data + len ), frag_len );
-		memmove ( ( low->rwdata + new_len ), ( low->data + len ),
-			  low->len );
-		memcpy ( ( low->rwdata + len ), free, frag_len );
-		len = new_len;
+
+		/* Calculate distance by which to shift the lower
+		 * image upwards: sufficient to vacate this fragment's
+		 * destination (including the higher image's CPIO
+		 * header headroom), and equal to the higher image's
+		 * total slot length once the final fragment has been
+		 * copied out to the free space.
+		 */
+		shift = ( ( ( ssize_t ) ( high_hlen + done + frag_len ) ) -
+			  ( ( ssize_t ) low_hlen ) );
+		if ( shift < ( ( ssize_t ) shifted ) )
+			shift = shifted;
+		if ( ( done + frag_len ) == high->len )
+			shift = high_slot;
+
+		/* Swap fragment */
+		memcpy ( free, ( high->data + done ), frag_len );
+		memmove ( ( base + low_hlen + shift ),
+			  ( base + low_hlen + shifted ), low->len );
+		memcpy ( ( base + high_hlen + done ), free, frag_len );
+		done += frag_len;
+		shifted = shift;
 	}
 
 	/* Adjust data pointers */
-	high->data = low->data;
-	low->data += len;
+	high->data = ( base + high_hlen );
+	low->data = ( base + high_slot + low_hlen );
 }
 
 /**
@@ -164,16 +201,19 @@ static void initrd_swap ( struct image *low, struct image *high,
 static int initrd_swap_any ( void *free, size_t free_len ) {
 	struct image *low;
 	struct image *high;
+	const void *slot;
 	const void *adjacent;
-	size_t padded_len;
+	size_t slot_len;
+	size_t hlen;
 
 	/* Find any pair of initrds that can be swapped */
 	for_each_image ( low ) {
 
-		/* Calculate location of adjacent image (if any) */
-		padded_len = ( ( low->len + INITRD_ALIGN - 1 ) &
-			       ~( INITRD_ALIGN - 1 ) );
-		adjacent = ( low->data + padded_len );
+		/* Calculate location of adjacent image's slot (if any) */
+		hlen = cpio_headers_len ( low );
+		slot_len = ( ( hlen + low->len + INITRD_ALIGN - 1 ) &
+			     ~( INITRD_ALIGN - 1 ) );
+		slot = ( low->data - hlen + slot_len );
 
 		/* Search for adjacent image */
 		for_each_image ( high ) {
@@ -186,6 +226,7 @@ static int initrd_swap_any ( void *free, size_t free_len ) {
 				break;
 
 			/* If we have found the adjacent image, swap and exit */
+			adjacent = ( slot + cpio_headers_len ( high ) );
 			if ( high->data == adjacent ) {
 				initrd_swap ( low, high, free, free_len );
 				return 1;
@@ -222,6 +263,11 @@ static void initrd_dump ( void ) {
  * Reshuffle initrds into desired order at top of memory
  *
  * @v bottom		Lowest physical address available for initrds
+ * @ret top		Highest physical address used (zero if no initrds)
+ *
+ * Each initrd is left with headroom below it sufficient to hold its
+ * CPIO headers, so that the headers can subsequently be constructed
+ * in situ without moving the initrd contents.
  *
  * After this function returns, the initrds have been rearranged in
  * memory and the external heap structures will have been corrupted.
@@ -229,7 +275,7 @@ static void initrd_dump ( void ) {
  * to the loaded OS kernel; no further execution within iPXE is
  * permitted.
  */
-void initrd_reshuffle ( physaddr_t bottom ) {
+physaddr_t initrd_reshuffle ( physaddr_t bottom ) {
 	physaddr_t top;
 	physaddr_t used;
 	void *free;
@@ -256,6 +302,8 @@ void initrd_reshuffle ( physaddr_t bottom ) {
 
 	/* Debug */
 	initrd_dump();
+
+	return ( ( used < top ) ? top : 0 );
 }
 
 /**
@@ -183,10 +183,14 @@ static int multiboot_add_modules ( struct image *image, physaddr_t start,
 				   struct multiboot_info *mbinfo,
 				   struct multiboot_module *modules,
 				   unsigned int limit ) {
+	struct memory_map memmap;
 	struct image *module_image;
 	struct multiboot_module *module;
 	int rc;
 
+	/* Fetch the memory map once for all modules */
+	get_memmap ( &memmap );
+
 	/* Add each image as a multiboot module */
 	for_each_image ( module_image ) {
 
@@ -206,7 +210,8 @@ static int multiboot_add_modules ( struct image *image, physaddr_t start,
 		/* Prepare segment */
 		if ( ( rc = prep_segment ( phys_to_virt ( start ),
 					   module_image->len,
-					   module_image->len ) ) != 0 ) {
+					   module_image->len,
+					   &memmap ) ) != 0 ) {
 			DBGC ( image, "MULTIBOOT %s could not prepare module "
 			       "%s: %s\n", image->name, module_image->name,
 			       strerror ( rc ) );
@@ -342,7 +347,7 @@ static int multiboot_load_raw ( struct image *image, size_t offset,
 
 	/* Verify and prepare segment */
 	buffer = phys_to_virt ( mb->load_addr );
-	if ( ( rc = prep_segment ( buffer, filesz, memsz ) ) != 0 ) {
+	if ( ( rc = prep_segment ( buffer, filesz, memsz, NULL ) ) != 0 ) {
 		DBGC ( image, "MULTIBOOT %s could not prepare segment: %s\n",
 		       image->name, strerror ( rc ) );
 		return rc;
@@ -110,7 +110,7 @@ static int nbi_prepare_segment ( struct image *image, size_t offset __unused,
 				 void *dest, size_t filesz, size_t memsz ) {
 	int rc;
 
-	if ( ( rc = prep_segment ( dest, filesz, memsz ) ) != 0 ) {
+	if ( ( rc = prep_segment ( dest, filesz, memsz, NULL ) ) != 0 ) {
 		DBGC ( image, "NBI %p could not prepare segment: %s\n",
 		       image, strerror ( rc ) );
 		return rc;
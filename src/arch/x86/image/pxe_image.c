@@ -59,7 +59,8 @@ static int pxe_exec ( struct image *image ) {
 	int rc;
 
 	/* Verify and prepare segment */
-	if ( ( rc = prep_segment ( buffer, image->len, image->len ) ) != 0 ) {
+	if ( ( rc = prep_segment ( buffer, image->len, image->len,
+				   NULL ) ) != 0 ) {
 		DBGC ( image, "IMAGE %p could not prepare segment: %s\n",
 		       image, strerror ( rc ) );
 		return rc;
@@ -11,8 +11,30 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdint.h>
 #include <string.h>
 
-/** Element of a big integer */
-typedef uint32_t bigint_element_t;
+/** Element of a big integer
+ *
+ * Using full-width native elements halves the number of iterations
+ * (and quarters the number of element multiplications) on 64-bit
+ * builds, which substantially speeds up RSA and elliptic curve
+ * operations.
+ */
+typedef unsigned long bigint_element_t;
+
+#ifdef __x86_64__
+/** Instruction suffix for element-sized operations */
+#define BIGINT_SFX "q"
+/** Element size (as an assembly scale factor or displacement) */
+#define BIGINT_ESZ "8"
+/** Element-sized accumulator register */
+#define BIGINT_ACC "%%rax"
+#else
+/** Instruction suffix for element-sized operations */
+#define BIGINT_SFX "l"
+/** Element size (as an assembly scale factor or displacement) */
+#define BIGINT_ESZ "4"
+/** Element-sized accumulator register */
+#define BIGINT_ACC "%%eax"
+#endif
 
 /**
  * Initialise big integer
@@ -23,7 +45,7 @@ typedef uint32_t bigint_element_t;
  * @v len		Length of raw data
  */
 static inline __attribute__ (( always_inline )) void
-bigint_init_raw ( uint32_t *value0, unsigned int size,
+bigint_init_raw ( unsigned long *value0, unsigned int size,
 		  const void *data, size_t len ) {
 	bigint_t ( size ) __attribute__ (( may_alias )) *value =
 		( ( void * ) value0 );
@@ -55,7 +77,7 @@ bigint_init_raw ( uint32_t *value0, unsigned int size,
  * @ret carry		Carry flag
  */
 static inline __attribute__ (( always_inline )) int
-bigint_add_raw ( const uint32_t *addend0, uint32_t *value0,
+bigint_add_raw ( const unsigned long *addend0, unsigned long *value0,
 		 unsigned int size ) {
 	bigint_t ( size ) __attribute__ (( may_alias )) *value =
 		( ( void * ) value0 );
@@ -66,8 +88,9 @@ bigint_add_raw ( const uint32_t *addend0, uint32_t *value0,
 
 	__asm__ __volatile__ ( "xor %0, %0\n\t" /* Zero %0 and clear CF */
 			       "\n1:\n\t"
-			       "lodsl\n\t"
-			       "adcl %%eax, (%5,%0,4)\n\t"
+			       "lods" BIGINT_SFX "\n\t"
+			       "adc" BIGINT_SFX " " BIGINT_ACC
+			       ", (%5,%0," BIGINT_ESZ ")\n\t"
 			       "inc %0\n\t" /* Does not affect CF */
 			       "loop 1b\n\t"
 			       : "=&r" ( index ), "=&S" ( discard_S ),
@@ -87,7 +110,7 @@ bigint_add_raw ( const uint32_t *addend0, uint32_t *value0,
  * @ret borrow		Borrow flag
  */
 static inline __attribute__ (( always_inline )) int
-bigint_subtract_raw ( const uint32_t *subtrahend0, uint32_t *value0,
+bigint_subtract_raw ( const unsigned long *subtrahend0, unsigned long *value0,
 		      unsigned int size ) {
 	bigint_t ( size ) __attribute__ (( may_alias )) *value =
 		( ( void * ) value0 );
@@ -98,8 +121,9 @@ bigint_subtract_raw ( const uint32_t *subtrahend0, uint32_t *value0,
 
 	__asm__ __volatile__ ( "xor %0, %0\n\t" /* Zero %0 and clear CF */
 			       "\n1:\n\t"
-			       "lodsl\n\t"
-			       "sbbl %%eax, (%5,%0,4)\n\t"
+			       "lods" BIGINT_SFX "\n\t"
+			       "sbb" BIGINT_SFX " " BIGINT_ACC
+			       ", (%5,%0," BIGINT_ESZ ")\n\t"
 			       "inc %0\n\t" /* Does not affect CF */
 			       "loop 1b\n\t"
 			       : "=&r" ( index ), "=&S" ( discard_S ),
@@ -119,7 +143,7 @@ bigint_subtract_raw ( const uint32_t *subtrahend0, uint32_t *value0,
  * @ret out		Bit shifted out
  */
 static inline __attribute__ (( always_inline )) int
-bigint_shl_raw ( uint32_t *value0, unsigned int size ) {
+bigint_shl_raw ( unsigned long *value0, unsigned int size ) {
 	bigint_t ( size ) __attribute__ (( may_alias )) *value =
 		( ( void * ) value0 );
 	long index;
@@ -128,7 +152,8 @@ bigint_shl_raw ( uint32_t *value0, unsigned int size ) {
 
 	__asm__ __volatile__ ( "xor %0, %0\n\t" /* Zero %0 and clear CF */
 			       "\n1:\n\t"
-			       "rcll $1, (%4,%0,4)\n\t"
+			       "rcl" BIGINT_SFX " $1, (%4,%0,"
+			       BIGINT_ESZ ")\n\t"
 			       "inc %0\n\t" /* Does not affect CF */
 			       "loop 1b\n\t"
 			       : "=&r" ( index ), "=&c" ( discard_c ),
@@ -145,7 +170,7 @@ bigint_shl_raw ( uint32_t *value0, unsigned int size ) {
  * @ret out		Bit shifted out
  */
 static inline __attribute__ (( always_inline )) int
-bigint_shr_raw ( uint32_t *value0, unsigned int size ) {
+bigint_shr_raw ( unsigned long *value0, unsigned int size ) {
 	bigint_t ( size ) __attribute__ (( may_alias )) *value =
 		( ( void * ) value0 );
 	long discard_c;
@@ -153,7 +178,8 @@ bigint_shr_raw ( uint32_t *value0, unsigned int size ) {
 
 	__asm__ __volatile__ ( "clc\n\t"
 			       "\n1:\n\t"
-			       "rcrl $1, -4(%3,%0,4)\n\t"
+			       "rcr" BIGINT_SFX " $1, -" BIGINT_ESZ
+			       "(%3,%0," BIGINT_ESZ ")\n\t"
 			       "loop 1b\n\t"
 			       : "=&c" ( discard_c ), "=@ccc" ( out ),
 				 "+m" ( *value )
@@ -169,13 +195,13 @@ bigint_shr_raw ( uint32_t *value0, unsigned int size ) {
  * @ret is_zero		Big integer is equal to zero
  */
 static inline __attribute__ (( always_inline, pure )) int
-bigint_is_zero_raw ( const uint32_t *value0, unsigned int size ) {
+bigint_is_zero_raw ( const unsigned long *value0, unsigned int size ) {
 	void *discard_D;
 	long discard_c;
 	int result;
 
 	__asm__ __volatile__ ( "xor %0, %0\n\t" /* Set ZF */
-			       "repe scasl\n\t"
+			       "repe scas" BIGINT_SFX "\n\t"
 			       "sete %b0\n\t"
 			       : "=&a" ( result ), "=&D" ( discard_D ),
 				 "=&c" ( discard_c )
@@ -192,15 +218,17 @@ bigint_is_zero_raw ( const uint32_t *value0, unsigned int size ) {
  * @ret geq		Big integer is greater than or equal to the reference
  */
 static inline __attribute__ (( always_inline, pure )) int
-bigint_is_geq_raw ( const uint32_t *value0, const uint32_t *reference0,
-		    unsigned int size ) {
+bigint_is_geq_raw ( const unsigned long *value0,
+		    const unsigned long *reference0, unsigned int size ) {
 	long discard_c;
 	long discard_tmp;
 	int result;
 
 	__asm__ __volatile__ ( "\n1:\n\t"
-			       "movl -4(%3, %1, 4), %k2\n\t"
-			       "cmpl -4(%4, %1, 4), %k2\n\t"
+			       "mov" BIGINT_SFX " -" BIGINT_ESZ
+			       "(%3, %1, " BIGINT_ESZ "), %2\n\t"
+			       "cmp" BIGINT_SFX " -" BIGINT_ESZ
+			       "(%4, %1, " BIGINT_ESZ "), %2\n\t"
 			       "loope 1b\n\t"
 			       "setae %b0\n\t"
 			       : "=q" ( result ), "=&c" ( discard_c ),
@@ -218,15 +246,19 @@ bigint_is_geq_raw ( const uint32_t *value0, const uint32_t *reference0,
  * @ret max_bit		Highest bit set + 1 (or 0 if no bits set)
  */
 static inline __attribute__ (( always_inline )) int
-bigint_max_set_bit_raw ( const uint32_t *value0, unsigned int size ) {
+bigint_max_set_bit_raw ( const unsigned long *value0, unsigned int size ) {
 	long discard_c;
-	int result;
+	long result;
 
 	__asm__ __volatile__ ( "\n1:\n\t"
-			       "bsrl -4(%2,%1,4), %0\n\t"
+			       "bsr" BIGINT_SFX " -" BIGINT_ESZ
+			       "(%2,%1," BIGINT_ESZ "), %0\n\t"
 			       "loopz 1b\n\t"
 			       "rol %1\n\t" /* Does not affect ZF */
 			       "rol %1\n\t"
+#ifdef __x86_64__
+			       "rol %1\n\t"
+#endif
 			       "leal 1(%k0,%k1,8), %k0\n\t"
 			       "jnz 2f\n\t"
 			       "xor %0, %0\n\t"
@@ -245,8 +277,8 @@ bigint_max_set_bit_raw ( const uint32_t *value0, unsigned int size ) {
  * @v dest_size		Number of elements in destination big integer
  */
 static inline __attribute__ (( always_inline )) void
-bigint_grow_raw ( const uint32_t *source0, unsigned int source_size,
-		  uint32_t *dest0, unsigned int dest_size ) {
+bigint_grow_raw ( const unsigned long *source0, unsigned int source_size,
+		  unsigned long *dest0, unsigned int dest_size ) {
 	bigint_t ( dest_size ) __attribute__ (( may_alias )) *dest =
 		( ( void * ) dest0 );
 	long pad_size = ( dest_size - source_size );
@@ -254,10 +286,10 @@ bigint_grow_raw ( const uint32_t *source0, unsigned int source_size,
 	void *discard_S;
 	long discard_c;
 
-	__asm__ __volatile__ ( "rep movsl\n\t"
+	__asm__ __volatile__ ( "rep movs" BIGINT_SFX "\n\t"
 			       "xorl %%eax, %%eax\n\t"
 			       "mov %4, %2\n\t"
-			       "rep stosl\n\t"
+			       "rep stos" BIGINT_SFX "\n\t"
 			       : "=&D" ( discard_D ), "=&S" ( discard_S ),
 				 "=&c" ( discard_c ), "+m" ( *dest )
 			       : "g" ( pad_size ), "0" ( dest0 ),
@@ -274,15 +306,16 @@ bigint_grow_raw ( const uint32_t *source0, unsigned int source_size,
  * @v dest_size		Number of elements in destination big integer
  */
 static inline __attribute__ (( always_inline )) void
-bigint_shrink_raw ( const uint32_t *source0, unsigned int source_size __unused,
-		    uint32_t *dest0, unsigned int dest_size ) {
+bigint_shrink_raw ( const unsigned long *source0,
+		    unsigned int source_size __unused,
+		    unsigned long *dest0, unsigned int dest_size ) {
 	bigint_t ( dest_size ) __attribute__ (( may_alias )) *dest =
 		( ( void * ) dest0 );
 	void *discard_D;
 	void *discard_S;
 	long discard_c;
 
-	__asm__ __volatile__ ( "rep movsl\n\t"
+	__asm__ __volatile__ ( "rep movs" BIGINT_SFX "\n\t"
 			       : "=&D" ( discard_D ), "=&S" ( discard_S ),
 				 "=&c" ( discard_c ), "+m" ( *dest )
 			       : "0" ( dest0 ), "1" ( source0 ),
@@ -299,7 +332,7 @@ bigint_shrink_raw ( const uint32_t *source0, unsigned int source_size __unused,
  * @v len		Length of output buffer
  */
 static inline __attribute__ (( always_inline )) void
-bigint_done_raw ( const uint32_t *value0, unsigned int size __unused,
+bigint_done_raw ( const unsigned long *value0, unsigned int size __unused,
 		  void *out, size_t len ) {
 	struct {
 		uint8_t bytes[len];
@@ -327,18 +360,19 @@ bigint_done_raw ( const uint32_t *value0, unsigned int size __unused,
  * @v carry		Carry element
  */
 static inline __attribute__ (( always_inline )) void
-bigint_multiply_one ( const uint32_t multiplicand, const uint32_t multiplier,
-		      uint32_t *result, uint32_t *carry ) {
-	uint32_t discard_a;
+bigint_multiply_one ( const unsigned long multiplicand,
+		      const unsigned long multiplier,
+		      unsigned long *result, unsigned long *carry ) {
+	unsigned long discard_a;
 
 	__asm__ __volatile__ ( /* Perform multiplication */
-			       "mull %3\n\t"
+			       "mul" BIGINT_SFX " %3\n\t"
 			       /* Accumulate carry */
-			       "addl %5, %0\n\t"
-			       "adcl $0, %1\n\t"
+			       "add" BIGINT_SFX " %5, %0\n\t"
+			       "adc" BIGINT_SFX " $0, %1\n\t"
 			       /* Accumulate result */
-			       "addl %0, %2\n\t"
-			       "adcl $0, %1\n\t"
+			       "add" BIGINT_SFX " %0, %2\n\t"
+			       "adc" BIGINT_SFX " $0, %1\n\t"
 			       : "=&a" ( discard_a ),
 				 "=&d" ( *carry ),
 				 "+m" ( *result )
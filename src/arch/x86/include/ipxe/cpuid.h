@@ -42,6 +42,15 @@ struct x86_features {
 /** Get standard features */
 #define CPUID_FEATURES 0x00000001UL
 
+/** PCLMULQDQ instruction is supported */
+#define CPUID_FEATURES_INTEL_ECX_PCLMULQDQ 0x00000002UL
+
+/** SSE4.2 instructions (including crc32) are supported */
+#define CPUID_FEATURES_INTEL_ECX_SSE42 0x00100000UL
+
+/** AES instructions are supported */
+#define CPUID_FEATURES_INTEL_ECX_AES 0x02000000UL
+
 /** RDRAND instruction is supported */
 #define CPUID_FEATURES_INTEL_ECX_RDRAND 0x40000000UL
 
@@ -54,6 +63,27 @@ struct x86_features {
 /** FXSAVE and FXRSTOR are supported */
 #define CPUID_FEATURES_INTEL_EDX_FXSR 0x01000000UL
 
+/** Get structured extended features */
+#define CPUID_SEF 0x00000007UL
+
+/** Enhanced REP MOVSB/STOSB is supported */
+#define CPUID_SEF_EBX_ERMS 0x00000200UL
+
+/** RDSEED instruction is supported */
+#define CPUID_SEF_EBX_RDSEED 0x00040000UL
+
+/** SHA extensions are supported */
+#define CPUID_SEF_EBX_SHA 0x20000000UL
+
+/** Get TSC and core crystal clock information */
+#define CPUID_TSC_CRYSTAL 0x00000015UL
+
+/** Get processor frequency information */
+#define CPUID_FREQUENCY 0x00000016UL
+
+/** Get hypervisor timing information */
+#define CPUID_HYPERVISOR_TIMING 0x40000010UL
+
 /** Get largest extended function */
 #define CPUID_AMD_MAX_FN 0x80000000UL
 
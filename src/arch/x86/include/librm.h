@@ -125,6 +125,7 @@ extern char * const text16;
 /* Variables in librm.S, present in the normal data segment */
 extern uint16_t rm_sp;
 extern uint16_t rm_ss;
+extern uint32_t librm_transitions;
 extern const uint16_t __text16 ( rm_cs );
 #define rm_cs __use_text16 ( rm_cs )
 extern const uint16_t __text16 ( rm_ds );
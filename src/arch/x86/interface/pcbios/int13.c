@@ -37,6 +37,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/device.h>
 #include <ipxe/pci.h>
 #include <ipxe/eltorito.h>
+#include <ipxe/profile.h>
 #include <realmode.h>
 #include <bios.h>
 #include <biosint.h>
@@ -97,6 +98,26 @@ struct int13_data {
 	int last_status;
 };
 
+/** INT 13 read call profiler
+ *
+ * Every INT 13 call serviced by iPXE costs a real-to-protected mode
+ * transition (and back) through librm.  The call counts recorded by
+ * these profilers therefore also record the number of mode transition
+ * round trips incurred while servicing disk I/O, which is useful for
+ * verifying that the SAN device readahead cache is absorbing most
+ * reads into a single bounce-buffer copy per transition.
+ */
+static struct profiler int13_read_profiler __profiler =
+	{ .name = "int13.read" };
+
+/** INT 13 write call profiler */
+static struct profiler int13_write_profiler __profiler =
+	{ .name = "int13.write" };
+
+/** Miscellaneous INT 13 call profiler */
+static struct profiler int13_misc_profiler __profiler =
+	{ .name = "int13.misc" };
+
 /** Vector for chaining to other INT 13 handlers */
 static struct segoff __text16 ( int13_vector );
 #define int13_vector __use_text16 ( int13_vector )
@@ -1067,6 +1088,27 @@ static int int13_cdrom_read_boot_catalog ( struct san_device *sandev,
 	return 0;
 }
 
+/**
+ * Determine applicable profiler (for debugging)
+ *
+ * @v command		INT 13 command
+ * @ret profiler	Profiler
+ */
+static struct profiler * int13_profiler ( int command ) {
+
+	/* Determine applicable profiler */
+	switch ( command ) {
+	case INT13_READ_SECTORS:
+	case INT13_EXTENDED_READ:
+		return &int13_read_profiler;
+	case INT13_WRITE_SECTORS:
+	case INT13_EXTENDED_WRITE:
+		return &int13_write_profiler;
+	default:
+		return &int13_misc_profiler;
+	}
+}
+
 /**
  * INT 13 handler
  *
@@ -1074,6 +1116,7 @@ static int int13_cdrom_read_boot_catalog ( struct san_device *sandev,
 static __asmcall __used void int13 ( struct i386_all_regs *ix86 ) {
 	int command = ix86->regs.ah;
 	unsigned int bios_drive = ix86->regs.dl;
+	struct profiler *profiler = int13_profiler ( command );
 	struct san_device *sandev;
 	struct int13_data *int13;
 	int status;
@@ -1104,6 +1147,7 @@ static __asmcall __used void int13 ( struct i386_all_regs *ix86 ) {
 		DBGC2 ( sandev->drive, "INT13,%02x (%02x): ",
 			ix86->regs.ah, bios_drive );
 
+		profile_start ( profiler );
 		switch ( command ) {
 		case INT13_RESET:
 			status = int13_reset ( sandev, ix86 );
@@ -1152,6 +1196,7 @@ static __asmcall __used void int13 ( struct i386_all_regs *ix86 ) {
 			status = -INT13_STATUS_INVALID;
 			break;
 		}
+		profile_stop ( profiler );
 
 		/* Store status for INT 13,01 */
 		int13->last_status = status;
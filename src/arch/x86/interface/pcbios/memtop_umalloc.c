@@ -45,6 +45,32 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Alignment of external allocated memory */
 #define EM_ALIGN ( 4 * 1024 )
 
+/** Alignment of large external allocated memory blocks
+ *
+ * Large blocks (such as downloaded image buffers) are aligned to
+ * 2MB extents so that subsequent whole-image copies and relocations
+ * (e.g. the bzImage initrd reshuffle) remain aligned to huge page
+ * boundaries throughout.  As a side effect, a block growing via
+ * repeated urealloc() calls is moved in 2MB steps rather than on
+ * every call.
+ *
+ * This is a policy decision.
+ */
+#ifndef EM_ALIGN_LARGE
+#define EM_ALIGN_LARGE ( 2 * 1024 * 1024 )
+#endif
+
+/**
+ * Determine alignment for an external memory block
+ *
+ * @v size		Requested size
+ * @ret align		Alignment
+ */
+static inline size_t em_align ( size_t size ) {
+
+	return ( ( size >= EM_ALIGN_LARGE ) ? EM_ALIGN_LARGE : EM_ALIGN );
+}
+
 /** An external memory block */
 struct external_memory {
 	/** Size of this memory block (excluding this header) */
@@ -160,6 +186,7 @@ static void ecollect_free ( void ) {
 static void * memtop_urealloc ( void *ptr, size_t new_size ) {
 	struct external_memory extmem;
 	void *new = ptr;
+	size_t old_size;
 	size_t align;
 
 	/* (Re)initialise external memory allocator if necessary */
@@ -183,13 +210,14 @@ static void * memtop_urealloc ( void *ptr, size_t new_size ) {
 		      virt_to_phys ( ptr ), virt_to_phys ( ptr ) );
 		extmem.size = 0;
 	}
+	old_size = extmem.size;
 	extmem.used = ( new_size > 0 );
 
 	/* Expand/shrink block if possible */
 	if ( ptr == bottom ) {
 		/* Update block */
 		new = ( ptr - ( new_size - extmem.size ) );
-		align = ( virt_to_phys ( new ) & ( EM_ALIGN - 1 ) );
+		align = ( virt_to_phys ( new ) & ( em_align ( new_size ) - 1 ) );
 		new_size += align;
 		new -= align;
 		if ( new_size > ( heap_size + extmem.size ) ) {
@@ -220,6 +248,9 @@ static void * memtop_urealloc ( void *ptr, size_t new_size ) {
 	/* Write back block properties */
 	memcpy ( ( new - sizeof ( extmem ) ), &extmem, sizeof ( extmem ) );
 
+	/* Update external memory usage statistics */
+	umalloc_account ( old_size, ( new_size ? extmem.size : 0 ) );
+
 	/* Collect any free blocks and update hidden memory region */
 	ecollect_free();
 	hide_umalloc ( ( virt_to_phys ( bottom ) -
@@ -56,6 +56,28 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  */
 static int undi_tx_count = 0;
 
+/** Number of transmit buffers to advertise
+ *
+ * PXENV_UNDI_TRANSMIT enqueues packets via netdev_tx() and reports
+ * completions asynchronously via PXENV_UNDI_ISR, so an NBP may have
+ * several transmissions outstanding at once.  Advertise a modest
+ * count so that spec-following NBPs pipeline transmits instead of
+ * waiting for each completion in turn.  This is a policy decision.
+ */
+#ifndef UNDI_TX_BUF_CNT
+#define UNDI_TX_BUF_CNT 8
+#endif
+
+/** Number of receive buffers to advertise
+ *
+ * Received packets accumulate on the frozen netdev RX queue until the
+ * NBP retrieves them via PXENV_UNDI_ISR; there is no single-buffer
+ * restriction.  This is a policy decision.
+ */
+#ifndef UNDI_RX_BUF_CNT
+#define UNDI_RX_BUF_CNT 8
+#endif
+
 struct net_device *pxe_netdev = NULL;
 
 /** Transmit profiler */
@@ -575,11 +597,8 @@ pxenv_undi_get_information ( struct s_PXENV_UNDI_GET_INFORMATION
 				 &undi_get_information->PermNodeAddress );
 	undi_get_information->ROMAddress = 0;
 		/* nic.rom_info->rom_segment; */
-	/* We only provide the ability to receive or transmit a single
-	 * packet at a time.  This is a bootloader, not an OS.
-	 */
-	undi_get_information->RxBufCt = 1;
-	undi_get_information->TxBufCt = 1;
+	undi_get_information->RxBufCt = UNDI_RX_BUF_CNT;
+	undi_get_information->TxBufCt = UNDI_TX_BUF_CNT;
 
 	DBGC ( &pxe_netdev, " io %04x irq %d mtu %d %s %s\n",
 	       undi_get_information->BaseIo, undi_get_information->IntNumber,
@@ -930,9 +949,15 @@ static PXENV_EXIT_t pxenv_undi_isr ( struct s_PXENV_UNDI_ISR *undi_isr ) {
 		 * they just sit in a tight polling loop merrily
 		 * violating the PXE spec with repeated calls to
 		 * PXENV_UNDI_ISR_IN_PROCESS.  Force extra polls to
-		 * cope with these out-of-spec clients.
+		 * cope with these out-of-spec clients, but only when
+		 * no received packets remain queued: draining the
+		 * queue first coalesces a single poll (and interrupt
+		 * acknowledgement) across a whole batch of received
+		 * frames, rather than repolling the hardware once per
+		 * delivered frame.
 		 */
-		net_poll();
+		if ( list_empty ( &pxe_netdev->rx_queue ) )
+			net_poll();
 
 		/* If we have not yet marked a TX as complete, and the
 		 * netdev TX queue is empty, report the TX completion.
@@ -75,6 +75,10 @@ static void librm_test_exec ( void ) {
 	uint32_t started;
 	uint32_t stopped;
 	uint32_t discard_d;
+	uint32_t transitions;
+
+	/* Record mode transition count */
+	transitions = librm_transitions;
 
 	/* Profile mode transitions.  We want to profile each
 	 * direction of the transition separately, so perform an RDTSC
@@ -113,6 +117,12 @@ static void librm_test_exec ( void ) {
 		profile_start_at ( &virt_call_profiler, started );
 		profile_stop_at ( &virt_call_profiler, stopped );
 	}
+
+	/* Check that the transition counter advanced by at least one
+	 * transition per real-mode call (interrupts may add more).
+	 */
+	ok ( ( ( uint32_t ) ( librm_transitions - transitions ) ) >=
+	     ( 3 * PROFILE_COUNT ) );
 }
 
 /** Real mode transition self-test */
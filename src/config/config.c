@@ -137,6 +137,12 @@ REQUIRE_OBJECT ( iscsi );
 #ifdef SANBOOT_PROTO_HTTP
 REQUIRE_OBJECT ( httpblock );
 #endif
+#ifdef SANBOOT_PROTO_NVME
+REQUIRE_OBJECT ( nvme );
+#endif
+#ifdef SANBOOT_PROTO_NVMETCP
+REQUIRE_OBJECT ( nvmetcp );
+#endif
 
 /*
  * Drag in all requested resolvers
@@ -191,6 +197,9 @@ REQUIRE_OBJECT ( zlib );
 #ifdef IMAGE_GZIP
 REQUIRE_OBJECT ( gzip );
 #endif
+#ifdef IMAGE_ZSTD
+REQUIRE_OBJECT ( zstd );
+#endif
 #ifdef IMAGE_UCODE
 REQUIRE_OBJECT ( ucode );
 #endif
@@ -281,15 +290,24 @@ REQUIRE_OBJECT ( neighbour_cmd );
 #ifdef PING_CMD
 REQUIRE_OBJECT ( ping_cmd );
 #endif
+#ifdef NETBENCH_CMD
+REQUIRE_OBJECT ( netbench_cmd );
+#endif
 #ifdef CONSOLE_CMD
 REQUIRE_OBJECT ( console_cmd );
 #endif
 #ifdef IPSTAT_CMD
 REQUIRE_OBJECT ( ipstat_cmd );
 #endif
+#ifdef MEMSTAT_CMD
+REQUIRE_OBJECT ( memstat_cmd );
+#endif
 #ifdef PROFSTAT_CMD
 REQUIRE_OBJECT ( profstat_cmd );
 #endif
+#ifdef TIMELINE_CMD
+REQUIRE_OBJECT ( timeline_cmd );
+#endif
 #ifdef NTP_CMD
 REQUIRE_OBJECT ( ntp_cmd );
 #endif
@@ -319,6 +337,9 @@ REQUIRE_OBJECT ( fdt_cmd );
 #ifdef NULL_TRAP
 REQUIRE_OBJECT ( nulltrap );
 #endif
+#ifdef PROFSNAP
+REQUIRE_OBJECT ( profsnap );
+#endif
 #ifdef GDBSERIAL
 REQUIRE_OBJECT ( gdbidt );
 REQUIRE_OBJECT ( gdbserial );
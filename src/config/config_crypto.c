@@ -108,6 +108,30 @@ REQUIRE_OBJECT ( oid_aes_cbc );
 REQUIRE_OBJECT ( oid_aes_gcm );
 #endif
 
+/* Hardware-accelerated AES */
+#if defined ( CRYPTO_ACCEL_AES ) && \
+    ( defined ( __i386__ ) || defined ( __x86_64__ ) )
+REQUIRE_OBJECT ( aesni );
+#endif
+
+/* Hardware-accelerated GCM */
+#if defined ( CRYPTO_ACCEL_GCM ) && \
+    ( defined ( __i386__ ) || defined ( __x86_64__ ) )
+REQUIRE_OBJECT ( pclmul );
+#endif
+
+/* Hardware-accelerated SHA-256 */
+#if defined ( CRYPTO_ACCEL_SHA256 ) && \
+    ( defined ( __i386__ ) || defined ( __x86_64__ ) )
+REQUIRE_OBJECT ( shani );
+#endif
+
+/* Hardware-accelerated CRC32C */
+#if defined ( CRYPTO_ACCEL_CRC32C ) && \
+    ( defined ( __i386__ ) || defined ( __x86_64__ ) )
+REQUIRE_OBJECT ( sse42 );
+#endif
+
 /* RSA and MD5 */
 #if defined ( CRYPTO_PUBKEY_RSA ) && defined ( CRYPTO_DIGEST_MD5 )
 REQUIRE_OBJECT ( rsa_md5 );
@@ -30,6 +30,18 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** AES-GCM block cipher */
 #define CRYPTO_CIPHER_AES_GCM
 
+/** Hardware-accelerated AES (where supported by the CPU) */
+#define CRYPTO_ACCEL_AES
+
+/** Hardware-accelerated GCM (where supported by the CPU) */
+#define CRYPTO_ACCEL_GCM
+
+/** Hardware-accelerated SHA-256 (where supported by the CPU) */
+#define CRYPTO_ACCEL_SHA256
+
+/** Hardware-accelerated CRC32C (where supported by the CPU) */
+#define CRYPTO_ACCEL_CRC32C
+
 /** MD4 digest algorithm */
 //#define CRYPTO_DIGEST_MD4
 
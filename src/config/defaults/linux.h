@@ -33,6 +33,7 @@ FILE_LICENCE ( GPL2_OR_LATER );
 #define SANBOOT_PROTO_IB_SRP
 #define SANBOOT_PROTO_FCP
 #define SANBOOT_PROTO_HTTP
+#define SANBOOT_PROTO_NVMETCP
 
 #if defined ( __i386__ ) || defined ( __x86_64__ )
 #define ENTROPY_RDRAND
@@ -72,6 +72,8 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 //#undef	SANBOOT_PROTO_IB_SRP	/* Infiniband SCSI RDMA protocol */
 //#undef	SANBOOT_PROTO_FCP	/* Fibre Channel protocol */
 //#undef	SANBOOT_PROTO_HTTP	/* HTTP SAN protocol */
+//#undef	SANBOOT_PROTO_NVME	/* Local NVMe drives */
+//#undef	SANBOOT_PROTO_NVMETCP	/* NVMe/TCP protocol */
 
 /*
  * HTTP extensions
@@ -81,6 +83,8 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define HTTP_AUTH_DIGEST	/* Digest authentication */
 //#define HTTP_AUTH_NTLM	/* NTLM authentication */
 //#define HTTP_ENC_PEERDIST	/* PeerDist content encoding */
+//#define HTTP_ENC_GZIP		/* gzip content encoding */
+//#define HTTP_MUX		/* Striped multi-connection downloads */
 //#define HTTP_HACK_GCE		/* Google Compute Engine hacks */
 
 /*
@@ -128,6 +132,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 //#define	IMAGE_EFISIG		/* EFI signature list image support */
 //#define	IMAGE_ZLIB		/* ZLIB image support */
 //#define	IMAGE_GZIP		/* GZIP image support */
+//#define	IMAGE_ZSTD		/* Zstandard image support */
 //#define	IMAGE_UCODE		/* Microcode update image support */
 
 /*
@@ -164,9 +169,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 //#define PARAM_CMD		/* Request parameter commands */
 //#define NEIGHBOUR_CMD		/* Neighbour management commands */
 //#define PING_CMD		/* Ping command */
+//#define NETBENCH_CMD		/* Network benchmark command */
 //#define CONSOLE_CMD		/* Console command */
 //#define IPSTAT_CMD		/* IP statistics commands */
+//#define MEMSTAT_CMD		/* Memory statistics command */
 //#define PROFSTAT_CMD		/* Profiling commands */
+//#define TIMELINE_CMD		/* Boot timeline command */
 //#define NTP_CMD		/* NTP commands */
 //#define CERT_CMD		/* Certificate management commands */
 //#define IMAGE_MEM_CMD		/* Read memory command */
@@ -215,6 +223,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #undef	BUILD_ID		/* Include a custom build ID string,
 				 * e.g "test-foo" */
 #undef	NULL_TRAP		/* Attempt to catch NULL function calls */
+#undef	PROFSNAP		/* Continuous profiler export via syslog */
 #undef	GDBSERIAL		/* Remote GDB debugging over serial */
 #undef	GDBUDP			/* Remote GDB debugging over UDP
 				 * (both may be set) */
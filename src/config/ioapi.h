@@ -13,6 +13,9 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 //#undef	PCIAPI_PCBIOS		/* Access via PCI BIOS */
 //#define	PCIAPI_DIRECT		/* Direct access via Type 1 accesses */
+//#define	PCIAPI_CLOUD		/* Select ECAM, PCI BIOS, or Type 1 at
+//					   run time, preferring memory-mapped
+//					   ECAM access where available */
 
 #include <config/named.h>
 #include NAMED_CONFIG(ioapi.h)
@@ -25,6 +25,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <string.h>
 #include <errno.h>
+#include <ipxe/umalloc.h>
 #include <ipxe/image.h>
 
 /** @file
@@ -119,6 +120,21 @@ int image_extract_exec ( struct image *image ) {
 	/* Set auto-unregister flag */
 	extracted->flags |= IMAGE_AUTO_UNREGISTER;
 
+	/* The source archive is no longer needed once extraction has
+	 * completed.  If it is due to be unregistered automatically
+	 * (and so would be freed after execution in any case), then
+	 * free its data now so that the memory is available while the
+	 * extracted image is being executed.  Peak memory usage
+	 * during extraction itself cannot be reduced, since the
+	 * extractors require random access to the complete source.
+	 */
+	if ( ( image->flags & IMAGE_AUTO_UNREGISTER ) &&
+	     ( ! ( image->flags & IMAGE_STATIC ) ) ) {
+		ufree ( image->rwdata );
+		image->rwdata = NULL;
+		image->len = 0;
+	}
+
 	/* Tail-recurse into extracted image */
 	return image_exec ( extracted );
 
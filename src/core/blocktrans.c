@@ -28,6 +28,14 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Block device translator
  *
+ * The translator does not maintain an intermediate copy of the data.
+ * When a data buffer is supplied, the translator wraps it in a fixed
+ * data transfer buffer and received data is written directly into the
+ * consumer's own memory (at the offset given by the delivery
+ * metadata, which accommodates out-of-order arrival).  When no data
+ * buffer is supplied (as used when probing device capacity), received
+ * data is discarded and only the total length is recorded.
+ *
  */
 
 #include <stdlib.h>
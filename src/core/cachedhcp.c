@@ -30,6 +30,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/dhcppkt.h>
 #include <ipxe/init.h>
 #include <ipxe/netdevice.h>
+#include <ipxe/settings.h>
 #include <ipxe/vlan.h>
 #include <ipxe/uaccess.h>
 #include <ipxe/cachedhcp.h>
@@ -58,6 +59,9 @@ struct cached_dhcp_packet {
 /** Cached DHCP packet has been used */
 #define CACHEDHCP_USED 0x0002
 
+/** Cached DHCP packet has been adopted by a network device */
+#define CACHEDHCP_ADOPTED 0x0004
+
 /** Cached DHCPACK */
 struct cached_dhcp_packet cached_dhcpack = {
 	.name = DHCP_SETTINGS_NAME,
@@ -105,6 +109,8 @@ static void cachedhcp_free ( struct cached_dhcp_packet *cache ) {
 static int cachedhcp_apply ( struct cached_dhcp_packet *cache,
 			     struct net_device *netdev ) {
 	struct settings *settings = NULL;
+	struct net_device_configurator *configurator;
+	struct net_device_configuration *config;
 	struct ll_protocol *ll_protocol;
 	const uint8_t *chaddr;
 	uint8_t *hw_addr;
@@ -180,6 +186,19 @@ static int cachedhcp_apply ( struct cached_dhcp_packet *cache,
 		return rc;
 	}
 
+	/* Treat adoption by a network device as a successful DHCP
+	 * configuration, so that the device need not repeat a full
+	 * DHCP exchange before use.
+	 */
+	if ( netdev ) {
+		configurator = find_netdev_configurator ( "dhcp" );
+		if ( configurator ) {
+			config = netdev_configuration ( netdev, configurator );
+			config->rc = 0;
+		}
+		cache->flags |= CACHEDHCP_ADOPTED;
+	}
+
 	/* Mark as used */
 	cache->flags |= CACHEDHCP_USED;
 
@@ -353,6 +372,8 @@ struct net_driver cachedhcp_driver __net_driver = {
  */
 void cachedhcp_recycle ( struct net_device *netdev ) {
 	struct cached_dhcp_packet *cache = &cached_dhcpack;
+	struct net_device_configurator *configurator;
+	struct net_device_configuration *config;
 	struct settings *settings;
 
 	/* Return DHCPACK to cache, if applicable */
@@ -363,6 +384,52 @@ void cachedhcp_recycle ( struct net_device *netdev ) {
 		       cache->name, netdev->name );
 		assert ( cache->flags & CACHEDHCP_USED );
 		unregister_settings ( settings );
-		cache->flags &= ~CACHEDHCP_USED;
+		cache->flags &= ~( CACHEDHCP_USED | CACHEDHCP_ADOPTED );
+
+		/* Revoke any successful DHCP configuration status
+		 * conferred by adoption.
+		 */
+		configurator = find_netdev_configurator ( "dhcp" );
+		if ( configurator ) {
+			config = netdev_configuration ( netdev, configurator );
+			if ( config->rc == 0 )
+				config->rc = -ECANCELED;
+		}
 	}
 }
+
+/** Cached DHCP lease adoption setting */
+const struct setting cachedhcp_setting __setting ( SETTING_MISC, cachedhcp ) = {
+	.name = "cachedhcp",
+	.description = "Cached DHCP lease adopted",
+	.type = &setting_type_int8,
+	.scope = &builtin_scope,
+};
+
+/**
+ * Fetch cached DHCP lease adoption setting
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ *
+ * This indicates whether or not the current boot adopted a cached
+ * DHCP lease rather than performing a fresh DHCP exchange.  Scripts
+ * that require up-to-date lease information (or fresh ProxyDHCP
+ * answers) can test this setting and force a reconfiguration.
+ */
+static int cachedhcp_fetch_adopted ( void *data, size_t len ) {
+	uint8_t adopted =
+		( ( cached_dhcpack.flags & CACHEDHCP_ADOPTED ) ? 1 : 0 );
+
+	if ( len > sizeof ( adopted ) )
+		len = sizeof ( adopted );
+	memcpy ( data, &adopted, len );
+	return sizeof ( adopted );
+}
+
+/** Cached DHCP lease adoption built-in setting */
+struct builtin_setting cachedhcp_builtin_setting __builtin_setting = {
+	.setting = &cachedhcp_setting,
+	.fetch = cachedhcp_fetch_adopted,
+};
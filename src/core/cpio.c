@@ -205,3 +205,23 @@ size_t cpio_header ( struct image *image, unsigned int index,
 	/* Calculate total length */
 	return ( sizeof ( *cpio ) + name_len );
 }
+
+/**
+ * Calculate total length of CPIO headers for image, if applicable
+ *
+ * @v image		Image
+ * @ret len		Total length of CPIO headers (including padding)
+ */
+size_t cpio_headers_len ( struct image *image ) {
+	struct cpio_header cpio;
+	size_t cpio_len;
+	size_t len;
+	unsigned int i;
+
+	/* Sum lengths of all constructed CPIO headers */
+	len = 0;
+	for ( i = 0 ; ( cpio_len = cpio_header ( image, i, &cpio ) ) ; i++ )
+		len += ( cpio_len + cpio_pad_len ( cpio_len ) );
+
+	return len;
+}
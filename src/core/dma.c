@@ -31,6 +31,13 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * DMA mappings
  *
+ * Note that mappings cannot be cached and reused at this layer: a
+ * platform DMA implementation is permitted to bounce-buffer, copying
+ * data into the mapped region at map time (for transmit mappings) and
+ * back out at unmap time (for receive mappings).  Reuse of mappings
+ * is instead handled at the I/O buffer level, where the buffer and
+ * its mapping can be retained together (see free_rx_iob()).
+ *
  */
 
 /******************************************************************************
@@ -27,6 +27,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <string.h>
 #include <errno.h>
 #include <syslog.h>
+#include <ipxe/timer.h>
 #include <ipxe/iobuf.h>
 #include <ipxe/xfer.h>
 #include <ipxe/open.h>
@@ -40,6 +41,13 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Image downloader
  *
+ * The downloader streams received data directly into an
+ * external-memory data transfer buffer, whose ownership is handed
+ * over verbatim to the image on completion; the downloaded payload is
+ * never copied.  Protocols that know the expected transfer size in
+ * advance (e.g. HTTP Content-Length, TFTP tsize) pre-size this buffer
+ * via xfer_seek(), so that the full allocation is performed once
+ * rather than grown incrementally during the download.
  */
 
 /** A downloader */
@@ -56,8 +64,16 @@ struct downloader {
 	struct image *image;
 	/** Data transfer buffer */
 	struct xfer_buffer buffer;
+
+	/** Start time */
+	unsigned long started;
+	/** Number of restarts (e.g. redirections) */
+	unsigned int restarts;
 };
 
+/** Metrics for the most recently completed download */
+struct downloader_metrics downloader_metrics;
+
 /**
  * Free downloader object
  *
@@ -85,15 +101,24 @@ static void downloader_finished ( struct downloader *downloader, int rc ) {
 	/* Log download status */
 	if ( rc == 0 ) {
 		syslog ( LOG_NOTICE, "Downloaded \"%s\"\n", image->name );
+		/* Record metrics for use as built-in settings */
+		downloader_metrics.valid = 1;
+		downloader_metrics.len = buffer->len;
+		downloader_metrics.elapsed =
+			( currticks() - downloader->started );
+		downloader_metrics.restarts = downloader->restarts;
 	} else {
 		syslog ( LOG_ERR, "Download of \"%s\" failed: %s\n",
 			 image->name, strerror ( rc ) );
 	}
 
-	/* Transfer ownership from data transfer buffer to image */
-	image->data = buffer->data;
+	/* Transfer ownership from data transfer buffer to image.
+	 * Detaching may relocate the data (since trimming the excess
+	 * reservation can move the underlying allocation), so the data
+	 * pointer must be taken from the detach itself.
+	 */
 	image->len = buffer->len;
-	xferbuf_detach ( buffer );
+	image->data = xferbuf_detach ( buffer );
 
 	/* Shut down interfaces */
 	intf_shutdown ( &downloader->xfer, rc );
@@ -204,6 +229,9 @@ static int downloader_vredirect ( struct downloader *downloader, int type,
 			goto err;
 	}
 
+	/* Count restarts for the download metrics */
+	downloader->restarts++;
+
 	/* Redirect to new location */
 	if ( ( rc = xfer_vreopen ( &downloader->xfer, type, args ) ) != 0 )
 		goto err;
@@ -274,6 +302,7 @@ int create_downloader ( struct interface *job, struct image *image ) {
 		    &downloader->refcnt );
 	downloader->image = image_get ( image );
 	xferbuf_umalloc_init ( &downloader->buffer );
+	downloader->started = currticks();
 
 	/* Instantiate child objects and attach to our interfaces */
 	if ( ( rc = xfer_open_uri ( &downloader->xfer, image->uri ) ) != 0 )
@@ -47,6 +47,28 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Shell stop state */
 static int stop_state;
 
+/** Most recently parsed command was terminated with "&" */
+static int terminator_background;
+
+/** Currently executing command should run in the background */
+static int background_state;
+
+/**
+ * Check whether currently executing command should run in the background
+ *
+ * @ret background	Command should run in the background
+ *
+ * Commands are synchronous function calls: the shell cannot suspend
+ * an arbitrary command.  A command terminated with "&" is therefore
+ * executed with this hint set, and commands that are capable of
+ * running as background jobs (such as "imgfetch") check it and return
+ * as soon as the job has been started.  Commands without background
+ * support simply run to completion as normal.
+ */
+int shell_background ( void ) {
+	return background_state;
+}
+
 /**
  * Execute command
  *
@@ -185,10 +207,19 @@ static int command_terminator ( char **tokens,
 	unsigned int i;
 
 	/* Find first terminating token */
+	terminator_background = 0;
 	for ( i = 0 ; tokens[i] ; i++ ) {
 		if ( tokens[i][0] == '#' ) {
 			/* Start of a comment */
 			break;
+		} else if ( strcmp ( tokens[i], "&" ) == 0 ) {
+			/* Process next command unconditionally,
+			 * hinting that this command should run in the
+			 * background.
+			 */
+			terminator_background = 1;
+			*process_next = process_always;
+			return i;
 		} else if ( strcmp ( tokens[i], "||" ) == 0 ) {
 			/* Short-circuit logical OR */
 			*process_next = process_on_failure;
@@ -320,7 +351,9 @@ int system ( const char *command ) {
 			argv[argc] = NULL;
 
 			/* Execute command */
+			background_state = terminator_background;
 			rc = execv ( argv[0], argv );
+			background_state = 0;
 
 			/* Free tokens */
 			free_tokens ( argv );
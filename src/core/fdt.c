@@ -308,9 +308,20 @@ static int fdt_end ( struct fdt *fdt, unsigned int offset,
  * @ret rc		Return status code
  */
 int fdt_path ( struct fdt *fdt, const char *path, unsigned int *offset ) {
+	struct fdt_path_cache *cache;
 	const char *tmp = path;
+	unsigned int i;
 	int rc;
 
+	/* Use cached result, if available */
+	for ( i = 0 ; i < FDT_PATH_CACHE_COUNT ; i++ ) {
+		cache = &fdt->cache[i];
+		if ( cache->path[0] && ( strcmp ( cache->path, path ) == 0 ) ) {
+			*offset = cache->offset;
+			return 0;
+		}
+	}
+
 	/* Initialise offset */
 	*offset = 0;
 
@@ -335,6 +346,14 @@ int fdt_path ( struct fdt *fdt, const char *path, unsigned int *offset ) {
 			break;
 	}
 
+	/* Record successful lookup in cache */
+	if ( strlen ( path ) < FDT_PATH_CACHE_LEN ) {
+		cache = &fdt->cache[ fdt->cache_evict++ %
+				     FDT_PATH_CACHE_COUNT ];
+		strcpy ( cache->path, path );
+		cache->offset = *offset;
+	}
+
 	DBGC2 ( fdt, "FDT found path \"%s\" at +%#04x\n", path, *offset );
 	return 0;
 }
@@ -730,6 +749,8 @@ int fdt_parse ( struct fdt *fdt, struct fdt_header *hdr, size_t max_len ) {
 	fdt->hdr = hdr;
 	fdt->len = be32_to_cpu ( hdr->totalsize );
 	fdt->used = sizeof ( *hdr );
+	memset ( fdt->cache, 0, sizeof ( fdt->cache ) );
+	fdt->cache_evict = 0;
 	if ( fdt->len > max_len ) {
 		DBGC ( fdt, "FDT has invalid length %#zx / %#zx\n",
 		       fdt->len, max_len );
@@ -888,6 +909,11 @@ static int fdt_insert ( struct fdt *fdt, unsigned int offset, size_t len ) {
 	memset ( ( fdt->raw + offset ), 0, len );
 	fdt->used += len;
 
+	/* Invalidate path lookup cache, since node offsets may have
+	 * changed.
+	 */
+	memset ( fdt->cache, 0, sizeof ( fdt->cache ) );
+
 	/* Update offsets
 	 *
 	 * We assume that we never need to legitimately insert data at
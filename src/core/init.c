@@ -25,6 +25,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <ipxe/device.h>
 #include <ipxe/console.h>
+#include <ipxe/timeline.h>
 #include <ipxe/init.h>
 
 /** @file
@@ -75,11 +76,13 @@ void startup ( void ) {
 		if ( startup_fn->startup ) {
 			DBGC ( colour, "INIT startup %s...\n",
 			       startup_fn->name );
+			timeline_record ( startup_fn->name );
 			startup_fn->startup();
 		}
 	}
 
 	started = 1;
+	timeline_record ( "startup complete" );
 	DBGC ( colour, "INIT startup complete\n" );
 }
 
@@ -35,6 +35,34 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/** Maximum number of detached I/O buffer descriptors retained for reuse */
+#define IOB_SLAB_MAX 32
+
+/** Maximum number of recycled RX I/O buffers retained for reuse */
+#define IOB_RX_RECYCLE_MAX 64
+
+/** List of recycled RX I/O buffers
+ *
+ * Freed RX I/O buffers are retained (complete with their DMA
+ * mappings) and reused by subsequent allocations, so that the receive
+ * datapath does not touch the heap or the IOMMU for each received
+ * frame.  Retained buffers are released on device closure and under
+ * memory pressure.
+ */
+static LIST_HEAD ( iob_rx_recycled );
+
+/** Number of recycled RX I/O buffers currently retained */
+static unsigned int iob_rx_recycled_count;
+
+/** Slab cache for detached I/O buffer descriptors
+ *
+ * Large I/O buffers (e.g. received jumbo frames) use a descriptor
+ * detached from the buffer itself, allocated and freed once per
+ * buffer.  Cache these descriptors to keep the allocation out of the
+ * receive datapath.
+ */
+static SLAB_CACHE ( iob_slab, sizeof ( struct io_buffer ), IOB_SLAB_MAX );
+
 /**
  * Allocate I/O buffer with specified alignment and offset
  *
@@ -102,7 +130,7 @@ struct io_buffer * alloc_iob_raw ( size_t len, size_t align, size_t offset ) {
 			return NULL;
 
 		/* Allocate memory for descriptor */
-		iobuf = malloc ( sizeof ( *iobuf ) );
+		iobuf = slab_alloc ( &iob_slab );
 		if ( ! iobuf ) {
 			free_phys ( data, len );
 			return NULL;
@@ -111,6 +139,7 @@ struct io_buffer * alloc_iob_raw ( size_t len, size_t align, size_t offset ) {
 
 	/* Populate descriptor */
 	memset ( &iobuf->map, 0, sizeof ( iobuf->map ) );
+	iobuf->flags = 0;
 	iobuf->head = iobuf->data = iobuf->tail = data;
 	iobuf->end = ( data + len );
 
@@ -173,7 +202,7 @@ void free_iob ( struct io_buffer *iobuf ) {
 
 		/* Descriptor is detached */
 		free_phys ( iobuf->head, len );
-		free ( iobuf );
+		slab_free ( &iob_slab, iobuf );
 	}
 }
 
@@ -188,6 +217,36 @@ struct io_buffer * alloc_rx_iob ( size_t len, struct dma_device *dma ) {
 	struct io_buffer *iobuf;
 	int rc;
 
+	/* Reuse a recycled buffer, if a suitable one exists.  A
+	 * recycled buffer may be reused if it is large enough and if
+	 * its mapping belongs to this DMA device.  An unmapped buffer
+	 * (as will arrive in the pool via a non-DMA driver) must be
+	 * mapped before being handed to a DMA device, since its DMA
+	 * address would otherwise silently degrade to an untranslated
+	 * physical address.
+	 */
+	list_for_each_entry ( iobuf, &iob_rx_recycled, list ) {
+		if ( ( ( size_t ) ( iobuf->end - iobuf->head ) ) < len )
+			continue;
+		if ( dma_mapped ( &iobuf->map ) ) {
+			if ( iobuf->map.dma != dma )
+				continue;
+		} else if ( dma ) {
+			/* Map for this device, failing over to the
+			 * next candidate on error (and leaving this
+			 * buffer in the pool).
+			 */
+			iobuf->data = iobuf->tail = iobuf->head;
+			if ( ( rc = iob_map_rx ( iobuf, dma ) ) != 0 )
+				continue;
+		}
+		list_del ( &iobuf->list );
+		iob_rx_recycled_count--;
+		iobuf->flags = 0;
+		iobuf->data = iobuf->tail = iobuf->head;
+		return iobuf;
+	}
+
 	/* Allocate I/O buffer */
 	iobuf = alloc_iob ( len );
 	if ( ! iobuf )
@@ -213,13 +272,66 @@ struct io_buffer * alloc_rx_iob ( size_t len, struct dma_device *dma ) {
  */
 void free_rx_iob ( struct io_buffer *iobuf ) {
 
-	/* Unmap I/O buffer */
-	iob_unmap ( iobuf );
+	/* Allow free_rx_iob(NULL) to be valid */
+	if ( ! iobuf )
+		return;
+
+	/* Retain buffer (and mapping) for reuse, if possible */
+	if ( iob_rx_recycled_count < IOB_RX_RECYCLE_MAX ) {
+		list_add ( &iobuf->list, &iob_rx_recycled );
+		iob_rx_recycled_count++;
+		return;
+	}
+
+	/* Unmap I/O buffer, if required */
+	if ( dma_mapped ( &iobuf->map ) )
+		iob_unmap ( iobuf );
 
 	/* Free I/O buffer */
 	free_iob ( iobuf );
 }
 
+/**
+ * Release recycled RX I/O buffers
+ *
+ * @v dma		DMA device, or NULL to release all recycled buffers
+ *
+ * Releases any recycled RX I/O buffers mapped for the specified DMA
+ * device.  This must be called before the DMA device itself is
+ * destroyed.
+ */
+void flush_rx_iobs ( struct dma_device *dma ) {
+	struct io_buffer *iobuf;
+	struct io_buffer *tmp;
+
+	list_for_each_entry_safe ( iobuf, tmp, &iob_rx_recycled, list ) {
+		if ( dma && ( iobuf->map.dma != dma ) )
+			continue;
+		list_del ( &iobuf->list );
+		iob_rx_recycled_count--;
+		if ( dma_mapped ( &iobuf->map ) )
+			iob_unmap ( iobuf );
+		free_iob ( iobuf );
+	}
+}
+
+/**
+ * Discard all recycled RX I/O buffers
+ *
+ * @ret discarded	Number of I/O buffers discarded
+ */
+static unsigned int iob_rx_discard ( void ) {
+	unsigned int discarded = iob_rx_recycled_count;
+
+	flush_rx_iobs ( NULL );
+	return discarded;
+}
+
+/** Recycled RX I/O buffer discarder */
+struct cache_discarder iob_rx_discarder __cache_discarder ( CACHE_CHEAP ) = {
+	.discard = iob_rx_discard,
+};
+
 /**
  * Ensure I/O buffer has sufficient headroom
  *
@@ -238,6 +350,21 @@ int iob_ensure_headroom ( struct io_buffer *iobuf, size_t len ) {
 	return -ENOBUFS;
 }
 
+/**
+ * Calculate total length of a chain of I/O buffers
+ *
+ * @v list	List of I/O buffers
+ * @ret len	Total length
+ */
+size_t iob_chain_len ( struct list_head *list ) {
+	struct io_buffer *iobuf;
+	size_t len = 0;
+
+	list_for_each_entry ( iobuf, list, list )
+		len += iob_len ( iobuf );
+	return len;
+}
+
 /**
  * Concatenate I/O buffers into a single buffer
  *
@@ -250,7 +377,7 @@ struct io_buffer * iob_concatenate ( struct list_head *list ) {
 	struct io_buffer *iobuf;
 	struct io_buffer *tmp;
 	struct io_buffer *concatenated;
-	size_t len = 0;
+	size_t len;
 
 	/* If the list contains only a single entry, avoid an
 	 * unnecessary additional allocation.
@@ -262,15 +389,25 @@ struct io_buffer * iob_concatenate ( struct list_head *list ) {
 	}
 
 	/* Calculate total length */
-	list_for_each_entry ( iobuf, list, list )
-		len += iob_len ( iobuf );
+	len = iob_chain_len ( list );
 
-	/* Allocate new I/O buffer */
-	concatenated = alloc_iob_raw ( len, __alignof__ ( *iobuf ), 0 );
-	if ( ! concatenated )
-		return NULL;
+	/* If the first buffer has sufficient tailroom to absorb the
+	 * remaining buffers, then concatenate in place: this avoids
+	 * both the allocation and the copying of the first buffer's
+	 * (typically dominant) payload.
+	 */
+	concatenated = list_first_entry ( list, struct io_buffer, list );
+	if ( iob_tailroom ( concatenated ) >=
+	     ( len - iob_len ( concatenated ) ) ) {
+		list_del ( &concatenated->list );
+	} else {
+		/* Allocate new I/O buffer */
+		concatenated = alloc_iob_raw ( len, __alignof__ ( *iobuf ), 0 );
+		if ( ! concatenated )
+			return NULL;
+	}
 
-	/* Move data to new I/O buffer */
+	/* Move data to concatenated I/O buffer */
 	list_for_each_entry_safe ( iobuf, tmp, list, list ) {
 		list_del ( &iobuf->list );
 		memcpy ( iob_put ( concatenated, iob_len ( iobuf ) ),
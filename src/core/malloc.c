@@ -83,6 +83,18 @@ size_t usedmem;
 /** Maximum amount of used memory */
 size_t maxusedmem;
 
+/** Number of failed allocations */
+static unsigned int alloc_failures;
+
+/** Total amount of used external (umalloc) memory */
+size_t uusedmem;
+
+/** Maximum amount of used external (umalloc) memory */
+size_t maxuusedmem;
+
+/** Largest failed allocation */
+struct heap_failure heap_worst_failure;
+
 /**
  * Heap size
  *
@@ -251,6 +263,35 @@ static void discard_all_cache ( void ) {
 	} while ( discarded );
 }
 
+/**
+ * Record a failed allocation
+ *
+ * @v size		Requested size
+ * @v align		Physical alignment
+ * @v caller		Return address of caller
+ *
+ * Only the largest failed request is recorded.  Must be called while
+ * the memory block records are accessible.
+ */
+static void record_failed_alloc ( size_t size, size_t align, void *caller ) {
+	struct memory_block *block;
+
+	/* Record only the largest failed request */
+	if ( size <= heap_worst_failure.size )
+		return;
+
+	/* Record request and heap state at time of failure */
+	heap_worst_failure.size = size;
+	heap_worst_failure.align = align;
+	heap_worst_failure.caller = caller;
+	heap_worst_failure.used = usedmem;
+	heap_worst_failure.largest = 0;
+	list_for_each_entry ( block, &free_blocks, list ) {
+		if ( block->size > heap_worst_failure.largest )
+			heap_worst_failure.largest = block->size;
+	}
+}
+
 /**
  * Allocate a memory block
  *
@@ -377,6 +418,9 @@ void * alloc_memblock ( size_t size, size_t align, size_t offset ) {
 			/* Nothing available to discard */
 			DBGC ( &heap, "HEAP failed to allocate %#zx (aligned "
 			       "%#zx)\n", size, align );
+			alloc_failures++;
+			record_failed_alloc ( size, align,
+					      __builtin_return_address ( 0 ) );
 			ptr = NULL;
 			goto done;
 		}
@@ -388,6 +432,22 @@ void * alloc_memblock ( size_t size, size_t align, size_t offset ) {
 	return ptr;
 }
 
+/**
+ * Record a change in external memory usage
+ *
+ * @v old_size		Previously used size
+ * @v new_size		Newly used size
+ *
+ * Called by the external (umalloc) memory allocators, which are the
+ * only place where external block sizes are known.
+ */
+void umalloc_account ( size_t old_size, size_t new_size ) {
+
+	uusedmem = ( uusedmem - old_size + new_size );
+	if ( uusedmem > maxuusedmem )
+		maxuusedmem = uusedmem;
+}
+
 /**
  * Free a memory block
  *
@@ -633,6 +693,104 @@ void * zalloc ( size_t size ) {
 	return data;
 }
 
+/** A free object retained within a slab cache */
+struct slab_object {
+	/** List of retained free objects */
+	struct list_head list;
+};
+
+/**
+ * Allocate an object from a slab cache
+ *
+ * @v slab		Slab cache
+ * @ret ptr		Object, or NULL
+ *
+ * Allocates an object of the cache's fixed size, reusing a retained
+ * free object if one is available and falling back to the heap
+ * otherwise.  As with malloc(), the contents of the object are
+ * undefined.
+ */
+void * slab_alloc ( struct slab_cache *slab ) {
+	struct slab_object *object;
+
+	/* Sanity check */
+	assert ( slab->size >= sizeof ( *object ) );
+
+	/* Reuse a retained free object, if available */
+	object = list_first_entry ( &slab->objects, struct slab_object, list );
+	if ( object ) {
+		list_del ( &object->list );
+		slab->count--;
+		DBGC2 ( &heap, "HEAP slab %s reused %p\n",
+			slab->name, object );
+		return object;
+	}
+
+	/* Fall back to the heap */
+	return malloc ( slab->size );
+}
+
+/**
+ * Free an object back to a slab cache
+ *
+ * @v slab		Slab cache
+ * @v ptr		Object allocated by slab_alloc(), or NULL
+ *
+ * If @c ptr is NULL, no action is taken.
+ */
+void slab_free ( struct slab_cache *slab, void *ptr ) {
+	struct slab_object *object = ptr;
+
+	/* Allow for ptr==NULL */
+	if ( ! ptr )
+		return;
+
+	/* Return object to the heap if the cache is fully populated */
+	if ( slab->count >= slab->max ) {
+		free ( ptr );
+		return;
+	}
+
+	/* Retain object for reuse */
+	list_add ( &object->list, &slab->objects );
+	slab->count++;
+	DBGC2 ( &heap, "HEAP slab %s retained %p\n", slab->name, object );
+}
+
+/**
+ * Discard all objects retained within a slab cache
+ *
+ * @ret discarded	Number of objects discarded
+ */
+static unsigned int slab_discard ( void ) {
+	struct slab_cache *slab;
+	struct slab_object *object;
+	struct slab_object *tmp;
+	unsigned int discarded;
+
+	for_each_table_entry ( slab, SLAB_CACHES ) {
+		if ( ! slab->count )
+			continue;
+		discarded = 0;
+		list_for_each_entry_safe ( object, tmp, &slab->objects, list ) {
+			list_del ( &object->list );
+			free ( object );
+			discarded++;
+		}
+		assert ( discarded == slab->count );
+		slab->count = 0;
+		DBGC ( &heap, "HEAP slab %s discarded %d objects\n",
+		       slab->name, discarded );
+		return discarded;
+	}
+	return 0;
+}
+
+/** Slab cache discarder */
+struct cache_discarder slab_discarder __cache_discarder ( CACHE_CHEAP ) = {
+	.discard = slab_discard,
+};
+
 /**
  * Add memory to allocation pool
  *
@@ -694,6 +852,34 @@ struct startup_fn heap_startup_fn __startup_fn ( STARTUP_EARLY ) = {
 	.shutdown = shutdown_cache,
 };
 
+/**
+ * Collect heap statistics
+ *
+ * @v stats		Heap statistics to fill in
+ *
+ * Collects fragmentation telemetry from the free block list.  An
+ * allocation can succeed only if it fits within the largest free
+ * block, regardless of the total amount of free memory.
+ */
+void heap_stat ( struct heap_stats *stats ) {
+	struct memory_block *block;
+
+	/* Sanity checks */
+	valgrind_make_blocks_defined();
+	check_blocks();
+
+	/* Traverse free block list */
+	memset ( stats, 0, sizeof ( *stats ) );
+	list_for_each_entry ( block, &free_blocks, list ) {
+		stats->blocks++;
+		if ( block->size > stats->largest )
+			stats->largest = block->size;
+	}
+	stats->failures = alloc_failures;
+
+	valgrind_make_blocks_noaccess();
+}
+
 /**
  * Dump free block list (for debugging)
  *
@@ -55,6 +55,9 @@ static struct interface_descriptor monojob_intf_desc =
 
 struct interface monojob = INTF_INIT ( monojob_intf_desc );
 
+/** Interval between progress checks */
+#define MONOJOB_PROGRESS_INTERVAL ( TICKS_PER_SEC / 4 )
+
 /**
  * Clear previously displayed message
  *
@@ -80,6 +83,8 @@ static void monojob_clear ( size_t len ) {
  */
 int monojob_wait ( const char *string, unsigned long timeout ) {
 	struct job_progress progress;
+	char shown[ sizeof ( progress.message ) + 7 /* "nnn% []" */ ] = "";
+	char render[ sizeof ( shown ) ];
 	unsigned long last_check;
 	unsigned long last_progress;
 	unsigned long last_display;
@@ -90,6 +95,7 @@ int monojob_wait ( const char *string, unsigned long timeout ) {
 	unsigned long scaled_total;
 	unsigned int percentage;
 	size_t clear_len = 0;
+	size_t len;
 	int ongoing_rc;
 	int key;
 	int rc;
@@ -104,11 +110,12 @@ int monojob_wait ( const char *string, unsigned long timeout ) {
 		step();
 		now = currticks();
 
-		/* Continue until a timer tick occurs (to minimise
-		 * time wasted checking for progress and keypresses).
+		/* Continue until the progress check interval has
+		 * elapsed (to minimise time wasted checking for
+		 * progress and keypresses).
 		 */
 		elapsed = ( now - last_check );
-		if ( ! elapsed )
+		if ( elapsed < MONOJOB_PROGRESS_INTERVAL )
 			continue;
 		last_check = now;
 
@@ -137,25 +144,51 @@ int monojob_wait ( const char *string, unsigned long timeout ) {
 		}
 
 		/* Display progress, if applicable */
-		elapsed = ( now - last_display );
-		if ( string && ( elapsed >= TICKS_PER_SEC ) ) {
-			monojob_clear ( clear_len );
-			/* Normalise progress figures to avoid overflow */
-			scaled_completed = ( progress.completed / 128 );
-			scaled_total = ( progress.total / 128 );
-			if ( scaled_total ) {
-				percentage = ( ( 100 * scaled_completed ) /
-					       scaled_total );
-				clear_len = printf ( "%3d%%", percentage );
-			} else {
+		if ( ! string )
+			continue;
+
+		/* Normalise progress figures to avoid overflow */
+		scaled_completed = ( progress.completed / 128 );
+		scaled_total = ( progress.total / 128 );
+		if ( scaled_total ) {
+
+			/* Render progress off the console path, and
+			 * redraw only when the rendered text has
+			 * changed, to avoid throttling the job via a
+			 * slow (e.g. serial) console.
+			 */
+			percentage = ( ( 100 * scaled_completed ) /
+				       scaled_total );
+			len = snprintf ( render, sizeof ( render ),
+					 "%3d%%", percentage );
+			if ( progress.message[0] ) {
+				snprintf ( ( render + len ),
+					   ( sizeof ( render ) - len ),
+					   " [%s]", progress.message );
+			}
+			if ( strcmp ( render, shown ) != 0 ) {
+				monojob_clear ( clear_len );
+				clear_len = printf ( "%s", render );
+				strcpy ( shown, render );
+			}
+
+		} else {
+
+			/* Print an indeterminate progress indicator
+			 * at one-second intervals
+			 */
+			elapsed = ( now - last_display );
+			if ( elapsed >= TICKS_PER_SEC ) {
+				monojob_clear ( clear_len );
 				printf ( "." );
 				clear_len = 0;
+				if ( progress.message[0] ) {
+					clear_len += printf ( " [%s]",
+							progress.message );
+				}
+				shown[0] = '\0';
+				last_display = now;
 			}
-			if ( progress.message[0] ) {
-				clear_len += printf ( " [%s]",
-						      progress.message );
-			}
-			last_display = now;
 		}
 	}
 	rc = monojob_rc;
@@ -27,6 +27,17 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Multiprocessor functions
  *
+ * Note that application processors are of very limited use for
+ * offloading data work (such as parallelising digest calculations):
+ * multiprocessor functions run with no stack, potentially in a
+ * different address space, and with no access to firmware services,
+ * and so cannot safely call into ordinary C code such as the digest
+ * algorithms.  Image verification must in any case produce the
+ * standard flat digest of the image in order to match existing
+ * signatures; a sharded tree-hash combine would compute a different
+ * (incompatible) digest.  The intended use of this API is for
+ * self-contained per-CPU operations such as microcode updates.
+ *
  */
 
 #include <ipxe/timer.h>
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <byteswap.h>
+#include <ipxe/refcnt.h>
+#include <ipxe/interface.h>
+#include <ipxe/job.h>
+#include <ipxe/xfer.h>
+#include <ipxe/iobuf.h>
+#include <ipxe/open.h>
+#include <ipxe/socket.h>
+#include <ipxe/tcpip.h>
+#include <ipxe/process.h>
+#include <ipxe/retry.h>
+#include <ipxe/timer.h>
+#include <ipxe/profile.h>
+#include <ipxe/netbench.h>
+
+/** @file
+ *
+ * Network benchmark streams
+ *
+ * A benchmark stream either transmits a continuous byte stream to a
+ * remote sink, or counts a received byte stream, for a fixed
+ * duration.  The transmit direction is wire-compatible with a
+ * standard iperf server in its default TCP and UDP modes, which
+ * simply count whatever bytes arrive.
+ */
+
+/** Maximum number of chunks transmitted per process step */
+#define NETBENCH_BURST 8
+
+/** Transmit datapath profiler */
+static struct profiler netbench_tx_profiler __profiler =
+	{ .name = "netbench.tx" };
+
+/** Receive datapath profiler */
+static struct profiler netbench_rx_profiler __profiler =
+	{ .name = "netbench.rx" };
+
+/** A network benchmark stream */
+struct netbench {
+	/** Reference count */
+	struct refcnt refcnt;
+
+	/** Job control interface */
+	struct interface job;
+	/** Data transfer interface */
+	struct interface xfer;
+
+	/** Transmit process */
+	struct process process;
+	/** Duration timer */
+	struct retry_timer timer;
+
+	/** Receive (rather than transmit) */
+	int rx;
+	/** Chunk length */
+	size_t len;
+	/** Duration (in ticks) */
+	unsigned long duration;
+
+	/** Measurement is running */
+	int running;
+	/** Start time (valid only while running) */
+	unsigned long start;
+	/** Transferred byte count */
+	unsigned long long bytes;
+
+	/** Measurement results (filled in on close) */
+	struct netbench_result *result;
+};
+
+/**
+ * Close benchmark stream
+ *
+ * @v netbench		Benchmark stream
+ * @v rc		Reason for close
+ */
+static void netbench_close ( struct netbench *netbench, int rc ) {
+	struct netbench_result *result;
+	struct profiler *profiler;
+
+	/* Record results exactly once */
+	result = netbench->result;
+	if ( result ) {
+		netbench->result = NULL;
+		result->bytes = netbench->bytes;
+		result->elapsed = ( netbench->running ?
+				    ( currticks() - netbench->start ) : 0 );
+		profiler = ( netbench->rx ?
+			     &netbench_rx_profiler : &netbench_tx_profiler );
+		result->cycles = profile_mean ( profiler );
+	}
+
+	/* Stop timer and process */
+	stop_timer ( &netbench->timer );
+	process_del ( &netbench->process );
+
+	/* Shut down interfaces */
+	intf_shutdown ( &netbench->xfer, rc );
+	intf_shutdown ( &netbench->job, rc );
+}
+
+/**
+ * Start measurement period
+ *
+ * @v netbench		Benchmark stream
+ */
+static void netbench_start ( struct netbench *netbench ) {
+
+	if ( netbench->running )
+		return;
+	netbench->running = 1;
+	netbench->start = currticks();
+	start_timer_fixed ( &netbench->timer, netbench->duration );
+}
+
+/**
+ * Handle duration timer expiry
+ *
+ * @v timer		Timer
+ * @v over		Failure indicator
+ */
+static void netbench_expired ( struct retry_timer *timer,
+			       int over __unused ) {
+	struct netbench *netbench =
+		container_of ( timer, struct netbench, timer );
+
+	/* Measurement period has completed successfully */
+	netbench_close ( netbench, 0 );
+}
+
+/**
+ * Transmit data chunks
+ *
+ * @v netbench		Benchmark stream
+ */
+static void netbench_step ( struct netbench *netbench ) {
+	struct io_buffer *iobuf;
+	unsigned int burst = NETBENCH_BURST;
+	int rc;
+
+	/* Fill the transmit window, bounding the work done per step
+	 * so that the duration timer (and everything else in the main
+	 * loop) continues to run even when the window never closes,
+	 * as with UDP.
+	 */
+	while ( burst-- && ( xfer_window ( &netbench->xfer ) >=
+			     netbench->len ) ) {
+
+		/* Start measuring on first opportunity to transmit */
+		netbench_start ( netbench );
+
+		/* Allocate, fill, and deliver chunk */
+		profile_start ( &netbench_tx_profiler );
+		iobuf = xfer_alloc_iob ( &netbench->xfer, netbench->len );
+		if ( ! iobuf )
+			return;
+		memset ( iob_put ( iobuf, netbench->len ), 0xeb,
+			 netbench->len );
+		if ( ( rc = xfer_deliver_iob ( &netbench->xfer,
+					       iobuf ) ) != 0 ) {
+			DBGC ( netbench, "NETBENCH %p could not transmit: "
+			       "%s\n", netbench, strerror ( rc ) );
+			netbench_close ( netbench, rc );
+			return;
+		}
+		profile_stop ( &netbench_tx_profiler );
+		netbench->bytes += netbench->len;
+	}
+}
+
+/**
+ * Handle received data
+ *
+ * @v netbench		Benchmark stream
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ */
+static int netbench_deliver ( struct netbench *netbench,
+			      struct io_buffer *iobuf,
+			      struct xfer_metadata *meta __unused ) {
+
+	/* Start measuring on first received data */
+	netbench_start ( netbench );
+
+	/* Count and discard received data */
+	profile_start ( &netbench_rx_profiler );
+	netbench->bytes += iob_len ( iobuf );
+	free_iob ( iobuf );
+	profile_stop ( &netbench_rx_profiler );
+
+	return 0;
+}
+
+/** Benchmark stream data transfer interface operations */
+static struct interface_operation netbench_xfer_op[] = {
+	INTF_OP ( xfer_deliver, struct netbench *, netbench_deliver ),
+	INTF_OP ( intf_close, struct netbench *, netbench_close ),
+};
+
+/** Benchmark stream data transfer interface descriptor */
+static struct interface_descriptor netbench_xfer_desc =
+	INTF_DESC ( struct netbench, xfer, netbench_xfer_op );
+
+/** Benchmark stream job control interface operations */
+static struct interface_operation netbench_job_op[] = {
+	INTF_OP ( intf_close, struct netbench *, netbench_close ),
+};
+
+/** Benchmark stream job control interface descriptor */
+static struct interface_descriptor netbench_job_desc =
+	INTF_DESC ( struct netbench, job, netbench_job_op );
+
+/** Benchmark stream transmit process descriptor */
+static struct process_descriptor netbench_process_desc =
+	PROC_DESC ( struct netbench, process, netbench_step );
+
+/**
+ * Create benchmark stream
+ *
+ * @v job		Job control interface
+ * @v hostname		Remote host
+ * @v port		Remote port
+ * @v udp		Use UDP (rather than TCP)
+ * @v rx		Receive (rather than transmit)
+ * @v len		Chunk length
+ * @v duration		Duration (in ticks)
+ * @v result		Measurement results to fill in (must remain valid)
+ * @ret rc		Return status code
+ */
+int create_netbench ( struct interface *job, const char *hostname,
+		      unsigned int port, int udp, int rx, size_t len,
+		      unsigned long duration,
+		      struct netbench_result *result ) {
+	struct netbench *netbench;
+	union {
+		struct sockaddr_tcpip st;
+		struct sockaddr sa;
+	} server;
+	int rc;
+
+	/* Sanity checks */
+	if ( ( ! len ) || ( ! duration ) )
+		return -EINVAL;
+
+	/* Reset profilers */
+	memset ( &netbench_tx_profiler, 0, sizeof ( netbench_tx_profiler ) );
+	netbench_tx_profiler.name = "netbench.tx";
+	memset ( &netbench_rx_profiler, 0, sizeof ( netbench_rx_profiler ) );
+	netbench_rx_profiler.name = "netbench.rx";
+
+	/* Allocate and initialise structure */
+	netbench = zalloc ( sizeof ( *netbench ) );
+	if ( ! netbench )
+		return -ENOMEM;
+	ref_init ( &netbench->refcnt, NULL );
+	intf_init ( &netbench->job, &netbench_job_desc, &netbench->refcnt );
+	intf_init ( &netbench->xfer, &netbench_xfer_desc, &netbench->refcnt );
+	process_init_stopped ( &netbench->process, &netbench_process_desc,
+			       &netbench->refcnt );
+	timer_init ( &netbench->timer, netbench_expired, &netbench->refcnt );
+	netbench->rx = rx;
+	netbench->len = len;
+	netbench->duration = duration;
+	netbench->result = result;
+
+	/* Start transmit process, if applicable */
+	if ( ! rx )
+		process_add ( &netbench->process );
+
+	/* Open socket */
+	memset ( &server, 0, sizeof ( server ) );
+	server.st.st_port = htons ( port );
+	if ( ( rc = xfer_open_named_socket ( &netbench->xfer,
+					     ( udp ? SOCK_DGRAM : SOCK_STREAM ),
+					     &server.sa, hostname,
+					     NULL ) ) != 0 ) {
+		DBGC ( netbench, "NETBENCH %p could not open socket: %s\n",
+		       netbench, strerror ( rc ) );
+		goto err;
+	}
+
+	/* Attach parent interface, mortalise self, and return */
+	intf_plug_plug ( &netbench->job, job );
+	ref_put ( &netbench->refcnt );
+	return 0;
+
+ err:
+	netbench_close ( netbench, rc );
+	ref_put ( &netbench->refcnt );
+	return rc;
+}
@@ -92,8 +92,10 @@ void process_del ( struct process *process ) {
 /**
  * Single-step a single process
  *
- * This executes a single step of the first process in the run queue,
- * and moves the process to the end of the run queue.
+ * This executes a single step of the first process in the run queue.
+ * The process is moved to the end of the run queue once it has
+ * executed as many steps in its current scheduling round as its
+ * weight allows.
  */
 void step ( void ) {
 	struct process *process;
@@ -106,8 +108,18 @@ void step ( void ) {
 		desc = process->desc;
 		object = process_object ( process );
 		if ( desc->reschedule ) {
-			list_del ( &process->list );
-			list_add_tail ( &process->list, &run_queue );
+			/* Start a new scheduling round, if applicable */
+			if ( ! process->remaining ) {
+				process->remaining =
+					( process->weight ? process->weight : 1 );
+			}
+			/* Yield to the next process once this round
+			 * is complete.
+			 */
+			if ( ! --process->remaining ) {
+				list_del ( &process->list );
+				list_add_tail ( &process->list, &run_queue );
+			}
 		} else {
 			process_del ( process );
 		}
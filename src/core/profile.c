@@ -127,6 +127,9 @@ void profile_update ( struct profiler *profiler, unsigned long sample ) {
 	if ( profiler->count < INT_MAX )
 		profiler->count++;
 
+	/* Record sample in histogram */
+	profiler->buckets[ flsl ( sample ) ]++;
+
 	/* Adjust mean sample value scale if necessary.  Skip if
 	 * sample is zero (in which case flsl(sample)-1 would
 	 * underflow): in the case of a zero sample we have no need to
@@ -276,3 +279,54 @@ unsigned long profile_stddev ( struct profiler *profiler ) {
 
 	return isqrt ( profile_variance ( profiler ) );
 }
+
+/**
+ * Get approximate percentile sample value
+ *
+ * @v profiler		Profiler
+ * @v percentile	Percentile (0-100)
+ * @ret value		Approximate sample value at the percentile
+ *
+ * The value is estimated by linear interpolation within the
+ * power-of-two histogram bucket containing the requested percentile.
+ * As with the other statistics, a rough approximation is sufficient.
+ */
+unsigned long profile_percentile ( struct profiler *profiler,
+				   unsigned int percentile ) {
+	unsigned int target;
+	unsigned int cumulative = 0;
+	unsigned int before;
+	unsigned int i;
+	unsigned long low;
+
+	/* Percentile of an empty sample set is zero */
+	if ( ! profiler->count )
+		return 0;
+
+	/* Calculate target sample rank (rounding up) */
+	target = ( ( ( ( unsigned long long ) profiler->count ) *
+		     percentile + 99 ) / 100 );
+	if ( ! target )
+		target = 1;
+
+	/* Locate bucket containing the target rank */
+	for ( i = 0 ; i < ( sizeof ( profiler->buckets ) /
+			    sizeof ( profiler->buckets[0] ) ) ; i++ ) {
+		cumulative += profiler->buckets[i];
+		if ( cumulative < target )
+			continue;
+
+		/* Bucket zero holds only zero-valued samples */
+		if ( ! i )
+			return 0;
+
+		/* Interpolate within the bucket's range [2^(i-1),2^i) */
+		low = ( 1UL << ( i - 1 ) );
+		before = ( cumulative - profiler->buckets[i] );
+		return ( low + ( ( ( unsigned long long ) low *
+				   ( target - before ) ) /
+				 profiler->buckets[i] ) );
+	}
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdio.h>
+#include <string.h>
+#include <syslog.h>
+#include <ipxe/init.h>
+#include <ipxe/netdevice.h>
+#include <ipxe/profile.h>
+#include <ipxe/retry.h>
+#include <ipxe/timer.h>
+
+/** @file
+ *
+ * Continuous profiler export
+ *
+ * Interactive profiling (via profstat) requires a human at the
+ * console.  For unattended boots, we periodically snapshot all
+ * profilers into a compact ring buffer and export the accumulated
+ * snapshots in a batch via the system log at shutdown, so that every
+ * boot reports where its time went.  Export is effectively optional:
+ * if no syslog server is configured then the messages go no further
+ * than the local log console.
+ */
+
+/** Snapshot interval */
+#ifndef PROFSNAP_INTERVAL
+#define PROFSNAP_INTERVAL ( 1 * TICKS_PER_SEC )
+#endif
+
+/** Number of snapshot ring buffer entries */
+#ifndef PROFSNAP_DEPTH
+#define PROFSNAP_DEPTH 64
+#endif
+
+/** Length of a snapshot name (including NUL) */
+#define PROFSNAP_NAME_LEN 24
+
+/** A profiler snapshot */
+struct profsnap {
+	/** Profiler (used only for identity comparison)
+	 *
+	 * Per-device profilers may cease to exist before the ring is
+	 * flushed, so this pointer must never be dereferenced.
+	 */
+	struct profiler *profiler;
+	/** Profiler name */
+	char name[PROFSNAP_NAME_LEN];
+	/** Snapshot timestamp */
+	unsigned long when;
+	/** Number of samples at time of snapshot */
+	unsigned int count;
+	/** Mean sample value at time of snapshot */
+	unsigned long mean;
+	/** 99th percentile sample value at time of snapshot */
+	unsigned long p99;
+};
+
+/** Snapshot ring buffer
+ *
+ * Older snapshots are overwritten once the ring is full; a boot that
+ * runs for longer than ( PROFSNAP_DEPTH * PROFSNAP_INTERVAL ) keeps
+ * only its most recent history, which is invariably the interesting
+ * part.
+ */
+static struct profsnap profsnap_ring[PROFSNAP_DEPTH];
+
+/** Snapshot ring buffer producer counter */
+static unsigned int profsnap_prod;
+
+/**
+ * Record a snapshot of a single profiler
+ *
+ * @v profiler		Profiler
+ * @v name		Profiler name
+ * @v when		Snapshot timestamp
+ */
+static void profsnap_record ( struct profiler *profiler, const char *name,
+			      unsigned long when ) {
+	struct profsnap *snap;
+	unsigned int prod;
+
+	/* Skip profilers that have accumulated no samples */
+	if ( ! profiler->count )
+		return;
+
+	/* Skip profilers that have accumulated no new samples since
+	 * their most recent snapshot, to avoid flooding the ring with
+	 * identical entries for idle datapaths.
+	 */
+	for ( prod = profsnap_prod ; prod-- &&
+		      ( ( profsnap_prod - prod ) <= PROFSNAP_DEPTH ) ; ) {
+		snap = &profsnap_ring[ prod % PROFSNAP_DEPTH ];
+		if ( snap->profiler != profiler )
+			continue;
+		if ( snap->count == profiler->count )
+			return;
+		break;
+	}
+
+	/* Record snapshot */
+	snap = &profsnap_ring[ profsnap_prod++ % PROFSNAP_DEPTH ];
+	snap->profiler = profiler;
+	snprintf ( snap->name, sizeof ( snap->name ), "%s", name );
+	snap->when = when;
+	snap->count = profiler->count;
+	snap->mean = profile_mean ( profiler );
+	snap->p99 = profile_percentile ( profiler, 99 );
+}
+
+/**
+ * Record a snapshot of all profilers
+ *
+ */
+static void profsnap_snapshot ( void ) {
+	struct profiler *profiler;
+	struct net_device *netdev;
+	unsigned long when = currticks();
+	char name[PROFSNAP_NAME_LEN];
+
+	/* Snapshot statically registered profilers */
+	for_each_table_entry ( profiler, PROFILERS )
+		profsnap_record ( profiler, profiler->name, when );
+
+	/* Snapshot per-device datapath profilers, which exist outside
+	 * of the profiler table since network devices are created at
+	 * run time.
+	 */
+	for_each_netdev ( netdev ) {
+		snprintf ( name, sizeof ( name ), "%s.tx", netdev->name );
+		profsnap_record ( &netdev->tx_profiler, name, when );
+		snprintf ( name, sizeof ( name ), "%s.poll", netdev->name );
+		profsnap_record ( &netdev->poll_profiler, name, when );
+	}
+}
+
+/**
+ * Export accumulated snapshots via the system log
+ *
+ */
+static void profsnap_flush ( void ) {
+	struct profsnap *snap;
+	unsigned int cons;
+
+	/* Export in oldest-first order */
+	cons = ( ( profsnap_prod > PROFSNAP_DEPTH ) ?
+		 ( profsnap_prod - PROFSNAP_DEPTH ) : 0 );
+	for ( ; cons != profsnap_prod ; cons++ ) {
+		snap = &profsnap_ring[ cons % PROFSNAP_DEPTH ];
+		syslog ( LOG_INFO, "PROFSNAP %s t=%ldms n=%d mean=%ld "
+			 "p99=%ld\n", snap->name,
+			 ( snap->when / TICKS_PER_MS ), snap->count,
+			 snap->mean, snap->p99 );
+	}
+
+	/* Empty the ring */
+	profsnap_prod = 0;
+}
+
+/** Snapshot timer */
+static void profsnap_expired ( struct retry_timer *timer, int over );
+static struct retry_timer profsnap_timer =
+	TIMER_INIT ( profsnap_expired );
+
+/**
+ * Handle snapshot timer expiry
+ *
+ * @v timer		Snapshot timer
+ * @v over		Failure indicator (ignored)
+ */
+static void profsnap_expired ( struct retry_timer *timer,
+			       int over __unused ) {
+
+	/* Record snapshot and restart timer */
+	profsnap_snapshot();
+	start_timer_fixed ( timer, PROFSNAP_INTERVAL );
+}
+
+/**
+ * Start continuous profiler export
+ *
+ */
+static void profsnap_startup ( void ) {
+
+	start_timer_fixed ( &profsnap_timer, PROFSNAP_INTERVAL );
+}
+
+/**
+ * Stop continuous profiler export
+ *
+ * @v booting		System is shutting down for OS boot
+ */
+static void profsnap_shutdown ( int booting __unused ) {
+
+	/* Take a final snapshot and export the accumulated batch */
+	stop_timer ( &profsnap_timer );
+	profsnap_snapshot();
+	profsnap_flush();
+}
+
+/** Continuous profiler export startup function */
+struct startup_fn profsnap_startup_fn __startup_fn ( STARTUP_NORMAL ) = {
+	.name = "profsnap",
+	.startup = profsnap_startup,
+	.shutdown = profsnap_shutdown,
+};
@@ -2,6 +2,13 @@
  *
  * Random number generation
  *
+ * This is the fast, non-cryptographic generator used for retry
+ * jitter, initial sequence numbers, DHCP transaction IDs, and
+ * similar.  Security-sensitive callers (TLS, WPA) use the
+ * entropy-backed DRBG via rbg_generate() instead; that split is
+ * deliberate, since the DRBG is orders of magnitude more expensive
+ * and pulling it into every build would cost both time and space for
+ * no benefit where unpredictability has no security value.
  */
 
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
@@ -10,7 +17,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdlib.h>
 #include <time.h>
 
-static int32_t rnd_seed = 0;
+static uint32_t rnd_state = 0;
 
 /**
  * Seed the pseudo-random number generator
@@ -18,28 +25,29 @@ static int32_t rnd_seed = 0;
  * @v seed		Seed value
  */
 void srandom ( unsigned int seed ) {
-	rnd_seed = seed;
-	if ( ! rnd_seed )
-		rnd_seed = 4; /* Chosen by fair dice roll */
+	rnd_state = seed;
+	if ( ! rnd_state )
+		rnd_state = 4; /* Chosen by fair dice roll */
 }
 
 /**
- * Generate a pseudo-random number between 0 and 2147483647L or 2147483562?
+ * Generate a pseudo-random number between 0 and 2147483647L
  *
  * @ret rand		Pseudo-random number
  */
 long int random ( void ) {
-	int32_t q;
 
-	/* Initialize linear congruential generator */
-	if ( ! rnd_seed )
+	/* Seed from wall clock time, if not yet seeded */
+	if ( ! rnd_state )
 		srandom ( time ( NULL ) );
 
-	/* simplified version of the LCG given in Bruce Schneier's
-	   "Applied Cryptography" */
-	q = ( rnd_seed / 53668 );
-	rnd_seed = ( 40014 * ( rnd_seed - 53668 * q ) - 12211 * q );
-	if ( rnd_seed < 0 )
-		rnd_seed += 2147483563L;
-	return rnd_seed;
+	/* Marsaglia xorshift: adequate statistical quality for
+	 * non-security uses, division-free, and never reaches the
+	 * all-zeroes state from a non-zero seed.
+	 */
+	rnd_state ^= ( rnd_state << 13 );
+	rnd_state ^= ( rnd_state >> 17 );
+	rnd_state ^= ( rnd_state << 5 );
+
+	return ( rnd_state >> 1 );
 }
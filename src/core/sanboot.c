@@ -40,6 +40,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/timer.h>
 #include <ipxe/process.h>
 #include <ipxe/iso9660.h>
+#include <ipxe/umalloc.h>
 #include <ipxe/dhcp.h>
 #include <ipxe/settings.h>
 #include <ipxe/quiesce.h>
@@ -76,6 +77,16 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  */
 #define SAN_REOPEN_DELAY_SECS 5
 
+/**
+ * Readahead cache size (in bytes)
+ *
+ * OS loaders tend to read sequentially in small chunks, and each read
+ * is a complete synchronous round trip to the SAN target.  When a
+ * sequential access pattern is detected, we read a larger extent in a
+ * single command and serve subsequent reads from the cache.
+ */
+#define SAN_READAHEAD_LEN ( 256 * 1024 )
+
 /** List of SAN devices */
 LIST_HEAD ( san_devices );
 
@@ -131,6 +142,7 @@ static void sandev_free ( struct refcnt *refcnt ) {
 		uri_put ( sandev->path[i].uri );
 		assert ( sandev->path[i].desc == NULL );
 	}
+	ufree ( sandev->cache );
 	free ( sandev );
 }
 
@@ -634,6 +646,17 @@ static int sandev_rw ( struct san_device *sandev, uint64_t lba,
 	return 0;
 }
 
+/**
+ * Invalidate SAN device readahead cache
+ *
+ * @v sandev		SAN device
+ */
+static void sandev_cache_invalidate ( struct san_device *sandev ) {
+
+	sandev->cache_count = 0;
+	sandev->cache_next = 0;
+}
+
 /**
  * Read from SAN device
  *
@@ -645,12 +668,58 @@ static int sandev_rw ( struct san_device *sandev, uint64_t lba,
  */
 int sandev_read ( struct san_device *sandev, uint64_t lba,
 		  unsigned int count, void *buffer ) {
+	size_t blksize = sandev_blksize ( sandev );
+	uint64_t blocks = sandev_capacity ( sandev );
+	unsigned int max_count;
+	unsigned int ra_count;
+	size_t offset;
 	int rc;
 
+	/* Serve read from cache, if possible */
+	if ( sandev->cache_count && ( lba >= sandev->cache_lba ) &&
+	     ( ( lba + count ) <=
+	       ( sandev->cache_lba + sandev->cache_count ) ) ) {
+		offset = ( ( lba - sandev->cache_lba ) * blksize );
+		memcpy ( buffer, ( sandev->cache + offset ),
+			 ( count * blksize ) );
+		sandev->cache_next = ( lba + count );
+		return 0;
+	}
+
+	/* Read ahead on a sequential access pattern, if possible */
+	max_count = ( SAN_READAHEAD_LEN / blksize );
+	if ( ( lba == sandev->cache_next ) && ( count < max_count ) &&
+	     ( lba < blocks ) ) {
+
+		/* Allocate cache buffer, if not already allocated.
+		 * Failure is non-fatal: we simply do not read ahead.
+		 */
+		if ( ! sandev->cache )
+			sandev->cache = umalloc ( SAN_READAHEAD_LEN );
+
+		/* Limit readahead to device capacity */
+		ra_count = max_count;
+		if ( ra_count > ( blocks - lba ) )
+			ra_count = ( blocks - lba );
+
+		/* Fill cache and serve read from it, if applicable */
+		if ( sandev->cache && ( ra_count > count ) &&
+		     ( ( rc = sandev_rw ( sandev, lba, ra_count,
+					  sandev->cache,
+					  block_read ) ) == 0 ) ) {
+			sandev->cache_lba = lba;
+			sandev->cache_count = ra_count;
+			memcpy ( buffer, sandev->cache, ( count * blksize ) );
+			sandev->cache_next = ( lba + count );
+			return 0;
+		}
+	}
+
 	/* Read from device */
 	if ( ( rc = sandev_rw ( sandev, lba, count, buffer,
 				block_read ) ) != 0 )
 		return rc;
+	sandev->cache_next = ( lba + count );
 
 	return 0;
 }
@@ -668,6 +737,9 @@ int sandev_write ( struct san_device *sandev, uint64_t lba,
 		   unsigned int count, void *buffer ) {
 	int rc;
 
+	/* Invalidate readahead cache */
+	sandev_cache_invalidate ( sandev );
+
 	/* Write to device */
 	if ( ( rc = sandev_rw ( sandev, lba, count, buffer,
 				block_write ) ) != 0 )
@@ -816,6 +888,11 @@ static int sandev_parse_iso9660 ( struct san_device *sandev ) {
 		       "filesystem; treating as CD-ROM\n", sandev->drive );
 		sandev->blksize_shift = blksize_shift;
 		sandev->is_cdrom = 1;
+
+		/* Cached block numbers are in the old (unshifted)
+		 * units; invalidate the readahead cache.
+		 */
+		sandev_cache_invalidate ( sandev );
 	}
 
  err_rw:
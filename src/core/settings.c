@@ -44,6 +44,8 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/pci.h>
 #include <ipxe/init.h>
 #include <ipxe/version.h>
+#include <ipxe/timer.h>
+#include <ipxe/downloader.h>
 #include <ipxe/settings.h>
 
 /** @file
@@ -108,8 +110,17 @@ find_generic_setting ( struct generic_settings *generics,
 	struct generic_setting *generic;
 
 	list_for_each_entry ( generic, &generics->list, list ) {
-		if ( setting_cmp ( &generic->setting, setting ) == 0 )
+		if ( setting_cmp ( &generic->setting, setting ) == 0 ) {
+			/* Move to front of list.  Settings within a
+			 * block are unordered, and script variable
+			 * expansion tends to fetch the same few
+			 * settings repeatedly, so a self-organising
+			 * list makes the common lookups O(1).
+			 */
+			list_del ( &generic->list );
+			list_add ( &generic->list, &generics->list );
 			return generic;
+		}
 	}
 	return NULL;
 }
@@ -741,6 +752,7 @@ static int fetch_setting_alloc ( struct settings *settings,
 				 void * ( * alloc ) ( size_t len ) ) {
 	struct settings *tmp_origin;
 	struct setting tmp_fetched;
+	char buf[128];
 	int len;
 	int check_len;
 
@@ -753,8 +765,14 @@ static int fetch_setting_alloc ( struct settings *settings,
 	/* Avoid returning uninitialised data on error */
 	*data = NULL;
 
-	/* Check existence, and fetch setting length */
-	len = fetch_setting ( settings, setting, origin, fetched, NULL, 0 );
+	/* Check existence, and fetch setting length.  Fetch into a
+	 * stack buffer at the same time: most settings fit, and this
+	 * avoids performing a second full fetch (which for some
+	 * settings blocks means reparsing the underlying data) merely
+	 * to retrieve the value.
+	 */
+	len = fetch_setting ( settings, setting, origin, fetched, buf,
+			      sizeof ( buf ) );
 	if ( len < 0 )
 		return len;
 
@@ -763,9 +781,14 @@ static int fetch_setting_alloc ( struct settings *settings,
 	if ( ! *data )
 		return -ENOMEM;
 
-	/* Fetch setting value */
-	check_len = fetch_setting ( *origin, fetched, NULL, NULL, *data, len );
-	assert ( check_len == len );
+	/* Copy or fetch setting value */
+	if ( ( ( size_t ) len ) <= sizeof ( buf ) ) {
+		memcpy ( *data, buf, len );
+	} else {
+		check_len = fetch_setting ( *origin, fetched, NULL, NULL,
+					    *data, len );
+		assert ( check_len == len );
+	}
 	return len;
 }
 
@@ -2650,6 +2673,116 @@ struct builtin_setting unixtime_builtin_setting __builtin_setting = {
 	.fetch = unixtime_fetch,
 };
 
+/**
+ * Fetch a last transfer metric setting
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @v content		Metric value
+ * @ret len		Length of setting data, or negative error
+ */
+static int xfermetric_fetch ( void *data, size_t len, uint32_t content ) {
+
+	/* Fail if no download has completed */
+	if ( ! downloader_metrics.valid )
+		return -ENOENT;
+
+	content = htonl ( content );
+	if ( len > sizeof ( content ) )
+		len = sizeof ( content );
+	memcpy ( data, &content, len );
+	return sizeof ( content );
+}
+
+/**
+ * Fetch last transfer rate setting
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int xferrate_fetch ( void *data, size_t len ) {
+	unsigned long elapsed = downloader_metrics.elapsed;
+
+	/* Round sub-tick transfers up to one tick rather than
+	 * reporting a division-by-zero rate
+	 */
+	if ( ! elapsed )
+		elapsed = 1;
+
+	return xfermetric_fetch ( data, len,
+				  ( ( ( ( uint64_t ) downloader_metrics.len ) *
+				      TICKS_PER_SEC ) / elapsed ) );
+}
+
+/** Last transfer rate setting */
+const struct setting xferrate_setting __setting ( SETTING_MISC, xferrate ) = {
+	.name = "xferrate",
+	.description = "Last transfer rate (bytes/sec)",
+	.type = &setting_type_uint32,
+	.scope = &builtin_scope,
+};
+
+/** Last transfer rate built-in setting */
+struct builtin_setting xferrate_builtin_setting __builtin_setting = {
+	.setting = &xferrate_setting,
+	.fetch = xferrate_fetch,
+};
+
+/**
+ * Fetch last transfer time setting
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int xfertime_fetch ( void *data, size_t len ) {
+
+	return xfermetric_fetch ( data, len, ( downloader_metrics.elapsed /
+					       TICKS_PER_MS ) );
+}
+
+/** Last transfer time setting */
+const struct setting xfertime_setting __setting ( SETTING_MISC, xfertime ) = {
+	.name = "xfertime",
+	.description = "Last transfer time (ms)",
+	.type = &setting_type_uint32,
+	.scope = &builtin_scope,
+};
+
+/** Last transfer time built-in setting */
+struct builtin_setting xfertime_builtin_setting __builtin_setting = {
+	.setting = &xfertime_setting,
+	.fetch = xfertime_fetch,
+};
+
+/**
+ * Fetch last transfer restart count setting
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int xferrestarts_fetch ( void *data, size_t len ) {
+
+	return xfermetric_fetch ( data, len, downloader_metrics.restarts );
+}
+
+/** Last transfer restart count setting */
+const struct setting xferrestarts_setting
+	__setting ( SETTING_MISC, xferrestarts ) = {
+	.name = "xferrestarts",
+	.description = "Last transfer restarts",
+	.type = &setting_type_uint32,
+	.scope = &builtin_scope,
+};
+
+/** Last transfer restart count built-in setting */
+struct builtin_setting xferrestarts_builtin_setting __builtin_setting = {
+	.setting = &xferrestarts_setting,
+	.fetch = xferrestarts_fetch,
+};
+
 /**
  * Fetch current working URI-related setting
  *
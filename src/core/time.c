@@ -24,6 +24,8 @@
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <time.h>
+#include <ipxe/init.h>
+#include <ipxe/version.h>
 
 /** @file
  *
@@ -143,3 +145,29 @@ time_t mktime ( struct tm *tm ) {
 
 	return seconds;
 }
+
+/**
+ * Apply build timestamp as system clock lower bound
+ *
+ * On platforms with no (or a dead-battery) real-time clock, the
+ * system clock may start at or close to the Epoch, which guarantees
+ * that certificate validity period checks will fail unless and until
+ * an NTP adjustment is applied.  The build timestamp is known to lie
+ * in the past, and so provides a safe lower bound on the current
+ * time.
+ */
+static void time_startup ( void ) {
+	time_t now = time ( NULL );
+
+	if ( now < ( ( time_t ) build_timestamp ) ) {
+		DBGC ( &weekdays, "TIME clamping %lld to build timestamp "
+		       "%ld\n", now, build_timestamp );
+		time_adjust ( build_timestamp - now );
+	}
+}
+
+/** System clock startup function */
+struct startup_fn time_startup_fn __startup_fn ( STARTUP_EARLY ) = {
+	.name = "time",
+	.startup = time_startup,
+};
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdio.h>
+#include <ipxe/timer.h>
+#include <ipxe/timeline.h>
+
+/** @file
+ *
+ * Boot timeline
+ *
+ * The boot timeline records coarse-grained milestones (startup
+ * phases, network configuration, etc.) with timestamps, to allow
+ * startup latency to be examined and tracked across builds.
+ * Recording a milestone is cheap enough to leave permanently enabled.
+ *
+ */
+
+/** Number of events in the timeline ring buffer */
+#define TIMELINE_MAX 32
+
+/** Timeline ring buffer */
+static struct timeline_event timeline[TIMELINE_MAX];
+
+/** Total number of events recorded */
+static unsigned int timeline_count;
+
+/**
+ * Record a boot timeline event
+ *
+ * @v name		Event name
+ *
+ * The name is recorded by pointer and so must have static storage
+ * duration.
+ */
+void timeline_record ( const char *name ) {
+	struct timeline_event *event;
+
+	event = &timeline[ timeline_count++ % TIMELINE_MAX ];
+	event->name = name;
+	event->ticks = currticks();
+}
+
+/**
+ * Show the boot timeline
+ *
+ */
+void timeline_show ( void ) {
+	struct timeline_event *event;
+	unsigned long previous = 0;
+	unsigned long relative;
+	unsigned int first = 0;
+	unsigned int i;
+
+	/* Identify oldest recorded event, if the ring has wrapped */
+	if ( timeline_count > TIMELINE_MAX ) {
+		printf ( "(%d earlier events overwritten)\n",
+			 ( timeline_count - TIMELINE_MAX ) );
+		first = ( timeline_count - TIMELINE_MAX );
+	}
+
+	/* Print events, with times relative to the oldest shown event */
+	for ( i = first ; i < timeline_count ; i++ ) {
+		event = &timeline[ i % TIMELINE_MAX ];
+		if ( i == first )
+			previous = event->ticks;
+		relative = ( event->ticks - previous );
+		printf ( "+%ld.%03lds %s\n",
+			 ( relative / TICKS_PER_SEC ),
+			 ( ( relative % TICKS_PER_SEC ) * 1000 /
+			   TICKS_PER_SEC ), event->name );
+	}
+}
@@ -37,6 +37,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/vsprintf.h>
 #include <ipxe/params.h>
 #include <ipxe/tcpip.h>
+#include <ipxe/malloc.h>
 #include <ipxe/uri.h>
 
 /**
@@ -283,6 +284,92 @@ static void uri_free ( struct refcnt *refcnt ) {
 	free ( uri );
 }
 
+/** Maximum number of interned parsed URIs */
+#define URI_CACHE_MAX 8
+
+/** An interned parsed URI */
+struct cached_uri {
+	/** List of interned URIs */
+	struct list_head list;
+	/** Original URI string */
+	char *string;
+	/** Shared parsed URI */
+	struct uri *uri;
+};
+
+/** List of interned parsed URIs (most recently used first)
+ *
+ * Parsed URI objects are immutable (modification requires uri_dup()),
+ * so identical URI strings can safely share a single refcounted
+ * parsed object.  Chained scripts and menus tend to re-resolve the
+ * same handful of URIs repeatedly.
+ */
+static LIST_HEAD ( uri_cache );
+
+/** Number of currently interned parsed URIs */
+static unsigned int uri_cache_count;
+
+/**
+ * Intern a parsed URI
+ *
+ * @v uri_string	Original URI string
+ * @v uri		Parsed URI
+ */
+static void uri_intern ( const char *uri_string, struct uri *uri ) {
+	struct cached_uri *cached;
+	struct cached_uri *evictee;
+	size_t len = ( strlen ( uri_string ) + 1 /* NUL */ );
+
+	/* Never intern URIs with request parameters, since claiming
+	 * the parameter list is a single-use operation.
+	 */
+	if ( uri->params )
+		return;
+
+	/* Create cache entry */
+	cached = zalloc ( sizeof ( *cached ) + len );
+	if ( ! cached )
+		return;
+	cached->string = ( ( ( void * ) cached ) + sizeof ( *cached ) );
+	memcpy ( cached->string, uri_string, len );
+	cached->uri = uri_get ( uri );
+	list_add ( &cached->list, &uri_cache );
+
+	/* Evict least recently used entry, if applicable */
+	if ( ++uri_cache_count > URI_CACHE_MAX ) {
+		evictee = list_last_entry ( &uri_cache, struct cached_uri,
+					    list );
+		list_del ( &evictee->list );
+		uri_cache_count--;
+		uri_put ( evictee->uri );
+		free ( evictee );
+	}
+}
+
+/**
+ * Discard all interned parsed URIs
+ *
+ * @ret discarded	Number of interned URIs discarded
+ */
+static unsigned int uri_cache_discard ( void ) {
+	struct cached_uri *cached;
+	struct cached_uri *tmp;
+	unsigned int discarded = uri_cache_count;
+
+	list_for_each_entry_safe ( cached, tmp, &uri_cache, list ) {
+		list_del ( &cached->list );
+		uri_put ( cached->uri );
+		free ( cached );
+	}
+	uri_cache_count = 0;
+	return discarded;
+}
+
+/** Interned URI discarder */
+struct cache_discarder uri_cache_discarder __cache_discarder ( CACHE_CHEAP ) = {
+	.discard = uri_cache_discard,
+};
+
 /**
  * Parse URI
  *
@@ -296,6 +383,7 @@ static void uri_free ( struct refcnt *refcnt ) {
 struct uri * parse_uri ( const char *uri_string ) {
 	struct uri *uri;
 	struct parameters *params;
+	struct cached_uri *cached;
 	char *raw;
 	char *tmp;
 	char *path;
@@ -304,6 +392,15 @@ struct uri * parse_uri ( const char *uri_string ) {
 	size_t raw_len;
 	unsigned int field;
 
+	/* Return a shared interned URI, if available */
+	list_for_each_entry ( cached, &uri_cache, list ) {
+		if ( strcmp ( cached->string, uri_string ) == 0 ) {
+			list_del ( &cached->list );
+			list_add ( &cached->list, &uri_cache );
+			return uri_get ( cached->uri );
+		}
+	}
+
 	/* Allocate space for URI struct and two copies of the string */
 	raw_len = ( strlen ( uri_string ) + 1 /* NUL */ );
 	uri = zalloc ( sizeof ( *uri ) + ( 2 * raw_len ) );
@@ -442,6 +539,9 @@ struct uri * parse_uri ( const char *uri_string ) {
 	uri_dump ( uri );
 	DBGC ( uri, "\n" );
 
+	/* Intern parsed URI for subsequent reuse */
+	uri_intern ( uri_string, uri );
+
 	return uri;
 }
 
@@ -54,15 +54,32 @@ static struct profiler xferbuf_read_profiler __profiler =
  * Detach data from data transfer buffer
  *
  * @v xferbuf		Data transfer buffer
+ * @ret data		Data previously owned by the data transfer buffer
  *
- * The caller assumes responsibility for eventually freeing the data
- * previously owned by the data transfer buffer.
+ * The caller assumes responsibility for eventually freeing the
+ * returned data.  Note that trimming the excess reservation may
+ * relocate the data: the caller must use the returned pointer rather
+ * than any previously captured copy of xferbuf->data.
  */
-void xferbuf_detach ( struct xfer_buffer *xferbuf ) {
+void * xferbuf_detach ( struct xfer_buffer *xferbuf ) {
+	void *data;
 
+	/* Trim any excess reservation before handing over the data.
+	 * If trimming fails then the caller simply inherits the
+	 * larger allocation.
+	 */
+	if ( xferbuf->reserved > xferbuf->len ) {
+		if ( xferbuf->op->realloc ( xferbuf, xferbuf->len ) == 0 )
+			xferbuf->reserved = xferbuf->len;
+	}
+
+	data = xferbuf->data;
 	xferbuf->data = NULL;
 	xferbuf->len = 0;
+	xferbuf->reserved = 0;
 	xferbuf->pos = 0;
+
+	return data;
 }
 
 /**
@@ -73,6 +90,8 @@ void xferbuf_detach ( struct xfer_buffer *xferbuf ) {
 void xferbuf_free ( struct xfer_buffer *xferbuf ) {
 
 	xferbuf->op->realloc ( xferbuf, 0 );
+	xferbuf->len = 0;
+	xferbuf->reserved = 0;
 	xferbuf_detach ( xferbuf );
 }
 
@@ -84,17 +103,37 @@ void xferbuf_free ( struct xfer_buffer *xferbuf ) {
  * @ret rc		Return status code
  */
 static int xferbuf_ensure_size ( struct xfer_buffer *xferbuf, size_t len ) {
+	size_t reserve;
 	int rc;
 
 	/* If buffer is already large enough, do nothing */
 	if ( len <= xferbuf->len )
 		return 0;
 
-	/* Extend buffer */
-	if ( ( rc = xferbuf->op->realloc ( xferbuf, len ) ) != 0 ) {
-		DBGC ( xferbuf, "XFERBUF %p could not extend buffer to "
-		       "%zd bytes: %s\n", xferbuf, len, strerror ( rc ) );
-		return rc;
+	/* Extend allocation if needed.  Grow the reservation
+	 * geometrically: repeated small extensions (e.g. one TCP
+	 * segment per delivery) would otherwise copy the entire
+	 * buffer contents on every extension.
+	 */
+	if ( len > xferbuf->reserved ) {
+		reserve = ( xferbuf->reserved * 2 );
+		if ( reserve < len )
+			reserve = len;
+		if ( ( rc = xferbuf->op->realloc ( xferbuf, reserve ) ) != 0 ) {
+			/* Fall back to extending by the exact
+			 * required amount, in case the geometric
+			 * reservation exceeds available memory.
+			 */
+			reserve = len;
+			if ( ( rc = xferbuf->op->realloc ( xferbuf,
+							   reserve ) ) != 0 ) {
+				DBGC ( xferbuf, "XFERBUF %p could not extend "
+				       "buffer to %zd bytes: %s\n", xferbuf,
+				       len, strerror ( rc ) );
+				return rc;
+			}
+		}
+		xferbuf->reserved = reserve;
 	}
 	xferbuf->len = len;
 
@@ -387,6 +387,48 @@ static void aes_final ( const struct aes_table *table, size_t stride,
 	aes_addroundkey ( out, key );
 }
 
+/**
+ * Check for hardware-accelerated AES support
+ *
+ * @ret supported	Hardware-accelerated AES is supported
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak int aes_accel_supported ( void ) {
+	return 0;
+}
+
+/**
+ * Encrypt data using hardware acceleration
+ *
+ * @v aes		AES context
+ * @v src		Data to encrypt
+ * @v dst		Buffer for encrypted data
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak void aes_accel_encrypt ( struct aes_context *aes __unused,
+				const void *src __unused,
+				void *dst __unused ) {
+}
+
+/**
+ * Decrypt data using hardware acceleration
+ *
+ * @v aes		AES context
+ * @v src		Data to decrypt
+ * @v dst		Buffer for decrypted data
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak void aes_accel_decrypt ( struct aes_context *aes __unused,
+				const void *src __unused,
+				void *dst __unused ) {
+}
+
 /**
  * Encrypt data
  *
@@ -405,6 +447,12 @@ static void aes_encrypt ( void *ctx, const void *src, void *dst, size_t len ) {
 	/* Sanity check */
 	assert ( len == sizeof ( *in ) );
 
+	/* Use hardware acceleration, if applicable */
+	if ( aes->accel ) {
+		aes_accel_encrypt ( aes, src, dst );
+		return;
+	}
+
 	/* Initialise input state */
 	memcpy ( in, src, sizeof ( *in ) );
 
@@ -441,6 +489,12 @@ static void aes_decrypt ( void *ctx, const void *src, void *dst, size_t len ) {
 	/* Sanity check */
 	assert ( len == sizeof ( *in ) );
 
+	/* Use hardware acceleration, if applicable */
+	if ( aes->accel ) {
+		aes_accel_decrypt ( aes, src, dst );
+		return;
+	}
+
 	/* Initialise input state */
 	memcpy ( in, src, sizeof ( *in ) );
 
@@ -716,6 +770,12 @@ static int aes_setkey ( void *ctx, const void *key, size_t keylen ) {
 	enc = aes->encrypt.key;
 	end = enc[rounds].column;
 
+	/* Check for hardware-accelerated implementation.  The
+	 * accelerated implementation reuses the expanded key
+	 * schedules constructed below.
+	 */
+	aes->accel = aes_accel_supported();
+
 	/* Copy raw key */
 	memcpy ( enc, key, keylen );
 	prev = enc->column;
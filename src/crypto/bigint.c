@@ -627,6 +627,13 @@ void bigint_montgomery_raw ( const bigint_element_t *modulus0,
  * defined as repeated multiplication, but that the ladder may equally
  * well be used to perform any isomorphic operation (such as
  * multiplication defined as repeated addition).
+ *
+ * A fixed-window exponentiation with precomputed powers would reduce
+ * the operation count by around a third, but would require either
+ * exponent-dependent table accesses or constant-time masked scans of
+ * the whole table that erode most of the saving.  We therefore retain
+ * the ladder's data-independent access pattern, and rely on the
+ * architecture-specific multiplication kernels for speed.
  */
 void bigint_ladder_raw ( bigint_element_t *result0,
 			 bigint_element_t *multiple0, unsigned int size,
@@ -649,6 +649,7 @@ static void cms_free ( struct refcnt *refcnt ) {
 	list_for_each_entry_safe ( part, tmp, &cms->participants, list ) {
 		list_del ( &part->list );
 		x509_chain_put ( part->chain );
+		free ( part->ctx );
 		free ( part );
 	}
 	x509_chain_put ( cms->certificates );
@@ -705,6 +706,61 @@ int cms_message ( struct image *image, struct cms_message **cms ) {
 	return rc;
 }
 
+/**
+ * Start incremental digest calculation
+ *
+ * @v cms		CMS message
+ * @ret rc		Return status code
+ *
+ * The digest algorithm used by each signer is known as soon as the
+ * detached signature has been parsed, which allows the signed data to
+ * be digested in arbitrary increments (e.g. interleaved with network
+ * operations) before cms_verify() is eventually called.
+ */
+int cms_digest_init ( struct cms_message *cms ) {
+	struct cms_participant *part;
+
+	/* Sanity check */
+	if ( ! cms_is_signature ( cms ) )
+		return -ENOTTY;
+
+	/* Initialise digest context for each participant */
+	list_for_each_entry ( part, &cms->participants, list ) {
+		if ( ! part->ctx ) {
+			part->ctx = malloc ( part->digest->ctxsize );
+			if ( ! part->ctx )
+				return -ENOMEM;
+		}
+		digest_init ( part->digest, part->ctx );
+	}
+
+	/* Reset digested length */
+	cms->digested = 0;
+
+	return 0;
+}
+
+/**
+ * Update incremental digest calculation
+ *
+ * @v cms		CMS message
+ * @v data		Signed data
+ * @v len		Length of signed data
+ */
+void cms_digest_update ( struct cms_message *cms, const void *data,
+			 size_t len ) {
+	struct cms_participant *part;
+
+	/* Update digest context for each participant */
+	list_for_each_entry ( part, &cms->participants, list ) {
+		assert ( part->ctx != NULL );
+		digest_update ( part->digest, part->ctx, data, len );
+	}
+
+	/* Update digested length */
+	cms->digested += len;
+}
+
 /**
  * Calculate digest of CMS-signed data
  *
@@ -720,10 +776,19 @@ static void cms_digest ( struct cms_message *cms,
 	struct digest_algorithm *digest = part->digest;
 	uint8_t ctx[ digest->ctxsize ];
 
-	/* Calculate digest */
-	digest_init ( digest, ctx );
-	digest_update ( digest, ctx, data, len );
-	digest_final ( digest, ctx, out );
+	/* Use the incrementally calculated digest if it covers
+	 * exactly the data to be digested, otherwise calculate the
+	 * digest from scratch.
+	 */
+	if ( part->ctx && ( cms->digested == len ) ) {
+		digest_final ( digest, part->ctx, out );
+		free ( part->ctx );
+		part->ctx = NULL;
+	} else {
+		digest_init ( digest, ctx );
+		digest_update ( digest, ctx, data, len );
+		digest_final ( digest, ctx, out );
+	}
 
 	DBGC ( cms, "CMS %p/%p digest value:\n", cms, part );
 	DBGC_HDA ( cms, 0, out, digest->digestsize );
@@ -827,6 +892,14 @@ static int cms_verify_signer ( struct cms_message *cms,
  * @v store		Certificate store, or NULL to use default
  * @v root		Root certificate list, or NULL to use default
  * @ret rc		Return status code
+ *
+ * The detached signature (which identifies the digest algorithm used
+ * by each signer) is generally not available until after the image
+ * itself has been downloaded, so the image cannot be hashed while it
+ * is still being transferred.  Callers may nevertheless overlap the
+ * digest pass with other work (such as certificate chain validation)
+ * by feeding the image data through cms_digest_init() and
+ * cms_digest_update() before calling cms_verify().
  */
 int cms_verify ( struct cms_message *cms, struct image *image,
 		 const char *name, time_t time, struct x509_chain *store,
@@ -21,10 +21,112 @@
 
 FILE_LICENCE ( GPL2_OR_LATER );
 
+#include <byteswap.h>
 #include <ipxe/crc32.h>
 
 #define CRCPOLY		0xedb88320
 
+/** CRC32C (Castagnoli) polynomial */
+#define CRC32CPOLY	0x82f63b78
+
+/** Number of bytes processed per iteration */
+#define CRC32_SLICES 8
+
+/** Slice-by-N lookup tables
+ *
+ * Table N gives the effect upon the final CRC of a byte appearing N
+ * bytes before the end of the data.  The tables are generated at run
+ * time, to avoid increasing the size of the compressed binary.
+ */
+static u32 crc32_table[CRC32_SLICES][256];
+
+/** Slice-by-N lookup tables for the CRC32C polynomial */
+static u32 crc32c_table[CRC32_SLICES][256];
+
+/**
+ * Generate CRC32 lookup tables
+ *
+ * @v poly	Generator polynomial (in reversed bit order)
+ * @v table	Lookup tables to fill in
+ */
+static void crc32_generate ( u32 poly, u32 table[CRC32_SLICES][256] ) {
+	unsigned int i;
+	unsigned int j;
+	u32 crc;
+	u32 mult;
+
+	/* Generate single-byte CRCs */
+	for ( i = 0 ; i < 256 ; i++ ) {
+		crc = i;
+		for ( j = 0 ; j < 8 ; j++ ) {
+			mult = ( crc & 1 ) ? poly : 0;
+			crc = ( crc >> 1 ) ^ mult;
+		}
+		table[0][i] = crc;
+	}
+
+	/* Generate effect of each byte shifted by a further (N-1)
+	 * zero bytes.
+	 */
+	for ( i = 1 ; i < CRC32_SLICES ; i++ ) {
+		for ( j = 0 ; j < 256 ; j++ ) {
+			crc = table[ i - 1 ][j];
+			table[i][j] = ( table[0][ crc & 0xff ] ^
+					( crc >> 8 ) );
+		}
+	}
+}
+
+/**
+ * Calculate 32-bit little-endian CRC checksum using lookup tables
+ *
+ * @v table	Lookup tables
+ * @v seed	Initial value
+ * @v data	Data to checksum
+ * @v len	Length of data
+ * @ret crc	Updated CRC value
+ */
+static u32 crc32_slice ( u32 table[CRC32_SLICES][256], u32 seed,
+			 const void *data, size_t len ) {
+	const u32 __attribute__ (( may_alias )) *word;
+	const u8 *src = data;
+	u32 crc = seed;
+	u32 lo;
+	u32 hi;
+
+	/* Process bytes up to the first word boundary */
+	while ( len && ( ( ( intptr_t ) src ) & ( sizeof ( *word ) - 1 ) ) ) {
+		crc = ( table[0][ ( crc ^ *(src++) ) & 0xff ] ^
+			( crc >> 8 ) );
+		len--;
+	}
+
+	/* Process whole words, a slice of bytes at a time */
+	while ( len >= CRC32_SLICES ) {
+		word = ( ( const void * ) src );
+		lo = ( le32_to_cpu ( word[0] ) ^ crc );
+		hi = le32_to_cpu ( word[1] );
+		crc = ( table[7][ ( lo >>  0 ) & 0xff ] ^
+			table[6][ ( lo >>  8 ) & 0xff ] ^
+			table[5][ ( lo >> 16 ) & 0xff ] ^
+			table[4][ ( lo >> 24 ) & 0xff ] ^
+			table[3][ ( hi >>  0 ) & 0xff ] ^
+			table[2][ ( hi >>  8 ) & 0xff ] ^
+			table[1][ ( hi >> 16 ) & 0xff ] ^
+			table[0][ ( hi >> 24 ) & 0xff ] );
+		src += CRC32_SLICES;
+		len -= CRC32_SLICES;
+	}
+
+	/* Process remaining bytes */
+	while ( len-- ) {
+		crc = ( table[0][ ( crc ^ *(src++) ) & 0xff ] ^
+			( crc >> 8 ) );
+	}
+
+	return crc;
+}
+
 /**
  * Calculate 32-bit little-endian CRC checksum
  *
@@ -36,20 +138,63 @@ FILE_LICENCE ( GPL2_OR_LATER );
  * protocol. To continue a CRC checksum over multiple calls, pass the
  * return value from one call as the @a seed parameter to the next.
  */
-u32 crc32_le ( u32 seed, const void *data, size_t len )
-{
-	u32 crc = seed;
-	const u8 *src = data;
-	u32 mult;
-	int i;
+u32 crc32_le ( u32 seed, const void *data, size_t len ) {
 
-	while ( len-- ) {
-		crc ^= *src++;
-		for ( i = 0; i < 8; i++ ) {
-			mult = ( crc & 1 ) ? CRCPOLY : 0;
-			crc = ( crc >> 1 ) ^ mult;
-		}
-	}
+	/* Generate lookup tables, if not already done */
+	if ( ! crc32_table[0][1] )
+		crc32_generate ( CRCPOLY, crc32_table );
 
-	return crc;
+	return crc32_slice ( crc32_table, seed, data, len );
+}
+
+/**
+ * Check for hardware-accelerated CRC32C support
+ *
+ * @ret supported	Hardware-accelerated CRC32C is supported
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak int crc32c_accel_supported ( void ) {
+	return 0;
+}
+
+/**
+ * Calculate CRC32C checksum using hardware acceleration
+ *
+ * @v seed	Initial value
+ * @v data	Data to checksum
+ * @v len	Length of data
+ * @ret crc	Updated CRC value
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak u32 crc32c_accel ( u32 seed, const void *data __unused,
+			  size_t len __unused ) {
+	return seed;
+}
+
+/**
+ * Calculate 32-bit little-endian CRC32C (Castagnoli) checksum
+ *
+ * @v seed	Initial value
+ * @v data	Data to checksum
+ * @v len	Length of data
+ *
+ * As for crc32_le(), the CRC may be continued over multiple calls by
+ * passing the return value from one call as the @a seed parameter to
+ * the next.
+ */
+u32 crc32c_le ( u32 seed, const void *data, size_t len ) {
+
+	/* Use hardware acceleration, if applicable */
+	if ( crc32c_accel_supported() )
+		return crc32c_accel ( seed, data, len );
+
+	/* Generate lookup tables, if not already done */
+	if ( ! crc32c_table[0][1] )
+		crc32_generate ( CRC32CPOLY, crc32c_table );
+
+	return crc32_slice ( crc32c_table, seed, data, len );
 }
@@ -195,7 +195,7 @@ static void deflate_dump_alphabet ( struct deflate *deflate,
 		deflate_alphabet_name ( deflate, alphabet ) );
 	for ( i = 0 ; i < ( sizeof ( alphabet->lookup ) /
 			    sizeof ( alphabet->lookup[0] ) ) ; i++ ) {
-		DBGC2 ( alphabet, " %d", ( alphabet->lookup[i] + 1 ) );
+		DBGC2 ( alphabet, " %04x", alphabet->lookup[i] );
 	}
 	DBGC2 ( alphabet, "\n" );
 }
@@ -219,6 +219,9 @@ static int deflate_alphabet ( struct deflate *deflate,
 	unsigned int raw;
 	unsigned int adjustment;
 	unsigned int prefix;
+	unsigned int entry;
+	unsigned int copies;
+	unsigned int i;
 	int complete;
 
 	/* Clear symbol table */
@@ -276,9 +279,40 @@ static int deflate_alphabet ( struct deflate *deflate,
 		huf_sym->raw -= adjustment; /* Adjust for quick indexing */
 
 		/* Populate quick lookup table */
-		for ( prefix = ( huf_sym->start >> DEFLATE_HUFFMAN_QL_SHIFT ) ;
-		      prefix < ( 1 << DEFLATE_HUFFMAN_QL_BITS ) ; prefix++ ) {
-			alphabet->lookup[prefix] = ( bits - 1 );
+		prefix = ( huf_sym->start >> DEFLATE_HUFFMAN_QL_SHIFT );
+		if ( bits <= DEFLATE_HUFFMAN_QL_BITS ) {
+
+			/* Short symbols are decoded directly by the
+			 * quick lookup table: store the raw symbol
+			 * and its length in each entry having the
+			 * Huffman-coded symbol as a prefix.
+			 */
+			for ( i = 0 ; i < huf_sym->freq ; i++ ) {
+				raw = huf_sym->raw[ adjustment + i ];
+				entry = ( ( raw <<
+					    DEFLATE_HUFFMAN_QL_RAW_SHIFT )
+					  | bits );
+				copies = ( 1 << ( DEFLATE_HUFFMAN_QL_BITS -
+						  bits ) );
+				while ( copies-- )
+					alphabet->lookup[ prefix++ ] = entry;
+			}
+
+		} else {
+
+			/* Longer symbols are decoded via a search
+			 * through the symbol sets: store the symbol
+			 * set index (and a zero length) in all
+			 * remaining entries.  Sets for longer lengths
+			 * will subsequently overwrite the entries for
+			 * their own prefixes.
+			 */
+			entry = ( ( bits - 1 ) <<
+				  DEFLATE_HUFFMAN_QL_RAW_SHIFT );
+			for ( ; prefix < ( 1 << DEFLATE_HUFFMAN_QL_BITS ) ;
+			      prefix++ ) {
+				alphabet->lookup[prefix] = entry;
+			}
 		}
 	}
 
@@ -390,7 +424,8 @@ static int deflate_decode ( struct deflate *deflate,
 			    struct deflate_alphabet *alphabet ) {
 	struct deflate_huf_symbols *huf_sym;
 	uint16_t huf;
-	unsigned int lookup_index;
+	unsigned int entry;
+	unsigned int bits;
 	int excess;
 	unsigned int raw;
 
@@ -404,9 +439,32 @@ static int deflate_decode ( struct deflate *deflate,
 	/* Normalise the bit-reversed accumulated value to 16 bits */
 	huf = ( deflate->rotalumucca >> 16 );
 
-	/* Find symbol set for this length */
-	lookup_index = ( huf >> DEFLATE_HUFFMAN_QL_SHIFT );
-	huf_sym = &alphabet->huf[ alphabet->lookup[ lookup_index ] ];
+	/* Decode short symbols directly via the quick lookup table */
+	entry = alphabet->lookup[ huf >> DEFLATE_HUFFMAN_QL_SHIFT ];
+	bits = ( entry & DEFLATE_HUFFMAN_QL_LEN_MASK );
+	if ( bits ) {
+
+		/* Calculate number of excess bits, and return if not
+		 * yet complete.
+		 */
+		excess = ( deflate->bits - bits );
+		if ( excess < 0 )
+			return excess;
+
+		/* Consume bits */
+		deflate_consume ( deflate, bits );
+
+		/* Extract raw symbol */
+		raw = ( entry >> DEFLATE_HUFFMAN_QL_RAW_SHIFT );
+		DBGCP ( deflate, "DEFLATE %p decoded %s = %#x = %d\n", deflate,
+			deflate_bin ( ( huf >> ( 16 - bits ) ), bits ),
+			raw, raw );
+
+		return raw;
+	}
+
+	/* Find symbol set for longer symbols */
+	huf_sym = &alphabet->huf[ entry >> DEFLATE_HUFFMAN_QL_RAW_SHIFT ];
 	while ( huf < huf_sym->start )
 		huf_sym--;
 
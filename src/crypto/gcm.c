@@ -280,6 +280,31 @@ static void gcm_multiply_x_8 ( union gcm_block *poly ) {
 	poly->word[0] ^= gcm_cached_reduce[msb];
 }
 
+/**
+ * Check for hardware-accelerated GCM support
+ *
+ * @ret supported	Hardware-accelerated GCM is supported
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak int gcm_accel_supported ( void ) {
+	return 0;
+}
+
+/**
+ * Multiply polynomial by hash key in situ using hardware acceleration
+ *
+ * @v key		Hash key
+ * @v poly		Multiplicand and result
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak void gcm_accel_multiply ( const union gcm_block *key __unused,
+				 union gcm_block *poly __unused ) {
+}
+
 /**
  * Multiply polynomial by hash key in situ
  *
@@ -291,6 +316,12 @@ static void gcm_multiply_key ( const union gcm_block *key,
 	union gcm_block res;
 	uint8_t *byte;
 
+	/* Use hardware acceleration, if applicable */
+	if ( gcm_accel_supported() ) {
+		gcm_accel_multiply ( key, poly );
+		return;
+	}
+
 	/* Construct tables, if necessary */
 	if ( gcm_cached_key != key )
 		gcm_cache ( key );
@@ -57,24 +57,37 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 void hmac_init ( struct digest_algorithm *digest, void *ctx, const void *key,
 		 size_t key_len ) {
 	hmac_context_t ( digest ) *hctx = ctx;
+	uint8_t pad[digest->blocksize];
 	unsigned int i;
 
 	/* Construct input pad */
-	memset ( hctx->pad, 0, sizeof ( hctx->pad ) );
-	if ( key_len <= sizeof ( hctx->pad ) ) {
-		memcpy ( hctx->pad, key, key_len );
+	memset ( pad, 0, sizeof ( pad ) );
+	if ( key_len <= sizeof ( pad ) ) {
+		memcpy ( pad, key, key_len );
 	} else {
 		digest_init ( digest, hctx->ctx );
 		digest_update ( digest, hctx->ctx, key, key_len );
-		digest_final ( digest, hctx->ctx, hctx->pad );
+		digest_final ( digest, hctx->ctx, pad );
 	}
-	for ( i = 0 ; i < sizeof ( hctx->pad ) ; i++ ) {
-		hctx->pad[i] ^= 0x36;
+	for ( i = 0 ; i < sizeof ( pad ) ; i++ ) {
+		pad[i] ^= 0x36;
 	}
 
 	/* Start inner hash */
 	digest_init ( digest, hctx->ctx );
-	digest_update ( digest, hctx->ctx, hctx->pad, sizeof ( hctx->pad ) );
+	digest_update ( digest, hctx->ctx, pad, sizeof ( pad ) );
+
+	/* Construct output pad from input pad */
+	for ( i = 0 ; i < sizeof ( pad ) ; i++ ) {
+		pad[i] ^= 0x6a;
+	}
+
+	/* Start outer hash */
+	digest_init ( digest, hctx->octx );
+	digest_update ( digest, hctx->octx, pad, sizeof ( pad ) );
+
+	/* Erase padding (from which the key may be derivable) */
+	memset ( pad, 0, sizeof ( pad ) );
 }
 
 /**
@@ -86,22 +99,11 @@ void hmac_init ( struct digest_algorithm *digest, void *ctx, const void *key,
  */
 void hmac_final ( struct digest_algorithm *digest, void *ctx, void *hmac ) {
 	hmac_context_t ( digest ) *hctx = ctx;
-	unsigned int i;
-
-	/* Construct output pad from input pad */
-	for ( i = 0 ; i < sizeof ( hctx->pad ) ; i++ ) {
-		hctx->pad[i] ^= 0x6a;
-	}
 
 	/* Finish inner hash */
 	digest_final ( digest, hctx->ctx, hmac );
 
-	/* Perform outer hash */
-	digest_init ( digest, hctx->ctx );
-	digest_update ( digest, hctx->ctx, hctx->pad, sizeof ( hctx->pad ) );
-	digest_update ( digest, hctx->ctx, hmac, digest->digestsize );
-	digest_final ( digest, hctx->ctx, hmac );
-
-	/* Erase output pad (from which the key may be derivable) */
-	memset ( hctx->pad, 0, sizeof ( hctx->pad ) );
+	/* Finish outer hash */
+	digest_update ( digest, hctx->octx, hmac, digest->digestsize );
+	digest_final ( digest, hctx->octx, hmac );
 }
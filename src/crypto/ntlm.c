@@ -117,7 +117,7 @@ void ntlm_key ( const char *domain, const char *username,
 	struct digest_algorithm *md5 = &md5_algorithm;
 	union {
 		uint8_t md4[MD4_CTX_SIZE];
-		uint8_t md5[ MD5_CTX_SIZE + MD5_BLOCK_SIZE ];
+		uint8_t md5[ 2 * MD5_CTX_SIZE ];
 	} ctx;
 	uint8_t digest[MD4_DIGEST_SIZE];
 	uint8_t c;
@@ -168,7 +168,7 @@ void ntlm_response ( struct ntlm_challenge_info *info, struct ntlm_key *key,
 		     struct ntlm_nt_response *nt ) {
 	struct digest_algorithm *md5 = &md5_algorithm;
 	struct ntlm_nonce tmp_nonce;
-	uint8_t ctx[ MD5_CTX_SIZE + MD5_BLOCK_SIZE ];
+	uint8_t ctx[ 2 * MD5_CTX_SIZE ];
 	unsigned int i;
 
 	/* Generate random nonce, if needed */
@@ -54,7 +54,7 @@ struct sha256_variables {
 } __attribute__ (( packed ));
 
 /** SHA-256 constants */
-static const uint32_t k[SHA256_ROUNDS] = {
+const uint32_t sha256_k[SHA256_ROUNDS] __attribute__ (( aligned ( 16 ) )) = {
 	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
 	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
 	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
@@ -111,6 +111,31 @@ static void sha256_init ( void *ctx ) {
 			     sizeof ( struct sha256_digest ) );
 }
 
+/**
+ * Check for hardware-accelerated SHA-256 support
+ *
+ * @ret supported	Hardware-accelerated SHA-256 is supported
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak int sha256_accel_supported ( void ) {
+	return 0;
+}
+
+/**
+ * Digest one data block using hardware acceleration
+ *
+ * @v digest		Digest to update
+ * @v data		Data block
+ *
+ * This is a weak definition, which may be overridden by an
+ * architecture-specific accelerated implementation.
+ */
+__weak void sha256_accel_digest ( struct sha256_digest *digest __unused,
+				  const union sha256_block *data __unused ) {
+}
+
 /**
  * Calculate SHA-256 digest of accumulated data
  *
@@ -150,6 +175,13 @@ static void sha256_digest ( struct sha256_context *context ) {
 	build_assert ( &u.ddd.dd.digest.h[7] == h );
 	build_assert ( &u.ddd.dd.data.dword[0] == w );
 
+	/* Use hardware acceleration, if applicable */
+	if ( sha256_accel_supported() ) {
+		sha256_accel_digest ( &context->ddd.dd.digest,
+				      &context->ddd.dd.data );
+		return;
+	}
+
 	DBGC ( context, "SHA256 digesting:\n" );
 	DBGC_HDA ( context, 0, &context->ddd.dd.digest,
 		   sizeof ( context->ddd.dd.digest ) );
@@ -181,7 +213,7 @@ static void sha256_digest ( struct sha256_context *context ) {
 		t2 = ( s0 + maj );
 		s1 = ( ror32 ( *e, 6 ) ^ ror32 ( *e, 11 ) ^ ror32 ( *e, 25 ) );
 		ch = ( ( *e & *f ) ^ ( (~*e) & *g ) );
-		t1 = ( *h + s1 + ch + k[i] + w[i] );
+		t1 = ( *h + s1 + ch + sha256_k[i] + w[i] );
 		*h = *g;
 		*g = *f;
 		*f = *e;
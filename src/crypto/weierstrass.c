@@ -766,6 +766,14 @@ static int weierstrass_verify_raw ( const struct weierstrass_curve *curve,
  * @v scalar		Scalar multiple
  * @v result		Result point to fill in
  * @ret rc		Return status code
+ *
+ * Fixed-base multiplications (i.e. ephemeral key generation) could in
+ * principle be accelerated using precomputed comb tables of generator
+ * multiples.  The scalar is secret, so table entries would have to be
+ * selected via constant-time scans of the whole table, and each curve
+ * would need several kilobytes of precomputed points.  We prefer to
+ * keep a single constant-time code path and minimal per-curve data,
+ * and so use the generic ladder for all multiplications.
  */
 int weierstrass_multiply ( struct weierstrass_curve *curve, const void *base,
 			   const void *scalar, void *result ) {
@@ -1357,8 +1357,9 @@ void x509_set_valid ( struct x509_certificate *cert,
  * The issuing certificate must have already been validated.
  *
  * Validation results are cached: if a certificate has already been
- * successfully validated then @c issuer, @c time, and @c root will be
- * ignored.
+ * successfully validated then @c issuer and @c root will be ignored.
+ * The validity period is always rechecked, so that a cached result
+ * cannot outlive the certificate's own expiry.
  */
 int x509_validate ( struct x509_certificate *cert,
 		    struct x509_certificate *issuer,
@@ -1369,9 +1370,18 @@ int x509_validate ( struct x509_certificate *cert,
 	if ( ! root )
 		root = &root_certificates;
 
-	/* Return success if certificate has already been validated */
-	if ( x509_is_valid ( cert, root ) )
-		return 0;
+	/* Return success if certificate has already been validated,
+	 * is still within its validity period, and any cached OCSP
+	 * status is still fresh; otherwise discard the stale cached
+	 * validation and revalidate from scratch.
+	 */
+	if ( x509_is_valid ( cert, root ) ) {
+		if ( ( x509_check_time ( cert, time ) == 0 ) &&
+		     ( ! ocsp_stale ( cert, time ) ) )
+			return 0;
+		ocsp_invalidate ( cert );
+		x509_invalidate ( cert );
+	}
 
 	/* Fail if certificate is invalid at specified time */
 	if ( ( rc = x509_check_time ( cert, time ) ) != 0 )
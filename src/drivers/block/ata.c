@@ -401,6 +401,9 @@ static void atacmd_identify_done ( struct ata_command *atacmd, int rc ) {
 	       ( ( signed long ) ( capacity.blocks >> 11 ) ),
 	       ( atadev->lba48 ? "LBA48" : "LBA" ) );
 
+	/* Allow transport layer to update capacity */
+	block_capacity ( &atadev->ata, &capacity );
+
 	/* Return capacity to caller */
 	block_capacity ( &atacmd->block, &capacity );
 
@@ -0,0 +1,1083 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <byteswap.h>
+#include <ipxe/io.h>
+#include <ipxe/pci.h>
+#include <ipxe/dma.h>
+#include <ipxe/timer.h>
+#include <ipxe/blockdev.h>
+#include <ipxe/xfer.h>
+#include <ipxe/uri.h>
+#include <ipxe/open.h>
+#include <ipxe/nvme.h>
+
+/** @file
+ *
+ * NVM Express (NVMe) block driver
+ *
+ * This driver provides access to a local NVMe drive as a SAN device,
+ * using a single admin queue pair and a single I/O queue pair.  The
+ * first namespace is exposed as a block device, and may be used via
+ * e.g.
+ *
+ *   sanboot nvme:0
+ *
+ * Interrupts are never enabled: admin command completions are polled
+ * synchronously, and I/O command completions are polled from a
+ * process while a command is in flight.
+ */
+
+/** Maximum time to wait for an admin command to complete (in ms) */
+#define NVME_ADMIN_MAX_WAIT_MS 5000
+
+/** An I/O command is in progress */
+#define NVME_PENDING_IO 0x0001
+
+/** A read capacity command is in progress */
+#define NVME_PENDING_CAPACITY 0x0002
+
+/** List of NVMe controllers */
+static LIST_HEAD ( nvme_ctrls );
+
+/** Next controller index */
+static unsigned int nvme_index;
+
+/******************************************************************************
+ *
+ * Register access
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Read 64-bit register
+ *
+ * @v ctrl		NVMe controller
+ * @v offset		Register offset
+ * @ret value		Register value
+ */
+static uint64_t nvme_readq ( struct nvme_ctrl *ctrl, unsigned int offset ) {
+	uint64_t value;
+
+	/* Read value as two dwords, low dword first */
+	value = readl ( ctrl->regs + offset + 4 );
+	value = ( ( value << 32 ) | readl ( ctrl->regs + offset ) );
+
+	return value;
+}
+
+/**
+ * Write 64-bit register
+ *
+ * @v ctrl		NVMe controller
+ * @v value		Register value
+ * @v offset		Register offset
+ */
+static void nvme_writeq ( struct nvme_ctrl *ctrl, uint64_t value,
+			  unsigned int offset ) {
+
+	/* Write value as two dwords, low dword first */
+	writel ( ( value >> 0 ), ( ctrl->regs + offset ) );
+	writel ( ( value >> 32 ), ( ctrl->regs + offset + 4 ) );
+}
+
+/**
+ * Wait for controller readiness to reach expected state
+ *
+ * @v ctrl		NVMe controller
+ * @v ready		Expected readiness state
+ * @ret rc		Return status code
+ */
+static int nvme_ready ( struct nvme_ctrl *ctrl, uint32_t ready ) {
+	uint32_t csts;
+	unsigned int i;
+
+	/* Wait for CSTS.RDY to reach the expected state */
+	for ( i = 0 ; i < ctrl->timeout ; i++ ) {
+		csts = readl ( ctrl->regs + NVME_CSTS );
+		if ( csts & NVME_CSTS_CFS ) {
+			DBGC ( ctrl, "NVME %d fatal controller status\n",
+			       ctrl->index );
+			return -EIO;
+		}
+		if ( ( csts & NVME_CSTS_RDY ) == ready )
+			return 0;
+		mdelay ( 1 );
+	}
+
+	DBGC ( ctrl, "NVME %d timed out waiting for CSTS.RDY=%d\n",
+	       ctrl->index, ( ready ? 1 : 0 ) );
+	return -ETIMEDOUT;
+}
+
+/**
+ * Enable controller
+ *
+ * @v ctrl		NVMe controller
+ * @ret rc		Return status code
+ */
+static int nvme_enable ( struct nvme_ctrl *ctrl ) {
+	uint32_t cc;
+
+	/* Set queue entry sizes, 4kB memory page size, and enable */
+	cc = ( NVME_CC_IOSQES | NVME_CC_IOCQES | NVME_CC_EN );
+	writel ( cc, ctrl->regs + NVME_CC );
+
+	return nvme_ready ( ctrl, NVME_CSTS_RDY );
+}
+
+/**
+ * Disable controller
+ *
+ * @v ctrl		NVMe controller
+ * @ret rc		Return status code
+ */
+static int nvme_disable ( struct nvme_ctrl *ctrl ) {
+	uint32_t cc;
+
+	/* Clear the enable bit */
+	cc = readl ( ctrl->regs + NVME_CC );
+	cc &= ~NVME_CC_EN;
+	writel ( cc, ctrl->regs + NVME_CC );
+
+	return nvme_ready ( ctrl, 0 );
+}
+
+/******************************************************************************
+ *
+ * Queue management
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Allocate queue pair
+ *
+ * @v ctrl		NVMe controller
+ * @v queue		Queue pair
+ * @v qid		Queue identifier
+ * @v count		Number of entries in each queue
+ * @ret rc		Return status code
+ */
+static int nvme_alloc_queue ( struct nvme_ctrl *ctrl,
+			      struct nvme_queue *queue, unsigned int qid,
+			      unsigned int count ) {
+	size_t sqe_len = ( count * sizeof ( queue->sqe[0] ) );
+	size_t cqe_len = ( count * sizeof ( queue->cqe[0] ) );
+	int rc;
+
+	/* Initialise queue state */
+	queue->count = count;
+	queue->sq_tail = 0;
+	queue->cq_head = 0;
+	queue->phase = NVME_STATUS_PHASE;
+
+	/* Calculate doorbell register locations */
+	queue->sq_db = ( ctrl->regs + NVME_DB +
+			 ( ( 2 * qid ) * ctrl->stride ) );
+	queue->cq_db = ( ctrl->regs + NVME_DB +
+			 ( ( ( 2 * qid ) + 1 ) * ctrl->stride ) );
+
+	/* Allocate submission queue */
+	queue->sqe = dma_alloc ( ctrl->dma, &queue->sqe_map, sqe_len,
+				 NVME_PAGE_SIZE );
+	if ( ! queue->sqe ) {
+		rc = -ENOMEM;
+		goto err_sqe;
+	}
+	memset ( queue->sqe, 0, sqe_len );
+
+	/* Allocate completion queue */
+	queue->cqe = dma_alloc ( ctrl->dma, &queue->cqe_map, cqe_len,
+				 NVME_PAGE_SIZE );
+	if ( ! queue->cqe ) {
+		rc = -ENOMEM;
+		goto err_cqe;
+	}
+	memset ( queue->cqe, 0, cqe_len );
+
+	return 0;
+
+	dma_free ( &queue->cqe_map, queue->cqe, cqe_len );
+ err_cqe:
+	dma_free ( &queue->sqe_map, queue->sqe, sqe_len );
+ err_sqe:
+	return rc;
+}
+
+/**
+ * Free queue pair
+ *
+ * @v ctrl		NVMe controller
+ * @v queue		Queue pair
+ */
+static void nvme_free_queue ( struct nvme_ctrl *ctrl __unused,
+			      struct nvme_queue *queue ) {
+
+	dma_free ( &queue->cqe_map, queue->cqe,
+		   ( queue->count * sizeof ( queue->cqe[0] ) ) );
+	dma_free ( &queue->sqe_map, queue->sqe,
+		   ( queue->count * sizeof ( queue->sqe[0] ) ) );
+}
+
+/**
+ * Submit command
+ *
+ * @v ctrl		NVMe controller
+ * @v queue		Queue pair
+ * @v cmd		Command
+ */
+static void nvme_submit ( struct nvme_ctrl *ctrl __unused,
+			  struct nvme_queue *queue,
+			  struct nvme_command *cmd ) {
+
+	/* Copy command into next submission queue entry */
+	cmd->cid = cpu_to_le16 ( queue->cid++ );
+	memcpy ( &queue->sqe[queue->sq_tail], cmd, sizeof ( *cmd ) );
+
+	/* Update tail pointer and ring doorbell */
+	queue->sq_tail = ( ( queue->sq_tail + 1 ) % queue->count );
+	wmb();
+	writel ( queue->sq_tail, queue->sq_db );
+}
+
+/**
+ * Poll for next completion
+ *
+ * @v queue		Queue pair
+ * @ret cqe		Completion queue entry, or NULL if none available
+ */
+static struct nvme_completion * nvme_poll ( struct nvme_queue *queue ) {
+	struct nvme_completion *cqe = &queue->cqe[queue->cq_head];
+
+	/* Check phase tag of next completion queue entry */
+	if ( ( le16_to_cpu ( cqe->status ) & NVME_STATUS_PHASE ) !=
+	     queue->phase )
+		return NULL;
+
+	return cqe;
+}
+
+/**
+ * Consume completion
+ *
+ * @v queue		Queue pair
+ */
+static void nvme_consume ( struct nvme_queue *queue ) {
+
+	/* Update head pointer (and phase, on wraparound) */
+	queue->cq_head++;
+	if ( queue->cq_head == queue->count ) {
+		queue->cq_head = 0;
+		queue->phase ^= NVME_STATUS_PHASE;
+	}
+
+	/* Ring doorbell */
+	writel ( queue->cq_head, queue->cq_db );
+}
+
+/**
+ * Check completion status
+ *
+ * @v ctrl		NVMe controller
+ * @v cqe		Completion queue entry
+ * @ret rc		Return status code
+ */
+static int nvme_status ( struct nvme_ctrl *ctrl,
+			 struct nvme_completion *cqe ) {
+	unsigned int status = NVME_STATUS ( le16_to_cpu ( cqe->status ) );
+
+	/* Report failed commands */
+	if ( status ) {
+		DBGC ( ctrl, "NVME %d command %#04x failed with status "
+		       "%#04x\n", ctrl->index, le16_to_cpu ( cqe->cid ),
+		       status );
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * Issue admin command and wait for completion
+ *
+ * @v ctrl		NVMe controller
+ * @v cmd		Command
+ * @ret rc		Return status code
+ */
+static int nvme_admin ( struct nvme_ctrl *ctrl, struct nvme_command *cmd ) {
+	struct nvme_completion *cqe;
+	unsigned int i;
+	int rc;
+
+	/* Submit command */
+	nvme_submit ( ctrl, &ctrl->admin, cmd );
+
+	/* Poll for completion */
+	for ( i = 0 ; i < NVME_ADMIN_MAX_WAIT_MS ; i++ ) {
+		if ( ( cqe = nvme_poll ( &ctrl->admin ) ) != NULL ) {
+			rc = nvme_status ( ctrl, cqe );
+			nvme_consume ( &ctrl->admin );
+			return rc;
+		}
+		mdelay ( 1 );
+	}
+
+	DBGC ( ctrl, "NVME %d admin command %#02x timed out\n",
+	       ctrl->index, cmd->opcode );
+	return -ETIMEDOUT;
+}
+
+/**
+ * Create I/O queue pair
+ *
+ * @v ctrl		NVMe controller
+ * @ret rc		Return status code
+ */
+static int nvme_create_io ( struct nvme_ctrl *ctrl ) {
+	struct nvme_command cmd;
+	int rc;
+
+	/* Allocate queue pair */
+	if ( ( rc = nvme_alloc_queue ( ctrl, &ctrl->io, NVME_QID_IO,
+				       ctrl->io_count ) ) != 0 )
+		goto err_alloc;
+
+	/* Create completion queue */
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_CREATE_CQ;
+	cmd.prp1 = cpu_to_le64 ( dma ( &ctrl->io.cqe_map, ctrl->io.cqe ) );
+	cmd.cdw10 = cpu_to_le32 ( ( ( ctrl->io_count - 1 ) << 16 ) |
+				  NVME_QID_IO );
+	cmd.cdw11 = cpu_to_le32 ( NVME_QUEUE_PC );
+	if ( ( rc = nvme_admin ( ctrl, &cmd ) ) != 0 ) {
+		DBGC ( ctrl, "NVME %d could not create I/O completion queue: "
+		       "%s\n", ctrl->index, strerror ( rc ) );
+		goto err_create_cq;
+	}
+
+	/* Create submission queue */
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_CREATE_SQ;
+	cmd.prp1 = cpu_to_le64 ( dma ( &ctrl->io.sqe_map, ctrl->io.sqe ) );
+	cmd.cdw10 = cpu_to_le32 ( ( ( ctrl->io_count - 1 ) << 16 ) |
+				  NVME_QID_IO );
+	cmd.cdw11 = cpu_to_le32 ( ( NVME_QID_IO << 16 ) | NVME_QUEUE_PC );
+	if ( ( rc = nvme_admin ( ctrl, &cmd ) ) != 0 ) {
+		DBGC ( ctrl, "NVME %d could not create I/O submission queue: "
+		       "%s\n", ctrl->index, strerror ( rc ) );
+		goto err_create_sq;
+	}
+
+	return 0;
+
+ err_create_sq:
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_DELETE_CQ;
+	cmd.cdw10 = cpu_to_le32 ( NVME_QID_IO );
+	nvme_admin ( ctrl, &cmd );
+ err_create_cq:
+	nvme_free_queue ( ctrl, &ctrl->io );
+ err_alloc:
+	return rc;
+}
+
+/**
+ * Delete I/O queue pair
+ *
+ * @v ctrl		NVMe controller
+ */
+static void nvme_delete_io ( struct nvme_ctrl *ctrl ) {
+	struct nvme_command cmd;
+
+	/* Delete submission queue */
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_DELETE_SQ;
+	cmd.cdw10 = cpu_to_le32 ( NVME_QID_IO );
+	nvme_admin ( ctrl, &cmd );
+
+	/* Delete completion queue */
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_DELETE_CQ;
+	cmd.cdw10 = cpu_to_le32 ( NVME_QID_IO );
+	nvme_admin ( ctrl, &cmd );
+
+	/* Free queue pair */
+	nvme_free_queue ( ctrl, &ctrl->io );
+}
+
+/******************************************************************************
+ *
+ * Namespace identification
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Issue identify command
+ *
+ * @v ctrl		NVMe controller
+ * @v nsid		Namespace identifier (if applicable)
+ * @v cns		Data structure selector
+ * @v data		Data buffer (must be page-sized and page-aligned)
+ * @v map		Data buffer DMA mapping
+ * @ret rc		Return status code
+ */
+static int nvme_identify ( struct nvme_ctrl *ctrl, uint32_t nsid,
+			   unsigned int cns, void *data,
+			   struct dma_mapping *map ) {
+	struct nvme_command cmd;
+
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = NVME_ADMIN_IDENTIFY;
+	cmd.nsid = cpu_to_le32 ( nsid );
+	cmd.prp1 = cpu_to_le64 ( dma ( map, data ) );
+	cmd.cdw10 = cpu_to_le32 ( cns );
+	return nvme_admin ( ctrl, &cmd );
+}
+
+/**
+ * Identify controller and first namespace
+ *
+ * @v ctrl		NVMe controller
+ * @ret rc		Return status code
+ */
+static int nvme_describe ( struct nvme_ctrl *ctrl ) {
+	union {
+		struct nvme_identity_ctrl ctrl;
+		struct nvme_identity_ns ns;
+	} *id;
+	struct dma_mapping map;
+	size_t max_len;
+	unsigned int format;
+	unsigned int lbads;
+	uint8_t mdts;
+	uint32_t lbaf;
+	int rc;
+
+	/* Allocate identify data buffer */
+	id = dma_alloc ( ctrl->dma, &map, sizeof ( *id ), NVME_PAGE_SIZE );
+	if ( ! id ) {
+		rc = -ENOMEM;
+		goto err_alloc;
+	}
+
+	/* Identify controller */
+	if ( ( rc = nvme_identify ( ctrl, 0, NVME_IDENTIFY_CTRL, id,
+				    &map ) ) != 0 ) {
+		DBGC ( ctrl, "NVME %d could not identify controller: %s\n",
+		       ctrl->index, strerror ( rc ) );
+		goto err_identify_ctrl;
+	}
+	DBGC ( ctrl, "NVME %d is \"%.40s\" (%.20s) with %d namespaces\n",
+	       ctrl->index, id->ctrl.mn, id->ctrl.sn,
+	       le32_to_cpu ( id->ctrl.nn ) );
+	mdts = id->ctrl.mdts;
+	if ( ! le32_to_cpu ( id->ctrl.nn ) ) {
+		rc = -ENODEV;
+		goto err_no_namespaces;
+	}
+
+	/* Identify first namespace
+	 *
+	 * Namespace identifiers need not be contiguous; we assume
+	 * (as does essentially all boot firmware) that the first
+	 * namespace is namespace 1.
+	 */
+	ctrl->nsid = 1;
+	if ( ( rc = nvme_identify ( ctrl, ctrl->nsid, NVME_IDENTIFY_NS, id,
+				    &map ) ) != 0 ) {
+		DBGC ( ctrl, "NVME %d could not identify namespace %d: %s\n",
+		       ctrl->index, ctrl->nsid, strerror ( rc ) );
+		goto err_identify_ns;
+	}
+
+	/* Record block size and capacity */
+	format = NVME_FLBAS_FORMAT ( id->ns.flbas );
+	lbaf = le32_to_cpu ( id->ns.lbaf[format] );
+	lbads = NVME_LBAF_LBADS ( lbaf );
+	ctrl->blksize = ( 1UL << lbads );
+	ctrl->blocks = le64_to_cpu ( id->ns.nsze );
+
+	/* Calculate maximum transfer length.  We use a single PRP
+	 * list page, allowing for transfers of up to 2MB; clamp this
+	 * to the controller's advertised limit (if any) and to the
+	 * 16-bit block count field in the I/O commands.
+	 */
+	max_len = ( NVME_PRP_COUNT * NVME_PAGE_SIZE );
+	if ( mdts && ( mdts < 32 ) &&
+	     ( ( 1ULL << ( ctrl->mps + mdts ) ) < max_len ) ) {
+		max_len = ( 1ULL << ( ctrl->mps + mdts ) );
+	}
+	ctrl->max_count = ( max_len / ctrl->blksize );
+	if ( ctrl->max_count > 0x10000 )
+		ctrl->max_count = 0x10000;
+
+	DBGC ( ctrl, "NVME %d namespace %d has %lld blocks of %zd bytes\n",
+	       ctrl->index, ctrl->nsid,
+	       ( ( unsigned long long ) ctrl->blocks ), ctrl->blksize );
+
+	/* Free identify data buffer */
+	dma_free ( &map, id, sizeof ( *id ) );
+
+	return 0;
+
+ err_identify_ns:
+ err_no_namespaces:
+ err_identify_ctrl:
+	dma_free ( &map, id, sizeof ( *id ) );
+ err_alloc:
+	return rc;
+}
+
+/******************************************************************************
+ *
+ * I/O command management
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Populate physical region page entries
+ *
+ * @v ctrl		NVMe controller
+ * @v cmd		Command
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvme_prp ( struct nvme_ctrl *ctrl, struct nvme_command *cmd,
+		      void *buffer, size_t len ) {
+	physaddr_t addr = dma ( &ctrl->map, buffer );
+	size_t first = ( NVME_PAGE_SIZE - ( addr & ( NVME_PAGE_SIZE - 1 ) ) );
+	unsigned int pages;
+	unsigned int i;
+
+	/* Populate first entry */
+	cmd->prp1 = cpu_to_le64 ( addr );
+	if ( len <= first )
+		return 0;
+	addr += first;
+	len -= first;
+
+	/* Use second entry directly for two-page transfers */
+	pages = ( ( len + NVME_PAGE_SIZE - 1 ) / NVME_PAGE_SIZE );
+	if ( pages == 1 ) {
+		cmd->prp2 = cpu_to_le64 ( addr );
+		return 0;
+	}
+
+	/* Use a single PRP list page for larger transfers */
+	if ( pages > NVME_PRP_COUNT )
+		return -ERANGE;
+	for ( i = 0 ; i < pages ; i++ ) {
+		ctrl->prp[i] =
+			cpu_to_le64 ( addr + ( i * NVME_PAGE_SIZE ) );
+	}
+	cmd->prp2 = cpu_to_le64 ( dma ( &ctrl->prp_map, ctrl->prp ) );
+
+	return 0;
+}
+
+/**
+ * Stop current command
+ *
+ * @v ctrl		NVMe controller
+ * @v rc		Reason for stop
+ */
+static void nvme_stop ( struct nvme_ctrl *ctrl, int rc ) {
+
+	/* Stop polling process */
+	process_del ( &ctrl->process );
+
+	/* Abort any in-flight I/O command.  There is no lightweight
+	 * way to do this: the only mechanism that guarantees the
+	 * controller will no longer write to the (possibly about to
+	 * be freed) data buffer is to delete and recreate the I/O
+	 * queue pair.
+	 */
+	if ( ctrl->pending & NVME_PENDING_IO ) {
+		DBGC ( ctrl, "NVME %d aborting I/O command: %s\n",
+		       ctrl->index, strerror ( rc ) );
+		nvme_delete_io ( ctrl );
+		nvme_create_io ( ctrl );
+		dma_unmap ( &ctrl->map );
+	}
+	ctrl->pending = 0;
+
+	/* Terminate command */
+	intf_restart ( &ctrl->data, rc );
+}
+
+/**
+ * Poll for command completion
+ *
+ * @v ctrl		NVMe controller
+ */
+static void nvme_step ( struct nvme_ctrl *ctrl ) {
+	struct block_device_capacity capacity;
+	struct nvme_completion *cqe;
+	int rc;
+
+	/* Report capacity, if requested.  This is deferred to the
+	 * process (rather than being reported within the method call
+	 * itself) since the caller does not expect a synchronous
+	 * completion.
+	 */
+	if ( ctrl->pending & NVME_PENDING_CAPACITY ) {
+		capacity.blocks = ctrl->blocks;
+		capacity.blksize = ctrl->blksize;
+		capacity.max_count = ctrl->max_count;
+		ctrl->pending = 0;
+		process_del ( &ctrl->process );
+		block_capacity ( &ctrl->data, &capacity );
+		intf_restart ( &ctrl->data, 0 );
+		return;
+	}
+
+	/* Poll for I/O command completion */
+	if ( ( cqe = nvme_poll ( &ctrl->io ) ) == NULL )
+		return;
+	rc = nvme_status ( ctrl, cqe );
+	nvme_consume ( &ctrl->io );
+
+	/* Complete command */
+	dma_unmap ( &ctrl->map );
+	ctrl->pending = 0;
+	process_del ( &ctrl->process );
+	intf_restart ( &ctrl->data, rc );
+}
+
+/** Polling process descriptor */
+static struct process_descriptor nvme_process_desc =
+	PROC_DESC ( struct nvme_ctrl, process, nvme_step );
+
+/** Data interface operations */
+static struct interface_operation nvme_data_operations[] = {
+	INTF_OP ( intf_close, struct nvme_ctrl *, nvme_stop ),
+};
+
+/** Data interface descriptor */
+static struct interface_descriptor nvme_data_desc =
+	INTF_DESC ( struct nvme_ctrl, data, nvme_data_operations );
+
+/******************************************************************************
+ *
+ * Block device interface
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Issue block read/write command
+ *
+ * @v ctrl		NVMe controller
+ * @v data		Data interface
+ * @v opcode		I/O command opcode
+ * @v flags		DMA mapping flags
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvme_block_rw ( struct nvme_ctrl *ctrl, struct interface *data,
+			   unsigned int opcode, int flags, uint64_t lba,
+			   unsigned int count, void *buffer, size_t len ) {
+	struct nvme_command cmd;
+	int rc;
+
+	/* Fail if a command is already in progress */
+	if ( ctrl->pending )
+		return -EBUSY;
+
+	/* Sanity checks */
+	assert ( len == ( count * ctrl->blksize ) );
+	assert ( count <= ctrl->max_count );
+
+	/* Map data buffer */
+	if ( ( rc = dma_map ( ctrl->dma, &ctrl->map,
+			      virt_to_phys ( buffer ), len, flags ) ) != 0 )
+		goto err_map;
+
+	/* Construct and submit command */
+	memset ( &cmd, 0, sizeof ( cmd ) );
+	cmd.opcode = opcode;
+	cmd.nsid = cpu_to_le32 ( ctrl->nsid );
+	if ( ( rc = nvme_prp ( ctrl, &cmd, buffer, len ) ) != 0 )
+		goto err_prp;
+	cmd.cdw10 = cpu_to_le32 ( lba >> 0 );
+	cmd.cdw11 = cpu_to_le32 ( lba >> 32 );
+	cmd.cdw12 = cpu_to_le32 ( count - 1 );
+	nvme_submit ( ctrl, &ctrl->io, &cmd );
+
+	/* Record command in progress and start polling */
+	ctrl->pending = NVME_PENDING_IO;
+	intf_plug_plug ( &ctrl->data, data );
+	process_add ( &ctrl->process );
+
+	return 0;
+
+ err_prp:
+	dma_unmap ( &ctrl->map );
+ err_map:
+	return rc;
+}
+
+/**
+ * Issue block read command
+ *
+ * @v ctrl		NVMe controller
+ * @v data		Data interface
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvme_block_read ( struct nvme_ctrl *ctrl, struct interface *data,
+			     uint64_t lba, unsigned int count,
+			     void *buffer, size_t len ) {
+
+	return nvme_block_rw ( ctrl, data, NVME_IO_READ, DMA_RX, lba, count,
+			       buffer, len );
+}
+
+/**
+ * Issue block write command
+ *
+ * @v ctrl		NVMe controller
+ * @v data		Data interface
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvme_block_write ( struct nvme_ctrl *ctrl, struct interface *data,
+			      uint64_t lba, unsigned int count,
+			      void *buffer, size_t len ) {
+
+	return nvme_block_rw ( ctrl, data, NVME_IO_WRITE, DMA_TX, lba, count,
+			       buffer, len );
+}
+
+/**
+ * Read block device capacity
+ *
+ * @v ctrl		NVMe controller
+ * @v data		Data interface
+ * @ret rc		Return status code
+ */
+static int nvme_block_read_capacity ( struct nvme_ctrl *ctrl,
+				      struct interface *data ) {
+
+	/* Fail if a command is already in progress */
+	if ( ctrl->pending )
+		return -EBUSY;
+
+	/* Record command in progress; the capacity (which is already
+	 * known) will be reported by the process.
+	 */
+	ctrl->pending = NVME_PENDING_CAPACITY;
+	intf_plug_plug ( &ctrl->data, data );
+	process_add ( &ctrl->process );
+
+	return 0;
+}
+
+/**
+ * Check block device flow-control window
+ *
+ * @v ctrl		NVMe controller
+ * @ret len		Length of window
+ */
+static size_t nvme_block_window ( struct nvme_ctrl *ctrl ) {
+
+	/* Allow a single command if no command is currently in progress */
+	return ( ctrl->pending ? 0 : 1 );
+}
+
+/**
+ * Close block device interface
+ *
+ * @v ctrl		NVMe controller
+ * @v rc		Reason for close
+ */
+static void nvme_block_close ( struct nvme_ctrl *ctrl, int rc ) {
+
+	/* Restart interfaces */
+	intfs_restart ( rc, &ctrl->block, &ctrl->data, NULL );
+
+	/* Stop any in-progress command */
+	nvme_stop ( ctrl, rc );
+
+	/* Flag as closed */
+	ctrl->opened = 0;
+}
+
+/** Block interface operations */
+static struct interface_operation nvme_block_operations[] = {
+	INTF_OP ( block_read, struct nvme_ctrl *, nvme_block_read ),
+	INTF_OP ( block_write, struct nvme_ctrl *, nvme_block_write ),
+	INTF_OP ( block_read_capacity, struct nvme_ctrl *,
+		  nvme_block_read_capacity ),
+	INTF_OP ( xfer_window, struct nvme_ctrl *, nvme_block_window ),
+	INTF_OP ( intf_close, struct nvme_ctrl *, nvme_block_close ),
+};
+
+/** Block interface descriptor */
+static struct interface_descriptor nvme_block_desc =
+	INTF_DESC ( struct nvme_ctrl, block, nvme_block_operations );
+
+/******************************************************************************
+ *
+ * SAN device interface
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Open NVMe URI
+ *
+ * @v parent		Parent interface
+ * @v uri		URI
+ * @ret rc		Return status code
+ */
+static int nvme_open_uri ( struct interface *parent, struct uri *uri ) {
+	struct nvme_ctrl *ctrl;
+	unsigned long index;
+	char *end;
+
+	/* Parse controller index */
+	if ( ! uri->opaque )
+		return -EINVAL;
+	index = strtoul ( uri->opaque, &end, 10 );
+	if ( *end )
+		return -EINVAL;
+
+	/* Find matching controller */
+	list_for_each_entry ( ctrl, &nvme_ctrls, list ) {
+		if ( ctrl->index == index )
+			goto found;
+	}
+	return -ENOENT;
+
+ found:
+	/* Fail if device is already open */
+	if ( ctrl->opened )
+		return -EBUSY;
+
+	/* Attach to parent interface */
+	intf_plug_plug ( &ctrl->block, parent );
+
+	/* Mark as opened */
+	ctrl->opened = 1;
+
+	return 0;
+}
+
+/** NVMe URI opener */
+struct uri_opener nvme_uri_opener __uri_opener = {
+	.scheme = "nvme",
+	.open = nvme_open_uri,
+};
+
+/******************************************************************************
+ *
+ * PCI interface
+ *
+ ******************************************************************************
+ */
+
+/**
+ * Probe PCI device
+ *
+ * @v pci		PCI device
+ * @ret rc		Return status code
+ */
+static int nvme_probe ( struct pci_device *pci ) {
+	struct nvme_ctrl *ctrl;
+	unsigned long bar_start;
+	size_t bar_size;
+	uint64_t cap;
+	uint32_t aqa;
+	int rc;
+
+	/* Allocate and initialise structure */
+	ctrl = zalloc ( sizeof ( *ctrl ) );
+	if ( ! ctrl ) {
+		rc = -ENOMEM;
+		goto err_alloc;
+	}
+	ref_init ( &ctrl->refcnt, NULL );
+	intf_init ( &ctrl->block, &nvme_block_desc, &ctrl->refcnt );
+	intf_init ( &ctrl->data, &nvme_data_desc, &ctrl->refcnt );
+	process_init_stopped ( &ctrl->process, &nvme_process_desc,
+			       &ctrl->refcnt );
+	ctrl->index = nvme_index;
+
+	/* Fix up PCI device */
+	adjust_pci_device ( pci );
+
+	/* Map registers */
+	bar_start = pci_bar_start ( pci, PCI_BASE_ADDRESS_0 );
+	bar_size = pci_bar_size ( pci, PCI_BASE_ADDRESS_0 );
+	ctrl->regs = pci_ioremap ( pci, bar_start, bar_size );
+	if ( ! ctrl->regs ) {
+		rc = -ENODEV;
+		goto err_ioremap;
+	}
+
+	/* Configure DMA */
+	ctrl->dma = &pci->dma;
+	dma_set_mask_64bit ( ctrl->dma );
+
+	/* Read controller capabilities */
+	cap = nvme_readq ( ctrl, NVME_CAP );
+	ctrl->stride = ( 4 << NVME_CAP_DSTRD ( cap ) );
+	ctrl->timeout = ( ( NVME_CAP_TO ( cap ) + 1 ) * 500 );
+	ctrl->mps = ( 12 + NVME_CAP_MPSMIN ( cap ) );
+	ctrl->io_count = NVME_IO_COUNT;
+	if ( ctrl->io_count > ( NVME_CAP_MQES ( cap ) + 1 ) )
+		ctrl->io_count = ( NVME_CAP_MQES ( cap ) + 1 );
+	if ( ( NVME_DB + ( 4 * ctrl->stride ) ) > bar_size ) {
+		DBGC ( ctrl, "NVME %d has unsupported doorbell stride\n",
+		       ctrl->index );
+		rc = -ENOTSUP;
+		goto err_stride;
+	}
+
+	/* Reset controller */
+	if ( ( rc = nvme_disable ( ctrl ) ) != 0 )
+		goto err_disable;
+
+	/* Configure admin queue pair */
+	if ( ( rc = nvme_alloc_queue ( ctrl, &ctrl->admin, NVME_QID_ADMIN,
+				       NVME_ADMIN_COUNT ) ) != 0 )
+		goto err_admin;
+	aqa = ( ( ( NVME_ADMIN_COUNT - 1 ) << 16 ) |
+		( NVME_ADMIN_COUNT - 1 ) );
+	writel ( aqa, ctrl->regs + NVME_AQA );
+	nvme_writeq ( ctrl, dma ( &ctrl->admin.sqe_map, ctrl->admin.sqe ),
+		      NVME_ASQ );
+	nvme_writeq ( ctrl, dma ( &ctrl->admin.cqe_map, ctrl->admin.cqe ),
+		      NVME_ACQ );
+
+	/* Enable controller */
+	if ( ( rc = nvme_enable ( ctrl ) ) != 0 )
+		goto err_enable;
+
+	/* Identify controller and namespace */
+	if ( ( rc = nvme_describe ( ctrl ) ) != 0 )
+		goto err_describe;
+
+	/* Allocate PRP list page */
+	ctrl->prp = dma_alloc ( ctrl->dma, &ctrl->prp_map, NVME_PAGE_SIZE,
+				NVME_PAGE_SIZE );
+	if ( ! ctrl->prp ) {
+		rc = -ENOMEM;
+		goto err_prp;
+	}
+
+	/* Create I/O queue pair */
+	if ( ( rc = nvme_create_io ( ctrl ) ) != 0 )
+		goto err_create_io;
+
+	/* Add to list of controllers */
+	nvme_index++;
+	list_add_tail ( &ctrl->list, &nvme_ctrls );
+	DBGC ( ctrl, "NVME %d registered as \"nvme:%d\"\n",
+	       ctrl->index, ctrl->index );
+
+	pci_set_drvdata ( pci, ctrl );
+	return 0;
+
+	nvme_delete_io ( ctrl );
+ err_create_io:
+	dma_free ( &ctrl->prp_map, ctrl->prp, NVME_PAGE_SIZE );
+ err_prp:
+ err_describe:
+	nvme_disable ( ctrl );
+ err_enable:
+	nvme_free_queue ( ctrl, &ctrl->admin );
+ err_admin:
+ err_disable:
+ err_stride:
+	iounmap ( ctrl->regs );
+ err_ioremap:
+	ref_put ( &ctrl->refcnt );
+ err_alloc:
+	return rc;
+}
+
+/**
+ * Remove PCI device
+ *
+ * @v pci		PCI device
+ */
+static void nvme_remove ( struct pci_device *pci ) {
+	struct nvme_ctrl *ctrl = pci_get_drvdata ( pci );
+
+	/* Remove from list of controllers */
+	list_del ( &ctrl->list );
+
+	/* Close all interfaces */
+	nvme_block_close ( ctrl, -ENODEV );
+
+	/* Shut down interfaces */
+	intfs_shutdown ( -ENODEV, &ctrl->block, &ctrl->data, NULL );
+
+	/* Delete I/O queue pair and disable controller */
+	nvme_delete_io ( ctrl );
+	nvme_disable ( ctrl );
+
+	/* Free resources */
+	dma_free ( &ctrl->prp_map, ctrl->prp, NVME_PAGE_SIZE );
+	nvme_free_queue ( ctrl, &ctrl->admin );
+	iounmap ( ctrl->regs );
+	ref_put ( &ctrl->refcnt );
+}
+
+/** NVMe PCI device IDs */
+static struct pci_device_id nvme_ids[] = {
+	PCI_ROM ( 0xffff, 0xffff, "nvme", "NVMe", 0 ),
+};
+
+/** NVMe PCI driver */
+struct pci_driver nvme_driver __pci_driver = {
+	.ids = nvme_ids,
+	.id_count = ( sizeof ( nvme_ids ) / sizeof ( nvme_ids[0] ) ),
+	.class = PCI_CLASS_ID ( PCI_CLASS_STORAGE, PCI_CLASS_STORAGE_NVME,
+				PCI_CLASS_STORAGE_NVME_NVME ),
+	.probe = nvme_probe,
+	.remove = nvme_remove,
+};
@@ -246,7 +246,14 @@ struct scsi_device {
 	/** TEST UNIT READY retry count */
 	unsigned int retries;
 
-	/** List of commands */
+	/** List of commands
+	 *
+	 * Commands are tagged and tracked individually, and each has
+	 * its own data interface, so any number may be outstanding
+	 * concurrently (up to whatever depth the transport's
+	 * flow-control window permits) and may complete in any order.
+	 * The block front-end above us chooses the actual depth.
+	 */
 	struct list_head cmds;
 };
 
@@ -43,6 +43,14 @@ FILE_LICENCE ( BSD2 );
  *
  * SCSI RDMA Protocol
  *
+ * We place no limit of our own on command concurrency or transfer
+ * size: the flow-control window is left open, commands are tracked by
+ * tag and may complete out of order, and each data buffer is
+ * described by a single direct RDMA descriptor covering the whole
+ * (contiguous) buffer.  The effective queue depth is therefore
+ * determined by the caller; the SAN device layer currently issues one
+ * command at a time, relying on large single-command transfers to
+ * approach link rate.
  */
 
 FEATURE ( FEATURE_PROTOCOL, "SRP", DHCP_EB_FEATURE_SRP, 1 );
@@ -1864,6 +1864,16 @@ void usb_port_changed ( struct usb_port *port ) {
 /**
  * Handle newly attached or detached USB device
  *
+ * Ports are deliberately enumerated one at a time.  Enumeration
+ * cannot usefully be parallelised across devices: each new device
+ * must be reset and assigned its address while it is responding on
+ * the shared default address zero, so the reset, SET ADDRESS, and
+ * associated mandatory recovery delays (which dominate enumeration
+ * time) are serialised per bus by the USB specification itself.
+ * Only the post-addressing descriptor fetches could overlap, and
+ * those are short control transfers that would not repay converting
+ * the entire synchronous enumeration path (including every hub and
+ * class driver above it) into a per-device state machine.
  */
 static void usb_hotplug ( void ) {
 	struct usb_port *port;
@@ -1873,6 +1873,7 @@ static void hermon_poll_cq ( struct ib_device *ibdev,
 	struct hermon_completion_queue *hermon_cq = ib_cq_get_drvdata ( cq );
 	union hermonprm_completion_entry *cqe;
 	unsigned int cqe_idx_mask;
+	unsigned int polled = 0;
 	int rc;
 
 	while ( 1 ) {
@@ -1895,8 +1896,15 @@ static void hermon_poll_cq ( struct ib_device *ibdev,
 
 		/* Update completion queue's index */
 		cq->next_idx++;
+		polled++;
+	}
 
-		/* Update doorbell record */
+	/* Update doorbell record once for the entire batch of
+	 * completions.  (This is a DMA doorbell record in host
+	 * memory, not an MMIO doorbell; updating it is cheap, but
+	 * there is still no need to rewrite it per entry.)
+	 */
+	if ( polled ) {
 		MLX_FILL_1 ( hermon_cq->doorbell, 0, update_ci,
 			     ( cq->next_idx & 0x00ffffffUL ) );
 	}
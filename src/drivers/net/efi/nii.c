@@ -196,8 +196,15 @@ struct nii_nic {
 	struct list_head mappings;
 };
 
-/** Maximum number of received packets per poll */
-#define NII_RX_QUOTA 4
+/** Maximum number of received packets per poll
+ *
+ * Each received frame unavoidably costs one UNDI command block: the
+ * UNDI specification provides no multi-frame receive operation, and
+ * PXE_OPCODE_RECEIVE fills exactly one caller-supplied buffer per
+ * invocation.  Draining more frames per poll at least amortises the
+ * per-poll PXE_OPCODE_GET_STATUS command over a larger batch.
+ */
+#define NII_RX_QUOTA 8
 
 /**
  * Open PCI I/O protocol and identify BARs
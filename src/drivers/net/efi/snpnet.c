@@ -64,8 +64,19 @@ struct snp_nic {
 	struct io_buffer *rxbuf;
 };
 
-/** Maximum number of received packets per poll */
-#define SNP_RX_QUOTA 4
+/** Maximum number of received packets per poll
+ *
+ * Vendor SNP implementations often buffer a substantial number of
+ * frames internally; draining more of them per poll amortises the
+ * fixed per-poll costs (GetStatus() and the link check) over more
+ * packets.  Note that the receive loop already avoids any per-frame
+ * GetStatus() round trip: Receive() itself returns EFI_NOT_READY
+ * when no further frames are pending.  The single GetStatus() call
+ * per poll cannot be elided even when no transmission is in flight,
+ * since the UEFI specification guarantees that the MediaPresent
+ * field is refreshed only as a side effect of GetStatus().
+ */
+#define SNP_RX_QUOTA 8
 
 /** Maximum initialisation retry count */
 #define SNP_INITIALIZE_RETRY_MAX 10
@@ -45,6 +45,15 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/* Sanity checks on ring sizes: completion queue indexing relies on
+ * power-of-two sizes, and the queue size fields are 8-bit.
+ */
+static_assert ( ( ENA_TX_COUNT & ( ENA_TX_COUNT - 1 ) ) == 0 );
+static_assert ( ( ENA_RX_COUNT & ( ENA_RX_COUNT - 1 ) ) == 0 );
+static_assert ( ENA_TX_COUNT <= 128 );
+static_assert ( ENA_RX_COUNT <= 128 );
+static_assert ( ENA_RX_FILL <= ENA_RX_COUNT );
+
 /**
  * Get direction name (for debugging)
  *
@@ -27,14 +27,31 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Number of async event notification queue entries */
 #define ENA_AENQ_COUNT 2
 
-/** Number of transmit queue entries */
-#define ENA_TX_COUNT 16
+/** Number of transmit queue entries
+ *
+ * This is a policy decision.  The queue size fields are 8-bit, so
+ * values above 128 cannot be represented.
+ */
+#ifndef ENA_TX_COUNT
+#define ENA_TX_COUNT 64
+#endif
 
-/** Number of receive queue entries */
+/** Number of receive queue entries
+ *
+ * This is a policy decision.  The queue size fields are 8-bit, so
+ * values above 128 cannot be represented.
+ */
+#ifndef ENA_RX_COUNT
 #define ENA_RX_COUNT 128
+#endif
 
-/** Receive queue maximum fill level */
+/** Receive queue maximum fill level
+ *
+ * This is a policy decision.
+ */
+#ifndef ENA_RX_FILL
 #define ENA_RX_FILL 16
+#endif
 
 /** Base address low register offset */
 #define ENA_BASE_LO 0x0
@@ -43,6 +43,13 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/* Sanity checks on (potentially overridden) descriptor ring sizes */
+static_assert ( ( INTEL_NUM_RX_DESC & ( INTEL_NUM_RX_DESC - 1 ) ) == 0 );
+static_assert ( ( INTEL_NUM_TX_DESC & ( INTEL_NUM_TX_DESC - 1 ) ) == 0 );
+static_assert ( INTEL_NUM_RX_DESC >= 8 );
+static_assert ( INTEL_NUM_TX_DESC >= 16 );
+static_assert ( INTEL_RX_FILL <= INTEL_NUM_RX_DESC );
+
 /** VM transmit profiler */
 static struct profiler intel_vm_tx_profiler __profiler =
 	{ .name = "intel.vm_tx" };
@@ -588,7 +595,7 @@ void intel_refill_rx ( struct intel_nic *intel ) {
 	while ( ( intel->rx.prod - intel->rx.cons ) < INTEL_RX_FILL ) {
 
 		/* Allocate I/O buffer */
-		iobuf = alloc_rx_iob ( INTEL_RX_MAX_LEN, intel->dma );
+		iobuf = alloc_rx_iob ( intel->rx_len, intel->dma );
 		if ( ! iobuf ) {
 			/* Wait for next refill */
 			break;
@@ -607,7 +614,7 @@ void intel_refill_rx ( struct intel_nic *intel ) {
 
 		DBGC2 ( intel, "INTEL %p RX %d is [%lx,%lx)\n",
 			intel, rx_idx, virt_to_phys ( iobuf->data ),
-			( virt_to_phys ( iobuf->data ) + INTEL_RX_MAX_LEN ) );
+			( virt_to_phys ( iobuf->data ) + intel->rx_len ) );
 		refilled++;
 	}
 
@@ -647,11 +654,30 @@ void intel_empty_rx ( struct intel_nic *intel ) {
 static int intel_open ( struct net_device *netdev ) {
 	struct intel_nic *intel = netdev->priv;
 	union intel_receive_address mac;
+	size_t max_frame;
 	uint32_t fextnvm11;
 	uint32_t tctl;
 	uint32_t rctl;
+	uint32_t bsize;
+	uint32_t rxcsum;
 	int rc;
 
+	/* Determine receive buffer length to suit the configured MTU */
+	max_frame = ( ETH_HLEN + netdev->mtu + 4 /* VLAN */ );
+	if ( max_frame <= 2048 ) {
+		intel->rx_len = 2048;
+		bsize = INTEL_RCTL_BSIZE_2048;
+	} else if ( max_frame <= 4096 ) {
+		intel->rx_len = 4096;
+		bsize = INTEL_RCTL_BSIZE_4096;
+	} else if ( max_frame <= 8192 ) {
+		intel->rx_len = 8192;
+		bsize = INTEL_RCTL_BSIZE_8192;
+	} else {
+		intel->rx_len = 16384;
+		bsize = INTEL_RCTL_BSIZE_16384;
+	}
+
 	/* Set undocumented bit in FEXTNVM11 to work around an errata
 	 * in i219 devices that will otherwise cause a complete
 	 * datapath hang at the next device reset.
@@ -686,13 +712,20 @@ static int intel_open ( struct net_device *netdev ) {
 		  INTEL_TCTL_COLD_DEFAULT );
 	writel ( tctl, intel->regs + INTEL_TCTL );
 
-	/* Enable receiver */
+	/* Enable receiver, allowing for long packets if applicable */
 	rctl = readl ( intel->regs + INTEL_RCTL );
-	rctl &= ~( INTEL_RCTL_BSIZE_BSEX_MASK );
+	rctl &= ~( INTEL_RCTL_BSIZE_BSEX_MASK | INTEL_RCTL_LPE );
 	rctl |= ( INTEL_RCTL_EN | INTEL_RCTL_UPE | INTEL_RCTL_MPE |
-		  INTEL_RCTL_BAM | INTEL_RCTL_BSIZE_2048 | INTEL_RCTL_SECRC );
+		  INTEL_RCTL_BAM | bsize | INTEL_RCTL_SECRC );
+	if ( netdev->mtu > ETH_MAX_MTU )
+		rctl |= INTEL_RCTL_LPE;
 	writel ( rctl, intel->regs + INTEL_RCTL );
 
+	/* Enable receive TCP/UDP checksum validation */
+	rxcsum = readl ( intel->regs + INTEL_RXCSUM );
+	rxcsum |= INTEL_RXCSUM_TUOFL;
+	writel ( rxcsum, intel->regs + INTEL_RXCSUM );
+
 	/* Fill receive ring */
 	intel_refill_rx ( intel );
 
@@ -753,7 +786,6 @@ int intel_transmit ( struct net_device *netdev, struct io_buffer *iobuf ) {
 	struct intel_nic *intel = netdev->priv;
 	struct intel_descriptor *tx;
 	unsigned int tx_idx;
-	unsigned int tx_tail;
 	size_t len;
 
 	/* Get next transmit descriptor */
@@ -762,20 +794,16 @@ int intel_transmit ( struct net_device *netdev, struct io_buffer *iobuf ) {
 		return -ENOBUFS;
 	}
 	tx_idx = ( intel->tx.prod++ % INTEL_NUM_TX_DESC );
-	tx_tail = ( intel->tx.prod % INTEL_NUM_TX_DESC );
 	tx = &intel->tx.desc[tx_idx];
 
-	/* Populate transmit descriptor */
+	/* Populate transmit descriptor.  The doorbell write is
+	 * deferred to intel_flush(), to allow its cost to be
+	 * amortised across a burst of packets.
+	 */
 	len = iob_len ( iobuf );
 	intel->tx.describe ( tx, iob_dma ( iobuf ), len );
 	wmb();
 
-	/* Notify card that there are packets ready to transmit */
-	profile_start ( &intel_vm_tx_profiler );
-	writel ( tx_tail, intel->regs + intel->tx.reg + INTEL_xDT );
-	profile_stop ( &intel_vm_tx_profiler );
-	profile_exclude ( &intel_vm_tx_profiler );
-
 	DBGC2 ( intel, "INTEL %p TX %d is [%lx,%lx)\n",
 		intel, tx_idx, virt_to_phys ( iobuf->data ),
 		( virt_to_phys ( iobuf->data ) + len ) );
@@ -783,6 +811,23 @@ int intel_transmit ( struct net_device *netdev, struct io_buffer *iobuf ) {
 	return 0;
 }
 
+/**
+ * Flush deferred transmissions
+ *
+ * @v netdev		Network device
+ */
+void intel_flush ( struct net_device *netdev ) {
+	struct intel_nic *intel = netdev->priv;
+	unsigned int tx_tail;
+
+	/* Notify card that there are packets ready to transmit */
+	tx_tail = ( intel->tx.prod % INTEL_NUM_TX_DESC );
+	profile_start ( &intel_vm_tx_profiler );
+	writel ( tx_tail, intel->regs + intel->tx.reg + INTEL_xDT );
+	profile_stop ( &intel_vm_tx_profiler );
+	profile_exclude ( &intel_vm_tx_profiler );
+}
+
 /**
  * Poll for completed packets
  *
@@ -841,6 +886,15 @@ void intel_poll_rx ( struct net_device *netdev ) {
 		len = le16_to_cpu ( rx->length );
 		iob_put ( iobuf, len );
 
+		/* Mark checksum as validated by hardware, if applicable */
+		if ( ( rx->status &
+		       cpu_to_le32 ( INTEL_DESC_STATUS_TCPCS |
+				     INTEL_DESC_STATUS_IXSM |
+				     INTEL_DESC_STATUS_TCPE ) ) ==
+		     cpu_to_le32 ( INTEL_DESC_STATUS_TCPCS ) ) {
+			iobuf->flags |= IOB_FL_CSUM_GOOD;
+		}
+
 		/* Hand off to network stack */
 		if ( rx->status & cpu_to_le32 ( INTEL_DESC_STATUS_RXE ) ) {
 			DBGC ( intel, "INTEL %p RX %d error (length %zd, "
@@ -925,6 +979,7 @@ static struct net_device_operations intel_operations = {
 	.open		= intel_open,
 	.close		= intel_close,
 	.transmit	= intel_transmit,
+	.flush		= intel_flush,
 	.poll		= intel_poll,
 	.irq		= intel_irq,
 };
@@ -954,6 +1009,7 @@ static int intel_probe ( struct pci_device *pci ) {
 		goto err_alloc;
 	}
 	netdev_init ( netdev, &intel_operations );
+	netdev->max_pkt_len = INTEL_MAX_PKT_LEN;
 	intel = netdev->priv;
 	pci_set_drvdata ( pci, netdev );
 	netdev->dev = &pci->dev;
@@ -50,9 +50,18 @@ struct intel_descriptor {
 /** Descriptor done */
 #define INTEL_DESC_STATUS_DD 0x00000001UL
 
+/** Ignore checksum indication */
+#define INTEL_DESC_STATUS_IXSM 0x00000004UL
+
+/** TCP/UDP checksum calculated */
+#define INTEL_DESC_STATUS_TCPCS 0x00000020UL
+
 /** Receive error */
 #define INTEL_DESC_STATUS_RXE 0x00000100UL
 
+/** TCP/UDP checksum error */
+#define INTEL_DESC_STATUS_TCPE 0x00002000UL
+
 /** Payload length */
 #define INTEL_DESC_STATUS_PAYLEN( len ) ( (len) << 14 )
 
@@ -114,10 +123,14 @@ struct intel_descriptor {
 #define INTEL_RCTL_EN		0x00000002UL	/**< Receive enable */
 #define INTEL_RCTL_UPE		0x00000008UL	/**< Unicast promiscuous mode */
 #define INTEL_RCTL_MPE		0x00000010UL	/**< Multicast promiscuous */
+#define INTEL_RCTL_LPE		0x00000020UL	/**< Long packet enable */
 #define INTEL_RCTL_BAM		0x00008000UL	/**< Broadcast accept mode */
 #define INTEL_RCTL_BSIZE_BSEX(bsex,bsize) \
 	( ( (bsize) << 16 ) | ( (bsex) << 25 ) ) /**< Buffer size */
 #define INTEL_RCTL_BSIZE_2048	INTEL_RCTL_BSIZE_BSEX ( 0, 0 )
+#define INTEL_RCTL_BSIZE_4096	INTEL_RCTL_BSIZE_BSEX ( 1, 3 )
+#define INTEL_RCTL_BSIZE_8192	INTEL_RCTL_BSIZE_BSEX ( 1, 2 )
+#define INTEL_RCTL_BSIZE_16384	INTEL_RCTL_BSIZE_BSEX ( 1, 1 )
 #define INTEL_RCTL_BSIZE_BSEX_MASK INTEL_RCTL_BSIZE_BSEX ( 1, 3 )
 #define INTEL_RCTL_SECRC	0x04000000UL	/**< Strip CRC */
 
@@ -148,16 +161,39 @@ struct intel_descriptor {
 /** Number of receive descriptors
  *
  * Minimum value is 8, since the descriptor ring length must be a
- * multiple of 128.
+ * multiple of 128.  Must be a power of two, since the ring index
+ * arithmetic relies upon it.
+ *
+ * May be overridden at build time (e.g. via CFLAGS) to provide more
+ * headroom for bursty receive on links where the poll interval is
+ * occasionally stretched by other work such as TLS decryption; the
+ * hardware ring length limits are far in excess of any size useful
+ * to iPXE.
  */
+#ifndef INTEL_NUM_RX_DESC
 #define INTEL_NUM_RX_DESC 16
+#endif
 
-/** Receive descriptor ring fill level */
-#define INTEL_RX_FILL 8
+/** Receive descriptor ring fill level
+ *
+ * Scales with the ring size, leaving half of the ring as headroom to
+ * absorb receive bursts.
+ */
+#ifndef INTEL_RX_FILL
+#define INTEL_RX_FILL ( INTEL_NUM_RX_DESC / 2 )
+#endif
 
-/** Receive buffer length */
+/** Default receive buffer length */
 #define INTEL_RX_MAX_LEN 2048
 
+/** Maximum packet length
+ *
+ * This is the maximum frame length that we will allow to be
+ * configured via a jumbo MTU.  Most jumbo-capable models support at
+ * least this length.
+ */
+#define INTEL_MAX_PKT_LEN 9216
+
 /** Transmit packet buffer size */
 #define INTEL_TXPBS 0x03404UL
 #define INTEL_TXPBS_I210	0x04000014UL	/**< I210 power-up default */
@@ -168,9 +204,14 @@ struct intel_descriptor {
 /** Number of transmit descriptors
  *
  * Descriptor ring length must be a multiple of 16.  ICH8/9/10
- * requires a minimum of 16 TX descriptors.
+ * requires a minimum of 16 TX descriptors.  Must be a power of two,
+ * since the ring index arithmetic relies upon it.
+ *
+ * May be overridden at build time (e.g. via CFLAGS).
  */
+#ifndef INTEL_NUM_TX_DESC
 #define INTEL_NUM_TX_DESC 16
+#endif
 
 /** Transmit descriptor ring maximum fill level */
 #define INTEL_TX_FILL ( INTEL_NUM_TX_DESC - 1 )
@@ -197,6 +238,10 @@ struct intel_descriptor {
 /** Maximum time to wait for queue disable, in milliseconds */
 #define INTEL_DISABLE_MAX_WAIT_MS 100
 
+/** Receive Checksum Control Register */
+#define INTEL_RXCSUM 0x05000UL
+#define INTEL_RXCSUM_TUOFL	0x00000200UL	/**< TCP/UDP checksum offload */
+
 /** Receive Address Low */
 #define INTEL_RAL0 0x05400UL
 
@@ -311,6 +356,8 @@ struct intel_nic {
 	struct intel_ring tx;
 	/** Receive descriptor ring */
 	struct intel_ring rx;
+	/** Receive buffer length */
+	size_t rx_len;
 	/** Receive I/O buffers */
 	struct io_buffer *rx_iobuf[INTEL_NUM_RX_DESC];
 };
@@ -368,6 +415,7 @@ extern void intel_refill_rx ( struct intel_nic *intel );
 extern void intel_empty_rx ( struct intel_nic *intel );
 extern int intel_transmit ( struct net_device *netdev,
 			    struct io_buffer *iobuf );
+extern void intel_flush ( struct net_device *netdev );
 extern void intel_poll_tx ( struct net_device *netdev );
 extern void intel_poll_rx ( struct net_device *netdev );
 
@@ -218,6 +218,7 @@ static int intelx_open ( struct net_device *netdev ) {
 	writel ( fctrl, intel->regs + INTELX_FCTRL );
 
 	/* Configure receive buffer sizes */
+	intel->rx_len = INTEL_RX_MAX_LEN;
 	srrctl = readl ( intel->regs + INTELX_SRRCTL );
 	srrctl &= ~INTELX_SRRCTL_BSIZE_MASK;
 	srrctl |= INTELX_SRRCTL_BSIZE_DEFAULT;
@@ -361,6 +362,7 @@ static struct net_device_operations intelx_operations = {
 	.open		= intelx_open,
 	.close		= intelx_close,
 	.transmit	= intel_transmit,
+	.flush		= intel_flush,
 	.poll		= intelx_poll,
 	.irq		= intelx_irq,
 };
@@ -1656,6 +1656,16 @@ void intelxl_poll ( struct net_device *netdev ) {
 	 * watch for the value being written.  We could read from the
 	 * INT_DYN_CTL register, but this is even less efficient than
 	 * just unconditionally rearming the interrupt.
+	 *
+	 * This is also why we do not use WB_ON_ITR moderation: it
+	 * would replace this single per-poll write with a write-back
+	 * latency of up to one ITR interval on every packet, and on
+	 * several hardware generations the WB_ON_ITR bit must anyway
+	 * be rewritten after each write-back event.  This rearm is
+	 * the only MMIO access in the poll path when the ring does
+	 * not need refilling: completions are drained in a batch by
+	 * inspecting the write-back descriptors in host memory, and
+	 * the refill path issues a single tail update per poll.
 	 */
 	writel ( INTELXL_INT_DYN_CTL_INTENA, intelxl->regs + intelxl->intr );
 }
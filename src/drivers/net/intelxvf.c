@@ -291,6 +291,7 @@ static int intelxvf_open ( struct net_device *netdev ) {
 		 intel->regs + INTELXVF_IVARM );
 
 	/* Configure receive buffer sizes and set receive descriptor type */
+	intel->rx_len = INTEL_RX_MAX_LEN;
 	srrctl = readl ( intel->regs + INTELXVF_SRRCTL );
 	srrctl &= ~( INTELXVF_SRRCTL_BSIZE_MASK |
 		     INTELXVF_SRRCTL_BHDRSIZE_MASK |
@@ -413,6 +414,7 @@ static struct net_device_operations intelxvf_operations = {
 	.open		= intelxvf_open,
 	.close		= intelxvf_close,
 	.transmit	= intel_transmit,
+	.flush		= intel_flush,
 	.poll		= intelxvf_poll,
 	.irq		= intelxvf_irq,
 };
@@ -48,6 +48,18 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** @file
  *
  * IP over Infiniband
+ *
+ * Only datagram mode (UD queue pairs, with the MTU limited by the
+ * link MTU) is implemented.  Connected mode would raise the MTU to
+ * 65520 bytes, but requires a reliable-connected queue pair and a
+ * communication-management handshake per destination, connection
+ * state tied into the neighbour cache, and per-connection receive
+ * buffer pools of full-MTU frames; the existing CMRC support in the
+ * Infiniband core serves single-stream consumers (e.g. SRP) and
+ * does not map onto a packet interface with arbitrary destinations.
+ * Booting typically talks to a handful of peers for a short time,
+ * and the first-packet connection handshake would penalise exactly
+ * the short exchanges (ARP, DHCP, DNS) that dominate that workload.
  */
 
 /* Disambiguate the various error causes */
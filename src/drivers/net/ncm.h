@@ -165,9 +165,13 @@ struct ncm_device {
 
 /** Bulk IN ring maximum total buffer size
  *
- * This is a policy decision.
+ * This is a policy decision.  Must be large enough to allow the
+ * minimum buffer count at the maximum (64kB) NTB input size, so that
+ * devices which rely on packing many datagrams into each buffer can
+ * be used at their negotiated NTB size when heap space permits; the
+ * prefill logic will fall back to smaller buffers when it does not.
  */
-#define NCM_IN_MAX_SIZE 131072
+#define NCM_IN_MAX_SIZE ( NCM_IN_MIN_COUNT * NCM_MAX_NTB_INPUT_SIZE )
 
 /** Interrupt ring buffer count
  *
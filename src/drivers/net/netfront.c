@@ -42,6 +42,17 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Xen netfront driver
  *
+ * Note that granting and revoking buffer access on the data path is
+ * cheap: xengrant_permit_access() and xengrant_invalidate() are plain
+ * writes into the pre-mapped grant table, not grant-table hypercalls
+ * (the only grant-table hypercalls are issued once at initialisation
+ * time).  Persistent grants, which trade a data copy for fewer grant
+ * operations, would therefore be a pessimisation here.  Event-channel
+ * notifications are likewise already minimised: descriptors are
+ * pushed to the shared rings in batches (e.g. one push per receive
+ * refill burst), and RING_PUSH_REQUESTS_AND_CHECK_NOTIFY() suppresses
+ * the notification hypercall entirely whenever the backend is still
+ * processing the ring.
  */
 
 /* Disambiguate the various error causes */
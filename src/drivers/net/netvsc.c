@@ -30,6 +30,17 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  * The network virtual service client (NetVSC) connects to the network
  * virtual service provider (NetVSP) via the Hyper-V virtual machine
  * bus (VMBus).  It provides a transport layer for RNDIS packets.
+ *
+ * Each transmitted packet is sent as a single-packet RNDIS message.
+ * Multi-packet RNDIS messages are deliberately not used: the network
+ * core hands us one packet at a time, so aggregation would require
+ * artificially delaying transmissions in the hope of a second packet
+ * arriving, and the dominant per-message cost (signalling the host)
+ * is already elided by the VMBus layer whenever the host is actively
+ * draining the ring.  The receive path is similarly already batched:
+ * each poll drains every pending VMBus message, and the receive
+ * completions we send back are subject to the same host-signal
+ * suppression.
  */
 
 #include <string.h>
@@ -53,6 +53,11 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *    http://www.datasheetarchive.com/indexdl/Datasheet-028/DSA00494723.pdf
  */
 
+/* Sanity check on ring size: producer and consumer counters are
+ * free-running, so the ring size must be a power of two.
+ */
+static_assert ( ( RTL_NUM_RX_DESC & ( RTL_NUM_RX_DESC - 1 ) ) == 0 );
+
 /******************************************************************************
  *
  * Debugging
@@ -88,7 +88,10 @@ enum realtek_legacy_status {
 
 /** Number of transmit descriptors
  *
- * This is a hardware limit when using legacy mode.
+ * This is a hardware limit when using legacy mode: the 8139 provides
+ * exactly four transmit status/start address register pairs.  Since
+ * the same constant is used to index both datapaths, it cannot be
+ * raised for C+ mode without also splitting the ring arithmetic.
  */
 #define RTL_NUM_TX_DESC 4
 
@@ -237,8 +240,15 @@ enum realtek_legacy_status {
 /** Receive Descriptor Start Address Register (qword) */
 #define RTL_RDSAR 0xe4
 
-/** Number of receive descriptors */
-#define RTL_NUM_RX_DESC 4
+/** Number of receive descriptors
+ *
+ * This is a policy decision (used only by the C+ datapath; legacy
+ * mode uses the receive buffer instead).  Must be a power of two,
+ * since the producer and consumer counters are free-running.
+ */
+#ifndef RTL_NUM_RX_DESC
+#define RTL_NUM_RX_DESC 8
+#endif
 
 /** Receive buffer length */
 #define RTL_RX_MAX_LEN \
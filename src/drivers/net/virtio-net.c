@@ -81,6 +81,15 @@ enum {
 /** Max number of pending rx packets */
 #define NUM_RX_BUF 8
 
+/** Maximum packet length
+ *
+ * Used when the device does not advertise its own MTU, to allow a
+ * jumbo MTU to be configured via the ${netX/mtu} setting.  Receive
+ * buffers are sized to suit the configured MTU, so permitting jumbo
+ * frames costs nothing when they are not in use.
+ */
+#define VIRTNET_MAX_PKT_LEN ( ETH_HLEN + 9000 /* jumbo MTU */ )
+
 struct virtnet_nic {
 	/** Base pio register address */
 	unsigned long ioaddr;
@@ -110,11 +119,13 @@ struct virtnet_nic {
  * @v netdev		Network device
  * @v vq_idx		Virtqueue index (RX_INDEX or TX_INDEX)
  * @v iobuf		I/O buffer
+ * @v num_added		Number of buffers already added since the last kick
  *
- * The virtqueue is kicked after the iobuf has been added.
+ * The caller is responsible for kicking the virtqueue (once per batch
+ * of added buffers) via virtnet_kick().
  */
-static void virtnet_enqueue_iob ( struct net_device *netdev,
-				  int vq_idx, struct io_buffer *iobuf ) {
+static void virtnet_enqueue_iob ( struct net_device *netdev, int vq_idx,
+				  struct io_buffer *iobuf, int num_added ) {
 	struct virtnet_nic *virtnet = netdev->priv;
 	struct vring_virtqueue *vq = &virtnet->virtqueue[vq_idx];
 	struct virtio_net_hdr_modern *header = vq->empty_header;
@@ -146,9 +157,28 @@ static void virtnet_enqueue_iob ( struct net_device *netdev,
 	DBGC2 ( virtnet, "VIRTIO-NET %p enqueuing iobuf %p on vq %d\n",
 		virtnet, iobuf, vq_idx );
 
-	vring_add_buf ( vq, list, out, in, iobuf, 0 );
+	vring_add_buf ( vq, list, out, in, iobuf, num_added );
+}
+
+/** Notify the host of newly added buffers
+ *
+ * @v netdev		Network device
+ * @v vq_idx		Virtqueue index (RX_INDEX or TX_INDEX)
+ * @v num_added		Number of buffers added since the last kick
+ *
+ * A kick may cause a vmexit, so callers batch multiple added buffers
+ * into a single kick where possible (e.g. when refilling the receive
+ * virtqueue).  The kick itself is further suppressed via
+ * VRING_USED_F_NO_NOTIFY while the host is already processing the
+ * queue.
+ */
+static void virtnet_kick ( struct net_device *netdev, int vq_idx,
+			   int num_added ) {
+	struct virtnet_nic *virtnet = netdev->priv;
+	struct vring_virtqueue *vq = &virtnet->virtqueue[vq_idx];
+
 	vring_kick ( virtnet->virtio_version ? &virtnet->vdev : NULL,
-		     virtnet->ioaddr, vq, 1 );
+		     virtnet->ioaddr, vq, num_added );
 }
 
 /** Try to keep rx virtqueue filled with iobufs
@@ -157,7 +187,8 @@ static void virtnet_enqueue_iob ( struct net_device *netdev,
  */
 static void virtnet_refill_rx_virtqueue ( struct net_device *netdev ) {
 	struct virtnet_nic *virtnet = netdev->priv;
-	size_t len = ( netdev->max_pkt_len + 4 /* VLAN */ );
+	size_t len = ( ETH_HLEN + netdev->mtu + 4 /* VLAN */ );
+	int num_added = 0;
 
 	while ( virtnet->rx_num_iobufs < NUM_RX_BUF ) {
 		struct io_buffer *iobuf;
@@ -173,9 +204,13 @@ static void virtnet_refill_rx_virtqueue ( struct net_device *netdev ) {
 		/* Mark packet length until we know the actual size */
 		iob_put ( iobuf, len );
 
-		virtnet_enqueue_iob ( netdev, RX_INDEX, iobuf );
+		virtnet_enqueue_iob ( netdev, RX_INDEX, iobuf, num_added++ );
 		virtnet->rx_num_iobufs++;
 	}
+
+	/* Notify the host once for the whole batch of buffers */
+	if ( num_added )
+		virtnet_kick ( netdev, RX_INDEX, num_added );
 }
 
 /** Helper to free all virtqueue memory
@@ -353,7 +388,8 @@ static void virtnet_close ( struct net_device *netdev ) {
  */
 static int virtnet_transmit ( struct net_device *netdev,
 			      struct io_buffer *iobuf ) {
-	virtnet_enqueue_iob ( netdev, TX_INDEX, iobuf );
+	virtnet_enqueue_iob ( netdev, TX_INDEX, iobuf, 0 );
+	virtnet_kick ( netdev, TX_INDEX, 1 );
 	return 0;
 }
 
@@ -504,6 +540,8 @@ static int virtnet_probe_legacy ( struct pci_device *pci ) {
 		DBGC ( virtnet, "VIRTIO-NET %p mtu=%d\n", virtnet, mtu );
 		netdev->max_pkt_len = ( mtu + ETH_HLEN );
 		netdev->mtu = mtu;
+	} else {
+		netdev->max_pkt_len = VIRTNET_MAX_PKT_LEN;
 	}
 
 	/* Register network device */
@@ -623,6 +661,9 @@ static int virtnet_probe_modern ( struct pci_device *pci, int *found_dev ) {
 			DBGC ( virtnet, "VIRTIO-NET %p mtu=%d\n", virtnet,
 			       mtu );
 			netdev->max_pkt_len = ( mtu + ETH_HLEN );
+			netdev->mtu = mtu;
+		} else {
+			netdev->max_pkt_len = VIRTNET_MAX_PKT_LEN;
 		}
 	}
 
@@ -117,21 +117,33 @@ static int vmxnet3_transmit ( struct net_device *netdev,
 	/* Store I/O buffer for later completion */
 	vmxnet->tx_iobuf[desc_idx] = iobuf;
 
-	/* Populate transmit descriptor */
+	/* Populate transmit descriptor.  The doorbell write (which
+	 * causes a VM exit) is deferred to vmxnet3_flush(), to allow
+	 * its cost to be amortised across a burst of packets.
+	 */
 	tx_desc = &vmxnet->dma->tx_desc[desc_idx];
 	tx_desc->address = cpu_to_le64 ( virt_to_bus ( iobuf->data ) );
 	tx_desc->flags[0] = ( generation | cpu_to_le32 ( iob_len ( iobuf ) ) );
 	tx_desc->flags[1] = cpu_to_le32 ( VMXNET3_TXF_CQ | VMXNET3_TXF_EOP );
-
-	/* Hand over descriptor to NIC */
 	wmb();
+
+	return 0;
+}
+
+/**
+ * Flush deferred transmissions
+ *
+ * @v netdev		Network device
+ */
+static void vmxnet3_flush ( struct net_device *netdev ) {
+	struct vmxnet3_nic *vmxnet = netdev->priv;
+
+	/* Hand over descriptor(s) to NIC */
 	profile_start ( &vmxnet3_vm_tx_profiler );
 	writel ( ( vmxnet->count.tx_prod % VMXNET3_NUM_TX_DESC ),
 		 ( vmxnet->pt + VMXNET3_PT_TXPROD ) );
 	profile_stop ( &vmxnet3_vm_tx_profiler );
 	profile_exclude ( &vmxnet3_vm_tx_profiler );
-
-	return 0;
 }
 
 /**
@@ -569,6 +581,7 @@ static struct net_device_operations vmxnet3_operations = {
 	.open		= vmxnet3_open,
 	.close		= vmxnet3_close,
 	.transmit	= vmxnet3_transmit,
+	.flush		= vmxnet3_flush,
 	.poll		= vmxnet3_poll,
 	.irq		= vmxnet3_irq,
 };
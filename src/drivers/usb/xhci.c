@@ -1734,6 +1734,10 @@ static void xhci_host_controller ( struct xhci_device *xhci,
  * Poll event ring
  *
  * @v xhci		xHCI device
+ *
+ * All pending events are drained in a single pass, with the event
+ * ring dequeue pointer register written back only once at the end;
+ * the register update is the expensive part of event processing.
  */
 static void xhci_event_poll ( struct xhci_device *xhci ) {
 	struct xhci_event_ring *event = &xhci->event;
@@ -2684,6 +2688,11 @@ static unsigned int xhci_endpoint_count ( size_t len, int zlp ) {
  * @v iobuf		I/O buffer
  * @v zlp		Append a zero-length packet
  * @ret rc		Return status code
+ *
+ * The transfer is enqueued as a single transfer descriptor: the
+ * chain bit links together as many maximally-sized (64kB) TRBs as
+ * are needed to cover the whole buffer, and the doorbell is rung
+ * once for the complete descriptor.
  */
 static int xhci_endpoint_stream ( struct usb_endpoint *ep,
 				  struct io_buffer *iobuf, int zlp ) {
@@ -156,10 +156,16 @@ static int ifclose_exec ( int argc, char **argv ) {
 }
 
 /** "ifstat" options */
-struct ifstat_options {};
+struct ifstat_options {
+	/** Rate sampling interval */
+	unsigned long interval;
+};
 
 /** "ifstat" option list */
-static struct option_descriptor ifstat_opts[] = {};
+static struct option_descriptor ifstat_opts[] = {
+	OPTION_DESC ( "rate", 'r', required_argument,
+		      struct ifstat_options, interval, parse_timeout ),
+};
 
 /**
  * "ifstat" payload
@@ -169,8 +175,16 @@ static struct option_descriptor ifstat_opts[] = {};
  * @ret rc		Return status code
  */
 static int ifstat_payload ( struct net_device *netdev,
-			    struct ifstat_options *opts __unused ) {
+			    struct ifstat_options *opts ) {
+	int rc;
+
 	ifstat ( netdev );
+
+	/* Measure traffic rates, if requested */
+	if ( opts->interval &&
+	     ( ( rc = ifrate ( netdev, opts->interval ) ) != 0 ) )
+		return rc;
+
 	return 0;
 }
 
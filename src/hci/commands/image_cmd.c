@@ -51,6 +51,8 @@ struct imgsingle_options {
 	int replace;
 	/** Free image after execution */
 	int autofree;
+	/** Download in the background */
+	int background;
 };
 
 /** "img{single}" option list */
@@ -124,11 +126,24 @@ static int imgsingle_exec ( int argc, char **argv,
 		}
 	}
 
+	/* Treat a trailing "&" as equivalent to "--background" for
+	 * pure download commands; commands that go on to act upon the
+	 * image require the download to have completed.
+	 */
+	if ( ( ! desc->action ) && shell_background() )
+		opts.background = 1;
+
 	/* Acquire the image */
 	if ( name_uri ) {
-		if ( ( rc = desc->acquire ( name_uri, opts.timeout,
-					    &image ) ) != 0 )
+		if ( opts.background ) {
+			/* Start download without waiting for completion */
+			rc = imgdownload_string_background ( name_uri, &image );
+			if ( rc != 0 )
+				goto err_acquire;
+		} else if ( ( rc = desc->acquire ( name_uri, opts.timeout,
+						   &image ) ) != 0 ) {
 			goto err_acquire;
+		}
 	} else {
 		image = find_image_tag ( &selected_image );
 		if ( ! image ) {
@@ -185,9 +200,26 @@ static int imgsingle_exec ( int argc, char **argv,
 	return rc;
 }
 
+/** "imgfetch" option list
+ *
+ * This is not part of the shared option list union, since
+ * "--background" applies only to pure downloads: commands that go on
+ * to act upon the image require the download to have completed.
+ */
+static struct option_descriptor imgfetch_opts[] = {
+	OPTION_DESC ( "name", 'n', required_argument,
+		      struct imgsingle_options, name, parse_string ),
+	OPTION_DESC ( "timeout", 't', required_argument,
+		      struct imgsingle_options, timeout, parse_timeout ),
+	OPTION_DESC ( "autofree", 'a', no_argument,
+		      struct imgsingle_options, autofree, parse_flag ),
+	OPTION_DESC ( "background", 'b', no_argument,
+		      struct imgsingle_options, background, parse_flag ),
+};
+
 /** "imgfetch" command descriptor */
 static struct command_descriptor imgfetch_cmd =
-	COMMAND_DESC ( struct imgsingle_options, opts.imgsingle,
+	COMMAND_DESC ( struct imgsingle_options, imgfetch_opts,
 		       1, MAX_ARGUMENTS, "<uri> [<arguments>...]" );
 
 /** "imgfetch" family command descriptor */
@@ -371,6 +403,78 @@ static int imgmulti_exec ( int argc, char **argv,
 	return 0;
 }
 
+/** "imgwait" options */
+struct imgwait_options {
+	/** Timeout */
+	unsigned long timeout;
+};
+
+/** "imgwait" option list */
+static struct option_descriptor imgwait_opts[] = {
+	OPTION_DESC ( "timeout", 't', required_argument,
+		      struct imgwait_options, timeout, parse_timeout ),
+};
+
+/** "imgwait" command descriptor */
+static struct command_descriptor imgwait_cmd =
+	COMMAND_DESC ( struct imgwait_options, imgwait_opts, 0, 0, NULL );
+
+/**
+ * The "imgwait" command
+ *
+ * @v argc		Argument count
+ * @v argv		Argument list
+ * @ret rc		Return status code
+ */
+static int imgwait_exec ( int argc, char **argv ) {
+	struct imgwait_options opts;
+	int rc;
+
+	/* Parse options */
+	if ( ( rc = parse_options ( argc, argv, &imgwait_cmd, &opts ) ) != 0 )
+		return rc;
+
+	/* Wait for background downloads to complete */
+	if ( ( rc = imgwait ( NULL, opts.timeout ) ) != 0 ) {
+		printf ( "Could not complete downloads: %s\n",
+			 strerror ( rc ) );
+		return rc;
+	}
+
+	return 0;
+}
+
+/** "imgjobs" options */
+struct imgjobs_options {};
+
+/** "imgjobs" option list */
+static struct option_descriptor imgjobs_opts[] = {};
+
+/** "imgjobs" command descriptor */
+static struct command_descriptor imgjobs_cmd =
+	COMMAND_DESC ( struct imgjobs_options, imgjobs_opts, 0, 0, NULL );
+
+/**
+ * The "imgjobs" command
+ *
+ * @v argc		Argument count
+ * @v argv		Argument list
+ * @ret rc		Return status code
+ */
+static int imgjobs_exec ( int argc, char **argv ) {
+	struct imgjobs_options opts;
+	int rc;
+
+	/* Parse options */
+	if ( ( rc = parse_options ( argc, argv, &imgjobs_cmd, &opts ) ) != 0 )
+		return rc;
+
+	/* List background downloads */
+	imgjobs();
+
+	return 0;
+}
+
 /**
  * The "imgstat" command
  *
@@ -427,6 +531,10 @@ struct command image_commands[] __command = {
 		.name = "imgargs",
 		.exec = imgargs_exec,
 	},
+	{
+		.name = "imgjobs",
+		.exec = imgjobs_exec,
+	},
 	{
 		.name = "imgexec",
 		.exec = imgexec_exec,
@@ -435,6 +543,10 @@ struct command image_commands[] __command = {
 		.name = "boot", /* synonym for "imgexec" */
 		.exec = imgexec_exec,
 	},
+	{
+		.name = "imgwait",
+		.exec = imgwait_exec,
+	},
 	{
 		.name = "imgstat",
 		.exec = imgstat_exec,
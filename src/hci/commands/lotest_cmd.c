@@ -45,6 +45,10 @@ struct lotest_options {
 	unsigned int mtu;
 	/** Broadcast */
 	int broadcast;
+	/** Benchmark packet count */
+	unsigned int count;
+	/** Benchmark in-flight depth */
+	unsigned int depth;
 };
 
 /** "lotest" option list */
@@ -53,6 +57,10 @@ static struct option_descriptor lotest_opts[] = {
 		      struct lotest_options, mtu, parse_integer ),
 	OPTION_DESC ( "broadcast", 'b', no_argument,
 		      struct lotest_options, broadcast, parse_flag ),
+	OPTION_DESC ( "count", 'c', required_argument,
+		      struct lotest_options, count, parse_integer ),
+	OPTION_DESC ( "depth", 'd', required_argument,
+		      struct lotest_options, depth, parse_integer ),
 };
 
 /** "lotest" command descriptor */
@@ -89,6 +97,16 @@ static int lotest_exec ( int argc, char **argv ) {
 	if ( ! opts.mtu )
 		opts.mtu = ETH_MAX_MTU;
 
+	/* Perform benchmark rather than test, if a count was given */
+	if ( opts.count ) {
+		if ( ( rc = loopback_bench ( sender, receiver, opts.mtu,
+					     opts.count, opts.depth ) ) != 0 ) {
+			printf ( "Benchmark failed: %s\n", strerror ( rc ) );
+			return rc;
+		}
+		return 0;
+	}
+
 	/* Perform loopback test */
 	if ( ( rc = loopback_test ( sender, receiver, opts.mtu,
 				    opts.broadcast ) ) != 0 ) {
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdio.h>
+#include <getopt.h>
+#include <ipxe/command.h>
+#include <ipxe/parseopt.h>
+#include <ipxe/malloc.h>
+
+/** @file
+ *
+ * Memory statistics command
+ *
+ */
+
+/** "memstat" options */
+struct memstat_options {};
+
+/** "memstat" option list */
+static struct option_descriptor memstat_opts[] = {};
+
+/** "memstat" command descriptor */
+static struct command_descriptor memstat_cmd =
+	COMMAND_DESC ( struct memstat_options, memstat_opts, 0, 0, NULL );
+
+/**
+ * The "memstat" command
+ *
+ * @v argc		Argument count
+ * @v argv		Argument list
+ * @ret rc		Return status code
+ */
+static int memstat_exec ( int argc, char **argv ) {
+	struct memstat_options opts;
+	struct heap_stats stats;
+	int rc;
+
+	/* Parse options */
+	if ( ( rc = parse_options ( argc, argv, &memstat_cmd, &opts ) ) != 0 )
+		return rc;
+
+	/* Print heap statistics */
+	heap_stat ( &stats );
+	printf ( "Heap: %zd used (max %zd), %zd free (largest block %zd in "
+		 "%d blocks), %d failures\n", usedmem, maxusedmem, freemem,
+		 stats.largest, stats.blocks, stats.failures );
+
+	/* Print external memory statistics */
+	printf ( "External: %zd used (max %zd)\n", uusedmem, maxuusedmem );
+
+	/* Print largest failed allocation, if any */
+	if ( heap_worst_failure.size ) {
+		printf ( "Worst failure: %zd bytes (align %zd) from %p with "
+			 "%zd used, largest free %zd\n",
+			 heap_worst_failure.size, heap_worst_failure.align,
+			 heap_worst_failure.caller, heap_worst_failure.used,
+			 heap_worst_failure.largest );
+	}
+
+	return 0;
+}
+
+/** Memory statistics command */
+struct command memstat_command __command = {
+	.name = "memstat",
+	.exec = memstat_exec,
+};
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <ipxe/command.h>
+#include <ipxe/parseopt.h>
+#include <ipxe/timer.h>
+#include <usr/nbmgmt.h>
+
+/** @file
+ *
+ * Network benchmark command
+ *
+ */
+
+/** Default remote port (as used by iperf) */
+#define NETBENCH_DEFAULT_PORT 5001
+
+/** Default chunk length */
+#define NETBENCH_DEFAULT_SIZE 1460
+
+/** Default duration */
+#define NETBENCH_DEFAULT_DURATION ( 10 * TICKS_PER_SEC )
+
+/** "netbench" options */
+struct netbench_options {
+	/** Remote port */
+	unsigned int port;
+	/** Use UDP */
+	int udp;
+	/** Receive (rather than transmit) */
+	int rx;
+	/** Chunk length */
+	unsigned int size;
+	/** Duration (in ms) */
+	unsigned long duration;
+};
+
+/** "netbench" option list */
+static struct option_descriptor netbench_opts[] = {
+	OPTION_DESC ( "port", 'p', required_argument,
+		      struct netbench_options, port, parse_integer ),
+	OPTION_DESC ( "udp", 'u', no_argument,
+		      struct netbench_options, udp, parse_flag ),
+	OPTION_DESC ( "receive", 'r', no_argument,
+		      struct netbench_options, rx, parse_flag ),
+	OPTION_DESC ( "size", 's', required_argument,
+		      struct netbench_options, size, parse_integer ),
+	OPTION_DESC ( "time", 't', required_argument,
+		      struct netbench_options, duration, parse_timeout ),
+};
+
+/** "netbench" command descriptor */
+static struct command_descriptor netbench_cmd =
+	COMMAND_DESC ( struct netbench_options, netbench_opts, 1, 1,
+		       "<host>" );
+
+/**
+ * The "netbench" command
+ *
+ * @v argc		Argument count
+ * @v argv		Argument list
+ * @ret rc		Return status code
+ */
+static int netbench_exec ( int argc, char **argv ) {
+	struct netbench_options opts;
+	const char *hostname;
+	int rc;
+
+	/* Initialise options */
+	memset ( &opts, 0, sizeof ( opts ) );
+	opts.port = NETBENCH_DEFAULT_PORT;
+	opts.size = NETBENCH_DEFAULT_SIZE;
+	opts.duration = NETBENCH_DEFAULT_DURATION;
+
+	/* Parse options */
+	if ( ( rc = reparse_options ( argc, argv, &netbench_cmd,
+				      &opts ) ) != 0 )
+		return rc;
+
+	/* Parse hostname */
+	hostname = argv[optind];
+
+	/* Run benchmark */
+	if ( ( rc = netbench ( hostname, opts.port, opts.udp, opts.rx,
+			       opts.size, opts.duration ) ) != 0 )
+		return rc;
+
+	return 0;
+}
+
+/** Network benchmark command */
+struct command netbench_command __command = {
+	.name = "netbench",
+	.exec = netbench_exec,
+};
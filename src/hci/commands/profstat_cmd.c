@@ -27,6 +27,10 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <getopt.h>
 #include <ipxe/command.h>
 #include <ipxe/parseopt.h>
+#include <ipxe/console.h>
+#include <ipxe/process.h>
+#include <ipxe/keys.h>
+#include <ipxe/timer.h>
 #include <usr/profstat.h>
 
 /** @file
@@ -36,10 +40,16 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  */
 
 /** "profstat" options */
-struct profstat_options {};
+struct profstat_options {
+	/** Repeat interval */
+	unsigned long interval;
+};
 
 /** "profstat" option list */
-static struct option_descriptor profstat_opts[] = {};
+static struct option_descriptor profstat_opts[] = {
+	OPTION_DESC ( "interval", 'i', required_argument,
+		      struct profstat_options, interval, parse_timeout ),
+};
 
 /** "profstat" command descriptor */
 static struct command_descriptor profstat_cmd =
@@ -54,13 +64,32 @@ static struct command_descriptor profstat_cmd =
  */
 static int profstat_exec ( int argc, char **argv ) {
 	struct profstat_options opts;
+	unsigned long start;
 	int rc;
 
 	/* Parse options */
 	if ( ( rc = parse_options ( argc, argv, &profstat_cmd, &opts ) ) != 0 )
 		return rc;
 
-	profstat();
+	while ( 1 ) {
+
+		/* Print profiling statistics */
+		profstat();
+
+		/* Print once only, unless a repeat interval was given */
+		if ( ! opts.interval )
+			break;
+
+		/* Wait for the repeat interval, allowing foreground
+		 * activity to continue and checking for Ctrl-C
+		 */
+		start = currticks();
+		while ( ( currticks() - start ) < opts.interval ) {
+			step();
+			if ( iskey() && ( getchar() == CTRL_C ) )
+				return 0;
+		}
+	}
 
 	return 0;
 }
@@ -249,6 +249,16 @@ static int efi_image_exec ( struct image *image ) {
 	 * but requires a non-const pointer to SourceBuffer.  We
 	 * therefore use the .rwdata field rather than .data.
 	 */
+	/* Passing SourceBuffer is already the minimal-copy handoff:
+	 * iPXE hands the firmware a pointer to the downloaded file in
+	 * place, and the only copy made is the firmware's own PE
+	 * section placement and relocation into boot services memory,
+	 * which no UEFI interface allows a caller to avoid.  Note
+	 * that this copy covers only the PE executable itself: large
+	 * payload files (e.g. a boot.wim exposed alongside a wimboot
+	 * wrapper) are not part of SourceBuffer and are read on
+	 * demand via our virtual filesystem.
+	 */
 	handle = NULL;
 	if ( ( efirc = bs->LoadImage ( FALSE, efi_image_handle, path,
 				       exec->rwdata, exec->len,
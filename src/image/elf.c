@@ -31,6 +31,20 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  * A "pure" ELF image is not a bootable image.  There are various
  * bootable formats based upon ELF (e.g. Multiboot), which share
  * common ELF-related functionality.
+ *
+ * Segments are copied from the downloaded file to their physical
+ * destinations only at execution time, even though the program
+ * headers arrive in the first few bytes of the file.  Steering
+ * download writes directly to p_paddr is not possible within our
+ * execution model: the file is typed only after the download
+ * completes, the destination addresses may overlap iPXE itself or
+ * memory that remains in use until shutdown (which is resolved only
+ * by shutting down immediately before jumping to the entry point),
+ * and the intact file must remain available for signature
+ * verification and for subsequent invocations.  The cost of loading
+ * is therefore a single memcpy() per segment (prep_segment() zeroes
+ * only the .bss tail), which is the minimum achievable without
+ * sacrificing those guarantees.
  */
 
 #include <string.h>
@@ -39,6 +53,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/segment.h>
 #include <ipxe/image.h>
 #include <ipxe/uaccess.h>
+#include <ipxe/io.h>
 #include <ipxe/elf.h>
 
 /**
@@ -47,10 +62,11 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  * @v image		ELF file
  * @v phdr		ELF program header
  * @v dest		Destination address
+ * @v memmap		Memory map
  * @ret rc		Return status code
  */
 static int elf_load_segment ( struct image *image, const Elf_Phdr *phdr,
-			      physaddr_t dest ) {
+			      physaddr_t dest, struct memory_map *memmap ) {
 	void *buffer = phys_to_virt ( dest );
 	int rc;
 
@@ -60,7 +76,7 @@ static int elf_load_segment ( struct image *image, const Elf_Phdr *phdr,
 
 	/* Verify and prepare segment */
 	if ( ( rc = prep_segment ( buffer, phdr->p_filesz,
-				   phdr->p_memsz ) ) != 0 ) {
+				   phdr->p_memsz, memmap ) ) != 0 ) {
 		DBGC ( image, "ELF %s could not prepare segment: %s\n",
 		       image->name, strerror ( rc ) );
 		return rc;
@@ -79,6 +95,7 @@ static int elf_load_segment ( struct image *image, const Elf_Phdr *phdr,
  * @v ehdr		ELF executable header
  * @v phdr		ELF program header
  * @v process		Segment processor
+ * @v memmap		Memory map
  * @ret entry		Entry point, if found
  * @ret max		Maximum used address
  * @ret rc		Return status code
@@ -87,7 +104,9 @@ static int elf_segment ( struct image *image, const Elf_Ehdr *ehdr,
 			 const Elf_Phdr *phdr,
 			 int ( * process ) ( struct image *image,
 					     const Elf_Phdr *phdr,
-					     physaddr_t dest ),
+					     physaddr_t dest,
+					     struct memory_map *memmap ),
+			 struct memory_map *memmap,
 			 physaddr_t *entry, physaddr_t *max ) {
 	physaddr_t dest;
 	physaddr_t end;
@@ -123,7 +142,7 @@ static int elf_segment ( struct image *image, const Elf_Ehdr *ehdr,
 		*max = end;
 
 	/* Process segment */
-	if ( ( rc = process ( image, phdr, dest ) ) != 0 )
+	if ( ( rc = process ( image, phdr, dest, memmap ) ) != 0 )
 		return rc;
 
 	/* Set execution address, if it lies within this segment */
@@ -150,6 +169,7 @@ static int elf_segment ( struct image *image, const Elf_Ehdr *ehdr,
  * @v image		ELF file
  * @v ehdr		ELF executable header
  * @v process		Segment processor
+ * @v memmap		Memory map (or NULL to fetch a map per segment)
  * @ret entry		Entry point, if found
  * @ret max		Maximum used address
  * @ret rc		Return status code
@@ -157,7 +177,9 @@ static int elf_segment ( struct image *image, const Elf_Ehdr *ehdr,
 int elf_segments ( struct image *image, const Elf_Ehdr *ehdr,
 		   int ( * process ) ( struct image *image,
 				       const Elf_Phdr *phdr,
-				       physaddr_t dest ),
+				       physaddr_t dest,
+				       struct memory_map *memmap ),
+		   struct memory_map *memmap,
 		   physaddr_t *entry, physaddr_t *max ) {
 	const Elf_Phdr *phdr;
 	Elf_Off phoff;
@@ -181,7 +203,7 @@ int elf_segments ( struct image *image, const Elf_Ehdr *ehdr,
 		}
 		phdr = ( image->data + phoff );
 		if ( ( rc = elf_segment ( image, ehdr, phdr, process,
-					  entry, max ) ) != 0 )
+					  memmap, entry, max ) ) != 0 )
 			return rc;
 	}
 
@@ -204,6 +226,7 @@ int elf_segments ( struct image *image, const Elf_Ehdr *ehdr,
  * @ret rc		Return status code
  */
 int elf_load ( struct image *image, physaddr_t *entry, physaddr_t *max ) {
+	struct memory_map memmap;
 	static const uint8_t e_ident[] = {
 		[EI_MAG0]	= ELFMAG0,
 		[EI_MAG1]	= ELFMAG1,
@@ -226,9 +249,12 @@ int elf_load ( struct image *image, physaddr_t *entry, physaddr_t *max ) {
 		return -ENOEXEC;
 	}
 
-	/* Load ELF segments into memory */
+	/* Load ELF segments into memory.  Fetch the memory map once
+	 * for the whole load operation, rather than once per segment.
+	 */
+	get_memmap ( &memmap );
 	if ( ( rc = elf_segments ( image, ehdr, elf_load_segment,
-				   entry, max ) ) != 0 )
+				   &memmap, entry, max ) ) != 0 )
 		return rc;
 
 	return 0;
@@ -4,6 +4,17 @@
  *
  * Embedded images are images built into the iPXE binary and do not require
  * fetching over the network.
+ *
+ * Embedded images are deliberately not individually compressed at
+ * build time.  All ROM and other bin-x86 media formats pass the whole
+ * binary (including the .data section holding the embedded images)
+ * through the util/zbin LZMA wrapper, so embedded images already
+ * occupy compressed space in flash and in the ROM BAR; a second
+ * compression layer would slightly inflate the ROM (compressed data
+ * does not compress further) while adding a runtime extraction cost.
+ * Images that are distributed pre-compressed (e.g. gzip, where
+ * IMAGE_GZIP is enabled) may be embedded as-is and will be extracted
+ * transparently on first use via their image type's extract method.
  */
 
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
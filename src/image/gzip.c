@@ -36,6 +36,18 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * gzip compressed images
  *
+ * Extraction runs as a single pass after the compressed image has
+ * been fully downloaded, rather than inflating incrementally as data
+ * arrives off the wire.  Image types are deliberately not probed
+ * until a download completes: the downloader is format-agnostic, the
+ * ISIZE footer used to presize the output buffer is the last four
+ * bytes of the file, and signature verification (imgverify) digests
+ * the compressed bytes exactly as fetched, which an on-the-fly
+ * inflater would bypass.  Transparent decompression during transfer
+ * belongs at the protocol layer (e.g. HTTP Content-Encoding) where
+ * the wire format is explicitly negotiated; for local extraction, the
+ * source image's data is instead freed as early as possible (see
+ * image_extract_exec()) to bound peak memory usage.
  */
 
 /**
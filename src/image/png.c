@@ -349,71 +349,84 @@ static int png_image_data ( struct image *image, struct png_context *png,
 }
 
 /**
- * Unfilter byte using the "None" filter
+ * Unfilter scanline using the "None" filter
  *
- * @v current		Filtered current byte
- * @v left		Unfiltered left byte
- * @v above		Unfiltered above byte
- * @v above_left	Unfiltered above-left byte
- * @ret current		Unfiltered current byte
+ * @v data		Scanline data
+ * @v above		Scanline data for row above (or NULL)
+ * @v pixel_len		Pixel length
+ * @v len		Scanline length (excluding filter byte)
  */
-static unsigned int png_unfilter_none ( unsigned int current,
-					unsigned int left __unused,
-					unsigned int above __unused,
-					unsigned int above_left __unused ) {
+static void png_unfilter_none ( uint8_t *data __unused,
+				const uint8_t *above __unused,
+				size_t pixel_len __unused,
+				size_t len __unused ) {
 
-	return current;
+	/* Nothing to do */
 }
 
 /**
- * Unfilter byte using the "Sub" filter
+ * Unfilter scanline using the "Sub" filter
  *
- * @v current		Filtered current byte
- * @v left		Unfiltered left byte
- * @v above		Unfiltered above byte
- * @v above_left	Unfiltered above-left byte
- * @ret current		Unfiltered current byte
+ * @v data		Scanline data
+ * @v above		Scanline data for row above (or NULL)
+ * @v pixel_len		Pixel length
+ * @v len		Scanline length (excluding filter byte)
  */
-static unsigned int png_unfilter_sub ( unsigned int current,
-				       unsigned int left,
-				       unsigned int above __unused,
-				       unsigned int above_left __unused ) {
-
-	return ( current + left );
+static void png_unfilter_sub ( uint8_t *data,
+			       const uint8_t *above __unused,
+			       size_t pixel_len, size_t len ) {
+	size_t i;
+
+	/* Left bytes within the first pixel are taken to be zero */
+	for ( i = pixel_len ; i < len ; i++ )
+		data[i] += data[ i - pixel_len ];
 }
 
 /**
- * Unfilter byte using the "Up" filter
+ * Unfilter scanline using the "Up" filter
  *
- * @v current		Filtered current byte
- * @v left		Unfiltered left byte
- * @v above		Unfiltered above byte
- * @v above_left	Unfiltered above-left byte
- * @ret current		Unfiltered current byte
+ * @v data		Scanline data
+ * @v above		Scanline data for row above (or NULL)
+ * @v pixel_len		Pixel length
+ * @v len		Scanline length (excluding filter byte)
  */
-static unsigned int png_unfilter_up ( unsigned int current,
-				      unsigned int left __unused,
-				      unsigned int above,
-				      unsigned int above_left __unused ) {
+static void png_unfilter_up ( uint8_t *data, const uint8_t *above,
+			      size_t pixel_len __unused, size_t len ) {
+	size_t i;
+
+	/* Above bytes on the first scanline are taken to be zero */
+	if ( ! above )
+		return;
 
-	return ( current + above );
+	for ( i = 0 ; i < len ; i++ )
+		data[i] += above[i];
 }
 
 /**
- * Unfilter byte using the "Average" filter
+ * Unfilter scanline using the "Average" filter
  *
- * @v current		Filtered current byte
- * @v left		Unfiltered left byte
- * @v above		Unfiltered above byte
- * @v above_left	Unfiltered above-left byte
- * @ret current		Unfiltered current byte
+ * @v data		Scanline data
+ * @v above		Scanline data for row above (or NULL)
+ * @v pixel_len		Pixel length
+ * @v len		Scanline length (excluding filter byte)
  */
-static unsigned int png_unfilter_average ( unsigned int current,
-					   unsigned int left,
-					   unsigned int above,
-					   unsigned int above_left __unused ) {
+static void png_unfilter_average ( uint8_t *data, const uint8_t *above,
+				   size_t pixel_len, size_t len ) {
+	size_t i;
 
-	return ( current + ( ( above + left ) >> 1 ) );
+	/* Above bytes on the first scanline (and left bytes within
+	 * the first pixel) are taken to be zero.
+	 */
+	if ( above ) {
+		for ( i = 0 ; i < pixel_len ; i++ )
+			data[i] += ( above[i] >> 1 );
+		for ( ; i < len ; i++ ) {
+			data[i] += ( ( data[ i - pixel_len ] + above[i] ) >> 1 );
+		}
+	} else {
+		for ( i = pixel_len ; i < len ; i++ )
+			data[i] += ( data[ i - pixel_len ] >> 1 );
+	}
 }
 
 /**
@@ -446,37 +459,47 @@ static unsigned int png_paeth_predictor ( unsigned int a, unsigned int b,
 }
 
 /**
- * Unfilter byte using the "Paeth" filter
+ * Unfilter scanline using the "Paeth" filter
  *
- * @v current		Filtered current byte
- * @v above_left	Unfiltered above-left byte
- * @v above		Unfiltered above byte
- * @v left		Unfiltered left byte
- * @ret current		Unfiltered current byte
+ * @v data		Scanline data
+ * @v above		Scanline data for row above (or NULL)
+ * @v pixel_len		Pixel length
+ * @v len		Scanline length (excluding filter byte)
  */
-static unsigned int png_unfilter_paeth ( unsigned int current,
-					 unsigned int left,
-					 unsigned int above,
-					 unsigned int above_left ) {
+static void png_unfilter_paeth ( uint8_t *data, const uint8_t *above,
+				 size_t pixel_len, size_t len ) {
+	size_t i;
 
-	return ( current + png_paeth_predictor ( left, above, above_left ) );
+	/* Above bytes on the first scanline (and left bytes within
+	 * the first pixel) are taken to be zero, for which the Paeth
+	 * predictor degenerates to the remaining non-zero byte.
+	 */
+	if ( above ) {
+		for ( i = 0 ; i < pixel_len ; i++ )
+			data[i] += above[i];
+		for ( ; i < len ; i++ ) {
+			data[i] += png_paeth_predictor ( data[ i - pixel_len ],
+							 above[i],
+							 above[ i - pixel_len ] );
+		}
+	} else {
+		for ( i = pixel_len ; i < len ; i++ )
+			data[i] += data[ i - pixel_len ];
+	}
 }
 
 /** A PNG filter */
 struct png_filter {
 	/**
-	 * Unfilter byte
+	 * Unfilter scanline
 	 *
-	 * @v current		Filtered current byte
-	 * @v left		Unfiltered left byte
-	 * @v above		Unfiltered above byte
-	 * @v above_left	Unfiltered above-left byte
-	 * @ret current		Unfiltered current byte
+	 * @v data		Scanline data
+	 * @v above		Scanline data for row above (or NULL)
+	 * @v pixel_len		Pixel length
+	 * @v len		Scanline length (excluding filter byte)
 	 */
-	unsigned int ( * unfilter ) ( unsigned int current,
-				      unsigned int left,
-				      unsigned int above,
-				      unsigned int above_left );
+	void ( * unfilter ) ( uint8_t *data, const uint8_t *above,
+			      size_t pixel_len, size_t len );
 };
 
 /** PNG filter types */
@@ -504,20 +527,19 @@ static int png_unfilter_pass ( struct image *image, struct png_context *png,
 	size_t pixel_len = png_pixel_len ( png );
 	size_t scanline_len = png_scanline_len ( png, interlace );
 	uint8_t *data = ( png->raw.data + png->raw.offset );
+	const uint8_t *above = NULL;
 	struct png_filter *filter;
 	unsigned int scanline;
-	unsigned int byte;
 	unsigned int filter_type;
-	unsigned int left;
-	unsigned int above;
-	unsigned int above_left;
 
-	/* On the first scanline of a pass, above bytes are assumed to
-	 * be zero.
+	/* Iterate over each scanline in turn, applying the
+	 * appropriate filter kernel to the whole scanline.  Boundary
+	 * conditions (the first scanline of a pass, and the first
+	 * pixel of a scanline) are hoisted out of the kernels' inner
+	 * loops, which therefore contain no per-byte branches or
+	 * indirections and can be autovectorized where the target
+	 * instruction set allows.
 	 */
-	above = 0;
-
-	/* Iterate over each scanline in turn */
 	for ( scanline = 0 ; scanline < interlace->height ; scanline++ ) {
 
 		/* Extract filter byte and determine filter type */
@@ -533,30 +555,13 @@ static int png_unfilter_pass ( struct image *image, struct png_context *png,
 		DBGC2 ( image, "PNG %s pass %d scanline %d filter type %d\n",
 			image->name, interlace->pass, scanline, filter_type );
 
-		/* At the start of a line, both above-left and left
-		 * bytes are taken to be zero.
-		 */
-		left = 0;
-		above_left = 0;
-
-		/* Iterate over each byte (not pixel) in turn */
-		for ( byte = 0 ; byte < ( scanline_len - 1 ) ; byte++ ) {
-
-			/* Extract predictor bytes, if applicable */
-			if ( byte >= pixel_len )
-				left = *( data - pixel_len );
-			if ( scanline > 0 )
-				above = *( data - scanline_len );
-			if ( ( scanline > 0 ) && ( byte >= pixel_len ) ) {
-				above_left = *( data - scanline_len -
-						pixel_len );
-			}
+		/* Unfilter scanline */
+		filter->unfilter ( data, above, pixel_len,
+				   ( scanline_len - 1 ) );
 
-			/* Unfilter current byte */
-			*data = filter->unfilter ( *data, left, above,
-						   above_left );
-			data++;
-		}
+		/* Record scanline as the row above for the next scanline */
+		above = data;
+		data += ( scanline_len - 1 );
 	}
 
 	/* Update offset */
@@ -676,6 +681,34 @@ static void png_pixels_pass ( struct image *image,
 		interlace->height, interlace->x_indent, interlace->y_indent,
 		interlace->x_stride, interlace->y_stride );
 
+	/* Use fast path for 8-bit true-colour images without alpha,
+	 * for which each pixel is simply three consecutive bytes and
+	 * no fixed-point alpha arithmetic is required.
+	 */
+	if ( ( png->depth == 8 ) && is_rgb && ( ! is_indexed ) &&
+	     ( ! has_alpha ) ) {
+		for ( y = 0 ; y < interlace->height ; y++ ) {
+
+			/* Skip filter byte */
+			data++;
+
+			/* Iterate over each pixel in turn */
+			pixbuf_index = pixbuf_y_index;
+			for ( x = 0 ; x < interlace->width ; x++ ) {
+				pixel = ( ( data[0] << 16 ) | ( data[1] << 8 ) |
+					  data[2] );
+				data += 3;
+				png->pixbuf->data[pixbuf_index] = pixel;
+				pixbuf_index += pixbuf_x_stride;
+			}
+
+			/* Move to next output row */
+			pixbuf_y_index += pixbuf_y_stride;
+		}
+		png->raw.offset = ( ( ( const void * ) data ) - png->raw.data );
+		return;
+	}
+
 	/* Iterate over each scanline in turn */
 	for ( y = 0 ; y < interlace->height ; y++ ) {
 
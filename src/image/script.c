@@ -43,30 +43,73 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <usr/prompt.h>
 #include <ipxe/script.h>
 
-/** Offset within current script
+/** A tokenized script line */
+struct script_line {
+	/** Offset within script (for debugging) */
+	size_t offset;
+	/** Line buffer */
+	char *line;
+	/** Label, or NULL */
+	const char *label;
+	/** Command */
+	const char *command;
+};
+
+/** A tokenized script */
+struct script {
+	/** Lines */
+	struct script_line *lines;
+	/** Number of lines */
+	unsigned int count;
+};
+
+/** Currently-executing script
  *
  * This is a global in order to allow goto_exec() to update the
- * offset.
+ * current line.
+ */
+static struct script *script;
+
+/** Index of next line within currently-executing script
+ *
+ * This is a global in order to allow goto_exec() to update the
+ * current line.
+ */
+static unsigned int script_line;
+
+/**
+ * Free tokenized script
+ *
+ * @v script		Tokenized script
  */
-static size_t script_offset;
+static void script_free ( struct script *script ) {
+	unsigned int i;
+
+	for ( i = 0 ; i < script->count ; i++ )
+		free ( script->lines[i].line );
+	free ( script->lines );
+}
 
 /**
- * Process script lines
+ * Tokenize script
  *
  * @v image		Script
- * @v process_line	Line processor
- * @v terminate		Termination check
+ * @v script		Tokenized script to fill in
  * @ret rc		Return status code
+ *
+ * The script is split once into lines (joining backslash
+ * continuations and stripping any trailing carriage returns), with
+ * each line split into its optional label and its command.  Commands
+ * are not expanded: settings expansion must take place at execution
+ * time, since settings may change between executions of the same
+ * line.
  */
-static int process_script ( struct image *image,
-			    int ( * process_line ) ( struct image *image,
-						     size_t offset,
-						     const char *label,
-						     const char *command ),
-			    int ( * terminate ) ( int rc ) ) {
+static int script_parse ( struct image *image, struct script *script ) {
+	struct script_line *lines;
+	size_t offset = 0;
+	size_t line_offset = 0;
 	size_t len = 0;
 	char *line = NULL;
-	size_t line_offset;
 	char *label;
 	char *command;
 	const void *eol;
@@ -74,19 +117,15 @@ static int process_script ( struct image *image,
 	char *tmp;
 	int rc;
 
-	/* Initialise script and line offsets */
-	script_offset = 0;
-	line_offset = 0;
-
 	do {
 
 		/* Find length of next line, excluding any terminating '\n' */
-		eol = memchr ( ( image->data + script_offset ), '\n',
-			       ( image->len - script_offset ) );
+		eol = memchr ( ( image->data + offset ), '\n',
+			       ( image->len - offset ) );
 		if ( eol ) {
-			frag_len = ( ( eol - image->data ) - script_offset );
+			frag_len = ( ( eol - image->data ) - offset );
 		} else {
-			frag_len = ( image->len - script_offset );
+			frag_len = ( image->len - offset );
 		}
 
 		/* Allocate buffer for line */
@@ -98,12 +137,11 @@ static int process_script ( struct image *image,
 		line = tmp;
 
 		/* Copy line */
-		memcpy ( ( line + len ), ( image->data + script_offset ),
-			 frag_len );
+		memcpy ( ( line + len ), ( image->data + offset ), frag_len );
 		len += frag_len;
 
 		/* Move to next line in script */
-		script_offset += ( frag_len + 1 );
+		offset += ( frag_len + 1 );
 
 		/* Strip trailing CR, if present */
 		if ( len && ( line[ len - 1 ] == '\r' ) )
@@ -133,62 +171,34 @@ static int process_script ( struct image *image,
 			label = NULL;
 		}
 
-		/* Process line */
-		rc = process_line ( image, line_offset, label, command );
-		if ( terminate ( rc ) )
-			goto err_process;
-
-		/* Free line */
-		free ( line );
+		/* Append line to tokenized script */
+		lines = realloc ( script->lines,
+				  ( ( script->count + 1 ) *
+				    sizeof ( script->lines[0] ) ) );
+		if ( ! lines ) {
+			rc = -ENOMEM;
+			goto err_alloc;
+		}
+		script->lines = lines;
+		lines[script->count].offset = line_offset;
+		lines[script->count].line = line;
+		lines[script->count].label = label;
+		lines[script->count].command = command;
+		script->count++;
+		rc = 0;
+
+		/* Relinquish line and update line offset */
 		line = NULL;
 		len = 0;
+		line_offset = offset;
 
-		/* Update line offset */
-		line_offset = script_offset;
-
-	} while ( script_offset < image->len );
+	} while ( offset < image->len );
 
- err_process:
  err_alloc:
 	free ( line );
 	return rc;
 }
 
-/**
- * Terminate script processing on shell exit or command failure
- *
- * @v rc		Line processing status
- * @ret terminate	Terminate script processing
- */
-static int terminate_on_exit_or_failure ( int rc ) {
-
-	return ( shell_stopped ( SHELL_STOP_COMMAND_SEQUENCE ) ||
-		 ( rc != 0 ) );
-}
-
-/**
- * Execute script line
- *
- * @v image		Script
- * @v offset		Offset within script
- * @v label		Label, or NULL
- * @v command		Command
- * @ret rc		Return status code
- */
-static int script_exec_line ( struct image *image, size_t offset,
-			      const char *label __unused,
-			      const char *command ) {
-	int rc;
-
-	DBGC ( image, "[%04zx] $ %s\n", offset, command );
-
-	/* Execute command */
-	if ( ( rc = system ( command ) ) != 0 )
-		return rc;
-
-	return 0;
-}
-
 /**
  * Execute script
  *
@@ -196,19 +206,40 @@ static int script_exec_line ( struct image *image, size_t offset,
  * @ret rc		Return status code
  */
 static int script_exec ( struct image *image ) {
-	size_t saved_offset;
+	struct script parsed = { NULL, 0 };
+	struct script *saved_script;
+	unsigned int saved_line;
+	struct script_line *line;
 	int rc;
 
+	/* Tokenize script, avoiding re-parsing each line on every
+	 * pass through any goto loops within the script.
+	 */
+	if ( ( rc = script_parse ( image, &parsed ) ) != 0 )
+		goto err_parse;
+
 	/* Preserve state of any currently-running script */
-	saved_offset = script_offset;
+	saved_script = script;
+	saved_line = script_line;
+	script = &parsed;
 
 	/* Process script */
-	rc = process_script ( image, script_exec_line,
-			      terminate_on_exit_or_failure );
+	for ( script_line = 0 ; script_line < parsed.count ; ) {
+		line = &parsed.lines[ script_line++ ];
+		DBGC ( image, "[%04zx] $ %s\n", line->offset, line->command );
+		rc = system ( line->command );
+		if ( shell_stopped ( SHELL_STOP_COMMAND_SEQUENCE ) ||
+		     ( rc != 0 ) ) {
+			break;
+		}
+	}
 
 	/* Restore saved state */
-	script_offset = saved_offset;
+	script = saved_script;
+	script_line = saved_line;
 
+	script_free ( &parsed );
+ err_parse:
 	return rc;
 }
 
@@ -264,50 +295,6 @@ static struct option_descriptor goto_opts[] = {};
 static struct command_descriptor goto_cmd =
 	COMMAND_DESC ( struct goto_options, goto_opts, 1, 1, "<label>" );
 
-/**
- * Current "goto" label
- *
- * Valid only during goto_exec().  Consider this part of a closure.
- */
-static const char *goto_label;
-
-/**
- * Check for presence of label
- *
- * @v image		Script
- * @v offset		Offset within script
- * @v label		Label
- * @v command		Command
- * @ret rc		Return status code
- */
-static int goto_find_label ( struct image *image, size_t offset,
-			     const char *label, const char *command __unused ) {
-
-	/* Check label exists */
-	if ( ! label )
-		return -ENOENT;
-
-	/* Check label matches */
-	if ( strcmp ( goto_label, label ) != 0 )
-		return -ENOENT;
-
-	/* Update script offset */
-	script_offset = offset;
-	DBGC ( image, "[%04zx] Gone to :%s\n", offset, label );
-
-	return 0;
-}
-
-/**
- * Terminate script processing when label is found
- *
- * @v rc		Line processing status
- * @ret terminate	Terminate script processing
- */
-static int terminate_on_label_found ( int rc ) {
-	return ( rc == 0 );
-}
-
 /**
  * "goto" command
  *
@@ -318,7 +305,8 @@ static int terminate_on_label_found ( int rc ) {
 static int goto_exec ( int argc, char **argv ) {
 	struct image *image = current_image.image;
 	struct goto_options opts;
-	size_t saved_offset;
+	struct script_line *line;
+	unsigned int i;
 	int rc;
 
 	/* Parse options */
@@ -326,29 +314,31 @@ static int goto_exec ( int argc, char **argv ) {
 		return rc;
 
 	/* Sanity check */
-	if ( ! image ) {
+	if ( ! script ) {
 		rc = -ENOTTY;
 		printf ( "Not in a script: %s\n", strerror ( rc ) );
 		return rc;
 	}
 
-	/* Parse label */
-	goto_label = argv[optind];
+	/* Find label within tokenized script */
+	for ( i = 0 ; i < script->count ; i++ ) {
+		line = &script->lines[i];
+		if ( line->label &&
+		     ( strcmp ( line->label, argv[optind] ) == 0 ) ) {
+			DBGC ( image, "[%04zx] Gone to :%s\n",
+			       line->offset, line->label );
+			script_line = i;
 
-	/* Find label */
-	saved_offset = script_offset;
-	if ( ( rc = process_script ( image, goto_find_label,
-				     terminate_on_label_found ) ) != 0 ) {
-		script_offset = saved_offset;
-		DBGC ( image, "[%04zx] No such label :%s\n",
-		       script_offset, goto_label );
-		return rc;
-	}
+			/* Terminate processing of current command */
+			shell_stop ( SHELL_STOP_COMMAND );
 
-	/* Terminate processing of current command */
-	shell_stop ( SHELL_STOP_COMMAND );
+			return 0;
+		}
+	}
 
-	return 0;
+	rc = -ENOENT;
+	DBGC ( image, "No such label :%s\n", argv[optind] );
+	return rc;
 }
 
 /** "goto" command */
@@ -56,10 +56,17 @@ struct errortab segment_errors[] __errortab = {
  * @v segment		Segment start
  * @v filesz		Size of the "allocated bytes" portion of the segment
  * @v memsz		Size of the segment
+ * @v memmap		Memory map, or NULL to fetch a fresh map
  * @ret rc		Return status code
+ *
+ * Callers preparing multiple segments as part of a single load
+ * operation may fetch the memory map once via get_memmap() and pass
+ * it to each call, avoiding the cost of re-fetching an identical map
+ * from the firmware for every segment.
  */
-int prep_segment ( void *segment, size_t filesz, size_t memsz ) {
-	struct memory_map memmap;
+int prep_segment ( void *segment, size_t filesz, size_t memsz,
+		   struct memory_map *memmap ) {
+	struct memory_map fresh;
 	physaddr_t start = virt_to_phys ( segment );
 	physaddr_t mid = ( start + filesz );
 	physaddr_t end = ( start + memsz );
@@ -73,16 +80,20 @@ int prep_segment ( void *segment, size_t filesz, size_t memsz ) {
 		return -EINVAL;
 	}
 
-	/* Get a fresh memory map.  This allows us to automatically
-	 * avoid treading on any regions that Etherboot is currently
-	 * editing out of the memory map.
+	/* Get a fresh memory map, unless the caller has provided one.
+	 * This allows us to automatically avoid treading on any
+	 * regions that Etherboot is currently editing out of the
+	 * memory map.
 	 */
-	get_memmap ( &memmap );
+	if ( ! memmap ) {
+		get_memmap ( &fresh );
+		memmap = &fresh;
+	}
 
 	/* Look for a suitable memory region */
-	for ( i = 0 ; i < memmap.count ; i++ ) {
-		if ( ( start >= memmap.regions[i].start ) &&
-		     ( end <= memmap.regions[i].end ) ) {
+	for ( i = 0 ; i < memmap->count ; i++ ) {
+		if ( ( start >= memmap->regions[i].start ) &&
+		     ( end <= memmap->regions[i].end ) ) {
 			/* Found valid region: zero bss and return */
 			memset ( ( segment + filesz ), 0, ( memsz - filesz ) );
 			return 0;
@@ -0,0 +1,1426 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <assert.h>
+#include <byteswap.h>
+#include <ipxe/image.h>
+#include <ipxe/zstd.h>
+
+/** @file
+ *
+ * Zstandard compressed images
+ *
+ * This is a self-contained decoder for the Zstandard format (RFC
+ * 8878), sufficient to extract the output of a standard "zstd"
+ * compressor: raw, RLE, and compressed blocks, Huffman-coded literals
+ * (including FSE-compressed weight tables and four-stream encoding),
+ * and FSE-coded sequences with predefined or custom distributions and
+ * repeat offsets.  External dictionaries are not supported, since
+ * boot artifacts are invariably self-contained frames.  The optional
+ * content checksum is skipped rather than verified, as with the CRC
+ * in gzip images: a detached signature is the only integrity
+ * mechanism that we can meaningfully enforce.
+ *
+ * Decompression is a single pass over the downloaded image into the
+ * extracted image, presized from the frame content size header where
+ * present and expanded on demand otherwise.
+ */
+
+/** Maximum Huffman code length */
+#define ZSTD_HUF_LOG_MAX 11
+
+/** Maximum accuracy log for literal length codes */
+#define ZSTD_LL_LOG_MAX 9
+
+/** Maximum accuracy log for offset codes */
+#define ZSTD_OF_LOG_MAX 8
+
+/** Maximum accuracy log for match length codes */
+#define ZSTD_ML_LOG_MAX 9
+
+/** Maximum accuracy log for Huffman weight codes */
+#define ZSTD_WT_LOG_MAX 6
+
+/** Maximum accuracy log for any sequence decoding table */
+#define ZSTD_FSE_LOG_MAX 9
+
+/** Maximum number of symbols in any decoding table */
+#define ZSTD_SYMBOLS_MAX 256
+
+/** Maximum literal length code */
+#define ZSTD_LL_CODE_MAX 35
+
+/** Maximum offset code (constrained by our 32-bit extra bits reads) */
+#define ZSTD_OF_CODE_MAX 31
+
+/** Maximum match length code */
+#define ZSTD_ML_CODE_MAX 52
+
+/** An FSE decoding table entry */
+struct zstd_fse_entry {
+	/** Baseline for next state */
+	uint16_t base;
+	/** Decoded symbol */
+	uint8_t sym;
+	/** Number of bits to read for next state */
+	uint8_t bits;
+};
+
+/** An FSE decoding table */
+struct zstd_fse {
+	/** Table is valid (for "repeat" symbol compression modes) */
+	int valid;
+	/** Accuracy log */
+	unsigned int log;
+	/** Table entries */
+	struct zstd_fse_entry entry[ 1 << ZSTD_FSE_LOG_MAX ];
+};
+
+/** A Huffman decoding table entry */
+struct zstd_huf_entry {
+	/** Decoded symbol */
+	uint8_t sym;
+	/** Code length */
+	uint8_t bits;
+};
+
+/** A Zstandard decompressor */
+struct zstd {
+	/** Extracted image */
+	struct image *extracted;
+	/** Number of bytes written to extracted image */
+	size_t out;
+	/** Literals buffer */
+	uint8_t *lit;
+	/** Length of literals buffer */
+	size_t lit_max;
+	/** Repeat offset history */
+	size_t rep[3];
+	/** Huffman table is valid (for treeless literals blocks) */
+	int huf_valid;
+	/** Huffman table log */
+	unsigned int huf_log;
+	/** Huffman decoding table */
+	struct zstd_huf_entry huf[ 1 << ZSTD_HUF_LOG_MAX ];
+	/** Literal length decoding table */
+	struct zstd_fse ll;
+	/** Offset decoding table */
+	struct zstd_fse of;
+	/** Match length decoding table */
+	struct zstd_fse ml;
+	/** Huffman weight decoding table */
+	struct zstd_fse wt;
+	/** Huffman weights scratch space */
+	uint8_t weights[ZSTD_SYMBOLS_MAX];
+};
+
+/** Literal length code baselines */
+static const uint32_t zstd_ll_base[ ZSTD_LL_CODE_MAX + 1 ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18,
+	20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048,
+	4096, 8192, 16384, 32768, 65536
+};
+
+/** Literal length code extra bits */
+static const uint8_t zstd_ll_bits[ ZSTD_LL_CODE_MAX + 1 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+	2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+};
+
+/** Match length code baselines */
+static const uint32_t zstd_ml_base[ ZSTD_ML_CODE_MAX + 1 ] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+	35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515,
+	1027, 2051, 4099, 8195, 16387, 32771, 65539
+};
+
+/** Match length code extra bits */
+static const uint8_t zstd_ml_bits[ ZSTD_ML_CODE_MAX + 1 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3,
+	4, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+};
+
+/** Predefined literal length code distribution */
+static const int16_t zstd_ll_def[ ZSTD_LL_CODE_MAX + 1 ] = {
+	4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1
+};
+
+/** Predefined literal length accuracy log */
+#define ZSTD_LL_DEF_LOG 6
+
+/** Predefined offset code distribution */
+static const int16_t zstd_of_def[29] = {
+	1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+
+/** Predefined offset accuracy log */
+#define ZSTD_OF_DEF_LOG 5
+
+/** Predefined match length code distribution */
+static const int16_t zstd_ml_def[ ZSTD_ML_CODE_MAX + 1 ] = {
+	1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1
+};
+
+/** Predefined match length accuracy log */
+#define ZSTD_ML_DEF_LOG 6
+
+/** A forward bitstream (used for FSE table descriptions) */
+struct zstd_fbits {
+	/** Data */
+	const uint8_t *data;
+	/** Length of data */
+	size_t len;
+	/** Number of bits consumed */
+	unsigned int pos;
+};
+
+/** A backward bitstream (used for entropy-coded payloads) */
+struct zstd_rbits {
+	/** Data */
+	const uint8_t *data;
+	/** Number of unconsumed bits */
+	int pos;
+};
+
+/**
+ * Read little-endian 32-bit value from potentially unaligned data
+ *
+ * @v data		Data
+ * @ret value		Value
+ */
+static inline uint32_t zstd_le32 ( const uint8_t *data ) {
+	return ( ( ( uint32_t ) data[0] ) | ( ( ( uint32_t ) data[1] ) << 8 ) |
+		 ( ( ( uint32_t ) data[2] ) << 16 ) |
+		 ( ( ( uint32_t ) data[3] ) << 24 ) );
+}
+
+/**
+ * Extract bit field from data
+ *
+ * @v data		Data
+ * @v start		Starting bit index
+ * @v count		Number of bits (up to 32)
+ * @ret value		Value
+ */
+static uint32_t zstd_bits_extract ( const uint8_t *data, unsigned int start,
+				    unsigned int count ) {
+	unsigned int byte = ( start >> 3 );
+	unsigned int shift = ( start & 7 );
+	uint64_t acc = 0;
+	unsigned int i;
+
+	if ( ! count )
+		return 0;
+	for ( i = 0 ; ( i * 8 ) < ( shift + count ) ; i++ )
+		acc |= ( ( ( uint64_t ) data[ byte + i ] ) << ( i * 8 ) );
+	return ( ( acc >> shift ) & ( ( 1ULL << count ) - 1 ) );
+}
+
+/**
+ * Peek at forward bitstream (zero-padded beyond end of data)
+ *
+ * @v bits		Forward bitstream
+ * @v count		Number of bits
+ * @ret value		Value
+ */
+static uint32_t zstd_fbits_peek ( struct zstd_fbits *bits,
+				  unsigned int count ) {
+	unsigned int byte = ( bits->pos >> 3 );
+	unsigned int shift = ( bits->pos & 7 );
+	uint64_t acc = 0;
+	unsigned int i;
+
+	if ( ! count )
+		return 0;
+	for ( i = 0 ; ( i * 8 ) < ( shift + count ) ; i++ ) {
+		if ( ( byte + i ) < bits->len )
+			acc |= ( ( ( uint64_t ) bits->data[ byte + i ] ) <<
+				 ( i * 8 ) );
+	}
+	return ( ( acc >> shift ) & ( ( 1ULL << count ) - 1 ) );
+}
+
+/**
+ * Read from forward bitstream
+ *
+ * @v bits		Forward bitstream
+ * @v count		Number of bits
+ * @ret value		Value
+ */
+static uint32_t zstd_fbits_pull ( struct zstd_fbits *bits,
+				  unsigned int count ) {
+	uint32_t value;
+
+	value = zstd_fbits_peek ( bits, count );
+	bits->pos += count;
+	return value;
+}
+
+/**
+ * Initialise backward bitstream
+ *
+ * @v bits		Backward bitstream
+ * @v data		Data
+ * @v len		Length of data
+ * @ret rc		Return status code
+ *
+ * The final byte must contain the sentinel bit marking the starting
+ * position of the stream.
+ */
+static int zstd_rbits_init ( struct zstd_rbits *bits, const uint8_t *data,
+			     size_t len ) {
+
+	if ( ( len == 0 ) || ( data[ len - 1 ] == 0 ) )
+		return -EINVAL;
+	bits->data = data;
+	bits->pos = ( ( ( len - 1 ) * 8 ) + fls ( data[ len - 1 ] ) - 1 );
+	return 0;
+}
+
+/**
+ * Peek at backward bitstream (zero-padded beyond start of data)
+ *
+ * @v bits		Backward bitstream
+ * @v count		Number of bits
+ * @ret value		Value
+ */
+static uint32_t zstd_rbits_peek ( struct zstd_rbits *bits,
+				  unsigned int count ) {
+	unsigned int avail = bits->pos;
+
+	if ( avail >= count )
+		return zstd_bits_extract ( bits->data, ( bits->pos - count ),
+					   count );
+	return ( zstd_bits_extract ( bits->data, 0, avail ) <<
+		 ( count - avail ) );
+}
+
+/**
+ * Read from backward bitstream
+ *
+ * @v bits		Backward bitstream
+ * @v count		Number of bits
+ * @v value		Value to fill in
+ * @ret rc		Return status code
+ */
+static int zstd_rbits_pull ( struct zstd_rbits *bits, unsigned int count,
+			     uint32_t *value ) {
+
+	if ( bits->pos < ( ( int ) count ) )
+		return -EINVAL;
+	bits->pos -= count;
+	*value = zstd_bits_extract ( bits->data, bits->pos, count );
+	return 0;
+}
+
+/**
+ * Build FSE decoding table from normalised symbol frequencies
+ *
+ * @v fse		FSE decoding table
+ * @v log		Accuracy log
+ * @v counts		Normalised frequencies (-1 for "less than one")
+ * @v num		Number of symbols
+ * @ret rc		Return status code
+ */
+static int zstd_fse_build ( struct zstd_fse *fse, unsigned int log,
+			    const int16_t *counts, unsigned int num ) {
+	unsigned int size = ( 1 << log );
+	unsigned int step = ( ( size >> 1 ) + ( size >> 3 ) + 3 );
+	unsigned int mask = ( size - 1 );
+	unsigned int high = ( size - 1 );
+	unsigned int pos = 0;
+	uint16_t next[ZSTD_SYMBOLS_MAX];
+	unsigned int state;
+	unsigned int bits;
+	unsigned int sym;
+	unsigned int i;
+
+	/* Sanity checks */
+	assert ( log <= ZSTD_FSE_LOG_MAX );
+	assert ( num <= ZSTD_SYMBOLS_MAX );
+
+	/* Place "less than one" probability symbols at end of table */
+	for ( sym = 0 ; sym < num ; sym++ ) {
+		if ( counts[sym] < 0 ) {
+			if ( ! high )
+				return -EINVAL;
+			fse->entry[ high-- ].sym = sym;
+			next[sym] = 1;
+		} else {
+			next[sym] = counts[sym];
+		}
+	}
+
+	/* Spread remaining symbols across table */
+	for ( sym = 0 ; sym < num ; sym++ ) {
+		for ( i = 0 ; ( ( int ) i ) < counts[sym] ; i++ ) {
+			fse->entry[pos].sym = sym;
+			do {
+				pos = ( ( pos + step ) & mask );
+			} while ( pos > high );
+		}
+	}
+	if ( pos != 0 )
+		return -EINVAL;
+
+	/* Assign bit counts and baselines */
+	for ( i = 0 ; i < size ; i++ ) {
+		sym = fse->entry[i].sym;
+		state = next[sym]++;
+		bits = ( log + 1 - fls ( state ) );
+		fse->entry[i].bits = bits;
+		fse->entry[i].base = ( ( state << bits ) - size );
+	}
+
+	fse->log = log;
+	fse->valid = 1;
+	return 0;
+}
+
+/**
+ * Build single-symbol (RLE) FSE decoding table
+ *
+ * @v fse		FSE decoding table
+ * @v sym		Symbol
+ */
+static void zstd_fse_rle ( struct zstd_fse *fse, unsigned int sym ) {
+
+	fse->entry[0].sym = sym;
+	fse->entry[0].bits = 0;
+	fse->entry[0].base = 0;
+	fse->log = 0;
+	fse->valid = 1;
+}
+
+/**
+ * Read FSE table description and build decoding table
+ *
+ * @v fse		FSE decoding table
+ * @v data		Data
+ * @v len		Maximum length of data
+ * @v used		Length of table description to fill in
+ * @v max_log		Maximum permitted accuracy log
+ * @v max_sym		Maximum permitted symbol
+ * @ret rc		Return status code
+ */
+static int zstd_fse_read ( struct zstd_fse *fse, const uint8_t *data,
+			   size_t len, size_t *used, unsigned int max_log,
+			   unsigned int max_sym ) {
+	struct zstd_fbits bits;
+	int16_t counts[ZSTD_SYMBOLS_MAX];
+	unsigned int log;
+	unsigned int threshold;
+	unsigned int nbits;
+	unsigned int repeat;
+	unsigned int low;
+	unsigned int sym = 0;
+	int prev_zero = 0;
+	int remaining;
+	int count;
+
+	/* Initialise bitstream and read accuracy log */
+	bits.data = data;
+	bits.len = len;
+	bits.pos = 0;
+	log = ( zstd_fbits_pull ( &bits, 4 ) + 5 );
+	if ( log > max_log )
+		return -EINVAL;
+
+	/* Read normalised frequencies */
+	memset ( counts, 0, sizeof ( counts ) );
+	remaining = ( ( 1 << log ) + 1 );
+	threshold = ( 1 << log );
+	nbits = ( log + 1 );
+	while ( remaining > 1 ) {
+
+		/* Skip runs of zero-probability symbols */
+		if ( prev_zero ) {
+			do {
+				repeat = zstd_fbits_pull ( &bits, 2 );
+				sym += repeat;
+			} while ( repeat == 3 );
+			prev_zero = 0;
+		}
+		if ( ( sym > max_sym ) || ( sym >= ZSTD_SYMBOLS_MAX ) )
+			return -EINVAL;
+
+		/* Read variable-length probability */
+		low = zstd_fbits_peek ( &bits, ( nbits - 1 ) );
+		if ( low < ( ( 2 * threshold - 1 ) -
+			     ( ( unsigned int ) remaining ) ) ) {
+			count = low;
+			bits.pos += ( nbits - 1 );
+		} else {
+			count = zstd_fbits_pull ( &bits, nbits );
+			if ( count >= ( ( int ) threshold ) ) {
+				count -= ( ( 2 * threshold - 1 ) -
+					   remaining );
+			}
+		}
+		count--;
+		remaining -= ( ( count < 0 ) ? -count : count );
+		counts[ sym++ ] = count;
+		prev_zero = ( count == 0 );
+
+		/* Shrink field width as remaining probability decreases */
+		while ( ( ( int ) threshold ) > remaining ) {
+			nbits--;
+			threshold >>= 1;
+		}
+	}
+	if ( remaining != 1 )
+		return -EINVAL;
+
+	/* Check that description lay within the provided data */
+	*used = ( ( bits.pos + 7 ) / 8 );
+	if ( *used > len )
+		return -EINVAL;
+
+	return zstd_fse_build ( fse, log, counts, sym );
+}
+
+/**
+ * Build Huffman decoding table from code weights
+ *
+ * @v zstd		Zstandard decompressor
+ * @v weights		Explicit weights (with space for one more)
+ * @v num		Number of explicit weights
+ * @ret rc		Return status code
+ *
+ * The final symbol's weight is never transmitted: it is deduced from
+ * the requirement that the weights complete a power of two.
+ */
+static int zstd_huf_build ( struct zstd *zstd, uint8_t *weights,
+			    unsigned int num ) {
+	unsigned int rank[ ZSTD_HUF_LOG_MAX + 1 ];
+	unsigned int total = 0;
+	unsigned int start;
+	unsigned int cells;
+	unsigned int rest;
+	unsigned int log;
+	unsigned int sym;
+	unsigned int w;
+	unsigned int i;
+
+	/* Deduce implicit final weight */
+	if ( num >= ( ZSTD_SYMBOLS_MAX - 1 ) )
+		return -EINVAL;
+	for ( sym = 0 ; sym < num ; sym++ ) {
+		w = weights[sym];
+		if ( w > ZSTD_HUF_LOG_MAX )
+			return -EINVAL;
+		if ( w )
+			total += ( 1 << ( w - 1 ) );
+	}
+	if ( ! total )
+		return -EINVAL;
+	log = fls ( total );
+	if ( log > ZSTD_HUF_LOG_MAX )
+		return -EINVAL;
+	rest = ( ( 1 << log ) - total );
+	if ( ( ! rest ) || ( rest & ( rest - 1 ) ) )
+		return -EINVAL;
+	weights[ num++ ] = fls ( rest );
+
+	/* Calculate starting position for each weight (longest
+	 * codes, i.e. lowest weights, first).
+	 */
+	memset ( rank, 0, sizeof ( rank ) );
+	for ( sym = 0 ; sym < num ; sym++ )
+		rank[ weights[sym] ]++;
+	start = 0;
+	for ( w = 1 ; w <= log ; w++ ) {
+		cells = ( rank[w] << ( w - 1 ) );
+		rank[w] = start;
+		start += cells;
+	}
+	if ( start != ( 1U << log ) )
+		return -EINVAL;
+
+	/* Populate decoding table */
+	for ( sym = 0 ; sym < num ; sym++ ) {
+		w = weights[sym];
+		if ( ! w )
+			continue;
+		cells = ( 1 << ( w - 1 ) );
+		for ( i = 0 ; i < cells ; i++ ) {
+			zstd->huf[ rank[w] + i ].sym = sym;
+			zstd->huf[ rank[w] + i ].bits = ( log + 1 - w );
+		}
+		rank[w] += cells;
+	}
+
+	zstd->huf_log = log;
+	zstd->huf_valid = 1;
+	return 0;
+}
+
+/**
+ * Read Huffman tree description and build decoding table
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Maximum length of data
+ * @v used		Length of tree description to fill in
+ * @ret rc		Return status code
+ */
+static int zstd_huf_read ( struct zstd *zstd, const uint8_t *data,
+			   size_t len, size_t *used ) {
+	struct zstd_fse *wt = &zstd->wt;
+	uint8_t *weights = zstd->weights;
+	struct zstd_rbits bits;
+	struct zstd_fse_entry *entry;
+	unsigned int num;
+	unsigned int hdr;
+	unsigned int i;
+	uint32_t state[2];
+	uint32_t value;
+	size_t wt_len;
+	size_t csize;
+	int rc;
+
+	/* Parse header byte */
+	if ( len < 1 )
+		return -EINVAL;
+	hdr = data[0];
+	data++;
+	len--;
+
+	if ( hdr >= 128 ) {
+
+		/* Direct representation: 4 bits per weight */
+		num = ( hdr - 127 );
+		if ( len < ( ( num + 1 ) / 2 ) )
+			return -EINVAL;
+		for ( i = 0 ; i < num ; i++ ) {
+			weights[i] = ( ( i & 1 ) ? ( data[ i / 2 ] & 0xf ) :
+				       ( data[ i / 2 ] >> 4 ) );
+		}
+		*used = ( 1 + ( ( num + 1 ) / 2 ) );
+
+	} else {
+
+		/* FSE-compressed weights: table description
+		 * followed by a two-state interleaved bitstream.
+		 */
+		csize = hdr;
+		if ( len < csize )
+			return -EINVAL;
+		if ( ( rc = zstd_fse_read ( wt, data, csize, &wt_len,
+					    ZSTD_WT_LOG_MAX,
+					    ( ZSTD_SYMBOLS_MAX - 1 ) ) ) != 0 )
+			return rc;
+		if ( ( rc = zstd_rbits_init ( &bits, ( data + wt_len ),
+					      ( csize - wt_len ) ) ) != 0 )
+			return rc;
+		for ( i = 0 ; i < 2 ; i++ ) {
+			if ( ( rc = zstd_rbits_pull ( &bits, wt->log,
+						      &state[i] ) ) != 0 )
+				return rc;
+		}
+		num = 0;
+		i = 0;
+		while ( 1 ) {
+			if ( num >= ( ZSTD_SYMBOLS_MAX - 1 ) )
+				return -EINVAL;
+			entry = &wt->entry[ state[ i % 2 ] ];
+			weights[ num++ ] = entry->sym;
+			if ( bits.pos < entry->bits ) {
+				/* Stream exhausted: flush other state */
+				if ( num >= ( ZSTD_SYMBOLS_MAX - 1 ) )
+					return -EINVAL;
+				entry = &wt->entry[ state[ ( i + 1 ) % 2 ] ];
+				weights[ num++ ] = entry->sym;
+				break;
+			}
+			zstd_rbits_pull ( &bits, entry->bits, &value );
+			state[ i % 2 ] = ( entry->base + value );
+			i++;
+		}
+		*used = ( 1 + csize );
+	}
+
+	return zstd_huf_build ( zstd, weights, num );
+}
+
+/**
+ * Decode one Huffman-coded literals stream
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Length of data
+ * @v out		Output buffer
+ * @v count		Number of literals to decode
+ * @ret rc		Return status code
+ */
+static int zstd_huf_decode ( struct zstd *zstd, const uint8_t *data,
+			     size_t len, uint8_t *out, size_t count ) {
+	struct zstd_rbits bits;
+	struct zstd_huf_entry *entry;
+	unsigned int idx;
+	int rc;
+
+	if ( ( rc = zstd_rbits_init ( &bits, data, len ) ) != 0 )
+		return rc;
+	while ( count-- ) {
+		idx = zstd_rbits_peek ( &bits, zstd->huf_log );
+		entry = &zstd->huf[idx];
+		if ( bits.pos < entry->bits )
+			return -EINVAL;
+		bits.pos -= entry->bits;
+		*(out++) = entry->sym;
+	}
+	if ( bits.pos != 0 )
+		return -EINVAL;
+	return 0;
+}
+
+/**
+ * Ensure that literals buffer is large enough
+ *
+ * @v zstd		Zstandard decompressor
+ * @v len		Required length
+ * @ret rc		Return status code
+ */
+static int zstd_lit_ensure ( struct zstd *zstd, size_t len ) {
+	uint8_t *new;
+
+	if ( len <= zstd->lit_max )
+		return 0;
+	new = realloc ( zstd->lit, len );
+	if ( ! new )
+		return -ENOMEM;
+	zstd->lit = new;
+	zstd->lit_max = len;
+	return 0;
+}
+
+/**
+ * Ensure that extracted image has space for more data
+ *
+ * @v zstd		Zstandard decompressor
+ * @v extra		Number of additional bytes required
+ * @ret rc		Return status code
+ */
+static int zstd_out_ensure ( struct zstd *zstd, size_t extra ) {
+	struct image *extracted = zstd->extracted;
+	size_t needed = ( zstd->out + extra );
+	size_t new_len;
+	int rc;
+
+	if ( needed <= extracted->len )
+		return 0;
+	new_len = ( extracted->len * 2 );
+	if ( new_len < needed )
+		new_len = needed;
+	if ( ( rc = image_set_len ( extracted, new_len ) ) != 0 )
+		return rc;
+	return 0;
+}
+
+/**
+ * Decode literals section of a compressed block
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Maximum length of data
+ * @v used		Length of literals section to fill in
+ * @v lit		Decoded literals to fill in
+ * @v lit_len		Number of decoded literals to fill in
+ * @ret rc		Return status code
+ */
+static int zstd_literals ( struct zstd *zstd, const uint8_t *data, size_t len,
+			   size_t *used, const uint8_t **lit,
+			   size_t *lit_len ) {
+	unsigned int type;
+	unsigned int sf;
+	unsigned int streams;
+	size_t regen;
+	size_t csize;
+	size_t hlen;
+	size_t part;
+	size_t last;
+	size_t tree_len = 0;
+	size_t stream_len[4];
+	size_t offset;
+	const uint8_t *p;
+	unsigned int i;
+	int rc;
+
+	/* Parse section header */
+	if ( len < 1 )
+		return -EINVAL;
+	type = ( data[0] & 0x3 );
+	sf = ( ( data[0] >> 2 ) & 0x3 );
+	if ( type <= 1 /* Raw or RLE */ ) {
+		if ( ! ( sf & 1 ) ) {
+			regen = ( data[0] >> 3 );
+			hlen = 1;
+		} else if ( sf == 1 ) {
+			if ( len < 2 )
+				return -EINVAL;
+			regen = ( ( data[0] >> 4 ) | ( data[1] << 4 ) );
+			hlen = 2;
+		} else {
+			if ( len < 3 )
+				return -EINVAL;
+			regen = ( ( data[0] >> 4 ) | ( data[1] << 4 ) |
+				  ( data[2] << 12 ) );
+			hlen = 3;
+		}
+		csize = 0;
+		streams = 0;
+	} else {
+		streams = ( ( sf == 0 ) ? 1 : 4 );
+		if ( sf <= 1 ) {
+			if ( len < 3 )
+				return -EINVAL;
+			regen = ( ( data[0] >> 4 ) |
+				  ( ( data[1] & 0x3f ) << 4 ) );
+			csize = ( ( data[1] >> 6 ) | ( data[2] << 2 ) );
+			hlen = 3;
+		} else if ( sf == 2 ) {
+			if ( len < 4 )
+				return -EINVAL;
+			regen = ( ( data[0] >> 4 ) | ( data[1] << 4 ) |
+				  ( ( data[2] & 0x3 ) << 12 ) );
+			csize = ( ( data[2] >> 2 ) | ( data[3] << 6 ) );
+			hlen = 4;
+		} else {
+			if ( len < 5 )
+				return -EINVAL;
+			regen = ( ( data[0] >> 4 ) | ( data[1] << 4 ) |
+				  ( ( data[2] & 0x3f ) << 12 ) );
+			csize = ( ( data[2] >> 6 ) | ( data[3] << 2 ) |
+				  ( data[4] << 10 ) );
+			hlen = 5;
+		}
+	}
+	if ( regen > ZSTD_BLOCK_MAX )
+		return -EINVAL;
+
+	/* Decode literals */
+	switch ( type ) {
+	case 0x0 /* Raw */ :
+		if ( len < ( hlen + regen ) )
+			return -EINVAL;
+		*lit = ( data + hlen );
+		*used = ( hlen + regen );
+		break;
+	case 0x1 /* RLE */ :
+		if ( len < ( hlen + 1 ) )
+			return -EINVAL;
+		if ( ( rc = zstd_lit_ensure ( zstd, regen ) ) != 0 )
+			return rc;
+		memset ( zstd->lit, data[hlen], regen );
+		*lit = zstd->lit;
+		*used = ( hlen + 1 );
+		break;
+	case 0x2 /* Huffman-coded */ :
+	case 0x3 /* Huffman-coded, reusing previous table */ :
+		if ( len < ( hlen + csize ) )
+			return -EINVAL;
+		if ( ( rc = zstd_lit_ensure ( zstd, regen ) ) != 0 )
+			return rc;
+		p = ( data + hlen );
+		if ( type == 0x2 ) {
+			if ( ( rc = zstd_huf_read ( zstd, p, csize,
+						    &tree_len ) ) != 0 )
+				return rc;
+			p += tree_len;
+			csize -= tree_len;
+		} else if ( ! zstd->huf_valid ) {
+			return -EINVAL;
+		}
+		if ( streams == 1 ) {
+			if ( ( rc = zstd_huf_decode ( zstd, p, csize,
+						      zstd->lit,
+						      regen ) ) != 0 )
+				return rc;
+		} else {
+			/* Four streams, preceded by a jump table
+			 * giving the compressed size of the first
+			 * three.
+			 */
+			if ( csize < 6 )
+				return -EINVAL;
+			stream_len[0] = ( p[0] | ( p[1] << 8 ) );
+			stream_len[1] = ( p[2] | ( p[3] << 8 ) );
+			stream_len[2] = ( p[4] | ( p[5] << 8 ) );
+			if ( ( 6 + stream_len[0] + stream_len[1] +
+			       stream_len[2] ) > csize )
+				return -EINVAL;
+			stream_len[3] = ( csize - 6 - stream_len[0] -
+					  stream_len[1] - stream_len[2] );
+			part = ( ( regen + 3 ) / 4 );
+			if ( ( part * 3 ) > regen )
+				return -EINVAL;
+			last = ( regen - ( part * 3 ) );
+			p += 6;
+			offset = 0;
+			for ( i = 0 ; i < 4 ; i++ ) {
+				if ( ( rc = zstd_huf_decode ( zstd, p,
+						stream_len[i],
+						( zstd->lit + offset ),
+						( ( i == 3 ) ? last :
+						  part ) ) ) != 0 )
+					return rc;
+				p += stream_len[i];
+				offset += part;
+			}
+		}
+		*lit = zstd->lit;
+		*used = ( hlen + tree_len + csize );
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	*lit_len = regen;
+	return 0;
+}
+
+/**
+ * Decode and execute sequences section of a compressed block
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Length of data
+ * @v lit		Decoded literals
+ * @v lit_len		Number of decoded literals
+ * @ret rc		Return status code
+ */
+static int zstd_sequences ( struct zstd *zstd, const uint8_t *data,
+			    size_t len, const uint8_t *lit, size_t lit_len ) {
+	struct zstd_fse *fse[3] = { &zstd->ll, &zstd->of, &zstd->ml };
+	static const int16_t * const def[3] =
+		{ zstd_ll_def, zstd_of_def, zstd_ml_def };
+	static const uint8_t def_num[3] = {
+		( sizeof ( zstd_ll_def ) / sizeof ( zstd_ll_def[0] ) ),
+		( sizeof ( zstd_of_def ) / sizeof ( zstd_of_def[0] ) ),
+		( sizeof ( zstd_ml_def ) / sizeof ( zstd_ml_def[0] ) )
+	};
+	static const uint8_t def_log[3] =
+		{ ZSTD_LL_DEF_LOG, ZSTD_OF_DEF_LOG, ZSTD_ML_DEF_LOG };
+	static const uint8_t max_log[3] =
+		{ ZSTD_LL_LOG_MAX, ZSTD_OF_LOG_MAX, ZSTD_ML_LOG_MAX };
+	static const uint8_t max_sym[3] =
+		{ ZSTD_LL_CODE_MAX, ZSTD_OF_CODE_MAX, ZSTD_ML_CODE_MAX };
+	struct zstd_rbits bits;
+	struct zstd_fse_entry *ell;
+	struct zstd_fse_entry *eof;
+	struct zstd_fse_entry *eml;
+	struct image *extracted = zstd->extracted;
+	size_t budget = ZSTD_BLOCK_MAX;
+	unsigned int nbseq;
+	unsigned int modes;
+	unsigned int mode;
+	unsigned int ofcode;
+	unsigned int mlcode;
+	unsigned int llcode;
+	unsigned int idx;
+	unsigned int i;
+	uint32_t state[3];
+	uint32_t value;
+	size_t ofval;
+	size_t offset;
+	size_t llen;
+	size_t mlen;
+	size_t fse_len;
+	uint8_t *dst;
+	const uint8_t *src;
+	int rc;
+
+	/* Parse number of sequences */
+	if ( len < 1 )
+		return -EINVAL;
+	if ( data[0] < 128 ) {
+		nbseq = data[0];
+		data++;
+		len--;
+	} else if ( data[0] < 255 ) {
+		if ( len < 2 )
+			return -EINVAL;
+		nbseq = ( ( ( data[0] - 128 ) << 8 ) + data[1] );
+		data += 2;
+		len -= 2;
+	} else {
+		if ( len < 3 )
+			return -EINVAL;
+		nbseq = ( data[1] + ( data[2] << 8 ) + 0x7f00 );
+		data += 3;
+		len -= 3;
+	}
+
+	/* With no sequences, the block is its literals */
+	if ( ! nbseq ) {
+		if ( lit_len > budget )
+			return -EINVAL;
+		if ( ( rc = zstd_out_ensure ( zstd, lit_len ) ) != 0 )
+			return rc;
+		memcpy ( ( extracted->rwdata + zstd->out ), lit, lit_len );
+		zstd->out += lit_len;
+		return 0;
+	}
+
+	/* Parse symbol compression modes and (re)build decoding tables */
+	if ( len < 1 )
+		return -EINVAL;
+	modes = data[0];
+	if ( modes & 0x3 )
+		return -EINVAL;
+	data++;
+	len--;
+	for ( i = 0 ; i < 3 ; i++ ) {
+		mode = ( ( modes >> ( 6 - ( 2 * i ) ) ) & 0x3 );
+		switch ( mode ) {
+		case 0x0 /* Predefined */ :
+			if ( ( rc = zstd_fse_build ( fse[i], def_log[i],
+						     def[i],
+						     def_num[i] ) ) != 0 )
+				return rc;
+			break;
+		case 0x1 /* RLE */ :
+			if ( len < 1 )
+				return -EINVAL;
+			if ( data[0] > max_sym[i] )
+				return -EINVAL;
+			zstd_fse_rle ( fse[i], data[0] );
+			data++;
+			len--;
+			break;
+		case 0x2 /* FSE-compressed */ :
+			if ( ( rc = zstd_fse_read ( fse[i], data, len,
+						    &fse_len, max_log[i],
+						    max_sym[i] ) ) != 0 )
+				return rc;
+			data += fse_len;
+			len -= fse_len;
+			break;
+		case 0x3 /* Repeat */ :
+			if ( ! fse[i]->valid )
+				return -EINVAL;
+			break;
+		}
+	}
+
+	/* Initialise bitstream and decoding states */
+	if ( ( rc = zstd_rbits_init ( &bits, data, len ) ) != 0 )
+		return rc;
+	if ( ( rc = zstd_rbits_pull ( &bits, zstd->ll.log,
+				      &state[0] ) ) != 0 )
+		return rc;
+	if ( ( rc = zstd_rbits_pull ( &bits, zstd->of.log,
+				      &state[1] ) ) != 0 )
+		return rc;
+	if ( ( rc = zstd_rbits_pull ( &bits, zstd->ml.log,
+				      &state[2] ) ) != 0 )
+		return rc;
+
+	/* Decode and execute sequences */
+	for ( i = 0 ; i < nbseq ; i++ ) {
+
+		/* Decode sequence */
+		ell = &zstd->ll.entry[ state[0] ];
+		eof = &zstd->of.entry[ state[1] ];
+		eml = &zstd->ml.entry[ state[2] ];
+		llcode = ell->sym;
+		ofcode = eof->sym;
+		mlcode = eml->sym;
+		if ( ( llcode > ZSTD_LL_CODE_MAX ) ||
+		     ( ofcode > ZSTD_OF_CODE_MAX ) ||
+		     ( mlcode > ZSTD_ML_CODE_MAX ) )
+			return -EINVAL;
+		if ( ( rc = zstd_rbits_pull ( &bits, ofcode, &value ) ) != 0 )
+			return rc;
+		ofval = ( ( ( ( size_t ) 1 ) << ofcode ) + value );
+		if ( ( rc = zstd_rbits_pull ( &bits, zstd_ml_bits[mlcode],
+					      &value ) ) != 0 )
+			return rc;
+		mlen = ( zstd_ml_base[mlcode] + value );
+		if ( ( rc = zstd_rbits_pull ( &bits, zstd_ll_bits[llcode],
+					      &value ) ) != 0 )
+			return rc;
+		llen = ( zstd_ll_base[llcode] + value );
+
+		/* Resolve offset against repeat offset history */
+		if ( ofval > 3 ) {
+			offset = ( ofval - 3 );
+			zstd->rep[2] = zstd->rep[1];
+			zstd->rep[1] = zstd->rep[0];
+			zstd->rep[0] = offset;
+		} else {
+			idx = ( ofval - 1 + ( ( llen == 0 ) ? 1 : 0 ) );
+			if ( idx == 0 ) {
+				offset = zstd->rep[0];
+			} else if ( idx == 1 ) {
+				offset = zstd->rep[1];
+				zstd->rep[1] = zstd->rep[0];
+				zstd->rep[0] = offset;
+			} else {
+				offset = ( ( idx == 2 ) ? zstd->rep[2] :
+					   ( zstd->rep[0] - 1 ) );
+				zstd->rep[2] = zstd->rep[1];
+				zstd->rep[1] = zstd->rep[0];
+				zstd->rep[0] = offset;
+			}
+		}
+
+		/* Update decoding states (except after the final sequence) */
+		if ( ( i + 1 ) < nbseq ) {
+			if ( ( rc = zstd_rbits_pull ( &bits, ell->bits,
+						      &value ) ) != 0 )
+				return rc;
+			state[0] = ( ell->base + value );
+			if ( ( rc = zstd_rbits_pull ( &bits, eml->bits,
+						      &value ) ) != 0 )
+				return rc;
+			state[2] = ( eml->base + value );
+			if ( ( rc = zstd_rbits_pull ( &bits, eof->bits,
+						      &value ) ) != 0 )
+				return rc;
+			state[1] = ( eof->base + value );
+		}
+
+		/* Execute sequence */
+		if ( llen > lit_len )
+			return -EINVAL;
+		if ( ( llen + mlen ) > budget )
+			return -EINVAL;
+		budget -= ( llen + mlen );
+		if ( ( rc = zstd_out_ensure ( zstd, ( llen + mlen ) ) ) != 0 )
+			return rc;
+		memcpy ( ( extracted->rwdata + zstd->out ), lit, llen );
+		zstd->out += llen;
+		lit += llen;
+		lit_len -= llen;
+		if ( mlen ) {
+			if ( ( offset == 0 ) || ( offset > zstd->out ) )
+				return -EINVAL;
+			dst = ( extracted->rwdata + zstd->out );
+			src = ( dst - offset );
+			zstd->out += mlen;
+			while ( mlen-- )
+				*(dst++) = *(src++);
+		}
+	}
+	if ( bits.pos != 0 )
+		return -EINVAL;
+
+	/* Copy any remaining literals */
+	if ( lit_len > budget )
+		return -EINVAL;
+	if ( ( rc = zstd_out_ensure ( zstd, lit_len ) ) != 0 )
+		return rc;
+	memcpy ( ( extracted->rwdata + zstd->out ), lit, lit_len );
+	zstd->out += lit_len;
+
+	return 0;
+}
+
+/**
+ * Decode a compressed block
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Length of data
+ * @ret rc		Return status code
+ */
+static int zstd_block ( struct zstd *zstd, const uint8_t *data, size_t len ) {
+	const uint8_t *lit;
+	size_t lit_len;
+	size_t used;
+	int rc;
+
+	if ( ( rc = zstd_literals ( zstd, data, len, &used, &lit,
+				    &lit_len ) ) != 0 )
+		return rc;
+	return zstd_sequences ( zstd, ( data + used ), ( len - used ),
+				lit, lit_len );
+}
+
+/**
+ * Decode a single frame
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data (starting after the magic number)
+ * @v len		Maximum length of data
+ * @v used		Length of frame to fill in
+ * @ret rc		Return status code
+ */
+static int zstd_frame ( struct zstd *zstd, const uint8_t *data, size_t len,
+			size_t *used ) {
+	static const uint8_t did_len[4] = { 0, 1, 2, 4 };
+	struct image *extracted = zstd->extracted;
+	unsigned int desc;
+	unsigned int fcs_code;
+	unsigned int last;
+	unsigned int type;
+	uint64_t fcs;
+	uint32_t did;
+	uint32_t hdr;
+	size_t bsize;
+	size_t pos = 0;
+	unsigned int i;
+	int rc;
+
+	/* Parse frame header descriptor */
+	if ( len < 1 )
+		return -EINVAL;
+	desc = data[ pos++ ];
+	if ( desc & ZSTD_FHD_RESERVED )
+		return -ENOTSUP;
+
+	/* Skip window descriptor: the whole history is always
+	 * available, since we decompress into the final buffer.
+	 */
+	if ( ! ( desc & ZSTD_FHD_SINGLE ) ) {
+		if ( len < ( pos + 1 ) )
+			return -EINVAL;
+		pos++;
+	}
+
+	/* Refuse frames requiring an external dictionary */
+	if ( ZSTD_FHD_DID ( desc ) ) {
+		if ( len < ( pos + did_len[ ZSTD_FHD_DID ( desc ) ] ) )
+			return -EINVAL;
+		did = 0;
+		for ( i = 0 ; i < did_len[ ZSTD_FHD_DID ( desc ) ] ; i++ )
+			did |= ( ( ( uint32_t ) data[ pos++ ] ) << ( i * 8 ) );
+		if ( did ) {
+			DBGC ( zstd, "ZSTD %p unsupported dictionary %#08x\n",
+			       zstd, did );
+			return -ENOTSUP;
+		}
+	}
+
+	/* Parse frame content size (if present) and presize output */
+	fcs_code = ZSTD_FHD_FCS ( desc );
+	if ( fcs_code || ( desc & ZSTD_FHD_SINGLE ) ) {
+		static const uint8_t fcs_len[4] = { 1, 2, 4, 8 };
+		if ( len < ( pos + fcs_len[fcs_code] ) )
+			return -EINVAL;
+		fcs = 0;
+		for ( i = 0 ; i < fcs_len[fcs_code] ; i++ )
+			fcs |= ( ( ( uint64_t ) data[ pos++ ] ) << ( i * 8 ) );
+		if ( fcs_code == 1 )
+			fcs += 256;
+		if ( fcs != ( ( size_t ) fcs ) )
+			return -ENOTSUP;
+		if ( ( rc = zstd_out_ensure ( zstd, fcs ) ) != 0 )
+			return rc;
+	}
+
+	/* Reset per-frame entropy state */
+	zstd->huf_valid = 0;
+	zstd->ll.valid = 0;
+	zstd->of.valid = 0;
+	zstd->ml.valid = 0;
+	zstd->rep[0] = 1;
+	zstd->rep[1] = 4;
+	zstd->rep[2] = 8;
+
+	/* Decode blocks */
+	do {
+		if ( len < ( pos + 3 ) )
+			return -EINVAL;
+		hdr = ( data[pos] | ( data[ pos + 1 ] << 8 ) |
+			( data[ pos + 2 ] << 16 ) );
+		pos += 3;
+		last = ( hdr & 0x1 );
+		type = ( ( hdr >> 1 ) & 0x3 );
+		bsize = ( hdr >> 3 );
+		switch ( type ) {
+		case 0x0 /* Raw */ :
+			if ( ( bsize > ZSTD_BLOCK_MAX ) ||
+			     ( len < ( pos + bsize ) ) )
+				return -EINVAL;
+			if ( ( rc = zstd_out_ensure ( zstd, bsize ) ) != 0 )
+				return rc;
+			memcpy ( ( extracted->rwdata + zstd->out ),
+				 ( data + pos ), bsize );
+			zstd->out += bsize;
+			pos += bsize;
+			break;
+		case 0x1 /* RLE */ :
+			if ( ( bsize > ZSTD_BLOCK_MAX ) ||
+			     ( len < ( pos + 1 ) ) )
+				return -EINVAL;
+			if ( ( rc = zstd_out_ensure ( zstd, bsize ) ) != 0 )
+				return rc;
+			memset ( ( extracted->rwdata + zstd->out ),
+				 data[pos], bsize );
+			zstd->out += bsize;
+			pos++;
+			break;
+		case 0x2 /* Compressed */ :
+			if ( len < ( pos + bsize ) )
+				return -EINVAL;
+			if ( ( rc = zstd_block ( zstd, ( data + pos ),
+						 bsize ) ) != 0 )
+				return rc;
+			pos += bsize;
+			break;
+		default:
+			return -EINVAL;
+		}
+	} while ( ! last );
+
+	/* Skip content checksum, if present (not verified, as with
+	 * the CRC in gzip images).
+	 */
+	if ( desc & ZSTD_FHD_CHECKSUM ) {
+		if ( len < ( pos + 4 ) )
+			return -EINVAL;
+		pos += 4;
+	}
+
+	*used = pos;
+	return 0;
+}
+
+/**
+ * Decompress Zstandard data
+ *
+ * @v zstd		Zstandard decompressor
+ * @v data		Data
+ * @v len		Length of data
+ * @ret rc		Return status code
+ */
+static int zstd_decompress ( struct zstd *zstd, const uint8_t *data,
+			     size_t len ) {
+	uint32_t magic;
+	size_t used;
+	size_t skip;
+	int rc;
+
+	/* Decode all frames */
+	while ( len ) {
+		if ( len < sizeof ( magic ) )
+			return -EINVAL;
+		magic = zstd_le32 ( data );
+		data += sizeof ( magic );
+		len -= sizeof ( magic );
+		if ( ( magic & ZSTD_MAGIC_SKIP_MASK ) == ZSTD_MAGIC_SKIP ) {
+			if ( len < sizeof ( uint32_t ) )
+				return -EINVAL;
+			skip = zstd_le32 ( data );
+			if ( ( sizeof ( uint32_t ) + skip ) > len )
+				return -EINVAL;
+			used = ( sizeof ( uint32_t ) + skip );
+		} else if ( magic == ZSTD_MAGIC ) {
+			if ( ( rc = zstd_frame ( zstd, data, len,
+						 &used ) ) != 0 )
+				return rc;
+		} else {
+			return -EINVAL;
+		}
+		data += used;
+		len -= used;
+	}
+
+	/* Trim extracted image to its actual length */
+	if ( ( rc = image_set_len ( zstd->extracted, zstd->out ) ) != 0 )
+		return rc;
+
+	return 0;
+}
+
+/**
+ * Extract Zstandard image
+ *
+ * @v image		Image
+ * @v extracted		Extracted image
+ * @ret rc		Return status code
+ */
+static int zstd_extract ( struct image *image, struct image *extracted ) {
+	struct zstd *zstd;
+	int rc;
+
+	/* Allocate and initialise decompressor */
+	zstd = zalloc ( sizeof ( *zstd ) );
+	if ( ! zstd ) {
+		rc = -ENOMEM;
+		goto err_alloc;
+	}
+	zstd->extracted = extracted;
+
+	/* Decompress image */
+	if ( ( rc = zstd_decompress ( zstd, image->data,
+				      image->len ) ) != 0 ) {
+		DBGC ( image, "ZSTD %p could not decompress: %s\n",
+		       image, strerror ( rc ) );
+		goto err_decompress;
+	}
+
+ err_decompress:
+	free ( zstd->lit );
+	free ( zstd );
+ err_alloc:
+	return rc;
+}
+
+/**
+ * Probe Zstandard image
+ *
+ * @v image		Zstandard image
+ * @ret rc		Return status code
+ */
+static int zstd_probe ( struct image *image ) {
+	const struct zstd_frame_descriptor *desc;
+
+	/* Sanity check */
+	if ( image->len < sizeof ( *desc ) ) {
+		DBGC ( image, "ZSTD %p image too short\n", image );
+		return -ENOEXEC;
+	}
+	desc = image->data;
+
+	/* Check magic number */
+	if ( desc->magic != cpu_to_le32 ( ZSTD_MAGIC ) ) {
+		DBGC ( image, "ZSTD %p invalid magic\n", image );
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+/** Zstandard image type */
+struct image_type zstd_image_type __image_type ( PROBE_NORMAL ) = {
+	.name = "zstd",
+	.probe = zstd_probe,
+	.extract = zstd_extract,
+	.exec = image_extract_exec,
+};
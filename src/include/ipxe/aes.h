@@ -39,11 +39,19 @@ struct aes_context {
 	struct aes_round_keys decrypt;
 	/** Number of rounds */
 	unsigned int rounds;
+	/** Use hardware-accelerated implementation */
+	int accel;
 };
 
 /** AES context size */
 #define AES_CTX_SIZE sizeof ( struct aes_context )
 
+extern int aes_accel_supported ( void );
+extern void aes_accel_encrypt ( struct aes_context *aes, const void *src,
+				void *dst );
+extern void aes_accel_decrypt ( struct aes_context *aes, const void *src,
+				void *dst );
+
 extern struct cipher_algorithm aes_algorithm;
 extern struct cipher_algorithm aes_ecb_algorithm;
 extern struct cipher_algorithm aes_cbc_algorithm;
@@ -108,9 +108,6 @@ struct aoehdr {
 /** AoE tag magic marker */
 #define AOE_TAG_MAGIC 0x18ae0000
 
-/** Maximum number of sectors per packet */
-#define AOE_MAX_COUNT 2
-
 /** An AoE device */
 struct aoe_device {
 	/** Reference counter */
@@ -127,6 +124,8 @@ struct aoe_device {
 	uint8_t minor;
 	/** Target MAC address */
 	uint8_t target[MAX_LL_ADDR_LEN];
+	/** Maximum number of sectors per command */
+	unsigned int max_count;
 
 	/** Saved timeout value */
 	unsigned long timeout;
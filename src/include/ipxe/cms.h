@@ -43,6 +43,8 @@ struct cms_participant {
 
 	/** Digest algorithm (for signature messages) */
 	struct digest_algorithm *digest;
+	/** Incremental digest context (if any) */
+	void *ctx;
 	/** Public-key algorithm */
 	struct pubkey_algorithm *pubkey;
 
@@ -63,6 +65,8 @@ struct cms_message {
 	struct x509_chain *certificates;
 	/** List of participant information blocks */
 	struct list_head participants;
+	/** Length of incrementally digested data */
+	size_t digested;
 
 	/** Cipher algorithm */
 	struct cipher_algorithm *cipher;
@@ -121,6 +125,9 @@ cms_is_encrypted ( struct cms_message *cms ) {
 }
 
 extern int cms_message ( struct image *image, struct cms_message **cms );
+extern int cms_digest_init ( struct cms_message *cms );
+extern void cms_digest_update ( struct cms_message *cms, const void *data,
+				size_t len );
 extern int cms_verify ( struct cms_message *cms, struct image *image,
 			const char *name, time_t time, struct x509_chain *store,
 			struct x509_root *root );
@@ -89,5 +89,6 @@ cpio_pad_len ( size_t len ) {
 
 extern size_t cpio_header ( struct image *image, unsigned int index,
 			    struct cpio_header *cpio );
+extern size_t cpio_headers_len ( struct image *image );
 
 #endif /* _IPXE_CPIO_H */
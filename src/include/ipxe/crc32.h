@@ -6,5 +6,9 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdint.h>
 
 u32 crc32_le ( u32 seed, const void *data, size_t len );
+u32 crc32c_le ( u32 seed, const void *data, size_t len );
+
+extern int crc32c_accel_supported ( void );
+extern u32 crc32c_accel ( u32 seed, const void *data, size_t len );
 
 #endif
@@ -73,13 +73,23 @@ enum deflate_format {
 
 /** Quick lookup length for a Huffman symbol (in bits)
  *
- * This is a policy decision.
+ * This is a policy decision.  A longer lookup allows more symbols to
+ * be decoded directly via a single table lookup, at the cost of a
+ * larger table.  Nine bits covers all symbols in the static Huffman
+ * alphabets and the vast majority of symbols in typical dynamic
+ * Huffman alphabets.
  */
-#define DEFLATE_HUFFMAN_QL_BITS 7
+#define DEFLATE_HUFFMAN_QL_BITS 9
 
 /** Quick lookup shift */
 #define DEFLATE_HUFFMAN_QL_SHIFT ( 16 - DEFLATE_HUFFMAN_QL_BITS )
 
+/** Quick lookup symbol length mask */
+#define DEFLATE_HUFFMAN_QL_LEN_MASK 0x0f
+
+/** Quick lookup raw symbol shift */
+#define DEFLATE_HUFFMAN_QL_RAW_SHIFT 4
+
 /** Literal/length end of block code */
 #define DEFLATE_LITLEN_END 256
 
@@ -133,8 +143,16 @@ struct deflate_huf_symbols {
 struct deflate_alphabet {
 	/** Huffman-coded symbol set for each length */
 	struct deflate_huf_symbols huf[DEFLATE_HUFFMAN_BITS];
-	/** Quick lookup table */
-	uint8_t lookup[ 1 << DEFLATE_HUFFMAN_QL_BITS ];
+	/** Quick lookup table
+	 *
+	 * Entries for symbols no longer than the quick lookup length
+	 * hold the raw symbol (shifted left by @c
+	 * DEFLATE_HUFFMAN_QL_RAW_SHIFT) and the symbol length,
+	 * allowing such symbols to be decoded directly.  Entries for
+	 * longer symbols hold a zero length and the index of the
+	 * Huffman-coded symbol set at which to start searching.
+	 */
+	uint16_t lookup[ 1 << DEFLATE_HUFFMAN_QL_BITS ];
 	/** Raw symbols
 	 *
 	 * Ordered by Huffman-coded symbol length, then by symbol
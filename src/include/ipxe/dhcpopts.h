@@ -11,6 +11,22 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <stdint.h>
 
+/** Number of indexed option locations
+ *
+ * Typical DHCP responses carry twenty to thirty options; a larger
+ * block simply degrades gracefully to a linear scan for options
+ * beyond the indexed portion.
+ */
+#define DHCPOPT_INDEX_COUNT 32
+
+/** An indexed DHCP option location */
+struct dhcp_option_index {
+	/** Option tag */
+	uint8_t tag;
+	/** Option offset within block */
+	uint16_t offset;
+} __attribute__ (( packed ));
+
 /** A DHCP options block */
 struct dhcp_options {
 	/** Option block raw data */
@@ -19,6 +35,19 @@ struct dhcp_options {
 	size_t used_len;
 	/** Option block allocated length */
 	size_t alloc_len;
+	/** Top-level option location index
+	 *
+	 * Built lazily on first lookup and discarded whenever the
+	 * block layout changes, so that repeated fetches (e.g. via
+	 * settings expansion) do not re-scan the raw option bytes.
+	 */
+	struct dhcp_option_index index[DHCPOPT_INDEX_COUNT];
+	/** Number of valid index entries */
+	unsigned int index_len;
+	/** Index has been built */
+	uint8_t indexed;
+	/** Index covers all options in the block */
+	uint8_t index_complete;
 	/** Reallocate option block raw data
 	 *
 	 * @v options		DHCP option block
@@ -9,9 +9,29 @@
 
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
+#include <stdint.h>
+
 struct interface;
 struct image;
 
+/** Metrics for the most recently completed download
+ *
+ * These are exposed to scripts as built-in settings, so that boot
+ * policy can branch on measured network quality.
+ */
+struct downloader_metrics {
+	/** A download has completed successfully */
+	int valid;
+	/** Downloaded length (in bytes) */
+	size_t len;
+	/** Elapsed time (in ticks) */
+	unsigned long elapsed;
+	/** Number of restarts (e.g. redirections) */
+	unsigned int restarts;
+};
+
+extern struct downloader_metrics downloader_metrics;
+
 extern int create_downloader ( struct interface *job, struct image *image );
 
 #endif /* _IPXE_DOWNLOADER_H */
@@ -26,6 +26,13 @@ FILE_LICENCE ( GPL2_OR_LATER );
  * iPXE Download Protocol
  *
  * EFI applications started by iPXE may use this interface to download files.
+ *
+ * The protocol is fully asynchronous: any number of downloads may be
+ * in progress concurrently, each identified by its own file token and
+ * delivering data through its own callbacks.  Consumers fetching
+ * several files (such as a boot image and its auxiliary files) should
+ * start them all before polling, rather than downloading serially;
+ * iPXE will multiplex the transfers over its network stack.
  */
 
 typedef struct _IPXE_DOWNLOAD_PROTOCOL IPXE_DOWNLOAD_PROTOCOL;
@@ -84,6 +91,10 @@ void
  * Start downloading a file, and register callback functions to handle the
  * download.
  *
+ * This function may be called again before any previously started
+ * download has finished; all downloads in progress proceed in
+ * parallel and are driven by the same Poll function.
+ *
  * @v This		iPXE Download Protocol instance
  * @v Url		URL to download from
  * @v DataCallback	Callback that will be invoked when data arrives
@@ -125,6 +136,8 @@ EFI_STATUS
  * Poll for more data from iPXE. This function will invoke the registered
  * callbacks if data is available or if downloads complete.
  *
+ * A single call polls every download currently in progress.
+ *
  * @v This		iPXE Download Protocol instance
  * @ret Status		EFI status code
  */
@@ -19,10 +19,14 @@ typedef Elf32_Phdr	Elf_Phdr;
 typedef Elf32_Off	Elf_Off;
 #define ELFCLASS	ELFCLASS32
 
+struct memory_map;
+
 extern int elf_segments ( struct image *image, const Elf_Ehdr *ehdr,
 			  int ( * process ) ( struct image *image,
 					      const Elf_Phdr *phdr,
-					      physaddr_t dest ),
+					      physaddr_t dest,
+					      struct memory_map *memmap ),
+			  struct memory_map *memmap,
 			  physaddr_t *entry, physaddr_t *max );
 extern int elf_load ( struct image *image, physaddr_t *entry, physaddr_t *max );
 
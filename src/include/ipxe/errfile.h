@@ -86,6 +86,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define ERRFILE_null_smbios	       ( ERRFILE_CORE | 0x002e0000 )
 #define ERRFILE_efi_open	       ( ERRFILE_CORE | 0x002f0000 )
 #define ERRFILE_efi_table	       ( ERRFILE_CORE | 0x00300000 )
+#define ERRFILE_netbench	       ( ERRFILE_CORE | 0x00310000 )
 
 #define ERRFILE_eisa		     ( ERRFILE_DRIVER | 0x00000000 )
 #define ERRFILE_isa		     ( ERRFILE_DRIVER | 0x00010000 )
@@ -233,6 +234,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define ERRFILE_atl2_hw		     ( ERRFILE_DRIVER | 0x00d90000 )
 #define ERRFILE_devtree		     ( ERRFILE_DRIVER | 0x00da0000 )
 #define ERRFILE_cgem		     ( ERRFILE_DRIVER | 0x00db0000 )
+#define ERRFILE_nvme		     ( ERRFILE_DRIVER | 0x00dc0000 )
 
 #define ERRFILE_aoe			( ERRFILE_NET | 0x00000000 )
 #define ERRFILE_arp			( ERRFILE_NET | 0x00010000 )
@@ -313,6 +315,10 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define ERRFILE_lldp			( ERRFILE_NET | 0x004c0000 )
 #define ERRFILE_eap_md5			( ERRFILE_NET | 0x004d0000 )
 #define ERRFILE_eap_mschapv2		( ERRFILE_NET | 0x004e0000 )
+#define ERRFILE_httpmux			( ERRFILE_NET | 0x004f0000 )
+#define ERRFILE_httpgzip		( ERRFILE_NET | 0x00500000 )
+#define ERRFILE_fragment		( ERRFILE_NET | 0x00510000 )
+#define ERRFILE_nvmetcp			( ERRFILE_NET | 0x00520000 )
 
 #define ERRFILE_image		      ( ERRFILE_IMAGE | 0x00000000 )
 #define ERRFILE_elf		      ( ERRFILE_IMAGE | 0x00010000 )
@@ -328,6 +334,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define ERRFILE_zlib		      ( ERRFILE_IMAGE | 0x000b0000 )
 #define ERRFILE_gzip		      ( ERRFILE_IMAGE | 0x000c0000 )
 #define ERRFILE_efi_siglist	      ( ERRFILE_IMAGE | 0x000d0000 )
+#define ERRFILE_zstd		      ( ERRFILE_IMAGE | 0x000e0000 )
 
 #define ERRFILE_asn1		      ( ERRFILE_OTHER | 0x00000000 )
 #define ERRFILE_chap		      ( ERRFILE_OTHER | 0x00010000 )
@@ -433,6 +440,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define ERRFILE_usb_settings	      ( ERRFILE_OTHER | 0x00650000 )
 #define ERRFILE_weierstrass	      ( ERRFILE_OTHER | 0x00660000 )
 #define ERRFILE_efi_cacert	      ( ERRFILE_OTHER | 0x00670000 )
+#define ERRFILE_xferbuf_test	      ( ERRFILE_OTHER | 0x00680000 )
 
 /** @} */
 
@@ -84,6 +84,28 @@ struct fdt_reservation {
 	uint64_t size;
 } __attribute__ (( packed ));
 
+/** Number of cached path lookups */
+#define FDT_PATH_CACHE_COUNT 4
+
+/** Maximum length of a cached path lookup */
+#define FDT_PATH_CACHE_LEN 64
+
+/** A cached device tree path lookup
+ *
+ * Path resolution walks the flattened token stream, which becomes
+ * expensive when the same paths (such as the boot hart node) are
+ * resolved repeatedly against a large tree during driver probing.
+ * Successful lookups are therefore cached.  Entries remain valid
+ * until space is inserted into the tree, since that is the only
+ * operation that changes existing node offsets.
+ */
+struct fdt_path_cache {
+	/** Path (empty if entry is unused) */
+	char path[FDT_PATH_CACHE_LEN];
+	/** Node offset within structure block */
+	unsigned int offset;
+};
+
 /** A device tree */
 struct fdt {
 	/** Tree data */
@@ -107,6 +129,10 @@ struct fdt {
 	size_t strings_len;
 	/** Offset to memory reservation block */
 	unsigned int reservations;
+	/** Path lookup cache */
+	struct fdt_path_cache cache[FDT_PATH_CACHE_COUNT];
+	/** Next path lookup cache entry to evict */
+	unsigned int cache_evict;
 	/** Reallocate device tree
 	 *
 	 * @v fdt		Device tree
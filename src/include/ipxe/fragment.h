@@ -12,29 +12,48 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdint.h>
 #include <ipxe/list.h>
 #include <ipxe/iobuf.h>
-#include <ipxe/retry.h>
 
 /** Fragment reassembly timeout */
 #define FRAGMENT_TIMEOUT ( TICKS_PER_SEC / 2 )
 
+/** Number of fragment reassembly hash buckets */
+#define FRAGMENT_BUCKETS 8
+
 /** A fragment reassembly buffer */
 struct fragment {
-	/* List of fragment reassembly buffers */
+	/* List of fragment reassembly buffers within this hash bucket */
 	struct list_head list;
+	/** List of fragment reassembly buffers in order of expiry */
+	struct list_head expiry;
+	/** Expiry time (in ticks) */
+	unsigned long expires;
+	/** Hash of fragmented packet identity */
+	unsigned int hash;
 	/** Reassembled packet */
 	struct io_buffer *iobuf;
 	/** Length of non-fragmentable portion of reassembled packet */
 	size_t hdrlen;
-	/** Reassembly timer */
-	struct retry_timer timer;
+	/** Length of fragmentable portion, or zero if not yet known */
+	size_t total;
+	/** List of as yet unfilled holes, in order of increasing offset */
+	struct list_head holes;
 	/** Fragment reassembler */
 	struct fragment_reassembler *fragments;
 };
 
 /** A fragment reassembler */
 struct fragment_reassembler {
-	/** List of fragment reassembly buffers */
-	struct list_head list;
+	/** Hash buckets of fragment reassembly buffers */
+	struct list_head buckets[FRAGMENT_BUCKETS];
+	/**
+	 * Calculate hash of fragmented packet identity
+	 *
+	 * @v iobuf		I/O buffer
+	 * @v hdrlen		Length of non-fragmentable potion of I/O buffer
+	 * @ret hash		Hash value
+	 */
+	unsigned int ( * fragment_hash ) ( struct io_buffer *iobuf,
+					   size_t hdrlen );
 	/**
 	 * Check if fragment matches fragment reassembly buffer
 	 *
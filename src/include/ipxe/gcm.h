@@ -36,6 +36,8 @@ union gcm_block {
 	uint16_t word[8];
 	/** Raw dwords */
 	uint32_t dword[4];
+	/** Raw qwords */
+	uint64_t qword[2];
 	/** Counter */
 	struct gcm_counter ctr;
 	/** Lengths */
@@ -58,6 +60,9 @@ struct gcm_context {
 	uint8_t raw_ctx[0];
 };
 
+extern int gcm_accel_supported ( void );
+extern void gcm_accel_multiply ( const union gcm_block *key,
+				 union gcm_block *poly );
 extern void gcm_tag ( struct gcm_context *context, union gcm_block *tag );
 extern int gcm_setkey ( struct gcm_context *context, const void *key,
 			size_t keylen, struct cipher_algorithm *raw_cipher );
@@ -10,12 +10,19 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <ipxe/crypto.h>
 
-/** HMAC context type */
+/** HMAC context type
+ *
+ * The inner and outer digest contexts are both keyed by hmac_init().
+ * A context that has been initialised (but not yet finalised) is
+ * self-contained, and may be copied with memcpy() to avoid repeating
+ * the key padding computation when multiple HMACs are calculated
+ * using the same key.
+ */
 #define hmac_context_t( digest ) struct {				\
-		/** Digest context */					\
+		/** Inner digest context */				\
 		uint8_t ctx[ digest->ctxsize ];				\
-		/** HMAC input/output padding */			\
-		uint8_t pad[ digest->blocksize ];			\
+		/** Outer digest context */				\
+		uint8_t octx[ digest->ctxsize ];			\
 	} __attribute__ (( packed ))
 
 /**
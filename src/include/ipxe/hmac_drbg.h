@@ -201,9 +201,16 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  * given in ANS X9.82 Part 3-2007 Annex E.2.1 (NIST SP 800-90 Appendix
  * F.2) shows a reseed interval of 10000.
  *
- * We choose a very conservative reseed interval.
+ * Our DRBG is seeded from a live entropy source at startup and
+ * remains instantiated only for the duration of a single boot.
+ * Gathering entropy for a reseed may be very slow (potentially
+ * several seconds for timer-based entropy sources), and would stall
+ * whichever network connection happened to trigger the reseed.  We
+ * therefore choose a reseed interval that will never be reached
+ * within the lifetime of a single boot, while remaining comfortably
+ * within the maximum permitted by the specification.
  */
-#define HMAC_DRBG_RESEED_INTERVAL 1024
+#define HMAC_DRBG_RESEED_INTERVAL ( 1UL << 28 )
 
 /**
  * HMAC_DRBG internal state
@@ -338,6 +338,10 @@ struct http_response {
 	int rc;
 	/** Redirection location */
 	const char *location;
+	/** Entity tag */
+	const char *etag;
+	/** Modification time */
+	const char *last_modified;
 	/** Transfer descriptor */
 	struct http_response_transfer transfer;
 	/** Content descriptor */
@@ -443,6 +447,17 @@ struct http_transaction {
 	size_t len;
 	/** Chunk length remaining */
 	size_t remaining;
+	/** Content offset of current response
+	 *
+	 * This is zero unless the download has been resumed, in which
+	 * case it is the offset within the content at which the
+	 * current response's body begins.
+	 */
+	size_t offset;
+	/** Copied validator (ETag or Last-Modified) for resumed requests */
+	char *validator;
+	/** Number of resume attempts */
+	unsigned int resumes;
 };
 
 /******************************************************************************
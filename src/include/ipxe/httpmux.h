@@ -0,0 +1,79 @@
+#ifndef _IPXE_HTTPMUX_H
+#define _IPXE_HTTPMUX_H
+
+/** @file
+ *
+ * Hyper Text Transfer Protocol (HTTP) striped download multiplexer
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <ipxe/refcnt.h>
+#include <ipxe/interface.h>
+#include <ipxe/list.h>
+#include <ipxe/process.h>
+#include <ipxe/uri.h>
+
+/** Maximum number of concurrent stripe downloads */
+#define HTTPMUX_MAX_STRIPES 4
+
+/** Stripe block size
+ *
+ * Each stripe download fetches this many bytes per range request.
+ * Larger blocks amortise the per-request overhead; smaller blocks
+ * keep the stripes more evenly loaded towards the end of the
+ * download.
+ */
+#define HTTPMUX_BLKSIZE ( 4 * 1024 * 1024 )
+
+struct http_multiplexer;
+
+/** A multiplexed HTTP stripe download */
+struct http_multiplexed_stripe {
+	/** HTTP download multiplexer */
+	struct http_multiplexer *httpmux;
+	/** Data transfer interface */
+	struct interface xfer;
+	/** List of busy or idle stripe downloads */
+	struct list_head list;
+	/** Starting offset of current range */
+	size_t start;
+	/** Length of current range (or zero for an unbounded download) */
+	size_t len;
+	/** Current position within range */
+	size_t pos;
+};
+
+/** An HTTP download multiplexer */
+struct http_multiplexer {
+	/** Reference count */
+	struct refcnt refcnt;
+	/** Data transfer interface */
+	struct interface xfer;
+	/** Length probe (HEAD request) interface */
+	struct interface probe;
+	/** Original URI */
+	struct uri *uri;
+	/** Number of stripes in use */
+	unsigned int streams;
+	/** Total download length */
+	size_t total;
+	/** Probe position */
+	size_t probe_pos;
+	/** Next unassigned offset */
+	size_t next;
+	/** Stripe initiation process */
+	struct process process;
+	/** List of busy stripe downloads */
+	struct list_head busy;
+	/** List of idle stripe downloads */
+	struct list_head idle;
+	/** Stripe downloads */
+	struct http_multiplexed_stripe stripe[HTTPMUX_MAX_STRIPES];
+};
+
+extern int http_mux_open ( struct interface *xfer, struct uri *uri );
+
+#endif /* _IPXE_HTTPMUX_H */
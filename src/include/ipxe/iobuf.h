@@ -42,6 +42,9 @@ struct io_buffer {
 	/** DMA mapping */
 	struct dma_mapping map;
 
+	/** Flags */
+	unsigned int flags;
+
 	/** Start of the buffer */
 	void *head;
 	/** Start of data */
@@ -52,6 +55,14 @@ struct io_buffer {
         void *end;
 };
 
+/** Transport-layer checksum has been verified by hardware
+ *
+ * Set by a network driver when the hardware has validated the
+ * received frame's TCP or UDP checksum (including the pseudo-header),
+ * allowing the software checksum verification to be skipped.
+ */
+#define IOB_FL_CSUM_GOOD 0x0001
+
 /**
  * Reserve space at start of I/O buffer
  *
@@ -283,8 +294,10 @@ extern void free_iob ( struct io_buffer *iobuf );
 extern struct io_buffer * __malloc alloc_rx_iob ( size_t len,
 						  struct dma_device *dma );
 extern void free_rx_iob ( struct io_buffer *iobuf );
+extern void flush_rx_iobs ( struct dma_device *dma );
 extern void iob_pad ( struct io_buffer *iobuf, size_t min_len );
 extern int iob_ensure_headroom ( struct io_buffer *iobuf, size_t len );
+extern size_t iob_chain_len ( struct list_head *list );
 extern struct io_buffer * iob_concatenate ( struct list_head *list );
 extern struct io_buffer * iob_split ( struct io_buffer *iobuf, size_t len );
 
@@ -301,6 +301,7 @@ extern int ipv6_add_miniroute ( struct net_device *netdev,
 				unsigned int prefix_len,
 				struct in6_addr *router );
 extern void ipv6_del_miniroute ( struct ipv6_miniroute *miniroute );
+extern void ipv6_flush_route_cache ( void );
 extern struct ipv6_miniroute * ipv6_route ( unsigned int scope_id,
 					    struct in6_addr **dest );
 extern int parse_ipv6_setting ( const struct setting_type *type,
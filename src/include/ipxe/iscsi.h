@@ -25,8 +25,15 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Default iSCSI first burst length */
 #define ISCSI_FIRST_BURST_LEN 65536
 
-/** Default iSCSI maximum burst length */
-#define ISCSI_MAX_BURST_LEN 262144
+/** Offered iSCSI maximum burst length
+ *
+ * This is the largest value representable in the MaxBurstLength
+ * three-byte field.  Since data is placed directly into the SCSI
+ * command's data buffer, a larger burst costs us no memory, and
+ * allows a single SCSI command to cover as much as possible of each
+ * block device request.
+ */
+#define ISCSI_MAX_BURST_LEN 16777215
 
 /** Default iSCSI maximum receive data segment length */
 #define ISCSI_MAX_RECV_DATA_SEG_LEN 8192
@@ -524,8 +531,12 @@ enum iscsi_tx_state {
 	ISCSI_TX_BHS,
 	/** Sending the additional header segment */
 	ISCSI_TX_AHS,
+	/** Sending the header digest */
+	ISCSI_TX_HEADER_DIGEST,
 	/** Sending the data segment */
 	ISCSI_TX_DATA,
+	/** Sending the data digest */
+	ISCSI_TX_DATA_DIGEST,
 };
 
 /** State of an iSCSI RX engine */
@@ -534,10 +545,14 @@ enum iscsi_rx_state {
 	ISCSI_RX_BHS = 0,
 	/** Receiving the additional header segment */
 	ISCSI_RX_AHS,
+	/** Receiving the header digest */
+	ISCSI_RX_HEADER_DIGEST,
 	/** Receiving the data segment */
 	ISCSI_RX_DATA,
 	/** Receiving the data segment padding */
 	ISCSI_RX_DATA_PADDING,
+	/** Receiving the data digest */
+	ISCSI_RX_DATA_DIGEST,
 };
 
 /** An iSCSI session */
@@ -588,6 +603,10 @@ struct iscsi_session {
 
 	/** Maximum burst length */
 	size_t max_burst_len;
+	/** CRC32C header digest is negotiated */
+	int header_digest;
+	/** CRC32C data digest is negotiated */
+	int data_digest;
 
 	/** Initiator session ID (IANA format) qualifier
 	 *
@@ -653,6 +672,12 @@ struct iscsi_session {
 	size_t rx_len;
 	/** Buffer for received data (not always used) */
 	void *rx_buffer;
+	/** Digests are in effect for the current RX PDU */
+	int rx_digests;
+	/** Running digest of the current RX PDU portion */
+	uint32_t rx_digest;
+	/** Received digest value */
+	uint32_t rx_digest_value;
 
 	/** Current SCSI command, if any */
 	struct scsi_cmd *command;
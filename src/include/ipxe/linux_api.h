@@ -79,6 +79,8 @@ extern void * __asmcall linux_mremap ( void *old_address, size_t old_size,
 				       size_t new_size, int flags, ... );
 extern int __asmcall linux_munmap ( void *addr, size_t length );
 extern int __asmcall linux_socket ( int domain, int type, int protocol );
+extern int __asmcall linux_setsockopt ( int sockfd, int level, int optname,
+					const void *optval, size_t optlen );
 extern int __asmcall linux_bind ( int sockfd, const struct sockaddr *addr,
 				  size_t addrlen );
 extern ssize_t __asmcall linux_sendto ( int sockfd, const void *buf,
@@ -18,6 +18,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 #include <stdlib.h>
+#include <ipxe/list.h>
 #include <ipxe/tables.h>
 #include <valgrind/memcheck.h>
 
@@ -42,11 +43,47 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 extern size_t freemem;
 extern size_t usedmem;
 extern size_t maxusedmem;
+extern size_t uusedmem;
+extern size_t maxuusedmem;
+
+/** Heap statistics */
+struct heap_stats {
+	/** Number of free blocks */
+	unsigned int blocks;
+	/** Size of largest free block */
+	size_t largest;
+	/** Number of failed allocations */
+	unsigned int failures;
+};
+
+/** A record of the largest failed allocation
+ *
+ * By the time an out-of-memory failure is reported, the conditions
+ * that caused it are usually long gone.  Record the state of the heap
+ * at the point of the largest failed request so that it can be
+ * inspected after the fact.
+ */
+struct heap_failure {
+	/** Requested size (zero if no allocation has ever failed) */
+	size_t size;
+	/** Requested physical alignment */
+	size_t align;
+	/** Return address of the failed caller */
+	void *caller;
+	/** Memory in use at time of failure */
+	size_t used;
+	/** Largest free block at time of failure */
+	size_t largest;
+};
+
+extern struct heap_failure heap_worst_failure;
 
 extern void * __malloc alloc_memblock ( size_t size, size_t align,
 					size_t offset );
 extern void free_memblock ( void *ptr, size_t size );
+extern void heap_stat ( struct heap_stats *stats );
 extern void mdumpfree ( void );
+extern void umalloc_account ( size_t old_size, size_t new_size );
 
 /**
  * Allocate memory with specified physical alignment and offset
@@ -123,4 +160,47 @@ struct cache_discarder {
 
 /** @} */
 
+/** A slab cache of fixed-size objects
+ *
+ * A slab cache provides O(1) allocation and freeing for frequently
+ * allocated fixed-size objects, by retaining a bounded population of
+ * freed objects instead of returning them to the heap.  Cached
+ * objects will be released back to the heap under memory pressure.
+ */
+struct slab_cache {
+	/** Name (for debugging) */
+	const char *name;
+	/** Object size */
+	size_t size;
+	/** Maximum number of retained free objects */
+	unsigned int max;
+	/** Current number of retained free objects */
+	unsigned int count;
+	/** List of retained free objects */
+	struct list_head objects;
+};
+
+/** Slab cache table */
+#define SLAB_CACHES __table ( struct slab_cache, "slab_caches" )
+
+/** Declare a slab cache */
+#define __slab_cache __table_entry ( SLAB_CACHES, 01 )
+
+/** Define a slab cache
+ *
+ * @v _name		Variable name
+ * @v _size		Object size
+ * @v _max		Maximum number of retained free objects
+ */
+#define SLAB_CACHE( _name, _size, _max )			\
+	struct slab_cache _name __slab_cache = {		\
+		.name = #_name,					\
+		.size = (_size),				\
+		.max = (_max),					\
+		.objects = LIST_HEAD_INIT ( _name.objects ),	\
+	}
+
+extern void * __malloc slab_alloc ( struct slab_cache *slab );
+extern void slab_free ( struct slab_cache *slab, void *ptr );
+
 #endif /* _IPXE_MALLOC_H */
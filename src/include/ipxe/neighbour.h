@@ -58,6 +58,8 @@ struct neighbour {
 
 	/** Pending I/O buffers */
 	struct list_head tx_queue;
+	/** Number of pending I/O buffers */
+	unsigned int tx_len;
 };
 
 /**
@@ -84,5 +86,13 @@ extern int neighbour_update ( struct net_device *netdev,
 extern int neighbour_define ( struct net_device *netdev,
 			      struct net_protocol *net_protocol,
 			      const void *net_dest, const void *ll_dest );
+extern int neighbour_probe ( struct net_device *netdev,
+			     struct net_protocol *net_protocol,
+			     const void *net_dest,
+			     struct neighbour_discovery *discovery,
+			     const void *net_source );
+extern int neighbour_fetch ( struct net_device *netdev,
+			     struct net_protocol *net_protocol,
+			     const void *net_dest, void *ll_dest );
 
 #endif /* _IPXE_NEIGHBOUR_H */
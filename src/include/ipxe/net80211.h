@@ -15,7 +15,14 @@
 /*
  * Major things NOT YET supported:
  * - any type of security
- * - 802.11n
+ * - 802.11n.  This is not merely a matter of advertising the HT
+ *   capability element: useful 11n throughput requires A-MPDU
+ *   aggregation, which in turn requires block-ack session management
+ *   (ADDBA/DELBA action frames), a receive reorder buffer with
+ *   timeout handling, QoS-data frame support, and per-driver A-MPDU
+ *   status reporting in the RX descriptor path.  Associating as a
+ *   legacy client of an 11n AP works today and is adequate for the
+ *   single-flow transfers this stack exists to perform.
  *
  * Major things that probably will NEVER be supported, barring a
  * compelling use case and/or corporate sponsorship:
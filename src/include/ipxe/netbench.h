@@ -0,0 +1,30 @@
+#ifndef _IPXE_NETBENCH_H
+#define _IPXE_NETBENCH_H
+
+/** @file
+ *
+ * Network benchmark streams
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <ipxe/interface.h>
+
+/** Network benchmark measurement results */
+struct netbench_result {
+	/** Transferred byte count */
+	unsigned long long bytes;
+	/** Elapsed time (in ticks) */
+	unsigned long elapsed;
+	/** Mean datapath cost per chunk (in profiler ticks) */
+	unsigned long cycles;
+};
+
+extern int create_netbench ( struct interface *job, const char *hostname,
+			     unsigned int port, int udp, int rx, size_t len,
+			     unsigned long duration,
+			     struct netbench_result *result );
+
+#endif /* _IPXE_NETBENCH_H */
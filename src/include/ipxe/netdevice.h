@@ -16,6 +16,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/settings.h>
 #include <ipxe/interface.h>
 #include <ipxe/retry.h>
+#include <ipxe/profile.h>
 
 struct io_buffer;
 struct net_device;
@@ -253,6 +254,19 @@ struct net_device_operations {
 	 */
 	int ( * transmit ) ( struct net_device *netdev,
 			     struct io_buffer *iobuf );
+	/** Flush deferred transmissions
+	 *
+	 * @v netdev	Network device
+	 *
+	 * This method may be NULL.  If implemented, then the
+	 * transmit() method may post descriptors without notifying
+	 * the hardware (e.g. without ringing a doorbell register),
+	 * and this method will be called to perform the notification
+	 * before the device is next polled.  This allows the cost of
+	 * the notification to be amortised across a burst of
+	 * transmitted packets.
+	 */
+	void ( * flush ) ( struct net_device *netdev );
 	/** Poll for completed and received packets
 	 *
 	 * @v netdev	Network device
@@ -287,14 +301,49 @@ struct net_device_error {
 /** Maximum number of unique errors that we will keep track of */
 #define NETDEV_MAX_UNIQUE_ERRORS 4
 
+/** Network device per-protocol statistics */
+struct net_device_proto_stats {
+	/** Network-layer protocol (in network byte order) */
+	uint16_t net_proto;
+	/** Packet count */
+	unsigned long packets;
+	/** Byte count */
+	unsigned long bytes;
+};
+
+/** Maximum number of unique protocols that we will keep track of */
+#define NETDEV_MAX_UNIQUE_PROTOS 4
+
 /** Network device statistics */
 struct net_device_stats {
 	/** Count of successful completions */
 	unsigned int good;
 	/** Count of error completions */
 	unsigned int bad;
+	/** Total bytes in successful completions */
+	unsigned long bytes;
 	/** Error breakdowns */
 	struct net_device_error errors[NETDEV_MAX_UNIQUE_ERRORS];
+	/** Per-protocol breakdowns */
+	struct net_device_proto_stats protos[NETDEV_MAX_UNIQUE_PROTOS];
+};
+
+/** Network device interval rate measurement */
+struct net_device_rates {
+	/** A measurement has been taken */
+	int valid;
+	/** TX packet rate (in packets per second) */
+	unsigned long tx_pps;
+	/** TX byte rate (in bytes per second) */
+	unsigned long tx_bps;
+	/** TX error completions during measurement interval */
+	unsigned int tx_bad;
+	/** RX packet rate (in packets per second) */
+	unsigned long rx_pps;
+	/** RX byte rate (in bytes per second) */
+	unsigned long rx_bps;
+	/** RX error completions during measurement interval */
+	unsigned int rx_bad;
 };
 
 /** A network device configuration */
@@ -419,10 +468,34 @@ struct net_device {
 	struct list_head tx_deferred;
 	/** RX packet queue */
 	struct list_head rx_queue;
+	/** Consecutive polls yielding no received packets
+	 *
+	 * Used to adaptively reduce the polling frequency of idle
+	 * devices.
+	 */
+	unsigned int quiet;
+	/** Number of polls remaining to be skipped */
+	unsigned int skip;
 	/** TX statistics */
 	struct net_device_stats tx_stats;
 	/** RX statistics */
 	struct net_device_stats rx_stats;
+	/** Most recent interval rate measurement (via ifrate()) */
+	struct net_device_rates rates;
+	/** Driver transmit() profiler
+	 *
+	 * Records the cycle cost of each call to the driver's
+	 * transmit() method, allowing boot time to be attributed
+	 * between driver and protocol stack without editing each
+	 * driver.  Reported by profstat as "<name>.tx".
+	 */
+	struct profiler tx_profiler;
+	/** Driver poll() profiler
+	 *
+	 * As per @c tx_profiler, but for the driver's poll() method.
+	 * Reported by profstat as "<name>.poll".
+	 */
+	struct profiler poll_profiler;
 
 	/** Configuration settings applicable to this device */
 	struct generic_settings settings;
@@ -460,6 +533,9 @@ struct net_device {
 /** Network device must be polled even when closed */
 #define NETDEV_INSOMNIAC 0x0040
 
+/** Network device has transmissions awaiting a flush */
+#define NETDEV_TX_UNFLUSHED 0x0080
+
 /** Link-layer protocol table */
 #define LL_PROTOCOLS __table ( struct ll_protocol, "ll_protocols" )
 
@@ -740,6 +816,7 @@ extern struct net_device * find_netdev_by_scope_id ( unsigned int scope_id );
 extern struct net_device * find_netdev_by_location ( unsigned int bus_type,
 						     unsigned int location );
 extern struct net_device * last_opened_netdev ( void );
+extern struct net_protocol * net_find_protocol ( uint16_t net_proto );
 extern int net_tx ( struct io_buffer *iobuf, struct net_device *netdev,
 		    struct net_protocol *net_protocol, const void *ll_dest,
 		    const void *ll_source );
@@ -0,0 +1,309 @@
+#ifndef _IPXE_NVME_H
+#define _IPXE_NVME_H
+
+/** @file
+ *
+ * NVM Express (NVMe) block driver
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <ipxe/list.h>
+#include <ipxe/interface.h>
+#include <ipxe/process.h>
+#include <ipxe/dma.h>
+
+/** Controller Capabilities register */
+#define NVME_CAP 0x0000
+
+/** Maximum Queue Entries Supported */
+#define NVME_CAP_MQES( cap ) ( ( (cap) >> 0 ) & 0xffff )
+
+/** Timeout (in units of 500ms) */
+#define NVME_CAP_TO( cap ) ( ( (cap) >> 24 ) & 0xff )
+
+/** Doorbell Stride */
+#define NVME_CAP_DSTRD( cap ) ( ( (cap) >> 32 ) & 0xf )
+
+/** Memory Page Size Minimum */
+#define NVME_CAP_MPSMIN( cap ) ( ( (cap) >> 48 ) & 0xf )
+
+/** Version register */
+#define NVME_VS 0x0008
+
+/** Controller Configuration register */
+#define NVME_CC 0x0014
+
+/** Controller Enable */
+#define NVME_CC_EN 0x00000001UL
+
+/** I/O Submission Queue Entry Size (64 bytes) */
+#define NVME_CC_IOSQES ( 6 << 16 )
+
+/** I/O Completion Queue Entry Size (16 bytes) */
+#define NVME_CC_IOCQES ( 4 << 20 )
+
+/** Controller Status register */
+#define NVME_CSTS 0x001c
+
+/** Controller Ready */
+#define NVME_CSTS_RDY 0x00000001UL
+
+/** Controller Fatal Status */
+#define NVME_CSTS_CFS 0x00000002UL
+
+/** Admin Queue Attributes register */
+#define NVME_AQA 0x0024
+
+/** Admin Submission Queue Base Address register */
+#define NVME_ASQ 0x0028
+
+/** Admin Completion Queue Base Address register */
+#define NVME_ACQ 0x0030
+
+/** Doorbell register base */
+#define NVME_DB 0x1000
+
+/** Memory page size
+ *
+ * We configure CC.MPS for 4kB pages, which every controller is
+ * required to support.
+ */
+#define NVME_PAGE_SIZE 4096
+
+/** Number of entries in a single PRP list page */
+#define NVME_PRP_COUNT ( NVME_PAGE_SIZE / sizeof ( uint64_t ) )
+
+/** A submission queue entry */
+struct nvme_command {
+	/** Opcode */
+	uint8_t opcode;
+	/** Flags */
+	uint8_t flags;
+	/** Command identifier */
+	uint16_t cid;
+	/** Namespace identifier */
+	uint32_t nsid;
+	/** Reserved */
+	uint8_t reserved_a[8];
+	/** Metadata pointer */
+	uint64_t mptr;
+	/** Physical region page entry 1 */
+	uint64_t prp1;
+	/** Physical region page entry 2 */
+	uint64_t prp2;
+	/** Command dwords 10-15 */
+	uint32_t cdw10;
+	uint32_t cdw11;
+	uint32_t cdw12;
+	uint32_t cdw13;
+	uint32_t cdw14;
+	uint32_t cdw15;
+} __attribute__ (( packed ));
+
+/** A completion queue entry */
+struct nvme_completion {
+	/** Command-specific result */
+	uint32_t result;
+	/** Reserved */
+	uint8_t reserved_a[4];
+	/** Submission queue head pointer */
+	uint16_t sqhd;
+	/** Submission queue identifier */
+	uint16_t sqid;
+	/** Command identifier */
+	uint16_t cid;
+	/** Phase tag and status field */
+	uint16_t status;
+} __attribute__ (( packed ));
+
+/** Phase tag */
+#define NVME_STATUS_PHASE 0x0001
+
+/** Status code (and status code type) */
+#define NVME_STATUS( status ) ( ( (status) >> 1 ) & 0x3fff )
+
+/** Delete I/O Submission Queue admin command */
+#define NVME_ADMIN_DELETE_SQ 0x00
+
+/** Create I/O Submission Queue admin command */
+#define NVME_ADMIN_CREATE_SQ 0x01
+
+/** Delete I/O Completion Queue admin command */
+#define NVME_ADMIN_DELETE_CQ 0x04
+
+/** Create I/O Completion Queue admin command */
+#define NVME_ADMIN_CREATE_CQ 0x05
+
+/** Identify admin command */
+#define NVME_ADMIN_IDENTIFY 0x06
+
+/** Identify namespace data structure */
+#define NVME_IDENTIFY_NS 0x00
+
+/** Identify controller data structure */
+#define NVME_IDENTIFY_CTRL 0x01
+
+/** Physically Contiguous queue flag */
+#define NVME_QUEUE_PC 0x00000001UL
+
+/** Write I/O command */
+#define NVME_IO_WRITE 0x01
+
+/** Read I/O command */
+#define NVME_IO_READ 0x02
+
+/** An Identify Controller data structure */
+struct nvme_identity_ctrl {
+	/** PCI vendor ID */
+	uint16_t vid;
+	/** PCI subsystem vendor ID */
+	uint16_t ssvid;
+	/** Serial number */
+	char sn[20];
+	/** Model number */
+	char mn[40];
+	/** Firmware revision */
+	char fr[8];
+	/** Recommended arbitration burst */
+	uint8_t rab;
+	/** IEEE OUI identifier */
+	uint8_t ieee[3];
+	/** Controller multi-path capabilities */
+	uint8_t cmic;
+	/** Maximum data transfer size (log2, in minimum pages) */
+	uint8_t mdts;
+	/** Reserved */
+	uint8_t reserved_a[438];
+	/** Number of namespaces */
+	uint32_t nn;
+	/** Reserved */
+	uint8_t reserved_b[3576];
+} __attribute__ (( packed ));
+
+/** An Identify Namespace data structure */
+struct nvme_identity_ns {
+	/** Namespace size (in logical blocks) */
+	uint64_t nsze;
+	/** Namespace capacity (in logical blocks) */
+	uint64_t ncap;
+	/** Namespace utilisation (in logical blocks) */
+	uint64_t nuse;
+	/** Namespace features */
+	uint8_t nsfeat;
+	/** Number of LBA formats */
+	uint8_t nlbaf;
+	/** Formatted LBA size */
+	uint8_t flbas;
+	/** Reserved */
+	uint8_t reserved_a[101];
+	/** LBA formats */
+	uint32_t lbaf[16];
+	/** Reserved */
+	uint8_t reserved_b[3904];
+} __attribute__ (( packed ));
+
+/** Currently formatted LBA format index */
+#define NVME_FLBAS_FORMAT( flbas ) ( ( (flbas) >> 0 ) & 0xf )
+
+/** LBA data size (log2, in bytes) */
+#define NVME_LBAF_LBADS( lbaf ) ( ( (lbaf) >> 16 ) & 0xff )
+
+/** A queue pair */
+struct nvme_queue {
+	/** Submission queue entries */
+	struct nvme_command *sqe;
+	/** Submission queue DMA mapping */
+	struct dma_mapping sqe_map;
+	/** Completion queue entries */
+	struct nvme_completion *cqe;
+	/** Completion queue DMA mapping */
+	struct dma_mapping cqe_map;
+
+	/** Number of entries in each queue */
+	unsigned int count;
+	/** Submission queue tail pointer */
+	unsigned int sq_tail;
+	/** Completion queue head pointer */
+	unsigned int cq_head;
+	/** Expected completion queue phase tag */
+	unsigned int phase;
+	/** Next command identifier */
+	uint16_t cid;
+
+	/** Submission queue doorbell register */
+	void *sq_db;
+	/** Completion queue doorbell register */
+	void *cq_db;
+};
+
+/** Admin queue identifier */
+#define NVME_QID_ADMIN 0
+
+/** I/O queue identifier */
+#define NVME_QID_IO 1
+
+/** Number of entries in each admin queue */
+#define NVME_ADMIN_COUNT 8
+
+/** Number of entries in each I/O queue */
+#define NVME_IO_COUNT 8
+
+/** An NVMe controller */
+struct nvme_ctrl {
+	/** Reference counter */
+	struct refcnt refcnt;
+	/** List of NVMe controllers */
+	struct list_head list;
+	/** Controller index */
+	unsigned int index;
+
+	/** Registers */
+	void *regs;
+	/** DMA device */
+	struct dma_device *dma;
+	/** Doorbell stride (in bytes) */
+	size_t stride;
+	/** Enable/disable timeout (in ms) */
+	unsigned int timeout;
+	/** Minimum memory page size (log2, in bytes) */
+	unsigned int mps;
+	/** Number of entries in each I/O queue */
+	unsigned int io_count;
+
+	/** Admin queue pair */
+	struct nvme_queue admin;
+	/** I/O queue pair */
+	struct nvme_queue io;
+	/** PRP list page */
+	uint64_t *prp;
+	/** PRP list page DMA mapping */
+	struct dma_mapping prp_map;
+
+	/** Namespace identifier */
+	uint32_t nsid;
+	/** Logical block size */
+	size_t blksize;
+	/** Total number of logical blocks */
+	uint64_t blocks;
+	/** Maximum number of blocks per single transfer */
+	unsigned int max_count;
+
+	/** Block control interface */
+	struct interface block;
+	/** Block data interface */
+	struct interface data;
+	/** Completion polling process */
+	struct process process;
+	/** Device is opened as a SAN device */
+	int opened;
+
+	/** Current command state */
+	int pending;
+	/** Data buffer DMA mapping */
+	struct dma_mapping map;
+};
+
+#endif /* _IPXE_NVME_H */
@@ -0,0 +1,330 @@
+#ifndef _IPXE_NVMETCP_H
+#define _IPXE_NVMETCP_H
+
+/** @file
+ *
+ * NVMe/TCP protocol
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <ipxe/interface.h>
+#include <ipxe/process.h>
+#include <ipxe/refcnt.h>
+#include <ipxe/retry.h>
+#include <ipxe/nvme.h>
+
+/** Default NVMe/TCP port */
+#define NVMETCP_PORT 4420
+
+/** Initialise Connection Request PDU */
+#define NVMETCP_ICREQ 0x00
+
+/** Initialise Connection Response PDU */
+#define NVMETCP_ICRESP 0x01
+
+/** Host to Controller Terminate Connection Request PDU */
+#define NVMETCP_H2C_TERM 0x02
+
+/** Controller to Host Terminate Connection Request PDU */
+#define NVMETCP_C2H_TERM 0x03
+
+/** Command Capsule PDU */
+#define NVMETCP_CMD 0x04
+
+/** Response Capsule PDU */
+#define NVMETCP_RSP 0x05
+
+/** Host to Controller Data PDU */
+#define NVMETCP_H2C_DATA 0x06
+
+/** Controller to Host Data PDU */
+#define NVMETCP_C2H_DATA 0x07
+
+/** Ready to Transfer PDU */
+#define NVMETCP_R2T 0x09
+
+/** Last PDU of a data transfer */
+#define NVMETCP_FLAG_LAST 0x04
+
+/** Command completed successfully (no response capsule will follow) */
+#define NVMETCP_FLAG_SUCCESS 0x08
+
+/** An NVMe/TCP PDU common header
+ *
+ * All fields are little-endian.
+ */
+struct nvmetcp_header {
+	/** PDU type */
+	uint8_t type;
+	/** Flags */
+	uint8_t flags;
+	/** Header length (in bytes) */
+	uint8_t hlen;
+	/** PDU data offset (in bytes) */
+	uint8_t pdo;
+	/** PDU length (in bytes) */
+	uint32_t plen;
+} __attribute__ (( packed ));
+
+/** An Initialise Connection Request PDU */
+struct nvmetcp_icreq {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** PDU format version */
+	uint16_t pfv;
+	/** Host PDU data alignment (log2, minus 2) */
+	uint8_t hpda;
+	/** Digest types enabled */
+	uint8_t dgst;
+	/** Maximum number of outstanding R2Ts (zero-based) */
+	uint32_t maxr2t;
+	/** Reserved */
+	uint8_t reserved[112];
+} __attribute__ (( packed ));
+
+/** An Initialise Connection Response PDU */
+struct nvmetcp_icresp {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** PDU format version */
+	uint16_t pfv;
+	/** Controller PDU data alignment (log2, minus 2) */
+	uint8_t cpda;
+	/** Digest types enabled */
+	uint8_t dgst;
+	/** Maximum data length per H2CData PDU */
+	uint32_t maxh2cdata;
+	/** Reserved */
+	uint8_t reserved[112];
+} __attribute__ (( packed ));
+
+/** A Command Capsule PDU */
+struct nvmetcp_cmd {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** Submission queue entry */
+	struct nvme_command sqe;
+} __attribute__ (( packed ));
+
+/** A Response Capsule PDU */
+struct nvmetcp_rsp {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** Completion queue entry */
+	struct nvme_completion cqe;
+} __attribute__ (( packed ));
+
+/** A Controller to Host Data PDU */
+struct nvmetcp_c2h_data {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** Command capsule identifier */
+	uint16_t cccid;
+	/** Reserved */
+	uint16_t reserved_a;
+	/** Data offset */
+	uint32_t datao;
+	/** Data length */
+	uint32_t datal;
+	/** Reserved */
+	uint32_t reserved_b;
+} __attribute__ (( packed ));
+
+/** A Host to Controller Data PDU */
+struct nvmetcp_h2c_data {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** Command capsule identifier */
+	uint16_t cccid;
+	/** Transfer tag */
+	uint16_t ttag;
+	/** Data offset */
+	uint32_t datao;
+	/** Data length */
+	uint32_t datal;
+	/** Reserved */
+	uint32_t reserved;
+} __attribute__ (( packed ));
+
+/** A Ready to Transfer PDU */
+struct nvmetcp_r2t {
+	/** Common header */
+	struct nvmetcp_header header;
+	/** Command capsule identifier */
+	uint16_t cccid;
+	/** Transfer tag */
+	uint16_t ttag;
+	/** Requested data offset */
+	uint32_t r2to;
+	/** Requested data length */
+	uint32_t r2tl;
+	/** Reserved */
+	uint32_t reserved;
+} __attribute__ (( packed ));
+
+/** Fabrics command opcode */
+#define NVME_FABRICS 0x7f
+
+/** Property Set fabrics command */
+#define NVME_FABRICS_PROPERTY_SET 0x00
+
+/** Connect fabrics command */
+#define NVME_FABRICS_CONNECT 0x01
+
+/** Property Get fabrics command */
+#define NVME_FABRICS_PROPERTY_GET 0x04
+
+/** Command uses an SGL descriptor */
+#define NVME_CMD_SGL 0x40
+
+/** In-capsule SGL data block descriptor (type and subtype) */
+#define NVMETCP_SGL_INCAPSULE 0x01
+
+/** Transport SGL data block descriptor (type and subtype) */
+#define NVMETCP_SGL_TRANSPORT 0x5a
+
+/** Connect command data */
+struct nvme_connect_data {
+	/** Host identifier */
+	uint8_t hostid[16];
+	/** Controller identifier */
+	uint16_t cntlid;
+	/** Reserved */
+	uint8_t reserved_a[238];
+	/** Subsystem NVMe qualified name */
+	char subnqn[256];
+	/** Host NVMe qualified name */
+	char hostnqn[256];
+	/** Reserved */
+	uint8_t reserved_b[256];
+} __attribute__ (( packed ));
+
+/** Controller identifier used when connecting the admin queue */
+#define NVME_CNTLID_DYNAMIC 0xffff
+
+/** NVMe/TCP session state */
+enum nvmetcp_state {
+	/** Awaiting ICResp on the admin queue connection */
+	NVMETCP_STATE_ADMIN_ICREQ = 0,
+	/** Awaiting admin queue Connect response */
+	NVMETCP_STATE_CONNECT_ADMIN,
+	/** Awaiting Property Set (controller enable) response */
+	NVMETCP_STATE_ENABLE,
+	/** Awaiting Property Get (controller status) response */
+	NVMETCP_STATE_WAIT_READY,
+	/** Awaiting Identify Controller completion */
+	NVMETCP_STATE_IDENTIFY_CTRL,
+	/** Awaiting Identify Namespace completion */
+	NVMETCP_STATE_IDENTIFY_NS,
+	/** Awaiting ICResp on the I/O queue connection */
+	NVMETCP_STATE_IO_ICREQ,
+	/** Awaiting I/O queue Connect response */
+	NVMETCP_STATE_CONNECT_IO,
+	/** Session is ready for I/O commands */
+	NVMETCP_STATE_READY,
+};
+
+/** NVMe/TCP receive state */
+enum nvmetcp_rx_state {
+	/** Receiving a PDU header */
+	NVMETCP_RX_HEADER = 0,
+	/** Receiving PDU data */
+	NVMETCP_RX_DATA,
+};
+
+/** An NVMe/TCP queue connection */
+struct nvmetcp_queue {
+	/** Containing session */
+	struct nvmetcp_session *session;
+	/** TCP socket interface */
+	struct interface socket;
+	/** Queue identifier */
+	uint16_t qid;
+	/** Next command identifier */
+	uint16_t cid;
+	/** ICReq has been sent */
+	int icreq_sent;
+
+	/** Receive state */
+	enum nvmetcp_rx_state rx_state;
+	/** Byte offset within current receive state */
+	size_t rx_offset;
+	/** Expected length of current receive state */
+	size_t rx_len;
+	/** Data destination for current data PDU */
+	void *rx_data;
+	/** PDU header buffer */
+	union {
+		struct nvmetcp_header header;
+		struct nvmetcp_icresp icresp;
+		struct nvmetcp_rsp rsp;
+		struct nvmetcp_c2h_data c2h;
+		struct nvmetcp_r2t r2t;
+		uint8_t bytes[128];
+	} rx;
+};
+
+/** An NVMe/TCP session */
+struct nvmetcp_session {
+	/** Reference counter */
+	struct refcnt refcnt;
+	/** Block control interface */
+	struct interface block;
+	/** Block data interface */
+	struct interface data;
+	/** Deferred completion process */
+	struct process process;
+	/** Controller ready polling timer */
+	struct retry_timer timer;
+
+	/** Target URI */
+	struct uri *uri;
+	/** Subsystem NVMe qualified name */
+	const char *subnqn;
+	/** Session state */
+	enum nvmetcp_state state;
+	/** Number of controller ready polls remaining */
+	unsigned int ready_polls;
+
+	/** Admin queue connection */
+	struct nvmetcp_queue admin;
+	/** I/O queue connection */
+	struct nvmetcp_queue io;
+	/** Controller identifier */
+	uint16_t cntlid;
+	/** Maximum data length per H2CData PDU */
+	uint32_t maxh2cdata;
+	/** Identify data buffer (during session establishment) */
+	void *ident;
+
+	/** Namespace identifier */
+	uint32_t nsid;
+	/** Logical block size */
+	size_t blksize;
+	/** Total number of logical blocks */
+	uint64_t blocks;
+	/** Maximum number of blocks per single transfer */
+	unsigned int max_count;
+
+	/** Current command state */
+	int pending;
+	/** Current command identifier */
+	uint16_t cmd_cid;
+	/** Current command opcode */
+	unsigned int opcode;
+	/** Current command data buffer */
+	void *buffer;
+	/** Current command data length */
+	size_t len;
+	/** Host to controller transfer tag */
+	uint16_t ttag;
+	/** Host to controller data offset */
+	size_t h2c_offset;
+	/** Host to controller data remaining */
+	size_t h2c_remaining;
+};
+
+#endif /* _IPXE_NVMETCP_H */
@@ -138,6 +138,39 @@ static inline int ocsp_required ( struct x509_certificate *cert ) {
 		 ( ! cert->extensions.auth_info.ocsp.good ) );
 }
 
+/**
+ * Check if cached OCSP status has become stale
+ *
+ * @v cert		X.509 certificate
+ * @v time		Time at which to check
+ * @ret stale		Cached OCSP status has become stale
+ */
+static inline int ocsp_stale ( struct x509_certificate *cert, time_t time ) {
+
+	/* A cached OCSP status cannot become stale if OCSP checks
+	 * are disabled.
+	 */
+	if ( ! OCSP_ENABLED )
+		return 0;
+
+	/* A cached good status is stale once the nextUpdate time from
+	 * the OCSP response has passed (allowing for some margin of
+	 * error).
+	 */
+	return ( cert->extensions.auth_info.ocsp.good &&
+		 ( cert->extensions.auth_info.ocsp.expiry <
+		   ( time - TIMESTAMP_ERROR_MARGIN ) ) );
+}
+
+/**
+ * Invalidate cached OCSP status
+ *
+ * @v cert		X.509 certificate
+ */
+static inline void ocsp_invalidate ( struct x509_certificate *cert ) {
+	cert->extensions.auth_info.ocsp.good = 0;
+}
+
 extern int ocsp_check ( struct x509_certificate *cert,
 			struct x509_certificate *issuer,
 			struct ocsp_check **ocsp );
@@ -124,6 +124,11 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Uncorrectable error status */
 #define PCI_ERR_UNCOR_STATUS	0x04
 
+/** Mass storage controller */
+#define PCI_CLASS_STORAGE	0x01
+#define PCI_CLASS_STORAGE_NVME		0x08	/**< Non-volatile memory */
+#define PCI_CLASS_STORAGE_NVME_NVME	 0x02	/**< NVM Express */
+
 /** Network controller */
 #define PCI_CLASS_NETWORK	0x02
 
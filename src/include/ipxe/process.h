@@ -25,6 +25,15 @@ struct process {
 	 * this field may be NULL.
 	 */
 	struct refcnt *refcnt;
+	/** Scheduling weight
+	 *
+	 * The process will be executed this many times in each pass
+	 * through the run queue.  A weight of zero is treated as a
+	 * weight of one.
+	 */
+	unsigned int weight;
+	/** Steps remaining in the current scheduling round */
+	unsigned int remaining;
 };
 
 /** A process descriptor */
@@ -128,10 +137,21 @@ extern void step ( void );
  * @v process		Process
  * @v desc		Process descriptor
  */
-#define PROC_INIT( _process, _desc ) {					      \
+#define PROC_INIT( _process, _desc ) \
+	PROC_INIT_WEIGHTED ( _process, _desc, 1 )
+
+/**
+ * Initialise a static process with a scheduling weight
+ *
+ * @v process		Process
+ * @v desc		Process descriptor
+ * @v weight		Scheduling weight
+ */
+#define PROC_INIT_WEIGHTED( _process, _desc, _weight ) {		      \
 		.list = LIST_HEAD_INIT ( (_process).list ),		      \
 		.desc = (_desc),					      \
 		.refcnt = NULL,						      \
+		.weight = (_weight),					      \
 	}
 
 /**
@@ -148,6 +168,22 @@ process_init_stopped ( struct process *process,
 	INIT_LIST_HEAD ( &process->list );
 	process->desc = desc;
 	process->refcnt = refcnt;
+	process->weight = 1;
+	process->remaining = 0;
+}
+
+/**
+ * Set process scheduling weight
+ *
+ * @v process		Process
+ * @v weight		Scheduling weight
+ *
+ * The new weight takes effect from the process' next scheduling
+ * round.
+ */
+static inline __attribute__ (( always_inline )) void
+process_set_weight ( struct process *process, unsigned int weight ) {
+	process->weight = weight;
 }
 
 /**
@@ -194,6 +230,14 @@ process_running ( struct process *process ) {
 static struct process_descriptor name ## _desc = PROC_DESC_PURE ( step );     \
 struct process name __permanent_process = PROC_INIT ( name, & name ## _desc );
 
+/** Define a permanent process with a scheduling weight
+ *
+ */
+#define PERMANENT_PROCESS_WEIGHTED( name, step, weight )		      \
+static struct process_descriptor name ## _desc = PROC_DESC_PURE ( step );     \
+struct process name __permanent_process =				      \
+	PROC_INIT_WEIGHTED ( name, & name ## _desc, weight );
+
 /**
  * Find debugging colourisation for a process
  *
@@ -48,6 +48,15 @@ struct profiler {
 	 * (i.e. one less than would be returned by flsll(raw_accvar)).
 	 */
 	unsigned int accvar_msb;
+	/** Sample histogram
+	 *
+	 * Samples are bucketed by flsl(sample): bucket @c n (for
+	 * non-zero @c n) counts samples in the range
+	 * [2^(n-1),2^n).  This allows approximate percentiles to
+	 * be recovered at a cost of one counter increment per
+	 * sample.
+	 */
+	unsigned int buckets[ 8 * sizeof ( unsigned long ) ];
 };
 
 /** Profiler table */
@@ -68,6 +77,8 @@ extern void profile_update ( struct profiler *profiler, unsigned long sample );
 extern unsigned long profile_mean ( struct profiler *profiler );
 extern unsigned long profile_variance ( struct profiler *profiler );
 extern unsigned long profile_stddev ( struct profiler *profiler );
+extern unsigned long profile_percentile ( struct profiler *profiler,
+					  unsigned int percentile );
 
 /**
  * Get start time
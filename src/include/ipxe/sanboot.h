@@ -85,6 +85,15 @@ struct san_device {
 	/** Drive is a CD-ROM */
 	int is_cdrom;
 
+	/** Readahead cache buffer (if allocated) */
+	void *cache;
+	/** Readahead cache starting logical block address */
+	uint64_t cache_lba;
+	/** Number of cached logical blocks (zero if cache is invalid) */
+	unsigned int cache_count;
+	/** Next expected sequential read logical block address */
+	uint64_t cache_next;
+
 	/** Driver private data */
 	void *priv;
 
@@ -12,6 +12,9 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <stdint.h>
 
-extern int prep_segment ( void *segment, size_t filesz, size_t memsz );
+struct memory_map;
+
+extern int prep_segment ( void *segment, size_t filesz, size_t memsz,
+			  struct memory_map *memmap );
 
 #endif /* _IPXE_SEGMENT_H */
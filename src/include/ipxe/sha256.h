@@ -79,11 +79,16 @@ struct sha256_context {
 /** SHA-224 digest size */
 #define SHA224_DIGEST_SIZE ( SHA256_DIGEST_SIZE * 224 / 256 )
 
+extern const uint32_t sha256_k[SHA256_ROUNDS];
+
 extern void sha256_family_init ( struct sha256_context *context,
 				 const struct sha256_digest *init,
 				 size_t digestsize );
 extern void sha256_update ( void *ctx, const void *data, size_t len );
 extern void sha256_final ( void *ctx, void *out );
+extern int sha256_accel_supported ( void );
+extern void sha256_accel_digest ( struct sha256_digest *digest,
+				  const union sha256_block *data );
 
 extern struct digest_algorithm sha256_algorithm;
 extern struct digest_algorithm sha224_algorithm;
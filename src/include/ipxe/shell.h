@@ -30,6 +30,7 @@ enum shell_stop_state {
 };
 
 extern void shell_stop ( int stop );
+extern int shell_background ( void );
 extern int shell_stopped ( int stop );
 extern int shell ( void );
 
@@ -138,6 +138,35 @@ struct tcp_timestamp_padded_option {
 /** Code for the TCP timestamp option */
 #define TCP_OPTION_TS 8
 
+/** TCP Fast Open option */
+struct tcp_fast_open_option {
+	uint8_t kind;
+	uint8_t length;
+	uint8_t cookie[0];
+} __attribute__ (( packed ));
+
+/** Code for the TCP Fast Open option */
+#define TCP_OPTION_TFO 34
+
+/** Minimum TCP Fast Open cookie length */
+#define TCP_TFO_COOKIE_MIN 4
+
+/** Maximum TCP Fast Open cookie length
+ *
+ * RFC 7413 permits cookies of up to 16 bytes, but the TCP data offset
+ * field limits the total option space to 40 bytes, of which our other
+ * SYN options (MSS, window scale, SACK permitted, and timestamps)
+ * already consume 24 bytes.  We therefore decline to cache any cookie
+ * that would not fit alongside them; servers typically issue 8-byte
+ * cookies.
+ */
+#define TCP_TFO_COOKIE_MAX 12
+
+/** Maximum length of the TCP Fast Open option (including padding) */
+#define TCP_TFO_OPTION_MAX_LEN					\
+	( ( sizeof ( struct tcp_fast_open_option ) +		\
+	    TCP_TFO_COOKIE_MAX + 3 ) & ~3 )
+
 /** Parsed TCP options */
 struct tcp_options {
 	/** Window scale option, if present */
@@ -146,6 +175,8 @@ struct tcp_options {
 	const struct tcp_sack_permitted_option *spopt;
 	/** Timestamp option, if present */
 	const struct tcp_timestamp_option *tsopt;
+	/** Fast Open option, if present */
+	const struct tcp_fast_open_option *tfopt;
 };
 
 /** @} */
@@ -358,8 +389,12 @@ struct tcp_options {
  * represents the maximum amount that will need to be retransmitted.
  *
  * We therefore choose a (rounded up) maximum window size of 2048kB.
+ * This default may be overridden at build time, and at runtime via
+ * the "tcpwin" setting.
  */
+#ifndef TCP_MAX_WINDOW_SIZE
 #define TCP_MAX_WINDOW_SIZE	( 2048 * 1024 )
+#endif
 
 /**
  * Path MTU
@@ -392,6 +427,17 @@ struct tcp_options {
  */
 #define TCP_KEEPALIVE_DELAY ( 15 * TICKS_PER_SEC )
 
+/**
+ * TCP delayed ACK timeout
+ *
+ * In-order data segments received on an established connection are
+ * not necessarily acknowledged immediately: we acknowledge every
+ * second segment, or after this delay has elapsed, as permitted by
+ * RFC 1122.  This roughly halves the pure ACK transmit load at high
+ * receive rates.
+ */
+#define TCP_DELACK_TIMEOUT ( TICKS_PER_SEC / 25 )
+
 /**
  * TCP maximum header length
  *
@@ -401,7 +447,16 @@ struct tcp_options {
 	  sizeof ( struct tcp_header ) +			\
 	  sizeof ( struct tcp_mss_option ) +			\
 	  sizeof ( struct tcp_window_scale_padded_option ) +	\
-	  sizeof ( struct tcp_timestamp_padded_option ) )
+	  sizeof ( struct tcp_sack_permitted_padded_option ) +	\
+	  sizeof ( struct tcp_timestamp_padded_option ) +	\
+	  TCP_TFO_OPTION_MAX_LEN )
+
+/** Maximum TCP option space
+ *
+ * The TCP data offset field limits the header to 60 bytes, and hence
+ * the options to 40 bytes.
+ */
+#define TCP_MAX_OPTIONS_LEN 40
 
 /**
  * Compare TCP sequence numbers
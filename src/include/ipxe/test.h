@@ -17,6 +17,12 @@ struct self_test {
 	const char *name;
 	/** Run self-tests */
 	void ( * exec ) ( void );
+	/** Run companion benchmarks (optional)
+	 *
+	 * Benchmarks report results via test_bench() and are run only
+	 * when performance mode is requested.
+	 */
+	void ( * bench ) ( void );
 	/** Number of tests run */
 	unsigned int total;
 	/** Number of test failures */
@@ -33,6 +39,8 @@ struct self_test {
 
 extern void test_ok ( int success, const char *file, unsigned int line,
 		      const char *test );
+extern void test_bench ( const char *name, unsigned long iterations,
+			 unsigned long long bytes, unsigned long long ticks );
 
 /**
  * Report test result
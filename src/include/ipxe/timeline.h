@@ -0,0 +1,23 @@
+#ifndef _IPXE_TIMELINE_H
+#define _IPXE_TIMELINE_H
+
+/** @file
+ *
+ * Boot timeline
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** A boot timeline event */
+struct timeline_event {
+	/** Name */
+	const char *name;
+	/** Timestamp (in ticks) */
+	unsigned long ticks;
+};
+
+extern void timeline_record ( const char *name );
+extern void timeline_show ( void );
+
+#endif /* _IPXE_TIMELINE_H */
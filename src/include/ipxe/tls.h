@@ -251,6 +251,8 @@ struct tls_cipherspec {
 	void *dynamic;
 	/** Bulk encryption cipher context */
 	void *cipher_ctx;
+	/** Pre-keyed HMAC context */
+	void *hmac_ctx;
 	/** MAC secret */
 	void *mac_secret;
 	/** Fixed initialisation vector */
@@ -15,6 +15,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/iobuf.h>
 #include <ipxe/tcpip.h>
 #include <ipxe/if_ether.h>
+#include <ipxe/netdevice.h>
 
 struct interface;
 struct sockaddr;
@@ -37,6 +38,13 @@ struct udp_header {
 	uint16_t chksum;
 };
 
+/** Maximum space required for a transmitted UDP header stack
+ *
+ * This includes the UDP header itself plus the network-layer and
+ * link-layer headers that will be pushed beneath it.
+ */
+#define UDP_MAX_HLEN ( MAX_LL_NET_HEADER_LEN + sizeof ( struct udp_header ) )
+
 extern int udp_open_promisc ( struct interface *xfer );
 extern int udp_open ( struct interface *xfer, struct sockaddr *peer,
 		      struct sockaddr *local );
@@ -131,6 +131,12 @@ struct x509_ocsp_responder {
 	struct asn1_cursor uri;
 	/** OCSP status is good */
 	int good;
+	/** Time at which OCSP status ceases to be fresh
+	 *
+	 * This is the nextUpdate time from the OCSP response that
+	 * established the status.
+	 */
+	time_t expiry;
 };
 
 /** X.509 certificate authority information access */
@@ -20,6 +20,13 @@ struct xfer_buffer {
 	void *data;
 	/** Size of data */
 	size_t len;
+	/** Allocated size of data
+	 *
+	 * This may exceed the size of the data, since allocations are
+	 * grown geometrically to avoid a full-buffer copy on every
+	 * extension.
+	 */
+	size_t reserved;
 	/** Current offset within data */
 	size_t pos;
 	/** Data transfer buffer operations */
@@ -96,7 +103,7 @@ xferbuf_void_init ( struct xfer_buffer *xferbuf ) {
 	xferbuf->op = &xferbuf_void_operations;
 }
 
-extern void xferbuf_detach ( struct xfer_buffer *xferbuf );
+extern void * xferbuf_detach ( struct xfer_buffer *xferbuf );
 extern void xferbuf_free ( struct xfer_buffer *xferbuf );
 extern int xferbuf_write ( struct xfer_buffer *xferbuf, size_t offset,
 			   const void *data, size_t len );
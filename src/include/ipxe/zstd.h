@@ -0,0 +1,52 @@
+#ifndef _IPXE_ZSTD_H
+#define _IPXE_ZSTD_H
+
+/** @file
+ *
+ * Zstandard compressed images
+ *
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <ipxe/image.h>
+
+/** Zstandard frame magic number */
+#define ZSTD_MAGIC 0xfd2fb528UL
+
+/** Zstandard skippable frame magic number (low nibble is variable) */
+#define ZSTD_MAGIC_SKIP 0x184d2a50UL
+
+/** Zstandard skippable frame magic number mask */
+#define ZSTD_MAGIC_SKIP_MASK 0xfffffff0UL
+
+/** Zstandard frame header descriptor */
+struct zstd_frame_descriptor {
+	/** Magic number */
+	uint32_t magic;
+	/** Frame header descriptor byte */
+	uint8_t desc;
+} __attribute__ (( packed ));
+
+/** Frame content size field size (2-bit code) */
+#define ZSTD_FHD_FCS( desc ) ( ( (desc) >> 6 ) & 0x3 )
+
+/** Single segment flag */
+#define ZSTD_FHD_SINGLE 0x20
+
+/** Content checksum flag */
+#define ZSTD_FHD_CHECKSUM 0x04
+
+/** Reserved bit (must be zero) */
+#define ZSTD_FHD_RESERVED 0x08
+
+/** Dictionary ID field size (2-bit code) */
+#define ZSTD_FHD_DID( desc ) ( ( (desc) >> 0 ) & 0x3 )
+
+/** Maximum decompressed size of a single block */
+#define ZSTD_BLOCK_MAX ( 128 * 1024 )
+
+extern struct image_type zstd_image_type __image_type ( PROBE_NORMAL );
+
+#endif /* _IPXE_ZSTD_H */
@@ -18,6 +18,7 @@ extern int ifconf ( struct net_device *netdev,
 		    unsigned long timeout );
 extern void ifclose ( struct net_device *netdev );
 extern void ifstat ( struct net_device *netdev );
+extern int ifrate ( struct net_device *netdev, unsigned long interval );
 extern int iflinkwait ( struct net_device *netdev, unsigned long timeout,
 			int verbose );
 
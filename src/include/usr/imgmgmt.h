@@ -15,6 +15,12 @@ extern int imgdownload ( struct uri *uri, unsigned long timeout,
 			 struct image **image );
 extern int imgdownload_string ( const char *uri_string, unsigned long timeout,
 				struct image **image );
+extern int imgdownload_background ( struct uri *uri, struct image **image );
+extern int imgdownload_string_background ( const char *uri_string,
+					   struct image **image );
+extern int imgwait ( struct image *image, unsigned long timeout );
+extern void imgjobs ( void );
+extern void imgcancel ( struct image *image );
 extern int imgacquire ( const char *name, unsigned long timeout,
 			struct image **image );
 extern void imgstat ( struct image *image );
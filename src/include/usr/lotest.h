@@ -12,5 +12,9 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 extern int loopback_test ( struct net_device *sender,
 			   struct net_device *receiver,
 			   size_t mtu, int broadcast );
+extern int loopback_bench ( struct net_device *sender,
+			    struct net_device *receiver,
+			    size_t mtu, unsigned int count,
+			    unsigned int depth );
 
 #endif /* _USR_LOTEST_H */
@@ -51,6 +51,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/acpi.h>
 #include <ipxe/efi/efi.h>
 #include <ipxe/efi/Protocol/BlockIo.h>
+#include <ipxe/efi/Protocol/BlockIo2.h>
 #include <ipxe/efi/Protocol/SimpleFileSystem.h>
 #include <ipxe/efi/Protocol/AcpiTable.h>
 #include <ipxe/efi/Guid/FileSystemInfo.h>
@@ -78,6 +79,8 @@ struct efi_block_data {
 	EFI_BLOCK_IO_MEDIA media;
 	/** Block I/O protocol */
 	EFI_BLOCK_IO_PROTOCOL block_io;
+	/** Block I/O2 protocol */
+	EFI_BLOCK_IO2_PROTOCOL block_io2;
 	/** Device path protocol */
 	EFI_DEVICE_PATH_PROTOCOL *path;
 };
@@ -211,6 +214,128 @@ efi_block_io_flush ( EFI_BLOCK_IO_PROTOCOL *block_io ) {
 	return 0;
 }
 
+/**
+ * Signal completion of a block I/O2 transaction
+ *
+ * The SAN command layer completes each command before returning, so
+ * there is no queue into which a non-blocking request could usefully
+ * be placed: requests are executed synchronously and the caller's
+ * event is signalled immediately on success.  (The specification
+ * requires that the event is not signalled on failure.)  Installing
+ * the protocol is still worthwhile, since callers that prefer block
+ * I/O2 can then issue requests without allocating events per call to
+ * wait on.
+ *
+ * @v token		Transaction token (or NULL for blocking I/O)
+ */
+static void efi_block_io2_complete ( EFI_BLOCK_IO2_TOKEN *token ) {
+	EFI_BOOT_SERVICES *bs = efi_systab->BootServices;
+
+	if ( token && token->Event ) {
+		token->TransactionStatus = 0;
+		bs->SignalEvent ( token->Event );
+	}
+}
+
+/**
+ * Reset EFI block device (via block I/O2 protocol)
+ *
+ * @v block_io2		Block I/O2 protocol
+ * @v verify		Perform extended verification
+ * @ret efirc		EFI status code
+ */
+static EFI_STATUS EFIAPI
+efi_block_io2_reset ( EFI_BLOCK_IO2_PROTOCOL *block_io2, BOOLEAN verify ) {
+	struct efi_block_data *block =
+		container_of ( block_io2, struct efi_block_data, block_io2 );
+
+	return efi_block_io_reset ( &block->block_io, verify );
+}
+
+/**
+ * Read from EFI block device (via block I/O2 protocol)
+ *
+ * @v block_io2		Block I/O2 protocol
+ * @v media		Media identifier
+ * @v lba		Starting LBA
+ * @v token		Transaction token
+ * @v len		Size of buffer
+ * @v data		Data buffer
+ * @ret efirc		EFI status code
+ */
+static EFI_STATUS EFIAPI
+efi_block_io2_read ( EFI_BLOCK_IO2_PROTOCOL *block_io2, UINT32 media,
+		     EFI_LBA lba, EFI_BLOCK_IO2_TOKEN *token, UINTN len,
+		     VOID *data ) {
+	struct efi_block_data *block =
+		container_of ( block_io2, struct efi_block_data, block_io2 );
+	EFI_STATUS efirc;
+
+	/* Perform read */
+	if ( ( efirc = efi_block_io_read ( &block->block_io, media, lba,
+					   len, data ) ) != 0 )
+		return efirc;
+
+	/* Signal completion */
+	efi_block_io2_complete ( token );
+
+	return 0;
+}
+
+/**
+ * Write to EFI block device (via block I/O2 protocol)
+ *
+ * @v block_io2		Block I/O2 protocol
+ * @v media		Media identifier
+ * @v lba		Starting LBA
+ * @v token		Transaction token
+ * @v len		Size of buffer
+ * @v data		Data buffer
+ * @ret efirc		EFI status code
+ */
+static EFI_STATUS EFIAPI
+efi_block_io2_write ( EFI_BLOCK_IO2_PROTOCOL *block_io2, UINT32 media,
+		      EFI_LBA lba, EFI_BLOCK_IO2_TOKEN *token, UINTN len,
+		      VOID *data ) {
+	struct efi_block_data *block =
+		container_of ( block_io2, struct efi_block_data, block_io2 );
+	EFI_STATUS efirc;
+
+	/* Perform write */
+	if ( ( efirc = efi_block_io_write ( &block->block_io, media, lba,
+					    len, data ) ) != 0 )
+		return efirc;
+
+	/* Signal completion */
+	efi_block_io2_complete ( token );
+
+	return 0;
+}
+
+/**
+ * Flush data to EFI block device (via block I/O2 protocol)
+ *
+ * @v block_io2		Block I/O2 protocol
+ * @v token		Transaction token
+ * @ret efirc		EFI status code
+ */
+static EFI_STATUS EFIAPI
+efi_block_io2_flush ( EFI_BLOCK_IO2_PROTOCOL *block_io2,
+		      EFI_BLOCK_IO2_TOKEN *token ) {
+	struct efi_block_data *block =
+		container_of ( block_io2, struct efi_block_data, block_io2 );
+	EFI_STATUS efirc;
+
+	/* Perform flush */
+	if ( ( efirc = efi_block_io_flush ( &block->block_io ) ) != 0 )
+		return efirc;
+
+	/* Signal completion */
+	efi_block_io2_complete ( token );
+
+	return 0;
+}
+
 /**
  * Connect all possible drivers to EFI block device
  *
@@ -275,6 +400,11 @@ static int efi_block_hook ( unsigned int drive, struct uri **uris,
 	block->block_io.ReadBlocks = efi_block_io_read;
 	block->block_io.WriteBlocks = efi_block_io_write;
 	block->block_io.FlushBlocks = efi_block_io_flush;
+	block->block_io2.Media = &block->media;
+	block->block_io2.Reset = efi_block_io2_reset;
+	block->block_io2.ReadBlocksEx = efi_block_io2_read;
+	block->block_io2.WriteBlocksEx = efi_block_io2_write;
+	block->block_io2.FlushBlocksEx = efi_block_io2_flush;
 
 	/* Register SAN device */
 	if ( ( rc = register_sandev ( sandev, drive, flags ) ) != 0 ) {
@@ -309,6 +439,7 @@ static int efi_block_hook ( unsigned int drive, struct uri **uris,
 	if ( ( efirc = bs->InstallMultipleProtocolInterfaces (
 			&block->handle,
 			&efi_block_io_protocol_guid, &block->block_io,
+			&efi_block_io2_protocol_guid, &block->block_io2,
 			&efi_device_path_protocol_guid, block->path,
 			NULL ) ) != 0 ) {
 		rc = -EEFI ( efirc );
@@ -327,6 +458,7 @@ static int efi_block_hook ( unsigned int drive, struct uri **uris,
 	if ( ( efirc = bs->UninstallMultipleProtocolInterfaces (
 			block->handle,
 			&efi_block_io_protocol_guid, &block->block_io,
+			&efi_block_io2_protocol_guid, &block->block_io2,
 			&efi_device_path_protocol_guid, block->path,
 			NULL ) ) != 0 ) {
 		DBGC ( drive, "EFIBLK %#02x could not uninstall protocols: "
@@ -334,6 +466,7 @@ static int efi_block_hook ( unsigned int drive, struct uri **uris,
 		leak = 1;
 	}
 	efi_nullify_block ( &block->block_io );
+	efi_nullify_block2 ( &block->block_io2 );
  err_install:
 	if ( ! leak )  {
 		free ( block->path );
@@ -377,6 +510,7 @@ static void efi_block_unhook ( unsigned int drive ) {
 	     ( ( efirc = bs->UninstallMultipleProtocolInterfaces (
 			block->handle,
 			&efi_block_io_protocol_guid, &block->block_io,
+			&efi_block_io2_protocol_guid, &block->block_io2,
 			&efi_device_path_protocol_guid, block->path,
 			NULL ) ) != 0 ) ) {
 		DBGC ( drive, "EFIBLK %#02x could not uninstall protocols: "
@@ -384,6 +518,7 @@ static void efi_block_unhook ( unsigned int drive ) {
 		leak = 1;
 	}
 	efi_nullify_block ( &block->block_io );
+	efi_nullify_block2 ( &block->block_io2 );
 
 	/* Free device path */
 	if ( ! leak ) {
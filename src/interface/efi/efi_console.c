@@ -205,14 +205,57 @@ static struct ansiesc_context efi_ansiesc_ctx = {
 /** EFI console UTF-8 accumulator */
 static struct utf8_accumulator efi_utf8_acc;
 
+/** Size of EFI console output batch buffer
+ *
+ * Some vendor firmware redraws the screen on every OutputString()
+ * call, making character-at-a-time output pathologically slow.
+ * Output is therefore batched and emitted via a single OutputString()
+ * per line (or per full buffer).
+ *
+ * This is a policy decision.
+ */
+#ifndef EFI_CONSOLE_OUTBUF_LEN
+#define EFI_CONSOLE_OUTBUF_LEN 256
+#endif
+
+/** EFI console output batch buffer */
+static wchar_t efi_outbuf[ EFI_CONSOLE_OUTBUF_LEN + 1 /* wNUL */ ];
+
+/** Number of characters in EFI console output batch buffer */
+static unsigned int efi_outbuf_len;
+
+/**
+ * Flush batched EFI console output
+ *
+ */
+static void efi_console_flush ( void ) {
+	EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL *conout = efi_systab->ConOut;
+
+	/* Do nothing if buffer is empty */
+	if ( ! efi_outbuf_len )
+		return;
+
+	/* Output and empty buffer */
+	efi_outbuf[efi_outbuf_len] = L'\0';
+	conout->OutputString ( conout, efi_outbuf );
+	efi_outbuf_len = 0;
+}
+
 /**
  * Print a character to EFI console
  *
  * @v character		Character to be printed
  */
 static void efi_putchar ( int character ) {
-	EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL *conout = efi_systab->ConOut;
-	wchar_t wstr[2];
+
+	/* Flush any batched output before processing an escape
+	 * sequence, since its handler may reposition the cursor,
+	 * change the character attributes, or clear the screen.
+	 * Nothing accumulates in the buffer while a sequence is in
+	 * progress, so flushing on the initial ESC is sufficient.
+	 */
+	if ( character == ESC )
+		efi_console_flush();
 
 	/* Intercept ANSI escape sequences */
 	character = ansiesc_process ( &efi_ansiesc_ctx, character );
@@ -228,10 +271,13 @@ static void efi_putchar ( int character ) {
 	if ( character & ~( ( wchar_t ) -1UL ) )
 		character = UTF8_INVALID;
 
-	/* Output character */
-	wstr[0] = character;
-	wstr[1] = L'\0';
-	conout->OutputString ( conout, wstr );
+	/* Add character to batch buffer */
+	efi_outbuf[efi_outbuf_len++] = character;
+
+	/* Flush on end of line or full buffer */
+	if ( ( character == L'\n' ) ||
+	     ( efi_outbuf_len == EFI_CONSOLE_OUTBUF_LEN ) )
+		efi_console_flush();
 }
 
 /**
@@ -307,6 +353,9 @@ static int efi_getchar ( void ) {
 	EFI_STATUS efirc;
 	int rc;
 
+	/* Flush any partial line (e.g. a prompt) before reading input */
+	efi_console_flush();
+
 	/* If we are mid-sequence, pass out the next byte */
 	if ( *ansi_input )
 		return *(ansi_input++);
@@ -390,6 +439,12 @@ static int efi_iskey ( void ) {
 	EFI_EVENT *event;
 	EFI_STATUS efirc;
 
+	/* Flush any partial line (e.g. a prompt), since every wait
+	 * loop polls for input: this guarantees that batched output
+	 * is displayed before iPXE idles.
+	 */
+	efi_console_flush();
+
 	/* If we are mid-sequence, we are always ready */
 	if ( *ansi_input )
 		return 1;
@@ -519,7 +519,15 @@ static int efi_driver_connect ( EFI_HANDLE device ) {
 	EFI_STATUS efirc;
 	int rc;
 
-	/* Check if we want to drive this device */
+	/* Check if we want to drive this device
+	 *
+	 * This check must happen before we disconnect any existing
+	 * drivers, so that controllers for which we have no driver are
+	 * left completely untouched.  Disconnection is itself further
+	 * filtered: only drivers that both claim to support the device
+	 * and provide an exclusion method will evict an existing
+	 * driver.
+	 */
 	if ( ( efirc = efi_driver_supported ( &efi_driver_binding, device,
 					      NULL ) ) != 0 ) {
 		/* Not supported; not an error */
@@ -654,6 +662,14 @@ static int efi_driver_handles ( int ( * method ) ( EFI_HANDLE handle ) ) {
  * Connect EFI driver to all possible devices
  *
  * @ret rc		Return status code
+ *
+ * Though this walks every handle in the system, it is effectively
+ * lazy: efi_driver_connect() probes each handle first and returns
+ * without side effects for any device that none of our drivers can
+ * support.  Note also that every driver in the EFI_DRIVERS table is a
+ * consumer of hardware or network-stack protocols; we never bind to
+ * storage controllers (SAN devices are exposed by efi_block.c as
+ * protocol producers instead), so there is no storage to defer.
  */
 int efi_driver_connect_all ( void ) {
 
@@ -84,6 +84,17 @@ struct efi_file {
 	const char *name;
 	/** Current file position */
 	size_t pos;
+	/** Cached file length (zero if not yet determined)
+	 *
+	 * Loaders such as bootmgfw read in small chunks with a
+	 * SetPosition() call before each Read(), and each seek needs
+	 * the file length; for the magic initrd file in particular,
+	 * determining the length means walking every image and
+	 * synthesising its CPIO headers.  The image list cannot
+	 * change while a file is open, so the length is computed at
+	 * most once per open.
+	 */
+	size_t len;
 	/**
 	 * Read from file
 	 *
@@ -161,16 +172,21 @@ static size_t efi_file_len ( struct efi_file *file ) {
 	if ( ! file->read )
 		return 0;
 
-	/* Initialise reader */
-	reader.file = file;
-	reader.pos = 0;
-	reader.data = NULL;
-	reader.len = 0;
+	/* Use cached length, if already determined */
+	if ( ! file->len ) {
 
-	/* Perform dummy read to determine file length */
-	file->read ( &reader );
+		/* Initialise reader */
+		reader.file = file;
+		reader.pos = 0;
+		reader.data = NULL;
+		reader.len = 0;
 
-	return reader.pos;
+		/* Perform dummy read to determine file length */
+		file->read ( &reader );
+		file->len = reader.pos;
+	}
+
+	return file->len;
 }
 
 /**
@@ -302,6 +318,9 @@ static EFI_STATUS efi_file_open_fixed ( struct efi_file *file,
 					const wchar_t *wname,
 					EFI_FILE_PROTOCOL **new ) {
 
+	/* Invalidate cached length, since fixed files are reused */
+	file->len = 0;
+
 	/* Increment reference count */
 	ref_get ( &file->refcnt );
 
@@ -323,6 +342,7 @@ static void efi_file_image ( struct efi_file *file, struct image *image ) {
 
 	file->image = image;
 	file->name = image->name;
+	file->len = 0;
 	file->read = efi_file_read_image;
 }
 
@@ -1121,6 +1141,11 @@ int efi_file_install ( EFI_HANDLE handle ) {
 	/* Reset root directory state */
 	efi_file_root.pos = 0;
 
+	/* Invalidate any cached magic initrd length, since the image
+	 * list may have changed since the previous installation.
+	 */
+	efi_file_initrd.file.len = 0;
+
 	/* Install the simple file system protocol, block I/O
 	 * protocol, and disk I/O protocol.  We don't have a block
 	 * device, but large parts of the EDK2 codebase make the
@@ -60,8 +60,21 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define EEFI_OPEN( efirc ) EPLATFORM ( EINFO_EEFI_OPEN, efirc,		\
 				       EEFI_OPEN_NOT_FOUND )
 
-/** Download blocksize */
-#define EFI_LOCAL_BLKSIZE 4096
+/** Download blocksize
+ *
+ * Reads from the file are synchronous, and so cost essentially one
+ * trip through the firmware's filesystem driver per call regardless
+ * of length.  Use a large blocksize to amortise this per-call
+ * overhead (falling back to smaller reads if a large I/O buffer
+ * cannot be allocated), since it determines the speed of local-media
+ * downloads.  This is a policy decision.
+ */
+#ifndef EFI_LOCAL_BLKSIZE
+#define EFI_LOCAL_BLKSIZE ( 512 * 1024 )
+#endif
+
+/** Minimum download blocksize */
+#define EFI_LOCAL_BLKSIZE_MIN 4096
 
 /** An EFI local file */
 struct efi_local {
@@ -464,6 +477,7 @@ static int efi_local_len ( struct efi_local *local ) {
  */
 static void efi_local_step ( struct efi_local *local ) {
 	struct io_buffer *iobuf = NULL;
+	size_t blksize = EFI_LOCAL_BLKSIZE;
 	size_t remaining;
 	size_t frag_len;
 	UINTN size;
@@ -499,12 +513,18 @@ static void efi_local_step ( struct efi_local *local ) {
 
 		/* Calculate length for this fragment */
 		frag_len = remaining;
-		if ( frag_len > EFI_LOCAL_BLKSIZE )
-			frag_len = EFI_LOCAL_BLKSIZE;
+		if ( frag_len > blksize )
+			frag_len = blksize;
 
-		/* Allocate I/O buffer */
+		/* Allocate I/O buffer, retrying with a smaller
+		 * blocksize if allocation fails.
+		 */
 		iobuf = xfer_alloc_iob ( &local->xfer, frag_len );
 		if ( ! iobuf ) {
+			if ( frag_len > EFI_LOCAL_BLKSIZE_MIN ) {
+				blksize = ( frag_len / 2 );
+				continue;
+			}
 			rc = -ENOMEM;
 			goto err;
 		}
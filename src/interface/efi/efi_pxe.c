@@ -920,6 +920,13 @@ efi_pxe_mtftp ( EFI_PXE_BASE_CODE_PROTOCOL *base,
 	/* Determine block size.  Ignore the requested block size
 	 * unless we are using callbacks, since limiting HTTP to a
 	 * 512-byte TCP window is not sensible.
+	 *
+	 * The value set here is returned as the flow control window
+	 * for the download.  The TFTP client derives its negotiated
+	 * "blksize" option from this window and independently
+	 * negotiates the RFC 7440 "windowsize" option, so transfers
+	 * through this shim are windowed whenever the server supports
+	 * it; nothing here forces lock-step operation.
 	 */
 	pxe->blksize = ( ( callback && blksize ) ? *blksize : -1UL );
 
@@ -33,6 +33,17 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * EFI random number generator protocol entropy source
  *
+ * This source is tried after the CPU hardware source (RDSEED/RDRAND,
+ * registered as ENTROPY_PREFERRED and enabled by default for EFI
+ * builds), and before the timer-tick source (ENTROPY_FALLBACK), which
+ * is therefore used only when both faster sources are unavailable.
+ *
+ * Note that DRBG seeding cannot simply consume one large GetRNG()
+ * read: the entropy core applies the SP800-90B repetition count and
+ * adaptive proportion health tests to individual noise samples, and a
+ * single opaque bulk read would bypass them.  Since GetRNG() reports
+ * nothing about the entropy content of its output, each 32-byte read
+ * is conservatively credited with a single bit.
  */
 
 struct entropy_source efirng_entropy __entropy_source ( ENTROPY_NORMAL );
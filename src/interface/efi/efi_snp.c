@@ -167,6 +167,7 @@ static void efi_snp_flush ( struct efi_snp_device *snpdev ) {
 static void efi_snp_poll ( struct efi_snp_device *snpdev ) {
 	EFI_BOOT_SERVICES *bs = efi_systab->BootServices;
 	struct io_buffer *iobuf;
+	int rx = 0;
 
 	/* Poll network device */
 	netdev_poll ( snpdev->netdev );
@@ -175,8 +176,12 @@ static void efi_snp_poll ( struct efi_snp_device *snpdev ) {
 	while ( ( iobuf = netdev_rx_dequeue ( snpdev->netdev ) ) ) {
 		list_add_tail ( &iobuf->list, &snpdev->rx );
 		snpdev->interrupts |= EFI_SIMPLE_NETWORK_RECEIVE_INTERRUPT;
-		bs->SignalEvent ( &snpdev->snp.WaitForPacket );
+		rx = 1;
 	}
+
+	/* Signal the WaitForPacket event (once per batch of packets) */
+	if ( rx )
+		bs->SignalEvent ( snpdev->snp.WaitForPacket );
 }
 
 /**
@@ -36,6 +36,20 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/** Alignment of large external memory allocations
+ *
+ * AllocatePages() guarantees only page alignment.  Large blocks (such
+ * as downloaded image buffers) are therefore placed in 2MB-aligned
+ * extents by over-allocating and freeing the unused head and tail, so
+ * that subsequent whole-image copies and relocations remain aligned
+ * to huge page boundaries throughout.
+ *
+ * This is a policy decision.
+ */
+#ifndef EFI_UMALLOC_ALIGN
+#define EFI_UMALLOC_ALIGN ( 2 * 1024 * 1024 )
+#endif
+
 /**
  * Reallocate external memory
  *
@@ -49,9 +63,11 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 static void * efi_urealloc ( void *old_ptr, size_t new_size ) {
 	EFI_BOOT_SERVICES *bs = efi_systab->BootServices;
 	EFI_PHYSICAL_ADDRESS phys_addr;
+	EFI_PHYSICAL_ADDRESS aligned;
 	unsigned int new_pages, old_pages;
+	unsigned int slack, head;
 	void *new_ptr = NOWHERE;
-	size_t old_size;
+	size_t old_size = 0;
 	size_t *info;
 	EFI_STATUS efirc;
 	int rc;
@@ -61,16 +77,44 @@ static void * efi_urealloc ( void *old_ptr, size_t new_size ) {
 	 */
 	if ( new_size ) {
 		new_pages = ( EFI_SIZE_TO_PAGES ( new_size ) + 1 );
+		slack = ( ( new_size >= EFI_UMALLOC_ALIGN ) ?
+			  EFI_SIZE_TO_PAGES ( EFI_UMALLOC_ALIGN ) : 0 );
 		if ( ( efirc = bs->AllocatePages ( AllocateAnyPages,
 						   EfiBootServicesData,
-						   new_pages,
+						   ( new_pages + slack ),
 						   &phys_addr ) ) != 0 ) {
 			rc = -EEFI ( efirc );
 			DBG ( "EFI could not allocate %d pages: %s\n",
-			      new_pages, strerror ( rc ) );
+			      ( new_pages + slack ), strerror ( rc ) );
 			return NULL;
 		}
 		assert ( phys_addr != 0 );
+
+		/* Trim large allocations so that the data region
+		 * (which starts one page beyond the size record) is
+		 * aligned to EFI_UMALLOC_ALIGN, freeing the unused
+		 * head and tail of the over-allocation.  Any failure
+		 * to free is a (non-fatal) leak.
+		 */
+		if ( slack ) {
+			aligned = ( ( ( phys_addr + EFI_PAGE_SIZE +
+					EFI_UMALLOC_ALIGN - 1 ) &
+				      ~( ( EFI_PHYSICAL_ADDRESS )
+					 ( EFI_UMALLOC_ALIGN - 1 ) ) ) -
+				    EFI_PAGE_SIZE );
+			head = ( EFI_SIZE_TO_PAGES ( aligned - phys_addr ) );
+			assert ( head <= slack );
+			if ( head )
+				bs->FreePages ( phys_addr, head );
+			if ( head < slack ) {
+				bs->FreePages ( ( aligned +
+						  ( ( EFI_PHYSICAL_ADDRESS )
+						    new_pages *
+						    EFI_PAGE_SIZE ) ),
+						( slack - head ) );
+			}
+			phys_addr = aligned;
+		}
 		new_ptr = phys_to_virt ( phys_addr + EFI_PAGE_SIZE );
 		info = ( new_ptr - EFI_PAGE_SIZE );
 		*info = new_size;
@@ -101,6 +145,9 @@ static void * efi_urealloc ( void *old_ptr, size_t new_size ) {
 		DBG ( "EFI freed %d pages at %llx\n", old_pages, phys_addr );
 	}
 
+	/* Update external memory usage statistics */
+	umalloc_account ( old_size, new_size );
+
 	return new_ptr;
 }
 
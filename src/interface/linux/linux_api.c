@@ -327,6 +327,20 @@ int __asmcall linux_socket ( int domain, int type, int protocol ) {
 	return ret;
 }
 
+/**
+ * Wrap setsockopt()
+ *
+ */
+int __asmcall linux_setsockopt ( int sockfd, int level, int optname,
+				 const void *optval, size_t optlen ) {
+	int ret;
+
+	ret = setsockopt ( sockfd, level, optname, optval, optlen );
+	if ( ret == -1 )
+		linux_errno = errno;
+	return ret;
+}
+
 /**
  * Wrap bind()
  *
@@ -513,6 +527,7 @@ PROVIDE_IPXE_SYM ( linux_mmap );
 PROVIDE_IPXE_SYM ( linux_mremap );
 PROVIDE_IPXE_SYM ( linux_munmap );
 PROVIDE_IPXE_SYM ( linux_socket );
+PROVIDE_IPXE_SYM ( linux_setsockopt );
 PROVIDE_IPXE_SYM ( linux_bind );
 PROVIDE_IPXE_SYM ( linux_sendto );
 PROVIDE_IPXE_SYM ( linux_strerror );
@@ -89,6 +89,7 @@ static void * linux_realloc(void *ptr, size_t size)
 			if (linux_munmap(mdptr, md.size))
 				DBG("linux_realloc munmap failed: %s\n", linux_strerror(linux_errno));
 			VALGRIND_FREELIKE_BLOCK(ptr, sizeof(*mdptr));
+			umalloc_account(md.size, 0);
 		}
 		return NOWHERE;
 	}
@@ -131,6 +132,9 @@ static void * linux_realloc(void *ptr, size_t size)
 		VALGRIND_MALLOCLIKE_BLOCK(ptr, size, SIZE_MD, 0);
 	}
 
+	/* Update external memory usage statistics */
+	umalloc_account(md.size, size);
+
 	/* Update the metadata */
 	VALGRIND_MAKE_MEM_DEFINED(mdptr, SIZE_MD);
 	mdptr->poison = POISON;
@@ -478,7 +478,7 @@ struct net80211_crypto ccmp_crypto __net80211_crypto = {
 static void ccmp_kie_mic ( const void *kck, const void *msg, size_t len,
 			   void *mic )
 {
-	u8 ctx[SHA1_CTX_SIZE + SHA1_BLOCK_SIZE];
+	u8 ctx[ 2 * SHA1_CTX_SIZE ];
 	u8 kckb[16];
 	u8 hash[SHA1_DIGEST_SIZE];
 
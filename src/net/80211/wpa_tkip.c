@@ -545,7 +545,7 @@ struct net80211_crypto tkip_crypto __net80211_crypto = {
 static void tkip_kie_mic ( const void *kck, const void *msg, size_t len,
 			   void *mic )
 {
-	uint8_t ctx[MD5_CTX_SIZE + MD5_BLOCK_SIZE];
+	uint8_t ctx[ 2 * MD5_CTX_SIZE ];
 	u8 kckb[16];
 
 	memcpy ( kckb, kck, sizeof ( kckb ) );
@@ -40,6 +40,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/uri.h>
 #include <ipxe/open.h>
 #include <ipxe/ata.h>
+#include <ipxe/blockdev.h>
 #include <ipxe/device.h>
 #include <ipxe/efi/efi_path.h>
 #include <ipxe/aoe.h>
@@ -528,6 +529,12 @@ static int aoecmd_cfg_rsp ( struct aoe_command *aoecmd, const void *data,
 	DBGC ( aoedev, "AoE %s has MAC address %s\n",
 	       aoedev_name ( aoedev ), ll_protocol->ntoa ( aoedev->target ) );
 
+	/* Clamp maximum number of sectors per command to the target's
+	 * advertised limit, if present.
+	 */
+	if ( aoecfg->scnt && ( aoecfg->scnt < aoedev->max_count ) )
+		aoedev->max_count = aoecfg->scnt;
+
 	return 0;
 }
 
@@ -730,6 +737,22 @@ static size_t aoedev_window ( struct aoe_device *aoedev ) {
 	return ( aoedev->configured ? ~( ( size_t ) 0 ) : 0 );
 }
 
+/**
+ * Update AoE device block device capacity
+ *
+ * @v aoedev		AoE device
+ * @v capacity		Block device capacity
+ */
+static void aoedev_ata_capacity ( struct aoe_device *aoedev,
+				  struct block_device_capacity *capacity ) {
+
+	/* Limit maximum number of blocks per transfer to fit within a
+	 * single frame and within the target's advertised limit.
+	 */
+	if ( aoedev->max_count < capacity->max_count )
+		capacity->max_count = aoedev->max_count;
+}
+
 /**
  * Handle AoE device configuration completion
  *
@@ -776,6 +799,7 @@ static struct acpi_descriptor * aoedev_describe ( struct aoe_device *aoedev ) {
 static struct interface_operation aoedev_ata_op[] = {
 	INTF_OP ( ata_command, struct aoe_device *, aoedev_ata_command ),
 	INTF_OP ( xfer_window, struct aoe_device *, aoedev_window ),
+	INTF_OP ( block_capacity, struct aoe_device *, aoedev_ata_capacity ),
 	INTF_OP ( intf_close, struct aoe_device *, aoedev_close ),
 	INTF_OP ( acpi_describe, struct aoe_device *, aoedev_describe ),
 	INTF_OP ( identify_device, struct aoe_device *,
@@ -826,6 +850,19 @@ static int aoedev_open ( struct interface *parent, struct net_device *netdev,
 		 netdev->ll_protocol->ll_addr_len );
 	acpi_init ( &aoedev->desc, &abft_model, &aoedev->refcnt );
 
+	/* Calculate maximum number of sectors per command.  Each
+	 * command's data must fit within a single frame, and the
+	 * configuration response may reduce this limit further.
+	 */
+	if ( netdev->mtu > ( sizeof ( struct aoehdr ) +
+			     sizeof ( struct aoeata ) ) ) {
+		aoedev->max_count =
+			( ( netdev->mtu - sizeof ( struct aoehdr ) -
+			    sizeof ( struct aoeata ) ) / ATA_SECTOR_SIZE );
+	}
+	if ( ! aoedev->max_count )
+		aoedev->max_count = 1;
+
 	/* Initiate configuration */
 	if ( ( rc = aoedev_cfg_command ( aoedev, &aoedev->config ) ) < 0 ) {
 		DBGC ( aoedev, "AoE %s could not initiate configuration: %s\n",
@@ -835,7 +872,7 @@ static int aoedev_open ( struct interface *parent, struct net_device *netdev,
 
 	/* Attach ATA device to parent interface */
 	if ( ( rc = ata_open ( parent, &aoedev->ata, ATA_DEV_MASTER,
-			       AOE_MAX_COUNT ) ) != 0 ) {
+			       aoedev->max_count ) ) != 0 ) {
 		DBGC ( aoedev, "AoE %s could not create ATA device: %s\n",
 		       aoedev_name ( aoedev ), strerror ( rc ) );
 		goto err_ata_open;
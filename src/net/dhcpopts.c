@@ -96,6 +96,48 @@ static unsigned int dhcp_option_len ( struct dhcp_option *option ) {
 	}
 }
 
+/**
+ * Build top-level option location index
+ *
+ * @v options		DHCP options block
+ *
+ * Records the offset of each top-level option, so that subsequent
+ * lookups need not re-scan the raw option bytes.  Encapsulated
+ * options are reached by indexing their encapsulator and scanning
+ * only within it.  The walk applies the same validation as option
+ * searching, so a malformed block simply produces a truncated index.
+ */
+static void build_dhcp_option_index ( struct dhcp_options *options ) {
+	struct dhcp_option *option;
+	unsigned int option_len;
+	int offset = 0;
+	ssize_t remaining = options->used_len;
+
+	options->index_len = 0;
+	options->indexed = 1;
+	options->index_complete = 1;
+	while ( remaining ) {
+		option = dhcp_option ( options, offset );
+		option_len = dhcp_option_len ( option );
+		remaining -= option_len;
+		if ( remaining < 0 )
+			break;
+		if ( option->tag == DHCP_END )
+			break;
+		if ( option->tag != DHCP_PAD ) {
+			if ( ( options->index_len == DHCPOPT_INDEX_COUNT ) ||
+			     ( offset > 0xffff ) ) {
+				options->index_complete = 0;
+				break;
+			}
+			options->index[options->index_len].tag = option->tag;
+			options->index[options->index_len].offset = offset;
+			options->index_len++;
+		}
+		offset += option_len;
+	}
+}
+
 /**
  * Find DHCP option within DHCP options block, and its encapsulator (if any)
  *
@@ -124,11 +166,37 @@ static int find_dhcp_option_with_encap ( struct dhcp_options *options,
 	int offset = 0;
 	ssize_t remaining = options->used_len;
 	unsigned int option_len;
+	unsigned int top;
+	unsigned int i;
 
 	/* Sanity check */
 	if ( tag == DHCP_PAD )
 		return -ENOENT;
 
+	/* Start search from the indexed location, if possible.  (The
+	 * index does not record the DHCP_END marker, so searches for
+	 * it fall through to the full scan.)
+	 */
+	if ( ! options->indexed )
+		build_dhcp_option_index ( options );
+	if ( tag != DHCP_END ) {
+		top = ( DHCP_IS_ENCAP_OPT ( tag ) ?
+			DHCP_ENCAPSULATOR ( tag ) : tag );
+		for ( i = 0 ; i < options->index_len ; i++ ) {
+			if ( options->index[i].tag == top )
+				break;
+		}
+		if ( i < options->index_len ) {
+			/* Restrict search to the indexed option */
+			offset = options->index[i].offset;
+			remaining =
+				dhcp_option_len ( dhcp_option ( options,
+								offset ) );
+		} else if ( options->index_complete ) {
+			return -ENOENT;
+		}
+	}
+
 	/* Search for option */
 	while ( remaining ) {
 		/* Calculate length of this option.  Abort processing
@@ -241,8 +309,9 @@ static int resize_dhcp_option ( struct dhcp_options *options,
 		encapsulator->len = new_encapsulator_len;
 	}
 
-	/* Update used length */
+	/* Update used length and discard location index */
 	options->used_len = new_used_len;
+	options->indexed = 0;
 
 	/* Move remainder of option data */
 	option = dhcp_option ( options, offset );
@@ -423,6 +492,9 @@ void dhcpopt_update_used_len ( struct dhcp_options *options ) {
 	ssize_t remaining = options->alloc_len;
 	unsigned int option_len;
 
+	/* Discard location index */
+	options->indexed = 0;
+
 	/* Find last non-pad option */
 	options->used_len = 0;
 	while ( remaining ) {
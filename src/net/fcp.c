@@ -52,6 +52,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Fibre Channel Protocol
  *
+ * FCP_DATA payloads are placed directly into the SCSI command's data
+ * buffer at the offset given by the frame's relative-offset field
+ * (carried as absolute-offset metadata by the exchange layer); there
+ * is no intermediate reassembly buffer.  Each command runs on its own
+ * exchange, so concurrency is limited only by the issuing block
+ * front-end, not by this layer.
  */
 
 /* Disambiguate the various error causes */
@@ -26,6 +26,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <ipxe/retry.h>
 #include <ipxe/timer.h>
 #include <ipxe/ipstat.h>
@@ -35,45 +36,334 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Fragment reassembly
  *
+ * Reassembly buffers are indexed by a hash of the fragmented packet
+ * identity, and the portions of each packet still awaited are tracked
+ * as a list of holes (as per RFC 815), allowing fragments to arrive
+ * in any order without ever requiring a rescan of previously received
+ * data.  All in-progress reassemblies share a single expiry timer,
+ * serviced in order of last activity.
  */
 
+/** A hole within a reassembly buffer */
+struct fragment_hole {
+	/** List of holes */
+	struct list_head list;
+	/** Start offset (within fragmentable portion) */
+	size_t start;
+	/** End offset (within fragmentable portion) */
+	size_t end;
+};
+
+/** End offset for a hole extending to the (as yet unknown) packet end */
+#define FRAGMENT_END_UNKNOWN ( ~( ( size_t ) 0 ) )
+
+/** List of all in-progress reassemblies, in order of expiry */
+static LIST_HEAD ( fragment_expiries );
+
+static void fragment_expired ( struct retry_timer *timer, int over );
+
+/** Shared fragment reassembly expiry timer */
+static struct retry_timer fragment_timer = TIMER_INIT ( fragment_expired );
+
 /**
- * Expire fragment reassembly buffer
+ * Free fragment reassembly buffer
+ *
+ * @v fragment		Fragment reassembly buffer
  *
- * @v timer		Retry timer
- * @v fail		Failure indicator
+ * The reassembled packet I/O buffer (if any) is not freed.
  */
-static void fragment_expired ( struct retry_timer *timer, int fail __unused ) {
-	struct fragment *fragment =
-		container_of ( timer, struct fragment, timer );
+static void fragment_free ( struct fragment *fragment ) {
+	struct fragment_hole *hole;
+	struct fragment_hole *tmp;
+
+	/* Free holes */
+	list_for_each_entry_safe ( hole, tmp, &fragment->holes, list ) {
+		list_del ( &hole->list );
+		free ( hole );
+	}
 
-	DBGC ( fragment, "FRAG %p expired\n", fragment );
-	free_iob ( fragment->iobuf );
+	/* Remove from hash bucket and expiry list */
 	list_del ( &fragment->list );
-	fragment->fragments->stats->reasm_fails++;
+	list_del ( &fragment->expiry );
+
+	/* Stop expiry timer if no reassemblies remain in progress */
+	if ( list_empty ( &fragment_expiries ) )
+		stop_timer ( &fragment_timer );
+
 	free ( fragment );
 }
 
+/**
+ * Expire fragment reassembly buffers
+ *
+ * @v timer		Expiry timer
+ * @v over		Failure indicator
+ */
+static void fragment_expired ( struct retry_timer *timer, int over __unused ) {
+	struct fragment *fragment;
+	struct fragment *tmp;
+	unsigned long now = currticks();
+
+	list_for_each_entry_safe ( fragment, tmp, &fragment_expiries, expiry ) {
+
+		/* Restart timer when we reach the first unexpired entry */
+		if ( ( ( signed long ) ( fragment->expires - now ) ) > 0 ) {
+			start_timer_fixed ( timer,
+					    ( fragment->expires - now ) );
+			break;
+		}
+
+		/* Expire this entry */
+		DBGC ( fragment, "FRAG %p expired\n", fragment );
+		free_iob ( fragment->iobuf );
+		fragment->fragments->stats->reasm_fails++;
+		fragment_free ( fragment );
+	}
+}
+
+/**
+ * Record activity on a fragment reassembly buffer
+ *
+ * @v fragment		Fragment reassembly buffer
+ *
+ * Resets the reassembly timeout.  Since all reassemblies share a
+ * fixed timeout, moving the entry to the tail of the expiry list
+ * keeps the list sorted in order of expiry.
+ */
+static void fragment_touch ( struct fragment *fragment ) {
+
+	fragment->expires = ( currticks() + FRAGMENT_TIMEOUT );
+	list_del ( &fragment->expiry );
+	list_add_tail ( &fragment->expiry, &fragment_expiries );
+	if ( ! timer_running ( &fragment_timer ) )
+		start_timer_fixed ( &fragment_timer, FRAGMENT_TIMEOUT );
+}
+
 /**
  * Find fragment reassembly buffer
  *
  * @v fragments		Fragment reassembler
+ * @v bucket		Hash bucket
+ * @v hash		Hash of fragmented packet identity
  * @v iobuf		I/O buffer
  * @v hdrlen		Length of non-fragmentable potion of I/O buffer
  * @ret fragment	Fragment reassembly buffer, or NULL if not found
  */
 static struct fragment * fragment_find ( struct fragment_reassembler *fragments,
+					 struct list_head *bucket,
+					 unsigned int hash,
 					 struct io_buffer *iobuf,
 					 size_t hdrlen ) {
 	struct fragment *fragment;
 
-	list_for_each_entry ( fragment, &fragments->list, list ) {
-		if ( fragments->is_fragment ( fragment, iobuf, hdrlen ) )
+	list_for_each_entry ( fragment, bucket, list ) {
+		if ( ( fragment->hash == hash ) &&
+		     fragments->is_fragment ( fragment, iobuf, hdrlen ) )
 			return fragment;
 	}
 	return NULL;
 }
 
+/**
+ * Create fragment reassembly buffer
+ *
+ * @v fragments		Fragment reassembler
+ * @v bucket		Hash bucket
+ * @v hash		Hash of fragmented packet identity
+ * @v iobuf		I/O buffer
+ * @v hdrlen		Length of non-fragmentable potion of I/O buffer
+ * @v offset		Fragment offset
+ * @ret fragment	Fragment reassembly buffer, or NULL on error
+ *
+ * If the fragment offset is zero then ownership of the I/O buffer is
+ * transferred to the reassembly buffer.
+ */
+static struct fragment *
+fragment_create ( struct fragment_reassembler *fragments,
+		  struct list_head *bucket, unsigned int hash,
+		  struct io_buffer *iobuf, size_t hdrlen, size_t offset ) {
+	struct fragment *fragment;
+	struct fragment_hole *hole;
+	size_t len = ( iob_len ( iobuf ) - hdrlen );
+
+	/* Allocate and initialise structure */
+	fragment = zalloc ( sizeof ( *fragment ) );
+	if ( ! fragment )
+		goto err_alloc;
+	list_add ( &fragment->list, bucket );
+	INIT_LIST_HEAD ( &fragment->expiry );
+	INIT_LIST_HEAD ( &fragment->holes );
+	fragment->hash = hash;
+	fragment->hdrlen = hdrlen;
+	fragment->fragments = fragments;
+
+	/* Create hole covering the as yet unreceived portion */
+	hole = zalloc ( sizeof ( *hole ) );
+	if ( ! hole )
+		goto err_hole;
+	hole->end = FRAGMENT_END_UNKNOWN;
+	list_add ( &hole->list, &fragment->holes );
+
+	if ( offset == 0 ) {
+
+		/* First fragment: take over I/O buffer (including
+		 * headroom, to allow for code which modifies and
+		 * resends the buffer, e.g. ICMP echo responses).
+		 */
+		fragment->iobuf = iobuf;
+		hole->start = len;
+
+	} else {
+
+		/* First fragment has not yet arrived: create a
+		 * reassembly buffer using the non-fragmentable
+		 * portion of this fragment as the packet header.
+		 * (The non-fragmentable portion is identical across
+		 * fragments in all respects that will matter after
+		 * reassembly completes.)
+		 */
+		fragment->iobuf = alloc_iob ( iob_headroom ( iobuf ) + hdrlen +
+					      offset + len );
+		if ( ! fragment->iobuf )
+			goto err_iobuf;
+		iob_reserve ( fragment->iobuf, iob_headroom ( iobuf ) );
+		memcpy ( iob_put ( fragment->iobuf, hdrlen ), iobuf->data,
+			 hdrlen );
+	}
+
+	DBGC ( fragment, "FRAG %p created for [%zd,%zd)\n",
+	       fragment, offset, ( offset + len ) );
+	return fragment;
+
+ err_iobuf:
+ err_hole:
+	fragment_free ( fragment );
+ err_alloc:
+	return NULL;
+}
+
+/**
+ * Copy fragment into reassembly buffer
+ *
+ * @v fragment		Fragment reassembly buffer
+ * @v start		Start offset (within fragmentable portion)
+ * @v data		Fragment payload
+ * @v len		Length of fragment payload
+ * @ret rc		Return status code
+ */
+static int fragment_write ( struct fragment *fragment, size_t start,
+			    const void *data, size_t len ) {
+	struct io_buffer *iobuf = fragment->iobuf;
+	struct io_buffer *new_iobuf;
+	size_t headroom = iob_headroom ( iobuf );
+	size_t filled = ( iob_len ( iobuf ) - fragment->hdrlen );
+	size_t end = ( start + len );
+	size_t new_len;
+
+	/* Grow reassembly buffer geometrically if required, so that
+	 * the total cost of copying remains linear in the packet
+	 * length regardless of the number of fragments.
+	 */
+	if ( ( end > filled ) &&
+	     ( ( end - filled ) > iob_tailroom ( iobuf ) ) ) {
+		new_len = ( 2 * ( headroom + iob_len ( iobuf ) +
+				  iob_tailroom ( iobuf ) ) );
+		if ( new_len < ( headroom + fragment->hdrlen + end ) )
+			new_len = ( headroom + fragment->hdrlen + end );
+		new_iobuf = alloc_iob ( new_len );
+		if ( ! new_iobuf ) {
+			DBGC ( fragment, "FRAG %p could not extend reassembly "
+			       "buffer to %zd bytes\n", fragment, new_len );
+			return -ENOMEM;
+		}
+		iob_reserve ( new_iobuf, headroom );
+		memcpy ( iob_put ( new_iobuf, iob_len ( iobuf ) ),
+			 iobuf->data, iob_len ( iobuf ) );
+		free_iob ( iobuf );
+		fragment->iobuf = iobuf = new_iobuf;
+	}
+
+	/* Extend buffer length to cover this fragment, if applicable */
+	if ( end > filled )
+		iob_put ( iobuf, ( end - filled ) );
+
+	/* Copy fragment into place */
+	memcpy ( ( iobuf->data + fragment->hdrlen + start ), data, len );
+
+	return 0;
+}
+
+/**
+ * Mark a range of the reassembly buffer as filled
+ *
+ * @v fragment		Fragment reassembly buffer
+ * @v start		Start offset (within fragmentable portion)
+ * @v end		End offset (within fragmentable portion)
+ * @ret rc		Return status code
+ */
+static int fragment_punch ( struct fragment *fragment, size_t start,
+			    size_t end ) {
+	struct fragment_hole *hole;
+	struct fragment_hole *tmp;
+	struct fragment_hole *split;
+
+	list_for_each_entry_safe ( hole, tmp, &fragment->holes, list ) {
+
+		/* Holes are sorted: stop once past the filled range */
+		if ( hole->start >= end )
+			break;
+
+		/* Ignore holes wholly before the filled range */
+		if ( hole->end <= start )
+			continue;
+
+		if ( ( start <= hole->start ) && ( end >= hole->end ) ) {
+			/* Hole is filled completely */
+			list_del ( &hole->list );
+			free ( hole );
+		} else if ( start <= hole->start ) {
+			/* Start of hole is filled */
+			hole->start = end;
+		} else if ( end >= hole->end ) {
+			/* End of hole is filled */
+			hole->end = start;
+		} else {
+			/* Middle of hole is filled: split into two */
+			split = zalloc ( sizeof ( *split ) );
+			if ( ! split )
+				return -ENOMEM;
+			split->start = end;
+			split->end = hole->end;
+			hole->end = start;
+			list_add ( &split->list, &hole->list );
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Record overall fragmentable length
+ *
+ * @v fragment		Fragment reassembly buffer
+ * @v total		Length of fragmentable portion
+ */
+static void fragment_trim ( struct fragment *fragment, size_t total ) {
+	struct fragment_hole *hole;
+	struct fragment_hole *tmp;
+
+	fragment->total = total;
+	list_for_each_entry_safe ( hole, tmp, &fragment->holes, list ) {
+		if ( hole->start >= total ) {
+			list_del ( &hole->list );
+			free ( hole );
+		} else if ( hole->end > total ) {
+			hole->end = total;
+		}
+	}
+}
+
 /**
  * Reassemble packet
  *
@@ -89,91 +379,85 @@ struct io_buffer * fragment_reassemble ( struct fragment_reassembler *fragments,
 					 struct io_buffer *iobuf,
 					 size_t *hdrlen ) {
 	struct fragment *fragment;
-	struct io_buffer *new_iobuf;
-	size_t new_len;
+	struct list_head *bucket;
+	unsigned int hash;
+	unsigned int i;
 	size_t offset;
-	size_t expected_offset;
+	size_t end;
 	int more_frags;
+	int rc;
 
 	/* Update statistics */
 	fragments->stats->reasm_reqds++;
 
+	/* Initialise hash buckets on first use */
+	if ( ! fragments->buckets[0].next ) {
+		for ( i = 0 ; i < FRAGMENT_BUCKETS ; i++ )
+			INIT_LIST_HEAD ( &fragments->buckets[i] );
+	}
+
 	/* Find matching fragment reassembly buffer, if any */
-	fragment = fragment_find ( fragments, iobuf, *hdrlen );
+	hash = fragments->fragment_hash ( iobuf, *hdrlen );
+	bucket = &fragments->buckets[ hash % FRAGMENT_BUCKETS ];
+	fragment = fragment_find ( fragments, bucket, hash, iobuf, *hdrlen );
 
-	/* Drop out-of-order fragments */
+	/* Determine fragment position */
 	offset = fragments->fragment_offset ( iobuf, *hdrlen );
-	expected_offset = ( fragment ? ( iob_len ( fragment->iobuf ) -
-					 fragment->hdrlen ) : 0 );
-	if ( offset != expected_offset ) {
-		DBGC ( fragment, "FRAG %p dropping out-of-sequence fragment "
-		       "[%zd,%zd), expected [%zd,...)\n", fragment, offset,
-		       ( offset + iob_len ( iobuf ) - *hdrlen ),
-		       expected_offset );
-		goto drop;
-	}
+	end = ( offset + iob_len ( iobuf ) - *hdrlen );
+	more_frags = fragments->more_fragments ( iobuf, *hdrlen );
 
-	/* Create or extend fragment reassembly buffer as applicable */
+	/* Create fragment reassembly buffer, if applicable */
 	if ( ! fragment ) {
-
-		/* Create new fragment reassembly buffer */
-		fragment = zalloc ( sizeof ( *fragment ) );
+		fragment = fragment_create ( fragments, bucket, hash, iobuf,
+					     *hdrlen, offset );
 		if ( ! fragment )
 			goto drop;
-		list_add ( &fragment->list, &fragments->list );
-		fragment->iobuf = iobuf;
-		fragment->hdrlen = *hdrlen;
-		timer_init ( &fragment->timer, fragment_expired, NULL );
-		fragment->fragments = fragments;
-		DBGC ( fragment, "FRAG %p [0,%zd)\n", fragment,
-		       ( iob_len ( iobuf ) - *hdrlen ) );
+		if ( offset == 0 ) {
+			/* I/O buffer (and payload) taken over by
+			 * fragment_create()
+			 */
+			iobuf = NULL;
+		}
+	}
+	DBGC ( fragment, "FRAG %p [%zd,%zd)%s\n", fragment, offset, end,
+	       ( more_frags ? "" : " final" ) );
 
-	} else {
+	/* Record overall length when the final fragment is seen */
+	if ( ( ! more_frags ) && ( ! fragment->total ) )
+		fragment_trim ( fragment, end );
 
-		/* Check if this is the final fragment */
-		more_frags = fragments->more_fragments ( iobuf, *hdrlen );
-		DBGC ( fragment, "FRAG %p [%zd,%zd)%s\n", fragment,
-		       offset, ( offset + iob_len ( iobuf ) - *hdrlen ),
-		       ( more_frags ? "" : " complete" ) );
+	/* Ignore any data beyond the overall length */
+	if ( fragment->total && ( end > fragment->total ) )
+		end = fragment->total;
 
-		/* Extend fragment reassembly buffer.  Preserve I/O
-		 * buffer headroom to allow for code which modifies
-		 * and resends the buffer (e.g. ICMP echo responses).
-		 */
-		iob_pull ( iobuf, *hdrlen );
-		new_len = ( iob_headroom ( fragment->iobuf ) +
-			    iob_len ( fragment->iobuf ) + iob_len ( iobuf ) );
-		new_iobuf = alloc_iob ( new_len );
-		if ( ! new_iobuf ) {
-			DBGC ( fragment, "FRAG %p could not extend reassembly "
-			       "buffer to %zd bytes\n", fragment, new_len );
+	/* Copy payload into place and fill the corresponding holes.
+	 * Failures here drop only the arriving fragment: the
+	 * reassembly buffer remains valid and will eventually either
+	 * complete (via a retransmission) or expire.
+	 */
+	if ( iobuf && ( offset < end ) ) {
+		if ( ( rc = fragment_write ( fragment, offset,
+					     ( iobuf->data + *hdrlen ),
+					     ( end - offset ) ) ) != 0 )
 			goto drop;
-		}
-		iob_reserve ( new_iobuf, iob_headroom ( fragment->iobuf ) );
-		memcpy ( iob_put ( new_iobuf, iob_len ( fragment->iobuf ) ),
-			 fragment->iobuf->data, iob_len ( fragment->iobuf ) );
-		memcpy ( iob_put ( new_iobuf, iob_len ( iobuf ) ),
-			 iobuf->data, iob_len ( iobuf ) );
-		free_iob ( fragment->iobuf );
-		fragment->iobuf = new_iobuf;
-		free_iob ( iobuf );
+		if ( ( rc = fragment_punch ( fragment, offset, end ) ) != 0 )
+			goto drop;
+	}
+	free_iob ( iobuf );
 
-		/* Stop fragment reassembly timer */
-		stop_timer ( &fragment->timer );
-
-		/* If this is the final fragment, return it */
-		if ( ! more_frags ) {
-			iobuf = fragment->iobuf;
-			*hdrlen = fragment->hdrlen;
-			list_del ( &fragment->list );
-			free ( fragment );
-			fragments->stats->reasm_oks++;
-			return iobuf;
-		}
+	/* If packet is now complete, return it */
+	if ( fragment->total && list_empty ( &fragment->holes ) ) {
+		iobuf = fragment->iobuf;
+		*hdrlen = fragment->hdrlen;
+		DBGC ( fragment, "FRAG %p complete at %zd+%zd bytes\n",
+		       fragment, fragment->hdrlen, fragment->total );
+		fragment_free ( fragment );
+		fragments->stats->reasm_oks++;
+		return iobuf;
 	}
 
-	/* (Re)start fragment reassembly timer */
-	start_timer_fixed ( &fragment->timer, FRAGMENT_TIMEOUT );
+	/* Reset reassembly timeout */
+	fragment_touch ( fragment );
 
 	return NULL;
 
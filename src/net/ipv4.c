@@ -31,6 +31,7 @@
 #include <ipxe/list.h>
 #include <ipxe/in.h>
 #include <ipxe/arp.h>
+#include <ipxe/neighbour.h>
 #include <ipxe/if_ether.h>
 #include <ipxe/iobuf.h>
 #include <ipxe/netdevice.h>
@@ -56,6 +57,21 @@ static uint8_t next_ident_high = 0;
 /** List of IPv4 miniroutes */
 struct list_head ipv4_miniroutes = LIST_HEAD_INIT ( ipv4_miniroutes );
 
+/** IPv4 route cache (most recent successful lookup)
+ *
+ * iPXE traffic is typically a single flow to a single server, so a
+ * one-entry cache allows almost every transmitted packet to skip the
+ * routing table scan entirely.
+ */
+static struct {
+	/** Destination address (prior to any gateway substitution) */
+	struct in_addr dest;
+	/** Destination address scope ID */
+	unsigned int scope_id;
+	/** Routing table entry */
+	struct ipv4_miniroute *miniroute;
+} ipv4_route_cache;
+
 /** IPv4 statistics */
 static struct ip_statistics ipv4_stats;
 
@@ -85,6 +101,7 @@ static int add_ipv4_miniroute ( struct net_device *netdev,
 				struct in_addr address, struct in_addr netmask,
 				struct in_addr gateway ) {
 	struct ipv4_miniroute *miniroute;
+	struct ipv4_miniroute *before;
 	struct in_addr hostmask;
 	struct in_addr broadcast;
 
@@ -115,14 +132,19 @@ static int add_ipv4_miniroute ( struct net_device *netdev,
 	miniroute->hostmask = hostmask;
 	miniroute->gateway = gateway;
 
-	/* Add to end of list if we have a gateway, otherwise
-	 * to start of list.
+	/* Insert into routing table, sorted by descending prefix
+	 * length, so that the first matching entry found is always
+	 * the longest-prefix match.
 	 */
-	if ( gateway.s_addr ) {
-		list_add_tail ( &miniroute->list, &ipv4_miniroutes );
-	} else {
-		list_add ( &miniroute->list, &ipv4_miniroutes );
+	list_for_each_entry ( before, &ipv4_miniroutes, list ) {
+		if ( ntohl ( before->netmask.s_addr ) <
+		     ntohl ( netmask.s_addr ) )
+			break;
 	}
+	list_add_tail ( &miniroute->list, &before->list );
+
+	/* Invalidate route cache */
+	ipv4_route_cache.miniroute = NULL;
 
 	return 0;
 }
@@ -141,6 +163,10 @@ static void del_ipv4_miniroute ( struct ipv4_miniroute *miniroute ) {
 		DBGC ( netdev, "gw %s ", inet_ntoa ( miniroute->gateway ) );
 	DBGC ( netdev, "via %s\n", miniroute->netdev->name );
 
+	/* Invalidate route cache, if applicable */
+	if ( ipv4_route_cache.miniroute == miniroute )
+		ipv4_route_cache.miniroute = NULL;
+
 	netdev_put ( miniroute->netdev );
 	list_del ( &miniroute->list );
 	free ( miniroute );
@@ -160,43 +186,78 @@ static void del_ipv4_miniroute ( struct ipv4_miniroute *miniroute ) {
 static struct ipv4_miniroute * ipv4_route ( unsigned int scope_id,
 					    struct in_addr *dest ) {
 	struct ipv4_miniroute *miniroute;
-
-	/* Find first usable route in routing table */
-	list_for_each_entry ( miniroute, &ipv4_miniroutes, list ) {
-
-		/* Skip closed network devices */
-		if ( ! netdev_is_open ( miniroute->netdev ) )
-			continue;
-
-		if ( IN_IS_MULTICAST ( dest->s_addr ) ) {
-
-			/* If destination is non-global, and the scope ID
-			 * matches this network device, then use this route.
-			 */
-			if ( miniroute->netdev->scope_id == scope_id )
-				return miniroute;
-
-		} else {
-
-			/* If destination is an on-link global
-			 * address, then use this route.
-			 */
-			if ( ( ( dest->s_addr ^ miniroute->address.s_addr )
-			       & miniroute->netmask.s_addr ) == 0 )
-				return miniroute;
-
-			/* If destination is an off-link global
-			 * address, and we have a default gateway,
-			 * then use this route.
-			 */
-			if ( miniroute->gateway.s_addr ) {
-				*dest = miniroute->gateway;
-				return miniroute;
+	struct ipv4_miniroute *candidate;
+	struct ipv4_miniroute *deflt = NULL;
+
+	/* Use cached lookup, if applicable */
+	miniroute = ipv4_route_cache.miniroute;
+	if ( ( ! miniroute ) ||
+	     ( dest->s_addr != ipv4_route_cache.dest.s_addr ) ||
+	     ( scope_id != ipv4_route_cache.scope_id ) ||
+	     ( ! netdev_is_open ( miniroute->netdev ) ) ) {
+
+		/* Find best usable route in routing table */
+		miniroute = NULL;
+		list_for_each_entry ( candidate, &ipv4_miniroutes, list ) {
+
+			/* Skip closed network devices */
+			if ( ! netdev_is_open ( candidate->netdev ) )
+				continue;
+
+			if ( IN_IS_MULTICAST ( dest->s_addr ) ) {
+
+				/* If destination is non-global, and
+				 * the scope ID matches this network
+				 * device, then use this route.
+				 */
+				if ( candidate->netdev->scope_id == scope_id ) {
+					miniroute = candidate;
+					break;
+				}
+
+			} else {
+
+				/* If destination is an on-link global
+				 * address, then use this route.  The
+				 * table is sorted by descending
+				 * prefix length, so the first match
+				 * is the longest-prefix match.
+				 */
+				if ( ( ( dest->s_addr ^
+					 candidate->address.s_addr )
+				       & candidate->netmask.s_addr ) == 0 ) {
+					miniroute = candidate;
+					break;
+				}
+
+				/* Record first default gateway, for
+				 * use if no on-link route exists.
+				 */
+				if ( ( ! deflt ) && candidate->gateway.s_addr )
+					deflt = candidate;
 			}
 		}
+		if ( ! miniroute )
+			miniroute = deflt;
+		if ( ! miniroute )
+			return NULL;
+
+		/* Update route cache */
+		ipv4_route_cache.miniroute = miniroute;
+		ipv4_route_cache.dest = *dest;
+		ipv4_route_cache.scope_id = scope_id;
+	}
+
+	/* If destination is an off-link global address, then use the
+	 * gateway as the next hop.
+	 */
+	if ( ( ! IN_IS_MULTICAST ( dest->s_addr ) ) &&
+	     ( ( ( dest->s_addr ^ miniroute->address.s_addr )
+		 & miniroute->netmask.s_addr ) != 0 ) ) {
+		*dest = miniroute->gateway;
 	}
 
-	return NULL;
+	return miniroute;
 }
 
 /**
@@ -233,7 +294,24 @@ static int ipv4_is_fragment ( struct fragment *fragment,
 	struct iphdr *iphdr = iobuf->data;
 
 	return ( ( iphdr->src.s_addr == frag_iphdr->src.s_addr ) &&
-		 ( iphdr->ident == frag_iphdr->ident ) );
+		 ( iphdr->dest.s_addr == frag_iphdr->dest.s_addr ) &&
+		 ( iphdr->ident == frag_iphdr->ident ) &&
+		 ( iphdr->protocol == frag_iphdr->protocol ) );
+}
+
+/**
+ * Calculate hash of IPv4 fragmented packet identity
+ *
+ * @v iobuf		I/O buffer
+ * @v hdrlen		Length of non-fragmentable potion of I/O buffer
+ * @ret hash		Hash value
+ */
+static unsigned int ipv4_fragment_hash ( struct io_buffer *iobuf,
+					 size_t hdrlen __unused ) {
+	struct iphdr *iphdr = iobuf->data;
+
+	return ( iphdr->src.s_addr ^ iphdr->dest.s_addr ^
+		 iphdr->ident ^ iphdr->protocol );
 }
 
 /**
@@ -266,7 +344,7 @@ static int ipv4_more_fragments ( struct io_buffer *iobuf,
 
 /** IPv4 fragment reassembler */
 static struct fragment_reassembler ipv4_reassembler = {
-	.list = LIST_HEAD_INIT ( ipv4_reassembler.list ),
+	.fragment_hash = ipv4_fragment_hash,
 	.is_fragment = ipv4_is_fragment,
 	.fragment_offset = ipv4_fragment_offset,
 	.more_fragments = ipv4_more_fragments,
@@ -822,6 +900,24 @@ const struct setting gateway_setting __setting ( SETTING_IP4, gateway ) = {
 	.type = &setting_type_ipv4,
 };
 
+/** Gateway link-layer address setting
+ *
+ * Fetching the built-in ${gateway-mac} setting returns the default
+ * gateway's link-layer address as currently recorded in the neighbour
+ * cache, allowing it to be exported (e.g. into a generated script for
+ * a subsequent boot stage).  Storing a value into a network device's
+ * settings block (e.g. "set netX/gateway-mac ...") seeds the
+ * neighbour cache with that address, so that the first transmitted
+ * packet never has to wait for ARP.
+ */
+const struct setting gateway_mac_setting __setting ( SETTING_MISC,
+						     gateway-mac ) = {
+	.name = "gateway-mac",
+	.description = "Gateway MAC address",
+	.type = &setting_type_hex,
+	.scope = &builtin_scope,
+};
+
 /**
  * Send gratuitous ARP, if applicable
  *
@@ -854,6 +950,98 @@ static int ipv4_gratuitous_arp ( struct net_device *netdev,
 	return 0;
 }
 
+/**
+ * Warm up neighbour cache for gateway, if applicable
+ *
+ * @v netdev		Network device
+ * @v address		IPv4 address
+ * @v netmask		Subnet mask
+ * @v gateway		Gateway address (if any)
+ * @ret rc		Return status code
+ */
+static int ipv4_resolve_gateway ( struct net_device *netdev,
+				  struct in_addr address,
+				  struct in_addr netmask __unused,
+				  struct in_addr gateway ) {
+	uint8_t ll_dest[MAX_LL_ADDR_LEN];
+	int len;
+	int rc;
+
+	/* Do nothing unless we have a gateway */
+	if ( ! gateway.s_addr )
+		return 0;
+
+	/* Adopt a gateway link-layer address provided via settings,
+	 * if present, avoiding the ARP round trip entirely.
+	 */
+	len = fetch_raw_setting ( netdev_settings ( netdev ),
+				  &gateway_mac_setting, ll_dest,
+				  sizeof ( ll_dest ) );
+	if ( len == ( ( int ) netdev->ll_protocol->ll_addr_len ) ) {
+		if ( ( rc = neighbour_define ( netdev, &ipv4_protocol,
+					       &gateway, ll_dest ) ) == 0 ) {
+			DBGC ( netdev, "IPv4 adopted gateway MAC for %s via "
+			       "%s\n", inet_ntoa ( gateway ), netdev->name );
+			return 0;
+		}
+		/* Fall back to discovery */
+	}
+
+	/* Otherwise, begin resolving the gateway now, so that the
+	 * link-layer address is usually already known by the time the
+	 * first data packet needs it.
+	 */
+	if ( ( rc = neighbour_probe ( netdev, &ipv4_protocol, &gateway,
+				      &arp_discovery, &address ) ) != 0 ) {
+		DBGC ( netdev, "IPv4 could not start gateway discovery: %s\n",
+		       strerror ( rc ) );
+		/* Treat failures as non-fatal */
+	}
+
+	return 0;
+}
+
+/**
+ * Fetch gateway link-layer address for export via settings
+ *
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int ipv4_fetch_gateway_mac ( void *data, size_t len ) {
+	struct ipv4_miniroute *miniroute;
+	struct net_device *netdev;
+	uint8_t ll_dest[MAX_LL_ADDR_LEN];
+	size_t ll_len;
+	int rc;
+
+	/* Use first open route with a resolved gateway */
+	list_for_each_entry ( miniroute, &ipv4_miniroutes, list ) {
+		netdev = miniroute->netdev;
+		if ( ! miniroute->gateway.s_addr )
+			continue;
+		if ( ! netdev_is_open ( netdev ) )
+			continue;
+		if ( ( rc = neighbour_fetch ( netdev, &ipv4_protocol,
+					      &miniroute->gateway,
+					      ll_dest ) ) != 0 )
+			continue;
+		ll_len = netdev->ll_protocol->ll_addr_len;
+		if ( len > ll_len )
+			len = ll_len;
+		memcpy ( data, ll_dest, len );
+		return ll_len;
+	}
+
+	return -ENOENT;
+}
+
+/** Gateway link-layer address built-in setting fetcher */
+struct builtin_setting gateway_mac_builtin_setting __builtin_setting = {
+	.setting = &gateway_mac_setting,
+	.fetch = ipv4_fetch_gateway_mac,
+};
+
 /**
  * Process IPv4 network device settings
  *
@@ -929,6 +1117,9 @@ static int ipv4_create_routes ( void ) {
 	if ( ( rc = ipv4_settings ( add_ipv4_miniroute ) ) != 0 )
 		return rc;
 
+	/* Warm up neighbour cache for any gateways */
+	ipv4_settings ( ipv4_resolve_gateway );
+
 	return 0;
 }
 
@@ -59,6 +59,21 @@ FILE_LICENCE ( GPL2_OR_LATER );
 /** List of IPv6 miniroutes */
 struct list_head ipv6_miniroutes = LIST_HEAD_INIT ( ipv6_miniroutes );
 
+/** IPv6 route cache (most recent successful lookup)
+ *
+ * iPXE traffic is typically a single flow to a single server, so a
+ * one-entry cache allows almost every transmitted packet to skip the
+ * routing table scan entirely.
+ */
+static struct {
+	/** Destination address (prior to any router substitution) */
+	struct in6_addr dest;
+	/** Destination address scope ID */
+	unsigned int scope_id;
+	/** Routing table entry */
+	struct ipv6_miniroute *miniroute;
+} ipv6_route_cache;
+
 /** IPv6 statistics */
 static struct ip_statistics ipv6_stats;
 
@@ -217,6 +232,7 @@ static struct ipv6_miniroute * ipv6_miniroute ( struct net_device *netdev,
 int ipv6_add_miniroute ( struct net_device *netdev, struct in6_addr *address,
 			 unsigned int prefix_len, struct in6_addr *router ) {
 	struct ipv6_miniroute *miniroute;
+	struct ipv6_miniroute *before;
 	uint8_t *prefix_mask;
 	unsigned int remaining;
 	unsigned int i;
@@ -254,8 +270,18 @@ int ipv6_add_miniroute ( struct net_device *netdev, struct in6_addr *address,
 			*prefix_mask = ( 0xff << ( 8 - remaining ) );
 	}
 
-	/* Add to start of routing table */
-	list_add ( &miniroute->list, &ipv6_miniroutes );
+	/* Insert into routing table, sorted by descending prefix
+	 * length, so that the first on-link match found is always the
+	 * longest-prefix match.
+	 */
+	list_for_each_entry ( before, &ipv6_miniroutes, list ) {
+		if ( before->prefix_len < miniroute->prefix_len )
+			break;
+	}
+	list_add_tail ( &miniroute->list, &before->list );
+
+	/* Invalidate route cache */
+	ipv6_route_cache.miniroute = NULL;
 
 	/* Set or update address, if applicable */
 	for ( i = 0 ; i < ( sizeof ( address->s6_addr32 ) /
@@ -291,11 +317,27 @@ int ipv6_add_miniroute ( struct net_device *netdev, struct in6_addr *address,
  */
 void ipv6_del_miniroute ( struct ipv6_miniroute *miniroute ) {
 
+	/* Invalidate route cache, if applicable */
+	if ( ipv6_route_cache.miniroute == miniroute )
+		ipv6_route_cache.miniroute = NULL;
+
 	netdev_put ( miniroute->netdev );
 	list_del ( &miniroute->list );
 	free ( miniroute );
 }
 
+/**
+ * Flush IPv6 route cache
+ *
+ * This is required by any code (e.g. the self-tests) that manipulates
+ * the routing table directly rather than via ipv6_add_miniroute() and
+ * ipv6_del_miniroute().
+ */
+void ipv6_flush_route_cache ( void ) {
+
+	ipv6_route_cache.miniroute = NULL;
+}
+
 /**
  * Perform IPv6 routing
  *
@@ -313,6 +355,31 @@ struct ipv6_miniroute * ipv6_route ( unsigned int scope_id,
 	unsigned int score;
 	unsigned int scope;
 
+	/* Use cached lookup, if applicable */
+	miniroute = ipv6_route_cache.miniroute;
+	if ( miniroute && ( scope_id == ipv6_route_cache.scope_id ) &&
+	     ( memcmp ( *dest, &ipv6_route_cache.dest,
+			sizeof ( ipv6_route_cache.dest ) ) == 0 ) &&
+	     netdev_is_open ( miniroute->netdev ) &&
+	     ( miniroute->flags & IPV6_HAS_ADDRESS ) ) {
+
+		/* Use route directly for multicast or on-link
+		 * destinations, or via the router (which must be
+		 * revalidated) for off-link unicast destinations.
+		 */
+		if ( IN6_IS_ADDR_MULTICAST ( *dest ) )
+			return miniroute;
+		match_len = ipv6_match_len ( miniroute, *dest );
+		if ( match_len >= miniroute->prefix_len )
+			return miniroute;
+		if ( miniroute->flags & IPV6_HAS_ROUTER ) {
+			*dest = &miniroute->router;
+			return miniroute;
+		}
+
+		/* Fall through to a full routing table lookup */
+	}
+
 	/* Calculate destination address scope */
 	scope = ipv6_scope ( *dest );
 
@@ -340,9 +407,17 @@ struct ipv6_miniroute * ipv6_route ( unsigned int scope_id,
 		/* Calculate match length */
 		match_len = ipv6_match_len ( miniroute, *dest );
 
-		/* If destination is on-link, then use this route */
-		if ( match_len >= miniroute->prefix_len )
+		/* If destination is on-link, then use this route.
+		 * The table is sorted by descending prefix length, so
+		 * the first match is the longest-prefix match.
+		 */
+		if ( match_len >= miniroute->prefix_len ) {
+			ipv6_route_cache.miniroute = miniroute;
+			memcpy ( &ipv6_route_cache.dest, *dest,
+				 sizeof ( ipv6_route_cache.dest ) );
+			ipv6_route_cache.scope_id = scope_id;
 			return miniroute;
+		}
 
 		/* If destination is unicast, then skip off-link
 		 * entries with no router.
@@ -366,6 +441,10 @@ struct ipv6_miniroute * ipv6_route ( unsigned int scope_id,
 
 	/* Return chosen route, if any */
 	if ( chosen ) {
+		ipv6_route_cache.miniroute = chosen;
+		memcpy ( &ipv6_route_cache.dest, *dest,
+			 sizeof ( ipv6_route_cache.dest ) );
+		ipv6_route_cache.scope_id = scope_id;
 		if ( ! IN6_IS_ADDR_MULTICAST ( *dest ) )
 			*dest = &chosen->router;
 		return chosen;
@@ -444,9 +523,35 @@ static int ipv6_is_fragment ( struct fragment *fragment,
 
 	return ( ( memcmp ( &iphdr->src, &frag_iphdr->src,
 			    sizeof ( iphdr->src ) ) == 0 ) &&
+		 ( memcmp ( &iphdr->dest, &frag_iphdr->dest,
+			    sizeof ( iphdr->dest ) ) == 0 ) &&
 		 ( fhdr->ident == frag_fhdr->ident ) );
 }
 
+/**
+ * Calculate hash of fragmented packet identity
+ *
+ * @v iobuf		I/O buffer
+ * @v hdrlen		Length of non-fragmentable potion of I/O buffer
+ * @ret hash		Hash value
+ */
+static unsigned int ipv6_fragment_hash ( struct io_buffer *iobuf,
+					 size_t hdrlen ) {
+	struct ipv6_header *iphdr = iobuf->data;
+	struct ipv6_fragment_header *fhdr =
+		( iobuf->data + hdrlen - sizeof ( *fhdr ) );
+	unsigned int hash = fhdr->ident;
+	unsigned int i;
+
+	for ( i = 0 ; i < ( sizeof ( iphdr->src.s6_addr32 ) /
+			    sizeof ( iphdr->src.s6_addr32[0] ) ) ; i++ ) {
+		hash ^= iphdr->src.s6_addr32[i];
+		hash ^= iphdr->dest.s6_addr32[i];
+	}
+
+	return hash;
+}
+
 /**
  * Get fragment offset
  *
@@ -477,7 +582,7 @@ static int ipv6_more_fragments ( struct io_buffer *iobuf, size_t hdrlen ) {
 
 /** Fragment reassembler */
 static struct fragment_reassembler ipv6_reassembler = {
-	.list = LIST_HEAD_INIT ( ipv6_reassembler.list ),
+	.fragment_hash = ipv6_fragment_hash,
 	.is_fragment = ipv6_is_fragment,
 	.fragment_offset = ipv6_fragment_offset,
 	.more_fragments = ipv6_more_fragments,
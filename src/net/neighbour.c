@@ -48,9 +48,28 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Neighbour discovery maximum timeout */
 #define NEIGHBOUR_MAX_TIMEOUT ( TICKS_PER_SEC * 3 )
 
+/** Maximum number of pending I/O buffers per neighbour
+ *
+ * This must be deep enough to absorb the burst of packets that an
+ * upper-layer protocol may emit before discovering that the neighbour
+ * is not yet resolved, since any packets dropped here will be
+ * recovered only by a retransmission timeout.
+ */
+#define NEIGHBOUR_TX_QUEUE_LEN 16
+
 /** The neighbour cache */
 struct list_head neighbours = LIST_HEAD_INIT ( neighbours );
 
+/** Most recently used neighbour cache entry
+ *
+ * An established flow performs a neighbour lookup for every
+ * transmitted packet.  Since consecutive packets almost always go to
+ * the same next hop (typically the default gateway), remembering the
+ * most recently used entry avoids walking the cache list on the
+ * critical transmit path.
+ */
+static struct neighbour *neighbour_mru;
+
 static void neighbour_expired ( struct retry_timer *timer, int over );
 
 /**
@@ -64,6 +83,7 @@ static void neighbour_free ( struct refcnt *refcnt ) {
 
 	/* Sanity check */
 	assert ( list_empty ( &neighbour->tx_queue ) );
+	assert ( neighbour->tx_len == 0 );
 
 	/* Drop reference to network device */
 	netdev_put ( neighbour->netdev );
@@ -101,6 +121,7 @@ static struct neighbour * neighbour_create ( struct net_device *netdev,
 
 	/* Transfer ownership to cache */
 	list_add ( &neighbour->list, &neighbours );
+	neighbour_mru = neighbour;
 
 	DBGC ( neighbour, "NEIGHBOUR %s %s %s created\n", netdev->name,
 	       net_protocol->name, net_protocol->ntoa ( net_dest ) );
@@ -120,6 +141,20 @@ static struct neighbour * neighbour_find ( struct net_device *netdev,
 					   const void *net_dest ) {
 	struct neighbour *neighbour;
 
+	/* Check most recently used entry first, preserving the
+	 * least-recently-used ordering relied upon by the cache
+	 * discarder.
+	 */
+	neighbour = neighbour_mru;
+	if ( neighbour && ( neighbour->netdev == netdev ) &&
+	     ( neighbour->net_protocol == net_protocol ) &&
+	     ( memcmp ( neighbour->net_dest, net_dest,
+			net_protocol->net_addr_len ) == 0 ) ) {
+		list_del ( &neighbour->list );
+		list_add ( &neighbour->list, &neighbours );
+		return neighbour;
+	}
+
 	list_for_each_entry ( neighbour, &neighbours, list ) {
 		if ( ( neighbour->netdev == netdev ) &&
 		     ( neighbour->net_protocol == net_protocol ) &&
@@ -129,6 +164,7 @@ static struct neighbour * neighbour_find ( struct net_device *netdev,
 			/* Move to start of cache */
 			list_del ( &neighbour->list );
 			list_add ( &neighbour->list, &neighbours );
+			neighbour_mru = neighbour;
 
 			return neighbour;
 		}
@@ -197,6 +233,7 @@ static void neighbour_discovered ( struct neighbour *neighbour,
 			"packet\n", netdev->name, net_protocol->name,
 			net_protocol->ntoa ( neighbour->net_dest ) );
 		list_del ( &iobuf->list );
+		neighbour->tx_len--;
 		if ( ( rc = net_tx ( iobuf, netdev, net_protocol, ll_dest,
 				     netdev->ll_addr ) ) != 0 ) {
 			DBGC ( neighbour, "NEIGHBOUR %s %s %s could not "
@@ -223,6 +260,8 @@ static void neighbour_destroy ( struct neighbour *neighbour, int rc ) {
 
 	/* Take ownership from cache */
 	list_del ( &neighbour->list );
+	if ( neighbour_mru == neighbour )
+		neighbour_mru = NULL;
 
 	/* Stop timer */
 	stop_timer ( &neighbour->timer );
@@ -235,6 +274,7 @@ static void neighbour_destroy ( struct neighbour *neighbour, int rc ) {
 			net_protocol->ntoa ( neighbour->net_dest ),
 			strerror ( rc ) );
 		list_del ( &iobuf->list );
+		neighbour->tx_len--;
 		netdev_tx_err ( neighbour->netdev, iobuf, rc );
 	}
 
@@ -312,17 +352,28 @@ int neighbour_tx ( struct io_buffer *iobuf, struct net_device *netdev,
 	}
 
 	/* If a link-layer address is available then transmit
-	 * immediately, otherwise queue for later transmission.
+	 * immediately, otherwise queue for transmission when discovery
+	 * completes.  The queue is bounded to prevent a non-responsive
+	 * neighbour from absorbing all available I/O buffers; senders
+	 * that maintain their own retransmission queues (e.g. TCP)
+	 * will pause and recover any packets dropped here.
 	 */
 	if ( neighbour_has_ll_dest ( neighbour ) ) {
 		return net_tx ( iobuf, netdev, net_protocol, neighbour->ll_dest,
 				ll_source );
-	} else {
+	} else if ( neighbour->tx_len < NEIGHBOUR_TX_QUEUE_LEN ) {
 		DBGC2 ( neighbour, "NEIGHBOUR %s %s %s deferring packet\n",
 			netdev->name, net_protocol->name,
 			net_protocol->ntoa ( net_dest ) );
 		list_add_tail ( &iobuf->list, &neighbour->tx_queue );
+		neighbour->tx_len++;
 		return 0;
+	} else {
+		DBGC ( neighbour, "NEIGHBOUR %s %s %s dropping packet: queue "
+		       "full\n", netdev->name, net_protocol->name,
+		       net_protocol->ntoa ( net_dest ) );
+		free_iob ( iobuf );
+		return -ENOBUFS;
 	}
 }
 
@@ -379,6 +430,71 @@ int neighbour_define ( struct net_device *netdev,
 	return 0;
 }
 
+/**
+ * Begin neighbour discovery without a packet to transmit
+ *
+ * @v netdev		Network device
+ * @v net_protocol	Network-layer protocol
+ * @v net_dest		Destination network-layer address
+ * @v discovery		Neighbour discovery protocol
+ * @v net_source	Source network-layer address
+ * @ret rc		Return status code
+ *
+ * This may be used to warm up the neighbour cache (e.g. for the
+ * default gateway as soon as the routing table is known), so that the
+ * link-layer address is usually already resolved by the time the
+ * first data packet needs it.
+ */
+int neighbour_probe ( struct net_device *netdev,
+		      struct net_protocol *net_protocol, const void *net_dest,
+		      struct neighbour_discovery *discovery,
+		      const void *net_source ) {
+	struct neighbour *neighbour;
+
+	/* Do nothing if a cache entry (in whatever state) already exists */
+	if ( neighbour_find ( netdev, net_protocol, net_dest ) )
+		return 0;
+
+	/* Create neighbour cache entry and start discovery */
+	neighbour = neighbour_create ( netdev, net_protocol, net_dest );
+	if ( ! neighbour )
+		return -ENOMEM;
+	neighbour_discover ( neighbour, discovery, net_source );
+
+	return 0;
+}
+
+/**
+ * Fetch cached link-layer address for a neighbour
+ *
+ * @v netdev		Network device
+ * @v net_protocol	Network-layer protocol
+ * @v net_dest		Destination network-layer address
+ * @v ll_dest		Buffer for link-layer address (of at least the
+ *			link-layer protocol's address length)
+ * @ret rc		Return status code
+ */
+int neighbour_fetch ( struct net_device *netdev,
+		      struct net_protocol *net_protocol, const void *net_dest,
+		      void *ll_dest ) {
+	struct neighbour *neighbour;
+
+	/* Find neighbour cache entry */
+	neighbour = neighbour_find ( netdev, net_protocol, net_dest );
+	if ( ! neighbour )
+		return -ENOENT;
+
+	/* Fail if discovery is still in progress */
+	if ( ! neighbour_has_ll_dest ( neighbour ) )
+		return -ENOENT;
+
+	/* Copy out link-layer address */
+	memcpy ( ll_dest, neighbour->ll_dest,
+		 netdev->ll_protocol->ll_addr_len );
+
+	return 0;
+}
+
 /**
  * Update neighbour cache on network device state change or removal
  *
@@ -80,6 +80,26 @@ const struct setting ifname_setting __setting ( SETTING_NETDEV, ifname ) = {
 	.description = "Interface name",
 	.type = &setting_type_string,
 };
+const struct setting txrate_setting __setting ( SETTING_NETDEV, txrate ) = {
+	.name = "txrate",
+	.description = "TX byte rate",
+	.type = &setting_type_uint32,
+};
+const struct setting txpps_setting __setting ( SETTING_NETDEV, txpps ) = {
+	.name = "txpps",
+	.description = "TX packet rate",
+	.type = &setting_type_uint32,
+};
+const struct setting rxrate_setting __setting ( SETTING_NETDEV, rxrate ) = {
+	.name = "rxrate",
+	.description = "RX byte rate",
+	.type = &setting_type_uint32,
+};
+const struct setting rxpps_setting __setting ( SETTING_NETDEV, rxpps ) = {
+	.name = "rxpps",
+	.description = "RX packet rate",
+	.type = &setting_type_uint32,
+};
 const struct setting mtu_setting __setting ( SETTING_NETDEV, mtu ) = {
 	.name = "mtu",
 	.description = "MTU",
@@ -296,6 +316,82 @@ struct netdev_setting_operation {
 	int ( * fetch ) ( struct net_device *netdev, void *data, size_t len );
 };
 
+/**
+ * Fetch an interval rate measurement setting
+ *
+ * @v netdev		Network device
+ * @v value		Measured value
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int netdev_fetch_rate ( struct net_device *netdev,
+			       unsigned long value, void *data, size_t len ) {
+	uint32_t rate;
+
+	/* Fail unless a measurement has been taken (via ifrate()) */
+	if ( ! netdev->rates.valid )
+		return -ENOENT;
+
+	rate = cpu_to_be32 ( value );
+	if ( len > sizeof ( rate ) )
+		len = sizeof ( rate );
+	memcpy ( data, &rate, len );
+	return sizeof ( rate );
+}
+
+/**
+ * Fetch TX byte rate setting
+ *
+ * @v netdev		Network device
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int netdev_fetch_txrate ( struct net_device *netdev, void *data,
+				 size_t len ) {
+	return netdev_fetch_rate ( netdev, netdev->rates.tx_bps, data, len );
+}
+
+/**
+ * Fetch TX packet rate setting
+ *
+ * @v netdev		Network device
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int netdev_fetch_txpps ( struct net_device *netdev, void *data,
+				size_t len ) {
+	return netdev_fetch_rate ( netdev, netdev->rates.tx_pps, data, len );
+}
+
+/**
+ * Fetch RX byte rate setting
+ *
+ * @v netdev		Network device
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int netdev_fetch_rxrate ( struct net_device *netdev, void *data,
+				 size_t len ) {
+	return netdev_fetch_rate ( netdev, netdev->rates.rx_bps, data, len );
+}
+
+/**
+ * Fetch RX packet rate setting
+ *
+ * @v netdev		Network device
+ * @v data		Buffer to fill with setting data
+ * @v len		Length of buffer
+ * @ret len		Length of setting data, or negative error
+ */
+static int netdev_fetch_rxpps ( struct net_device *netdev, void *data,
+				size_t len ) {
+	return netdev_fetch_rate ( netdev, netdev->rates.rx_pps, data, len );
+}
+
 /** Network device settings */
 static struct netdev_setting_operation netdev_setting_operations[] = {
 	{ &mac_setting, netdev_store_mac, netdev_fetch_mac },
@@ -306,6 +402,10 @@ static struct netdev_setting_operation netdev_setting_operations[] = {
 	{ &linktype_setting, NULL, netdev_fetch_linktype },
 	{ &chip_setting, NULL, netdev_fetch_chip },
 	{ &ifname_setting, NULL, netdev_fetch_ifname },
+	{ &txrate_setting, NULL, netdev_fetch_txrate },
+	{ &txpps_setting, NULL, netdev_fetch_txpps },
+	{ &rxrate_setting, NULL, netdev_fetch_rxrate },
+	{ &rxpps_setting, NULL, netdev_fetch_rxpps },
 };
 
 /**
@@ -286,16 +286,19 @@ static void netdev_link_block_expired ( struct retry_timer *timer,
  * Record network device statistic
  *
  * @v stats		Network device statistics
+ * @v len		Length of packet, if successful
  * @v rc		Status code
  */
-static void netdev_record_stat ( struct net_device_stats *stats, int rc ) {
+static void netdev_record_stat ( struct net_device_stats *stats, size_t len,
+				 int rc ) {
 	struct net_device_error *error;
 	struct net_device_error *least_common_error;
 	unsigned int i;
 
-	/* If this is not an error, just update the good counter */
+	/* If this is not an error, just update the good counters */
 	if ( rc == 0 ) {
 		stats->good++;
+		stats->bytes += len;
 		return;
 	}
 
@@ -321,6 +324,40 @@ static void netdev_record_stat ( struct net_device_stats *stats, int rc ) {
 	least_common_error->count = 1;
 }
 
+/**
+ * Record per-protocol network device statistic
+ *
+ * @v stats		Network device statistics
+ * @v net_proto		Network-layer protocol, in network-byte order
+ * @v len		Length of packet
+ */
+static void netdev_record_proto ( struct net_device_stats *stats,
+				  uint16_t net_proto, size_t len ) {
+	struct net_device_proto_stats *proto;
+	struct net_device_proto_stats *least_common_proto;
+	unsigned int i;
+
+	/* Locate the appropriate protocol record */
+	least_common_proto = &stats->protos[0];
+	for ( i = 0 ; i < ( sizeof ( stats->protos ) /
+			    sizeof ( stats->protos[0] ) ) ; i++ ) {
+		proto = &stats->protos[i];
+		/* Update matching record, if found */
+		if ( proto->net_proto == net_proto ) {
+			proto->packets++;
+			proto->bytes += len;
+			return;
+		}
+		if ( proto->packets < least_common_proto->packets )
+			least_common_proto = proto;
+	}
+
+	/* Overwrite the least common protocol record */
+	least_common_proto->net_proto = net_proto;
+	least_common_proto->packets = 1;
+	least_common_proto->bytes = len;
+}
+
 /**
  * Transmit raw packet via network device
  *
@@ -365,9 +402,20 @@ int netdev_tx ( struct net_device *netdev, struct io_buffer *iobuf ) {
 	}
 
 	/* Transmit packet */
-	if ( ( rc = netdev->op->transmit ( netdev, iobuf ) ) != 0 )
+	profile_start ( &netdev->tx_profiler );
+	rc = netdev->op->transmit ( netdev, iobuf );
+	profile_stop ( &netdev->tx_profiler );
+	if ( rc != 0 )
 		goto err_transmit;
 
+	/* Mark doorbell as deferred, if driver supports flushing */
+	if ( netdev->op->flush )
+		netdev->state |= NETDEV_TX_UNFLUSHED;
+
+	/* Resume polling at full rate, since a response is likely */
+	netdev->quiet = 0;
+	netdev->skip = 0;
+
 	/* Clear in-progress flag */
 	netdev->state &= ~NETDEV_TX_IN_PROGRESS;
 
@@ -441,7 +489,8 @@ void netdev_tx_err ( struct net_device *netdev,
 		     struct io_buffer *iobuf, int rc ) {
 
 	/* Update statistics counter */
-	netdev_record_stat ( &netdev->tx_stats, rc );
+	netdev_record_stat ( &netdev->tx_stats,
+			     ( iobuf ? iob_len ( iobuf ) : 0 ), rc );
 	if ( rc == 0 ) {
 		DBGC2 ( netdev, "NETDEV %s transmission %p complete\n",
 			netdev->name, iobuf );
@@ -565,7 +614,7 @@ void netdev_rx ( struct net_device *netdev, struct io_buffer *iobuf ) {
 	list_add_tail ( &iobuf->list, &netdev->rx_queue );
 
 	/* Update statistics counter */
-	netdev_record_stat ( &netdev->rx_stats, 0 );
+	netdev_record_stat ( &netdev->rx_stats, iob_len ( iobuf ), 0 );
 }
 
 /**
@@ -589,17 +638,24 @@ void netdev_rx_err ( struct net_device *netdev,
 	DBGC ( netdev, "NETDEV %s failed to receive %p: %s\n",
 	       netdev->name, iobuf, strerror ( rc ) );
 
-	/* Unmap I/O buffer, if required */
-	if ( iobuf && dma_mapped ( &iobuf->map ) )
-		iob_unmap ( iobuf );
-
-	/* Discard packet */
-	free_iob ( iobuf );
+	/* Discard packet via the recycling pool, preserving any DMA
+	 * mapping for reuse.  Discards are frequent on busy links
+	 * (unwanted protocols, ring overflow), and recycling them
+	 * keeps buffer remapping off the receive path.
+	 */
+	free_rx_iob ( iobuf );
 
 	/* Update statistics counter */
-	netdev_record_stat ( &netdev->rx_stats, rc );
+	netdev_record_stat ( &netdev->rx_stats, 0, rc );
 }
 
+/** Maximum adaptive polling backoff (as a power of two)
+ *
+ * An idle device will be polled on at least one in every
+ * 2^NETDEV_POLL_BACKOFF_MAX passes through the poll loop.
+ */
+#define NETDEV_POLL_BACKOFF_MAX 6
+
 /**
  * Poll for completed and received packets on network device
  *
@@ -619,10 +675,43 @@ void netdev_poll ( struct net_device *netdev ) {
 	if ( netdev->state & NETDEV_POLL_IN_PROGRESS )
 		return;
 
+	/* Flush any deferred transmissions.  This must happen before
+	 * the device may be skipped, since anything waiting on a
+	 * transmit completion will be polling the device.
+	 */
+	if ( netdev->state & NETDEV_TX_UNFLUSHED ) {
+		netdev->state &= ~NETDEV_TX_UNFLUSHED;
+		netdev->op->flush ( netdev );
+	}
+
+	/* Adaptively reduce the polling frequency of idle devices:
+	 * after each consecutive poll that yields no received
+	 * packets, skip a (geometrically growing, bounded) number of
+	 * subsequent polls.  This keeps device register accesses off
+	 * the critical path while e.g. an interactive menu is
+	 * displayed, at a worst-case cost of a few tens of extra
+	 * polling passes of receive latency.
+	 */
+	if ( netdev->skip ) {
+		netdev->skip--;
+		return;
+	}
+
 	/* Poll device */
 	netdev->state |= NETDEV_POLL_IN_PROGRESS;
+	profile_start ( &netdev->poll_profiler );
 	netdev->op->poll ( netdev );
+	profile_stop ( &netdev->poll_profiler );
 	netdev->state &= ~NETDEV_POLL_IN_PROGRESS;
+
+	/* Update adaptive polling state */
+	if ( list_empty ( &netdev->rx_queue ) ) {
+		if ( netdev->quiet < NETDEV_POLL_BACKOFF_MAX )
+			netdev->quiet++;
+	} else {
+		netdev->quiet = 0;
+	}
+	netdev->skip = ( ( 1 << netdev->quiet ) - 1 );
 }
 
 /**
@@ -870,6 +959,10 @@ int netdev_open ( struct net_device *netdev ) {
 	/* Mark as opened */
 	netdev->state |= NETDEV_OPEN;
 
+	/* Reset adaptive polling state */
+	netdev->quiet = 0;
+	netdev->skip = 0;
+
 	/* Open the device */
 	if ( ( rc = netdev->op->open ( netdev ) ) != 0 )
 		goto err;
@@ -914,8 +1007,8 @@ void netdev_close ( struct net_device *netdev ) {
 	/* Remove from open devices list */
 	list_del ( &netdev->open_list );
 
-	/* Mark as closed */
-	netdev->state &= ~NETDEV_OPEN;
+	/* Mark as closed, discarding any deferred doorbell */
+	netdev->state &= ~( NETDEV_OPEN | NETDEV_TX_UNFLUSHED );
 
 	/* Notify drivers of device state change */
 	netdev_notify ( netdev );
@@ -929,6 +1022,10 @@ void netdev_close ( struct net_device *netdev ) {
 	/* Flush TX and RX queues */
 	netdev_tx_flush ( netdev );
 	netdev_rx_flush ( netdev );
+
+	/* Release any RX I/O buffers still mapped for this device */
+	if ( netdev->dma )
+		flush_rx_iobs ( netdev->dma );
 }
 
 /**
@@ -1070,12 +1167,32 @@ struct net_device * last_opened_netdev ( void ) {
  * packet via the specified network device.  This function takes
  * ownership of the I/O buffer.
  */
+/**
+ * Identify network-layer protocol
+ *
+ * @v net_proto		Network-layer protocol, in network-byte order
+ * @ret net_protocol	Network-layer protocol, or NULL if not found
+ */
+struct net_protocol * net_find_protocol ( uint16_t net_proto ) {
+	struct net_protocol *net_protocol;
+
+	for_each_table_entry ( net_protocol, NET_PROTOCOLS ) {
+		if ( net_protocol->net_proto == net_proto )
+			return net_protocol;
+	}
+	return NULL;
+}
+
 int net_tx ( struct io_buffer *iobuf, struct net_device *netdev,
 	     struct net_protocol *net_protocol, const void *ll_dest,
 	     const void *ll_source ) {
 	struct ll_protocol *ll_protocol = netdev->ll_protocol;
 	int rc;
 
+	/* Update per-protocol statistics counter */
+	netdev_record_proto ( &netdev->tx_stats, net_protocol->net_proto,
+			      iob_len ( iobuf ) );
+
 	/* Add link-layer header */
 	if ( ( rc = ll_protocol->push ( netdev, iobuf, ll_dest, ll_source,
 					net_protocol->net_proto ) ) != 0 ) {
@@ -1104,11 +1221,15 @@ int net_rx ( struct io_buffer *iobuf, struct net_device *netdev,
 	     unsigned int flags ) {
 	struct net_protocol *net_protocol;
 
+	/* Update per-protocol statistics counter */
+	netdev_record_proto ( &netdev->rx_stats, net_proto,
+			      iob_len ( iobuf ) );
+
 	/* Hand off to network-layer protocol, if any */
-	for_each_table_entry ( net_protocol, NET_PROTOCOLS ) {
-		if ( net_protocol->net_proto == net_proto )
-			return net_protocol->rx ( iobuf, netdev, ll_dest,
-						  ll_source, flags );
+	net_protocol = net_find_protocol ( net_proto );
+	if ( net_protocol ) {
+		return net_protocol->rx ( iobuf, netdev, ll_dest, ll_source,
+					  flags );
 	}
 
 	DBGC ( netdev, "NETDEV %s unknown network protocol %04x\n",
@@ -1117,6 +1238,9 @@ int net_rx ( struct io_buffer *iobuf, struct net_device *netdev,
 	return -ENOTSUP;
 }
 
+/** Maximum number of received packets to process per device per pass */
+#define NET_RX_BUDGET 16
+
 /**
  * Poll the network stack
  *
@@ -1130,6 +1254,7 @@ void net_poll ( void ) {
 	const void *ll_dest;
 	const void *ll_source;
 	uint16_t net_proto;
+	unsigned int budget;
 	unsigned int flags;
 	int rc;
 
@@ -1150,8 +1275,15 @@ void net_poll ( void ) {
 		if ( netdev_rx_frozen ( netdev ) )
 			continue;
 
-		/* Process all received packets */
-		while ( ( iobuf = netdev_rx_dequeue ( netdev ) ) ) {
+		/* Process received packets, up to a fixed budget per
+		 * device per pass.  Limiting the batch size provides
+		 * round-robin fairness between devices: a flooded
+		 * device cannot monopolise the stack while other
+		 * devices' receive rings overflow.  Any remaining
+		 * packets stay on the queue for the next pass.
+		 */
+		budget = NET_RX_BUDGET;
+		while ( budget-- && ( iobuf = netdev_rx_dequeue ( netdev ) ) ) {
 
 			DBGC2 ( netdev, "NETDEV %s processing %p (%p+%zx)\n",
 				netdev->name, iobuf, iobuf->data,
@@ -1231,8 +1363,18 @@ __weak void vlan_netdev_rx_err ( struct net_device *netdev,
 	netdev_rx_err ( netdev, iobuf, rc );
 }
 
+/** Networking stack process scheduling weight
+ *
+ * Network devices are polled this many times in each pass through the
+ * process run queue.  Weighting the poller above other processes
+ * (e.g. console and UI processes) reduces the likelihood of receive
+ * ring overflow on fast links.  The weight remains adjustable at
+ * runtime via process_set_weight().
+ */
+#define NET_PROCESS_WEIGHT 4
+
 /** Networking stack process */
-PERMANENT_PROCESS ( net_process, net_step );
+PERMANENT_PROCESS_WEIGHTED ( net_process, net_step, NET_PROCESS_WEIGHT );
 
 /**
  * Discard some cached network device data
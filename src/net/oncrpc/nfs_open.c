@@ -52,6 +52,23 @@ FEATURE ( FEATURE_PROTOCOL, "NFS", DHCP_EB_FEATURE_NFS, 1 );
 
 #define NFS_RSIZE 100000
 
+/** Number of READ calls kept in flight
+ *
+ * Issuing a single READ per round trip caps throughput at one rsize
+ * per RTT; a window of concurrent calls keeps the link filled on
+ * high-latency paths.  Replies may arrive out of order and are placed
+ * at their absolute file offsets.
+ */
+#define NFS_READ_WINDOW 4
+
+/** Maximum accumulated length of a reply header
+ *
+ * A READ reply header (record mark, RPC reply header, status, and
+ * post-operation attributes) is comfortably under this size; any
+ * bytes beyond it belong to the payload.
+ */
+#define NFS_HDR_MAX 256
+
 enum nfs_pm_state {
 	NFS_PORTMAP_NONE = 0,
 	NFS_PORTMAP_MOUNTPORT,
@@ -77,6 +94,21 @@ enum nfs_state {
 	NFS_CLOSED,
 };
 
+/**
+ * An outstanding READ call
+ *
+ */
+struct nfs_read_call {
+	/** Call slot is in use */
+	int                     busy;
+	/** Transaction identifier */
+	uint32_t                xid;
+	/** Requested file offset */
+	uint64_t                offset;
+	/** Requested byte count */
+	uint32_t                count;
+};
+
 /**
  * A NFS request
  *
@@ -108,7 +140,16 @@ struct nfs_request {
 	struct nfs_fh           current_fh;
 	uint64_t                file_offset;
 
+	struct nfs_read_call    calls[NFS_READ_WINDOW];
+	unsigned int            outstanding;
+	uint64_t                filesize;
+	int                     size_known;
+
+	uint8_t                 hdr[NFS_HDR_MAX];
+	size_t                  hdr_len;
+	uint64_t                stream_offset;
 	size_t                  remaining;
+	size_t                  pad;
 	int                     eof;
 };
 
@@ -364,6 +405,81 @@ done:
 	return 0;
 }
 
+/**
+ * Issue a single READ call
+ *
+ * @v nfs               NFS request
+ * @v offset            File offset
+ * @v count             Byte count
+ * @ret rc              Return status code
+ */
+static int nfs_issue_read ( struct nfs_request *nfs, uint64_t offset,
+                            uint32_t count ) {
+	struct nfs_read_call    *call = NULL;
+	unsigned int            i;
+	int                     rc;
+
+	/* Find a free call slot */
+	for ( i = 0 ; i < NFS_READ_WINDOW ; i++ ) {
+		if ( ! nfs->calls[i].busy ) {
+			call = &nfs->calls[i];
+			break;
+		}
+	}
+	if ( ! call )
+		return -EBUSY;
+
+	DBGC2 ( nfs, "NFS_OPEN %p READ call [%llu,+%u)\n", nfs,
+	        ( ( unsigned long long ) offset ), count );
+
+	rc = nfs_read ( &nfs->nfs_intf, &nfs->nfs_session,
+	                &nfs->current_fh, offset, count );
+	if ( rc != 0 )
+		return rc;
+
+	call->busy   = 1;
+	call->xid    = nfs->nfs_session.rpc_id;
+	call->offset = offset;
+	call->count  = count;
+	nfs->outstanding++;
+
+	return 0;
+}
+
+/**
+ * Keep the READ call window full
+ *
+ * @v nfs               NFS request
+ *
+ * Until the file size is known (from the first reply's attributes)
+ * only a single READ may usefully be in flight; thereafter the window
+ * is kept full, never requesting beyond the end of the file.
+ */
+static void nfs_issue_reads ( struct nfs_request *nfs ) {
+	uint32_t        count;
+	int             rc;
+
+	while ( nfs->outstanding < NFS_READ_WINDOW ) {
+		if ( nfs->size_known ) {
+			if ( nfs->file_offset >= nfs->filesize )
+				return;
+			count = NFS_RSIZE;
+			if ( count > ( nfs->filesize - nfs->file_offset ) )
+				count = ( nfs->filesize - nfs->file_offset );
+		} else {
+			if ( nfs->outstanding || nfs->eof )
+				return;
+			count = NFS_RSIZE;
+		}
+		if ( ( rc = nfs_issue_read ( nfs, nfs->file_offset,
+		                             count ) ) != 0 ) {
+			nfs_done ( nfs, rc );
+			return;
+		}
+		nfs->file_offset += count;
+	}
+}
+
 static void nfs_step ( struct nfs_request *nfs ) {
 	int     rc;
 	char    *path_component;
@@ -402,13 +518,8 @@ static void nfs_step ( struct nfs_request *nfs ) {
 	if ( nfs->nfs_state == NFS_READ ) {
 		DBGC ( nfs, "NFS_OPEN %p READ call\n", nfs );
 
-		rc = nfs_read ( &nfs->nfs_intf, &nfs->nfs_session,
-		                &nfs->current_fh, nfs->file_offset,
-		                NFS_RSIZE );
-		if ( rc != 0 )
-			goto err;
-
 		nfs->nfs_state++;
+		nfs_issue_reads ( nfs );
 		return;
 	}
 
@@ -417,18 +528,266 @@ err:
 	nfs_done ( nfs, rc );
 }
 
+static int nfs_read_consume ( struct nfs_request *nfs,
+                              struct io_buffer *io_buf );
+
+/**
+ * Accumulate and parse a READ reply header
+ *
+ * @v nfs               NFS request
+ * @v io_buf            I/O buffer
+ * @ret rc              Return status code
+ *
+ * Reply records may butt up against each other within a single I/O
+ * buffer, and a header may be split across buffers, so headers are
+ * reassembled into a bounce buffer before parsing.  Replies are
+ * matched to their READ calls by transaction identifier, and may
+ * arrive in any order.
+ */
+static int nfs_read_header ( struct nfs_request *nfs,
+                             struct io_buffer *io_buf ) {
+	struct oncrpc_reply     reply;
+	struct nfs_read_reply   read_reply;
+	struct nfs_read_call    *call = NULL;
+	struct io_buffer        *parse;
+	uint32_t                mark;
+	size_t                  record;
+	size_t                  want;
+	size_t                  len;
+	size_t                  consumed;
+	unsigned int            i;
+	int                     rc;
+
+	/* Accumulate the record mark */
+	if ( nfs->hdr_len < sizeof ( mark ) ) {
+		len = sizeof ( mark ) - nfs->hdr_len;
+		if ( len > iob_len ( io_buf ) )
+			len = iob_len ( io_buf );
+		memcpy ( &nfs->hdr[nfs->hdr_len], io_buf->data, len );
+		nfs->hdr_len += len;
+		iob_pull ( io_buf, len );
+		if ( nfs->hdr_len < sizeof ( mark ) )
+			return 0;
+	}
+
+	/* Determine total record length (mark's top bit flags the
+	 * last fragment; servers send single-fragment replies) */
+	mark = ntohl ( *( ( uint32_t * ) nfs->hdr ) );
+	if ( ! ( mark & 0x80000000UL ) ) {
+		DBGC ( nfs, "NFS_OPEN %p unsupported multi-fragment "
+		       "record\n", nfs );
+		return -EPROTO;
+	}
+	record = sizeof ( mark ) + ( mark & 0x7fffffffUL );
+
+	/* Accumulate as much of the record as could constitute a
+	 * reply header */
+	want = ( record < NFS_HDR_MAX ? record : NFS_HDR_MAX );
+	if ( nfs->hdr_len < want ) {
+		len = want - nfs->hdr_len;
+		if ( len > iob_len ( io_buf ) )
+			len = iob_len ( io_buf );
+		memcpy ( &nfs->hdr[nfs->hdr_len], io_buf->data, len );
+		nfs->hdr_len += len;
+		iob_pull ( io_buf, len );
+		if ( nfs->hdr_len < want )
+			return 0;
+	}
+
+	/* Parse the header from a temporary I/O buffer */
+	parse = alloc_iob ( nfs->hdr_len );
+	if ( ! parse )
+		return -ENOMEM;
+	memcpy ( iob_put ( parse, nfs->hdr_len ), nfs->hdr, nfs->hdr_len );
+	len = nfs->hdr_len;
+	nfs->hdr_len = 0;
+
+	oncrpc_get_reply ( &nfs->nfs_session, &reply, parse );
+	if ( reply.accept_state != 0 ) {
+		rc = -EPROTO;
+		goto err;
+	}
+	memset ( &read_reply, 0, sizeof ( read_reply ) );
+	if ( ( rc = nfs_get_read_reply ( &read_reply, &reply ) ) != 0 )
+		goto err;
+	consumed = ( len - iob_len ( parse ) );
+	if ( record < ( consumed + read_reply.count ) ) {
+		rc = -EPROTO;
+		goto err;
+	}
+
+	/* Identify the matching READ call */
+	for ( i = 0 ; i < NFS_READ_WINDOW ; i++ ) {
+		if ( nfs->calls[i].busy &&
+		     ( nfs->calls[i].xid == reply.rpc_id ) ) {
+			call = &nfs->calls[i];
+			break;
+		}
+	}
+	if ( ! call ) {
+		DBGC ( nfs, "NFS_OPEN %p got READ reply with unknown " \
+		       "xid %08x\n", nfs, reply.rpc_id );
+		rc = -EPROTO;
+		goto err;
+	}
+	DBGC2 ( nfs, "NFS_OPEN %p got READ reply [%llu,+%u)%s\n", nfs,
+	        ( ( unsigned long long ) call->offset ), read_reply.count,
+	        ( read_reply.eof ? " eof" : "" ) );
+	call->busy = 0;
+	nfs->outstanding--;
+
+	/* First reply: record the file size and presize the stream */
+	if ( call->offset == 0 ) {
+		DBGC2 ( nfs, "NFS_OPEN %p size: %llu bytes\n", nfs,
+		        read_reply.filesize );
+		xfer_seek ( &nfs->xfer, read_reply.filesize );
+		xfer_seek ( &nfs->xfer, 0 );
+	}
+	if ( read_reply.filesize && ! nfs->size_known ) {
+		nfs->filesize   = read_reply.filesize;
+		nfs->size_known = 1;
+	}
+	if ( read_reply.eof )
+		nfs->eof = 1;
+
+	/* A short read leaves a hole before the next requested range;
+	 * request the missing bytes (or, before the size is known,
+	 * simply continue from where the server stopped) */
+	if ( ( read_reply.count < call->count ) && ( ! read_reply.eof ) ) {
+		if ( nfs->size_known ) {
+			rc = nfs_issue_read ( nfs,
+			                      ( call->offset +
+			                        read_reply.count ),
+			                      ( call->count -
+			                        read_reply.count ) );
+			if ( rc != 0 )
+				goto err;
+		} else {
+			nfs->file_offset = ( call->offset +
+			                     read_reply.count );
+		}
+	}
+
+	/* Set up streaming of this record's payload; anything in the
+	 * record beyond the header and payload is XDR padding */
+	nfs->stream_offset = call->offset;
+	nfs->remaining     = read_reply.count;
+	nfs->pad           = ( record - consumed - read_reply.count );
+
+	/* Refill the call window */
+	nfs_issue_reads ( nfs );
+
+	/* Deliver any payload bytes already accumulated */
+	return nfs_read_consume ( nfs, iob_disown ( parse ) );
+
+err:
+	free_iob ( parse );
+	return rc;
+}
+
+/**
+ * Consume READ reply stream data
+ *
+ * @v nfs               NFS request
+ * @v io_buf            I/O buffer, ownership is taken
+ * @ret rc              Return status code
+ *
+ * A buffer lying entirely within a record's payload (the common case,
+ * since rsize far exceeds a single TCP delivery) is handed downstream
+ * as-is; no payload byte is ever copied.
+ */
+static int nfs_read_consume ( struct nfs_request *nfs,
+                              struct io_buffer *io_buf ) {
+	struct xfer_metadata    meta;
+	size_t                  len;
+	int                     rc;
+
+	while ( iob_len ( io_buf ) ) {
+
+		/* Stream record payload directly to the data transfer
+		 * interface at its absolute file offset */
+		if ( nfs->remaining ) {
+			memset ( &meta, 0, sizeof ( meta ) );
+			meta.flags  = XFER_FL_ABS_OFFSET;
+			meta.offset = nfs->stream_offset;
+			len = iob_len ( io_buf );
+			if ( len <= nfs->remaining ) {
+				/* Entirely payload: pass the buffer
+				 * downstream without copying */
+				nfs->stream_offset += len;
+				nfs->remaining     -= len;
+				return xfer_deliver ( &nfs->xfer,
+				                      iob_disown ( io_buf ),
+				                      &meta );
+			}
+			len = nfs->remaining;
+			rc = xfer_deliver_raw_meta ( &nfs->xfer,
+			                             io_buf->data, len,
+			                             &meta );
+			if ( rc != 0 ) {
+				free_iob ( io_buf );
+				return rc;
+			}
+			iob_pull ( io_buf, len );
+			nfs->stream_offset += len;
+			nfs->remaining     -= len;
+			continue;
+		}
+
+		/* Discard padding after the payload */
+		if ( nfs->pad ) {
+			len = iob_len ( io_buf );
+			if ( len > nfs->pad )
+				len = nfs->pad;
+			iob_pull ( io_buf, len );
+			nfs->pad -= len;
+			continue;
+		}
+
+		/* Accumulate and parse the next reply header */
+		if ( ( rc = nfs_read_header ( nfs, io_buf ) ) != 0 ) {
+			free_iob ( io_buf );
+			return rc;
+		}
+	}
+
+	free_iob ( io_buf );
+	return 0;
+}
+
 static int nfs_deliver ( struct nfs_request *nfs,
                          struct io_buffer *io_buf,
                          struct xfer_metadata *meta __unused ) {
 	int                     rc;
 	struct oncrpc_reply     reply;
 
-	if ( nfs->remaining == 0 ) {
-		oncrpc_get_reply ( &nfs->nfs_session, &reply, io_buf );
-		if ( reply.accept_state != 0 ) {
-			rc = -EPROTO;
-			goto err;
+	if ( nfs->nfs_state == NFS_READ_SENT ) {
+		rc = nfs_read_consume ( nfs, iob_disown ( io_buf ) );
+		if ( rc != 0 ) {
+			nfs_done ( nfs, rc );
+			return 0;
 		}
+
+		/* Complete once every requested byte has been
+		 * delivered */
+		if ( ( ! nfs->outstanding ) && ( ! nfs->remaining ) &&
+		     ( ! nfs->pad ) && ( ! nfs->hdr_len ) &&
+		     ( nfs->eof || ( nfs->size_known &&
+		                     ( nfs->file_offset >=
+		                       nfs->filesize ) ) ) ) {
+			intf_shutdown ( &nfs->nfs_intf, 0 );
+			nfs->nfs_state++;
+			nfs->mount_state++;
+			nfs_mount_step ( nfs );
+		}
+
+		return 0;
+	}
+
+	oncrpc_get_reply ( &nfs->nfs_session, &reply, io_buf );
+	if ( reply.accept_state != 0 ) {
+		rc = -EPROTO;
+		goto err;
 	}
 
 	if ( nfs->nfs_state == NFS_LOOKUP_SENT ) {
@@ -490,57 +849,6 @@ static int nfs_deliver ( struct nfs_request *nfs,
 		goto done;
 	}
 
-	if ( nfs->nfs_state == NFS_READ_SENT ) {
-		if ( nfs->remaining == 0 ) {
-			DBGC ( nfs, "NFS_OPEN %p got READ reply\n", nfs );
-
-			struct nfs_read_reply read_reply;
-
-			rc = nfs_get_read_reply ( &read_reply, &reply );
-			if ( rc != 0 )
-				goto err;
-
-			if ( nfs->file_offset == 0 ) {
-				DBGC2 ( nfs, "NFS_OPEN %p size: %llu bytes\n",
-				        nfs, read_reply.filesize );
-
-				xfer_seek ( &nfs->xfer, read_reply.filesize );
-				xfer_seek ( &nfs->xfer, 0 );
-			}
-
-			nfs->file_offset += read_reply.count;
-			nfs->remaining    = read_reply.count;
-			nfs->eof          = read_reply.eof;
-		}
-
-		size_t len = iob_len ( io_buf );
-		if ( len > nfs->remaining )
-			iob_unput ( io_buf, len - nfs->remaining );
-
-		nfs->remaining -= iob_len ( io_buf );
-
-		DBGC ( nfs, "NFS_OPEN %p got %zd bytes\n", nfs,
-		       iob_len ( io_buf ) );
-
-		rc = xfer_deliver_iob ( &nfs->xfer, iob_disown ( io_buf ) );
-		if ( rc != 0 )
-			goto err;
-
-		if ( nfs->remaining == 0 ) {
-			if ( ! nfs->eof ) {
-				nfs->nfs_state--;
-				nfs_step ( nfs );
-			} else {
-				intf_shutdown ( &nfs->nfs_intf, 0 );
-				nfs->nfs_state++;
-				nfs->mount_state++;
-				nfs_mount_step ( nfs );
-			}
-		}
-
-		return 0;
-	}
-
 	rc = -EPROTO;
 err:
 	nfs_done ( nfs, rc );
@@ -35,6 +35,15 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Peer Content Caching and Retrieval: Content Identification [MS-PCCRC]
  *
+ * This file parses content information and derives segment
+ * identifiers; it performs no per-block data hashing.  Verification
+ * of downloaded block data against the hashes extracted here happens
+ * in the block download code, which hashes incrementally: raw range
+ * downloads feed each delivery into a streaming digest as it arrives,
+ * and retrieval protocol downloads (whose initialisation vector
+ * arrives after the ciphertext, precluding on-the-fly decryption)
+ * hash during the chunked background decryption process.  In both
+ * cases only a digest finalisation remains once the last byte is in.
  */
 
 /******************************************************************************
@@ -330,6 +330,17 @@ static void peerblk_done ( struct peerdist_block *peerblk, int rc ) {
 	peer = ( ( peerblk->peer == head ) ? NULL : peerblk->peer );
 	peerdisc_stat ( &peerblk->xfer, peer, &segment->peers );
 
+	/* Promote the successful peer to the head of the peer list.
+	 * Blocks always try peers in list order, so the collective
+	 * effect across concurrent block downloads is that responsive
+	 * peers attract the work while unresponsive peers drift
+	 * towards the tail of the list.
+	 */
+	if ( peer ) {
+		list_del ( &peer->list );
+		list_add ( &peer->list, &segment->peers );
+	}
+
 	/* Close download */
 	peerblk_close ( peerblk, 0 );
 	return;
@@ -412,6 +423,14 @@ static int peerblk_raw_rx ( struct peerdist_block *peerblk,
 
 	/* Fail if data is delivered out of order, since the streaming
 	 * digest requires strict ordering.
+	 *
+	 * Hashing incrementally as data arrives overlaps the digest
+	 * cost with network transfer and avoids a separate
+	 * verification pass over the assembled block.  Concurrent
+	 * block downloads progress independently and so cannot
+	 * usefully be batched into a multi-buffer digest; fast
+	 * single-stream hashing is provided by the hardware-
+	 * accelerated digest implementations where available.
 	 */
 	if ( ( rc = xfer_check_order ( meta, &peerblk->pos, len ) ) != 0 )
 		goto err;
@@ -1315,6 +1334,19 @@ static void peerblk_expired ( struct retry_timer *timer, int over __unused ) {
 	 * origin server), then abort the overall download.
 	 */
 	head = list_entry ( &segment->peers, struct peerdisc_peer, list );
+
+	/* Demote a peer whose download attempt timed out to the tail
+	 * of the peer list.  Other blocks then need not each wait out
+	 * the same timeout before finding a working peer, and this
+	 * block falls through to the origin server as overflow
+	 * capacity rather than queueing behind another slow peer.
+	 */
+	if ( ( peerblk->peer != NULL ) && ( peerblk->peer != head ) &&
+	     ( timer->timeout != 0 ) ) {
+		list_del ( &peerblk->peer->list );
+		list_add_tail ( &peerblk->peer->list, &segment->peers );
+	}
+
 	if ( ( peerblk->peer == head ) &&
 	     ( ++peerblk->cycles >= PEERBLK_MAX_ATTEMPT_CYCLES ) ) {
 		rc = peerblk->rc;
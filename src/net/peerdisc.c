@@ -79,9 +79,13 @@ static char *peerdisc_recent;
 /** Hosted cache server */
 static char *peerhost;
 
+/** Cached peer location (from a previous boot) */
+static char *peerseed;
+
 static struct peerdisc_segment * peerdisc_find ( const char *id );
 static int peerdisc_discovered ( struct peerdisc_segment *segment,
 				 const char *location );
+extern const struct setting peerseed_setting;
 
 /******************************************************************************
  *
@@ -414,6 +418,17 @@ static int peerdisc_discovered ( struct peerdisc_segment *segment,
 			free ( peerdisc_recent );
 			peerdisc_recent = recent;
 		}
+
+		/* Expose via the peer cache setting, so that a boot
+		 * script may persist it to non-volatile storage for
+		 * use by subsequent boots.  Skip the store if the
+		 * value is unchanged, since storing a setting
+		 * reapplies all settings.
+		 */
+		if ( ( peerseed == NULL ) ||
+		     ( strcmp ( peerseed, location ) != 0 ) ) {
+			storef_setting ( NULL, &peerseed_setting, location );
+		}
 	}
 
 	/* Notify all clients */
@@ -497,6 +512,17 @@ static struct peerdisc_segment * peerdisc_create ( const char *id ) {
 
 	} else {
 
+		/* Add cached peer from a previous boot, if
+		 * configured.  Downloads may then begin immediately,
+		 * without waiting out the discovery timeout.  The
+		 * peer is adopted only via the normal download
+		 * attempt path (with its progress timeouts), so a
+		 * stale cache entry costs one failed attempt rather
+		 * than a hang, and discovery continues regardless.
+		 */
+		if ( peerseed )
+			peerdisc_discovered ( segment, peerseed );
+
 		/* Add most recently discovered peer to list of peers
 		 *
 		 * This is a performance optimisation: we assume that
@@ -638,6 +664,20 @@ const struct setting peerhost_setting __setting ( SETTING_MISC, peerhost ) = {
 	.type = &setting_type_string,
 };
 
+/** PeerDist cached peer setting
+ *
+ * This records the most recently discovered peer.  If it is present
+ * at boot time (e.g. because a boot script persisted it to
+ * non-volatile storage on a previous boot), then it is used to seed
+ * the peer list for each segment, allowing downloads to start without
+ * waiting out the discovery timeout.
+ */
+const struct setting peerseed_setting __setting ( SETTING_MISC, peerseed ) = {
+	.name = "peerseed",
+	.description = "PeerDist cached peer",
+	.type = &setting_type_string,
+};
+
 /**
  * Apply PeerDist discovery settings
  *
@@ -645,9 +685,11 @@ const struct setting peerhost_setting __setting ( SETTING_MISC, peerhost ) = {
  */
 static int apply_peerdisc_settings ( void ) {
 
-	/* Free any existing hosted cache server */
+	/* Free any existing hosted cache server and cached peer */
 	free ( peerhost );
 	peerhost = NULL;
+	free ( peerseed );
+	peerseed = NULL;
 
 	/* Fetch hosted cache server */
 	fetch_string_setting_copy ( NULL, &peerhost_setting, &peerhost );
@@ -656,6 +698,13 @@ static int apply_peerdisc_settings ( void ) {
 		       peerhost );
 	}
 
+	/* Fetch cached peer */
+	fetch_string_setting_copy ( NULL, &peerseed_setting, &peerseed );
+	if ( peerseed ) {
+		DBGC ( &peerseed, "PEERDISC using cached peer %s\n",
+		       peerseed );
+	}
+
 	return 0;
 }
 
@@ -48,7 +48,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  */
 #define MIN_TIMEOUT 7
 
-/** List of running timers */
+/** List of running timers
+ *
+ * The list is kept sorted by increasing expiry time, so that the
+ * poller need examine only the head of the list regardless of the
+ * number of running timers.
+ */
 static LIST_HEAD ( timers );
 
 /**
@@ -62,10 +67,13 @@ static LIST_HEAD ( timers );
  * be stopped and the timer's callback function will be called.
  */
 void start_timer_fixed ( struct retry_timer *timer, unsigned long timeout ) {
+	struct retry_timer *pending;
+	unsigned long expiry;
 
-	/* Add to list of running timers (if applicable) */
-	if ( ! timer->running ) {
-		list_add ( &timer->list, &timers );
+	/* Remove from list of running timers, if applicable */
+	if ( timer->running ) {
+		list_del ( &timer->list );
+	} else {
 		ref_get ( timer->refcnt );
 		timer->running = 1;
 	}
@@ -76,6 +84,17 @@ void start_timer_fixed ( struct retry_timer *timer, unsigned long timeout ) {
 	/* Record timeout */
 	timer->timeout = timeout;
 
+	/* Insert into list of running timers, sorted by expiry time.
+	 * Timers sharing an expiry time are processed in start order.
+	 */
+	expiry = ( timer->start + timer->timeout );
+	list_for_each_entry ( pending, &timers, list ) {
+		if ( ( ( signed long ) ( ( pending->start + pending->timeout )
+					 - expiry ) ) > 0 )
+			break;
+	}
+	list_add_tail ( &timer->list, &pending->list );
+
 	DBGC2 ( timer, "Timer %p started at time %ld (expires at %ld)\n",
 		timer, timer->start, ( timer->start + timer->timeout ) );
 }
@@ -197,20 +216,18 @@ static void timer_expired ( struct retry_timer *timer ) {
 void retry_poll ( void ) {
 	struct retry_timer *timer;
 	unsigned long now = currticks();
-	unsigned long used;
 
 	/* Process at most one timer expiry.  We cannot process
 	 * multiple expiries in one pass, because one timer expiring
 	 * may end up triggering another timer's deletion from the
 	 * list.
+	 *
+	 * The list is sorted by expiry time, so only the head of the
+	 * list need be examined.
 	 */
-	list_for_each_entry ( timer, &timers, list ) {
-		used = ( now - timer->start );
-		if ( used >= timer->timeout ) {
-			timer_expired ( timer );
-			break;
-		}
-	}
+	timer = list_first_entry ( &timers, struct retry_timer, list );
+	if ( timer && ( ( now - timer->start ) >= timer->timeout ) )
+		timer_expired ( timer );
 }
 
 /**
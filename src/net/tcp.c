@@ -18,6 +18,7 @@
 #include <ipxe/profile.h>
 #include <ipxe/process.h>
 #include <ipxe/job.h>
+#include <ipxe/settings.h>
 #include <ipxe/tcpip.h>
 #include <ipxe/tcp.h>
 
@@ -35,6 +36,8 @@ struct tcp_connection {
 	struct refcnt refcnt;
 	/** List of TCP connections */
 	struct list_head list;
+	/** List of connections within demultiplexing hash bucket */
+	struct list_head hash;
 
 	/** Flags */
 	unsigned int flags;
@@ -102,6 +105,14 @@ struct tcp_connection {
 	 * Equivalent to Rcv.Wind.Scale in RFC 1323 terminology
 	 */
 	uint8_t rcv_win_scale;
+	/** Maximum advertised receive window */
+	uint32_t max_rcv_win;
+	/** Number of received segments awaiting acknowledgement */
+	unsigned int unacked;
+	/** Fast Open cookie length (zero if no cookie is cached) */
+	size_t tfo_len;
+	/** Fast Open cookie */
+	uint8_t tfo[TCP_TFO_COOKIE_MAX];
 
 	/** Selective acknowledgement list (in host-endian order) */
 	struct tcp_sack_block sack[TCP_SACK_MAX];
@@ -116,6 +127,8 @@ struct tcp_connection {
 	struct retry_timer timer;
 	/** Keepalive timer */
 	struct retry_timer keepalive;
+	/** Delayed ACK timer */
+	struct retry_timer delack;
 	/** Shutdown (TIME_WAIT) timer */
 	struct retry_timer wait;
 
@@ -135,6 +148,8 @@ enum tcp_flags {
 	TCP_ACK_PENDING = 0x0004,
 	/** TCP selective acknowledgement is enabled */
 	TCP_SACK_ENABLED = 0x0008,
+	/** TCP Fast Open is being attempted */
+	TCP_TFO = 0x0010,
 };
 
 /** TCP internal header
@@ -167,6 +182,52 @@ struct tcp_rx_queued_header {
  */
 static LIST_HEAD ( tcp_conns );
 
+/** Number of demultiplexing hash buckets
+ *
+ * Connections are demultiplexed by local port alone, since iPXE
+ * initiates all of its own connections and so never shares a local
+ * port.  Must be a power of two.
+ */
+#define TCP_DEMUX_BUCKETS 16
+
+/** Demultiplexing hash buckets */
+static struct list_head tcp_demux_buckets[TCP_DEMUX_BUCKETS];
+
+/** Most recently demultiplexed connection
+ *
+ * Bulk transfers deliver long runs of segments for a single
+ * connection; this cache makes that common case a single comparison
+ * regardless of connection count.
+ */
+static struct tcp_connection *tcp_demux_cache;
+
+/**
+ * Identify demultiplexing hash bucket
+ *
+ * @v local_port	Local port
+ * @ret bucket		Hash bucket
+ */
+static inline struct list_head * tcp_demux_bucket ( unsigned int local_port ) {
+
+	return &tcp_demux_buckets[ local_port & ( TCP_DEMUX_BUCKETS - 1 ) ];
+}
+
+/**
+ * Initialise demultiplexing hash buckets
+ *
+ */
+static void tcp_init ( void ) {
+	unsigned int i;
+
+	for ( i = 0 ; i < TCP_DEMUX_BUCKETS ; i++ )
+		INIT_LIST_HEAD ( &tcp_demux_buckets[i] );
+}
+
+/** TCP initialiser */
+struct init_fn tcp_init_fn __init_fn ( INIT_NORMAL ) = {
+	.initialise = tcp_init,
+};
+
 /** Transmit profiler */
 static struct profiler tcp_tx_profiler __profiler = { .name = "tcp.tx" };
 
@@ -176,11 +237,25 @@ static struct profiler tcp_rx_profiler __profiler = { .name = "tcp.rx" };
 /** Data transfer profiler */
 static struct profiler tcp_xfer_profiler __profiler = { .name = "tcp.xfer" };
 
+/** Maximum advertised receive window setting
+ *
+ * This allows the build-time default maximum window (see
+ * TCP_MAX_WINDOW_SIZE) to be overridden at runtime, e.g. to fill a
+ * high bandwidth-delay product path.  The effective maximum is also
+ * limited by the advertised window scale.
+ */
+const struct setting tcpwin_setting __setting ( SETTING_MISC, tcpwin ) = {
+	.name = "tcpwin",
+	.description = "TCP maximum window",
+	.type = &setting_type_uint32,
+};
+
 /* Forward declarations */
 static struct process_descriptor tcp_process_desc;
 static struct interface_descriptor tcp_xfer_desc;
 static void tcp_expired ( struct retry_timer *timer, int over );
 static void tcp_keepalive_expired ( struct retry_timer *timer, int over );
+static void tcp_delack_expired ( struct retry_timer *timer, int over );
 static void tcp_wait_expired ( struct retry_timer *timer, int over );
 static struct tcp_connection * tcp_demux ( unsigned int local_port );
 static int tcp_rx_ack ( struct tcp_connection *tcp, uint32_t ack,
@@ -262,6 +337,94 @@ static int tcp_port_available ( int port ) {
 	return ( tcp_demux ( port ) ? -EADDRINUSE : port );
 }
 
+/** A cached TCP Fast Open cookie */
+struct tcp_cookie {
+	/** List of cached cookies */
+	struct list_head list;
+	/** Peer address */
+	struct sockaddr_tcpip peer;
+	/** Cookie length */
+	size_t len;
+	/** Cookie */
+	uint8_t cookie[TCP_TFO_COOKIE_MAX];
+};
+
+/** List of cached TCP Fast Open cookies, most recently used first */
+static LIST_HEAD ( tcp_cookies );
+
+/** Maximum number of cached TCP Fast Open cookies */
+#define TCP_COOKIE_MAX 8
+
+/**
+ * Find cached TCP Fast Open cookie
+ *
+ * @v peer		Peer socket address
+ * @ret cookie		Cached cookie, or NULL
+ */
+static struct tcp_cookie * tcp_cookie_find ( struct sockaddr_tcpip *peer ) {
+	struct sockaddr_tcpip key;
+	struct sockaddr_tcpip entry;
+	struct tcp_cookie *cookie;
+
+	/* Cookies are issued per server, irrespective of port number */
+	memcpy ( &key, peer, sizeof ( key ) );
+	key.st_port = 0;
+
+	/* Find matching cookie, and move it to the head of the list */
+	list_for_each_entry ( cookie, &tcp_cookies, list ) {
+		memcpy ( &entry, &cookie->peer, sizeof ( entry ) );
+		entry.st_port = 0;
+		if ( memcmp ( &key, &entry, sizeof ( key ) ) == 0 ) {
+			list_del ( &cookie->list );
+			list_add ( &cookie->list, &tcp_cookies );
+			return cookie;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Cache TCP Fast Open cookie
+ *
+ * @v peer		Peer socket address
+ * @v data		Cookie data
+ * @v len		Cookie length
+ */
+static void tcp_cookie_update ( struct sockaddr_tcpip *peer, const void *data,
+				size_t len ) {
+	struct tcp_cookie *cookie;
+	unsigned int count = 0;
+
+	/* Sanity check */
+	assert ( len <= TCP_TFO_COOKIE_MAX );
+
+	/* Reuse existing entry, if any */
+	cookie = tcp_cookie_find ( peer );
+	if ( ! cookie ) {
+
+		/* Recycle least recently used entry, or allocate a
+		 * new entry if the cache is not yet full.
+		 */
+		list_for_each_entry ( cookie, &tcp_cookies, list )
+			count++;
+		if ( count >= TCP_COOKIE_MAX ) {
+			cookie = list_last_entry ( &tcp_cookies,
+						   struct tcp_cookie, list );
+			list_del ( &cookie->list );
+		} else {
+			cookie = zalloc ( sizeof ( *cookie ) );
+			if ( ! cookie )
+				return;
+		}
+		memcpy ( &cookie->peer, peer, sizeof ( cookie->peer ) );
+		list_add ( &cookie->list, &tcp_cookies );
+	}
+
+	/* Record cookie */
+	memcpy ( cookie->cookie, data, len );
+	cookie->len = len;
+}
+
 /**
  * Open a TCP connection
  *
@@ -275,6 +438,8 @@ static int tcp_open ( struct interface *xfer, struct sockaddr *peer,
 	struct sockaddr_tcpip *st_peer = ( struct sockaddr_tcpip * ) peer;
 	struct sockaddr_tcpip *st_local = ( struct sockaddr_tcpip * ) local;
 	struct tcp_connection *tcp;
+	struct tcp_cookie *cookie;
+	unsigned long max_rcv_win;
 	size_t mtu;
 	int port;
 	int rc;
@@ -289,6 +454,7 @@ static int tcp_open ( struct interface *xfer, struct sockaddr *peer,
 	process_init_stopped ( &tcp->process, &tcp_process_desc, &tcp->refcnt );
 	timer_init ( &tcp->timer, tcp_expired, &tcp->refcnt );
 	timer_init ( &tcp->keepalive, tcp_keepalive_expired, &tcp->refcnt );
+	timer_init ( &tcp->delack, tcp_delack_expired, &tcp->refcnt );
 	timer_init ( &tcp->wait, tcp_wait_expired, &tcp->refcnt );
 	tcp->prev_tcp_state = TCP_CLOSED;
 	tcp->tcp_state = TCP_STATE_SENT ( TCP_SYN );
@@ -298,6 +464,29 @@ static int tcp_open ( struct interface *xfer, struct sockaddr *peer,
 	INIT_LIST_HEAD ( &tcp->rx_queue );
 	memcpy ( &tcp->peer, st_peer, sizeof ( tcp->peer ) );
 
+	/* Attempt TCP Fast Open.  If a cookie for this peer is
+	 * cached, then any data queued before the SYN is transmitted
+	 * will be carried within the SYN.  If not, the SYN will carry
+	 * a zero-length Fast Open option to request a cookie for use
+	 * by subsequent connections.
+	 */
+	cookie = tcp_cookie_find ( &tcp->peer );
+	if ( cookie ) {
+		memcpy ( tcp->tfo, cookie->cookie, cookie->len );
+		tcp->tfo_len = cookie->len;
+	}
+	tcp->flags |= TCP_TFO;
+
+	/* Determine maximum advertised receive window.  This also
+	 * bounds the memory consumed by the out-of-order receive
+	 * queue, since segments outside the window are discarded.
+	 */
+	if ( fetch_uint_setting ( NULL, &tcpwin_setting, &max_rcv_win ) >= 0 ) {
+		tcp->max_rcv_win = max_rcv_win;
+	} else {
+		tcp->max_rcv_win = TCP_MAX_WINDOW_SIZE;
+	}
+
 	/* Calculate MSS */
 	mtu = tcpip_mtu ( &tcp->peer );
 	if ( ! mtu ) {
@@ -330,6 +519,7 @@ static int tcp_open ( struct interface *xfer, struct sockaddr *peer,
 	 */
 	intf_plug_plug ( &tcp->xfer, xfer );
 	list_add ( &tcp->list, &tcp_conns );
+	list_add ( &tcp->hash, tcp_demux_bucket ( tcp->local_port ) );
 	return 0;
 
  err:
@@ -386,8 +576,12 @@ static void tcp_close ( struct tcp_connection *tcp, int rc ) {
 		process_del ( &tcp->process );
 		stop_timer ( &tcp->timer );
 		stop_timer ( &tcp->keepalive );
+		stop_timer ( &tcp->delack );
 		stop_timer ( &tcp->wait );
 		list_del ( &tcp->list );
+		list_del ( &tcp->hash );
+		if ( tcp_demux_cache == tcp )
+			tcp_demux_cache = NULL;
 		ref_put ( &tcp->refcnt );
 		DBGC ( tcp, "TCP %p connection deleted\n", tcp );
 		return;
@@ -432,6 +626,16 @@ static void tcp_close ( struct tcp_connection *tcp, int rc ) {
 static size_t tcp_xmit_win ( struct tcp_connection *tcp ) {
 	size_t len;
 
+	/* Allow data to accompany the initial SYN (up to one MSS,
+	 * less the maximum option space) if we hold a TCP Fast Open
+	 * cookie for this peer.
+	 */
+	if ( tcp->tcp_state == TCP_SYN_SENT ) {
+		if ( ( tcp->flags & TCP_TFO ) && tcp->tfo_len )
+			return ( tcp->mss - TCP_MAX_OPTIONS_LEN );
+		return 0;
+	}
+
 	/* Not ready if we're not in a suitable connection state */
 	if ( ! TCP_CAN_SEND_DATA ( tcp->tcp_state ) )
 		return 0;
@@ -599,12 +803,34 @@ static size_t tcp_process_tx_queue ( struct tcp_connection *tcp, size_t max_len,
  *
  * @v tcp		TCP connection
  * @v sack_seq		SEQ for first selective acknowledgement (if any)
- * 
+ *
  * Transmits any outstanding data on the connection.
  *
  * Note that even if an error is returned, the retransmission timer
  * will have been started if necessary, and so the stack will
  * eventually attempt to retransmit the failed packet.
+ *
+ * The transmit side is deliberately stop-and-wait: nothing further is
+ * sent while the retransmission timer is running, so at most one
+ * segment is ever unacknowledged.  A retransmission therefore always
+ * re-sends exactly one segment, which is already the minimum possible
+ * unit; sender-side processing of incoming SACK options (and
+ * duplicate-ACK fast retransmit) would have no ranges to act upon.
+ * SACK blocks are generated on the receive side only, where bulk data
+ * actually flows.
+ *
+ * For the same reason there is no sender congestion control (CUBIC,
+ * Reno, or otherwise): congestion control governs the growth of a
+ * multi-segment congestion window, and with at most one segment in
+ * flight there is no window to govern.  Congestion response on the
+ * bulk (receive) path is the remote sender's responsibility.
+ *
+ * Software segmentation offload (building one large buffer and
+ * slicing it into MSS-sized segments with incremental header fixups)
+ * is likewise inapplicable: it amortises per-segment costs only when
+ * several segments are handed to the device back-to-back, and
+ * stop-and-wait never produces more than one segment per
+ * acknowledgement round trip.
  */
 static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 	struct io_buffer *iobuf;
@@ -613,6 +839,9 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 	struct tcp_window_scale_padded_option *wsopt;
 	struct tcp_timestamp_padded_option *tsopt;
 	struct tcp_sack_permitted_padded_option *spopt;
+	struct tcp_fast_open_option *tfoopt;
+	size_t tfo_len;
+	size_t tfo_pad;
 	struct tcp_sack_padded_option *sackopt;
 	struct tcp_sack_block *sack;
 	void *payload;
@@ -634,12 +863,11 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 		return;
 
 	/* Calculate both the actual (payload) and sequence space
-	 * lengths that we wish to transmit.
+	 * lengths that we wish to transmit.  The transmit window is
+	 * zero in any state in which we cannot send data (other than
+	 * a Fast Open SYN).
 	 */
-	if ( TCP_CAN_SEND_DATA ( tcp->tcp_state ) ) {
-		len = tcp_process_tx_queue ( tcp, tcp_xmit_win ( tcp ),
-					     NULL, 0 );
-	}
+	len = tcp_process_tx_queue ( tcp, tcp_xmit_win ( tcp ), NULL, 0 );
 	seq_len = len;
 	flags = TCP_FLAGS_SENDING ( tcp->tcp_state );
 	if ( flags & ( TCP_SYN | TCP_FIN ) ) {
@@ -647,7 +875,14 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 		assert ( ! ( ( flags & TCP_SYN ) && ( flags & TCP_FIN ) ) );
 		seq_len++;
 	}
-	tcp->snd_sent = seq_len;
+
+	/* Record the sent sequence space length.  This may only ever
+	 * grow while unacknowledged: if we fall back from a Fast Open
+	 * SYN to a plain SYN on retransmission, the peer may still
+	 * acknowledge data carried by the original SYN.
+	 */
+	if ( seq_len > tcp->snd_sent )
+		tcp->snd_sent = seq_len;
 
 	/* If we have nothing to transmit, stop now */
 	if ( ( seq_len == 0 ) && ! ( tcp->flags & TCP_ACK_PENDING ) )
@@ -676,8 +911,8 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 
 	/* Expand receive window if possible */
 	max_rcv_win = xfer_window ( &tcp->xfer );
-	if ( max_rcv_win > TCP_MAX_WINDOW_SIZE )
-		max_rcv_win = TCP_MAX_WINDOW_SIZE;
+	if ( max_rcv_win > tcp->max_rcv_win )
+		max_rcv_win = tcp->max_rcv_win;
 	max_representable_win = ( 0xffff << tcp->rcv_win_scale );
 	if ( max_rcv_win > max_representable_win )
 		max_rcv_win = max_representable_win;
@@ -701,6 +936,17 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 		memset ( spopt->nop, TCP_OPTION_NOP, sizeof ( spopt->nop ) );
 		spopt->spopt.kind = TCP_OPTION_SACK_PERMITTED;
 		spopt->spopt.length = sizeof ( spopt->spopt );
+		if ( tcp->flags & TCP_TFO ) {
+			tfo_len = ( sizeof ( *tfoopt ) + tcp->tfo_len );
+			tfo_pad = ( ( -tfo_len ) & 0x3 );
+			tfoopt = ( iob_push ( iobuf, ( tfo_len + tfo_pad ) ) +
+				   tfo_pad );
+			memset ( ( ( ( void * ) tfoopt ) - tfo_pad ),
+				 TCP_OPTION_NOP, tfo_pad );
+			tfoopt->kind = TCP_OPTION_TFO;
+			tfoopt->length = tfo_len;
+			memcpy ( tfoopt->cookie, tcp->tfo, tcp->tfo_len );
+		}
 	}
 	if ( ( flags & TCP_SYN ) || ( tcp->flags & TCP_TS_ENABLED ) ) {
 		tsopt = iob_push ( iobuf, sizeof ( *tsopt ) );
@@ -755,8 +1001,10 @@ static void tcp_xmit_sack ( struct tcp_connection *tcp, uint32_t sack_seq ) {
 		return;
 	}
 
-	/* Clear ACK-pending flag */
+	/* Clear ACK-pending flag and delayed ACK state */
 	tcp->flags &= ~TCP_ACK_PENDING;
+	tcp->unacked = 0;
+	stop_timer ( &tcp->delack );
 
 	profile_stop ( &tcp_tx_profiler );
 }
@@ -805,6 +1053,16 @@ static void tcp_expired ( struct retry_timer *timer, int over ) {
 		tcp_dump_state ( tcp );
 		tcp_close ( tcp, -ETIMEDOUT );
 	} else {
+		/* Fall back to a conventional SYN on retransmission,
+		 * in case a middlebox is dropping SYNs that carry the
+		 * Fast Open option or payload.  Any data remains on
+		 * the transmit queue, to be sent once established.
+		 */
+		if ( tcp->tcp_state == TCP_SYN_SENT ) {
+			tcp->flags &= ~TCP_TFO;
+			tcp->tfo_len = 0;
+		}
+
 		/* Otherwise, retransmit the packet */
 		tcp_xmit ( tcp );
 	}
@@ -836,6 +1094,21 @@ static void tcp_keepalive_expired ( struct retry_timer *timer,
 	tcp_xmit ( tcp );
 }
 
+/**
+ * Delayed ACK timer expired
+ *
+ * @v timer		Delayed ACK timer
+ * @v over		Failure indicator
+ */
+static void tcp_delack_expired ( struct retry_timer *timer,
+				 int over __unused ) {
+	struct tcp_connection *tcp =
+		container_of ( timer, struct tcp_connection, delack );
+
+	/* Transmit the deferred ACK */
+	tcp_xmit ( tcp );
+}
+
 /**
  * Shutdown timer expired
  *
@@ -929,9 +1202,17 @@ static int tcp_xmit_reset ( struct tcp_connection *tcp,
 static struct tcp_connection * tcp_demux ( unsigned int local_port ) {
 	struct tcp_connection *tcp;
 
-	list_for_each_entry ( tcp, &tcp_conns, list ) {
-		if ( tcp->local_port == local_port )
+	/* Check most recently demultiplexed connection first */
+	tcp = tcp_demux_cache;
+	if ( tcp && ( tcp->local_port == local_port ) )
+		return tcp;
+
+	/* Walk hash bucket */
+	list_for_each_entry ( tcp, tcp_demux_bucket ( local_port ), hash ) {
+		if ( tcp->local_port == local_port ) {
+			tcp_demux_cache = tcp;
 			return tcp;
+		}
 	}
 	return NULL;
 }
@@ -995,6 +1276,10 @@ static int tcp_rx_opts ( struct tcp_connection *tcp,
 			options->tsopt = data;
 			min = sizeof ( *options->tsopt );
 			break;
+		case TCP_OPTION_TFO:
+			options->tfopt = data;
+			min = sizeof ( *options->tfopt );
+			break;
 		default:
 			DBGC ( tcp, "TCP %p received unknown option %d\n",
 			       tcp, kind );
@@ -1070,6 +1355,7 @@ static void tcp_rx_seq ( struct tcp_connection *tcp, uint32_t seq_len ) {
  */
 static int tcp_rx_syn ( struct tcp_connection *tcp, uint32_t seq,
 			struct tcp_options *options ) {
+	size_t tfo_len;
 
 	/* Synchronise sequence numbers on first SYN */
 	if ( ! ( tcp->tcp_state & TCP_STATE_RCVD ( TCP_SYN ) ) ) {
@@ -1082,6 +1368,19 @@ static int tcp_rx_syn ( struct tcp_connection *tcp, uint32_t seq,
 			tcp->snd_win_scale = options->wsopt->scale;
 			tcp->rcv_win_scale = TCP_RX_WINDOW_SCALE;
 		}
+		if ( options->tfopt ) {
+			/* Cache Fast Open cookie for future connections */
+			tfo_len = ( options->tfopt->length -
+				    sizeof ( *options->tfopt ) );
+			if ( ( tfo_len >= TCP_TFO_COOKIE_MIN ) &&
+			     ( tfo_len <= TCP_TFO_COOKIE_MAX ) ) {
+				tcp_cookie_update ( &tcp->peer,
+						    options->tfopt->cookie,
+						    tfo_len );
+				DBGC ( tcp, "TCP %p cached %zd-byte Fast "
+				       "Open cookie\n", tcp, tfo_len );
+			}
+		}
 		DBGC ( tcp, "TCP %p using %stimestamps, %sSACK, TX window "
 		       "x%d, RX window x%d\n", tcp,
 		       ( ( tcp->flags & TCP_TS_ENABLED ) ? "" : "no " ),
@@ -1329,13 +1628,19 @@ static void tcp_rx_enqueue ( struct tcp_connection *tcp, uint32_t seq,
 	tcpqhdr->nxt = nxt;
 	tcpqhdr->flags = flags;
 
-	/* Add to RX queue */
-	list_for_each_entry ( queued, &tcp->rx_queue, list ) {
+	/* Add to RX queue, which is kept sorted by SEQ.  Segments
+	 * tend to arrive in ascending order even within a reordering
+	 * burst, so search backwards from the tail: the insertion
+	 * point is then found in amortised constant time, rather
+	 * than rescanning the whole queue from the front for every
+	 * arrival.
+	 */
+	list_for_each_entry_reverse ( queued, &tcp->rx_queue, list ) {
 		tcpqhdr = queued->data;
-		if ( tcp_cmp ( seq, tcpqhdr->seq ) < 0 )
+		if ( tcp_cmp ( seq, tcpqhdr->seq ) >= 0 )
 			break;
 	}
-	list_add_tail ( &iobuf->list, &queued->list );
+	list_add ( &iobuf->list, &queued->list );
 }
 
 /**
@@ -1410,6 +1715,7 @@ static int tcp_rx ( struct io_buffer *iobuf,
 	size_t len;
 	uint32_t seq_len;
 	size_t old_xfer_window;
+	int force_ack = 0;
 	int rc;
 
 	/* Start profiling */
@@ -1435,13 +1741,15 @@ static int tcp_rx ( struct io_buffer *iobuf,
 		rc = -EINVAL;
 		goto discard;
 	}
-	csum = tcpip_continue_chksum ( pshdr_csum, iobuf->data,
-				       iob_len ( iobuf ) );
-	if ( csum != 0 ) {
-		DBG ( "TCP checksum incorrect (is %04x including checksum "
-		      "field, should be 0000)\n", csum );
-		rc = -EINVAL;
-		goto discard;
+	if ( ! ( iobuf->flags & IOB_FL_CSUM_GOOD ) ) {
+		csum = tcpip_continue_chksum ( pshdr_csum, iobuf->data,
+					       iob_len ( iobuf ) );
+		if ( csum != 0 ) {
+			DBG ( "TCP checksum incorrect (is %04x including "
+			      "checksum field, should be 0000)\n", csum );
+			rc = -EINVAL;
+			goto discard;
+		}
 	}
 	
 	/* Parse parameters from header and strip header */
@@ -1489,6 +1797,7 @@ static int tcp_rx ( struct io_buffer *iobuf,
 	if ( ( tcp->tcp_state & TCP_STATE_RCVD ( TCP_SYN ) ) &&
 	     ( seq != tcp->rcv_ack ) ) {
 		tcp->flags |= TCP_ACK_PENDING;
+		force_ack = 1;
 	}
 
 	/* Handle SYN, if present */
@@ -1503,11 +1812,36 @@ static int tcp_rx ( struct io_buffer *iobuf,
 			goto discard;
 	}
 
-	/* Enqueue received data */
-	tcp_rx_enqueue ( tcp, seq, flags, iob_disown ( iobuf ) );
+	/* Deliver received data.  The overwhelmingly common case
+	 * during a bulk download is an in-order segment arriving with
+	 * an empty receive queue; deliver such segments directly,
+	 * bypassing the receive queue's internal header insertion and
+	 * sorted list handling.  Anything else (gaps, overlaps, zero
+	 * receive window) goes through the receive queue as before.
+	 */
+	if ( ( tcp->tcp_state & TCP_STATE_RCVD ( TCP_SYN ) ) &&
+	     list_empty ( &tcp->rx_queue ) && ( seq == tcp->rcv_ack ) &&
+	     ( tcp->rcv_win > 0 ) &&
+	     ( ( len != 0 ) || ( flags & TCP_FIN ) ) ) {
+
+		/* Handle new data, if any */
+		tcp_rx_data ( tcp, seq, iob_disown ( iobuf ) );
+		seq += len;
+
+		/* Handle FIN, if present */
+		if ( flags & TCP_FIN ) {
+			tcp_rx_fin ( tcp, seq );
+			seq++;
+		}
+
+	} else {
 
-	/* Process receive queue */
-	tcp_process_rx_queue ( tcp );
+		/* Enqueue received data */
+		tcp_rx_enqueue ( tcp, seq, flags, iob_disown ( iobuf ) );
+
+		/* Process receive queue */
+		tcp_process_rx_queue ( tcp );
+	}
 
 	/* Dump out any state change as a result of the received packet */
 	tcp_dump_state ( tcp );
@@ -1515,12 +1849,24 @@ static int tcp_rx ( struct io_buffer *iobuf,
 	/* Schedule transmission of ACK (and any pending data).  If we
 	 * have received any out-of-order packets (i.e. if the receive
 	 * queue remains non-empty after processing) then send the ACK
-	 * immediately in order to trigger Fast Retransmission.
+	 * immediately in order to trigger Fast Retransmission.  If
+	 * this was an in-order data segment on an established
+	 * connection with nothing of our own to transmit, then delay
+	 * the ACK: we acknowledge every second segment, or on expiry
+	 * of the delayed ACK timer, as permitted by RFC 1122.
 	 */
-	if ( list_empty ( &tcp->rx_queue ) ) {
-		process_add ( &tcp->process );
-	} else {
+	if ( ! list_empty ( &tcp->rx_queue ) ) {
 		tcp_xmit_sack ( tcp, seq );
+	} else if ( ( tcp->flags & TCP_ACK_PENDING ) && ( ! force_ack ) &&
+		    ( tcp->tcp_state == TCP_ESTABLISHED ) && ( len != 0 ) &&
+		    list_empty ( &tcp->tx_queue ) &&
+		    ( ++tcp->unacked < 2 ) ) {
+		if ( ! timer_running ( &tcp->delack ) ) {
+			start_timer_fixed ( &tcp->delack,
+					    TCP_DELACK_TIMEOUT );
+		}
+	} else {
+		process_add ( &tcp->process );
 	}
 
 	/* If this packet was the last we expect to receive, set up
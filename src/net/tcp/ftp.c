@@ -43,11 +43,18 @@
 
 FEATURE ( FEATURE_PROTOCOL, "FTP", DHCP_EB_FEATURE_FTP, 1 );
 
+/** Maximum number of attempts to resume an interrupted transfer
+ *
+ * This is a policy decision.
+ */
+#define FTP_MAX_RESUMES 8
+
 /**
  * FTP states
  *
  * These @b must be sequential, i.e. a successful FTP session must
- * pass through each of these states in order.
+ * pass through each of these states in order.  (Resuming an
+ * interrupted transfer rewinds from the transfer back to FTP_PASV.)
  */
 enum ftp_state {
 	FTP_CONNECT = 0,
@@ -56,6 +63,7 @@ enum ftp_state {
 	FTP_TYPE,
 	FTP_SIZE,
 	FTP_PASV,
+	FTP_REST,
 	FTP_RETR,
 	FTP_WAIT,
 	FTP_QUIT,
@@ -91,6 +99,22 @@ struct ftp_request {
 	char passive_text[24]; /* "aaa,bbb,ccc,ddd,eee,fff" */
 	/** File size, as text */
 	char filesize[20];
+	/** File size (zero if not reported by the server) */
+	size_t size;
+	/** Amount of file data received so far */
+	size_t offset;
+	/** Restart offset, as text */
+	char restart_text[20];
+	/** A resume is pending the second end-of-transfer event
+	 *
+	 * An interrupted transfer produces two events: the data
+	 * channel closes, and a completion reply arrives on the
+	 * control channel.  These may happen in either order; the
+	 * resume is initiated by whichever happens second.
+	 */
+	int resume;
+	/** Number of resume attempts so far */
+	unsigned int resumes;
 };
 
 /**
@@ -174,6 +198,18 @@ static const char * ftp_password ( struct ftp_request *ftp ) {
 	return ftp->uri->password ? ftp->uri->password : ftp_default_password;
 }
 
+/**
+ * Retrieve FTP restart offset
+ *
+ * @v ftp		FTP request
+ * @ret restart		Restart offset, as text
+ */
+static const char * ftp_restart ( struct ftp_request *ftp ) {
+	snprintf ( ftp->restart_text, sizeof ( ftp->restart_text ), "%zd",
+		   ftp->offset );
+	return ftp->restart_text;
+}
+
 /** FTP control channel strings */
 static struct ftp_control_string ftp_strings[] = {
 	[FTP_CONNECT]	= { NULL, NULL },
@@ -182,6 +218,7 @@ static struct ftp_control_string ftp_strings[] = {
 	[FTP_TYPE]	= { "TYPE I", NULL },
 	[FTP_SIZE]	= { "SIZE ", ftp_uri_path },
 	[FTP_PASV]	= { "PASV", NULL },
+	[FTP_REST]	= { "REST ", ftp_restart },
 	[FTP_RETR]	= { "RETR ", ftp_uri_path },
 	[FTP_WAIT]	= { NULL, NULL },
 	[FTP_QUIT]	= { "QUIT", NULL },
@@ -226,6 +263,10 @@ static void ftp_next_state ( struct ftp_request *ftp ) {
 	if ( ftp->state < FTP_DONE )
 		ftp->state++;
 
+	/* Skip the REST command unless resuming a partial transfer */
+	if ( ( ftp->state == FTP_REST ) && ( ftp->offset == 0 ) )
+		ftp->state++;
+
 	/* Send control string if needed */
 	ftp_string = &ftp_strings[ftp->state];
 	literal = ftp_string->literal;
@@ -237,6 +278,31 @@ static void ftp_next_state ( struct ftp_request *ftp ) {
 	}
 }
 
+/**
+ * Resume an interrupted FTP transfer
+ *
+ * @v ftp		FTP request
+ *
+ * Rewind the state machine to re-open a data connection and restart
+ * the transfer from the current offset, using the still-open control
+ * channel.
+ */
+static void ftp_resume ( struct ftp_request *ftp ) {
+
+	DBGC ( ftp, "FTP %p resuming transfer from %zd\n", ftp, ftp->offset );
+	ftp->resumes++;
+	ftp->resume = 0;
+
+	/* Ensure the old data channel is fully shut down, so that the
+	 * interface can be reused for the new data connection.
+	 */
+	intf_restart ( &ftp->data, 0 );
+
+	/* Rewind to re-open a data connection */
+	ftp->state = FTP_SIZE;
+	ftp_next_state ( ftp );
+}
+
 /**
  * Handle an FTP control channel response
  *
@@ -258,6 +324,25 @@ static void ftp_reply ( struct ftp_request *ftp ) {
 	if ( status_major == '1' )
 		return;
 
+	/* If a resume is pending, then this is the completion reply
+	 * for the interrupted transfer (the data channel has already
+	 * closed): any completion status simply triggers the resume.
+	 */
+	if ( ( ftp->state == FTP_RETR ) && ftp->resume ) {
+		ftp_resume ( ftp );
+		return;
+	}
+
+	/* A failed transfer (e.g. "426 connection closed") may be
+	 * resumable: wait for the data channel to close, then restart
+	 * from the current offset.
+	 */
+	if ( ( status_major == '4' ) && ( ftp->state == FTP_RETR ) &&
+	     ftp->offset && ( ftp->resumes < FTP_MAX_RESUMES ) ) {
+		ftp->resume = 1;
+		return;
+	}
+
 	/* If the SIZE command is not supported by the server, we go to
 	 * the next step.
 	 */
@@ -267,11 +352,13 @@ static void ftp_reply ( struct ftp_request *ftp ) {
 	}
 
 	/* Anything other than success (2xx) or, in the case of a
-	 * repsonse to a "USER" command, a password prompt (3xx), is a
-	 * fatal error.
+	 * repsonse to a "USER" command or a "REST" command, an
+	 * intermediate success (3xx), is a fatal error.
 	 */
 	if ( ! ( ( status_major == '2' ) ||
-		 ( ( status_major == '3' ) && ( ftp->state == FTP_USER ) ) ) ){
+		 ( ( status_major == '3' ) &&
+		   ( ( ftp->state == FTP_USER ) ||
+		     ( ftp->state == FTP_REST ) ) ) ) ) {
 		/* Flag protocol error and close connections */
 		ftp_done ( ftp, -EPROTO );
 		return;
@@ -291,6 +378,9 @@ static void ftp_reply ( struct ftp_request *ftp ) {
 			return;
 		}
 
+		/* Record size for detecting truncated transfers */
+		ftp->size = filesize;
+
 		/* Use seek() to notify recipient of filesize */
 		DBGC ( ftp, "FTP %p file size is %zd bytes\n", ftp, filesize );
 		xfer_seek ( &ftp->xfer, filesize );
@@ -403,6 +493,34 @@ static struct interface_descriptor ftp_control_desc =
  *
  */
 
+/**
+ * Handle new data arriving on the FTP data channel
+ *
+ * @v ftp		FTP request
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ *
+ * Data is passed through unmodified; we record the amount received so
+ * that an interrupted transfer can be resumed from the right offset.
+ */
+static int ftp_data_deliver ( struct ftp_request *ftp,
+			      struct io_buffer *iobuf,
+			      struct xfer_metadata *meta ) {
+	size_t len = iob_len ( iobuf );
+	int rc;
+
+	/* Deliver data */
+	if ( ( rc = xfer_deliver ( &ftp->xfer, iob_disown ( iobuf ),
+				   meta ) ) != 0 )
+		return rc;
+
+	/* Record amount received */
+	ftp->offset += len;
+
+	return 0;
+}
+
 /**
  * Handle FTP data channel being closed
  *
@@ -413,13 +531,44 @@ static struct interface_descriptor ftp_control_desc =
  * alone; the server will send a completion message via the control
  * channel which we'll pick up.
  *
- * If the data channel is closed due to an error, we abort the request.
+ * If the data channel is closed mid-transfer (or closed cleanly but
+ * short of the reported file size), we attempt to resume the transfer
+ * from the current offset rather than aborting, using the REST
+ * command on the still-open control channel.
  */
 static void ftp_data_closed ( struct ftp_request *ftp, int rc ) {
+	int incomplete;
 
 	DBGC ( ftp, "FTP %p data connection closed: %s\n",
 	       ftp, strerror ( rc ) );
-	
+
+	/* If the completion reply has already committed us to a
+	 * resume, then rewind now.
+	 */
+	if ( ftp->resume ) {
+		ftp_resume ( ftp );
+		return;
+	}
+
+	/* Attempt to resume an incomplete transfer, if applicable */
+	if ( ( ftp->state == FTP_RETR ) || ( ftp->state == FTP_WAIT ) ) {
+		incomplete = ( ( rc != 0 ) ||
+			       ( ftp->size && ( ftp->offset < ftp->size ) ) );
+		if ( incomplete && ftp->offset &&
+		     ( ftp->resumes < FTP_MAX_RESUMES ) ) {
+			if ( ftp->state == FTP_WAIT ) {
+				/* Completion reply already consumed:
+				 * rewind immediately.
+				 */
+				ftp_resume ( ftp );
+			} else {
+				/* Wait for the completion reply */
+				ftp->resume = 1;
+			}
+			return;
+		}
+	}
+
 	/* If there was an error, close control channel and record status */
 	if ( rc ) {
 		ftp_done ( ftp, rc );
@@ -430,6 +579,7 @@ static void ftp_data_closed ( struct ftp_request *ftp, int rc ) {
 
 /** FTP data channel interface operations */
 static struct interface_operation ftp_data_operations[] = {
+	INTF_OP ( xfer_deliver, struct ftp_request *, ftp_data_deliver ),
 	INTF_OP ( intf_close, struct ftp_request *, ftp_data_closed ),
 };
 
@@ -28,6 +28,16 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Hyper Text Transfer Protocol (HTTP) block device
  *
+ * The translator itself is stateless: each block device read becomes
+ * one ranged GET.  Performance comes from the layers either side of
+ * it.  The SAN device's readahead cache merges sequential small reads
+ * into large aligned ranges before they reach this translator, so a
+ * streaming loader costs one GET per readahead window rather than one
+ * per 512-byte block, and the HTTP connection pool keeps the origin
+ * connection (and any TLS session) alive between requests, so each
+ * GET costs a single round trip rather than a fresh handshake.  The
+ * SAN layer issues only one command at a time, which bounds the
+ * number of range requests in flight to one by design.
  */
 
 #include <stdint.h>
@@ -41,14 +41,30 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/xfer.h>
 #include <ipxe/open.h>
 #include <ipxe/pool.h>
+#include <ipxe/profile.h>
 #include <ipxe/http.h>
 
 /** HTTP pooled connection expiry time */
+#ifndef HTTP_CONN_EXPIRY
 #define HTTP_CONN_EXPIRY ( 10 * TICKS_PER_SEC )
+#endif
+
+/** Maximum number of pooled connections to a single origin */
+#ifndef HTTP_CONN_POOL_MAX
+#define HTTP_CONN_POOL_MAX 4
+#endif
 
 /** HTTP connection pool */
 static LIST_HEAD ( http_connection_pool );
 
+/** Pooled connection reuse profiler */
+static struct profiler http_conn_reuse_profiler __profiler =
+	{ .name = "httpconn.reuse" };
+
+/** Pooled connection miss profiler */
+static struct profiler http_conn_miss_profiler __profiler =
+	{ .name = "httpconn.miss" };
+
 /**
  * Identify HTTP scheme
  *
@@ -122,6 +138,22 @@ static void http_conn_expired ( struct pooled_connection *pool ) {
 	http_conn_close ( conn, 0 /* Not an error to close idle connection */ );
 }
 
+/**
+ * Check for matching connection origin
+ *
+ * @v conn		HTTP connection
+ * @v other		HTTP connection to compare against
+ * @ret matches		Connections are to the same origin
+ */
+static int http_conn_same_origin ( struct http_connection *conn,
+				   struct http_connection *other ) {
+
+	return ( ( conn->scheme == other->scheme ) &&
+		 ( strcmp ( conn->uri->host, other->uri->host ) == 0 ) &&
+		 ( uri_port ( conn->uri, conn->scheme->port ) ==
+		   uri_port ( other->uri, other->scheme->port ) ) );
+}
+
 /**
  * Receive data from transport layer interface
  *
@@ -180,11 +212,30 @@ static void http_conn_xfer_recycle ( struct http_connection *conn ) {
  * @v rc		Reason for close
  */
 static void http_conn_xfer_close ( struct http_connection *conn, int rc ) {
+	struct http_connection *pooled;
+	struct http_connection *oldest = NULL;
+	unsigned int count = 0;
 
 	/* Add to the connection pool if keepalive is enabled and no
 	 * error occurred.
 	 */
 	if ( ( rc == 0 ) && pool_is_recyclable ( &conn->pool ) ) {
+
+		/* Limit the number of pooled connections to this
+		 * origin, discarding the oldest (least recently
+		 * pooled) connection if applicable.
+		 */
+		list_for_each_entry ( pooled, &http_connection_pool,
+				      pool.list ) {
+			if ( ! http_conn_same_origin ( conn, pooled ) )
+				continue;
+			if ( ! oldest )
+				oldest = pooled;
+			count++;
+		}
+		if ( count >= HTTP_CONN_POOL_MAX )
+			http_conn_close ( oldest, 0 );
+
 		intf_restart ( &conn->xfer, rc );
 		pool_add ( &conn->pool, &http_connection_pool,
 			   HTTP_CONN_EXPIRY );
@@ -269,6 +320,11 @@ int http_connect ( struct interface *xfer, struct uri *uri ) {
 		     ( strcmp ( uri->host, conn->uri->host ) == 0 ) &&
 		     ( port == uri_port ( conn->uri, scheme->port ) ) ) {
 
+			/* Record pool hit (with idle time as sample) */
+			profile_custom ( &http_conn_reuse_profiler,
+					 ( currticks() -
+					   conn->pool.timer.start ) );
+
 			/* Remove from connection pool, stop timer,
 			 * attach to parent interface, and return.
 			 */
@@ -280,6 +336,9 @@ int http_connect ( struct interface *xfer, struct uri *uri ) {
 		}
 	}
 
+	/* Record pool miss */
+	profile_custom ( &http_conn_miss_profiler, 0 );
+
 	/* Allocate and initialise structure */
 	conn = zalloc ( sizeof ( *conn ) );
 	if ( ! conn ) {
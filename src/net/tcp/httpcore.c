@@ -58,6 +58,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/errortab.h>
 #include <ipxe/efi/efi_path.h>
 #include <ipxe/http.h>
+#include <ipxe/httpmux.h>
 
 /* Disambiguate the various error causes */
 #define EACCES_401 __einfo_error ( EINFO_EACCES_401 )
@@ -81,6 +82,9 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #define EIO_CONTENT_LENGTH __einfo_error ( EINFO_EIO_CONTENT_LENGTH )
 #define EINFO_EIO_CONTENT_LENGTH \
 	__einfo_uniqify ( EINFO_EIO, 0x02, "Content length mismatch" )
+#define EIO_RESUME __einfo_error ( EINFO_EIO_RESUME )
+#define EINFO_EIO_RESUME \
+	__einfo_uniqify ( EINFO_EIO, 0x03, "Resumed content mismatch" )
 #define EIO_4XX __einfo_error ( EINFO_EIO_4XX )
 #define EINFO_EIO_4XX \
 	__einfo_uniqify ( EINFO_EIO, 0x04, "HTTP 4xx Client Error" )
@@ -106,6 +110,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 /** Retry delay used when we cannot understand the Retry-After header */
 #define HTTP_RETRY_SECONDS 5
 
+/** Maximum number of download resumption attempts
+ *
+ * This is a policy decision.
+ */
+#define HTTP_RESUME_MAX 16
+
 /** Receive profiler */
 static struct profiler http_rx_profiler __profiler = { .name = "http.rx" };
 
@@ -266,6 +276,7 @@ static void http_free ( struct refcnt *refcnt ) {
 
 	empty_line_buffer ( &http->response.headers );
 	empty_line_buffer ( &http->linebuf );
+	free ( http->validator );
 	uri_put ( http->uri );
 	free ( http );
 }
@@ -331,6 +342,84 @@ static void http_reopen ( struct http_transaction *http ) {
 	http_close ( http, rc );
 }
 
+/**
+ * Attempt to resume an interrupted HTTP download
+ *
+ * @v http		HTTP transaction
+ * @v rc		Reason for interruption
+ * @ret rc		Return status code
+ *
+ * When a connection dies partway through a download, we can often
+ * avoid restarting from scratch.  If the server provided a validator
+ * (an ETag or Last-Modified header) then we may reissue the request
+ * with a range starting at the first byte not yet received, using
+ * If-Range to ensure that we do not conflate content from two
+ * different versions of the file.
+ */
+static int http_resume ( struct http_transaction *http, int rc ) {
+	const char *validator;
+	char *copy;
+
+	/* Resume only GET requests */
+	if ( http->request.method != &http_get )
+		return rc;
+
+	/* Resume only if the interrupted response was itself successful */
+	if ( http->response.rc != 0 )
+		return rc;
+
+	/* Resume only if some progress has been made since the last
+	 * (re)start, to guarantee that resumption cannot loop forever.
+	 */
+	if ( ! http->len )
+		return rc;
+
+	/* Resume only if the content is not encoded, since we count
+	 * progress in transfer-decoded bytes and a content encoding
+	 * would be left decoding the resumed data against a missing
+	 * initial state.
+	 */
+	if ( http->response.content.encoding )
+		return rc;
+
+	/* Resume only if the server provided a validator */
+	validator = http->response.etag;
+	if ( ! validator )
+		validator = http->response.last_modified;
+	if ( ! validator )
+		return rc;
+
+	/* Limit the total number of resume attempts */
+	if ( http->resumes >= HTTP_RESUME_MAX )
+		return rc;
+	http->resumes++;
+
+	/* Take a copy of the validator, since it points into the
+	 * response header buffer, which will be overwritten by the
+	 * resumed request's response.
+	 */
+	copy = strdup ( validator );
+	if ( ! copy )
+		return rc;
+	free ( http->validator );
+	http->validator = copy;
+
+	/* Update the request range to cover only the missing tail */
+	http->offset += http->len;
+	http->request.range.start += http->len;
+	if ( http->request.range.len )
+		http->request.range.len -= http->len;
+	http->len = 0;
+
+	DBGC ( http, "HTTP %p resuming at +%zd: %s\n",
+	       http, http->offset, strerror ( rc ) );
+
+	/* Reopen connection and retransmit request */
+	http_reopen ( http );
+
+	return 0;
+}
+
 /**
  * Handle retry timer expiry
  *
@@ -975,6 +1064,12 @@ static int http_format_range ( struct http_transaction *http,
 				  http->request.range.start,
 				  ( http->request.range.start +
 				    http->request.range.len - 1 ) );
+	} else if ( http->request.range.start ) {
+		/* An open-ended range is used when resuming an
+		 * interrupted download of a file of unknown length.
+		 */
+		return snprintf ( buf, len, "bytes=%zd-",
+				  http->request.range.start );
 	} else {
 		return 0;
 	}
@@ -986,6 +1081,30 @@ struct http_request_header http_request_range __http_request_header = {
 	.format = http_format_range,
 };
 
+/**
+ * Construct HTTP "If-Range" header
+ *
+ * @v http		HTTP transaction
+ * @v buf		Buffer
+ * @v len		Length of buffer
+ * @ret len		Length of header value, or negative error
+ */
+static int http_format_if_range ( struct http_transaction *http,
+				  char *buf, size_t len ) {
+
+	/* Construct validator for resumed requests, if applicable */
+	if ( http->validator )
+		return snprintf ( buf, len, "%s", http->validator );
+
+	return 0;
+}
+
+/** HTTP "If-Range" header */
+struct http_request_header http_request_if_range __http_request_header = {
+	.name = "If-Range",
+	.format = http_format_if_range,
+};
+
 /**
  * Construct HTTP "Content-Type" header
  *
@@ -1478,6 +1597,49 @@ struct http_response_header http_response_retry_after __http_response_header = {
 	.parse = http_parse_retry_after,
 };
 
+/**
+ * Parse HTTP "ETag" header
+ *
+ * @v http		HTTP transaction
+ * @v line		Remaining header line
+ * @ret rc		Return status code
+ */
+static int http_parse_etag ( struct http_transaction *http, char *line ) {
+
+	/* Record entity tag */
+	http->response.etag = line;
+
+	return 0;
+}
+
+/** HTTP "ETag" header */
+struct http_response_header http_response_etag __http_response_header = {
+	.name = "ETag",
+	.parse = http_parse_etag,
+};
+
+/**
+ * Parse HTTP "Last-Modified" header
+ *
+ * @v http		HTTP transaction
+ * @v line		Remaining header line
+ * @ret rc		Return status code
+ */
+static int http_parse_last_modified ( struct http_transaction *http,
+				      char *line ) {
+
+	/* Record modification time */
+	http->response.last_modified = line;
+
+	return 0;
+}
+
+/** HTTP "Last-Modified" header */
+struct http_response_header http_response_last_modified __http_response_header ={
+	.name = "Last-Modified",
+	.parse = http_parse_last_modified,
+};
+
 /**
  * Handle received HTTP headers
  *
@@ -1506,6 +1668,18 @@ static int http_rx_headers ( struct http_transaction *http,
 	if ( ( rc = http_parse_headers ( http ) ) != 0 )
 		return rc;
 
+	/* A resumed request requires a partial content response:
+	 * anything else means that the file has changed (or that the
+	 * server has ignored If-Range), and appending its body to the
+	 * data already delivered would corrupt the download.
+	 */
+	if ( http->offset && ( http->response.rc == 0 ) &&
+	     ( http->response.status != 206 ) ) {
+		DBGC ( http, "HTTP %p cannot resume: status %d\n",
+		       http, http->response.status );
+		return -EIO_RESUME;
+	}
+
 	/* Initialise content encoding, if applicable */
 	if ( ( content = http->response.content.encoding ) &&
 	     ( ( rc = content->init ( http ) ) != 0 ) ) {
@@ -1514,10 +1688,15 @@ static int http_rx_headers ( struct http_transaction *http,
 		return rc;
 	}
 
-	/* Presize receive buffer, if we have a content length */
+	/* Presize receive buffer, if we have a content length.  For a
+	 * resumed request, the response covers only the missing tail,
+	 * and the buffer position must be left at the resume offset
+	 * rather than rewound to zero.
+	 */
 	if ( http->response.content.len ) {
-		xfer_seek ( &http->transfer, http->response.content.len );
-		xfer_seek ( &http->transfer, 0 );
+		xfer_seek ( &http->transfer, ( http->offset +
+					       http->response.content.len ) );
+		xfer_seek ( &http->transfer, http->offset );
 	}
 
 	/* Complete transfer if this is a HEAD request */
@@ -1625,18 +1804,23 @@ static int http_rx_transfer_identity ( struct http_transaction *http,
 static void http_close_transfer_identity ( struct http_transaction *http,
 					   int rc ) {
 
-	/* Fail if any error occurred */
-	if ( rc != 0 )
-		goto err;
-
 	/* Fail if we have a content length (since we would have
 	 * already closed the connection if we had received the
 	 * correct content length).
 	 */
-	if ( http->response.flags & HTTP_RESPONSE_CONTENT_LEN ) {
+	if ( ( rc == 0 ) &&
+	     ( http->response.flags & HTTP_RESPONSE_CONTENT_LEN ) ) {
 		DBGC ( http, "HTTP %p content length underrun\n", http );
 		rc = EIO_CONTENT_LENGTH;
-		goto err;
+	}
+
+	/* On error, attempt to resume the download from the current
+	 * position rather than failing the transaction.
+	 */
+	if ( rc != 0 ) {
+		if ( ( rc = http_resume ( http, rc ) ) != 0 )
+			goto err;
+		return;
 	}
 
 	/* Indicate that transfer is complete */
@@ -1716,9 +1900,9 @@ static int http_rx_chunk_len ( struct http_transaction *http,
 	empty_line_buffer ( &http->linebuf );
 
 	/* Update expected length */
-	len = ( http->len + http->remaining );
+	len = ( http->offset + http->len + http->remaining );
 	xfer_seek ( &http->transfer, len );
-	xfer_seek ( &http->transfer, http->len );
+	xfer_seek ( &http->transfer, ( http->offset + http->len ) );
 
 	/* If chunk length is zero, then move to response trailers state */
 	if ( ! http->remaining )
@@ -1974,6 +2158,10 @@ int http_open_uri ( struct interface *xfer, struct uri *uri ) {
 		method = &http_get;
 		type = NULL;
 		data = NULL;
+
+		/* Use the striped download engine, if enabled */
+		if ( ( rc = http_mux_open ( xfer, uri ) ) != -ENOTSUP )
+			return rc;
 	}
 
 	/* Construct request content */
@@ -1991,6 +2179,18 @@ int http_open_uri ( struct interface *xfer, struct uri *uri ) {
 	return rc;
 }
 
+/**
+ * Open striped HTTP download (when striping support is not present)
+ *
+ * @v xfer		Data transfer interface
+ * @v uri		Request URI
+ * @ret rc		Return status code
+ */
+__weak int http_mux_open ( struct interface *xfer __unused,
+			   struct uri *uri __unused ) {
+	return -ENOTSUP;
+}
+
 /* Drag in HTTP extensions */
 REQUIRING_SYMBOL ( http_open );
 REQUIRE_OBJECT ( config_http );
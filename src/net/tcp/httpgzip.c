@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * Hyper Text Transfer Protocol (HTTP) gzip content encoding
+ *
+ * Compressed data is decompressed as it arrives, rather than after
+ * the download completes, so that decompression overlaps with
+ * network transfer time.
+ *
+ * The DEFLATE decompressor requires its output to be contiguous,
+ * since duplicated strings are copied from up to 32kB earlier in the
+ * output stream.  We therefore decompress into a 64kB buffer, slide
+ * the most recent 32kB window back to the start of the buffer as
+ * needed, and deliver the decompressed data onwards as it is
+ * produced.  The decompressor cannot pause on output exhaustion, so
+ * input is fed in slices small enough that even maximally-expanding
+ * input cannot overrun the buffer.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <byteswap.h>
+#include <ipxe/iobuf.h>
+#include <ipxe/xfer.h>
+#include <ipxe/deflate.h>
+#include <ipxe/gzip.h>
+#include <ipxe/http.h>
+
+/** DEFLATE sliding window length */
+#define HTTP_GZIP_WINDOW 32768
+
+/** Decompression buffer length */
+#define HTTP_GZIP_BUFLEN ( 2 * HTTP_GZIP_WINDOW )
+
+/** Maximum length of compressed input fed to a single inflate call
+ *
+ * A single compressed input byte can expand to at most around 2kB of
+ * output (eight one-bit length symbols, each representing up to 258
+ * duplicated bytes).  Limiting the input slice guarantees that one
+ * call can never produce more output than the buffer space remaining
+ * beyond the preserved window.
+ */
+#define HTTP_GZIP_SLICE 8
+
+#define EINVAL_HEADER __einfo_error ( EINFO_EINVAL_HEADER )
+#define EINFO_EINVAL_HEADER						\
+	__einfo_uniqify ( EINFO_EINVAL, 0x01, "Invalid gzip header" )
+#define ENOTSUP_METHOD __einfo_error ( EINFO_ENOTSUP_METHOD )
+#define EINFO_ENOTSUP_METHOD						\
+	__einfo_uniqify ( EINFO_ENOTSUP, 0x01,				\
+			  "Unsupported compression method" )
+#define EIO_TRUNCATED __einfo_error ( EINFO_EIO_TRUNCATED )
+#define EINFO_EIO_TRUNCATED						\
+	__einfo_uniqify ( EINFO_EIO, 0x01,				\
+			  "Truncated compressed stream" )
+
+/** A gzip decompression state */
+enum http_gzip_state {
+	/** Fixed gzip header */
+	HTTP_GZIP_HEADER = 0,
+	/** Extra header length */
+	HTTP_GZIP_EXTRA_LEN,
+	/** Skippable header bytes (extra header or header CRC) */
+	HTTP_GZIP_SKIP,
+	/** NUL-terminated header string (name or comment) */
+	HTTP_GZIP_STRING,
+	/** Compressed data */
+	HTTP_GZIP_DATA,
+	/** Stream footer */
+	HTTP_GZIP_FOOTER,
+};
+
+/** A gzip content decoder */
+struct http_gzip {
+	/** Reference count */
+	struct refcnt refcnt;
+	/** Decompressed data interface */
+	struct interface xfer;
+	/** Compressed data interface */
+	struct interface raw;
+
+	/** Current state */
+	enum http_gzip_state state;
+	/** Header buffer */
+	uint8_t buf[ sizeof ( struct gzip_header ) ];
+	/** Length of header buffer */
+	size_t buf_len;
+	/** Remaining header flags */
+	uint8_t flags;
+	/** Remaining skippable header length */
+	size_t skip;
+
+	/** Decompressor */
+	struct deflate deflate;
+	/** Current offset within decompression buffer */
+	size_t offset;
+	/** Decompression buffer */
+	uint8_t window[0];
+};
+
+/**
+ * Close gzip content decoder
+ *
+ * @v gzip		gzip content decoder
+ * @v rc		Reason for close
+ */
+static void http_gzip_close ( struct http_gzip *gzip, int rc ) {
+
+	/* Shut down interfaces */
+	intf_shutdown ( &gzip->xfer, rc );
+	intf_shutdown ( &gzip->raw, rc );
+}
+
+/**
+ * Move to next gzip header element
+ *
+ * @v gzip		gzip content decoder
+ */
+static void http_gzip_next ( struct http_gzip *gzip ) {
+
+	/* Process header elements in order of appearance */
+	if ( gzip->flags & GZIP_FL_EXTRA ) {
+		gzip->flags &= ~GZIP_FL_EXTRA;
+		gzip->state = HTTP_GZIP_EXTRA_LEN;
+		return;
+	}
+	if ( gzip->flags & GZIP_FL_NAME ) {
+		gzip->flags &= ~GZIP_FL_NAME;
+		gzip->state = HTTP_GZIP_STRING;
+		return;
+	}
+	if ( gzip->flags & GZIP_FL_COMMENT ) {
+		gzip->flags &= ~GZIP_FL_COMMENT;
+		gzip->state = HTTP_GZIP_STRING;
+		return;
+	}
+	if ( gzip->flags & GZIP_FL_HCRC ) {
+		gzip->flags &= ~GZIP_FL_HCRC;
+		gzip->skip = sizeof ( struct gzip_crc_header );
+		gzip->state = HTTP_GZIP_SKIP;
+		return;
+	}
+
+	/* Header is complete: start decompression */
+	deflate_init ( &gzip->deflate, DEFLATE_RAW );
+	gzip->state = HTTP_GZIP_DATA;
+}
+
+/**
+ * Decompress a slice of compressed data
+ *
+ * @v gzip		gzip content decoder
+ * @v iobuf		I/O buffer
+ * @ret rc		Return status code
+ */
+static int http_gzip_inflate ( struct http_gzip *gzip,
+			       struct io_buffer *iobuf ) {
+	struct deflate_chunk out;
+	struct io_buffer *plain;
+	size_t frag_len;
+	size_t produced;
+	size_t consumed;
+	int rc;
+
+	/* Slide window back to start of buffer, if applicable */
+	if ( ( gzip->offset + ( HTTP_GZIP_SLICE * 8 * 258 ) ) >
+	     HTTP_GZIP_BUFLEN ) {
+		memmove ( gzip->window,
+			  ( gzip->window + gzip->offset - HTTP_GZIP_WINDOW ),
+			  HTTP_GZIP_WINDOW );
+		gzip->offset = HTTP_GZIP_WINDOW;
+	}
+
+	/* Decompress one slice of input */
+	frag_len = iob_len ( iobuf );
+	if ( frag_len > HTTP_GZIP_SLICE )
+		frag_len = HTTP_GZIP_SLICE;
+	deflate_chunk_init ( &out, gzip->window, gzip->offset,
+			     HTTP_GZIP_BUFLEN );
+	if ( ( rc = deflate_inflate ( &gzip->deflate, iobuf->data, frag_len,
+				      &out ) ) != 0 ) {
+		DBGC ( gzip, "GZIP %p could not decompress: %s\n",
+		       gzip, strerror ( rc ) );
+		return rc;
+	}
+	assert ( out.offset <= HTTP_GZIP_BUFLEN );
+
+	/* Consume input up to the point at which the decompressor
+	 * stopped (which will be the end of the slice unless the
+	 * compressed stream finished within the slice).
+	 */
+	consumed = ( gzip->deflate.in -
+		     ( ( const uint8_t * ) iobuf->data ) );
+	assert ( consumed <= frag_len );
+	iob_pull ( iobuf, consumed );
+
+	/* Deliver any newly produced data */
+	produced = ( out.offset - gzip->offset );
+	if ( produced ) {
+		plain = alloc_iob ( produced );
+		if ( ! plain )
+			return -ENOMEM;
+		memcpy ( iob_put ( plain, produced ),
+			 ( gzip->window + gzip->offset ), produced );
+		gzip->offset = out.offset;
+		if ( ( rc = xfer_deliver_iob ( &gzip->xfer,
+					       iob_disown ( plain ) ) ) != 0 )
+			return rc;
+	}
+
+	/* Move to footer state when decompression completes */
+	if ( deflate_finished ( &gzip->deflate ) )
+		gzip->state = HTTP_GZIP_FOOTER;
+
+	return 0;
+}
+
+/**
+ * Receive compressed data
+ *
+ * @v gzip		gzip content decoder
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ */
+static int http_gzip_deliver ( struct http_gzip *gzip,
+			       struct io_buffer *iobuf,
+			       struct xfer_metadata *meta __unused ) {
+	struct gzip_header *header;
+	struct gzip_extra_header *extra;
+	uint8_t *nul;
+	size_t target;
+	size_t frag_len;
+	int rc;
+
+	/* Process buffer contents according to current state */
+	while ( iob_len ( iobuf ) ) {
+
+		switch ( gzip->state ) {
+
+		case HTTP_GZIP_HEADER:
+		case HTTP_GZIP_EXTRA_LEN:
+
+			/* Accumulate fixed-length header element */
+			target = ( ( gzip->state == HTTP_GZIP_HEADER ) ?
+				   sizeof ( struct gzip_header ) :
+				   sizeof ( struct gzip_extra_header ) );
+			frag_len = ( target - gzip->buf_len );
+			if ( frag_len > iob_len ( iobuf ) )
+				frag_len = iob_len ( iobuf );
+			memcpy ( ( gzip->buf + gzip->buf_len ), iobuf->data,
+				 frag_len );
+			gzip->buf_len += frag_len;
+			iob_pull ( iobuf, frag_len );
+			if ( gzip->buf_len < target )
+				break;
+			gzip->buf_len = 0;
+
+			/* Parse completed header element */
+			if ( gzip->state == HTTP_GZIP_HEADER ) {
+				header = ( ( void * ) gzip->buf );
+				if ( header->magic !=
+				     cpu_to_be16 ( GZIP_MAGIC ) ) {
+					DBGC ( gzip, "GZIP %p invalid magic\n",
+					       gzip );
+					rc = -EINVAL_HEADER;
+					goto done;
+				}
+				if ( header->method != GZIP_METHOD_DEFLATE ) {
+					DBGC ( gzip, "GZIP %p unsupported "
+					       "method %#02x\n", gzip,
+					       header->method );
+					rc = -ENOTSUP_METHOD;
+					goto done;
+				}
+				gzip->flags = header->flags;
+				http_gzip_next ( gzip );
+			} else {
+				extra = ( ( void * ) gzip->buf );
+				gzip->skip = le16_to_cpu ( extra->len );
+				gzip->state = HTTP_GZIP_SKIP;
+			}
+			break;
+
+		case HTTP_GZIP_SKIP:
+
+			/* Skip uninteresting header bytes */
+			frag_len = gzip->skip;
+			if ( frag_len > iob_len ( iobuf ) )
+				frag_len = iob_len ( iobuf );
+			iob_pull ( iobuf, frag_len );
+			gzip->skip -= frag_len;
+			if ( ! gzip->skip )
+				http_gzip_next ( gzip );
+			break;
+
+		case HTTP_GZIP_STRING:
+
+			/* Skip NUL-terminated header string */
+			nul = memchr ( iobuf->data, 0, iob_len ( iobuf ) );
+			if ( nul ) {
+				iob_pull ( iobuf, ( nul + 1 -
+						    ( ( uint8_t * )
+						      iobuf->data ) ) );
+				http_gzip_next ( gzip );
+			} else {
+				iob_pull ( iobuf, iob_len ( iobuf ) );
+			}
+			break;
+
+		case HTTP_GZIP_DATA:
+
+			/* Decompress one slice of compressed data */
+			if ( ( rc = http_gzip_inflate ( gzip, iobuf ) ) != 0 )
+				goto done;
+			break;
+
+		case HTTP_GZIP_FOOTER:
+
+			/* Consume and discard the stream footer.  As
+			 * with gzip image extraction, the trailing
+			 * CRC is not verified.
+			 */
+			iob_pull ( iobuf, iob_len ( iobuf ) );
+			break;
+
+		default:
+			assert ( 0 );
+			rc = -EINVAL;
+			goto done;
+		}
+	}
+	rc = 0;
+
+ done:
+	free_iob ( iobuf );
+	return rc;
+}
+
+/**
+ * Report compressed data window
+ *
+ * @v gzip		gzip content decoder
+ * @ret len		Length of window
+ */
+static size_t http_gzip_raw_window ( struct http_gzip *gzip ) {
+
+	/* Use downstream flow control window */
+	return xfer_window ( &gzip->xfer );
+}
+
+/**
+ * Handle closure of compressed data stream
+ *
+ * @v gzip		gzip content decoder
+ * @v rc		Reason for close
+ */
+static void http_gzip_raw_close ( struct http_gzip *gzip, int rc ) {
+
+	/* Check that the compressed stream was complete */
+	if ( ( rc == 0 ) && ( gzip->state != HTTP_GZIP_FOOTER ) ) {
+		DBGC ( gzip, "GZIP %p truncated compressed stream\n", gzip );
+		rc = -EIO_TRUNCATED;
+	}
+
+	/* Close decoder */
+	http_gzip_close ( gzip, rc );
+}
+
+/**
+ * Handle deferred window change notification
+ *
+ * @v gzip		gzip content decoder
+ */
+static void http_gzip_window_changed ( struct http_gzip *gzip ) {
+
+	/* Propagate window change to compressed data stream */
+	xfer_window_changed ( &gzip->raw );
+}
+
+/** gzip decompressed data interface operations */
+static struct interface_operation http_gzip_xfer_operations[] = {
+	INTF_OP ( xfer_window_changed, struct http_gzip *,
+		  http_gzip_window_changed ),
+	INTF_OP ( intf_close, struct http_gzip *, http_gzip_close ),
+};
+
+/** gzip decompressed data interface descriptor */
+static struct interface_descriptor http_gzip_xfer_desc =
+	INTF_DESC ( struct http_gzip, xfer, http_gzip_xfer_operations );
+
+/** gzip compressed data interface operations */
+static struct interface_operation http_gzip_raw_operations[] = {
+	INTF_OP ( xfer_deliver, struct http_gzip *, http_gzip_deliver ),
+	INTF_OP ( xfer_window, struct http_gzip *, http_gzip_raw_window ),
+	INTF_OP ( intf_close, struct http_gzip *, http_gzip_raw_close ),
+};
+
+/** gzip compressed data interface descriptor */
+static struct interface_descriptor http_gzip_raw_desc =
+	INTF_DESC ( struct http_gzip, raw, http_gzip_raw_operations );
+
+/**
+ * Add gzip content-decoding filter
+ *
+ * @v xfer		Data transfer interface
+ * @v raw		Compressed data interface
+ * @ret rc		Return status code
+ */
+static int http_gzip_filter ( struct interface *xfer,
+			      struct interface *raw ) {
+	struct http_gzip *gzip;
+
+	/* Allocate and initialise structure */
+	gzip = zalloc ( sizeof ( *gzip ) + HTTP_GZIP_BUFLEN );
+	if ( ! gzip )
+		return -ENOMEM;
+	ref_init ( &gzip->refcnt, NULL );
+	intf_init ( &gzip->xfer, &http_gzip_xfer_desc, &gzip->refcnt );
+	intf_init ( &gzip->raw, &http_gzip_raw_desc, &gzip->refcnt );
+	gzip->state = HTTP_GZIP_HEADER;
+
+	/* Attach to parent interfaces, mortalise self, and return */
+	intf_plug_plug ( &gzip->xfer, xfer );
+	intf_plug_plug ( &gzip->raw, raw );
+	ref_put ( &gzip->refcnt );
+	return 0;
+}
+
+/**
+ * Initialise gzip content encoding
+ *
+ * @v http		HTTP transaction
+ * @ret rc		Return status code
+ */
+static int http_gzip_init ( struct http_transaction *http ) {
+
+	return http_gzip_filter ( &http->content, &http->transfer );
+}
+
+/** gzip HTTP content encoding */
+struct http_content_encoding gzip_encoding __http_content_encoding = {
+	.name = "gzip",
+	.init = http_gzip_init,
+};
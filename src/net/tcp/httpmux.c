@@ -0,0 +1,490 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * Hyper Text Transfer Protocol (HTTP) striped download multiplexer
+ *
+ * A single TCP connection often cannot fill a high bandwidth-delay
+ * product path.  The multiplexer splits a large download into
+ * fixed-size byte ranges and fetches several ranges concurrently
+ * (each over its own connection, reusing pooled connections where
+ * possible), delivering the results into the recipient's data
+ * transfer buffer at absolute offsets.
+ *
+ * The total length is determined via an initial HEAD request.  If
+ * the length cannot be determined, or if the server turns out to
+ * ignore range requests, the multiplexer falls back transparently to
+ * a single sequential download.
+ *
+ * Striping is enabled via the "httpstreams" setting, which specifies
+ * the number of concurrent connections to use.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <ipxe/uri.h>
+#include <ipxe/iobuf.h>
+#include <ipxe/xfer.h>
+#include <ipxe/job.h>
+#include <ipxe/settings.h>
+#include <ipxe/http.h>
+#include <ipxe/httpmux.h>
+
+/** Number of concurrent HTTP connections setting */
+const struct setting httpstreams_setting __setting ( SETTING_MISC,
+						     httpstreams ) = {
+	.name = "httpstreams",
+	.description = "HTTP concurrent streams",
+	.type = &setting_type_uint32,
+};
+
+static void httpmux_fallback ( struct http_multiplexer *httpmux );
+
+/**
+ * Free HTTP download multiplexer
+ *
+ * @v refcnt		Reference count
+ */
+static void httpmux_free ( struct refcnt *refcnt ) {
+	struct http_multiplexer *httpmux =
+		container_of ( refcnt, struct http_multiplexer, refcnt );
+
+	uri_put ( httpmux->uri );
+	free ( httpmux );
+}
+
+/**
+ * Close HTTP download multiplexer
+ *
+ * @v httpmux		HTTP download multiplexer
+ * @v rc		Reason for close
+ */
+static void httpmux_close ( struct http_multiplexer *httpmux, int rc ) {
+	unsigned int i;
+
+	/* Stop stripe initiation process */
+	process_del ( &httpmux->process );
+
+	/* Shut down all stripe downloads */
+	for ( i = 0 ; i < HTTPMUX_MAX_STRIPES ; i++ )
+		intf_shutdown ( &httpmux->stripe[i].xfer, rc );
+
+	/* Shut down all other interfaces */
+	intf_shutdown ( &httpmux->probe, rc );
+	intf_shutdown ( &httpmux->xfer, rc );
+}
+
+/**
+ * Report progress of HTTP download
+ *
+ * @v httpmux		HTTP download multiplexer
+ * @v progress		Progress report to fill in
+ * @ret ongoing_rc	Ongoing job status code (if known)
+ */
+static int httpmux_progress ( struct http_multiplexer *httpmux,
+			      struct job_progress *progress ) {
+	struct http_multiplexed_stripe *stripe;
+	unsigned int count = 0;
+
+	/* Construct status message */
+	list_for_each_entry ( stripe, &httpmux->busy, list )
+		count++;
+	snprintf ( progress->message, sizeof ( progress->message ),
+		   "%d stream%s", count, ( ( count == 1 ) ? "" : "s" ) );
+
+	return 0;
+}
+
+/**
+ * Initiate next stripe download
+ *
+ * @v httpmux		HTTP download multiplexer
+ */
+static void httpmux_step ( struct http_multiplexer *httpmux ) {
+	struct http_multiplexed_stripe *stripe;
+	struct http_request_range range;
+	size_t len;
+	int rc;
+
+	/* Stop initiation process if all stripe downloads are busy */
+	stripe = list_first_entry ( &httpmux->idle,
+				    struct http_multiplexed_stripe, list );
+	if ( ! stripe ) {
+		process_del ( &httpmux->process );
+		return;
+	}
+
+	/* If all ranges have been assigned and all downloads have
+	 * completed, then we are finished.
+	 */
+	if ( httpmux->next >= httpmux->total ) {
+		process_del ( &httpmux->process );
+		if ( list_empty ( &httpmux->busy ) )
+			httpmux_close ( httpmux, 0 );
+		return;
+	}
+
+	/* Assign next range */
+	len = ( httpmux->total - httpmux->next );
+	if ( len > HTTPMUX_BLKSIZE )
+		len = HTTPMUX_BLKSIZE;
+	range.start = httpmux->next;
+	range.len = len;
+
+	/* Start downloading this range */
+	if ( ( rc = http_open ( &stripe->xfer, &http_get, httpmux->uri,
+				&range, NULL ) ) != 0 ) {
+		DBGC ( httpmux, "HTTPMUX %p could not start range [%zx,%zx): "
+		       "%s\n", httpmux, httpmux->next,
+		       ( httpmux->next + len ), strerror ( rc ) );
+		httpmux_close ( httpmux, rc );
+		return;
+	}
+	stripe->start = httpmux->next;
+	stripe->len = len;
+	stripe->pos = 0;
+	httpmux->next += len;
+
+	/* Move to list of busy stripe downloads */
+	list_del ( &stripe->list );
+	list_add_tail ( &stripe->list, &httpmux->busy );
+}
+
+/**
+ * Receive data from stripe download
+ *
+ * @v stripe		Stripe download
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ */
+static int httpmux_stripe_deliver ( struct http_multiplexed_stripe *stripe,
+				    struct io_buffer *iobuf,
+				    struct xfer_metadata *meta ) {
+	struct http_multiplexer *httpmux = stripe->httpmux;
+	struct xfer_metadata stripe_meta;
+	size_t len = iob_len ( iobuf );
+	size_t pos;
+	int rc;
+
+	/* Calculate position within this stripe's range */
+	pos = stripe->pos;
+	if ( meta->flags & XFER_FL_ABS_OFFSET )
+		pos = 0;
+	pos += meta->offset;
+
+	/* If the response overruns the requested range, then the
+	 * server has ignored the range request (e.g. because it does
+	 * not support range requests): fall back to a single
+	 * sequential download.  The presizing seek that precedes any
+	 * data delivery reveals an overlength response before any
+	 * data can be misplaced.
+	 */
+	if ( stripe->len && ( ( pos + len ) > stripe->len ) ) {
+		DBGC ( httpmux, "HTTPMUX %p range [%zx,%zx) overrun to %zx: "
+		       "falling back to single stream\n", httpmux,
+		       stripe->start, ( stripe->start + stripe->len ),
+		       ( stripe->start + pos + len ) );
+		free_iob ( iobuf );
+		httpmux_fallback ( httpmux );
+		return 0;
+	}
+	stripe->pos = pos;
+
+	/* Ignore zero-length deliveries (e.g. presizing seeks) */
+	if ( ! len ) {
+		free_iob ( iobuf );
+		return 0;
+	}
+
+	/* Deliver to parent at an absolute offset, since stripe
+	 * downloads run concurrently.  We can't use a simple
+	 * passthrough interface descriptor, since there are multiple
+	 * stripe download interfaces.
+	 */
+	memcpy ( &stripe_meta, meta, sizeof ( stripe_meta ) );
+	stripe_meta.flags = ( meta->flags | XFER_FL_ABS_OFFSET );
+	stripe_meta.offset = ( stripe->start + pos );
+	stripe->pos += len;
+	if ( ( rc = xfer_deliver ( &httpmux->xfer, iob_disown ( iobuf ),
+				   &stripe_meta ) ) != 0 ) {
+		httpmux_close ( httpmux, rc );
+		return rc;
+	}
+
+	return 0;
+}
+
+/**
+ * Close stripe download
+ *
+ * @v stripe		Stripe download
+ * @v rc		Reason for close
+ */
+static void httpmux_stripe_close ( struct http_multiplexed_stripe *stripe,
+				   int rc ) {
+	struct http_multiplexer *httpmux = stripe->httpmux;
+
+	/* Move to list of idle stripe downloads */
+	list_del ( &stripe->list );
+	list_add_tail ( &stripe->list, &httpmux->idle );
+
+	/* If any error occurred, terminate the whole download */
+	if ( rc != 0 ) {
+		httpmux_close ( httpmux, rc );
+		return;
+	}
+
+	/* Restart data transfer interface */
+	intf_restart ( &stripe->xfer, rc );
+
+	/* Restart stripe initiation process */
+	process_add ( &httpmux->process );
+}
+
+/**
+ * Receive length probe data
+ *
+ * @v httpmux		HTTP download multiplexer
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ */
+static int httpmux_probe_deliver ( struct http_multiplexer *httpmux,
+				   struct io_buffer *iobuf,
+				   struct xfer_metadata *meta ) {
+	size_t pos;
+
+	/* Track the maximum position seen: the HEAD response carries
+	 * no data, but its presizing seek reveals the total length.
+	 */
+	pos = httpmux->probe_pos;
+	if ( meta->flags & XFER_FL_ABS_OFFSET )
+		pos = 0;
+	pos += meta->offset;
+	pos += iob_len ( iobuf );
+	httpmux->probe_pos = pos;
+	if ( pos > httpmux->total )
+		httpmux->total = pos;
+
+	free_iob ( iobuf );
+	return 0;
+}
+
+/**
+ * Close length probe
+ *
+ * @v httpmux		HTTP download multiplexer
+ * @v rc		Reason for close
+ */
+static void httpmux_probe_close ( struct http_multiplexer *httpmux, int rc ) {
+
+	/* Shut down probe interface */
+	intf_shutdown ( &httpmux->probe, rc );
+
+	/* Fall back to a single sequential download if the total
+	 * length could not be determined (e.g. because the server
+	 * does not support HEAD requests).
+	 */
+	if ( ( rc != 0 ) || ( httpmux->total == 0 ) ) {
+		DBGC ( httpmux, "HTTPMUX %p could not probe length: %s\n",
+		       httpmux, strerror ( rc ) );
+		httpmux_fallback ( httpmux );
+		return;
+	}
+
+	DBGC ( httpmux, "HTTPMUX %p striping %zd bytes across %d streams\n",
+	       httpmux, httpmux->total, httpmux->streams );
+
+	/* Notify recipient of total download size */
+	if ( ( rc = xfer_seek ( &httpmux->xfer, httpmux->total ) ) != 0 ) {
+		DBGC ( httpmux, "HTTPMUX %p could not presize buffer: %s\n",
+		       httpmux, strerror ( rc ) );
+		httpmux_close ( httpmux, rc );
+		return;
+	}
+	xfer_seek ( &httpmux->xfer, 0 );
+
+	/* Start stripe initiation process */
+	process_add ( &httpmux->process );
+}
+
+/**
+ * Fall back to a single sequential download
+ *
+ * @v httpmux		HTTP download multiplexer
+ */
+static void httpmux_fallback ( struct http_multiplexer *httpmux ) {
+	struct http_multiplexed_stripe *stripe;
+	unsigned int i;
+	int rc;
+
+	DBGC ( httpmux, "HTTPMUX %p using single sequential download\n",
+	       httpmux );
+
+	/* Stop stripe initiation process */
+	process_del ( &httpmux->process );
+
+	/* Restart all stripe downloads, and return them to the idle
+	 * list.  Any ranges already correctly delivered will simply
+	 * be redelivered with identical content.
+	 */
+	for ( i = 0 ; i < HTTPMUX_MAX_STRIPES ; i++ ) {
+		stripe = &httpmux->stripe[i];
+		intf_restart ( &stripe->xfer, -ECANCELED );
+		list_del ( &stripe->list );
+		list_add_tail ( &stripe->list, &httpmux->idle );
+	}
+
+	/* Mark all ranges as assigned */
+	httpmux->next = httpmux->total;
+
+	/* Start a single unbounded download */
+	stripe = &httpmux->stripe[0];
+	stripe->start = 0;
+	stripe->len = 0;
+	stripe->pos = 0;
+	if ( ( rc = http_open ( &stripe->xfer, &http_get, httpmux->uri,
+				NULL, NULL ) ) != 0 ) {
+		httpmux_close ( httpmux, rc );
+		return;
+	}
+
+	/* Move to list of busy stripe downloads */
+	list_del ( &stripe->list );
+	list_add_tail ( &stripe->list, &httpmux->busy );
+}
+
+/** Data transfer interface operations */
+static struct interface_operation httpmux_xfer_operations[] = {
+	INTF_OP ( job_progress, struct http_multiplexer *, httpmux_progress ),
+	INTF_OP ( intf_close, struct http_multiplexer *, httpmux_close ),
+};
+
+/** Data transfer interface descriptor */
+static struct interface_descriptor httpmux_xfer_desc =
+	INTF_DESC ( struct http_multiplexer, xfer, httpmux_xfer_operations );
+
+/** Length probe interface operations */
+static struct interface_operation httpmux_probe_operations[] = {
+	INTF_OP ( xfer_deliver, struct http_multiplexer *,
+		  httpmux_probe_deliver ),
+	INTF_OP ( intf_close, struct http_multiplexer *,
+		  httpmux_probe_close ),
+};
+
+/** Length probe interface descriptor */
+static struct interface_descriptor httpmux_probe_desc =
+	INTF_DESC ( struct http_multiplexer, probe, httpmux_probe_operations );
+
+/** Stripe download data transfer interface operations */
+static struct interface_operation httpmux_stripe_operations[] = {
+	INTF_OP ( xfer_deliver, struct http_multiplexed_stripe *,
+		  httpmux_stripe_deliver ),
+	INTF_OP ( intf_close, struct http_multiplexed_stripe *,
+		  httpmux_stripe_close ),
+};
+
+/** Stripe download data transfer interface descriptor */
+static struct interface_descriptor httpmux_stripe_desc =
+	INTF_DESC ( struct http_multiplexed_stripe, xfer,
+		    httpmux_stripe_operations );
+
+/** Stripe initiation process descriptor */
+static struct process_descriptor httpmux_process_desc =
+	PROC_DESC ( struct http_multiplexer, process, httpmux_step );
+
+/**
+ * Open striped HTTP download
+ *
+ * @v xfer		Data transfer interface
+ * @v uri		Request URI
+ * @ret rc		Return status code
+ *
+ * Returns -ENOTSUP if striping is not enabled, in which case the
+ * caller should fall back to a plain HTTP transaction.
+ */
+int http_mux_open ( struct interface *xfer, struct uri *uri ) {
+	struct http_multiplexer *httpmux;
+	struct http_multiplexed_stripe *stripe;
+	unsigned long streams;
+	unsigned int i;
+	int rc;
+
+	/* Do nothing unless multiple streams are configured */
+	if ( fetch_uint_setting ( NULL, &httpstreams_setting,
+				  &streams ) < 0 ) {
+		return -ENOTSUP;
+	}
+	if ( streams < 2 )
+		return -ENOTSUP;
+	if ( streams > HTTPMUX_MAX_STRIPES )
+		streams = HTTPMUX_MAX_STRIPES;
+
+	/* Allocate and initialise structure */
+	httpmux = zalloc ( sizeof ( *httpmux ) );
+	if ( ! httpmux )
+		return -ENOMEM;
+	ref_init ( &httpmux->refcnt, httpmux_free );
+	intf_init ( &httpmux->xfer, &httpmux_xfer_desc, &httpmux->refcnt );
+	intf_init ( &httpmux->probe, &httpmux_probe_desc, &httpmux->refcnt );
+	httpmux->uri = uri_get ( uri );
+	httpmux->streams = streams;
+	process_init_stopped ( &httpmux->process, &httpmux_process_desc,
+			       &httpmux->refcnt );
+	INIT_LIST_HEAD ( &httpmux->busy );
+	INIT_LIST_HEAD ( &httpmux->idle );
+	for ( i = 0 ; i < HTTPMUX_MAX_STRIPES ; i++ ) {
+		stripe = &httpmux->stripe[i];
+		stripe->httpmux = httpmux;
+		intf_init ( &stripe->xfer, &httpmux_stripe_desc,
+			    &httpmux->refcnt );
+		if ( i < streams )
+			list_add_tail ( &stripe->list, &httpmux->idle );
+		else
+			INIT_LIST_HEAD ( &stripe->list );
+	}
+
+	/* Probe total length via a HEAD request */
+	if ( ( rc = http_open ( &httpmux->probe, &http_head, uri, NULL,
+				NULL ) ) != 0 ) {
+		DBGC ( httpmux, "HTTPMUX %p could not start probe: %s\n",
+		       httpmux, strerror ( rc ) );
+		goto err_probe;
+	}
+
+	/* Attach to parent interface, mortalise self, and return */
+	intf_plug_plug ( &httpmux->xfer, xfer );
+	ref_put ( &httpmux->refcnt );
+	return 0;
+
+ err_probe:
+	httpmux_close ( httpmux, rc );
+	ref_put ( &httpmux->refcnt );
+	return rc;
+}
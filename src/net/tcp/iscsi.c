@@ -44,6 +44,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/features.h>
 #include <ipxe/base16.h>
 #include <ipxe/base64.h>
+#include <ipxe/crc32.h>
 #include <ipxe/ibft.h>
 #include <ipxe/blockdev.h>
 #include <ipxe/efi/efi_path.h>
@@ -90,6 +91,14 @@ FEATURE ( FEATURE_PROTOCOL, "iSCSI", DHCP_EB_FEATURE_ISCSI, 1 );
 	__einfo_error ( EINFO_EINVAL_MAXBURSTLENGTH )
 #define EINFO_EINVAL_MAXBURSTLENGTH \
 	__einfo_uniqify ( EINFO_EINVAL, 0x06, "Invalid MaxBurstLength" )
+#define EINVAL_HEADER_DIGEST \
+	__einfo_error ( EINFO_EINVAL_HEADER_DIGEST )
+#define EINFO_EINVAL_HEADER_DIGEST \
+	__einfo_uniqify ( EINFO_EINVAL, 0x07, "Invalid HeaderDigest" )
+#define EINVAL_DATA_DIGEST \
+	__einfo_error ( EINFO_EINVAL_DATA_DIGEST )
+#define EINFO_EINVAL_DATA_DIGEST \
+	__einfo_uniqify ( EINFO_EINVAL, 0x08, "Invalid DataDigest" )
 #define EIO_TARGET_UNAVAILABLE \
 	__einfo_error ( EINFO_EIO_TARGET_UNAVAILABLE )
 #define EINFO_EIO_TARGET_UNAVAILABLE \
@@ -146,6 +155,14 @@ FEATURE ( FEATURE_PROTOCOL, "iSCSI", DHCP_EB_FEATURE_ISCSI, 1 );
 	__einfo_error ( EINFO_EPROTO_VALUE_REJECTED )
 #define EINFO_EPROTO_VALUE_REJECTED					\
 	__einfo_uniqify ( EINFO_EPROTO, 0x06, "Parameter rejected" )
+#define EPROTO_INVALID_HEADER_DIGEST \
+	__einfo_error ( EINFO_EPROTO_INVALID_HEADER_DIGEST )
+#define EINFO_EPROTO_INVALID_HEADER_DIGEST \
+	__einfo_uniqify ( EINFO_EPROTO, 0x07, "Invalid header digest" )
+#define EPROTO_INVALID_DATA_DIGEST \
+	__einfo_error ( EINFO_EPROTO_INVALID_DATA_DIGEST )
+#define EINFO_EPROTO_INVALID_DATA_DIGEST \
+	__einfo_uniqify ( EINFO_EPROTO, 0x08, "Invalid data digest" )
 
 static void iscsi_start_tx ( struct iscsi_session *iscsi );
 static void iscsi_start_login ( struct iscsi_session *iscsi );
@@ -311,6 +328,10 @@ static void iscsi_close_connection ( struct iscsi_session *iscsi, int rc ) {
 	/* Clear connection status */
 	iscsi->status = 0;
 
+	/* Clear negotiated digests */
+	iscsi->header_digest = 0;
+	iscsi->data_digest = 0;
+
 	/* Reset TX and RX state machines */
 	iscsi->tx_state = ISCSI_TX_IDLE;
 	iscsi->rx_state = ISCSI_RX_BHS;
@@ -650,13 +671,13 @@ static int iscsi_rx_nop_in ( struct iscsi_session *iscsi,
  * These are the initial set of strings sent in the first login
  * request PDU.  We want the following settings:
  *
- *     HeaderDigest=None
- *     DataDigest=None
+ *     HeaderDigest=CRC32C,None [7]
+ *     DataDigest=CRC32C,None [7]
  *     MaxConnections=1 (irrelevant; we make only one connection anyway) [4]
  *     InitialR2T=Yes [1]
  *     ImmediateData=No (irrelevant; we never send immediate data) [4]
  *     MaxRecvDataSegmentLength=8192 (default; we don't care) [3]
- *     MaxBurstLength=262144 (default; we don't care) [3]
+ *     MaxBurstLength=16777215 [6]
  *     FirstBurstLength=65536 (irrelevant due to other settings) [5]
  *     DefaultTime2Wait=0 [2]
  *     DefaultTime2Retain=0 [2]
@@ -687,6 +708,22 @@ static int iscsi_rx_nop_in ( struct iscsi_session *iscsi,
  * force InitialR2T=Yes and ImmediateData=No, but some targets
  * (notably LIO as of kernel 4.11) fail unless it is specified, so we
  * explicitly specify the default value.
+ *
+ * [6] We offer the largest value representable in the MaxBurstLength
+ * field.  The SAN block layer issues commands synchronously, so each
+ * SCSI command costs at least one network round trip; since received
+ * data is placed directly into the command's data buffer, allowing
+ * each command to cover as much as possible of the block device
+ * request minimises the number of round trips at no memory cost.
+ * MaxBurstLength negotiates to the minimum of the two offered values,
+ * so the target remains free to select a smaller value.
+ *
+ * [7] We offer CRC32C digests in preference to None, since some
+ * targets route digest-less sessions onto a slower I/O path and
+ * CRC32C calculation is cheap for us (especially where a hardware
+ * CRC32 instruction is available).  List negotiation selects the
+ * first value offered by the originator that is also acceptable to
+ * the responder, so the target remains free to select None.
  */
 static int iscsi_build_login_request_strings ( struct iscsi_session *iscsi,
 					       void *data, size_t len ) {
@@ -738,8 +775,8 @@ static int iscsi_build_login_request_strings ( struct iscsi_session *iscsi,
 
 	if ( iscsi->status & ISCSI_STATUS_STRINGS_OPERATIONAL ) {
 		used += ssnprintf ( data + used, len - used,
-				    "HeaderDigest=None%c"
-				    "DataDigest=None%c"
+				    "HeaderDigest=CRC32C,None%c"
+				    "DataDigest=CRC32C,None%c"
 				    "MaxConnections=1%c"
 				    "InitialR2T=Yes%c"
 				    "ImmediateData=No%c"
@@ -944,6 +981,54 @@ static int iscsi_handle_maxburstlength_value ( struct iscsi_session *iscsi,
 	return 0;
 }
 
+/**
+ * Handle iSCSI HeaderDigest text value
+ *
+ * @v iscsi		iSCSI session
+ * @v value		HeaderDigest value
+ * @ret rc		Return status code
+ */
+static int iscsi_handle_headerdigest_value ( struct iscsi_session *iscsi,
+					     const char *value ) {
+
+	/* Record the digest scheme selected by the target */
+	if ( strcmp ( value, "CRC32C" ) == 0 ) {
+		iscsi->header_digest = 1;
+	} else if ( strcmp ( value, "None" ) == 0 ) {
+		iscsi->header_digest = 0;
+	} else {
+		DBGC ( iscsi, "iSCSI %p invalid HeaderDigest \"%s\"\n",
+		       iscsi, value );
+		return -EINVAL_HEADER_DIGEST;
+	}
+
+	return 0;
+}
+
+/**
+ * Handle iSCSI DataDigest text value
+ *
+ * @v iscsi		iSCSI session
+ * @v value		DataDigest value
+ * @ret rc		Return status code
+ */
+static int iscsi_handle_datadigest_value ( struct iscsi_session *iscsi,
+					   const char *value ) {
+
+	/* Record the digest scheme selected by the target */
+	if ( strcmp ( value, "CRC32C" ) == 0 ) {
+		iscsi->data_digest = 1;
+	} else if ( strcmp ( value, "None" ) == 0 ) {
+		iscsi->data_digest = 0;
+	} else {
+		DBGC ( iscsi, "iSCSI %p invalid DataDigest \"%s\"\n",
+		       iscsi, value );
+		return -EINVAL_DATA_DIGEST;
+	}
+
+	return 0;
+}
+
 /**
  * Handle iSCSI CHAP_A text value
  *
@@ -1185,6 +1270,8 @@ struct iscsi_string_type {
 static struct iscsi_string_type iscsi_string_types[] = {
 	{ "TargetAddress", iscsi_handle_targetaddress_value },
 	{ "MaxBurstLength", iscsi_handle_maxburstlength_value },
+	{ "HeaderDigest", iscsi_handle_headerdigest_value },
+	{ "DataDigest", iscsi_handle_datadigest_value },
 	{ "AuthMethod", iscsi_handle_authmethod_value },
 	{ "CHAP_A", iscsi_handle_chap_a_value },
 	{ "CHAP_I", iscsi_handle_chap_i_value },
@@ -1409,6 +1496,33 @@ static int iscsi_rx_login_response ( struct iscsi_session *iscsi,
  *
  */
 
+/** Seed value for iSCSI CRC32C digest calculations */
+#define ISCSI_DIGEST_SEED 0xffffffffUL
+
+/**
+ * Check whether or not PDU digests are in effect
+ *
+ * @v iscsi		iSCSI session
+ * @ret in_effect	Digests are in effect
+ *
+ * Digests are negotiated during login but apply only to full feature
+ * phase PDUs; login PDUs themselves are never digested.
+ */
+static int iscsi_digests ( struct iscsi_session *iscsi ) {
+	return ( ( iscsi->status & ISCSI_STATUS_PHASE_MASK ) ==
+		 ISCSI_STATUS_FULL_FEATURE_PHASE );
+}
+
+/**
+ * Calculate wire representation of an iSCSI CRC32C digest
+ *
+ * @v crc		Running CRC32C value
+ * @ret digest		Digest value (in wire byte order)
+ */
+static uint32_t iscsi_digest ( uint32_t crc ) {
+	return cpu_to_le32 ( ~crc );
+}
+
 /**
  * Pause TX engine
  *
@@ -1470,6 +1584,96 @@ static int iscsi_tx_bhs ( struct iscsi_session *iscsi ) {
 				  sizeof ( iscsi->tx_bhs ) );
 }
 
+/**
+ * Calculate transmit length of the header digest
+ *
+ * @v iscsi		iSCSI session
+ * @ret len		Length of header digest to be transmitted
+ */
+static size_t iscsi_tx_header_digest_len ( struct iscsi_session *iscsi ) {
+	return ( ( iscsi->header_digest && iscsi_digests ( iscsi ) ) ?
+		 sizeof ( uint32_t ) : 0 );
+}
+
+/**
+ * Calculate transmit length of the data digest
+ *
+ * @v iscsi		iSCSI session
+ * @ret len		Length of data digest to be transmitted
+ */
+static size_t iscsi_tx_data_digest_len ( struct iscsi_session *iscsi ) {
+	struct iscsi_bhs_common *common = &iscsi->tx_bhs.common;
+
+	return ( ( iscsi->data_digest && iscsi_digests ( iscsi ) &&
+		   ISCSI_DATA_LEN ( common->lengths ) ) ?
+		 sizeof ( uint32_t ) : 0 );
+}
+
+/**
+ * Transmit header digest of an iSCSI PDU
+ *
+ * @v iscsi		iSCSI session
+ * @ret rc		Return status code
+ */
+static int iscsi_tx_header_digest ( struct iscsi_session *iscsi ) {
+	uint32_t digest;
+
+	/* Do nothing unless header digests are in effect */
+	if ( ! iscsi_tx_header_digest_len ( iscsi ) )
+		return 0;
+
+	/* Calculate and transmit digest of the basic header segment
+	 * (we never send an additional header segment).
+	 */
+	digest = iscsi_digest ( crc32c_le ( ISCSI_DIGEST_SEED,
+					    &iscsi->tx_bhs,
+					    sizeof ( iscsi->tx_bhs ) ) );
+	return xfer_deliver_raw ( &iscsi->socket, &digest,
+				  sizeof ( digest ) );
+}
+
+/**
+ * Transmit data digest of an iSCSI PDU
+ *
+ * @v iscsi		iSCSI session
+ * @ret rc		Return status code
+ */
+static int iscsi_tx_data_digest ( struct iscsi_session *iscsi ) {
+	struct iscsi_bhs_data_out *data_out = &iscsi->tx_bhs.data_out;
+	static const uint8_t pad[3];
+	unsigned long offset;
+	size_t len;
+	size_t pad_len;
+	uint32_t crc;
+	uint32_t digest;
+
+	/* Do nothing unless data digests are in effect and the PDU
+	 * carries a data segment.
+	 */
+	if ( ! iscsi_tx_data_digest_len ( iscsi ) )
+		return 0;
+
+	/* Data-out PDUs are the only PDUs with a data segment that we
+	 * ever transmit within the full feature phase.
+	 */
+	assert ( ( data_out->opcode & ISCSI_OPCODE_MASK ) ==
+		 ISCSI_OPCODE_DATA_OUT );
+	offset = ntohl ( data_out->offset );
+	len = ISCSI_DATA_LEN ( data_out->lengths );
+	pad_len = ISCSI_DATA_PAD_LEN ( data_out->lengths );
+	assert ( ( offset + len ) <= iscsi->command->data_out_len );
+
+	/* Calculate and transmit digest of the data segment and its
+	 * padding.
+	 */
+	crc = crc32c_le ( ISCSI_DIGEST_SEED,
+			  ( iscsi->command->data_out + offset ), len );
+	crc = crc32c_le ( crc, pad, pad_len );
+	digest = iscsi_digest ( crc );
+	return xfer_deliver_raw ( &iscsi->socket, &digest,
+				  sizeof ( digest ) );
+}
+
 /**
  * Transmit data segment of an iSCSI PDU
  *
@@ -1548,11 +1752,21 @@ static void iscsi_tx_step ( struct iscsi_session *iscsi ) {
 		case ISCSI_TX_AHS:
 			tx = iscsi_tx_nothing;
 			tx_len = 0;
+			next_state = ISCSI_TX_HEADER_DIGEST;
+			break;
+		case ISCSI_TX_HEADER_DIGEST:
+			tx = iscsi_tx_header_digest;
+			tx_len = iscsi_tx_header_digest_len ( iscsi );
 			next_state = ISCSI_TX_DATA;
 			break;
 		case ISCSI_TX_DATA:
 			tx = iscsi_tx_data;
 			tx_len = ISCSI_DATA_LEN ( common->lengths );
+			next_state = ISCSI_TX_DATA_DIGEST;
+			break;
+		case ISCSI_TX_DATA_DIGEST:
+			tx = iscsi_tx_data_digest;
+			tx_len = iscsi_tx_data_digest_len ( iscsi );
 			next_state = ISCSI_TX_IDLE;
 			break;
 		case ISCSI_TX_IDLE:
@@ -1638,6 +1852,73 @@ static int iscsi_rx_discard ( struct iscsi_session *iscsi __unused,
 	return 0;
 }
 
+/**
+ * Receive digest of an iSCSI PDU
+ *
+ * @v iscsi		iSCSI session
+ * @v data		Received data
+ * @v len		Length of received data
+ * @v remaining		Data remaining after this data
+ * @ret rc		Return status code
+ *
+ * This collects and verifies either the header digest or the data
+ * digest, as indicated by the current receive state.
+ */
+static int iscsi_rx_digest ( struct iscsi_session *iscsi, const void *data,
+			     size_t len, size_t remaining ) {
+	int is_header = ( iscsi->rx_state == ISCSI_RX_HEADER_DIGEST );
+	uint32_t expected;
+
+	/* Do nothing if digests are not in effect for this PDU */
+	if ( iscsi->rx_len == 0 )
+		return 0;
+
+	/* Fill in received digest */
+	memcpy ( ( ( ( void * ) &iscsi->rx_digest_value ) +
+		   iscsi->rx_offset ), data, len );
+
+	/* Wait for whole digest to arrive */
+	if ( remaining )
+		return 0;
+
+	/* Verify digest */
+	expected = iscsi_digest ( iscsi->rx_digest );
+	if ( iscsi->rx_digest_value != expected ) {
+		DBGC ( iscsi, "iSCSI %p invalid %s digest %08x (expected "
+		       "%08x)\n", iscsi, ( is_header ? "header" : "data" ),
+		       le32_to_cpu ( iscsi->rx_digest_value ),
+		       le32_to_cpu ( expected ) );
+		return ( is_header ? -EPROTO_INVALID_HEADER_DIGEST :
+			 -EPROTO_INVALID_DATA_DIGEST );
+	}
+
+	return 0;
+}
+
+/**
+ * Check whether or not a digest covers the current receive state
+ *
+ * @v iscsi		iSCSI session
+ * @ret digested	Received data contributes to a digest
+ */
+static int iscsi_rx_digested ( struct iscsi_session *iscsi ) {
+
+	/* Do nothing unless digests are in effect for this PDU */
+	if ( ! iscsi->rx_digests )
+		return 0;
+
+	switch ( iscsi->rx_state ) {
+	case ISCSI_RX_BHS:
+	case ISCSI_RX_AHS:
+		return iscsi->header_digest;
+	case ISCSI_RX_DATA:
+	case ISCSI_RX_DATA_PADDING:
+		return iscsi->data_digest;
+	default:
+		return 0;
+	}
+}
+
 /**
  * Receive data segment of an iSCSI PDU
  *
@@ -1710,21 +1991,44 @@ static int iscsi_socket_deliver ( struct iscsi_session *iscsi,
 		case ISCSI_RX_BHS:
 			rx = iscsi_rx_bhs;
 			iscsi->rx_len = sizeof ( iscsi->rx_bhs );
-			next_state = ISCSI_RX_AHS;			
+			if ( iscsi->rx_offset == 0 ) {
+				iscsi->rx_digests = iscsi_digests ( iscsi );
+				iscsi->rx_digest = ISCSI_DIGEST_SEED;
+			}
+			next_state = ISCSI_RX_AHS;
 			break;
 		case ISCSI_RX_AHS:
 			rx = iscsi_rx_discard;
 			iscsi->rx_len = 4 * ISCSI_AHS_LEN ( common->lengths );
+			next_state = ISCSI_RX_HEADER_DIGEST;
+			break;
+		case ISCSI_RX_HEADER_DIGEST:
+			rx = iscsi_rx_digest;
+			iscsi->rx_len =
+				( ( iscsi->rx_digests &&
+				    iscsi->header_digest ) ?
+				  sizeof ( iscsi->rx_digest_value ) : 0 );
 			next_state = ISCSI_RX_DATA;
 			break;
 		case ISCSI_RX_DATA:
 			rx = iscsi_rx_data;
 			iscsi->rx_len = ISCSI_DATA_LEN ( common->lengths );
+			if ( iscsi->rx_offset == 0 )
+				iscsi->rx_digest = ISCSI_DIGEST_SEED;
 			next_state = ISCSI_RX_DATA_PADDING;
 			break;
 		case ISCSI_RX_DATA_PADDING:
 			rx = iscsi_rx_discard;
 			iscsi->rx_len = ISCSI_DATA_PAD_LEN ( common->lengths );
+			next_state = ISCSI_RX_DATA_DIGEST;
+			break;
+		case ISCSI_RX_DATA_DIGEST:
+			rx = iscsi_rx_digest;
+			iscsi->rx_len =
+				( ( iscsi->rx_digests &&
+				    iscsi->data_digest &&
+				    ISCSI_DATA_LEN ( common->lengths ) ) ?
+				  sizeof ( iscsi->rx_digest_value ) : 0 );
 			next_state = ISCSI_RX_BHS;
 			break;
 		default:
@@ -1737,6 +2041,13 @@ static int iscsi_socket_deliver ( struct iscsi_session *iscsi,
 		if ( frag_len > iob_len ( iobuf ) )
 			frag_len = iob_len ( iobuf );
 		remaining = iscsi->rx_len - iscsi->rx_offset - frag_len;
+
+		/* Update the digest covering this portion, if any */
+		if ( iscsi_rx_digested ( iscsi ) ) {
+			iscsi->rx_digest = crc32c_le ( iscsi->rx_digest,
+						       iobuf->data, frag_len );
+		}
+
 		if ( ( rc = rx ( iscsi, iobuf->data, frag_len,
 				 remaining ) ) != 0 ) {
 			DBGC ( iscsi, "iSCSI %p could not process received "
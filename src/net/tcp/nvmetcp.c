@@ -0,0 +1,1182 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <byteswap.h>
+#include <ipxe/iobuf.h>
+#include <ipxe/xfer.h>
+#include <ipxe/open.h>
+#include <ipxe/uri.h>
+#include <ipxe/socket.h>
+#include <ipxe/tcpip.h>
+#include <ipxe/retry.h>
+#include <ipxe/timer.h>
+#include <ipxe/process.h>
+#include <ipxe/blockdev.h>
+#include <ipxe/nvme.h>
+#include <ipxe/nvmetcp.h>
+
+/** @file
+ *
+ * NVMe/TCP protocol
+ *
+ * The NVMe/TCP transport binding maps each NVMe queue pair onto its
+ * own TCP connection, with commands, completions, and data carried as
+ * a stream of PDUs.  We establish the admin queue connection, connect
+ * and enable the controller via the fabrics command set, identify the
+ * first namespace, and then establish a single I/O queue connection
+ * through which all block commands are issued.
+ *
+ * The SAN device layer issues commands strictly sequentially, so only
+ * a single command is ever outstanding on the I/O queue.  Header and
+ * data digests are never negotiated.  The subsystem NQN is taken from
+ * the URI path, e.g.:
+ *
+ *   sanboot nvmetcp://10.0.4.1/nqn.2010-04.org.ipxe:boot-disk
+ *
+ * Connecting to a discovery controller (and walking its discovery log
+ * page) is not supported; the subsystem NQN must be given explicitly.
+ */
+
+/** Host NQN
+ *
+ * Targets identify hosts by NQN; we use a fixed name in keeping with
+ * our default iSCSI initiator name.
+ */
+#define NVMETCP_HOSTNQN "nqn.2010-04.org.ipxe"
+
+/** Submission queue size (zero-based) used when connecting queues */
+#define NVMETCP_SQSIZE 31
+
+/** Maximum length of a single data transfer */
+#define NVMETCP_MAX_XFER_LEN ( 256 * 1024 )
+
+/** Maximum data length per transmitted H2CData PDU */
+#define NVMETCP_MAX_H2C_LEN 8192
+
+/** Delay between controller ready polls */
+#define NVMETCP_READY_DELAY ( TICKS_PER_SEC / 10 )
+
+/** Maximum number of controller ready polls */
+#define NVMETCP_MAX_READY_POLLS 50
+
+/** A read or write command is in progress */
+#define NVMETCP_PENDING_IO 0x0001
+
+/** A capacity report is pending */
+#define NVMETCP_PENDING_CAPACITY 0x0002
+
+#define EINVAL_NO_NQN __einfo_error ( EINFO_EINVAL_NO_NQN )
+#define EINFO_EINVAL_NO_NQN \
+	__einfo_uniqify ( EINFO_EINVAL, 0x01, "No subsystem NQN" )
+#define EPROTO_INVALID_PDU __einfo_error ( EINFO_EPROTO_INVALID_PDU )
+#define EINFO_EPROTO_INVALID_PDU \
+	__einfo_uniqify ( EINFO_EPROTO, 0x01, "Invalid PDU received" )
+#define EIO_CMD __einfo_error ( EINFO_EIO_CMD )
+#define EINFO_EIO_CMD \
+	__einfo_uniqify ( EINFO_EIO, 0x01, "Command failed" )
+
+static void nvmetcp_close ( struct nvmetcp_session *session, int rc );
+
+/**
+ * Free NVMe/TCP session
+ *
+ * @v refcnt		Reference counter
+ */
+static void nvmetcp_free ( struct refcnt *refcnt ) {
+	struct nvmetcp_session *session =
+		container_of ( refcnt, struct nvmetcp_session, refcnt );
+
+	uri_put ( session->uri );
+	free ( session->ident );
+	free ( session );
+}
+
+/**
+ * Open NVMe/TCP queue connection
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_open_connection ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct sockaddr_tcpip target;
+	int rc;
+
+	/* Open socket */
+	memset ( &target, 0, sizeof ( target ) );
+	target.st_port = htons ( uri_port ( session->uri, NVMETCP_PORT ) );
+	if ( ( rc = xfer_open_named_socket ( &queue->socket, SOCK_STREAM,
+					     ( struct sockaddr * ) &target,
+					     session->uri->host,
+					     NULL ) ) != 0 ) {
+		DBGC ( session, "NVMeTCP %p could not open qid %d socket: "
+		       "%s\n", session, queue->qid, strerror ( rc ) );
+		return rc;
+	}
+
+	return 0;
+}
+
+/**
+ * Initialise a command capsule PDU
+ *
+ * @v queue		NVMe/TCP queue
+ * @v cmd		Command capsule to initialise
+ * @v data_len		Length of in-capsule data (if any)
+ */
+static void nvmetcp_cmd_init ( struct nvmetcp_queue *queue,
+			       struct nvmetcp_cmd *cmd, size_t data_len ) {
+
+	memset ( cmd, 0, sizeof ( *cmd ) );
+	cmd->header.type = NVMETCP_CMD;
+	cmd->header.hlen = sizeof ( *cmd );
+	cmd->header.pdo = ( data_len ? sizeof ( *cmd ) : 0 );
+	cmd->header.plen = cpu_to_le32 ( sizeof ( *cmd ) + data_len );
+	cmd->sqe.cid = cpu_to_le16 ( queue->cid++ );
+}
+
+/**
+ * Populate an SGL data block descriptor
+ *
+ * @v sqe		Submission queue entry
+ * @v type		SGL descriptor type (and subtype)
+ * @v len		Data length
+ */
+static void nvmetcp_sgl ( struct nvme_command *sqe, unsigned int type,
+			  size_t len ) {
+
+	sqe->flags |= NVME_CMD_SGL;
+	sqe->prp2 = cpu_to_le64 ( ( ( ( uint64_t ) type ) << 56 ) | len );
+}
+
+/**
+ * Transmit an Initialise Connection Request PDU
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_tx_icreq ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_icreq icreq;
+
+	/* Construct ICReq: no digests, no data alignment, one R2T */
+	memset ( &icreq, 0, sizeof ( icreq ) );
+	icreq.header.type = NVMETCP_ICREQ;
+	icreq.header.hlen = sizeof ( icreq );
+	icreq.header.plen = cpu_to_le32 ( sizeof ( icreq ) );
+
+	return xfer_deliver_raw ( &queue->socket, &icreq, sizeof ( icreq ) );
+}
+
+/**
+ * Transmit a Connect fabrics command
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_tx_connect ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	int is_admin = ( queue->qid == NVME_QID_ADMIN );
+	struct nvme_connect_data data;
+	struct nvmetcp_cmd cmd;
+	int rc;
+
+	/* Construct command capsule */
+	nvmetcp_cmd_init ( queue, &cmd, sizeof ( data ) );
+	cmd.sqe.opcode = NVME_FABRICS;
+	cmd.sqe.nsid = cpu_to_le32 ( NVME_FABRICS_CONNECT );
+	nvmetcp_sgl ( &cmd.sqe, NVMETCP_SGL_INCAPSULE, sizeof ( data ) );
+	cmd.sqe.cdw10 = cpu_to_le32 ( queue->qid << 16 );
+	cmd.sqe.cdw11 = cpu_to_le32 ( NVMETCP_SQSIZE );
+
+	/* Construct in-capsule connect data */
+	memset ( &data, 0, sizeof ( data ) );
+	data.cntlid = cpu_to_le16 ( is_admin ? NVME_CNTLID_DYNAMIC :
+				    session->cntlid );
+	snprintf ( data.subnqn, sizeof ( data.subnqn ), "%s",
+		   session->subnqn );
+	snprintf ( data.hostnqn, sizeof ( data.hostnqn ), "%s",
+		   NVMETCP_HOSTNQN );
+
+	/* Transmit capsule and in-capsule data */
+	if ( ( rc = xfer_deliver_raw ( &queue->socket, &cmd,
+				       sizeof ( cmd ) ) ) != 0 )
+		return rc;
+	if ( ( rc = xfer_deliver_raw ( &queue->socket, &data,
+				       sizeof ( data ) ) ) != 0 )
+		return rc;
+
+	return 0;
+}
+
+/**
+ * Transmit a Property Set/Get fabrics command
+ *
+ * Fabrics property offsets mirror the memory-mapped controller
+ * register map, so the register offsets may be used directly.
+ *
+ * @v session		NVMe/TCP session
+ * @v fctype		Fabrics command type
+ * @v offset		Property offset
+ * @v value		Property value (for Property Set)
+ * @ret rc		Return status code
+ */
+static int nvmetcp_tx_property ( struct nvmetcp_session *session,
+				 unsigned int fctype, unsigned int offset,
+				 uint32_t value ) {
+	struct nvmetcp_cmd cmd;
+
+	/* Construct command capsule (4-byte property) */
+	nvmetcp_cmd_init ( &session->admin, &cmd, 0 );
+	cmd.sqe.opcode = NVME_FABRICS;
+	cmd.sqe.nsid = cpu_to_le32 ( fctype );
+	cmd.sqe.cdw11 = cpu_to_le32 ( offset );
+	cmd.sqe.cdw12 = cpu_to_le32 ( value );
+
+	return xfer_deliver_raw ( &session->admin.socket, &cmd,
+				  sizeof ( cmd ) );
+}
+
+/**
+ * Transmit an Identify admin command
+ *
+ * @v session		NVMe/TCP session
+ * @v cns		Identify data structure type
+ * @v nsid		Namespace identifier (if applicable)
+ * @ret rc		Return status code
+ */
+static int nvmetcp_tx_identify ( struct nvmetcp_session *session,
+				 unsigned int cns, uint32_t nsid ) {
+	struct nvmetcp_cmd cmd;
+
+	/* Construct command capsule */
+	nvmetcp_cmd_init ( &session->admin, &cmd, 0 );
+	cmd.sqe.opcode = NVME_ADMIN_IDENTIFY;
+	cmd.sqe.nsid = cpu_to_le32 ( nsid );
+	nvmetcp_sgl ( &cmd.sqe, NVMETCP_SGL_TRANSPORT,
+		      sizeof ( struct nvme_identity_ctrl ) );
+	cmd.sqe.cdw10 = cpu_to_le32 ( cns );
+
+	return xfer_deliver_raw ( &session->admin.socket, &cmd,
+				  sizeof ( cmd ) );
+}
+
+/**
+ * Transmit as much pending host to controller data as possible
+ *
+ * @v session		NVMe/TCP session
+ *
+ * Transmission is limited by the TCP transmit window; any remaining
+ * data will be transmitted as the window reopens.
+ */
+static void nvmetcp_tx_h2c ( struct nvmetcp_session *session ) {
+	struct nvmetcp_queue *queue = &session->io;
+	struct nvmetcp_h2c_data h2c;
+	size_t chunk;
+	int rc;
+
+	while ( session->h2c_remaining ) {
+
+		/* Calculate length of this H2CData PDU */
+		chunk = session->h2c_remaining;
+		if ( chunk > session->maxh2cdata )
+			chunk = session->maxh2cdata;
+		if ( chunk > NVMETCP_MAX_H2C_LEN )
+			chunk = NVMETCP_MAX_H2C_LEN;
+
+		/* Wait for the transmit window to reopen, if needed */
+		if ( xfer_window ( &queue->socket ) <
+		     ( sizeof ( h2c ) + chunk ) )
+			return;
+
+		/* Construct and transmit H2CData PDU */
+		memset ( &h2c, 0, sizeof ( h2c ) );
+		h2c.header.type = NVMETCP_H2C_DATA;
+		h2c.header.hlen = sizeof ( h2c );
+		h2c.header.pdo = sizeof ( h2c );
+		h2c.header.plen = cpu_to_le32 ( sizeof ( h2c ) + chunk );
+		if ( ( session->h2c_offset + chunk ) == session->len )
+			h2c.header.flags |= NVMETCP_FLAG_LAST;
+		h2c.cccid = cpu_to_le16 ( session->cmd_cid );
+		h2c.ttag = cpu_to_le16 ( session->ttag );
+		h2c.datao = cpu_to_le32 ( session->h2c_offset );
+		h2c.datal = cpu_to_le32 ( chunk );
+		if ( ( ( rc = xfer_deliver_raw ( &queue->socket, &h2c,
+						 sizeof ( h2c ) ) ) != 0 ) ||
+		     ( ( rc = xfer_deliver_raw ( &queue->socket,
+						 ( session->buffer +
+						   session->h2c_offset ),
+						 chunk ) ) != 0 ) ) {
+			DBGC ( session, "NVMeTCP %p could not transmit data: "
+			       "%s\n", session, strerror ( rc ) );
+			nvmetcp_close ( session, rc );
+			return;
+		}
+		session->h2c_offset += chunk;
+		session->h2c_remaining -= chunk;
+	}
+}
+
+/**
+ * Complete the current I/O command
+ *
+ * @v session		NVMe/TCP session
+ * @v rc		Return status code
+ */
+static void nvmetcp_done ( struct nvmetcp_session *session, int rc ) {
+
+	session->pending = 0;
+	session->h2c_remaining = 0;
+	intf_restart ( &session->data, rc );
+}
+
+/**
+ * Handle controller ready polling timer expiry
+ *
+ * @v timer		Controller ready polling timer
+ * @v over		Failure indicator (ignored)
+ */
+static void nvmetcp_expired ( struct retry_timer *timer, int over __unused ) {
+	struct nvmetcp_session *session =
+		container_of ( timer, struct nvmetcp_session, timer );
+	int rc;
+
+	/* Poll controller status again */
+	assert ( session->state == NVMETCP_STATE_WAIT_READY );
+	if ( ( rc = nvmetcp_tx_property ( session, NVME_FABRICS_PROPERTY_GET,
+					  NVME_CSTS, 0 ) ) != 0 )
+		nvmetcp_close ( session, rc );
+}
+
+/**
+ * Handle an admin queue completion
+ *
+ * @v session		NVMe/TCP session
+ * @v cqe		Completion queue entry
+ * @ret rc		Return status code
+ */
+static int nvmetcp_admin_rsp ( struct nvmetcp_session *session,
+			       struct nvme_completion *cqe ) {
+	struct nvme_identity_ctrl *ctrl;
+	struct nvme_identity_ns *ns;
+	unsigned int status;
+	unsigned int lbads;
+	int rc;
+
+	/* Fail on any admin command error */
+	status = NVME_STATUS ( le16_to_cpu ( cqe->status ) );
+	if ( status ) {
+		DBGC ( session, "NVMeTCP %p admin command failed in state "
+		       "%d: status %#04x\n", session, session->state,
+		       status );
+		return -EIO_CMD;
+	}
+
+	/* Advance the session establishment state machine */
+	switch ( session->state ) {
+
+	case NVMETCP_STATE_CONNECT_ADMIN:
+		/* Record controller ID and enable the controller */
+		session->cntlid = ( le32_to_cpu ( cqe->result ) & 0xffff );
+		DBGC ( session, "NVMeTCP %p connected to controller %#04x\n",
+		       session, session->cntlid );
+		session->state = NVMETCP_STATE_ENABLE;
+		return nvmetcp_tx_property ( session,
+					     NVME_FABRICS_PROPERTY_SET,
+					     NVME_CC, ( NVME_CC_IOSQES |
+							NVME_CC_IOCQES |
+							NVME_CC_EN ) );
+
+	case NVMETCP_STATE_ENABLE:
+		/* Start polling for controller ready */
+		session->ready_polls = NVMETCP_MAX_READY_POLLS;
+		session->state = NVMETCP_STATE_WAIT_READY;
+		return nvmetcp_tx_property ( session,
+					     NVME_FABRICS_PROPERTY_GET,
+					     NVME_CSTS, 0 );
+
+	case NVMETCP_STATE_WAIT_READY:
+		/* Retry until the controller reports ready */
+		if ( ! ( le32_to_cpu ( cqe->result ) & NVME_CSTS_RDY ) ) {
+			if ( ! session->ready_polls-- ) {
+				DBGC ( session, "NVMeTCP %p timed out "
+				       "waiting for controller ready\n",
+				       session );
+				return -ETIMEDOUT;
+			}
+			start_timer_fixed ( &session->timer,
+					    NVMETCP_READY_DELAY );
+			return 0;
+		}
+		/* Identify the controller */
+		session->ident = malloc ( sizeof ( *ctrl ) );
+		if ( ! session->ident )
+			return -ENOMEM;
+		session->state = NVMETCP_STATE_IDENTIFY_CTRL;
+		return nvmetcp_tx_identify ( session, NVME_IDENTIFY_CTRL, 0 );
+
+	case NVMETCP_STATE_IDENTIFY_CTRL:
+		/* Check for the presence of a namespace */
+		ctrl = session->ident;
+		DBGC ( session, "NVMeTCP %p model \"%.40s\" serial \"%.20s\" "
+		       "(%d namespaces)\n", session, ctrl->mn, ctrl->sn,
+		       le32_to_cpu ( ctrl->nn ) );
+		if ( ! ctrl->nn ) {
+			DBGC ( session, "NVMeTCP %p has no namespaces\n",
+			       session );
+			return -ENODEV;
+		}
+		/* Assume that the first namespace is namespace 1 */
+		session->nsid = 1;
+		session->state = NVMETCP_STATE_IDENTIFY_NS;
+		return nvmetcp_tx_identify ( session, NVME_IDENTIFY_NS,
+					     session->nsid );
+
+	case NVMETCP_STATE_IDENTIFY_NS:
+		/* Record namespace geometry */
+		ns = session->ident;
+		lbads = NVME_LBAF_LBADS ( le32_to_cpu ( ns->lbaf [
+				NVME_FLBAS_FORMAT ( ns->flbas ) ] ) );
+		session->blksize = ( 1UL << lbads );
+		session->blocks = le64_to_cpu ( ns->nsze );
+		if ( ! session->blocks ) {
+			DBGC ( session, "NVMeTCP %p namespace %d has zero "
+			       "size\n", session, session->nsid );
+			return -ENODEV;
+		}
+		session->max_count = ( NVMETCP_MAX_XFER_LEN /
+				       session->blksize );
+		if ( session->max_count > 0x10000 )
+			session->max_count = 0x10000;
+		DBGC ( session, "NVMeTCP %p namespace %d has %lld blocks of "
+		       "%zd bytes\n", session, session->nsid,
+		       ( ( unsigned long long ) session->blocks ),
+		       session->blksize );
+		free ( session->ident );
+		session->ident = NULL;
+		/* Establish the I/O queue connection */
+		session->state = NVMETCP_STATE_IO_ICREQ;
+		if ( ( rc = nvmetcp_open_connection ( &session->io ) ) != 0 )
+			return rc;
+		return 0;
+
+	case NVMETCP_STATE_CONNECT_IO:
+		/* Session is now ready for I/O commands */
+		session->state = NVMETCP_STATE_READY;
+		DBGC ( session, "NVMeTCP %p ready\n", session );
+		return 0;
+
+	default:
+		DBGC ( session, "NVMeTCP %p unexpected admin completion in "
+		       "state %d\n", session, session->state );
+		return -EPROTO_INVALID_PDU;
+	}
+}
+
+/**
+ * Handle a received Initialise Connection Response PDU
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_icresp ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvmetcp_icresp *icresp = &queue->rx.icresp;
+
+	/* Validate negotiated parameters */
+	if ( le16_to_cpu ( icresp->pfv ) != 0 ) {
+		DBGC ( session, "NVMeTCP %p unsupported PDU format version "
+		       "%d\n", session, le16_to_cpu ( icresp->pfv ) );
+		return -EPROTO_INVALID_PDU;
+	}
+	if ( icresp->dgst ) {
+		DBGC ( session, "NVMeTCP %p unexpected digest negotiation "
+		       "%#02x\n", session, icresp->dgst );
+		return -EPROTO_INVALID_PDU;
+	}
+	if ( ! icresp->maxh2cdata ) {
+		DBGC ( session, "NVMeTCP %p invalid maximum data length\n",
+		       session );
+		return -EPROTO_INVALID_PDU;
+	}
+	session->maxh2cdata = le32_to_cpu ( icresp->maxh2cdata );
+
+	/* Connect this queue */
+	if ( queue->qid == NVME_QID_ADMIN ) {
+		if ( session->state != NVMETCP_STATE_ADMIN_ICREQ )
+			return -EPROTO_INVALID_PDU;
+		session->state = NVMETCP_STATE_CONNECT_ADMIN;
+	} else {
+		if ( session->state != NVMETCP_STATE_IO_ICREQ )
+			return -EPROTO_INVALID_PDU;
+		session->state = NVMETCP_STATE_CONNECT_IO;
+	}
+	return nvmetcp_tx_connect ( queue );
+}
+
+/**
+ * Handle a received Response Capsule PDU
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_rsp ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvme_completion *cqe = &queue->rx.rsp.cqe;
+	unsigned int status;
+	int rc = 0;
+
+	/* Admin completions drive the session state machine */
+	if ( queue->qid == NVME_QID_ADMIN )
+		return nvmetcp_admin_rsp ( session, cqe );
+
+	/* I/O completions must match the current command */
+	if ( ! ( session->pending & NVMETCP_PENDING_IO ) ) {
+		DBGC ( session, "NVMeTCP %p unexpected I/O completion\n",
+		       session );
+		return -EPROTO_INVALID_PDU;
+	}
+	if ( le16_to_cpu ( cqe->cid ) != session->cmd_cid ) {
+		DBGC ( session, "NVMeTCP %p completion for unknown command "
+		       "%#04x\n", session, le16_to_cpu ( cqe->cid ) );
+		return -EPROTO_INVALID_PDU;
+	}
+	status = NVME_STATUS ( le16_to_cpu ( cqe->status ) );
+	if ( status ) {
+		DBGC ( session, "NVMeTCP %p command %#02x failed: status "
+		       "%#04x\n", session, session->opcode, status );
+		rc = -EIO_CMD;
+	}
+	nvmetcp_done ( session, rc );
+	return 0;
+}
+
+/**
+ * Handle a received Controller to Host Data PDU header
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_c2h ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvmetcp_c2h_data *c2h = &queue->rx.c2h;
+	size_t datao = le32_to_cpu ( c2h->datao );
+	size_t datal = le32_to_cpu ( c2h->datal );
+	size_t max;
+	void *base;
+
+	/* Identify the data buffer for this queue's current command */
+	if ( queue->qid == NVME_QID_ADMIN ) {
+		base = session->ident;
+		max = sizeof ( struct nvme_identity_ctrl );
+		if ( ! base ) {
+			DBGC ( session, "NVMeTCP %p unexpected admin data\n",
+			       session );
+			return -EPROTO_INVALID_PDU;
+		}
+	} else {
+		base = session->buffer;
+		max = session->len;
+		if ( ( ! ( session->pending & NVMETCP_PENDING_IO ) ) ||
+		     ( session->opcode != NVME_IO_READ ) ||
+		     ( le16_to_cpu ( c2h->cccid ) != session->cmd_cid ) ) {
+			DBGC ( session, "NVMeTCP %p unexpected I/O data\n",
+			       session );
+			return -EPROTO_INVALID_PDU;
+		}
+	}
+
+	/* Validate data range */
+	if ( ( datao > max ) || ( datal > ( max - datao ) ) ) {
+		DBGC ( session, "NVMeTCP %p data [%zd,%zd) exceeds buffer "
+		       "length %zd\n", session, datao, ( datao + datal ),
+		       max );
+		return -EPROTO_INVALID_PDU;
+	}
+
+	/* Receive data directly into the command data buffer */
+	queue->rx_data = ( base + datao );
+	queue->rx_state = NVMETCP_RX_DATA;
+	queue->rx_offset = 0;
+	queue->rx_len = datal;
+	return 0;
+}
+
+/**
+ * Handle a received Ready to Transfer PDU
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_r2t ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvmetcp_r2t *r2t = &queue->rx.r2t;
+	size_t r2to = le32_to_cpu ( r2t->r2to );
+	size_t r2tl = le32_to_cpu ( r2t->r2tl );
+
+	/* Validate solicitation */
+	if ( ( queue->qid == NVME_QID_ADMIN ) ||
+	     ( ! ( session->pending & NVMETCP_PENDING_IO ) ) ||
+	     ( session->opcode != NVME_IO_WRITE ) ||
+	     ( le16_to_cpu ( r2t->cccid ) != session->cmd_cid ) ) {
+		DBGC ( session, "NVMeTCP %p unexpected R2T\n", session );
+		return -EPROTO_INVALID_PDU;
+	}
+	if ( ( ! r2tl ) || ( r2to > session->len ) ||
+	     ( r2tl > ( session->len - r2to ) ) ) {
+		DBGC ( session, "NVMeTCP %p R2T [%zd,%zd) exceeds command "
+		       "length %zd\n", session, r2to, ( r2to + r2tl ),
+		       session->len );
+		return -EPROTO_INVALID_PDU;
+	}
+
+	/* Begin the solicited data transfer */
+	session->ttag = le16_to_cpu ( r2t->ttag );
+	session->h2c_offset = r2to;
+	session->h2c_remaining = r2tl;
+	nvmetcp_tx_h2c ( session );
+	return 0;
+}
+
+/**
+ * Handle a completely received PDU header
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_header_done ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvmetcp_header *header = &queue->rx.header;
+	size_t plen = le32_to_cpu ( header->plen );
+
+	switch ( header->type ) {
+
+	case NVMETCP_ICRESP:
+		if ( ( header->hlen != sizeof ( queue->rx.icresp ) ) ||
+		     ( plen != sizeof ( queue->rx.icresp ) ) )
+			goto invalid;
+		return nvmetcp_rx_icresp ( queue );
+
+	case NVMETCP_RSP:
+		if ( ( header->hlen != sizeof ( queue->rx.rsp ) ) ||
+		     ( plen != sizeof ( queue->rx.rsp ) ) )
+			goto invalid;
+		return nvmetcp_rx_rsp ( queue );
+
+	case NVMETCP_C2H_DATA:
+		/* No digests or data alignment are ever negotiated */
+		if ( ( header->hlen != sizeof ( queue->rx.c2h ) ) ||
+		     ( plen != ( sizeof ( queue->rx.c2h ) +
+				 le32_to_cpu ( queue->rx.c2h.datal ) ) ) ||
+		     ( ! queue->rx.c2h.datal ) )
+			goto invalid;
+		return nvmetcp_rx_c2h ( queue );
+
+	case NVMETCP_R2T:
+		if ( ( header->hlen != sizeof ( queue->rx.r2t ) ) ||
+		     ( plen != sizeof ( queue->rx.r2t ) ) )
+			goto invalid;
+		return nvmetcp_rx_r2t ( queue );
+
+	case NVMETCP_C2H_TERM:
+		DBGC ( session, "NVMeTCP %p connection terminated by "
+		       "controller\n", session );
+		return -EPROTO_INVALID_PDU;
+
+	default:
+		DBGC ( session, "NVMeTCP %p received unknown PDU type "
+		       "%#02x\n", session, header->type );
+		return -EPROTO_INVALID_PDU;
+	}
+
+ invalid:
+	DBGC ( session, "NVMeTCP %p received malformed PDU type %#02x "
+	       "(hlen %d plen %zd)\n", session, header->type, header->hlen,
+	       plen );
+	return -EPROTO_INVALID_PDU;
+}
+
+/**
+ * Handle completely received PDU data
+ *
+ * @v queue		NVMe/TCP queue
+ * @ret rc		Return status code
+ */
+static int nvmetcp_rx_data_done ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	uint8_t flags = queue->rx.header.flags;
+
+	/* A successful read may complete without a response capsule */
+	if ( ( queue->qid != NVME_QID_ADMIN ) &&
+	     ( flags & NVMETCP_FLAG_SUCCESS ) &&
+	     ( flags & NVMETCP_FLAG_LAST ) ) {
+		nvmetcp_done ( session, 0 );
+	}
+	return 0;
+}
+
+/**
+ * Receive data from the TCP connection
+ *
+ * @v queue		NVMe/TCP queue
+ * @v iobuf		I/O buffer
+ * @v meta		Data transfer metadata
+ * @ret rc		Return status code
+ */
+static int nvmetcp_socket_deliver ( struct nvmetcp_queue *queue,
+				    struct io_buffer *iobuf,
+				    struct xfer_metadata *meta __unused ) {
+	struct nvmetcp_session *session = queue->session;
+	struct nvmetcp_header *header = &queue->rx.header;
+	size_t frag_len;
+	int rc = 0;
+
+	while ( iob_len ( iobuf ) ) {
+
+		if ( queue->rx_state == NVMETCP_RX_HEADER ) {
+
+			/* Receive the common header, then extend to
+			 * the full header length.
+			 */
+			if ( queue->rx_offset < sizeof ( *header ) )
+				queue->rx_len = sizeof ( *header );
+			frag_len = ( queue->rx_len - queue->rx_offset );
+			if ( frag_len > iob_len ( iobuf ) )
+				frag_len = iob_len ( iobuf );
+			memcpy ( &queue->rx.bytes[queue->rx_offset],
+				 iobuf->data, frag_len );
+			queue->rx_offset += frag_len;
+			iob_pull ( iobuf, frag_len );
+			if ( queue->rx_offset == sizeof ( *header ) ) {
+				if ( ( header->hlen < sizeof ( *header ) ) ||
+				     ( header->hlen >
+				       sizeof ( queue->rx.bytes ) ) ) {
+					DBGC ( session, "NVMeTCP %p invalid "
+					       "header length %d\n", session,
+					       header->hlen );
+					rc = -EPROTO_INVALID_PDU;
+					goto done;
+				}
+				queue->rx_len = header->hlen;
+			}
+			if ( queue->rx_offset < queue->rx_len )
+				continue;
+			if ( ( rc = nvmetcp_rx_header_done ( queue ) ) != 0 )
+				goto done;
+			if ( queue->rx_state == NVMETCP_RX_HEADER )
+				queue->rx_offset = 0;
+
+		} else {
+
+			/* Receive PDU data directly into its buffer */
+			frag_len = ( queue->rx_len - queue->rx_offset );
+			if ( frag_len > iob_len ( iobuf ) )
+				frag_len = iob_len ( iobuf );
+			memcpy ( ( queue->rx_data + queue->rx_offset ),
+				 iobuf->data, frag_len );
+			queue->rx_offset += frag_len;
+			iob_pull ( iobuf, frag_len );
+			if ( queue->rx_offset < queue->rx_len )
+				continue;
+			if ( ( rc = nvmetcp_rx_data_done ( queue ) ) != 0 )
+				goto done;
+			queue->rx_state = NVMETCP_RX_HEADER;
+			queue->rx_offset = 0;
+		}
+	}
+
+ done:
+	/* Free I/O buffer */
+	free_iob ( iobuf );
+
+	/* Destroy session on error */
+	if ( rc != 0 )
+		nvmetcp_close ( session, rc );
+
+	return rc;
+}
+
+/**
+ * Handle a change in the TCP transmit window
+ *
+ * @v queue		NVMe/TCP queue
+ */
+static void nvmetcp_socket_window_changed ( struct nvmetcp_queue *queue ) {
+	struct nvmetcp_session *session = queue->session;
+	int rc;
+
+	/* Do nothing until the connection can accept data */
+	if ( ! xfer_window ( &queue->socket ) )
+		return;
+
+	/* Initialise the connection as soon as it is established */
+	if ( ! queue->icreq_sent ) {
+		queue->icreq_sent = 1;
+		if ( ( rc = nvmetcp_tx_icreq ( queue ) ) != 0 ) {
+			nvmetcp_close ( session, rc );
+			return;
+		}
+	}
+
+	/* Resume any paused solicited data transfer */
+	if ( ( queue->qid != NVME_QID_ADMIN ) && session->h2c_remaining )
+		nvmetcp_tx_h2c ( session );
+}
+
+/**
+ * Handle closure of a queue connection
+ *
+ * @v queue		NVMe/TCP queue
+ * @v rc		Reason for closure
+ */
+static void nvmetcp_socket_close ( struct nvmetcp_queue *queue, int rc ) {
+	struct nvmetcp_session *session = queue->session;
+
+	DBGC ( session, "NVMeTCP %p qid %d connection closed: %s\n",
+	       session, queue->qid, strerror ( rc ) );
+	nvmetcp_close ( session, ( rc ? rc : -ECONNRESET ) );
+}
+
+/** NVMe/TCP socket interface operations */
+static struct interface_operation nvmetcp_socket_operations[] = {
+	INTF_OP ( xfer_deliver, struct nvmetcp_queue *,
+		  nvmetcp_socket_deliver ),
+	INTF_OP ( xfer_window_changed, struct nvmetcp_queue *,
+		  nvmetcp_socket_window_changed ),
+	INTF_OP ( intf_close, struct nvmetcp_queue *, nvmetcp_socket_close ),
+};
+
+/** NVMe/TCP socket interface descriptor */
+static struct interface_descriptor nvmetcp_socket_desc =
+	INTF_DESC ( struct nvmetcp_queue, socket, nvmetcp_socket_operations );
+
+/**
+ * Issue a block device read or write command
+ *
+ * @v session		NVMe/TCP session
+ * @v data		Data interface
+ * @v opcode		NVMe I/O opcode
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvmetcp_block_rw ( struct nvmetcp_session *session,
+			      struct interface *data, unsigned int opcode,
+			      uint64_t lba, unsigned int count,
+			      void *buffer, size_t len ) {
+	struct nvmetcp_cmd cmd;
+	int rc;
+
+	/* Fail if the session is not ready for a command */
+	if ( ( session->state != NVMETCP_STATE_READY ) || session->pending )
+		return -EBUSY;
+
+	/* Sanity checks */
+	assert ( len == ( count * session->blksize ) );
+	assert ( count <= session->max_count );
+
+	/* Record command state */
+	session->opcode = opcode;
+	session->buffer = buffer;
+	session->len = len;
+
+	/* Construct and transmit command capsule */
+	nvmetcp_cmd_init ( &session->io, &cmd, 0 );
+	cmd.sqe.opcode = opcode;
+	cmd.sqe.nsid = cpu_to_le32 ( session->nsid );
+	nvmetcp_sgl ( &cmd.sqe, NVMETCP_SGL_TRANSPORT, len );
+	cmd.sqe.cdw10 = cpu_to_le32 ( lba & 0xffffffffUL );
+	cmd.sqe.cdw11 = cpu_to_le32 ( lba >> 32 );
+	cmd.sqe.cdw12 = cpu_to_le32 ( count - 1 );
+	session->cmd_cid = le16_to_cpu ( cmd.sqe.cid );
+	if ( ( rc = xfer_deliver_raw ( &session->io.socket, &cmd,
+				       sizeof ( cmd ) ) ) != 0 )
+		return rc;
+
+	/* Record command as pending */
+	session->pending = NVMETCP_PENDING_IO;
+	intf_plug_plug ( &session->data, data );
+	return 0;
+}
+
+/**
+ * Read blocks from the namespace
+ *
+ * @v session		NVMe/TCP session
+ * @v data		Data interface
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvmetcp_block_read ( struct nvmetcp_session *session,
+				struct interface *data, uint64_t lba,
+				unsigned int count, void *buffer,
+				size_t len ) {
+
+	return nvmetcp_block_rw ( session, data, NVME_IO_READ, lba, count,
+				  buffer, len );
+}
+
+/**
+ * Write blocks to the namespace
+ *
+ * @v session		NVMe/TCP session
+ * @v data		Data interface
+ * @v lba		Starting logical block address
+ * @v count		Number of logical blocks
+ * @v buffer		Data buffer
+ * @v len		Length of data buffer
+ * @ret rc		Return status code
+ */
+static int nvmetcp_block_write ( struct nvmetcp_session *session,
+				 struct interface *data, uint64_t lba,
+				 unsigned int count, void *buffer,
+				 size_t len ) {
+
+	return nvmetcp_block_rw ( session, data, NVME_IO_WRITE, lba, count,
+				  buffer, len );
+}
+
+/**
+ * Read namespace capacity
+ *
+ * @v session		NVMe/TCP session
+ * @v data		Data interface
+ * @ret rc		Return status code
+ */
+static int nvmetcp_block_read_capacity ( struct nvmetcp_session *session,
+					 struct interface *data ) {
+
+	/* Fail if the session is not ready for a command */
+	if ( ( session->state != NVMETCP_STATE_READY ) || session->pending )
+		return -EBUSY;
+
+	/* The capacity is already known, but the caller does not
+	 * expect synchronous completion; defer the report to the
+	 * process.
+	 */
+	session->pending = NVMETCP_PENDING_CAPACITY;
+	intf_plug_plug ( &session->data, data );
+	process_add ( &session->process );
+	return 0;
+}
+
+/**
+ * Check block device flow control window
+ *
+ * @v session		NVMe/TCP session
+ * @ret len		Length of window
+ */
+static size_t nvmetcp_block_window ( struct nvmetcp_session *session ) {
+
+	/* Accept commands only once the session is established, and
+	 * only one at a time.
+	 */
+	return ( ( ( session->state == NVMETCP_STATE_READY ) &&
+		   ( ! session->pending ) ) ? 1 : 0 );
+}
+
+/**
+ * Handle closure of the block control interface
+ *
+ * @v session		NVMe/TCP session
+ * @v rc		Reason for closure
+ */
+static void nvmetcp_block_close ( struct nvmetcp_session *session, int rc ) {
+
+	nvmetcp_close ( session, rc );
+}
+
+/** NVMe/TCP block control interface operations */
+static struct interface_operation nvmetcp_block_operations[] = {
+	INTF_OP ( block_read, struct nvmetcp_session *, nvmetcp_block_read ),
+	INTF_OP ( block_write, struct nvmetcp_session *,
+		  nvmetcp_block_write ),
+	INTF_OP ( block_read_capacity, struct nvmetcp_session *,
+		  nvmetcp_block_read_capacity ),
+	INTF_OP ( xfer_window, struct nvmetcp_session *,
+		  nvmetcp_block_window ),
+	INTF_OP ( intf_close, struct nvmetcp_session *, nvmetcp_block_close ),
+};
+
+/** NVMe/TCP block control interface descriptor */
+static struct interface_descriptor nvmetcp_block_desc =
+	INTF_DESC ( struct nvmetcp_session, block, nvmetcp_block_operations );
+
+/**
+ * Handle closure of the block data interface
+ *
+ * @v session		NVMe/TCP session
+ * @v rc		Reason for closure
+ */
+static void nvmetcp_command_close ( struct nvmetcp_session *session,
+				    int rc ) {
+
+	/* The command has been aborted (e.g. by the SAN device
+	 * timeout).  Responses and data for it may still be in
+	 * flight, so the connection state can no longer be trusted;
+	 * close the session and allow the SAN layer to reopen it.
+	 */
+	DBGC ( session, "NVMeTCP %p command aborted: %s\n",
+	       session, strerror ( rc ) );
+	nvmetcp_close ( session, ( rc ? rc : -ECANCELED ) );
+}
+
+/** NVMe/TCP block data interface operations */
+static struct interface_operation nvmetcp_data_operations[] = {
+	INTF_OP ( intf_close, struct nvmetcp_session *,
+		  nvmetcp_command_close ),
+};
+
+/** NVMe/TCP block data interface descriptor */
+static struct interface_descriptor nvmetcp_data_desc =
+	INTF_DESC ( struct nvmetcp_session, data, nvmetcp_data_operations );
+
+/**
+ * Report namespace capacity
+ *
+ * @v session		NVMe/TCP session
+ */
+static void nvmetcp_step ( struct nvmetcp_session *session ) {
+	struct block_device_capacity capacity;
+
+	/* Process runs only to defer a capacity report */
+	process_del ( &session->process );
+	if ( ! ( session->pending & NVMETCP_PENDING_CAPACITY ) )
+		return;
+	session->pending = 0;
+
+	/* Report namespace capacity */
+	capacity.blocks = session->blocks;
+	capacity.blksize = session->blksize;
+	capacity.max_count = session->max_count;
+	block_capacity ( &session->data, &capacity );
+	intf_restart ( &session->data, 0 );
+}
+
+/** NVMe/TCP process descriptor */
+static struct process_descriptor nvmetcp_process_desc =
+	PROC_DESC ( struct nvmetcp_session, process, nvmetcp_step );
+
+/**
+ * Close NVMe/TCP session
+ *
+ * @v session		NVMe/TCP session
+ * @v rc		Reason for close
+ */
+static void nvmetcp_close ( struct nvmetcp_session *session, int rc ) {
+
+	/* Stop any pending activity */
+	stop_timer ( &session->timer );
+	process_del ( &session->process );
+	session->pending = 0;
+	session->h2c_remaining = 0;
+
+	/* Shut down interfaces */
+	intf_shutdown ( &session->data, rc );
+	intf_shutdown ( &session->io.socket, rc );
+	intf_shutdown ( &session->admin.socket, rc );
+	intf_shutdown ( &session->block, rc );
+}
+
+/**
+ * Open NVMe/TCP URI
+ *
+ * @v parent		Parent interface
+ * @v uri		URI
+ * @ret rc		Return status code
+ */
+static int nvmetcp_open ( struct interface *parent, struct uri *uri ) {
+	struct nvmetcp_session *session;
+	int rc;
+
+	/* Sanity checks */
+	if ( ! uri->host ) {
+		rc = -EINVAL;
+		goto err_sanity;
+	}
+	if ( ( ! uri->path ) || ( uri->path[0] != '/' ) ||
+	     ( ! uri->path[1] ) ) {
+		rc = -EINVAL_NO_NQN;
+		goto err_sanity;
+	}
+
+	/* Allocate and initialise structure */
+	session = zalloc ( sizeof ( *session ) );
+	if ( ! session ) {
+		rc = -ENOMEM;
+		goto err_zalloc;
+	}
+	ref_init ( &session->refcnt, nvmetcp_free );
+	intf_init ( &session->block, &nvmetcp_block_desc, &session->refcnt );
+	intf_init ( &session->data, &nvmetcp_data_desc, &session->refcnt );
+	intf_init ( &session->admin.socket, &nvmetcp_socket_desc,
+		    &session->refcnt );
+	intf_init ( &session->io.socket, &nvmetcp_socket_desc,
+		    &session->refcnt );
+	process_init_stopped ( &session->process, &nvmetcp_process_desc,
+			       &session->refcnt );
+	timer_init ( &session->timer, nvmetcp_expired, &session->refcnt );
+	session->admin.session = session;
+	session->admin.qid = NVME_QID_ADMIN;
+	session->io.session = session;
+	session->io.qid = NVME_QID_IO;
+	session->uri = uri_get ( uri );
+	session->subnqn = &uri->path[1];
+	DBGC ( session, "NVMeTCP %p target %s port %d subsystem %s\n",
+	       session, uri->host, uri_port ( uri, NVMETCP_PORT ),
+	       session->subnqn );
+
+	/* Open the admin queue connection */
+	if ( ( rc = nvmetcp_open_connection ( &session->admin ) ) != 0 )
+		goto err_open_connection;
+
+	/* Attach to parent interface, mortalise self, and return */
+	intf_plug_plug ( &session->block, parent );
+	ref_put ( &session->refcnt );
+	return 0;
+
+ err_open_connection:
+	nvmetcp_close ( session, rc );
+	ref_put ( &session->refcnt );
+ err_zalloc:
+ err_sanity:
+	return rc;
+}
+
+/** NVMe/TCP URI opener */
+struct uri_opener nvmetcp_uri_opener __uri_opener = {
+	.scheme = "nvmetcp",
+	.open = nvmetcp_open,
+};
@@ -169,25 +169,78 @@ size_t tcpip_mtu ( struct sockaddr_tcpip *st_dest ) {
  */
 uint16_t generic_tcpip_continue_chksum ( uint16_t partial,
 					 const void *data, size_t len ) {
-	unsigned int cksum = ( ( ~partial ) & 0xffff );
-	unsigned int value;
-	unsigned int i;
-	
-	for ( i = 0 ; i < len ; i++ ) {
-		value = * ( ( uint8_t * ) data + i );
-		if ( i & 1 ) {
-			/* Odd bytes: swap on little-endian systems */
-			value = be16_to_cpu ( value );
-		} else {
-			/* Even bytes: swap on big-endian systems */
-			value = le16_to_cpu ( value );
-		}
-		cksum += value;
-		if ( cksum > 0xffff )
-			cksum -= 0xffff;
+	const uint8_t *bytes = data;
+	const uint16_t *half_words;
+	const unsigned long *words;
+	unsigned long sum = ( ( ~partial ) & 0xffff );
+	unsigned long value;
+	int swapped = 0;
+
+	/* The one's complement sum is endian-independent when
+	 * accumulated using host-order loads of any word size (RFC
+	 * 1071): we therefore sum native machine words where
+	 * possible, and fold down to 16 bits at the end.
+	 */
+
+	/* Consume a single leading byte to reach 16-bit alignment,
+	 * if applicable.  Subsequent bytes then have inverted parity
+	 * within their 16-bit words; compensate by byte-swapping the
+	 * running sum, and swapping back before returning.
+	 */
+	if ( len && ( ( ( intptr_t ) bytes ) & 1 ) ) {
+		value = *(bytes++);
+		sum += le16_to_cpu ( value );
+		len--;
+		sum = ( ( sum & 0xffff ) + ( sum >> 16 ) );
+		sum = ( ( sum & 0xffff ) + ( sum >> 16 ) );
+		sum = bswap_16 ( sum );
+		swapped = 1;
+	}
+
+	/* Consume leading 16-bit words up to native word alignment */
+	half_words = ( ( const uint16_t * ) bytes );
+	while ( ( len >= 2 ) &&
+		( ( ( intptr_t ) half_words ) & ( sizeof ( *words ) - 1 ) ) ) {
+		sum += *(half_words++);
+		len -= 2;
+	}
+
+	/* Sum aligned native words, with end-around carry */
+	words = ( ( const unsigned long * ) half_words );
+	while ( len >= sizeof ( *words ) ) {
+		value = *(words++);
+		sum += value;
+		if ( sum < value )
+			sum++;
+		len -= sizeof ( *words );
 	}
-	
-	return ( ~cksum );
+
+	/* Fold down to 16 bits before summing trailing data */
+	while ( sum >> 16 )
+		sum = ( ( sum & 0xffff ) + ( sum >> 16 ) );
+
+	/* Sum trailing 16-bit words */
+	half_words = ( ( const uint16_t * ) words );
+	while ( len >= 2 ) {
+		sum += *(half_words++);
+		len -= 2;
+	}
+
+	/* Sum trailing byte, if applicable */
+	if ( len ) {
+		value = *( ( const uint8_t * ) half_words );
+		sum += le16_to_cpu ( value );
+	}
+
+	/* Fold down to 16 bits */
+	while ( sum >> 16 )
+		sum = ( ( sum & 0xffff ) + ( sum >> 16 ) );
+
+	/* Undo any byte-swap of the running sum */
+	if ( swapped )
+		sum = bswap_16 ( sum );
+
+	return ( ~sum & 0xffff );
 }
 
 /**
@@ -191,6 +191,14 @@ FILE_LICENCE ( GPL2_OR_LATER );
 /** List of TLS session */
 static LIST_HEAD ( tls_sessions );
 
+/** Number of idle TLS sessions to retain for resumption
+ *
+ * Sessions (including any session ID or session ticket) are retained
+ * after the last connection closes, so that a subsequent connection
+ * to the same server may perform an abbreviated handshake.
+ */
+#define TLS_SESSION_CACHE 8
+
 static void tls_tx_resume_all ( struct tls_session *session );
 static struct io_buffer * tls_alloc_iob ( struct tls_connection *tls,
 					  size_t len );
@@ -357,9 +365,6 @@ static void free_tls_session ( struct refcnt *refcnt ) {
 	/* Sanity check */
 	assert ( list_empty ( &session->conn ) );
 
-	/* Remove from list of sessions */
-	list_del ( &session->list );
-
 	/* Free dynamically-allocated resources */
 	x509_root_put ( session->root );
 	privkey_put ( session->key );
@@ -694,6 +699,14 @@ static int tls_generate_keys ( struct tls_connection *tls ) {
 	DBGC_HD ( tls, key, hash_size );
 	key += hash_size;
 
+	/* Pre-key HMAC contexts, to avoid repeating the key padding
+	 * computation for each record.
+	 */
+	hmac_init ( tx_cipherspec->suite->digest, tx_cipherspec->hmac_ctx,
+		    tx_cipherspec->mac_secret, hash_size );
+	hmac_init ( rx_cipherspec->suite->digest, rx_cipherspec->hmac_ctx,
+		    rx_cipherspec->mac_secret, hash_size );
+
 	/* TX key */
 	if ( ( rc = cipher_setkey ( tx_cipherspec->suite->cipher,
 				    tx_cipherspec->cipher_ctx,
@@ -874,6 +887,7 @@ static int tls_set_cipher ( struct tls_connection *tls,
 			    struct tls_cipherspec *cipherspec,
 			    struct tls_cipher_suite *suite ) {
 	struct cipher_algorithm *cipher = suite->cipher;
+	size_t hmac_len = hmac_ctxsize ( suite->digest );
 	size_t total;
 	void *dynamic;
 
@@ -881,7 +895,8 @@ static int tls_set_cipher ( struct tls_connection *tls,
 	tls_clear_cipher ( tls, cipherspec );
 
 	/* Allocate dynamic storage */
-	total = ( cipher->ctxsize + suite->mac_len + suite->fixed_iv_len );
+	total = ( cipher->ctxsize + hmac_len + suite->mac_len +
+		  suite->fixed_iv_len );
 	dynamic = zalloc ( total );
 	if ( ! dynamic ) {
 		DBGC ( tls, "TLS %p could not allocate %zd bytes for crypto "
@@ -892,6 +907,7 @@ static int tls_set_cipher ( struct tls_connection *tls,
 	/* Assign storage */
 	cipherspec->dynamic = dynamic;
 	cipherspec->cipher_ctx = dynamic;	dynamic += cipher->ctxsize;
+	cipherspec->hmac_ctx = dynamic;		dynamic += hmac_len;
 	cipherspec->mac_secret = dynamic;	dynamic += suite->mac_len;
 	cipherspec->fixed_iv = dynamic;		dynamic += suite->fixed_iv_len;
 	assert ( ( cipherspec->dynamic + total ) == dynamic );
@@ -2839,7 +2855,7 @@ static void tls_hmac_init ( struct tls_cipherspec *cipherspec, void *ctx,
 	struct tls_cipher_suite *suite = cipherspec->suite;
 	struct digest_algorithm *digest = suite->digest;
 
-	hmac_init ( digest, ctx, cipherspec->mac_secret, suite->mac_len );
+	memcpy ( ctx, cipherspec->hmac_ctx, hmac_ctxsize ( digest ) );
 	hmac_update ( digest, ctx, authhdr, sizeof ( *authhdr ) );
 }
 
@@ -3575,7 +3591,15 @@ static int tls_cipherstream_deliver ( struct tls_connection *tls,
 			goto done;
 		}
 
-		/* Copy data portion to buffer */
+		/* Copy data portion to buffer.  This is the only copy
+		 * made of the record contents: decryption is
+		 * performed in place within the receive buffers, and
+		 * plaintext data records are delivered to the
+		 * plaintext stream without further copying.  This
+		 * copy cannot be elided, since received TCP segment
+		 * boundaries bear no relation to record and cipher
+		 * block boundaries.
+		 */
 		frag_len = iob_len ( iobuf );
 		if ( frag_len > iob_tailroom ( dest ) )
 			frag_len = iob_tailroom ( dest );
@@ -3818,6 +3842,29 @@ static struct process_descriptor tls_process_desc =
  ******************************************************************************
  */
 
+/**
+ * Discard least recently used idle TLS sessions
+ *
+ */
+static void tls_session_prune ( void ) {
+	struct tls_session *session;
+	struct tls_session *tmp;
+	unsigned int idle = 0;
+
+	/* Discard idle sessions beyond the cache limit.  The list is
+	 * maintained in order of recency of use.
+	 */
+	list_for_each_entry_safe ( session, tmp, &tls_sessions, list ) {
+		if ( ! list_empty ( &session->conn ) )
+			continue;
+		if ( ++idle <= TLS_SESSION_CACHE )
+			continue;
+		DBGC ( session, "TLS session %s discarded\n", session->name );
+		list_del ( &session->list );
+		ref_put ( &session->refcnt );
+	}
+}
+
 /**
  * Find or create session for TLS connection
  *
@@ -3837,6 +3884,9 @@ static int tls_session ( struct tls_connection *tls, const char *name ) {
 		     ( tls->client.key == session->key ) ) {
 			ref_get ( &session->refcnt );
 			tls->session = session;
+			/* Mark session as most recently used */
+			list_del ( &session->list );
+			list_add ( &session->list, &tls_sessions );
 			DBGC ( tls, "TLS %p joining session %s\n", tls, name );
 			return 0;
 		}
@@ -3856,7 +3906,14 @@ static int tls_session ( struct tls_connection *tls, const char *name ) {
 	session->root = x509_root_get ( tls->server.root );
 	session->key = privkey_get ( tls->client.key );
 	INIT_LIST_HEAD ( &session->conn );
+
+	/* Add to list of sessions, with the list itself holding a
+	 * reference so that the session (and hence any session ID or
+	 * ticket) survives after the last connection closes.
+	 */
+	ref_get ( &session->refcnt );
 	list_add ( &session->list, &tls_sessions );
+	tls_session_prune();
 
 	/* Record session */
 	tls->session = session;
@@ -43,6 +43,22 @@ struct udp_connection {
  */
 static LIST_HEAD ( udp_conns );
 
+/** Most recently demultiplexed connection
+ *
+ * UDP connections may match on wildcard addresses and ports (and
+ * promiscuous connections match everything), so the first-match walk
+ * cannot be replaced by a pure hash lookup.  Bulk transfers
+ * nevertheless deliver long runs of datagrams to a single local
+ * address, so a one-entry cache keyed on the incoming local address
+ * removes the per-packet walk in the common case.  The cache must be
+ * invalidated whenever the connection list changes, since a new
+ * connection may displace an existing first match.
+ */
+static struct udp_connection *udp_demux_cache;
+
+/** Local address matching the most recently demultiplexed connection */
+static struct sockaddr_tcpip udp_demux_cache_local;
+
 /* Forward declatations */
 static struct interface_descriptor udp_xfer_desc;
 struct tcpip_protocol udp_protocol __tcpip_protocol;
@@ -112,6 +128,7 @@ static int udp_open_common ( struct interface *xfer,
 	 */
 	intf_plug_plug ( &udp->xfer, xfer );
 	list_add ( &udp->list, &udp_conns );
+	udp_demux_cache = NULL;
 	return 0;
 
  err:
@@ -158,6 +175,7 @@ static void udp_close ( struct udp_connection *udp, int rc ) {
 
 	/* Remove from list of connections and drop list's reference */
 	list_del ( &udp->list );
+	udp_demux_cache = NULL;
 	ref_put ( &udp->refcnt );
 
 	DBGC ( udp, "UDP %p closed\n", udp );
@@ -180,9 +198,11 @@ static int udp_tx ( struct udp_connection *udp, struct io_buffer *iobuf,
 	size_t len;
 	int rc;
 
-	/* Check we can accommodate the header */
-	if ( ( rc = iob_ensure_headroom ( iobuf,
-					  MAX_LL_NET_HEADER_LEN ) ) != 0 ) {
+	/* Check we can accommodate the complete header stack.  This
+	 * is a no-op (and hence guarantees a copy-free transmission)
+	 * for I/O buffers allocated via udp_xfer_alloc_iob().
+	 */
+	if ( ( rc = iob_ensure_headroom ( iobuf, UDP_MAX_HLEN ) ) != 0 ) {
 		free_iob ( iobuf );
 		return rc;
 	}
@@ -228,6 +248,13 @@ static struct udp_connection * udp_demux ( struct sockaddr_tcpip *local ) {
 	static const struct sockaddr_tcpip empty_sockaddr = { .pad = { 0, } };
 	struct udp_connection *udp;
 
+	/* Check most recently demultiplexed connection first */
+	if ( udp_demux_cache &&
+	     ( memcmp ( &udp_demux_cache_local, local,
+			sizeof ( udp_demux_cache_local ) ) == 0 ) ) {
+		return udp_demux_cache;
+	}
+
 	list_for_each_entry ( udp, &udp_conns, list ) {
 		if ( ( ( udp->local.st_family == local->st_family ) ||
 		       ( udp->local.st_family == 0 ) ) &&
@@ -237,6 +264,9 @@ static struct udp_connection * udp_demux ( struct sockaddr_tcpip *local ) {
 				  sizeof ( udp->local.pad ) ) == 0 ) ||
 		       ( memcmp ( udp->local.pad, empty_sockaddr.pad,
 				  sizeof ( udp->local.pad ) ) == 0 ) ) ) {
+			udp_demux_cache = udp;
+			memcpy ( &udp_demux_cache_local, local,
+				 sizeof ( udp_demux_cache_local ) );
 			return udp;
 		}
 	}
@@ -285,7 +315,7 @@ static int udp_rx ( struct io_buffer *iobuf,
 		rc = -EINVAL;
 		goto done;
 	}
-	if ( udphdr->chksum ) {
+	if ( udphdr->chksum && ( ! ( iobuf->flags & IOB_FL_CSUM_GOOD ) ) ) {
 		csum = tcpip_continue_chksum ( pshdr_csum, iobuf->data, ulen );
 		if ( csum != 0 ) {
 			DBG ( "UDP checksum incorrect (is %04x including "
@@ -345,18 +375,23 @@ struct tcpip_protocol udp_protocol __tcpip_protocol = {
  * @v udp		UDP connection
  * @v len		Payload size
  * @ret iobuf		I/O buffer, or NULL
+ *
+ * The returned I/O buffer has headroom reserved for the complete
+ * UDP, network-layer and link-layer header stack, so that
+ * transmitting the resulting datagram is a pure header push with no
+ * reallocation or copying at any layer.
  */
 static struct io_buffer * udp_xfer_alloc_iob ( struct udp_connection *udp,
 					       size_t len ) {
 	struct io_buffer *iobuf;
 
-	iobuf = alloc_iob ( MAX_LL_NET_HEADER_LEN + len );
+	iobuf = alloc_iob ( UDP_MAX_HLEN + len );
 	if ( ! iobuf ) {
 		DBGC ( udp, "UDP %p cannot allocate buffer of length %zd\n",
 		       udp, len );
 		return NULL;
 	}
-	iob_reserve ( iobuf, MAX_LL_NET_HEADER_LEN );
+	iob_reserve ( iobuf, UDP_MAX_HLEN );
 	return iobuf;
 }
 
@@ -48,6 +48,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/dhcppkt.h>
 #include <ipxe/dhcparch.h>
 #include <ipxe/features.h>
+#include <ipxe/timeline.h>
 #include <config/dhcp.h>
 
 /** @file
@@ -267,6 +268,10 @@ static void dhcp_free ( struct refcnt *refcnt ) {
  */
 static void dhcp_finished ( struct dhcp_session *dhcp, int rc ) {
 
+	/* Record boot timeline milestone */
+	if ( rc == 0 )
+		timeline_record ( "dhcp" );
+
 	/* Stop retry timer */
 	stop_timer ( &dhcp->timer );
 
@@ -537,6 +537,8 @@ enum dhcpv6_session_state_flags {
 	DHCPV6_RX_RECORD_SERVER_ID = 0x04,
 	/** Record received IPv6 address */
 	DHCPV6_RX_RECORD_IAADDR = 0x08,
+	/** Include rapid commit option within request */
+	DHCPV6_TX_RAPID_COMMIT = 0x10,
 };
 
 /** DHCPv6 request state */
@@ -552,8 +554,8 @@ static struct dhcpv6_session_state dhcpv6_request = {
 static struct dhcpv6_session_state dhcpv6_solicit = {
 	.tx_type = DHCPV6_SOLICIT,
 	.rx_type = DHCPV6_ADVERTISE,
-	.flags = ( DHCPV6_TX_IA_NA | DHCPV6_RX_RECORD_SERVER_ID |
-		   DHCPV6_RX_RECORD_IAADDR ),
+	.flags = ( DHCPV6_TX_IA_NA | DHCPV6_TX_RAPID_COMMIT |
+		   DHCPV6_RX_RECORD_SERVER_ID | DHCPV6_RX_RECORD_IAADDR ),
 	.next = &dhcpv6_request,
 };
 
@@ -688,6 +690,7 @@ static int dhcpv6_tx ( struct dhcpv6_session *dhcpv6 ) {
 	struct dhcpv6_duid_option *server_id;
 	struct dhcpv6_ia_na_option *ia_na;
 	struct dhcpv6_iaaddr_option *iaaddr;
+	struct dhcpv6_option *rapid;
 	struct dhcpv6_user_class_option *user_class;
 	struct dhcpv6_elapsed_time_option *elapsed;
 	struct dhcpv6_header *dhcphdr;
@@ -696,6 +699,7 @@ static int dhcpv6_tx ( struct dhcpv6_session *dhcpv6 ) {
 	size_t client_id_len;
 	size_t server_id_len;
 	size_t ia_na_len;
+	size_t rapid_len;
 	size_t user_class_string_len;
 	size_t user_class_len;
 	size_t elapsed_len;
@@ -714,13 +718,16 @@ static int dhcpv6_tx ( struct dhcpv6_session *dhcpv6 ) {
 	} else {
 		ia_na_len = 0;
 	}
+	rapid_len = ( ( dhcpv6->state->flags & DHCPV6_TX_RAPID_COMMIT ) ?
+		      sizeof ( *rapid ) : 0 );
 	user_class_string_len = dhcpv6_user_class ( NULL, 0 );
 	user_class_len = ( sizeof ( *user_class ) +
 			   sizeof ( user_class->user_class[0] ) +
 			   user_class_string_len );
 	elapsed_len = sizeof ( *elapsed );
 	total_len = ( sizeof ( *dhcphdr ) + client_id_len + server_id_len +
-		      ia_na_len + sizeof ( dhcpv6_request_options_data ) +
+		      ia_na_len + rapid_len +
+		      sizeof ( dhcpv6_request_options_data ) +
 		      user_class_len + elapsed_len );
 
 	/* Allocate packet */
@@ -772,6 +779,13 @@ static int dhcpv6_tx ( struct dhcpv6_session *dhcpv6 ) {
 		}
 	}
 
+	/* Construct rapid commit option, if applicable */
+	if ( rapid_len ) {
+		rapid = iob_put ( iobuf, rapid_len );
+		rapid->code = htons ( DHCPV6_RAPID_COMMIT );
+		rapid->len = htons ( 0 );
+	}
+
 	/* Construct fixed request options */
 	options = iob_put ( iobuf, sizeof ( dhcpv6_request_options_data ) );
 	memcpy ( options, dhcpv6_request_options_data,
@@ -846,6 +860,7 @@ static int dhcpv6_rx ( struct dhcpv6_session *dhcpv6,
 	struct dhcpv6_header *dhcphdr = iobuf->data;
 	struct dhcpv6_option_list options;
 	const union dhcpv6_any_option *option;
+	int rapid = 0;
 	int rc;
 
 	/* Sanity checks */
@@ -888,13 +903,27 @@ static int dhcpv6_rx ( struct dhcpv6_session *dhcpv6,
 		goto done;
 	}
 
-	/* Check message type */
+	/* Check message type.  A server supporting rapid commit may
+	 * respond to our SOLICIT with an immediate REPLY containing a
+	 * rapid commit option, completing the exchange in a single
+	 * round trip.
+	 */
 	if ( dhcphdr->type != dhcpv6->state->rx_type ) {
-		DBGC ( dhcpv6, "DHCPv6 %s received %s while expecting %s\n",
-		       dhcpv6->netdev->name, dhcpv6_type_name ( dhcphdr->type ),
-		       dhcpv6_type_name ( dhcpv6->state->rx_type ) );
-		rc = -ENOTTY;
-		goto done;
+		if ( ( dhcpv6->state->flags & DHCPV6_TX_RAPID_COMMIT ) &&
+		     ( dhcphdr->type == DHCPV6_REPLY ) &&
+		     dhcpv6_option ( &options, DHCPV6_RAPID_COMMIT ) ) {
+			DBGC ( dhcpv6, "DHCPv6 %s received rapid commit %s\n",
+			       dhcpv6->netdev->name,
+			       dhcpv6_type_name ( dhcphdr->type ) );
+			rapid = 1;
+		} else {
+			DBGC ( dhcpv6, "DHCPv6 %s received %s while expecting "
+			       "%s\n", dhcpv6->netdev->name,
+			       dhcpv6_type_name ( dhcphdr->type ),
+			       dhcpv6_type_name ( dhcpv6->state->rx_type ) );
+			rc = -ENOTTY;
+			goto done;
+		}
 	}
 
 	/* Fetch status code, if present */
@@ -946,7 +975,7 @@ static int dhcpv6_rx ( struct dhcpv6_session *dhcpv6,
 	}
 
 	/* Transition to next state, if applicable */
-	if ( dhcpv6->state->next ) {
+	if ( dhcpv6->state->next && ! rapid ) {
 		dhcpv6_set_state ( dhcpv6, dhcpv6->state->next );
 		rc = 0;
 		goto done;
@@ -29,10 +29,13 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 #include <ctype.h>
 #include <errno.h>
 #include <byteswap.h>
+#include <ipxe/list.h>
+#include <ipxe/timer.h>
 #include <ipxe/refcnt.h>
 #include <ipxe/iobuf.h>
 #include <ipxe/xfer.h>
@@ -448,6 +451,116 @@ static const char * dns_type ( uint16_t type ) {
 	}
 }
 
+/******************************************************************************
+ *
+ * Lookup result cache
+ *
+ ******************************************************************************
+ */
+
+/** A cached DNS lookup result */
+struct dns_cache_entry {
+	/** List of cached lookup results */
+	struct list_head list;
+	/** Expiry time (as a currticks() timestamp) */
+	unsigned long expiry;
+	/** Resolved address (only the family and address are used) */
+	union {
+		struct sockaddr sa;
+		struct sockaddr_in sin;
+		struct sockaddr_in6 sin6;
+	} address;
+	/** Looked-up name (NUL-terminated) */
+	char name[0];
+};
+
+/** List of cached DNS lookup results */
+static LIST_HEAD ( dns_cache );
+
+/**
+ * Find cached DNS lookup result
+ *
+ * @v name		Name
+ * @ret entry		Cached lookup result, or NULL if not found
+ *
+ * Expired entries are removed from the cache as they are encountered.
+ */
+static struct dns_cache_entry * dns_cache_find ( const char *name ) {
+	struct dns_cache_entry *entry;
+	struct dns_cache_entry *tmp;
+
+	list_for_each_entry_safe ( entry, tmp, &dns_cache, list ) {
+
+		/* Discard expired entries */
+		if ( ( ( signed long ) ( currticks() - entry->expiry ) ) >= 0 ){
+			DBGC ( &dns_cache, "DNS cache expired %s\n",
+			       entry->name );
+			list_del ( &entry->list );
+			free ( entry );
+			continue;
+		}
+
+		/* Check for matching name (case-insensitively) */
+		if ( strcasecmp ( name, entry->name ) == 0 )
+			return entry;
+	}
+
+	return NULL;
+}
+
+/**
+ * Add DNS lookup result to cache
+ *
+ * @v name		Name
+ * @v sa		Resolved address
+ * @v ttl		Time to live (in seconds)
+ *
+ * Allocation failures are ignored, since the cache is only ever an
+ * optimisation.
+ */
+static void dns_cache_add ( const char *name, struct sockaddr *sa,
+			    unsigned long ttl ) {
+	struct dns_cache_entry *entry;
+
+	/* Remove any existing entry for this name */
+	if ( ( entry = dns_cache_find ( name ) ) != NULL ) {
+		list_del ( &entry->list );
+		free ( entry );
+	}
+
+	/* Allocate and initialise entry */
+	entry = zalloc ( sizeof ( *entry ) + strlen ( name ) + 1 /* NUL */ );
+	if ( ! entry )
+		return;
+	entry->expiry = ( currticks() + ( ttl * TICKS_PER_SEC ) );
+	memcpy ( &entry->address.sa, sa, sizeof ( entry->address.sa ) );
+	strcpy ( entry->name, name );
+	list_add ( &entry->list, &dns_cache );
+
+	DBGC ( &dns_cache, "DNS cache added %s (TTL %ld)\n", name, ttl );
+}
+
+/**
+ * Discard all cached DNS lookup results
+ *
+ */
+static void dns_cache_flush ( void ) {
+	struct dns_cache_entry *entry;
+	struct dns_cache_entry *tmp;
+
+	list_for_each_entry_safe ( entry, tmp, &dns_cache, list ) {
+		list_del ( &entry->list );
+		free ( entry );
+	}
+}
+
+/******************************************************************************
+ *
+ * DNS requests
+ *
+ ******************************************************************************
+ */
+
 /** A DNS request */
 struct dns_request {
 	/** Reference counter */
@@ -490,6 +603,12 @@ struct dns_request {
 	unsigned int index;
 	/** Recursion counter */
 	unsigned int recursion;
+	/** Originally requested name (NUL-terminated) */
+	const char *hostname;
+	/** Time to live of resolved address (in seconds) */
+	unsigned long ttl;
+	/** Request was answered from the cache */
+	int cached;
 };
 
 /**
@@ -519,6 +638,10 @@ static void dns_resolved ( struct dns_request *dns ) {
 	DBGC ( dns, "DNS %p found address %s\n",
 	       dns, sock_ntoa ( &dns->address.sa ) );
 
+	/* Record result in cache, unless it came from the cache */
+	if ( ! dns->cached )
+		dns_cache_add ( dns->hostname, &dns->address.sa, dns->ttl );
+
 	/* Return resolved address */
 	resolv_done ( &dns->resolv, &dns->address.sa );
 
@@ -648,6 +771,12 @@ static void dns_timer_expired ( struct retry_timer *timer, int fail ) {
 		return;
 	}
 
+	/* Complete immediately if answered from the cache */
+	if ( dns->cached ) {
+		dns_resolved ( dns );
+		return;
+	}
+
 	/* Move to next DNS server if this is a retransmission */
 	if ( dns->buf.query.id )
 		dns->index++;
@@ -777,6 +906,7 @@ static int dns_xfer_deliver ( struct dns_request *dns,
 			memcpy ( &dns->address.sin6.sin6_addr,
 				 &rr->aaaa.in6_addr,
 				 sizeof ( dns->address.sin6.sin6_addr ) );
+			dns->ttl = ntohl ( rr->common.ttl );
 			dns_resolved ( dns );
 			rc = 0;
 			goto done;
@@ -792,6 +922,7 @@ static int dns_xfer_deliver ( struct dns_request *dns,
 			}
 			dns->address.sin.sin_family = AF_INET;
 			dns->address.sin.sin_addr = rr->a.in_addr;
+			dns->ttl = ntohl ( rr->common.ttl );
 			dns_resolved ( dns );
 			rc = 0;
 			goto done;
@@ -975,13 +1106,19 @@ static struct interface_descriptor dns_resolv_desc =
 static int dns_resolv ( struct interface *resolv,
 			const char *name, struct sockaddr *sa ) {
 	struct dns_request *dns;
+	struct dns_cache_entry *entry;
 	struct dns_header *query;
 	size_t search_len;
+	size_t hostname_len;
+	char *hostname;
 	int name_len;
 	int rc;
 
-	/* Fail immediately if no DNS servers */
-	if ( dns_count == 0 ) {
+	/* Check for a cached lookup result */
+	entry = dns_cache_find ( name );
+
+	/* Fail immediately if no DNS servers and no cached result */
+	if ( ( entry == NULL ) && ( dns_count == 0 ) ) {
 		DBG ( "DNS not attempting to resolve \"%s\": "
 		      "no DNS servers\n", name );
 		rc = -ENXIO_NO_NAMESERVER;
@@ -992,7 +1129,8 @@ static int dns_resolv ( struct interface *resolv,
 	search_len = ( strchr ( name, '.' ) ? 0 : dns_search.len );
 
 	/* Allocate DNS structure */
-	dns = zalloc ( sizeof ( *dns ) + search_len );
+	hostname_len = ( strlen ( name ) + 1 /* NUL */ );
+	dns = zalloc ( sizeof ( *dns ) + search_len + hostname_len );
 	if ( ! dns ) {
 		rc = -ENOMEM;
 		goto err_alloc_dns;
@@ -1005,6 +1143,24 @@ static int dns_resolv ( struct interface *resolv,
 	dns->search.data = ( ( ( void * ) dns ) + sizeof ( *dns ) );
 	dns->search.len = search_len;
 	memcpy ( dns->search.data, dns_search.data, search_len );
+	hostname = ( ( ( void * ) dns ) + sizeof ( *dns ) + search_len );
+	strcpy ( hostname, name );
+	dns->hostname = hostname;
+
+	/* Use cached lookup result, if available */
+	if ( entry ) {
+		DBGC ( dns, "DNS %p using cached address %s for %s\n", dns,
+		       sock_ntoa ( &entry->address.sa ), name );
+		dns->address.sa.sa_family = entry->address.sa.sa_family;
+		if ( entry->address.sa.sa_family == AF_INET6 ) {
+			memcpy ( &dns->address.sin6.sin6_addr,
+				 &entry->address.sin6.sin6_addr,
+				 sizeof ( dns->address.sin6.sin6_addr ) );
+		} else {
+			dns->address.sin.sin_addr = entry->address.sin.sin_addr;
+		}
+		dns->cached = 1;
+	}
 
 	/* Determine initial query type */
 	dns->qtype = ( ( dns6.count != 0 ) ?
@@ -1027,12 +1183,14 @@ static int dns_resolv ( struct interface *resolv,
 	if ( ( rc = dns_question ( dns ) ) != 0 )
 		goto err_question;
 
-	/* Open UDP connection */
-	if ( ( rc = xfer_open_socket ( &dns->socket, SOCK_DGRAM,
-				       NULL, NULL ) ) != 0 ) {
-		DBGC ( dns, "DNS %p could not open socket: %s\n",
-		       dns, strerror ( rc ) );
-		goto err_open_socket;
+	/* Open UDP connection (unless completing from the cache) */
+	if ( ! dns->cached ) {
+		if ( ( rc = xfer_open_socket ( &dns->socket, SOCK_DGRAM,
+					       NULL, NULL ) ) != 0 ) {
+			DBGC ( dns, "DNS %p could not open socket: %s\n",
+			       dns, strerror ( rc ) );
+			goto err_open_socket;
+		}
 	}
 
 	/* Start timer to trigger first packet */
@@ -1147,6 +1305,11 @@ const struct setting dnssl_setting __setting ( SETTING_IP_EXTRA, dnssl ) = {
 static void apply_dns_servers ( void ) {
 	int len;
 
+	/* Discard cached lookup results, which may have been obtained
+	 * from servers that are no longer configured.
+	 */
+	dns_cache_flush();
+
 	/* Free existing server addresses */
 	free ( dns4.data );
 	free ( dns6.data );
@@ -35,6 +35,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/retry.h>
 #include <ipxe/timer.h>
 #include <ipxe/time.h>
+#include <ipxe/in.h>
 #include <ipxe/tcpip.h>
 #include <ipxe/dhcp.h>
 #include <ipxe/settings.h>
@@ -283,3 +284,56 @@ const struct setting ntp_setting __setting ( SETTING_IP4_EXTRA, ntp ) = {
 	.tag = DHCP_NTP_SERVERS,
 	.type = &setting_type_ipv4,
 };
+
+/** Background NTP client job interface operations */
+static struct interface_operation ntp_background_operations[] = {};
+
+/** Background NTP client job interface descriptor */
+static struct interface_descriptor ntp_background_desc =
+	INTF_DESC_PURE ( ntp_background_operations );
+
+/** Background NTP client job interface */
+static struct interface ntp_background = INTF_INIT ( ntp_background_desc );
+
+/** Most recently applied NTP server */
+static struct in_addr ntp_server;
+
+/**
+ * Apply NTP settings
+ *
+ * @ret rc		Return status code
+ */
+static int apply_ntp_settings ( void ) {
+	struct in_addr server;
+	int rc;
+
+	/* Do nothing unless an NTP server is configured */
+	if ( fetch_ipv4_setting ( NULL, &ntp_setting, &server ) < 0 )
+		return 0;
+
+	/* Do nothing unless NTP server has changed */
+	if ( server.s_addr == ntp_server.s_addr )
+		return 0;
+	ntp_server = server;
+
+	/* Start NTP client in the background, so that the clock
+	 * adjustment is (usually) already in place by the time that
+	 * anything requiring an accurate time (such as certificate
+	 * validation) runs, without ever blocking the boot on an NTP
+	 * round trip or timeout.
+	 */
+	intf_restart ( &ntp_background, 0 );
+	if ( ( rc = start_ntp ( &ntp_background,
+				inet_ntoa ( server ) ) ) != 0 ) {
+		DBG ( "NTP could not start background client: %s\n",
+		      strerror ( rc ) );
+		return rc;
+	}
+
+	return 0;
+}
+
+/** NTP settings applicator */
+struct settings_applicator ntp_applicator __settings_applicator = {
+	.apply = apply_ntp_settings,
+};
@@ -104,16 +104,33 @@ FEATURE ( FEATURE_PROTOCOL, "SLAM", DHCP_EB_FEATURE_SLAM, 1 );
 /** Maximum number of blocks to request per NACK
  *
  * This is a policy decision equivalent to selecting a TCP window
- * size.
+ * size.  It may be overridden at build time for tuning to a specific
+ * network.
  */
-#define SLAM_MAX_BLOCKS_PER_NACK 4
+#ifndef SLAM_MAX_BLOCKS_PER_NACK
+#define SLAM_MAX_BLOCKS_PER_NACK 256
+#endif
+
+/** Maximum number of missing-block ranges to describe per NACK
+ *
+ * The received-blocks bitmap can become arbitrarily fragmented under
+ * packet loss.  We place an upper limit on the number of ranges that
+ * we will describe in a single NACK, both to bound the NACK packet
+ * size and to bound the cost of scanning the bitmap.
+ */
+#ifndef SLAM_MAX_RANGES_PER_NACK
+#define SLAM_MAX_RANGES_PER_NACK 16
+#endif
 
 /** Maximum SLAM NACK length
  *
- * We only ever send a NACK for a single range of up to @c
- * SLAM_MAX_BLOCKS_PER_NACK blocks.
+ * Each range is encoded as a pair of variable-length values (number
+ * of consecutive received packets, number of consecutive missing
+ * packets), followed by a terminating NUL.
  */
-#define SLAM_MAX_NACK_LEN ( 7 /* block */ + 7 /* #blocks */ + 1 /* NUL */ )
+#define SLAM_MAX_NACK_LEN \
+	( SLAM_MAX_RANGES_PER_NACK * ( 7 /* #received */ + 7 /* #missing */ ) \
+	  + 1 /* NUL */ )
 
 /** SLAM slave timeout */
 #define SLAM_SLAVE_TIMEOUT ( 1 * TICKS_PER_SEC )
@@ -253,8 +270,10 @@ static int slam_put_value ( struct slam_request *slam,
  */
 static int slam_tx_nack ( struct slam_request *slam ) {
 	struct io_buffer *iobuf;
-	unsigned long first_block;
-	unsigned long num_blocks;
+	unsigned long block;
+	unsigned long run;
+	unsigned long requested;
+	unsigned int ranges;
 	uint8_t *nul;
 	int rc;
 
@@ -270,34 +289,55 @@ static int slam_tx_nack ( struct slam_request *slam ) {
 		goto err_alloc;
 	}
 
-	/* Construct NACK.  We always request only a single packet;
-	 * this allows us to force multicast-TFTP-style flow control
-	 * on the SLAM server, which will otherwise just blast the
-	 * data out as fast as it can.  On a gigabit network, without
-	 * RX checksumming, this would inevitably cause packet drops.
+	/* Construct NACK as a run-length-encoded representation of
+	 * the received-blocks bitmap, requesting up to
+	 * SLAM_MAX_BLOCKS_PER_NACK blocks in total.  Capping the
+	 * total number of requested blocks allows us to force
+	 * multicast-TFTP-style flow control on the SLAM server, which
+	 * will otherwise just blast the data out as fast as it can.
+	 * Describing multiple missing ranges per NACK allows loss
+	 * recovery to proceed in parallel with the ongoing transfer,
+	 * rather than requiring a separate NACK round trip per
+	 * contiguous range.
 	 */
-	first_block = bitmap_first_gap ( &slam->bitmap );
-	for ( num_blocks = 1 ; ; num_blocks++ ) {
-		if ( num_blocks >= SLAM_MAX_BLOCKS_PER_NACK )
-			break;
-		if ( ( first_block + num_blocks ) >= slam->num_blocks )
-			break;
-		if ( bitmap_test ( &slam->bitmap,
-				   ( first_block + num_blocks ) ) )
+	block = 0;
+	requested = 0;
+	for ( ranges = 0 ; ranges < SLAM_MAX_RANGES_PER_NACK ; ranges++ ) {
+		/* Measure length of contiguous received run */
+		for ( run = 0 ; ( block + run ) < slam->num_blocks ; run++ ) {
+			if ( ! bitmap_test ( &slam->bitmap, ( block + run ) ) )
+				break;
+		}
+		/* Stop if no missing blocks remain, or if we have
+		 * already requested a full window.
+		 */
+		if ( ( ( block + run ) >= slam->num_blocks ) ||
+		     ( requested >= SLAM_MAX_BLOCKS_PER_NACK ) )
 			break;
+		if ( ( rc = slam_put_value ( slam, iobuf, run ) ) != 0 )
+			goto err_put_value;
+		block += run;
+		/* Measure length of contiguous missing run, limited
+		 * by the remaining window.
+		 */
+		for ( run = 0 ; ( block + run ) < slam->num_blocks ; run++ ) {
+			if ( bitmap_test ( &slam->bitmap, ( block + run ) ) )
+				break;
+			if ( ( requested + run ) >= SLAM_MAX_BLOCKS_PER_NACK )
+				break;
+		}
+		if ( ( rc = slam_put_value ( slam, iobuf, run ) ) != 0 )
+			goto err_put_value;
+		block += run;
+		requested += run;
 	}
-	if ( first_block ) {
-		DBGCP ( slam, "SLAM %p transmitting NACK for blocks "
-			"%ld-%ld\n", slam, first_block,
-			( first_block + num_blocks - 1 ) );
+	if ( bitmap_first_gap ( &slam->bitmap ) ) {
+		DBGCP ( slam, "SLAM %p transmitting NACK for %ld blocks in "
+			"%d ranges\n", slam, requested, ranges );
 	} else {
-		DBGC ( slam, "SLAM %p transmitting initial NACK for blocks "
-		       "0-%ld\n", slam, ( num_blocks - 1 ) );
+		DBGC ( slam, "SLAM %p transmitting initial NACK for %ld "
+		       "blocks\n", slam, requested );
 	}
-	if ( ( rc = slam_put_value ( slam, iobuf, first_block ) ) != 0 )
-		goto err_put_value;
-	if ( ( rc = slam_put_value ( slam, iobuf, num_blocks ) ) != 0 )
-		goto err_put_value;
 	nul = iob_put ( iobuf, 1 );
 	*nul = 0;
 
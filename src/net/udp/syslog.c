@@ -31,9 +31,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 #include <ctype.h>
 #include <byteswap.h>
+#include <ipxe/iobuf.h>
+#include <ipxe/process.h>
 #include <ipxe/xfer.h>
 #include <ipxe/open.h>
 #include <ipxe/tcpip.h>
@@ -121,6 +124,31 @@ static char syslog_buffer[SYSLOG_BUFSIZE];
 /** Syslog severity */
 static unsigned int syslog_severity = SYSLOG_DEFAULT_SEVERITY;
 
+/** Size of syslog transmit ring buffer
+ *
+ * Must be a power of two.  Completed log lines are appended to the
+ * ring by the console output path and drained in batches by the
+ * syslog transmit process, so that logging never blocks the code
+ * path that generated the log message.
+ */
+#define SYSLOG_RING_SIZE 4096
+
+/** Syslog transmit ring buffer
+ *
+ * Each entry comprises a single severity byte followed by a
+ * NUL-terminated message line.
+ */
+static char syslog_ring[SYSLOG_RING_SIZE];
+
+/** Syslog transmit ring buffer producer counter */
+static unsigned int syslog_ring_prod;
+
+/** Syslog transmit ring buffer consumer counter */
+static unsigned int syslog_ring_cons;
+
+/** Number of messages dropped due to a full transmit ring buffer */
+static unsigned long syslog_dropped;
+
 /**
  * Handle ANSI set syslog priority (private sequence)
  *
@@ -162,7 +190,8 @@ static int syslog_entered;
  * @v character		Character to be printed
  */
 static void syslog_putchar ( int character ) {
-	int rc;
+	size_t len;
+	unsigned int i;
 
 	/* Ignore if we are already mid-logging */
 	if ( syslog_entered )
@@ -172,20 +201,141 @@ static void syslog_putchar ( int character ) {
 	if ( line_putchar ( &syslog_line, character ) == 0 )
 		return;
 
-	/* Guard against re-entry */
+	/* Drop message (and record the drop) if the transmit ring
+	 * has insufficient space.  Dropping is preferable to either
+	 * blocking the code path that generated the message, or
+	 * transmitting synchronously from within the console output
+	 * path.
+	 */
+	len = ( 1 /* severity */ + strlen ( syslog_buffer ) + 1 /* NUL */ );
+	if ( ( syslog_ring_prod - syslog_ring_cons + len ) >
+	     sizeof ( syslog_ring ) ) {
+		syslog_dropped++;
+		return;
+	}
+
+	/* Append severity and message line to transmit ring */
+	syslog_ring[ syslog_ring_prod++ % sizeof ( syslog_ring ) ] =
+		syslog_severity;
+	for ( i = 0 ; i < ( len - 1 /* severity */ ) ; i++ ) {
+		syslog_ring[ syslog_ring_prod++ % sizeof ( syslog_ring ) ] =
+			syslog_buffer[i];
+	}
+}
+
+/**
+ * Format syslog message
+ *
+ * @v severity		Severity
+ * @v message		Message
+ * @v buf		Buffer
+ * @v len		Length of buffer
+ * @ret len		Length of formatted message (may exceed buffer length)
+ */
+static size_t syslog_format ( unsigned int severity, const char *message,
+			      char *buf, size_t len ) {
+	const char *hostname = ( syslog_hostname ? syslog_hostname : "" );
+	const char *domain = ( ( hostname[0] && syslog_domain ) ?
+			       syslog_domain : "" );
+
+	return snprintf ( buf, len, "<%d>%s%s%s%sipxe: %s\n",
+			  SYSLOG_PRIORITY ( SYSLOG_DEFAULT_FACILITY,
+					    severity ), hostname,
+			  ( domain[0] ? "." : "" ), domain,
+			  ( hostname[0] ? " " : "" ), message );
+}
+
+/**
+ * Transmit a batch of syslog messages
+ *
+ * @v process		Syslog transmit process
+ */
+static void syslog_step ( struct process *process __unused ) {
+	struct io_buffer *iobuf;
+	char line[ sizeof ( syslog_buffer ) ];
+	unsigned int severity;
+	unsigned int cons;
+	unsigned int i;
+	size_t window;
+	size_t len;
+	char c;
+	int rc;
+
+	/* Do nothing unless messages are pending */
+	if ( syslog_ring_cons == syslog_ring_prod )
+		return;
+
+	/* Wait until the syslog connection can accept a datagram */
+	window = xfer_window ( &syslogger );
+	if ( ! window )
+		return;
+
+	/* Guard against re-entry via console output generated while
+	 * transmitting.
+	 */
 	syslog_entered = 1;
 
-	/* Send log message */
-	if ( ( rc = syslog_send ( &syslogger, syslog_severity,
-				  syslog_buffer, "" ) ) != 0 ) {
-		DBG ( "SYSLOG could not send log message: %s\n",
+	/* Allocate I/O buffer */
+	iobuf = xfer_alloc_iob ( &syslogger, window );
+	if ( ! iobuf )
+		goto out;
+
+	/* Report dropped messages, if any */
+	if ( syslog_dropped ) {
+		snprintf ( line, sizeof ( line ), "lost %ld messages",
+			   syslog_dropped );
+		len = syslog_format ( SYSLOG_DEFAULT_SEVERITY, line,
+				      iobuf->tail, iob_tailroom ( iobuf ) );
+		if ( len < iob_tailroom ( iobuf ) ) {
+			iob_put ( iobuf, len );
+			syslog_dropped = 0;
+		}
+	}
+
+	/* Add as many pending messages as will fit in one datagram */
+	while ( syslog_ring_cons != syslog_ring_prod ) {
+
+		/* Copy severity and message line out of ring */
+		cons = syslog_ring_cons;
+		severity = ( ( unsigned char )
+			     syslog_ring[ cons++ % sizeof ( syslog_ring ) ] );
+		i = 0;
+		do {
+			c = syslog_ring[ cons++ % sizeof ( syslog_ring ) ];
+			line[i++] = c;
+		} while ( c && ( i < sizeof ( line ) ) );
+		line[ i - 1 ] = '\0';
+
+		/* Format message into I/O buffer */
+		len = syslog_format ( severity, line, iobuf->tail,
+				      iob_tailroom ( iobuf ) );
+		if ( len >= iob_tailroom ( iobuf ) ) {
+			/* Leave message for a subsequent batch unless
+			 * it could never fit, in which case truncate.
+			 */
+			if ( iob_len ( iobuf ) != 0 )
+				break;
+			len = ( iob_tailroom ( iobuf ) - 1 );
+		}
+		iob_put ( iobuf, len );
+		syslog_ring_cons = cons;
+	}
+
+	/* Transmit batch */
+	if ( ( rc = xfer_deliver_iob ( &syslogger,
+				       iob_disown ( iobuf ) ) ) != 0 ) {
+		DBG ( "SYSLOG could not send log messages: %s\n",
 		      strerror ( rc ) );
 	}
 
+ out:
 	/* Clear re-entry flag */
 	syslog_entered = 0;
 }
 
+/** Syslog transmit process */
+PERMANENT_PROCESS ( syslog_process, syslog_step );
+
 /** Syslog console driver */
 struct console_driver syslog_console __console_driver = {
 	.putchar = syslog_putchar,
@@ -37,6 +37,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/open.h>
 #include <ipxe/uri.h>
 #include <ipxe/tcpip.h>
+#include <ipxe/udp.h>
 #include <ipxe/retry.h>
 #include <ipxe/features.h>
 #include <ipxe/bitmap.h>
@@ -77,6 +78,9 @@ FEATURE ( FEATURE_PROTOCOL, "TFTP", DHCP_EB_FEATURE_TFTP, 1 );
 #define EINVAL_MC_INVALID_PORT __einfo_error ( EINFO_EINVAL_MC_INVALID_PORT )
 #define EINFO_EINVAL_MC_INVALID_PORT __einfo_uniqify \
 	( EINFO_EINVAL, 0x07, "Invalid multicast port" )
+#define EINVAL_WINDOWSIZE __einfo_error ( EINFO_EINVAL_WINDOWSIZE )
+#define EINFO_EINVAL_WINDOWSIZE __einfo_uniqify \
+	( EINFO_EINVAL, 0x08, "Invalid windowsize" )
 #define ENOENT_NOT_FOUND __einfo_error ( EINFO_ENOENT_NOT_FOUND )
 #define EINFO_ENOENT_NOT_FOUND __einfo_uniqify \
 	( EINFO_ENOENT, 0x01, "Not found" )
@@ -106,6 +110,27 @@ struct tftp_request {
 	 * this will default to 512).
 	 */
 	unsigned int blksize;
+	/** Maximum block size to request
+	 *
+	 * This starts out at the protocol maximum, and is reduced to
+	 * the path MTU limit if data blocks are observed to have
+	 * required IP-layer fragmentation and reassembly.
+	 */
+	size_t max_blksize;
+	/** Data transfer window size
+	 *
+	 * This is the "windowsize" option (defined in RFC 7440)
+	 * negotiated with the TFTP server.  (If the TFTP server does
+	 * not support TFTP options, this will default to 1.)
+	 */
+	unsigned int windowsize;
+	/** Number of blocks acknowledged so far
+	 *
+	 * This is the block number carried in our most recent ACK,
+	 * which is equal to the number of contiguously received
+	 * blocks at the time that the ACK was sent.
+	 */
+	unsigned int acked;
 	/** File size
 	 *
 	 * This is the value returned in the "tsize" option from the
@@ -357,7 +382,8 @@ static int tftp_send_rrq ( struct tftp_request *tftp ) {
 	len = ( sizeof ( *rrq ) + strlen ( path ) + 1 /* NUL */
 		+ 5 + 1 /* "octet" + NUL */
 		+ 7 + 1 + 5 + 1 /* "blksize" + NUL + ddddd + NUL */
-		+ 5 + 1 + 1 + 1 /* "tsize" + NUL + "0" + NUL */ 
+		+ 5 + 1 + 1 + 1 /* "tsize" + NUL + "0" + NUL */
+		+ 10 + 1 + 5 + 1 /* "windowsize" + NUL + ddddd + NUL */
 		+ 9 + 1 + 1 /* "multicast" + NUL + NUL */ );
 	iobuf = xfer_alloc_iob ( &tftp->socket, len );
 	if ( ! iobuf )
@@ -365,8 +391,8 @@ static int tftp_send_rrq ( struct tftp_request *tftp ) {
 
 	/* Determine block size */
 	blksize = xfer_window ( &tftp->xfer );
-	if ( blksize > TFTP_MAX_BLKSIZE )
-		blksize = TFTP_MAX_BLKSIZE;
+	if ( blksize > tftp->max_blksize )
+		blksize = tftp->max_blksize;
 
 	/* Build request */
 	rrq = iob_put ( iobuf, sizeof ( *rrq ) );
@@ -379,6 +405,13 @@ static int tftp_send_rrq ( struct tftp_request *tftp ) {
 					    "blksize%c%zd%ctsize%c0",
 					    0, blksize, 0, 0 ) + 1 );
 	}
+	if ( ( tftp->flags & TFTP_FL_RRQ_SIZES ) &&
+	     ( ! ( tftp->flags & TFTP_FL_RRQ_MULTICAST ) ) ) {
+		iob_put ( iobuf, snprintf ( iobuf->tail,
+					    iob_tailroom ( iobuf ),
+					    "windowsize%c%d", 0,
+					    TFTP_MAX_WINDOWSIZE ) + 1 );
+	}
 	if ( tftp->flags & TFTP_FL_RRQ_MULTICAST ) {
 		iob_put ( iobuf, snprintf ( iobuf->tail,
 					    iob_tailroom ( iobuf ),
@@ -409,6 +442,9 @@ static int tftp_send_ack ( struct tftp_request *tftp ) {
 	block = bitmap_first_gap ( &tftp->bitmap );
 	DBGC2 ( tftp, "TFTP %p sending ACK for block %d\n", tftp, block );
 
+	/* Record acknowledged block count */
+	tftp->acked = block;
+
 	/* Allocate buffer */
 	iobuf = xfer_alloc_iob ( &tftp->socket, sizeof ( *ack ) );
 	if ( ! iobuf )
@@ -533,6 +569,8 @@ static void tftp_timer_expired ( struct retry_timer *timer, int fail ) {
 				bitmap_free ( &tftp->bitmap );
 				memset ( &tftp->bitmap, 0,
 					 sizeof ( tftp->bitmap ) );
+				tftp->windowsize = TFTP_DEFAULT_WINDOWSIZE;
+				tftp->acked = 0;
 
 				/* Reopen on standard TFTP port */
 				tftp->port = TFTP_PORT;
@@ -577,6 +615,28 @@ static int tftp_process_blksize ( struct tftp_request *tftp, char *value ) {
 	return 0;
 }
 
+/**
+ * Process TFTP "windowsize" option
+ *
+ * @v tftp		TFTP connection
+ * @v value		Option value
+ * @ret rc		Return status code
+ */
+static int tftp_process_windowsize ( struct tftp_request *tftp, char *value ) {
+	char *end;
+
+	tftp->windowsize = strtoul ( value, &end, 10 );
+	if ( ( *end ) || ( tftp->windowsize < 1 ) ||
+	     ( tftp->windowsize > TFTP_MAX_WINDOWSIZE ) ) {
+		DBGC ( tftp, "TFTP %p got invalid windowsize \"%s\"\n",
+		       tftp, value );
+		return -EINVAL_WINDOWSIZE;
+	}
+	DBGC ( tftp, "TFTP %p windowsize=%d\n", tftp, tftp->windowsize );
+
+	return 0;
+}
+
 /**
  * Process TFTP "tsize" option
  *
@@ -681,6 +741,7 @@ struct tftp_option {
 /** Recognised TFTP options */
 static struct tftp_option tftp_options[] = {
 	{ "blksize", tftp_process_blksize },
+	{ "windowsize", tftp_process_windowsize },
 	{ "tsize", tftp_process_tsize },
 	{ "multicast", tftp_process_multicast },
 	{ NULL, NULL }
@@ -785,6 +846,30 @@ static int tftp_rx_oack ( struct tftp_request *tftp, void *buf, size_t len ) {
 	return rc;
 }
 
+/**
+ * Calculate maximum unfragmented block size
+ *
+ * @v tftp		TFTP connection
+ * @ret blksize		Largest block size avoiding fragmentation, or zero
+ *
+ * Calculate the largest data block that fits within the path MTU to
+ * the server, so that data blocks do not incur IP-layer fragmentation
+ * and reassembly costs on receive.
+ */
+static size_t tftp_mtu_blksize ( struct tftp_request *tftp ) {
+	size_t mtu;
+
+	/* The path MTU is unknown until we have a peer address */
+	if ( ! tftp->peer.st_family )
+		return 0;
+	mtu = tcpip_mtu ( &tftp->peer );
+	if ( ! mtu )
+		return 0;
+
+	return ( mtu - sizeof ( struct udp_header ) -
+		 sizeof ( struct tftp_data ) );
+}
+
 /**
  * Receive DATA
  *
@@ -798,9 +883,12 @@ static int tftp_rx_data ( struct tftp_request *tftp,
 			  struct io_buffer *iobuf ) {
 	struct tftp_data *data = iobuf->data;
 	struct xfer_metadata meta;
-	unsigned int block;
+	unsigned int expected;
+	unsigned int first_gap;
+	int block;
 	off_t offset;
 	size_t data_len;
+	size_t limit;
 	int rc;
 
 	/* Sanity check */
@@ -811,14 +899,21 @@ static int tftp_rx_data ( struct tftp_request *tftp,
 		goto done;
 	}
 
-	/* Calculate block number */
-	block = ( ( bitmap_first_gap ( &tftp->bitmap ) + 1 ) & ~0xffff );
-	if ( data->block == 0 && block == 0 ) {
-		DBGC ( tftp, "TFTP %p received data block 0\n", tftp );
+	/* Calculate block number.  The raw block number is only
+	 * sixteen bits wide: interpret it as the value closest to the
+	 * next expected block number, to support files longer than
+	 * 65536 blocks and windows spanning a numbering wraparound.
+	 */
+	expected = ( bitmap_first_gap ( &tftp->bitmap ) + 1 );
+	block = ( expected +
+		  ( ( int16_t ) ( ntohs ( data->block ) - expected ) ) );
+	if ( block <= 0 ) {
+		DBGC ( tftp, "TFTP %p received data block %d\n",
+		       tftp, ntohs ( data->block ) );
 		rc = -EINVAL;
 		goto done;
 	}
-	block += ( ntohs ( data->block ) - 1 );
+	block--;	/* Convert to zero-based block number */
 
 	/* Stop profiling server turnaround if applicable */
 	if ( block )
@@ -835,6 +930,28 @@ static int tftp_rx_data ( struct tftp_request *tftp,
 		goto done;
 	}
 
+	/* Renegotiate a smaller block size if this block must have
+	 * been fragmented and reassembled in transit.  The block size
+	 * cannot change mid-transfer, so discard the block bitmap and
+	 * restart the transfer with the reduced limit.
+	 */
+	limit = tftp_mtu_blksize ( tftp );
+	if ( limit && ( data_len > limit ) &&
+	     ( limit >= TFTP_DEFAULT_BLKSIZE ) &&
+	     ( limit < tftp->max_blksize ) ) {
+		DBGC ( tftp, "TFTP %p blksize %d exceeds path limit %zd; "
+		       "renegotiating\n", tftp, tftp->blksize, limit );
+		tftp->max_blksize = limit;
+		bitmap_free ( &tftp->bitmap );
+		memset ( &tftp->bitmap, 0, sizeof ( tftp->bitmap ) );
+		tftp->acked = 0;
+		if ( ( rc = tftp_reopen ( tftp ) ) != 0 )
+			goto done;
+		tftp_send_packet ( tftp );
+		rc = 0;
+		goto done;
+	}
+
 	/* Deliver data */
 	memset ( &meta, 0, sizeof ( meta ) );
 	meta.flags = XFER_FL_ABS_OFFSET;
@@ -853,8 +970,28 @@ static int tftp_rx_data ( struct tftp_request *tftp,
 	/* Mark block as received */
 	bitmap_set ( &tftp->bitmap, block );
 
-	/* Acknowledge block */
-	tftp_send_packet ( tftp );
+	/* Acknowledge when the window is complete, when the final
+	 * (short) block is received, or upon the first receipt beyond
+	 * a gap left by lost blocks.  Blocks received beyond a gap
+	 * are retained, so recovery involves retransmitting only the
+	 * missing blocks.
+	 */
+	first_gap = bitmap_first_gap ( &tftp->bitmap );
+	if ( ( ( first_gap - tftp->acked ) >= tftp->windowsize ) ||
+	     ( data_len < tftp->blksize ) ||
+	     ( bitmap_full ( &tftp->bitmap ) ) ||
+	     ( ( ( ( unsigned int ) block ) > first_gap ) &&
+	       ( tftp->acked != first_gap ) ) ) {
+		tftp_send_packet ( tftp );
+	} else {
+		/* Restart the retransmission timer without
+		 * transmitting, so that a lost remainder of the
+		 * window eventually triggers a repeated
+		 * acknowledgement.
+		 */
+		stop_timer ( &tftp->timer );
+		start_timer ( &tftp->timer );
+	}
 
 	/* Stop profiling client turnaround */
 	profile_stop ( &tftp_client_profiler );
@@ -1109,6 +1246,8 @@ static int tftp_core_open ( struct interface *xfer, struct uri *uri,
 	timer_init ( &tftp->timer, tftp_timer_expired, &tftp->refcnt );
 	tftp->uri = uri_get ( uri );
 	tftp->blksize = TFTP_DEFAULT_BLKSIZE;
+	tftp->max_blksize = TFTP_MAX_BLKSIZE;
+	tftp->windowsize = TFTP_DEFAULT_WINDOWSIZE;
 	tftp->flags = flags;
 
 	/* Open socket */
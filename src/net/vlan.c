@@ -97,6 +97,7 @@ static int vlan_transmit ( struct net_device *netdev,
 	struct net_device *trunk = vlan->trunk;
 	struct ll_protocol *ll_protocol;
 	struct vlan_header *vlanhdr;
+	struct ethhdr *ethhdr;
 	uint8_t ll_dest_copy[ETH_ALEN];
 	uint8_t ll_source_copy[ETH_ALEN];
 	const void *ll_dest;
@@ -105,8 +106,48 @@ static int vlan_transmit ( struct net_device *netdev,
 	unsigned int flags;
 	int rc;
 
-	/* Strip link-layer header and preserve link-layer header fields */
+	/* Insert VLAN tag in situ, if possible.  The I/O buffer
+	 * already contains a complete Ethernet frame, and transmitted
+	 * I/O buffers are allocated with MAX_LL_HEADER_LEN bytes of
+	 * headroom, so we can almost always insert the tag by shifting
+	 * just the address fields, avoiding the cost of stripping and
+	 * reconstructing the link-layer header around the tag.
+	 */
 	ll_protocol = netdev->ll_protocol;
+	if ( ( trunk->ll_protocol == ll_protocol ) &&
+	     ( iob_headroom ( iobuf ) >= sizeof ( *vlanhdr ) ) ) {
+
+		/* Shift address fields and insert VLAN tag.  The
+		 * encapsulated protocol is already in place, since
+		 * the original protocol field becomes the VLAN
+		 * header's encapsulated protocol field.
+		 */
+		ethhdr = iob_push ( iobuf, sizeof ( *vlanhdr ) );
+		memmove ( ethhdr, ( ( ( void * ) ethhdr ) +
+				    sizeof ( *vlanhdr ) ),
+			  offsetof ( struct ethhdr, h_protocol ) );
+		ethhdr->h_protocol = htons ( ETH_P_8021Q );
+		vlanhdr = ( ( void * ) ( ethhdr + 1 ) );
+		vlanhdr->tci = htons ( VLAN_TCI ( vlan->tag,
+						  vlan->priority ) );
+
+		/* Reclaim I/O buffer from VLAN device's TX queue */
+		list_del ( &iobuf->list );
+
+		/* Transmit packet on trunk device */
+		if ( ( rc = netdev_tx ( trunk,
+					iob_disown ( iobuf ) ) ) != 0 ) {
+			DBGC ( netdev, "VLAN %s could not transmit: %s\n",
+			       netdev->name, strerror ( rc ) );
+			/* Cannot return an error status, since that
+			 * would cause the I/O buffer to be
+			 * double-freed.
+			 */
+		}
+		return 0;
+	}
+
+	/* Strip link-layer header and preserve link-layer header fields */
 	if ( ( rc = ll_protocol->pull ( netdev, iobuf, &ll_dest, &ll_source,
 					&net_proto, &flags ) ) != 0 ) {
 		DBGC ( netdev, "VLAN %s could not parse link-layer header: "
@@ -258,6 +299,22 @@ static int vlan_rx ( struct io_buffer *iobuf, struct net_device *trunk,
 		goto err_no_vlan;
 	}
 
+	/* Strip VLAN tag in situ, if possible.  The original Ethernet
+	 * header (ending in the 802.1Q protocol field) immediately
+	 * precedes the VLAN header within the I/O buffer, so we can
+	 * untag the frame by shifting just the address fields, with
+	 * the VLAN header's encapsulated protocol field becoming the
+	 * protocol field of the reconstructed header.
+	 */
+	if ( trunk->ll_protocol == netdev->ll_protocol ) {
+		iob_push ( iobuf, ( sizeof ( struct ethhdr ) -
+				    sizeof ( *vlanhdr ) ) );
+		memmove ( iobuf->data, ( iobuf->data - sizeof ( *vlanhdr ) ),
+			  offsetof ( struct ethhdr, h_protocol ) );
+		netdev_rx ( netdev, iob_disown ( iobuf ) );
+		return 0;
+	}
+
 	/* Strip VLAN header and preserve original link-layer header fields */
 	iob_pull ( iobuf, sizeof ( *vlanhdr ) );
 	ll_protocol = trunk->ll_protocol;
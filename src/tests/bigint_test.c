@@ -33,10 +33,18 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #undef NDEBUG
 
 #include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ipxe/bigint.h>
+#include <ipxe/profile.h>
 #include <ipxe/test.h>
 
+/** Number of sample iterations for profiling */
+#define PROFILE_COUNT 16
+
+/** Modulus length used for modular exponentiation profiling */
+#define PROFILE_MOD_EXP_LEN 256
+
 /** Define inline big integer */
 #define BIGINT(...) { __VA_ARGS__ }
 
@@ -699,6 +707,55 @@ void bigint_mod_exp_sample ( const bigint_element_t *base0,
 		      sizeof ( result_raw ) ) == 0 );			\
 	} while ( 0 )
 
+/**
+ * Calculate modular exponentiation cost
+ *
+ * @ret cost		Cost (in cycles per modular exponentiation)
+ */
+static unsigned long bigint_mod_exp_cost ( void ) {
+	uint8_t base_raw[PROFILE_MOD_EXP_LEN];
+	uint8_t modulus_raw[PROFILE_MOD_EXP_LEN];
+	uint8_t exponent_raw[PROFILE_MOD_EXP_LEN];
+	bigint_t ( bigint_required_size ( PROFILE_MOD_EXP_LEN ) ) base;
+	bigint_t ( bigint_required_size ( PROFILE_MOD_EXP_LEN ) ) modulus;
+	bigint_t ( bigint_required_size ( PROFILE_MOD_EXP_LEN ) ) exponent;
+	bigint_t ( bigint_required_size ( PROFILE_MOD_EXP_LEN ) ) result;
+	size_t tmp_len = bigint_mod_exp_tmp_len ( &modulus );
+	uint8_t tmp[tmp_len];
+	struct profiler profiler;
+	unsigned int i;
+
+	/* Construct pseudo-random base, modulus, and exponent */
+	srand ( 0x1234568 );
+	for ( i = 0 ; i < PROFILE_MOD_EXP_LEN ; i++ ) {
+		base_raw[i] = rand();
+		modulus_raw[i] = rand();
+		exponent_raw[i] = rand();
+	}
+
+	/* Ensure that modulus is odd (as required by bigint_mod_exp())
+	 * and that base is less than modulus.
+	 */
+	modulus_raw[ PROFILE_MOD_EXP_LEN - 1 ] |= 0x01;
+	modulus_raw[0] |= 0x80;
+	base_raw[0] &= 0x7f;
+
+	/* Initialise big integers */
+	bigint_init ( &base, base_raw, sizeof ( base_raw ) );
+	bigint_init ( &modulus, modulus_raw, sizeof ( modulus_raw ) );
+	bigint_init ( &exponent, exponent_raw, sizeof ( exponent_raw ) );
+
+	/* Profile modular exponentiations */
+	memset ( &profiler, 0, sizeof ( profiler ) );
+	for ( i = 0 ; i < PROFILE_COUNT ; i++ ) {
+		profile_start ( &profiler );
+		bigint_mod_exp ( &base, &modulus, &exponent, &result, tmp );
+		profile_stop ( &profiler );
+	}
+
+	return profile_mean ( &profiler );
+}
+
 /**
  * Perform big integer self-tests
  *
@@ -2638,10 +2695,25 @@ static void bigint_test_exec ( void ) {
 				     0xa0, 0x8a, 0x70, 0xa8, 0xc6, 0x20,
 				     0x0a, 0x0d, 0x3b, 0x2a, 0x92, 0x65,
 				     0x9c, 0x59 ) );
+
+	/* Speed tests */
+	DBG ( "BIGINT %d-bit mod_exp required %ld cycles\n",
+	      ( PROFILE_MOD_EXP_LEN * 8 ), bigint_mod_exp_cost() );
+}
+
+/**
+ * Run big integer benchmarks
+ *
+ */
+static void bigint_test_bench ( void ) {
+
+	test_bench ( "bigint_mod_exp", PROFILE_COUNT, 0,
+		     ( bigint_mod_exp_cost() * PROFILE_COUNT ) );
 }
 
 /** Big integer self-test */
 struct self_test bigint_test __self_test = {
 	.name = "bigint",
 	.exec = bigint_test_exec,
+	.bench = bigint_test_bench,
 };
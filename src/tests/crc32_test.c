@@ -87,6 +87,17 @@ struct crc32_test {
 	ok ( crc32 == (test)->crc32 );					\
 	} while ( 0 )
 
+/**
+ * Report a CRC32C test result
+ *
+ * @v test		CRC32C test
+ */
+#define crc32c_ok( test ) do {						\
+	uint32_t crc32c;						\
+	crc32c = crc32c_le ( (test)->seed, (test)->data, (test)->len );	\
+	ok ( crc32c == (test)->crc32 );					\
+	} while ( 0 )
+
 /* CRC32 tests */
 CRC32_TEST ( empty_test,
 	     DATA ( ),
@@ -100,6 +111,65 @@ CRC32_TEST ( hw_split_part1_test,
 CRC32_TEST ( hw_split_part2_test,
 	     DATA ( ' ', 'w', 'o', 'r', 'l', 'd' ),
 	     0xc9ef5979UL, 0xf2b5ee7aUL );
+CRC32_TEST ( longer_test,
+	     DATA ( 0x05, 0x22, 0x3f, 0x5c, 0x79, 0x96, 0xb3, 0xd0,
+		    0xed, 0x0a, 0x27, 0x44, 0x61, 0x7e, 0x9b, 0xb8,
+		    0xd5, 0xf2, 0x0f, 0x2c, 0x49, 0x66, 0x83, 0xa0,
+		    0xbd, 0xda, 0xf7, 0x14, 0x31, 0x4e, 0x6b, 0x88,
+		    0xa5, 0xc2, 0xdf, 0xfc, 0x19, 0x36, 0x53, 0x70,
+		    0x8d, 0xaa, 0xc7, 0xe4, 0x01, 0x1e, 0x3b, 0x58,
+		    0x75, 0x92, 0xaf, 0xcc, 0xe9, 0x06, 0x23, 0x40,
+		    0x5d, 0x7a, 0x97, 0xb4, 0xd1, 0xee, 0x0b, 0x28 ),
+	     0xffffffffUL, 0xf2cc3ca6UL );
+CRC32_TEST ( longer_split_part1_test,
+	     DATA ( 0x05, 0x22, 0x3f, 0x5c, 0x79, 0x96, 0xb3, 0xd0,
+		    0xed, 0x0a, 0x27, 0x44, 0x61 ),
+	     0xffffffffUL, 0x9b037f5fUL );
+CRC32_TEST ( longer_split_part2_test,
+	     DATA ( 0x7e, 0x9b, 0xb8,
+		    0xd5, 0xf2, 0x0f, 0x2c, 0x49, 0x66, 0x83, 0xa0,
+		    0xbd, 0xda, 0xf7, 0x14, 0x31, 0x4e, 0x6b, 0x88,
+		    0xa5, 0xc2, 0xdf, 0xfc, 0x19, 0x36, 0x53, 0x70,
+		    0x8d, 0xaa, 0xc7, 0xe4, 0x01, 0x1e, 0x3b, 0x58,
+		    0x75, 0x92, 0xaf, 0xcc, 0xe9, 0x06, 0x23, 0x40,
+		    0x5d, 0x7a, 0x97, 0xb4, 0xd1, 0xee, 0x0b, 0x28 ),
+	     0x9b037f5fUL, 0xf2cc3ca6UL );
+
+/* CRC32C tests
+ *
+ * The 32-byte vectors (and their final digest values ~crc) are taken
+ * from RFC 7143 Appendix A.4.
+ */
+CRC32_TEST ( crc32c_zeros_test,
+	     DATA ( 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 ),
+	     0xffffffffUL, 0x756ec955UL );
+CRC32_TEST ( crc32c_ones_test,
+	     DATA ( 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff ),
+	     0xffffffffUL, 0x9d5754bcUL );
+CRC32_TEST ( crc32c_incr_test,
+	     DATA ( 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+		    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+		    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+		    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f ),
+	     0xffffffffUL, 0xb92286b1UL );
+CRC32_TEST ( crc32c_incr_split_part1_test,
+	     DATA ( 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+		    0x08, 0x09, 0x0a, 0x0b, 0x0c ),
+	     0xffffffffUL, 0x3965ba25UL );
+CRC32_TEST ( crc32c_incr_split_part2_test,
+	     DATA ( 0x0d, 0x0e, 0x0f,
+		    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+		    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f ),
+	     0x3965ba25UL, 0xb92286b1UL );
+CRC32_TEST ( crc32c_check_test,
+	     DATA ( '1', '2', '3', '4', '5', '6', '7', '8', '9' ),
+	     0xffffffffUL, 0x1cf96d7cUL );
 
 /**
  * Perform CRC32 self-tests
@@ -111,6 +181,15 @@ static void crc32_test_exec ( void ) {
 	crc32_ok ( &hw_test );
 	crc32_ok ( &hw_split_part1_test );
 	crc32_ok ( &hw_split_part2_test );
+	crc32_ok ( &longer_test );
+	crc32_ok ( &longer_split_part1_test );
+	crc32_ok ( &longer_split_part2_test );
+	crc32c_ok ( &crc32c_zeros_test );
+	crc32c_ok ( &crc32c_ones_test );
+	crc32c_ok ( &crc32c_incr_test );
+	crc32c_ok ( &crc32c_incr_split_part1_test );
+	crc32c_ok ( &crc32c_incr_split_part2_test );
+	crc32c_ok ( &crc32c_check_test );
 }
 
 /** CRC32 self-test */
@@ -36,8 +36,12 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdlib.h>
 #include <string.h>
 #include <ipxe/deflate.h>
+#include <ipxe/profile.h>
 #include <ipxe/test.h>
 
+/** Number of sample iterations for profiling */
+#define PROFILE_COUNT 16
+
 /** A DEFLATE test */
 struct deflate_test {
 	/** Compression format */
@@ -209,6 +213,39 @@ static void deflate_okx ( struct deflate *deflate,
 #define deflate_ok( deflate, test, frags ) \
 	deflate_okx ( deflate, test, frags, __FILE__, __LINE__ )
 
+/**
+ * Calculate decompression cost
+ *
+ * @v deflate		Decompressor
+ * @v test		Deflate test
+ * @ret cost		Cost (in cycles per output byte)
+ */
+static unsigned long deflate_cost ( struct deflate *deflate,
+				    struct deflate_test *test ) {
+	uint8_t buf[ test->expected_len ];
+	struct deflate_chunk out;
+	struct profiler profiler;
+	unsigned long cost;
+	unsigned int i;
+
+	/* Profile decompression */
+	memset ( &profiler, 0, sizeof ( profiler ) );
+	for ( i = 0 ; i < PROFILE_COUNT ; i++ ) {
+		deflate_init ( deflate, test->format );
+		deflate_chunk_init ( &out, buf, 0, sizeof ( buf ) );
+		profile_start ( &profiler );
+		deflate_inflate ( deflate, test->compressed,
+				  test->compressed_len, &out );
+		profile_stop ( &profiler );
+	}
+
+	/* Round to nearest whole number of cycles */
+	cost = ( ( profile_mean ( &profiler ) + ( test->expected_len / 2 ) ) /
+		 test->expected_len );
+
+	return cost;
+}
+
 /**
  * Perform DEFLATE self-test
  *
@@ -239,14 +276,42 @@ static void deflate_test_exec ( void ) {
 				    sizeof ( zlib_fragments[0] ) ) ; i++ ) {
 			deflate_ok ( deflate, &zlib, &zlib_fragments[i] );
 		}
+
+		/* Speed tests */
+		DBG ( "DEFLATE required %ld cycles per byte\n",
+		      deflate_cost ( deflate, &rfc_sentence ) );
 	}
 
 	/* Free shared structure */
 	free ( deflate );
 }
 
+/**
+ * Run DEFLATE benchmarks
+ *
+ */
+static void deflate_test_bench ( void ) {
+	struct deflate *deflate;
+	unsigned long long bytes;
+	unsigned long cost;
+
+	/* Allocate shared structure */
+	deflate = malloc ( sizeof ( *deflate ) );
+	assert ( deflate != NULL );
+
+	/* Report cost in cycles per byte scaled to total bytes */
+	bytes = ( PROFILE_COUNT * ( ( unsigned long long )
+				    rfc_sentence.expected_len ) );
+	cost = deflate_cost ( deflate, &rfc_sentence );
+	test_bench ( "deflate", PROFILE_COUNT, bytes, ( cost * bytes ) );
+
+	/* Free shared structure */
+	free ( deflate );
+}
+
 /** DEFLATE self-test */
 struct self_test deflate_test __self_test = {
 	.name = "deflate",
 	.exec = deflate_test_exec,
+	.bench = deflate_test_bench,
 };
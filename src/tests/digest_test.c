@@ -157,3 +157,18 @@ unsigned long digest_cost ( struct digest_algorithm *digest ) {
 
 	return cost;
 }
+
+/**
+ * Run a digest algorithm benchmark
+ *
+ * @v name		Benchmark name
+ * @v digest		Digest algorithm
+ */
+void digest_bench ( const char *name, struct digest_algorithm *digest ) {
+	unsigned long long bytes = ( PROFILE_COUNT * 8192ULL );
+	unsigned long cost;
+
+	/* Report cost in cycles per byte scaled to total bytes */
+	cost = digest_cost ( digest );
+	test_bench ( name, PROFILE_COUNT, bytes, ( cost * bytes ) );
+}
@@ -111,5 +111,7 @@ struct digest_test {
 extern void digest_okx ( struct digest_test *test, const char *file,
 			 unsigned int line );
 extern unsigned long digest_cost ( struct digest_algorithm *digest );
+extern void digest_bench ( const char *name,
+			   struct digest_algorithm *digest );
 
 #endif /* _DIGEST_TEST_H */
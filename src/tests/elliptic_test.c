@@ -33,12 +33,17 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #undef NDEBUG
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <ipxe/crypto.h>
+#include <ipxe/profile.h>
 #include <ipxe/test.h>
 #include "elliptic_test.h"
 
+/** Number of sample iterations for profiling */
+#define PROFILE_COUNT 16
+
 /**
  * Report elliptic curve point multiplication test result
  *
@@ -74,3 +79,31 @@ void elliptic_okx ( struct elliptic_test *test, const char *file,
 	okx ( memcmp ( actual, test->expected, test->expected_len ) == 0,
 	      file, line );
 }
+
+/**
+ * Calculate elliptic curve point multiplication cost
+ *
+ * @v curve		Elliptic curve
+ * @ret cost		Cost (in cycles per multiplication)
+ */
+unsigned long elliptic_cost ( struct elliptic_curve *curve ) {
+	uint8_t scalar[curve->keysize];
+	uint8_t result[curve->pointsize];
+	struct profiler profiler;
+	unsigned int i;
+
+	/* Fill scalar with pseudo-random data */
+	srand ( 0x1234568 );
+	for ( i = 0 ; i < sizeof ( scalar ) ; i++ )
+		scalar[i] = rand();
+
+	/* Profile base point multiplications */
+	memset ( &profiler, 0, sizeof ( profiler ) );
+	for ( i = 0 ; i < PROFILE_COUNT ; i++ ) {
+		profile_start ( &profiler );
+		elliptic_multiply ( curve, NULL, scalar, result );
+		profile_stop ( &profiler );
+	}
+
+	return profile_mean ( &profiler );
+}
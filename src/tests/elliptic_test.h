@@ -66,6 +66,7 @@ struct elliptic_test {
 
 extern void elliptic_okx ( struct elliptic_test *test, const char *file,
 			   unsigned int line );
+extern unsigned long elliptic_cost ( struct elliptic_curve *curve );
 
 /**
  * Report an elliptic curve point multiplication test result
@@ -250,6 +250,7 @@ static void ipv6_table_okx ( struct ipv6_test_table *table, const char *file,
 			     unsigned int line ) {
 	const struct ipv6_test_route *route;
 	struct ipv6_miniroute *miniroute;
+	struct ipv6_miniroute *tmp;
 	struct in6_addr address;
 	struct in6_addr router;
 	struct in6_addr mask;
@@ -284,9 +285,18 @@ static void ipv6_table_okx ( struct ipv6_test_table *table, const char *file,
 					     &router : NULL ) ) == 0,
 		      file, line );
 
-		/* Check routing table entry */
-		miniroute = list_first_entry ( &ipv6_miniroutes,
-					       struct ipv6_miniroute, list );
+		/* Check routing table entry (which is not necessarily
+		 * at the head of the list, since the table is sorted
+		 * by descending prefix length).
+		 */
+		miniroute = NULL;
+		list_for_each_entry ( tmp, &ipv6_miniroutes, list ) {
+			if ( memcmp ( &tmp->address, &address,
+				      sizeof ( address ) ) == 0 ) {
+				miniroute = tmp;
+				break;
+			}
+		}
 		okx ( miniroute != NULL, file, line );
 		okx ( memcmp ( &miniroute->address, &address,
 			       sizeof ( address ) ) == 0, file, line );
@@ -308,6 +318,7 @@ static void ipv6_table_okx ( struct ipv6_test_table *table, const char *file,
 
 	/* Restore original routing table */
 	list_splice ( &saved, &ipv6_miniroutes );
+	ipv6_flush_route_cache();
 }
 #define ipv6_table_ok( table )						\
 	ipv6_table_okx ( table, __FILE__, __LINE__ )
@@ -336,6 +347,7 @@ static void ipv6_route_okx ( struct ipv6_test_table *table, const char *dest,
 	INIT_LIST_HEAD ( &saved );
 	list_splice_init ( &ipv6_miniroutes, &saved );
 	list_splice_init ( &table->list, &ipv6_miniroutes );
+	ipv6_flush_route_cache();
 
 	/* Parse addresses */
 	okx ( inet6_aton ( dest, &in_dest ) == 0, file, line );
@@ -376,6 +388,7 @@ static void ipv6_route_okx ( struct ipv6_test_table *table, const char *dest,
 	/* Restore original routing table */
 	list_splice_init ( &ipv6_miniroutes, &table->list );
 	list_splice ( &saved, &ipv6_miniroutes );
+	ipv6_flush_route_cache();
 }
 #define ipv6_route_ok( table, dest, src, next )				\
 	ipv6_route_okx ( table, dest, src, next, __FILE__, __LINE__ )
@@ -401,6 +414,7 @@ static void ipv6_table_del ( struct ipv6_test_table *table ) {
 
 	/* Restore original routing table */
 	list_splice ( &saved, &ipv6_miniroutes );
+	ipv6_flush_route_cache();
 }
 
 /**
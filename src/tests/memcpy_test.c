@@ -266,8 +266,47 @@ static void memcpy_test_exec ( void ) {
 	}
 }
 
+/**
+ * Run memcpy() benchmarks
+ *
+ */
+static void memcpy_test_bench ( void ) {
+	static const size_t len = 4096;
+	struct profiler profiler;
+	uint8_t *dest;
+	uint8_t *src;
+	unsigned int i;
+
+	/* Allocate blocks */
+	dest = malloc ( len );
+	assert ( dest != NULL );
+	src = malloc ( len );
+	assert ( src != NULL );
+
+	/* Generate random source data */
+	for ( i = 0 ; i < len ; i++ )
+		src[i] = random();
+
+	/* Profile aligned copies */
+	memset ( &profiler, 0, sizeof ( profiler ) );
+	for ( i = 0 ; i < PROFILE_COUNT ; i++ ) {
+		profile_start ( &profiler );
+		memcpy ( dest, src, len );
+		profile_stop ( &profiler );
+	}
+
+	/* Free blocks */
+	free ( dest );
+	free ( src );
+
+	/* Report results */
+	test_bench ( "memcpy", PROFILE_COUNT, ( PROFILE_COUNT * len ),
+		     ( profile_mean ( &profiler ) * PROFILE_COUNT ) );
+}
+
 /** memcpy() self-test */
 struct self_test memcpy_test __self_test = {
 	.name = "memcpy",
 	.exec = memcpy_test_exec,
+	.bench = memcpy_test_bench,
 };
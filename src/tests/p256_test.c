@@ -167,6 +167,10 @@ static void p256_test_exec ( void ) {
 	/* Invalid point tests */
 	elliptic_ok ( &invalid_zero );
 	elliptic_ok ( &invalid_one );
+
+	/* Speed tests */
+	DBG ( "P256 required %ld cycles per multiplication\n",
+	      elliptic_cost ( &p256_curve ) );
 }
 
 /** P-256 self-test */
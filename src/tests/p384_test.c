@@ -213,6 +213,10 @@ static void p384_test_exec ( void ) {
 	/* Invalid point tests */
 	elliptic_ok ( &invalid_zero );
 	elliptic_ok ( &invalid_one );
+
+	/* Speed tests */
+	DBG ( "P384 required %ld cycles per multiplication\n",
+	      elliptic_cost ( &p384_curve ) );
 }
 
 /** P-384 self-test */
@@ -104,8 +104,19 @@ static void sha256_test_exec ( void ) {
 	      digest_cost ( &sha224_algorithm ) );
 }
 
+/**
+ * Run SHA-256 family benchmarks
+ *
+ */
+static void sha256_test_bench ( void ) {
+
+	digest_bench ( "sha256", &sha256_algorithm );
+	digest_bench ( "sha224", &sha224_algorithm );
+}
+
 /** SHA-256 family self-test */
 struct self_test sha256_test __self_test = {
 	.name = "sha256",
 	.exec = sha256_test_exec,
+	.bench = sha256_test_bench,
 };
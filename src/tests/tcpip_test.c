@@ -253,8 +253,41 @@ static void tcpip_test_exec ( void ) {
 	tcpip_random_ok ( &partial );
 }
 
+/**
+ * Run TCP/IP benchmarks
+ *
+ */
+static void tcpip_test_bench ( void ) {
+	static const size_t len = 4096;
+	struct profiler profiler;
+	uint16_t sum;
+	unsigned int i;
+
+	/* Generate random data */
+	srandom ( 0x481ede02UL );
+	for ( i = 0 ; i < len ; i++ )
+		tcpip_data[i] = random();
+
+	/* Profile optimised calculation over aligned data */
+	memset ( &profiler, 0, sizeof ( profiler ) );
+	for ( i = 0 ; i < PROFILE_COUNT ; i++ ) {
+		profile_start ( &profiler );
+		sum = tcpip_continue_chksum ( TCPIP_EMPTY_CSUM, tcpip_data,
+					      len );
+		profile_stop ( &profiler );
+	}
+
+	/* Prevent compiler from optimising away the calculation */
+	ok ( sum != TCPIP_EMPTY_CSUM );
+
+	/* Report results */
+	test_bench ( "tcpip_chksum", PROFILE_COUNT, ( PROFILE_COUNT * len ),
+		     ( profile_mean ( &profiler ) * PROFILE_COUNT ) );
+}
+
 /** TCP/IP self-test */
 struct self_test tcpip_test __self_test = {
 	.name = "tcpip",
 	.exec = tcpip_test_exec,
+	.bench = tcpip_test_bench,
 };
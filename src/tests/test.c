@@ -70,6 +70,22 @@ void test_ok ( int success, const char *file, unsigned int line,
 	}
 }
 
+/**
+ * Report benchmark result
+ *
+ * @v name		Benchmark name
+ * @v iterations	Number of iterations
+ * @v bytes		Number of bytes processed (or zero if not applicable)
+ * @v ticks		Total number of profiler ticks
+ */
+void test_bench ( const char *name, unsigned long iterations,
+		  unsigned long long bytes, unsigned long long ticks ) {
+
+	/* Print a parseable tab-separated result row */
+	printf ( "BENCH\t%s\t%ld\t%lld\t%lld\n",
+		 name, iterations, bytes, ticks );
+}
+
 /**
  * Run self-test set
  *
@@ -111,9 +127,10 @@ static void run_tests ( struct self_test *tests ) {
 /**
  * Run all self-tests
  *
+ * @v perf		Run companion benchmarks
  * @ret rc		Return status code
  */
-static int run_all_tests ( void ) {
+static int run_all_tests ( int perf ) {
 	struct self_test *tests;
 	unsigned int failures = 0;
 	unsigned int assertions = 0;
@@ -140,6 +157,14 @@ static int run_all_tests ( void ) {
 		return -EINPROGRESS;
 	} else {
 		printf ( "OK: all %d tests passed\n", total );
+		/* Run companion benchmarks, if requested */
+		if ( perf ) {
+			printf ( "BENCH\tname\titerations\tbytes\tticks\n" );
+			for_each_table_entry ( tests, SELF_TESTS ) {
+				if ( tests->bench )
+					tests->bench();
+			}
+		}
 		profstat();
 		return 0;
 	}
@@ -149,8 +174,15 @@ static int test_image_probe ( struct image *image __unused ) {
 	return -ENOTTY;
 }
 
-static int test_image_exec ( struct image *image __unused ) {
-	return run_all_tests();
+static int test_image_exec ( struct image *image ) {
+	int perf;
+
+	/* Run benchmarks if performance mode is requested via the
+	 * image command line (e.g. "imgargs <TESTS> perf")
+	 */
+	perf = ( image->cmdline && strstr ( image->cmdline, "perf" ) );
+
+	return run_all_tests ( perf );
 }
 
 static struct image_type test_image_type = {
@@ -38,6 +38,7 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <string.h>
 #include <ipxe/x25519.h>
 #include <ipxe/test.h>
+#include "elliptic_test.h"
 
 /** Define inline multiplicand */
 #define MULTIPLICAND(...) { __VA_ARGS__ }
@@ -591,6 +592,10 @@ static void x25519_test_exec ( void ) {
 	x25519_key_ok ( &rfc7748_3 );
 	x25519_key_ok ( &rfc7748_4_100 );
 	x25519_key_ok ( &malicious );
+
+	/* Speed tests */
+	DBG ( "X25519 required %ld cycles per multiplication\n",
+	      elliptic_cost ( &x25519_curve ) );
 }
 
 /** X25519 self-test */
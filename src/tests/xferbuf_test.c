@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * Data transfer buffer tests
+ *
+ */
+
+/* Forcibly enable assertions */
+#undef NDEBUG
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ipxe/xferbuf.h>
+#include <ipxe/test.h>
+
+/**
+ * Reallocate mover data transfer buffer
+ *
+ * @v xferbuf		Data transfer buffer
+ * @v len		New length (or zero to free buffer)
+ * @ret rc		Return status code
+ *
+ * Unconditionally relocate the data on every reallocation (including
+ * shrinking), to model reallocators such as memtop_urealloc() that
+ * may move a block even when trimming it.
+ */
+static int xferbuf_move_realloc ( struct xfer_buffer *xferbuf, size_t len ) {
+	size_t old_len = xferbuf->reserved;
+	void *new_data;
+
+	/* Handle freeing of buffer */
+	if ( ! len ) {
+		free ( xferbuf->data );
+		xferbuf->data = NULL;
+		return 0;
+	}
+
+	/* Allocate new buffer and relocate any existing data */
+	new_data = malloc ( len );
+	if ( ! new_data )
+		return -ENOSPC;
+	if ( xferbuf->data ) {
+		memcpy ( new_data, xferbuf->data,
+			 ( ( len < old_len ) ? len : old_len ) );
+		free ( xferbuf->data );
+	}
+	xferbuf->data = new_data;
+	return 0;
+}
+
+/** Mover data buffer operations */
+static struct xfer_buffer_operations xferbuf_move_operations = {
+	.realloc = xferbuf_move_realloc,
+};
+
+/**
+ * Perform data transfer buffer self-tests
+ *
+ */
+static void xferbuf_test_exec ( void ) {
+	static uint8_t data[3072];
+	struct xfer_buffer xferbuf = { .op = &xferbuf_move_operations };
+	void *detached;
+	unsigned int i;
+
+	/* Construct test pattern */
+	for ( i = 0 ; i < sizeof ( data ) ; i++ )
+		data[i] = ( i & 0xff );
+
+	/* Write data in two instalments, so that geometric growth
+	 * leaves the buffer with an excess reservation.
+	 */
+	ok ( xferbuf_write ( &xferbuf, 0, data, 2048 ) == 0 );
+	ok ( xferbuf_write ( &xferbuf, 2048, &data[2048], 1024 ) == 0 );
+	ok ( xferbuf.len == sizeof ( data ) );
+	ok ( xferbuf.reserved > xferbuf.len );
+
+	/* Detach data: the trim must relocate the data (by
+	 * construction of xferbuf_move_realloc()), and the detached
+	 * pointer must refer to the relocated contents.
+	 */
+	detached = xferbuf_detach ( &xferbuf );
+	ok ( detached != NULL );
+	ok ( memcmp ( detached, data, sizeof ( data ) ) == 0 );
+	ok ( xferbuf.data == NULL );
+	ok ( xferbuf.len == 0 );
+	ok ( xferbuf.reserved == 0 );
+	free ( detached );
+}
+
+/** Data transfer buffer self-test */
+struct self_test xferbuf_test __self_test = {
+	.name = "xferbuf",
+	.exec = xferbuf_test_exec,
+};
@@ -0,0 +1,1115 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+/** @file
+ *
+ * Zstandard image tests
+ *
+ */
+
+/* Forcibly enable assertions */
+#undef NDEBUG
+
+#include <stdint.h>
+#include <string.h>
+#include <ipxe/image.h>
+#include <ipxe/zstd.h>
+#include <ipxe/test.h>
+
+/** A Zstandard test */
+struct zstd_test {
+	/** Compressed filename */
+	const char *compressed_name;
+	/** Compressed data */
+	const void *compressed;
+	/** Length of compressed data */
+	size_t compressed_len;
+	/** Expected uncompressed name */
+	const char *expected_name;
+	/** Expected uncompressed data */
+	const void *expected;
+	/** Length of expected uncompressed data */
+	size_t expected_len;
+};
+
+/** Define inline data */
+#define DATA(...) { __VA_ARGS__ }
+
+/** Define a Zstandard test */
+#define ZSTD( name, COMPRESSED, EXPECTED )				\
+	static const uint8_t name ## _compressed[] = COMPRESSED;	\
+	static const uint8_t name ## _expected[] = EXPECTED;		\
+	static struct zstd_test name = {				\
+		.compressed_name = #name ".zst",			\
+		.compressed = name ## _compressed,			\
+		.compressed_len = sizeof ( name ## _compressed ),	\
+		.expected_name = #name,					\
+		.expected = name ## _expected,				\
+		.expected_len = sizeof ( name ## _expected ),		\
+	};
+
+/** "Hello world" (raw block) */
+ZSTD ( hello_world,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x0b, 0x59, 0x00, 0x00, 0x48,
+	      0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64,
+	      0xd8, 0x76, 0xb3, 0x12 ),
+       DATA ( 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f, 0x72, 0x6c,
+	      0x64 ) );
+
+/** Repetitive text (sequences with raw literals) */
+ZSTD ( fox,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x64, 0x1c, 0x01, 0xb5, 0x01, 0x00,
+	      0xd4, 0x02, 0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63,
+	      0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f,
+	      0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76,
+	      0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a,
+	      0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20, 0x01, 0x00, 0x65,
+	      0x87, 0xaa, 0x2a, 0x03, 0x6a, 0x80, 0x60, 0xb8 ),
+       DATA ( 0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20 ) );
+
+/** Mixed text (single-stream Huffman literals, no checksum) */
+ZSTD ( lorem,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x60, 0xa2, 0x03, 0x55, 0x08, 0x00,
+	      0x02, 0x83, 0x0a, 0x10, 0xc0, 0xeb, 0x00, 0xb1, 0x20, 0x95,
+	      0x25, 0x4b, 0x84, 0x30, 0xdd, 0x56, 0x55, 0xec, 0x5a, 0x4e,
+	      0xff, 0x8d, 0x75, 0xcc, 0xe3, 0x5c, 0x36, 0x55, 0xe2, 0x06,
+	      0x4b, 0xa3, 0xba, 0x00, 0x84, 0x6e, 0xaa, 0xea, 0xe4, 0x7d,
+	      0x4a, 0xa1, 0x89, 0xe0, 0x44, 0x80, 0x84, 0xa8, 0xb1, 0x27,
+	      0x49, 0x36, 0x76, 0x03, 0x20, 0x44, 0x60, 0x18, 0x43, 0xeb,
+	      0x11, 0x44, 0x09, 0x16, 0x50, 0x82, 0x52, 0x62, 0xe9, 0xa6,
+	      0xf2, 0xed, 0xa9, 0x55, 0x4d, 0x38, 0x75, 0xef, 0x3d, 0x8e,
+	      0xc4, 0x2d, 0x19, 0xaf, 0xa8, 0x24, 0x51, 0xd4, 0xf4, 0xb9,
+	      0x97, 0x2d, 0xbe, 0x5b, 0x48, 0x51, 0x2b, 0x84, 0x19, 0x74,
+	      0x4d, 0x64, 0x61, 0x8d, 0xab, 0xce, 0x42, 0xbf, 0x74, 0x07,
+	      0x95, 0xe9, 0x26, 0xda, 0x5f, 0xda, 0xc5, 0x56, 0x41, 0x24,
+	      0xf3, 0x8c, 0x87, 0x6d, 0x8a, 0x40, 0x2e, 0x89, 0xdb, 0x00,
+	      0x32, 0x0f, 0xfb, 0x6b, 0xf4, 0x82, 0xf8, 0x14, 0x95, 0x95,
+	      0x1a, 0x3d, 0x87, 0xac, 0x6b, 0x75, 0x3e, 0x60, 0x75, 0x21,
+	      0xb3, 0x3f, 0xda, 0x1c, 0x31, 0x65, 0x3a, 0x9b, 0x79, 0x42,
+	      0xeb, 0x28, 0x71, 0x07, 0xbb, 0xd3, 0x9e, 0x1c, 0x20, 0x53,
+	      0xb6, 0x95, 0x5d, 0x85, 0xde, 0x3e, 0x58, 0x35, 0x26, 0x81,
+	      0xa1, 0x36, 0x46, 0x6f, 0x72, 0xcd, 0x95, 0x7e, 0x93, 0xc8,
+	      0x08, 0xc9, 0xb2, 0x9f, 0x9d, 0x41, 0xc2, 0xd4, 0x04, 0x1e,
+	      0x22, 0xe0, 0xcd, 0xbf, 0x1b, 0x05, 0xf7, 0xa4, 0x56, 0xd2,
+	      0xa2, 0x80, 0x8d, 0x8a, 0x5a, 0x17, 0xf7, 0x66, 0x6d, 0x86,
+	      0xc0, 0x98, 0xde, 0x52, 0xf8, 0xc1, 0x40, 0xbe, 0x2f, 0x5d,
+	      0xd3, 0x95, 0xe6, 0x2a, 0xef, 0xaf, 0x14, 0xf3, 0x56, 0xee,
+	      0x6f, 0x59, 0x7b, 0x13, 0xfe, 0x75, 0x1b, 0x02, 0x81, 0x67,
+	      0x22, 0xbb, 0x3f, 0x3f, 0x20, 0x4c, 0xdc, 0x50, 0xed, 0x23,
+	      0x0d, 0xa6, 0x3f, 0xec, 0x56, 0x01 ),
+       DATA ( 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x62, 0x6f, 0x6f, 0x74,
+	      0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x70, 0x78, 0x65, 0x20,
+	      0x70, 0x78, 0x65, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20,
+	      0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x6d, 0x65, 0x6e, 0x75,
+	      0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x64, 0x68, 0x63,
+	      0x70, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x62,
+	      0x6f, 0x6f, 0x74, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x63,
+	      0x68, 0x61, 0x69, 0x6e, 0x20, 0x70, 0x78, 0x65, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x64, 0x68,
+	      0x63, 0x70, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x6d, 0x65,
+	      0x6e, 0x75, 0x20, 0x70, 0x78, 0x65, 0x20, 0x6d, 0x65, 0x6e,
+	      0x75, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20,
+	      0x64, 0x68, 0x63, 0x70, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20,
+	      0x62, 0x6f, 0x6f, 0x74, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	      0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x69, 0x6d,
+	      0x61, 0x67, 0x65, 0x20, 0x70, 0x78, 0x65, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x63,
+	      0x68, 0x61, 0x69, 0x6e, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65,
+	      0x6c, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x68, 0x74, 0x74, 0x70, 0x20, 0x64, 0x68,
+	      0x63, 0x70, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x62, 0x6f,
+	      0x6f, 0x74, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20,
+	      0x6d, 0x65, 0x6e, 0x75, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e,
+	      0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x63, 0x68,
+	      0x61, 0x69, 0x6e, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x74,
+	      0x66, 0x74, 0x70, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x68,
+	      0x74, 0x74, 0x70, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x62,
+	      0x6f, 0x6f, 0x74, 0x20, 0x70, 0x78, 0x65, 0x20, 0x74, 0x66,
+	      0x74, 0x70, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x6b,
+	      0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x74, 0x66, 0x74, 0x70,
+	      0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x68,
+	      0x74, 0x74, 0x70, 0x20, 0x68, 0x74, 0x74, 0x70, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x63, 0x68,
+	      0x61, 0x69, 0x6e, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x69,
+	      0x6d, 0x61, 0x67, 0x65, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20,
+	      0x70, 0x78, 0x65, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20,
+	      0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x6b, 0x65, 0x72,
+	      0x6e, 0x65, 0x6c, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x70, 0x78, 0x65, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x70, 0x78,
+	      0x65, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x68, 0x74, 0x74,
+	      0x70, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x74,
+	      0x66, 0x74, 0x70, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20,
+	      0x70, 0x78, 0x65, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x68,
+	      0x74, 0x74, 0x70, 0x20, 0x70, 0x78, 0x65, 0x20, 0x69, 0x6e,
+	      0x69, 0x74, 0x72, 0x64, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65,
+	      0x6c, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x69,
+	      0x6d, 0x61, 0x67, 0x65, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20,
+	      0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x70, 0x78, 0x65, 0x20,
+	      0x6d, 0x65, 0x6e, 0x75, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20,
+	      0x74, 0x66, 0x74, 0x70, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20,
+	      0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x64, 0x68, 0x63,
+	      0x70, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x68,
+	      0x74, 0x74, 0x70, 0x20, 0x70, 0x78, 0x65, 0x20, 0x69, 0x6d,
+	      0x61, 0x67, 0x65, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x69,
+	      0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x63, 0x68, 0x61, 0x69,
+	      0x6e, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x63, 0x68, 0x61,
+	      0x69, 0x6e, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x69,
+	      0x6d, 0x61, 0x67, 0x65, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65,
+	      0x6c, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x63, 0x68, 0x61,
+	      0x69, 0x6e, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20,
+	      0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x64, 0x68, 0x63,
+	      0x70, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x63,
+	      0x68, 0x61, 0x69, 0x6e, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20,
+	      0x74, 0x66, 0x74, 0x70, 0x20, 0x68, 0x74, 0x74, 0x70, 0x20,
+	      0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x74, 0x66, 0x74, 0x70,
+	      0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x69, 0x6d,
+	      0x61, 0x67, 0x65, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64,
+	      0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x74, 0x66, 0x74, 0x70,
+	      0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x69, 0x6d, 0x61, 0x67,
+	      0x65, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x63, 0x68, 0x61,
+	      0x69, 0x6e, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20, 0x6d, 0x65,
+	      0x6e, 0x75, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x70, 0x78,
+	      0x65, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x68, 0x74,
+	      0x74, 0x70, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x62,
+	      0x6f, 0x6f, 0x74, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x68,
+	      0x74, 0x74, 0x70, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64,
+	      0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x63, 0x68, 0x61, 0x69,
+	      0x6e, 0x20, 0x68, 0x74, 0x74, 0x70, 0x20, 0x74, 0x66, 0x74,
+	      0x70, 0x20, 0x70, 0x78, 0x65, 0x20, 0x62, 0x6f, 0x6f, 0x74,
+	      0x20, 0x70, 0x78, 0x65, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20,
+	      0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x63, 0x68, 0x61, 0x69,
+	      0x6e, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x63,
+	      0x68, 0x61, 0x69, 0x6e, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20,
+	      0x69, 0x6d, 0x61, 0x67, 0x65, 0x20, 0x69, 0x6d, 0x61, 0x67,
+	      0x65, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x20,
+	      0x74, 0x66, 0x74, 0x70, 0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20,
+	      0x64, 0x68, 0x63, 0x70, 0x20, 0x6b, 0x65, 0x72, 0x6e, 0x65,
+	      0x6c, 0x20, 0x70, 0x78, 0x65, 0x20, 0x6d, 0x65, 0x6e, 0x75,
+	      0x20, 0x70, 0x78, 0x65, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20,
+	      0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x20, 0x68, 0x74, 0x74,
+	      0x70, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x6d,
+	      0x65, 0x6e, 0x75, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64,
+	      0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x70, 0x78, 0x65,
+	      0x20, 0x70, 0x78, 0x65, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e,
+	      0x20, 0x68, 0x74, 0x74, 0x70, 0x20, 0x62, 0x6f, 0x6f, 0x74,
+	      0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x6d, 0x65, 0x6e, 0x75,
+	      0x20, 0x70, 0x78, 0x65, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20,
+	      0x70, 0x78, 0x65, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x63,
+	      0x68, 0x61, 0x69, 0x6e, 0x20, 0x62, 0x6f, 0x6f, 0x74, 0x20,
+	      0x70, 0x78, 0x65, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20,
+	      0x62, 0x6f, 0x6f, 0x74, 0x20, 0x68, 0x74, 0x74, 0x70, 0x20,
+	      0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x6d, 0x65, 0x6e, 0x75,
+	      0x20, 0x70, 0x78, 0x65, 0x20, 0x74, 0x66, 0x74, 0x70, 0x20,
+	      0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x70, 0x78, 0x65,
+	      0x20, 0x6d, 0x65, 0x6e, 0x75, 0x20, 0x69, 0x6d, 0x61, 0x67,
+	      0x65, 0x20, 0x64, 0x68, 0x63, 0x70, 0x20, 0x64, 0x68, 0x63,
+	      0x70, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20, 0x70,
+	      0x78, 0x65, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x72, 0x64, 0x20,
+	      0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c ) );
+
+/** Skewed-distribution text (four-stream Huffman literals,
+ * FSE-compressed weights)
+ */
+ZSTD ( skew,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x60, 0x08, 0x06, 0x55, 0x1a, 0x00,
+	      0xda, 0x6f, 0xf0, 0x0c, 0x10, 0xc0, 0x25, 0x1d, 0xad, 0x35,
+	      0x42, 0x08, 0xd9, 0x7b, 0xef, 0x2d, 0xb9, 0xaa, 0xaa, 0x4e,
+	      0x0f, 0xc7, 0x00, 0xcb, 0x00, 0xc8, 0x00, 0x65, 0x0b, 0xed,
+	      0xb0, 0xb2, 0x21, 0xf2, 0x3b, 0x1f, 0xce, 0xf4, 0x12, 0xe0,
+	      0x04, 0x00, 0xe7, 0x21, 0x59, 0x43, 0x3c, 0xed, 0x6f, 0xcb,
+	      0x44, 0x85, 0x9a, 0x8a, 0xe9, 0x5d, 0x86, 0x64, 0xf3, 0x72,
+	      0x68, 0x24, 0x7f, 0xce, 0x2c, 0xd4, 0x11, 0x8b, 0xaf, 0xca,
+	      0xad, 0x2f, 0x22, 0xf3, 0x48, 0xe7, 0xcd, 0x83, 0x13, 0x1e,
+	      0xea, 0xa5, 0xad, 0xec, 0x74, 0x31, 0x4c, 0x01, 0x02, 0xe3,
+	      0xb2, 0xc9, 0xd5, 0x7c, 0x5e, 0x14, 0x62, 0x19, 0x55, 0x66,
+	      0xa6, 0x66, 0x68, 0x88, 0xd1, 0x1c, 0x49, 0x1f, 0x4d, 0xc9,
+	      0x86, 0x37, 0xfb, 0xcc, 0x90, 0x12, 0x9a, 0x92, 0x4b, 0x22,
+	      0x49, 0x31, 0x5a, 0xa6, 0x82, 0xa7, 0x96, 0x20, 0x3e, 0xf2,
+	      0xb4, 0xd2, 0x06, 0xd7, 0xe3, 0xd8, 0x91, 0xfa, 0x6a, 0x04,
+	      0x21, 0x92, 0x2c, 0x20, 0x94, 0x01, 0x8a, 0xfc, 0x0e, 0xed,
+	      0x4e, 0x08, 0xc7, 0xde, 0xdc, 0x65, 0x8d, 0x60, 0x9e, 0x07,
+	      0x78, 0xc1, 0xfe, 0xcc, 0x20, 0x6e, 0x39, 0x8d, 0xfb, 0xdf,
+	      0xf9, 0x75, 0x7b, 0xe3, 0xc8, 0x45, 0x53, 0x00, 0xb5, 0x93,
+	      0x86, 0xe4, 0xc0, 0x68, 0x39, 0x6e, 0xd0, 0x3c, 0xca, 0xed,
+	      0x9f, 0xab, 0x14, 0x43, 0xd5, 0x35, 0x45, 0x0c, 0x51, 0x71,
+	      0x90, 0xd5, 0xb3, 0x75, 0x81, 0x36, 0x86, 0x58, 0xc7, 0x21,
+	      0xb6, 0xf8, 0xd4, 0x22, 0x1e, 0x9f, 0xe2, 0xa0, 0x04, 0x10,
+	      0x17, 0xfd, 0x3e, 0x77, 0xae, 0x1b, 0xf5, 0x45, 0x7d, 0x3a,
+	      0x92, 0xd5, 0x59, 0x44, 0x5e, 0x12, 0x5d, 0x8e, 0x33, 0x5a,
+	      0x28, 0xe0, 0x9c, 0x88, 0x9b, 0x87, 0x3a, 0xce, 0xd0, 0xd2,
+	      0x98, 0xa4, 0x95, 0x28, 0x2e, 0x61, 0x45, 0xe5, 0xd8, 0x3c,
+	      0x85, 0x21, 0x94, 0x9e, 0xc6, 0xaf, 0x2d, 0x9d, 0xb0, 0x63,
+	      0x99, 0xb2, 0x00, 0x30, 0xbc, 0x14, 0xb1, 0x59, 0x23, 0x01,
+	      0x2c, 0x31, 0x92, 0xdf, 0xae, 0x93, 0x92, 0x74, 0xae, 0x10,
+	      0x25, 0x30, 0x50, 0xce, 0xb6, 0xb5, 0x15, 0xb6, 0x0c, 0x36,
+	      0x48, 0xff, 0x80, 0x1d, 0xa8, 0x92, 0x03, 0xd0, 0xc8, 0x63,
+	      0xc0, 0xb1, 0x63, 0xb5, 0x93, 0x14, 0x5b, 0x33, 0x0b, 0x20,
+	      0x67, 0x14, 0x30, 0x9c, 0x58, 0x9a, 0xaf, 0xe2, 0x2c, 0xc2,
+	      0x9b, 0xc6, 0xca, 0x4a, 0xcd, 0x33, 0x10, 0xa2, 0x74, 0x1a,
+	      0x62, 0x3f, 0x04, 0x30, 0x25, 0x29, 0x68, 0x06, 0x78, 0x3b,
+	      0xad, 0x0d, 0x22, 0xef, 0x7c, 0x06, 0xc2, 0x21, 0xfc, 0x12,
+	      0x8b, 0x81, 0xb1, 0x73, 0x99, 0x65, 0x63, 0x1b, 0x15, 0x42,
+	      0x37, 0x80, 0x72, 0xc8, 0x42, 0xf1, 0x6c, 0x69, 0x68, 0x49,
+	      0xac, 0x2c, 0x6c, 0xd1, 0xce, 0x99, 0x1f, 0xc2, 0x1a, 0x73,
+	      0x03, 0x33, 0xb1, 0x90, 0x03, 0xdc, 0x5c, 0x02, 0x8e, 0x67,
+	      0x86, 0x55, 0xc5, 0x27, 0x1a, 0xbf, 0xc8, 0x6a, 0x3a, 0x81,
+	      0xd1, 0x38, 0xed, 0x9a, 0xb1, 0x7b, 0x8a, 0x88, 0xc4, 0x7d,
+	      0x56, 0x0d, 0x12, 0x27, 0x66, 0x3e, 0xa3, 0x21, 0x0e, 0x55,
+	      0xa2, 0x6e, 0x18, 0x6b, 0x54, 0x62, 0xa5, 0xa7, 0xa6, 0xae,
+	      0x97, 0x17, 0x6b, 0x27, 0x74, 0x60, 0x0b, 0xd8, 0xa7, 0x7c,
+	      0x51, 0x24, 0xc7, 0x4c, 0x57, 0x5a, 0x89, 0xdb, 0x32, 0x9b,
+	      0xe1, 0xe8, 0x10, 0xf2, 0xf1, 0x68, 0x4b, 0x57, 0x77, 0x3d,
+	      0x45, 0x16, 0x8a, 0x0e, 0x6f, 0xe6, 0xc0, 0x38, 0x6f, 0xc1,
+	      0xa9, 0x5e, 0x3b, 0x89, 0x01, 0x5a, 0x23, 0x6f, 0x69, 0x4f,
+	      0x12, 0x75, 0xe2, 0x79, 0x21, 0xe3, 0x71, 0x57, 0xda, 0xaa,
+	      0xea, 0x6f, 0xf9, 0xc9, 0x44, 0x92, 0x55, 0x94, 0x18, 0xa1,
+	      0x8a, 0x08, 0x3b, 0x6a, 0xc5, 0xc8, 0x07, 0x81, 0xe2, 0x5c,
+	      0x89, 0x26, 0xca, 0x3a, 0xe7, 0xd8, 0x98, 0xd8, 0x6e, 0x4c,
+	      0xf2, 0x6a, 0x88, 0x17, 0xfa, 0x66, 0x67, 0x42, 0x2b, 0x53,
+	      0xa5, 0x9a, 0xbd, 0x51, 0xcf, 0xf2, 0x10, 0x89, 0xd8, 0xfb,
+	      0xc5, 0xc9, 0x94, 0x7e, 0x16, 0x09, 0xc5, 0xdb, 0x38, 0x56,
+	      0x1a, 0x78, 0xa5, 0xe1, 0x41, 0x34, 0x5a, 0x55, 0xe6, 0x1d,
+	      0x92, 0xcc, 0x47, 0xb2, 0xf5, 0x72, 0x13, 0x60, 0x04, 0x9e,
+	      0x0d, 0x62, 0xa0, 0xf3, 0x9c, 0x5d, 0x4f, 0xef, 0x0f, 0xe7,
+	      0x8c, 0x43, 0x77, 0xaa, 0x54, 0x12, 0xd1, 0x62, 0xa3, 0x89,
+	      0xf1, 0x4e, 0x49, 0x21, 0xca, 0x5b, 0x10, 0x29, 0x79, 0x82,
+	      0x32, 0x81, 0x9b, 0xc9, 0xf0, 0x29, 0x4d, 0x8a, 0x7e, 0x46,
+	      0xaf, 0x64, 0x1a, 0x3b, 0x8c, 0x96, 0x08, 0x90, 0x0d, 0x93,
+	      0x33, 0xbb, 0x11, 0xab, 0xd8, 0x0b, 0x65, 0xb7, 0x20, 0xa4,
+	      0x9c, 0x03, 0xf0, 0xb4, 0x80, 0x22, 0x02, 0x97, 0x26, 0x65,
+	      0x06, 0x3d, 0x39, 0x81, 0xb3, 0xd2, 0x23, 0xcd, 0xf8, 0xea,
+	      0x0e, 0x3f, 0xa5, 0x16, 0x49, 0x9a, 0x19, 0x84, 0x78, 0xf7,
+	      0x9c, 0x91, 0x53, 0xc4, 0x62, 0x3c, 0xba, 0xa4, 0x4e, 0x90,
+	      0xc6, 0x89, 0xc7, 0x51, 0x39, 0x8f, 0x50, 0x75, 0x94, 0x24,
+	      0x02, 0xaa, 0xa8, 0x60, 0xd2, 0x95, 0x6b, 0xa9, 0x7a, 0x57,
+	      0xa9, 0x8f, 0xd8, 0xf8, 0xd5, 0x1b, 0xc0, 0x32, 0x46, 0x9b,
+	      0xb0, 0x9b, 0x46, 0xfb, 0x31, 0x70, 0xfd, 0xac, 0x3b, 0x42,
+	      0xa1, 0x3e, 0x84, 0xee, 0xe9, 0x52, 0x6d, 0x49, 0x3a, 0xd1,
+	      0x22, 0x37, 0xb7, 0x29, 0x16, 0x15, 0x11, 0x91, 0x2b, 0x22,
+	      0x9c, 0xcf, 0xb0, 0xaf, 0x88, 0xed, 0x55, 0x30, 0x9c, 0x0a,
+	      0x0a, 0x6a, 0x79, 0x33, 0x15, 0x25, 0x9b, 0xcc, 0x08, 0x2d,
+	      0x45, 0x57, 0x0d, 0xb4, 0xa2, 0x68, 0xc4, 0x62, 0x66, 0x9e,
+	      0x67, 0x92, 0x46, 0x6d, 0x8a, 0xe2, 0x46, 0x1d, 0x8d, 0x8f,
+	      0xdc, 0xe3, 0xb3, 0x80, 0x2f, 0xf1, 0x11, 0xb1, 0x28, 0xad,
+	      0xea, 0x90, 0xb4, 0x59, 0x96, 0xa2, 0x62, 0xe2, 0xdc, 0x55,
+	      0x01, 0xd2, 0xd4, 0xdd, 0xec, 0x71, 0x8a, 0x91, 0xad, 0xf6,
+	      0xf2, 0x0a, 0x5b, 0x8b, 0x40, 0x47, 0xd4, 0xd8, 0xd0, 0x53,
+	      0xee, 0x39, 0x98, 0x5e, 0xb1, 0x54, 0x69, 0x4a, 0xb2, 0xeb,
+	      0xc4, 0x09, 0x02, 0x00, 0xb4, 0x5c, 0x26, 0x4d, 0x40, 0xae,
+	      0x49, 0x05 ),
+       DATA ( 0x63, 0x61, 0x66, 0x61, 0x64, 0x63, 0x61, 0x64, 0x61, 0x63,
+	      0x61, 0x61, 0x63, 0x69, 0x61, 0x62, 0x65, 0x6d, 0x65, 0x63,
+	      0x6e, 0x61, 0x69, 0x62, 0x61, 0x61, 0x62, 0x68, 0x62, 0x65,
+	      0x66, 0x63, 0x65, 0x61, 0x61, 0x62, 0x66, 0x63, 0x62, 0x65,
+	      0x64, 0x62, 0x68, 0x66, 0x62, 0x65, 0x64, 0x6a, 0x67, 0x62,
+	      0x6f, 0x61, 0x63, 0x67, 0x61, 0x64, 0x61, 0x66, 0x67, 0x65,
+	      0x6a, 0x62, 0x66, 0x65, 0x65, 0x64, 0x69, 0x6c, 0x64, 0x66,
+	      0x61, 0x66, 0x66, 0x70, 0x69, 0x62, 0x63, 0x66, 0x61, 0x64,
+	      0x61, 0x61, 0x61, 0x67, 0x61, 0x62, 0x63, 0x6a, 0x61, 0x64,
+	      0x65, 0x6a, 0x68, 0x6a, 0x62, 0x63, 0x63, 0x6a, 0x6d, 0x61,
+	      0x62, 0x62, 0x62, 0x64, 0x65, 0x62, 0x61, 0x63, 0x63, 0x65,
+	      0x6d, 0x66, 0x64, 0x65, 0x66, 0x61, 0x6b, 0x68, 0x6a, 0x68,
+	      0x63, 0x63, 0x61, 0x66, 0x61, 0x61, 0x62, 0x61, 0x63, 0x61,
+	      0x61, 0x61, 0x61, 0x63, 0x61, 0x6a, 0x65, 0x61, 0x62, 0x63,
+	      0x63, 0x61, 0x69, 0x70, 0x64, 0x64, 0x61, 0x61, 0x63, 0x62,
+	      0x69, 0x61, 0x61, 0x6d, 0x64, 0x61, 0x64, 0x61, 0x64, 0x6e,
+	      0x6a, 0x66, 0x62, 0x63, 0x61, 0x68, 0x64, 0x68, 0x63, 0x62,
+	      0x68, 0x6f, 0x69, 0x68, 0x68, 0x67, 0x62, 0x64, 0x63, 0x61,
+	      0x61, 0x62, 0x62, 0x66, 0x6d, 0x64, 0x6c, 0x6f, 0x6d, 0x63,
+	      0x62, 0x62, 0x62, 0x62, 0x65, 0x6b, 0x69, 0x64, 0x66, 0x68,
+	      0x61, 0x66, 0x6b, 0x68, 0x67, 0x64, 0x62, 0x68, 0x63, 0x68,
+	      0x6e, 0x63, 0x63, 0x6c, 0x67, 0x62, 0x61, 0x61, 0x6b, 0x68,
+	      0x61, 0x69, 0x6f, 0x66, 0x63, 0x65, 0x61, 0x61, 0x6e, 0x66,
+	      0x64, 0x6c, 0x63, 0x6a, 0x69, 0x62, 0x62, 0x62, 0x62, 0x65,
+	      0x62, 0x63, 0x61, 0x6b, 0x63, 0x64, 0x65, 0x6b, 0x63, 0x6b,
+	      0x64, 0x64, 0x64, 0x61, 0x63, 0x62, 0x61, 0x68, 0x62, 0x64,
+	      0x67, 0x65, 0x63, 0x64, 0x65, 0x68, 0x61, 0x65, 0x62, 0x62,
+	      0x68, 0x64, 0x65, 0x67, 0x6b, 0x64, 0x65, 0x64, 0x64, 0x66,
+	      0x64, 0x64, 0x64, 0x6c, 0x66, 0x6a, 0x6c, 0x62, 0x65, 0x6c,
+	      0x69, 0x61, 0x61, 0x64, 0x61, 0x62, 0x61, 0x66, 0x68, 0x6b,
+	      0x61, 0x67, 0x66, 0x61, 0x6a, 0x6d, 0x62, 0x6d, 0x63, 0x64,
+	      0x70, 0x69, 0x61, 0x63, 0x64, 0x63, 0x62, 0x63, 0x67, 0x61,
+	      0x65, 0x63, 0x61, 0x63, 0x65, 0x64, 0x61, 0x6f, 0x68, 0x6e,
+	      0x61, 0x62, 0x61, 0x68, 0x62, 0x61, 0x63, 0x6b, 0x68, 0x62,
+	      0x61, 0x6b, 0x65, 0x66, 0x61, 0x61, 0x66, 0x63, 0x61, 0x6c,
+	      0x66, 0x68, 0x61, 0x69, 0x61, 0x69, 0x64, 0x63, 0x65, 0x6c,
+	      0x62, 0x61, 0x64, 0x62, 0x61, 0x61, 0x61, 0x62, 0x62, 0x62,
+	      0x67, 0x62, 0x64, 0x62, 0x63, 0x61, 0x62, 0x61, 0x67, 0x65,
+	      0x62, 0x64, 0x6c, 0x61, 0x68, 0x63, 0x64, 0x69, 0x63, 0x64,
+	      0x66, 0x6f, 0x63, 0x69, 0x67, 0x66, 0x63, 0x63, 0x61, 0x61,
+	      0x61, 0x67, 0x62, 0x61, 0x61, 0x69, 0x6a, 0x66, 0x62, 0x62,
+	      0x62, 0x64, 0x61, 0x64, 0x62, 0x6d, 0x6e, 0x64, 0x62, 0x6d,
+	      0x62, 0x63, 0x61, 0x63, 0x64, 0x64, 0x62, 0x64, 0x61, 0x62,
+	      0x61, 0x63, 0x61, 0x61, 0x62, 0x62, 0x65, 0x64, 0x67, 0x66,
+	      0x67, 0x6a, 0x63, 0x63, 0x6f, 0x61, 0x67, 0x66, 0x61, 0x69,
+	      0x6a, 0x65, 0x67, 0x68, 0x61, 0x64, 0x64, 0x69, 0x68, 0x69,
+	      0x65, 0x6a, 0x66, 0x66, 0x62, 0x61, 0x61, 0x63, 0x61, 0x69,
+	      0x65, 0x65, 0x65, 0x66, 0x64, 0x61, 0x68, 0x67, 0x64, 0x64,
+	      0x66, 0x61, 0x67, 0x62, 0x61, 0x62, 0x67, 0x62, 0x67, 0x6e,
+	      0x64, 0x63, 0x64, 0x66, 0x67, 0x65, 0x66, 0x61, 0x61, 0x62,
+	      0x67, 0x62, 0x65, 0x61, 0x61, 0x62, 0x66, 0x66, 0x66, 0x62,
+	      0x64, 0x64, 0x64, 0x61, 0x6a, 0x62, 0x6e, 0x6c, 0x61, 0x64,
+	      0x68, 0x6d, 0x64, 0x62, 0x62, 0x6c, 0x62, 0x65, 0x61, 0x64,
+	      0x6d, 0x61, 0x68, 0x64, 0x6a, 0x66, 0x62, 0x6b, 0x64, 0x61,
+	      0x61, 0x64, 0x64, 0x62, 0x61, 0x63, 0x63, 0x69, 0x61, 0x67,
+	      0x69, 0x61, 0x6c, 0x67, 0x6b, 0x62, 0x63, 0x63, 0x70, 0x65,
+	      0x63, 0x63, 0x62, 0x61, 0x61, 0x69, 0x62, 0x6c, 0x62, 0x62,
+	      0x64, 0x62, 0x63, 0x6d, 0x6a, 0x68, 0x65, 0x6b, 0x6c, 0x65,
+	      0x67, 0x61, 0x67, 0x64, 0x67, 0x66, 0x62, 0x61, 0x6c, 0x61,
+	      0x64, 0x63, 0x62, 0x67, 0x6e, 0x62, 0x66, 0x62, 0x65, 0x63,
+	      0x61, 0x61, 0x62, 0x6b, 0x64, 0x62, 0x6b, 0x70, 0x64, 0x61,
+	      0x62, 0x61, 0x63, 0x61, 0x62, 0x62, 0x65, 0x6a, 0x67, 0x63,
+	      0x63, 0x64, 0x63, 0x63, 0x61, 0x62, 0x6d, 0x61, 0x64, 0x65,
+	      0x69, 0x62, 0x62, 0x62, 0x63, 0x64, 0x6d, 0x69, 0x6a, 0x61,
+	      0x61, 0x67, 0x6b, 0x64, 0x65, 0x61, 0x63, 0x6c, 0x69, 0x69,
+	      0x6e, 0x62, 0x61, 0x61, 0x64, 0x66, 0x6c, 0x67, 0x66, 0x67,
+	      0x64, 0x65, 0x61, 0x68, 0x62, 0x6b, 0x66, 0x62, 0x61, 0x62,
+	      0x66, 0x66, 0x61, 0x61, 0x64, 0x65, 0x63, 0x62, 0x65, 0x61,
+	      0x62, 0x64, 0x6d, 0x66, 0x6a, 0x64, 0x62, 0x62, 0x6d, 0x66,
+	      0x62, 0x61, 0x64, 0x66, 0x63, 0x62, 0x66, 0x6b, 0x62, 0x61,
+	      0x63, 0x63, 0x66, 0x62, 0x68, 0x67, 0x64, 0x62, 0x6e, 0x62,
+	      0x68, 0x62, 0x62, 0x67, 0x62, 0x6d, 0x64, 0x62, 0x62, 0x63,
+	      0x66, 0x6d, 0x61, 0x63, 0x62, 0x6e, 0x61, 0x61, 0x61, 0x63,
+	      0x6b, 0x6a, 0x67, 0x70, 0x6c, 0x63, 0x62, 0x6c, 0x67, 0x61,
+	      0x66, 0x63, 0x63, 0x63, 0x62, 0x61, 0x62, 0x63, 0x6d, 0x61,
+	      0x6d, 0x62, 0x63, 0x69, 0x69, 0x63, 0x61, 0x64, 0x63, 0x6b,
+	      0x62, 0x63, 0x6b, 0x61, 0x63, 0x68, 0x67, 0x61, 0x61, 0x61,
+	      0x6b, 0x62, 0x67, 0x6b, 0x63, 0x62, 0x6d, 0x65, 0x62, 0x67,
+	      0x63, 0x62, 0x61, 0x67, 0x6b, 0x66, 0x6c, 0x61, 0x62, 0x64,
+	      0x6d, 0x6d, 0x63, 0x62, 0x63, 0x64, 0x6c, 0x62, 0x68, 0x67,
+	      0x69, 0x68, 0x65, 0x63, 0x63, 0x63, 0x68, 0x61, 0x62, 0x67,
+	      0x62, 0x61, 0x61, 0x65, 0x63, 0x6f, 0x6a, 0x6f, 0x62, 0x61,
+	      0x61, 0x64, 0x67, 0x64, 0x62, 0x63, 0x65, 0x66, 0x67, 0x69,
+	      0x66, 0x61, 0x69, 0x62, 0x65, 0x63, 0x67, 0x62, 0x62, 0x62,
+	      0x61, 0x6a, 0x65, 0x63, 0x63, 0x70, 0x64, 0x62, 0x68, 0x66,
+	      0x70, 0x61, 0x64, 0x68, 0x69, 0x6b, 0x61, 0x62, 0x61, 0x62,
+	      0x6e, 0x65, 0x6c, 0x63, 0x6a, 0x64, 0x62, 0x68, 0x6c, 0x61,
+	      0x65, 0x65, 0x62, 0x63, 0x61, 0x62, 0x62, 0x65, 0x66, 0x62,
+	      0x61, 0x63, 0x66, 0x62, 0x62, 0x62, 0x68, 0x65, 0x61, 0x61,
+	      0x63, 0x65, 0x66, 0x61, 0x61, 0x66, 0x63, 0x62, 0x62, 0x6d,
+	      0x62, 0x65, 0x63, 0x63, 0x6a, 0x70, 0x63, 0x62, 0x67, 0x62,
+	      0x61, 0x6b, 0x63, 0x68, 0x63, 0x6a, 0x64, 0x61, 0x61, 0x65,
+	      0x66, 0x6b, 0x61, 0x65, 0x63, 0x64, 0x61, 0x62, 0x64, 0x6b,
+	      0x61, 0x64, 0x68, 0x6d, 0x62, 0x61, 0x6c, 0x6e, 0x64, 0x61,
+	      0x6b, 0x63, 0x6b, 0x65, 0x69, 0x61, 0x68, 0x62, 0x63, 0x69,
+	      0x69, 0x62, 0x62, 0x63, 0x64, 0x63, 0x61, 0x62, 0x67, 0x6b,
+	      0x61, 0x65, 0x67, 0x61, 0x69, 0x61, 0x65, 0x65, 0x65, 0x62,
+	      0x63, 0x65, 0x63, 0x66, 0x64, 0x63, 0x61, 0x65, 0x64, 0x62,
+	      0x67, 0x68, 0x64, 0x62, 0x64, 0x61, 0x61, 0x63, 0x61, 0x63,
+	      0x64, 0x61, 0x66, 0x61, 0x67, 0x68, 0x64, 0x61, 0x64, 0x63,
+	      0x6d, 0x61, 0x69, 0x70, 0x67, 0x68, 0x62, 0x6f, 0x64, 0x6d,
+	      0x6b, 0x61, 0x68, 0x6c, 0x61, 0x63, 0x67, 0x61, 0x6b, 0x62,
+	      0x68, 0x61, 0x64, 0x6b, 0x62, 0x62, 0x64, 0x63, 0x61, 0x62,
+	      0x61, 0x6c, 0x66, 0x6b, 0x62, 0x68, 0x61, 0x64, 0x66, 0x63,
+	      0x6a, 0x65, 0x65, 0x6a, 0x61, 0x70, 0x65, 0x63, 0x68, 0x62,
+	      0x70, 0x65, 0x63, 0x67, 0x64, 0x62, 0x67, 0x61, 0x68, 0x62,
+	      0x66, 0x6f, 0x65, 0x66, 0x62, 0x61, 0x61, 0x61, 0x65, 0x63,
+	      0x64, 0x6b, 0x61, 0x62, 0x66, 0x61, 0x61, 0x63, 0x61, 0x63,
+	      0x62, 0x65, 0x65, 0x62, 0x65, 0x64, 0x61, 0x6c, 0x62, 0x61,
+	      0x61, 0x66, 0x6a, 0x68, 0x63, 0x62, 0x61, 0x66, 0x65, 0x63,
+	      0x66, 0x64, 0x6c, 0x67, 0x62, 0x6b, 0x61, 0x64, 0x63, 0x62,
+	      0x61, 0x68, 0x61, 0x65, 0x6c, 0x61, 0x62, 0x65, 0x64, 0x66,
+	      0x68, 0x62, 0x62, 0x62, 0x61, 0x6a, 0x68, 0x67, 0x61, 0x69,
+	      0x67, 0x64, 0x67, 0x64, 0x62, 0x61, 0x62, 0x61, 0x63, 0x67,
+	      0x66, 0x69, 0x67, 0x62, 0x65, 0x63, 0x68, 0x64, 0x62, 0x66,
+	      0x6d, 0x62, 0x6a, 0x61, 0x62, 0x62, 0x67, 0x6c, 0x67, 0x63,
+	      0x6a, 0x63, 0x62, 0x6b, 0x65, 0x66, 0x66, 0x6f, 0x64, 0x69,
+	      0x66, 0x69, 0x63, 0x67, 0x65, 0x62, 0x62, 0x65, 0x61, 0x6b,
+	      0x61, 0x61, 0x61, 0x6c, 0x63, 0x61, 0x61, 0x61, 0x66, 0x66,
+	      0x66, 0x67, 0x61, 0x65, 0x63, 0x68, 0x68, 0x6a, 0x61, 0x6a,
+	      0x6b, 0x6c, 0x61, 0x62, 0x61, 0x61, 0x69, 0x68, 0x66, 0x69,
+	      0x65, 0x62, 0x61, 0x61, 0x67, 0x62, 0x63, 0x63, 0x61, 0x62,
+	      0x62, 0x67, 0x63, 0x63, 0x6d, 0x64, 0x69, 0x65, 0x61, 0x63,
+	      0x63, 0x68, 0x63, 0x66, 0x64, 0x62, 0x69, 0x61, 0x68, 0x62,
+	      0x61, 0x62, 0x67, 0x6e, 0x61, 0x64, 0x64, 0x68, 0x62, 0x64,
+	      0x63, 0x69, 0x62, 0x6c, 0x62, 0x62, 0x66, 0x64, 0x61, 0x66,
+	      0x61, 0x68, 0x66, 0x68, 0x65, 0x63, 0x63, 0x63, 0x6a, 0x61,
+	      0x6a, 0x61, 0x62, 0x62, 0x6b, 0x64, 0x63, 0x6a, 0x62, 0x64,
+	      0x64, 0x67, 0x67, 0x66, 0x63, 0x63, 0x61, 0x69, 0x66, 0x67,
+	      0x62, 0x63, 0x68, 0x65, 0x61, 0x64, 0x6a, 0x62, 0x62, 0x62,
+	      0x66, 0x69, 0x61, 0x61, 0x62, 0x63, 0x64, 0x61, 0x63, 0x62,
+	      0x6e, 0x67, 0x61, 0x6d, 0x61, 0x63, 0x6f, 0x68, 0x67, 0x63,
+	      0x62, 0x66, 0x61, 0x62, 0x63, 0x61, 0x63, 0x68, 0x66, 0x64,
+	      0x66, 0x64, 0x61, 0x65, 0x63, 0x67, 0x6b, 0x63, 0x65, 0x67,
+	      0x63, 0x62, 0x67, 0x6a, 0x68, 0x66, 0x69, 0x66, 0x66, 0x64,
+	      0x62, 0x65, 0x61, 0x63, 0x68, 0x67, 0x65, 0x62, 0x63, 0x64,
+	      0x65, 0x63, 0x66, 0x6c, 0x62, 0x66, 0x68, 0x63, 0x64, 0x6e,
+	      0x61, 0x64, 0x61, 0x68, 0x6c, 0x64, 0x61, 0x65, 0x64, 0x67,
+	      0x64, 0x66, 0x69, 0x64, 0x63, 0x6d, 0x62, 0x66, 0x63, 0x67,
+	      0x61, 0x6f, 0x63, 0x61, 0x62, 0x63, 0x61, 0x63, 0x63, 0x66,
+	      0x63, 0x62, 0x62, 0x67, 0x6c, 0x64, 0x62, 0x68, 0x63, 0x62,
+	      0x61, 0x68, 0x68, 0x66, 0x64, 0x65, 0x62, 0x6d, 0x63, 0x66,
+	      0x68, 0x68, 0x64, 0x62, 0x65, 0x61, 0x69, 0x63, 0x69, 0x62,
+	      0x63, 0x62, 0x63, 0x62, 0x61, 0x67, 0x62, 0x62, 0x62, 0x64,
+	      0x63, 0x66, 0x66, 0x63, 0x6c, 0x69, 0x61, 0x69, 0x6b, 0x68,
+	      0x61, 0x69, 0x66, 0x61, 0x61, 0x6d, 0x66, 0x62, 0x61, 0x61,
+	      0x62, 0x68, 0x63, 0x61, 0x6b, 0x68, 0x61, 0x6a, 0x65, 0x68,
+	      0x66, 0x6a, 0x68, 0x69, 0x62, 0x66, 0x64, 0x67, 0x63, 0x6a,
+	      0x65, 0x62, 0x62, 0x61, 0x64, 0x61, 0x64, 0x61, 0x64, 0x64,
+	      0x64, 0x69, 0x61, 0x69, 0x64, 0x65, 0x66, 0x69, 0x63, 0x63,
+	      0x6d, 0x61, 0x66, 0x66, 0x61, 0x65, 0x66, 0x6c, 0x63, 0x6f,
+	      0x64, 0x64, 0x6b, 0x61, 0x67, 0x65, 0x63, 0x69, 0x63, 0x64,
+	      0x64, 0x68, 0x62, 0x63, 0x63, 0x65, 0x69, 0x62, 0x69, 0x63,
+	      0x64, 0x62, 0x64, 0x6e, 0x66, 0x68, 0x63, 0x63, 0x62, 0x65,
+	      0x66, 0x68, 0x61, 0x67, 0x6a, 0x64, 0x61, 0x62, 0x61, 0x62,
+	      0x6b, 0x65, 0x66, 0x68, 0x6b, 0x65, 0x65, 0x65, 0x66, 0x65,
+	      0x66, 0x62, 0x66, 0x64, 0x67, 0x61, 0x62, 0x61, 0x68, 0x6b,
+	      0x66, 0x63, 0x69, 0x68, 0x65, 0x62, 0x62, 0x63, 0x63, 0x63,
+	      0x66, 0x6c, 0x61, 0x65, 0x61, 0x61, 0x68, 0x65, 0x6b, 0x64,
+	      0x61, 0x63, 0x65, 0x6c, 0x6f, 0x64, 0x63, 0x61, 0x66, 0x62,
+	      0x61, 0x61, 0x61, 0x66, 0x61, 0x6d, 0x61, 0x6a, 0x61, 0x61,
+	      0x67, 0x62, 0x67, 0x62, 0x61, 0x68, 0x67, 0x69, 0x67, 0x61,
+	      0x65, 0x67, 0x64, 0x6c, 0x62, 0x6d, 0x67, 0x61, 0x61, 0x66,
+	      0x68, 0x61, 0x62, 0x67, 0x61, 0x69, 0x64, 0x61, 0x63, 0x65,
+	      0x63, 0x66, 0x61, 0x68, 0x63, 0x66, 0x65, 0x63, 0x63, 0x68,
+	      0x6c, 0x68, 0x65, 0x62, 0x61, 0x6e, 0x66, 0x69, 0x63, 0x65,
+	      0x6e, 0x69, 0x65, 0x62, 0x63, 0x6a, 0x63, 0x66, 0x65, 0x6b,
+	      0x68, 0x62, 0x61, 0x62, 0x63, 0x65, 0x68, 0x6a, 0x61, 0x69,
+	      0x68, 0x6a, 0x65, 0x62, 0x69, 0x68, 0x66, 0x6b, 0x63, 0x61,
+	      0x65, 0x68, 0x62, 0x67, 0x6c, 0x62, 0x65, 0x66, 0x64, 0x62,
+	      0x62, 0x67, 0x68, 0x64, 0x61, 0x68, 0x68, 0x62, 0x65, 0x6b,
+	      0x6a, 0x64, 0x64, 0x65, 0x62, 0x62, 0x62, 0x66, 0x63, 0x65,
+	      0x63, 0x64, 0x61, 0x61, 0x70, 0x63, 0x61, 0x66, 0x68, 0x61,
+	      0x65, 0x63, 0x64, 0x61, 0x61, 0x70, 0x6a, 0x64, 0x65, 0x62,
+	      0x68, 0x63, 0x6c, 0x67, 0x68, 0x6d, 0x62, 0x61, 0x62, 0x62,
+	      0x61, 0x61, 0x65, 0x6a, 0x64, 0x6c, 0x6b, 0x61, 0x65, 0x63,
+	      0x61, 0x6d, 0x62, 0x65, 0x66, 0x6d, 0x66, 0x63, 0x64, 0x61,
+	      0x6d, 0x70, 0x62, 0x61, 0x62, 0x63, 0x6b, 0x6b, 0x69, 0x61,
+	      0x68, 0x67, 0x66, 0x6f, 0x61, 0x61, 0x67, 0x6c, 0x66, 0x62,
+	      0x65, 0x67, 0x61, 0x63, 0x62, 0x61, 0x64, 0x62, 0x62, 0x61 ) );
+
+/** Single repeated byte (long matches via repeat offsets) */
+ZSTD ( runs,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x60, 0x00, 0x0f, 0x45, 0x00, 0x00,
+	      0x08, 0x41, 0x01, 0x00, 0xfc, 0xf7, 0x81, 0x10 ),
+       DATA ( 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
+	      0x41, 0x41, 0x41, 0x41, 0x41, 0x41 ) );
+
+/** Single repeated byte (RLE block) */
+ZSTD ( rle,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x20, 0x0d, 0x6b, 0x00, 0x00, 0x5a ),
+       DATA ( 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a, 0x5a,
+	      0x5a, 0x5a, 0x5a ) );
+
+/** Concatenated frames with an intervening skippable frame */
+ZSTD ( multi,
+       DATA ( 0x28, 0xb5, 0x2f, 0xfd, 0x64, 0x1c, 0x01, 0xb5, 0x01, 0x00,
+	      0xd4, 0x02, 0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63,
+	      0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f,
+	      0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76,
+	      0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a,
+	      0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20, 0x01, 0x00, 0x65,
+	      0x87, 0xaa, 0x2a, 0x03, 0x6a, 0x80, 0x60, 0xb8, 0x5e, 0x2a,
+	      0x4d, 0x18, 0x04, 0x00, 0x00, 0x00, 0x6a, 0x75, 0x6e, 0x6b,
+	      0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x0b, 0x59, 0x00, 0x00, 0x48,
+	      0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64,
+	      0xd8, 0x76, 0xb3, 0x12 ),
+       DATA ( 0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x74, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+	      0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20,
+	      0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72,
+	      0x20, 0x74, 0x68, 0x65, 0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20,
+	      0x64, 0x6f, 0x67, 0x2e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x71,
+	      0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+	      0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73,
+	      0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	      0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e, 0x20,
+	      0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f, 0x72, 0x6c,
+	      0x64 ) );
+
+/**
+ * Report Zstandard test result
+ *
+ * @v test		Zstandard test
+ * @v file		Test code file
+ * @v line		Test code line
+ */
+static void zstd_okx ( struct zstd_test *test, const char *file,
+		       unsigned int line ) {
+	struct image *image;
+	struct image *extracted;
+
+	/* Construct compressed image */
+	image = image_memory ( test->compressed_name, test->compressed,
+			       test->compressed_len );
+	okx ( image != NULL, file, line );
+	okx ( image->len == test->compressed_len, file, line );
+
+	/* Check type detection */
+	okx ( image->type == &zstd_image_type, file, line );
+
+	/* Extract archive image */
+	okx ( image_extract ( image, NULL, &extracted ) == 0, file, line );
+
+	/* Verify extracted image content */
+	okx ( extracted->len == test->expected_len, file, line );
+	okx ( memcmp ( extracted->data, test->expected,
+		       test->expected_len ) == 0, file, line );
+
+	/* Verify extracted image name */
+	okx ( strcmp ( extracted->name, test->expected_name ) == 0,
+	      file, line );
+
+	/* Unregister images */
+	unregister_image ( extracted );
+	unregister_image ( image );
+}
+#define zstd_ok( test ) zstd_okx ( test, __FILE__, __LINE__ )
+
+/**
+ * Perform Zstandard self-test
+ *
+ */
+static void zstd_test_exec ( void ) {
+
+	zstd_ok ( &hello_world );
+	zstd_ok ( &fox );
+	zstd_ok ( &lorem );
+	zstd_ok ( &skew );
+	zstd_ok ( &runs );
+	zstd_ok ( &rle );
+	zstd_ok ( &multi );
+}
+
+/** Zstandard self-test */
+struct self_test zstd_test __self_test = {
+	.name = "zstd",
+	.exec = zstd_test_exec,
+};
@@ -27,6 +27,8 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdio.h>
 #include <errno.h>
 #include <ipxe/netdevice.h>
+#include <ipxe/job.h>
+#include <ipxe/monojob.h>
 #include <ipxe/vlan.h>
 #include <ipxe/dhcp.h>
 #include <ipxe/settings.h>
@@ -403,9 +405,11 @@ int netboot ( struct net_device *netdev ) {
 		goto err_ifopen;
 	ifstat ( netdev );
 
-	/* Configure device */
-	if ( ( rc = ifconf ( netdev, NULL, 0 ) ) != 0 )
-		goto err_dhcp;
+	/* Configure device, unless a usable configuration already exists */
+	if ( ! netdev_configuration_ok ( netdev ) ) {
+		if ( ( rc = ifconf ( netdev, NULL, 0 ) ) != 0 )
+			goto err_dhcp;
+	}
 	route();
 
 	/* Try PXE menu boot, if applicable */
@@ -532,6 +536,103 @@ void set_autoboot_ll_addr ( const void *ll_addr, size_t len,
 	is_autoboot_device = is_autoboot_ll_addr;
 }
 
+/** A concurrent configuration poller */
+struct autoconf_poller {
+	/** Job control interface */
+	struct interface job;
+};
+
+/**
+ * Check progress of concurrent network device configuration
+ *
+ * @v autoconf		Concurrent configuration poller
+ * @v progress		Progress report to fill in
+ * @ret ongoing_rc	Ongoing job status code (if known)
+ */
+static int autoconf_progress ( struct autoconf_poller *autoconf,
+			       struct job_progress *progress __unused ) {
+	struct net_device *netdev;
+	unsigned int pending = 0;
+
+	/* Scan for a device with a usable completed configuration */
+	for_each_netdev ( netdev ) {
+
+		/* Skip any non-matching devices, if applicable */
+		if ( is_autoboot_device && ( ! is_autoboot_device ( netdev ) ) )
+			continue;
+
+		/* Skip devices which are not open */
+		if ( ! netdev_is_open ( netdev ) )
+			continue;
+
+		/* Count devices still attempting configuration */
+		if ( netdev_configuration_in_progress ( netdev ) ) {
+			pending++;
+			continue;
+		}
+
+		/* Complete as soon as any device becomes usable */
+		if ( netdev_configuration_ok ( netdev ) ) {
+			intf_close ( &autoconf->job, 0 );
+			return 0;
+		}
+	}
+
+	/* Fail if no devices are still attempting configuration */
+	if ( ! pending )
+		intf_close ( &autoconf->job, -EADDRNOTAVAIL );
+
+	return 0;
+}
+
+/** Concurrent configuration poller interface operations */
+static struct interface_operation autoconf_op[] = {
+	INTF_OP ( job_progress, struct autoconf_poller *, autoconf_progress ),
+};
+
+/** Concurrent configuration poller interface descriptor */
+static struct interface_descriptor autoconf_desc =
+	INTF_DESC ( struct autoconf_poller, job, autoconf_op );
+
+/**
+ * Configure all autoboot devices concurrently
+ *
+ * Open each matching network device and start configuration on all of
+ * them at once, then wait until any one device has been successfully
+ * configured.  This avoids paying the link-up and DHCP timeouts
+ * serially for each device that turns out to be unusable.
+ */
+static void autoconf ( void ) {
+	static struct autoconf_poller poller = {
+		.job = INTF_INIT ( autoconf_desc ),
+	};
+	struct net_device *netdev;
+	unsigned int started = 0;
+
+	/* Open all matching devices and begin configuration */
+	for_each_netdev ( netdev ) {
+
+		/* Skip any non-matching devices, if applicable */
+		if ( is_autoboot_device && ( ! is_autoboot_device ( netdev ) ) )
+			continue;
+
+		/* Open device and start configuration */
+		if ( ifopen ( netdev ) != 0 )
+			continue;
+		if ( netdev_configure_all ( netdev ) != 0 )
+			continue;
+		printf ( "%s%s", ( started ? ", " : "Configuring " ),
+			 netdev->name );
+		started++;
+	}
+	if ( ! started )
+		return;
+
+	/* Wait for any device to be successfully configured */
+	intf_plug_plug ( &monojob, &poller.job );
+	monojob_wait ( "", 0 );
+}
+
 /**
  * Boot the system
  */
@@ -539,9 +640,15 @@ static int autoboot ( void ) {
 	struct net_device *netdev;
 	int rc = -ENODEV;
 
-	/* Try booting from each network device.  If we have a
-	 * specified autoboot device location, then use only devices
-	 * matching that location.
+	/* Configure all matching devices concurrently, so that the
+	 * time spent waiting for link-up and DHCP on unusable devices
+	 * overlaps rather than accumulates.
+	 */
+	autoconf();
+
+	/* Try booting from any device which has been successfully
+	 * configured.  If we have a specified autoboot device
+	 * location, then use only devices matching that location.
 	 */
 	for_each_netdev ( netdev ) {
 
@@ -549,6 +656,27 @@ static int autoboot ( void ) {
 		if ( is_autoboot_device && ( ! is_autoboot_device ( netdev ) ) )
 			continue;
 
+		/* Skip devices which were not successfully configured */
+		if ( ! ( netdev_is_open ( netdev ) &&
+			 netdev_configuration_ok ( netdev ) ) )
+			continue;
+
+		/* Attempt booting from this device */
+		rc = netboot ( netdev );
+	}
+
+	/* Try booting from each remaining network device */
+	for_each_netdev ( netdev ) {
+
+		/* Skip any non-matching devices, if applicable */
+		if ( is_autoboot_device && ( ! is_autoboot_device ( netdev ) ) )
+			continue;
+
+		/* Skip devices which have already been attempted */
+		if ( netdev_is_open ( netdev ) &&
+		     netdev_configuration_ok ( netdev ) )
+			continue;
+
 		/* Attempt booting from this device */
 		rc = netboot ( netdev );
 	}
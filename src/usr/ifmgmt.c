@@ -27,7 +27,11 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdio.h>
 #include <unistd.h>
 #include <errno.h>
+#include <byteswap.h>
 #include <ipxe/console.h>
+#include <ipxe/keys.h>
+#include <ipxe/process.h>
+#include <ipxe/nap.h>
 #include <ipxe/netdevice.h>
 #include <ipxe/device.h>
 #include <ipxe/job.h>
@@ -102,6 +106,36 @@ static void ifstat_errors ( struct net_device_stats *stats,
 	}
 }
 
+/**
+ * Print network device per-protocol breakdown
+ *
+ * @v stats		Network device statistics
+ * @v prefix		Message prefix
+ */
+static void ifstat_protos ( struct net_device_stats *stats,
+			    const char *prefix ) {
+	struct net_device_proto_stats *proto;
+	struct net_protocol *net_protocol;
+	unsigned int i;
+
+	for ( i = 0 ; i < ( sizeof ( stats->protos ) /
+			    sizeof ( stats->protos[0] ) ) ; i++ ) {
+		proto = &stats->protos[i];
+		if ( ! proto->packets )
+			continue;
+		net_protocol = net_find_protocol ( proto->net_proto );
+		if ( net_protocol ) {
+			printf ( "  [%s: %ld x %s, %ld bytes]\n", prefix,
+				 proto->packets, net_protocol->name,
+				 proto->bytes );
+		} else {
+			printf ( "  [%s: %ld x %04x, %ld bytes]\n", prefix,
+				 proto->packets, ntohs ( proto->net_proto ),
+				 proto->bytes );
+		}
+	}
+}
+
 /**
  * Print status of network device
  *
@@ -109,21 +143,98 @@ static void ifstat_errors ( struct net_device_stats *stats,
  */
 void ifstat ( struct net_device *netdev ) {
 	printf ( "%s: %s using %s on %s (%s) [%s]\n"
-		 "  [Link:%s%s, TX:%d TXE:%d RX:%d RXE:%d]\n",
+		 "  [Link:%s%s, TX:%d/%ld TXE:%d RX:%d/%ld RXE:%d]\n",
 		 netdev->name, netdev_addr ( netdev ),
 		 netdev->dev->driver_name, netdev->dev->name,
 		 netdev->ll_protocol->name,
 		 ( netdev_is_open ( netdev ) ? "open" : "closed" ),
 		 ( netdev_link_ok ( netdev ) ? "up" : "down" ),
 		 ( netdev_link_blocked ( netdev ) ? " (blocked)" : "" ),
-		 netdev->tx_stats.good, netdev->tx_stats.bad,
-		 netdev->rx_stats.good, netdev->rx_stats.bad );
+		 netdev->tx_stats.good, netdev->tx_stats.bytes,
+		 netdev->tx_stats.bad,
+		 netdev->rx_stats.good, netdev->rx_stats.bytes,
+		 netdev->rx_stats.bad );
 	if ( ! netdev_link_ok ( netdev ) ) {
 		printf ( "  [Link status: %s]\n",
 			 strerror ( netdev->link_rc ) );
 	}
 	ifstat_errors ( &netdev->tx_stats, "TXE" );
 	ifstat_errors ( &netdev->rx_stats, "RXE" );
+	ifstat_protos ( &netdev->tx_stats, "TXP" );
+	ifstat_protos ( &netdev->rx_stats, "RXP" );
+}
+
+/**
+ * Measure network device traffic rates
+ *
+ * Samples the cumulative statistics counters over the specified
+ * interval and reports packet and byte rates along with error deltas.
+ * The measurement is also recorded against the network device, from
+ * where it is exposed as the ${netX/txrate} and related settings.
+ *
+ * @v netdev		Network device
+ * @v interval		Sampling interval, in ticks
+ * @ret rc		Return status code
+ */
+int ifrate ( struct net_device *netdev, unsigned long interval ) {
+	struct net_device_rates *rates = &netdev->rates;
+	unsigned int tx_good;
+	unsigned int tx_bad;
+	unsigned long tx_bytes;
+	unsigned int rx_good;
+	unsigned int rx_bad;
+	unsigned long rx_bytes;
+	unsigned long start;
+	unsigned long elapsed;
+	int rc;
+
+	/* Ensure device is open */
+	if ( ( rc = ifopen ( netdev ) ) != 0 )
+		return rc;
+
+	/* Snapshot cumulative counters */
+	tx_good = netdev->tx_stats.good;
+	tx_bad = netdev->tx_stats.bad;
+	tx_bytes = netdev->tx_stats.bytes;
+	rx_good = netdev->rx_stats.good;
+	rx_bad = netdev->rx_stats.bad;
+	rx_bytes = netdev->rx_stats.bytes;
+
+	/* Poll for the duration of the sampling interval */
+	start = currticks();
+	while ( ( elapsed = ( currticks() - start ) ) < interval ) {
+		step();
+		if ( iskey() && ( getchar() == CTRL_C ) )
+			return -ECANCELED;
+		cpu_nap();
+	}
+
+	/* Calculate rates over the sampled interval */
+	if ( ! elapsed )
+		elapsed = 1;
+	rates->tx_pps = ( ( ( ( uint64_t ) ( netdev->tx_stats.good -
+					     tx_good ) ) *
+			    TICKS_PER_SEC ) / elapsed );
+	rates->tx_bps = ( ( ( ( uint64_t ) ( netdev->tx_stats.bytes -
+					     tx_bytes ) ) *
+			    TICKS_PER_SEC ) / elapsed );
+	rates->tx_bad = ( netdev->tx_stats.bad - tx_bad );
+	rates->rx_pps = ( ( ( ( uint64_t ) ( netdev->rx_stats.good -
+					     rx_good ) ) *
+			    TICKS_PER_SEC ) / elapsed );
+	rates->rx_bps = ( ( ( ( uint64_t ) ( netdev->rx_stats.bytes -
+					     rx_bytes ) ) *
+			    TICKS_PER_SEC ) / elapsed );
+	rates->rx_bad = ( netdev->rx_stats.bad - rx_bad );
+	rates->valid = 1;
+
+	/* Print measurement */
+	printf ( "%s: [TX: %ld pkt/s, %ld bytes/s, %d errors] "
+		 "[RX: %ld pkt/s, %ld bytes/s, %d errors]\n",
+		 netdev->name, rates->tx_pps, rates->tx_bps, rates->tx_bad,
+		 rates->rx_pps, rates->rx_bps, rates->rx_bad );
+
+	return 0;
 }
 
 /** Network device poller */
@@ -246,17 +357,29 @@ static int ifconf_progress ( struct ifpoller *ifpoller ) {
 	struct net_device_configuration *config;
 	int rc;
 
-	/* Do nothing unless configuration has completed */
-	if ( netdev_configuration_in_progress ( netdev ) )
-		return 0;
-
 	/* Terminate with appropriate overall return status code */
 	if ( configurator ) {
+
+		/* Do nothing unless configuration has completed */
+		if ( netdev_configuration_in_progress ( netdev ) )
+			return 0;
 		config = netdev_configuration ( netdev, configurator );
 		rc = config->rc;
+
 	} else {
-		rc = ( netdev_configuration_ok ( netdev ) ?
-		       0 : -EADDRNOTAVAIL_CONFIG );
+
+		/* Terminate as soon as any configurator succeeds,
+		 * rather than waiting for all configurators to
+		 * complete.  Any remaining configurators will
+		 * continue to run in the background.
+		 */
+		if ( netdev_configuration_ok ( netdev ) ) {
+			rc = 0;
+		} else if ( netdev_configuration_in_progress ( netdev ) ) {
+			return 0;
+		} else {
+			rc = -EADDRNOTAVAIL_CONFIG;
+		}
 	}
 	intf_close ( &ifpoller->job, rc );
 
@@ -28,6 +28,14 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <ipxe/refcnt.h>
+#include <ipxe/list.h>
+#include <ipxe/interface.h>
+#include <ipxe/job.h>
+#include <ipxe/process.h>
+#include <ipxe/console.h>
+#include <ipxe/keys.h>
+#include <ipxe/timer.h>
 #include <ipxe/image.h>
 #include <ipxe/downloader.h>
 #include <ipxe/monojob.h>
@@ -39,8 +47,80 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  * Image management
  *
+ * Images are downloaded either in the foreground (waiting for each
+ * download to complete before returning) or in the background, where
+ * multiple downloads run as concurrent jobs and a script later joins
+ * them all via imgwait().  Background downloads allow the link to be
+ * kept busy during the connection setup and server think-time gaps of
+ * each individual transfer, so that fetching a kernel, initrd, and
+ * firmware blobs costs roughly the time of the largest transfer
+ * rather than the sum of all of them.
  */
 
+/** Interval between keypress checks while waiting for downloads */
+#define IMGWAIT_CHECK_INTERVAL ( TICKS_PER_SEC / 4 )
+
+/** A background image download */
+struct imgdownload {
+	/** Reference count */
+	struct refcnt refcnt;
+	/** List of background downloads */
+	struct list_head list;
+	/** Job control interface */
+	struct interface job;
+	/** Image being downloaded */
+	struct image *image;
+	/** Overall status
+	 *
+	 * This is -EINPROGRESS while the download is still running.
+	 */
+	int rc;
+};
+
+/** List of background downloads */
+static LIST_HEAD ( imgdownloads );
+
+/**
+ * Free background download
+ *
+ * @v refcnt		Reference count
+ */
+static void imgdownload_free ( struct refcnt *refcnt ) {
+	struct imgdownload *imgdl =
+		container_of ( refcnt, struct imgdownload, refcnt );
+
+	image_put ( imgdl->image );
+	free ( imgdl );
+}
+
+/**
+ * Handle background download completion
+ *
+ * @v imgdl		Background download
+ * @v rc		Reason for close
+ */
+static void imgdownload_close ( struct imgdownload *imgdl, int rc ) {
+
+	/* Register image on success */
+	if ( rc == 0 )
+		rc = register_image ( imgdl->image );
+
+	/* Record overall status */
+	imgdl->rc = rc;
+
+	/* Shut down interfaces */
+	intf_shutdown ( &imgdl->job, rc );
+}
+
+/** Background download job control interface operations */
+static struct interface_operation imgdownload_job_op[] = {
+	INTF_OP ( intf_close, struct imgdownload *, imgdownload_close ),
+};
+
+/** Background download job control interface descriptor */
+static struct interface_descriptor imgdownload_job_desc =
+	INTF_DESC ( struct imgdownload, job, imgdownload_job_op );
+
 /**
  * Download a new image
  *
@@ -131,6 +211,224 @@ int imgdownload_string ( const char *uri_string, unsigned long timeout,
 	return rc;
 }
 
+/**
+ * Start downloading a new image in the background
+ *
+ * @v uri		URI
+ * @v image		Image to fill in
+ * @ret rc		Return status code
+ *
+ * The download runs as a background job: this function returns as
+ * soon as the download has started, and the image is registered
+ * automatically upon successful completion.  All outstanding
+ * background downloads may be joined via imgwait().
+ */
+int imgdownload_background ( struct uri *uri, struct image **image ) {
+	struct imgdownload *imgdl;
+	int rc;
+
+	/* Resolve URI */
+	uri = resolve_uri ( cwuri, uri );
+	if ( ! uri ) {
+		rc = -ENOMEM;
+		goto err_resolve_uri;
+	}
+
+	/* Allocate and initialise structure */
+	imgdl = zalloc ( sizeof ( *imgdl ) );
+	if ( ! imgdl ) {
+		rc = -ENOMEM;
+		goto err_alloc;
+	}
+	ref_init ( &imgdl->refcnt, imgdownload_free );
+	intf_init ( &imgdl->job, &imgdownload_job_desc, &imgdl->refcnt );
+	imgdl->rc = -EINPROGRESS;
+
+	/* Allocate image */
+	*image = alloc_image ( uri );
+	if ( ! *image ) {
+		rc = -ENOMEM;
+		goto err_alloc_image;
+	}
+	imgdl->image = image_get ( *image );
+
+	/* Create downloader */
+	if ( ( rc = create_downloader ( &imgdl->job, *image ) ) != 0 ) {
+		printf ( "Could not start download: %s\n", strerror ( rc ) );
+		goto err_create_downloader;
+	}
+
+	/* Add to list of background downloads (transferring our
+	 * reference), and drop the image's creation reference: the
+	 * image remains alive via the background download until it is
+	 * registered upon completion.
+	 */
+	list_add_tail ( &imgdl->list, &imgdownloads );
+	image_put ( *image );
+	uri_put ( uri );
+
+	return 0;
+
+ err_create_downloader:
+	image_put ( *image );
+ err_alloc_image:
+	ref_put ( &imgdl->refcnt );
+ err_alloc:
+	uri_put ( uri );
+ err_resolve_uri:
+	return rc;
+}
+
+/**
+ * Start downloading a new image in the background
+ *
+ * @v uri_string	URI string
+ * @v image		Image to fill in
+ * @ret rc		Return status code
+ */
+int imgdownload_string_background ( const char *uri_string,
+				    struct image **image ) {
+	struct uri *uri;
+	int rc;
+
+	if ( ! ( uri = parse_uri ( uri_string ) ) )
+		return -ENOMEM;
+
+	rc = imgdownload_background ( uri, image );
+
+	uri_put ( uri );
+	return rc;
+}
+
+/**
+ * Cancel background downloads
+ *
+ * @v image		Image to cancel, or NULL for all downloads
+ *
+ * Any matching downloads still in progress are aborted, and all
+ * matching downloads (including completed ones) are reaped.  Images
+ * already registered by completed downloads remain registered.
+ */
+void imgcancel ( struct image *image ) {
+	struct imgdownload *imgdl;
+	struct imgdownload *tmp;
+
+	list_for_each_entry_safe ( imgdl, tmp, &imgdownloads, list ) {
+		if ( image && ( imgdl->image != image ) )
+			continue;
+		if ( imgdl->rc == -EINPROGRESS ) {
+			imgdl->rc = -ECANCELED;
+			intf_shutdown ( &imgdl->job, -ECANCELED );
+		}
+		list_del ( &imgdl->list );
+		ref_put ( &imgdl->refcnt );
+	}
+}
+
+/**
+ * List background downloads
+ *
+ */
+void imgjobs ( void ) {
+	struct imgdownload *imgdl;
+	struct job_progress progress;
+
+	list_for_each_entry ( imgdl, &imgdownloads, list ) {
+		printf ( "%s: ", imgdl->image->name );
+		if ( imgdl->rc == -EINPROGRESS ) {
+			job_progress ( &imgdl->job, &progress );
+			if ( progress.total ) {
+				printf ( "downloading, %ld / %ld bytes\n",
+					 progress.completed, progress.total );
+			} else {
+				printf ( "downloading, %ld bytes\n",
+					 progress.completed );
+			}
+		} else if ( imgdl->rc == 0 ) {
+			printf ( "completed, %zd bytes\n",
+				 imgdl->image->len );
+		} else {
+			printf ( "failed: %s\n", strerror ( imgdl->rc ) );
+		}
+	}
+}
+
+/**
+ * Wait for background downloads to complete
+ *
+ * @v image		Image to wait for, or NULL for all downloads
+ * @v timeout		Maximum time to wait, in ticks (0=indefinite)
+ * @ret rc		Return status code
+ */
+int imgwait ( struct image *image, unsigned long timeout ) {
+	struct imgdownload *imgdl;
+	struct imgdownload *tmp;
+	unsigned long start;
+	unsigned long last_check;
+	unsigned long ticks;
+	int pending;
+	int rc = 0;
+
+	/* Wait for all downloads to complete */
+	start = last_check = currticks();
+	while ( 1 ) {
+
+		/* Allow downloads to progress */
+		step();
+
+		/* Check for matching downloads still in progress */
+		pending = 0;
+		list_for_each_entry ( imgdl, &imgdownloads, list ) {
+			if ( image && ( imgdl->image != image ) )
+				continue;
+			if ( imgdl->rc == -EINPROGRESS )
+				pending = 1;
+		}
+		if ( ! pending )
+			break;
+
+		/* Check for timeout, if applicable */
+		ticks = currticks();
+		if ( timeout && ( ( ticks - start ) >= timeout ) ) {
+			rc = -ETIMEDOUT;
+			break;
+		}
+
+		/* Check for keypresses at infrequent intervals (to
+		 * minimise time wasted polling the console).
+		 */
+		if ( ( ticks - last_check ) < IMGWAIT_CHECK_INTERVAL )
+			continue;
+		last_check = ticks;
+		if ( iskey() && ( getchar() == CTRL_C ) ) {
+			rc = -ECANCELED;
+			break;
+		}
+	}
+
+	/* Cancel any matching downloads still in progress */
+	list_for_each_entry ( imgdl, &imgdownloads, list ) {
+		if ( image && ( imgdl->image != image ) )
+			continue;
+		if ( imgdl->rc == -EINPROGRESS ) {
+			imgdl->rc = rc;
+			intf_shutdown ( &imgdl->job, rc );
+		}
+	}
+
+	/* Reap matching completed downloads, recording the first failure */
+	list_for_each_entry_safe ( imgdl, tmp, &imgdownloads, list ) {
+		if ( image && ( imgdl->image != image ) )
+			continue;
+		if ( ( rc == 0 ) && ( imgdl->rc != 0 ) )
+			rc = imgdl->rc;
+		list_del ( &imgdl->list );
+		ref_put ( &imgdl->refcnt );
+	}
+
+	return rc;
+}
+
 /**
  * Acquire an image
  *
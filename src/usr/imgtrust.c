@@ -28,18 +28,52 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <errno.h>
 #include <time.h>
 #include <syslog.h>
+#include <ipxe/process.h>
+#include <ipxe/console.h>
+#include <ipxe/keys.h>
+#include <ipxe/timer.h>
 #include <ipxe/image.h>
 #include <ipxe/cms.h>
 #include <ipxe/validator.h>
-#include <ipxe/monojob.h>
 #include <usr/imgtrust.h>
 
 /** @file
  *
  * Image trust management
  *
+ * The digest algorithm used by each signer is not known until the
+ * detached signature has been parsed, so the image cannot be hashed
+ * while it is still being downloaded.  The next best overlap is
+ * exploited instead: the image is digested incrementally while
+ * certificate chain validation (which may involve downloading
+ * cross-signed certificates and OCSP responses) is waiting on the
+ * network, so that by the time cms_verify() runs the expensive pass
+ * over the image data has typically already completed.
  */
 
+/** Amount of image data to digest between validator polls */
+#define IMGVERIFY_DIGEST_STRIDE ( 256 * 1024 )
+
+/** Interval between keypress checks */
+#define IMGVERIFY_CHECK_INTERVAL ( TICKS_PER_SEC / 4 )
+
+static int imgverify_rc;
+
+static void imgverify_close ( struct interface *intf, int rc ) {
+	imgverify_rc = rc;
+	intf_restart ( intf, rc );
+}
+
+static struct interface_operation imgverify_intf_op[] = {
+	INTF_OP ( intf_close, struct interface *, imgverify_close ),
+};
+
+static struct interface_descriptor imgverify_intf_desc =
+	INTF_DESC_PURE ( imgverify_intf_op );
+
+/** Certificate chain validation job interface */
+static struct interface imgverify_job = INTF_INIT ( imgverify_intf_desc );
+
 /**
  * Verify image using downloaded signature
  *
@@ -52,6 +86,10 @@ int imgverify ( struct image *image, struct image *signature,
 		const char *name ) {
 	struct cms_message *cms;
 	struct cms_participant *part;
+	unsigned long last_check;
+	unsigned long ticks;
+	size_t offset = 0;
+	size_t frag_len;
 	time_t now;
 	int rc;
 
@@ -59,15 +97,59 @@ int imgverify ( struct image *image, struct image *signature,
 	if ( ( rc = cms_message ( signature, &cms ) ) != 0 )
 		goto err_parse;
 
-	/* Complete all certificate chains */
+	/* Start incremental digest calculation */
+	if ( ( rc = cms_digest_init ( cms ) ) != 0 )
+		goto err_digest_init;
+
+	/* Complete all certificate chains, digesting the image in the
+	 * gaps while validation waits on the network.
+	 */
 	list_for_each_entry ( part, &cms->participants, list ) {
-		if ( ( rc = create_validator ( &monojob, part->chain,
+		imgverify_rc = -EINPROGRESS;
+		if ( ( rc = create_validator ( &imgverify_job, part->chain,
 					       NULL ) ) != 0 )
 			goto err_create_validator;
-		if ( ( rc = monojob_wait ( NULL, 0 ) ) != 0 )
+		last_check = currticks();
+		while ( imgverify_rc == -EINPROGRESS ) {
+
+			/* Allow validator to progress */
+			step();
+
+			/* Digest next portion of image data, if any */
+			if ( offset < image->len ) {
+				frag_len = ( image->len - offset );
+				if ( frag_len > IMGVERIFY_DIGEST_STRIDE )
+					frag_len = IMGVERIFY_DIGEST_STRIDE;
+				cms_digest_update ( cms,
+						    ( image->data + offset ),
+						    frag_len );
+				offset += frag_len;
+			}
+
+			/* Check for keypresses at infrequent intervals
+			 * (to minimise time wasted polling the
+			 * console).
+			 */
+			ticks = currticks();
+			if ( ( ticks - last_check ) < IMGVERIFY_CHECK_INTERVAL )
+				continue;
+			last_check = ticks;
+			if ( iskey() && ( getchar() == CTRL_C ) ) {
+				imgverify_rc = -ECANCELED;
+				break;
+			}
+		}
+		imgverify_close ( &imgverify_job, imgverify_rc );
+		if ( ( rc = imgverify_rc ) != 0 )
 			goto err_validator_wait;
 	}
 
+	/* Digest any remaining image data */
+	if ( offset < image->len ) {
+		cms_digest_update ( cms, ( image->data + offset ),
+				    ( image->len - offset ) );
+	}
+
 	/* Use signature to verify image */
 	now = time ( NULL );
 	if ( ( rc = cms_verify ( cms, image, name, now, NULL, NULL ) ) != 0 )
@@ -85,6 +167,7 @@ int imgverify ( struct image *image, struct image *signature,
  err_verify:
  err_validator_wait:
  err_create_validator:
+ err_digest_init:
 	cms_put ( cms );
  err_parse:
 	syslog ( LOG_ERR, "Image \"%s\" signature bad: %s\n",
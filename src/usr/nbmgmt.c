@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2025 Michael Brown <mbrown@fensystems.co.uk>.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * You can also choose to distribute this program under the terms of
+ * the Unmodified Binary Distribution Licence (as given in the file
+ * COPYING.UBDL), provided that you have satisfied its requirements.
+ */
+
+FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <ipxe/netbench.h>
+#include <ipxe/monojob.h>
+#include <ipxe/timer.h>
+#include <usr/nbmgmt.h>
+
+/** @file
+ *
+ * Network benchmark management
+ *
+ */
+
+/**
+ * Run a network benchmark stream
+ *
+ * @v hostname		Remote host
+ * @v port		Remote port
+ * @v udp		Use UDP (rather than TCP)
+ * @v rx		Receive (rather than transmit)
+ * @v len		Chunk length
+ * @v duration		Duration (in ticks)
+ * @ret rc		Return status code
+ */
+int netbench ( const char *hostname, unsigned int port, int udp, int rx,
+	       size_t len, unsigned long duration ) {
+	struct netbench_result result;
+	unsigned long long kbps;
+	int rc;
+
+	/* Create benchmark stream */
+	memset ( &result, 0, sizeof ( result ) );
+	if ( ( rc = create_netbench ( &monojob, hostname, port, udp, rx,
+				      len, duration, &result ) ) != 0 ) {
+		printf ( "Could not start benchmark: %s\n", strerror ( rc ) );
+		return rc;
+	}
+
+	/* Wait for benchmark to complete */
+	printf ( "Benchmarking %s %s:%d (%s %zd byte chunks)\n",
+		 ( rx ? "from" : "to" ), hostname, port,
+		 ( udp ? "UDP" : "TCP" ), len );
+	if ( ( rc = monojob_wait ( NULL, 0 ) ) != 0 ) {
+		printf ( "Benchmark failed: %s\n", strerror ( rc ) );
+		return rc;
+	}
+
+	/* Report measurements */
+	printf ( "%s %lld bytes in %ld ms\n", ( rx ? "Received" : "Sent" ),
+		 result.bytes, ( result.elapsed / TICKS_PER_MS ) );
+	if ( result.elapsed ) {
+		kbps = ( ( result.bytes * 8 * TICKS_PER_SEC ) /
+			 ( result.elapsed * 1000 ) );
+		printf ( "Throughput %lld.%03lld Mbit/s\n",
+			 ( kbps / 1000 ), ( kbps % 1000 ) );
+	}
+	if ( result.cycles && len ) {
+		printf ( "Datapath cost %ld ticks/chunk (%ld ticks/byte)\n",
+			 result.cycles, ( result.cycles / len ) );
+	}
+
+	return 0;
+}
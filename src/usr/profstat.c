@@ -24,7 +24,9 @@
 FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 
 #include <stdio.h>
+#include <ipxe/malloc.h>
 #include <ipxe/profile.h>
+#include <ipxe/netdevice.h>
 #include <usr/profstat.h>
 
 /** @file
@@ -33,16 +35,52 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/**
+ * Print statistics for a single profiler
+ *
+ * @v profiler		Profiler
+ */
+static void profstat_samples ( struct profiler *profiler ) {
+
+	printf ( "%ld +/- %ld ticks (%d samples, p50 %ld, p95 %ld, p99 %ld)\n",
+		 profile_mean ( profiler ), profile_stddev ( profiler ),
+		 profiler->count, profile_percentile ( profiler, 50 ),
+		 profile_percentile ( profiler, 95 ),
+		 profile_percentile ( profiler, 99 ) );
+}
+
 /**
  * Print profiling statistics
  *
  */
 void profstat ( void ) {
 	struct profiler *profiler;
+	struct net_device *netdev;
+	struct heap_stats stats;
 
 	for_each_table_entry ( profiler, PROFILERS ) {
-		printf ( "%s: %ld +/- %ld ticks (%d samples)\n",
-			 profiler->name, profile_mean ( profiler ),
-			 profile_stddev ( profiler ), profiler->count );
+		printf ( "%s: ", profiler->name );
+		profstat_samples ( profiler );
+	}
+
+	/* Print per-device driver datapath profilers, which exist
+	 * outside of the profiler table since network devices are
+	 * created at run time.
+	 */
+	for_each_netdev ( netdev ) {
+		if ( netdev->tx_profiler.count ) {
+			printf ( "%s.tx: ", netdev->name );
+			profstat_samples ( &netdev->tx_profiler );
+		}
+		if ( netdev->poll_profiler.count ) {
+			printf ( "%s.poll: ", netdev->name );
+			profstat_samples ( &netdev->poll_profiler );
+		}
 	}
+
+	/* Print heap statistics */
+	heap_stat ( &stats );
+	printf ( "heap: %zd bytes free (largest block %zd in %d blocks), "
+		 "%zd used (max %zd), %d failures\n", freemem, stats.largest,
+		 stats.blocks, usedmem, maxusedmem, stats.failures );
 }
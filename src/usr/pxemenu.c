@@ -37,7 +37,10 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
 #include <ipxe/timer.h>
 #include <ipxe/uri.h>
 #include <ipxe/ansicol.h>
+#include <ipxe/image.h>
+#include <ipxe/process.h>
 #include <usr/dhcpmgmt.h>
+#include <usr/imgmgmt.h>
 #include <usr/autoboot.h>
 
 /** @file
@@ -46,6 +49,20 @@ FILE_LICENCE ( GPL2_OR_LATER_OR_UBDL );
  *
  */
 
+/** Prefetch the default boot item during the menu countdown
+ *
+ * When a menu timeout is running, the overwhelmingly common outcome
+ * is that the timeout expires and the default item boots.  Perform
+ * boot server discovery for the default item up front and download
+ * its NBP as a background job while the countdown (and any subsequent
+ * menu interaction) runs, so that taking the default path finds its
+ * payload already transferred.  A mispredicted prefetch is cancelled
+ * when a different item is selected.
+ */
+#ifndef PXEMENU_PREFETCH
+#define PXEMENU_PREFETCH 1
+#endif
+
 /** A PXE boot menu item */
 struct pxe_menu_item {
 	/** Boot Server type */
@@ -219,7 +236,9 @@ static void pxe_menu_draw_item ( struct pxe_menu *menu,
 static int pxe_menu_select ( struct pxe_menu *menu ) {
 	int key;
 	unsigned int key_selection;
+	unsigned int selection;
 	unsigned int i;
+	int chosen;
 	int rc = 0;
 
 	/* Initialise UI */
@@ -227,28 +246,25 @@ static int pxe_menu_select ( struct pxe_menu *menu ) {
 	start_color();
 	color_set ( CPAIR_DEFAULT, NULL );
 
-	/* Draw initial menu */
+	/* Draw initial menu, highlighting the current selection */
 	for ( i = 0 ; i < menu->num_items ; i++ )
 		printf ( "\n" );
 	for ( i = 0 ; i < menu->num_items ; i++ )
 		pxe_menu_draw_item ( menu, ( menu->num_items - i - 1 ), 0 );
+	pxe_menu_draw_item ( menu, menu->selection, 1 );
 
 	while ( 1 ) {
 
-		/* Highlight currently selected item */
-		pxe_menu_draw_item ( menu, menu->selection, 1 );
-
 		/* Wait for keyboard input */
 		key = getkey ( 0 );
 
-		/* Unhighlight currently selected item */
-		pxe_menu_draw_item ( menu, menu->selection, 0 );
-
 		/* Act upon key */
+		selection = menu->selection;
+		chosen = 0;
 		if ( ( key == CR ) || ( key == LF ) ) {
-			pxe_menu_draw_item ( menu, menu->selection, 1 );
 			break;
 		} else if ( ( key == CTRL_C ) || ( key == ESC ) ) {
+			pxe_menu_draw_item ( menu, selection, 0 );
 			rc = -ECANCELED;
 			break;
 		} else if ( key == KEY_UP ) {
@@ -261,9 +277,18 @@ static int pxe_menu_select ( struct pxe_menu *menu ) {
 			    ( ( key_selection = ( toupper ( key ) - 'A' ) )
 			      < menu->num_items ) ) {
 			menu->selection = key_selection;
+			chosen = 1;
+		}
+
+		/* Redraw only the rows whose highlight has changed */
+		if ( menu->selection != selection ) {
+			pxe_menu_draw_item ( menu, selection, 0 );
 			pxe_menu_draw_item ( menu, menu->selection, 1 );
-			break;
 		}
+
+		/* Accept selection made via keyboard shortcut */
+		if ( chosen )
+			break;
 	}
 
 	/* Shut down UI */
@@ -299,6 +324,10 @@ static int pxe_menu_prompt_and_select ( struct pxe_menu *menu ) {
 
 	/* Wait for timeout, if specified */
 	while ( menu->timeout > 0 ) {
+
+		/* Allow any prefetch download to progress */
+		step();
+
 		if ( ! len )
 			len = printf ( " (%d)", menu->timeout );
 		if ( iskey() ) {
@@ -332,6 +361,70 @@ static int pxe_menu_prompt_and_select ( struct pxe_menu *menu ) {
 	return rc;
 }
 
+/**
+ * Speculatively prefetch a boot menu item's NBP
+ *
+ * @v netdev		Network device
+ * @v type		Boot server type
+ * @v image		Image to fill in
+ * @ret rc		Return status code
+ *
+ * On success, the returned image holds a reference which must
+ * eventually be dropped, and the download continues as a background
+ * job to be joined via imgwait() or abandoned via imgcancel().
+ */
+static int pxe_menu_prefetch ( struct net_device *netdev, unsigned int type,
+			       struct image **image ) {
+	struct settings *pxebs_settings;
+	struct uri *uri;
+	int rc;
+
+	/* Attempt PXE Boot Server Discovery */
+	if ( ( rc = pxebs ( netdev, type ) ) != 0 )
+		return rc;
+
+	/* Fetch next server and filename */
+	pxebs_settings = find_settings ( PXEBS_SETTINGS_NAME );
+	assert ( pxebs_settings );
+	uri = fetch_next_server_and_filename ( pxebs_settings );
+	if ( ! uri )
+		return -ENOMEM;
+
+	/* Start downloading NBP in the background */
+	if ( ( rc = imgdownload_background ( uri, image ) ) != 0 ) {
+		uri_put ( uri );
+		return rc;
+	}
+
+	/* Take a reference, since the background download's own
+	 * reference is dropped when the download is reaped.
+	 */
+	image_get ( *image );
+	uri_put ( uri );
+	return 0;
+}
+
+/**
+ * Abandon a mispredicted NBP prefetch
+ *
+ * @v image		Prefetched image
+ */
+static void pxe_menu_prefetch_abort ( struct image *image ) {
+
+	/* Cancel the prefetch download, if still in progress.  Other
+	 * background downloads (e.g. user-initiated ones) are left
+	 * untouched.
+	 */
+	imgcancel ( image );
+
+	/* Unregister image, if the download had already completed */
+	if ( image->flags & IMAGE_REGISTERED )
+		unregister_image ( image );
+
+	/* Drop our reference */
+	image_put ( image );
+}
+
 /**
  * Boot using PXE boot menu
  *
@@ -344,6 +437,8 @@ static int pxe_menu_prompt_and_select ( struct pxe_menu *menu ) {
 int pxe_menu_boot ( struct net_device *netdev ) {
 	struct pxe_menu *menu;
 	unsigned int pxe_type;
+	unsigned int prefetch_type = 0;
+	struct image *prefetch = NULL;
 	struct settings *pxebs_settings;
 	struct uri *uri;
 	int rc;
@@ -352,8 +447,21 @@ int pxe_menu_boot ( struct net_device *netdev ) {
 	if ( ( rc = pxe_menu_parse ( &menu ) ) != 0 )
 		return rc;
 
+	/* Speculatively prefetch the default item's NBP while the
+	 * countdown and menu run, if applicable.
+	 */
+	if ( PXEMENU_PREFETCH && ( menu->timeout > 0 ) &&
+	     ( prefetch_type = menu->items[menu->selection].type ) != 0 ) {
+		if ( pxe_menu_prefetch ( netdev, prefetch_type,
+					 &prefetch ) != 0 ) {
+			prefetch_type = 0;
+		}
+	}
+
 	/* Make selection from boot menu */
 	if ( ( rc = pxe_menu_prompt_and_select ( menu ) ) != 0 ) {
+		if ( prefetch )
+			pxe_menu_prefetch_abort ( prefetch );
 		free ( menu );
 		return rc;
 	}
@@ -362,6 +470,28 @@ int pxe_menu_boot ( struct net_device *netdev ) {
 	/* Free boot menu */
 	free ( menu );
 
+	/* Use the prefetched NBP, if the prediction held */
+	if ( prefetch ) {
+		if ( pxe_type == prefetch_type ) {
+			/* Join the prefetch download and boot */
+			if ( ( rc = imgwait ( prefetch, 0 ) ) == 0 ) {
+				imgstat ( prefetch );
+				prefetch->flags |= IMAGE_AUTO_UNREGISTER;
+				if ( ( rc = image_exec ( prefetch ) ) != 0 ) {
+					printf ( "Could not boot image: %s\n",
+						 strerror ( rc ) );
+				}
+				image_put ( prefetch );
+				return rc;
+			}
+			/* Fall back to a fresh attempt on error */
+			image_put ( prefetch );
+		} else {
+			/* Cancel mispredicted prefetch */
+			pxe_menu_prefetch_abort ( prefetch );
+		}
+	}
+
 	/* Return immediately if local boot selected */
 	if ( ! pxe_type )
 		return 0;
@@ -17,6 +17,17 @@
 /* LZMA preset choice.  This is a policy decision */
 #define LZMA_PRESET ( LZMA_PRESET_DEFAULT | LZMA_PRESET_EXTREME )
 
+/* An LZ4 compression option has been considered for ROM-embedded
+ * targets where decompression latency matters more than image size.
+ * Adding one is gated on the self-extractor side rather than here:
+ * each architecture would need a hand-written LZ4 counterpart to
+ * unlzma.S/unlzma16.S (boot-critical prefix assembly that runs before
+ * any C environment exists), plus per-target format selection in
+ * Makefile.housekeeping and a host-side liblz4 dependency.  The
+ * compressor changes below are trivial by comparison and will follow
+ * whenever such an extractor lands.
+ */
+
 #undef ELF_R_TYPE
 
 #ifdef ELF32